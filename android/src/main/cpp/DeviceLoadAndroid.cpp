@@ -0,0 +1,60 @@
+#include "DeviceLoadAndroid.hpp"
+#include "DeviceLoad.hpp"
+
+#include <fbjni/fbjni.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+jclass monitor_class = nullptr;
+jmethodID start_method = nullptr;
+
+// DeviceLoadMonitor's levels are DeviceLoad::Level's
+DeviceLoad::Level to_level(jint level) noexcept {
+    return level >= 2 ? DeviceLoad::Level::CRITICAL : level == 1 ? DeviceLoad::Level::ELEVATED : DeviceLoad::Level::NORMAL;
+}
+
+} // namespace
+
+void register_device_load(JNIEnv* env) noexcept {
+    jclass local = env->FindClass("com/nitroeventsource/DeviceLoadMonitor");
+    if (!local) {
+        env->ExceptionClear();
+        return;
+    }
+    monitor_class = static_cast<jclass>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    start_method = env->GetStaticMethodID(monitor_class, "start", "()V");
+    if (!start_method) {
+        env->ExceptionClear();
+    }
+}
+
+void DeviceLoad::start_platform_monitor() noexcept {
+    if (!monitor_class || !start_method) {
+        return;
+    }
+    try {
+        JNIEnv* env = facebook::jni::Environment::ensureCurrentThreadIsAttached();
+        env->CallStaticVoidMethod(monitor_class, start_method);
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+    } catch (...) {
+        // Without a monitor the device never reads as loaded, as before
+    }
+}
+
+} // namespace margelo::nitro::nitroeventsource
+
+extern "C" JNIEXPORT void JNICALL Java_com_nitroeventsource_DeviceLoadMonitor_nativeReportMemory(JNIEnv*, jclass, jint level) {
+    using margelo::nitro::nitroeventsource::DeviceLoad;
+    DeviceLoad::shared().report_memory(margelo::nitro::nitroeventsource::to_level(level));
+}
+
+extern "C" JNIEXPORT void JNICALL Java_com_nitroeventsource_DeviceLoadMonitor_nativeReportThermal(JNIEnv*, jclass, jint level) {
+    using margelo::nitro::nitroeventsource::DeviceLoad;
+    DeviceLoad::shared().report_thermal(margelo::nitro::nitroeventsource::to_level(level));
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <jni.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+// Called from JNI_OnLoad, the only place the app's classes can be looked up from any thread
+void register_device_load(JNIEnv* env) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,87 @@
+#include "NetworkMonitorAndroid.hpp"
+#include "NetworkMonitor.hpp"
+#include "TransferEngine.hpp"
+
+#include <fbjni/fbjni.h>
+#if NITRO_EVENT_SOURCE_ARES
+#include <ares.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+jclass monitor_class = nullptr;
+jmethodID start_method = nullptr;
+jmethodID connectivity_manager_method = nullptr;
+
+} // namespace
+
+void register_network_monitor(JNIEnv* env) noexcept {
+    jclass local = env->FindClass("com/nitroeventsource/NetworkMonitor");
+    if (!local) {
+        env->ExceptionClear();
+        return;
+    }
+    monitor_class = static_cast<jclass>(env->NewGlobalRef(local));
+    env->DeleteLocalRef(local);
+    start_method = env->GetStaticMethodID(monitor_class, "start", "()V");
+    if (!start_method) {
+        env->ExceptionClear();
+    }
+    connectivity_manager_method = env->GetStaticMethodID(monitor_class, "connectivityManager", "()Landroid/net/ConnectivityManager;");
+    if (!connectivity_manager_method) {
+        env->ExceptionClear();
+    }
+}
+
+void NetworkMonitor::start_platform_monitor() noexcept {
+    if (!monitor_class || !start_method) {
+        return;
+    }
+    try {
+        JNIEnv* env = facebook::jni::Environment::ensureCurrentThreadIsAttached();
+        env->CallStaticVoidMethod(monitor_class, start_method);
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+    } catch (...) {
+        // Without a monitor the device always reads as online, as before
+    }
+}
+
+#if NITRO_EVENT_SOURCE_ARES
+
+void TransferEngine::prepare_platform_resolver() noexcept {
+    // Since Android 8 the DNS servers are only known to ConnectivityManager, c-ares asks it
+    // through JNI; without it every lookup fails
+    if (!monitor_class || !connectivity_manager_method) {
+        return;
+    }
+    try {
+        JNIEnv* env = facebook::jni::Environment::ensureCurrentThreadIsAttached();
+        JavaVM* vm = nullptr;
+        jobject manager = env->GetJavaVM(&vm) == JNI_OK ? env->CallStaticObjectMethod(monitor_class, connectivity_manager_method) : nullptr;
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+        if (!manager) {
+            return;
+        }
+        ares_library_init_jvm(vm);
+        // c-ares keeps its own global reference
+        ares_library_init_android(manager);
+        env->DeleteLocalRef(manager);
+    } catch (...) {
+    }
+}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource
+
+extern "C" JNIEXPORT void JNICALL Java_com_nitroeventsource_NetworkMonitor_nativeReport(JNIEnv*, jclass, jboolean online, jlong network) {
+    margelo::nitro::nitroeventsource::NetworkMonitor::shared().report(online == JNI_TRUE, static_cast<uint64_t>(network));
+}
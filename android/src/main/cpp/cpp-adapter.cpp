@@ -1,6 +1,13 @@
 #include <jni.h>
+#include "DeviceLoadAndroid.hpp"
+#include "NetworkMonitorAndroid.hpp"
 #include "NitroEventSourceOnLoad.hpp"
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void*) {
+  JNIEnv* env = nullptr;
+  if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+    margelo::nitro::nitroeventsource::register_network_monitor(env);
+    margelo::nitro::nitroeventsource::register_device_load(env);
+  }
   return margelo::nitro::nitroeventsource::initialize(vm);
 }
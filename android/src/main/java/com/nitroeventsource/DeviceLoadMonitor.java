@@ -0,0 +1,110 @@
+package com.nitroeventsource;
+
+import android.content.ComponentCallbacks2;
+import android.content.Context;
+import android.content.res.Configuration;
+import android.os.Build;
+import android.os.Handler;
+import android.os.Looper;
+import android.os.PowerManager;
+import android.util.Log;
+import androidx.annotation.Keep;
+import androidx.annotation.NonNull;
+
+import com.margelo.nitro.NitroModules;
+
+/**
+ * Feeds the native DeviceLoad from onTrimMemory() and, on Android 10 and later, the
+ * thermal status listener, so streams with an `underLoad` policy degrade while the
+ * device is short of memory or throttling. Android never reports that memory pressure
+ * is over, so it counts as over once no trim arrived for a minute.
+ */
+@Keep
+final class DeviceLoadMonitor {
+  private static final String TAG = "NitroEventSource";
+  // DeviceLoad::Level
+  private static final int NORMAL = 0;
+  private static final int ELEVATED = 1;
+  private static final int CRITICAL = 2;
+  private static final long MEMORY_CALM_MS = 60_000;
+
+  private static boolean started = false;
+  private static final Handler handler = new Handler(Looper.getMainLooper());
+  private static final Runnable memoryCalm = new Runnable() {
+    @Override
+    public void run() {
+      nativeReportMemory(NORMAL);
+    }
+  };
+
+  private DeviceLoadMonitor() {}
+
+  // Called from native the first time a stream has an underLoad policy
+  @Keep
+  static synchronized void start() {
+    if (started) {
+      return;
+    }
+    Context context = NitroModules.Companion.getApplicationContext();
+    if (context == null) {
+      Log.w(TAG, "No application context, underLoad policies never apply");
+      return;
+    }
+
+    context.registerComponentCallbacks(new ComponentCallbacks2() {
+      @Override
+      public void onTrimMemory(int level) {
+        // TRIM_MEMORY_UI_HIDDEN only says the app went to the background
+        if (level == TRIM_MEMORY_UI_HIDDEN) {
+          return;
+        }
+        reportMemory(level >= TRIM_MEMORY_RUNNING_CRITICAL ? CRITICAL : ELEVATED);
+      }
+
+      @Override
+      public void onLowMemory() {
+        reportMemory(CRITICAL);
+      }
+
+      @Override
+      public void onConfigurationChanged(@NonNull Configuration configuration) {}
+    });
+
+    if (Build.VERSION.SDK_INT >= Build.VERSION_CODES.Q) {
+      final PowerManager power = (PowerManager) context.getSystemService(Context.POWER_SERVICE);
+      if (power != null) {
+        power.addThermalStatusListener(new PowerManager.OnThermalStatusChangedListener() {
+          @Override
+          public void onThermalStatusChanged(int status) {
+            nativeReportThermal(thermalLoad(status));
+          }
+        });
+        // Posted: native is still waiting for this call to return before it takes reports
+        handler.post(new Runnable() {
+          @Override
+          public void run() {
+            nativeReportThermal(thermalLoad(power.getCurrentThermalStatus()));
+          }
+        });
+      }
+    }
+    started = true;
+  }
+
+  private static void reportMemory(int load) {
+    nativeReportMemory(load);
+    handler.removeCallbacks(memoryCalm);
+    handler.postDelayed(memoryCalm, MEMORY_CALM_MS);
+  }
+
+  // Moderate is where the platform starts throttling, severe where the user notices
+  private static int thermalLoad(int status) {
+    if (status >= PowerManager.THERMAL_STATUS_SEVERE) {
+      return CRITICAL;
+    }
+    return status >= PowerManager.THERMAL_STATUS_MODERATE ? ELEVATED : NORMAL;
+  }
+
+  private static native void nativeReportMemory(int level);
+  private static native void nativeReportThermal(int level);
+}
@@ -0,0 +1,70 @@
+package com.nitroeventsource;
+
+import android.content.Context;
+import android.net.ConnectivityManager;
+import android.net.Network;
+import android.util.Log;
+import androidx.annotation.Keep;
+import androidx.annotation.NonNull;
+
+import com.margelo.nitro.NitroModules;
+
+/**
+ * Feeds the native NetworkMonitor from the default network callback, so streams
+ * stop retrying while offline and reconnect as soon as a network is back. A network
+ * Doze or App Standby blocks for the app counts as offline, so background streams
+ * wait for the next maintenance window instead of waking the radio to fail.
+ */
+@Keep
+final class NetworkMonitor {
+  private static final String TAG = "NitroEventSource";
+  private static boolean started = false;
+
+  private NetworkMonitor() {}
+
+  // Called from native the first time a stream needs reachability
+  @Keep
+  static synchronized void start() {
+    if (started) {
+      return;
+    }
+    Context context = NitroModules.Companion.getApplicationContext();
+    ConnectivityManager manager = context == null ? null : (ConnectivityManager) context.getSystemService(Context.CONNECTIVITY_SERVICE);
+    if (manager == null) {
+      Log.w(TAG, "ConnectivityManager unavailable, reconnects are not network-aware");
+      return;
+    }
+
+    try {
+      manager.registerDefaultNetworkCallback(new ConnectivityManager.NetworkCallback() {
+        @Override
+        public void onAvailable(@NonNull Network network) {
+          nativeReport(true, network.getNetworkHandle());
+        }
+
+        @Override
+        public void onLost(@NonNull Network network) {
+          nativeReport(false, 0);
+        }
+
+        // API 29+; older releases never call it and streams retry through Doze as before
+        @Override
+        public void onBlockedStatusChanged(@NonNull Network network, boolean blocked) {
+          nativeReport(!blocked, blocked ? 0 : network.getNetworkHandle());
+        }
+      });
+      started = true;
+    } catch (RuntimeException e) {
+      Log.w(TAG, "Failed to monitor the network, reconnects are not network-aware", e);
+    }
+  }
+
+  // For a libcurl built with c-ares, which reads the DNS servers from it
+  @Keep
+  static ConnectivityManager connectivityManager() {
+    Context context = NitroModules.Companion.getApplicationContext();
+    return context == null ? null : (ConnectivityManager) context.getSystemService(Context.CONNECTIVITY_SERVICE);
+  }
+
+  private static native void nativeReport(boolean online, long network);
+}
@@ -0,0 +1,156 @@
+/**
+ * Throughput of SseParser on the streams the module sees in practice, in MB/s
+ * and events/s. Each corpus is fed in 16 KiB reads, what the write callback
+ * usually gets, and one byte at a time, so every split a proxy could produce
+ * shows up. SseCountingSink stands in for the HybridObject's sink: what is
+ * measured is the framing, decoding and limits, not the JSI conversion.
+ *
+ *   build/sse_parser_bench            every corpus
+ *   build/sse_parser_bench json       corpora whose name contains "json"
+ */
+#include "SseParser.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace margelo::nitro::nitroeventsource;
+
+namespace {
+
+struct Corpus {
+    std::string name;
+    std::string body;
+    SseLimits limits;
+};
+
+// About 4 MB each, enough for a steady reading without the run taking long
+constexpr size_t CORPUS_BYTES = 4 * 1024 * 1024;
+
+// LLM-style token stream: an id and a few bytes of data per event
+std::string tiny_tokens(std::string_view newline) {
+    std::string body;
+    for (size_t i = 0; body.size() < CORPUS_BYTES; ++i) {
+        body.append("id: ").append(std::to_string(i)).append(newline);
+        body.append("data: {\"t\":\"tok").append(std::to_string(i % 97)).append("\"}").append(newline).append(newline);
+    }
+    return body;
+}
+
+// Full-state snapshots of about 100 KB on a single data line
+std::string json_snapshots() {
+    std::string item = "{\"id\":12345,\"name\":\"instrument\",\"bid\":101.25,\"ask\":101.5,\"tags\":[\"a\",\"b\"]},";
+    std::string payload = "{\"items\":[";
+    while (payload.size() < 100 * 1024) {
+        payload += item;
+    }
+    payload.back() = ']';
+    payload += '}';
+
+    std::string body;
+    while (body.size() < CORPUS_BYTES) {
+        body.append("event: snapshot\ndata: ").append(payload).append("\n\n");
+    }
+    return body;
+}
+
+// Log tailing: many short data lines per event, joined with newlines
+std::string multiline() {
+    std::string body;
+    while (body.size() < CORPUS_BYTES) {
+        body += "event: log\n";
+        for (int line = 0; line < 24; ++line) {
+            body.append("data: 2025-01-01T00:00:00Z worker-").append(std::to_string(line)).append(" finished a job\n");
+        }
+        body += '\n';
+    }
+    return body;
+}
+
+// Non-ASCII text, which the parser validates as UTF-8 instead of passing through the ASCII path
+std::string utf8_text() {
+    std::string body;
+    while (body.size() < CORPUS_BYTES) {
+        body += "data: Grüße aus Zürich, привет, こんにちは, 👋\n\n";
+    }
+    return body;
+}
+
+// Keepalive comments between sparse events
+std::string comments() {
+    std::string body;
+    while (body.size() < CORPUS_BYTES) {
+        for (int i = 0; i < 8; ++i) {
+            body += ":keepalive\n";
+        }
+        body += "data: tick\n\n";
+    }
+    return body;
+}
+
+std::vector<Corpus> corpora() {
+    SseLimits chunked;
+    chunked.chunk_bytes = 16 * 1024;
+    return {
+        {"tiny tokens (LF)", tiny_tokens("\n"), {}},
+        {"tiny tokens (CRLF)", tiny_tokens("\r\n"), {}},
+        {"json snapshots 100 KB", json_snapshots(), {}},
+        {"json snapshots 100 KB, 16 KB chunks", json_snapshots(), chunked},
+        {"multiline data", multiline(), {}},
+        {"utf-8 text", utf8_text(), {}},
+        {"keepalive comments", comments(), {}},
+    };
+}
+
+struct Result {
+    double seconds;
+    size_t events;
+};
+
+Result run(const Corpus& corpus, size_t read_bytes) {
+    SseParser<SseCountingSink> parser{SseCountingSink{}, corpus.limits};
+    const std::string_view body = corpus.body;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < body.size(); offset += read_bytes) {
+        parser.feed(body.substr(offset, read_bytes));
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {elapsed.count(), parser.sink().events};
+}
+
+// The best of a few runs, the one least disturbed by the rest of the machine
+Result best_of(const Corpus& corpus, size_t read_bytes, int runs) {
+    Result best = run(corpus, read_bytes);
+    for (int i = 1; i < runs; ++i) {
+        const Result result = run(corpus, read_bytes);
+        if (result.seconds < best.seconds) {
+            best = result;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    constexpr std::array<size_t, 2> READS{16 * 1024, 1};
+
+    std::printf("%-40s %10s %12s %14s\n", "corpus", "read", "MB/s", "events/s");
+    for (const Corpus& corpus : corpora()) {
+        if (corpus.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        for (const size_t read_bytes : READS) {
+            // Byte at a time is slow enough that one run is a steady reading
+            const Result result = best_of(corpus, read_bytes, read_bytes == 1 ? 1 : 5);
+            const double megabytes = static_cast<double>(corpus.body.size()) / 1e6;
+            std::printf("%-40s %10zu %12.1f %14.0f\n", corpus.name.c_str(), read_bytes, megabytes / result.seconds,
+                        static_cast<double>(result.events) / result.seconds);
+        }
+    }
+    return 0;
+}
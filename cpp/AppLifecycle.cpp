@@ -0,0 +1,60 @@
+#include "AppLifecycle.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+AppLifecycle& AppLifecycle::shared() {
+    static AppLifecycle* lifecycle = new AppLifecycle();
+    return *lifecycle;
+}
+
+uint64_t AppLifecycle::subscribe(Listener listener) {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t id = _next_id++;
+    _listeners.emplace(id, std::move(listener));
+    return id;
+}
+
+void AppLifecycle::unsubscribe(uint64_t id) noexcept {
+    Listener listener;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _listeners.find(id);
+        if (it == _listeners.end()) {
+            return;
+        }
+        // Destroyed outside the lock, it may hold the last reference to a stream
+        listener = std::move(it->second);
+        _listeners.erase(it);
+    }
+}
+
+void AppLifecycle::report(bool foreground) noexcept {
+    std::vector<Listener> listeners;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (_foreground.exchange(foreground, std::memory_order_acq_rel) == foreground) {
+            return;
+        }
+        try {
+            listeners.reserve(_listeners.size());
+            for (const auto& [id, listener] : _listeners) {
+                listeners.push_back(listener);
+            }
+        } catch (...) {
+            return;
+        }
+    }
+
+    for (const Listener& listener : listeners) {
+        try {
+            listener(foreground);
+        } catch (...) {
+            // A listener only posts to the I/O thread, there is nobody to report to
+        }
+    }
+}
+
+} // namespace margelo::nitro::nitroeventsource
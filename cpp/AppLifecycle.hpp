@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Process-wide foreground/background state, reported from React Native's
+ * AppState through `setForeground()`. Streams apply their `background` policy
+ * when it changes; listeners run on the reporting (JS) thread.
+ */
+class AppLifecycle {
+public:
+    using Listener = std::function<void(bool /* foreground */)>;
+
+    static AppLifecycle& shared();
+
+    AppLifecycle(const AppLifecycle&) = delete;
+    AppLifecycle& operator=(const AppLifecycle&) = delete;
+
+    uint64_t subscribe(Listener listener);
+    void unsubscribe(uint64_t id) noexcept;
+
+    bool foreground() const noexcept { return _foreground.load(std::memory_order_acquire); }
+    void report(bool foreground) noexcept;
+
+private:
+    AppLifecycle() = default;
+    ~AppLifecycle() = default;
+
+    std::atomic<bool> _foreground{true};
+    std::mutex _mutex;
+    uint64_t _next_id = 1;
+    std::unordered_map<uint64_t, Listener> _listeners;
+};
+
+} // namespace margelo::nitro::nitroeventsource
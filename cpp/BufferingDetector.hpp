@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Spots a proxy that buffers the stream and flushes it in bursts. A read is a
+ * burst when it follows a silence of `gap` and carries at least `burst_events`
+ * events; while server timestamps are available (latencyTracing) its events
+ * must also have spent `lag_ms` on the way, so a server that simply sends in
+ * batches is not mistaken for one. The stream counts as buffered once
+ * `bursts_to_flag` of the last eight reads with events were bursts, and stays
+ * so until reset() for the next connection. Owned by the I/O thread.
+ */
+class BufferingDetector {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings {
+        std::chrono::milliseconds gap{1000};
+        uint32_t burst_events = 4;
+        double lag_ms = 2000.0;
+        uint32_t bursts_to_flag = 3;
+    };
+
+    explicit BufferingDetector(Settings settings) noexcept : _settings(settings) {}
+
+    // A server timestamp of an event in the current read, as `received - sent` in milliseconds
+    void record_lag(double lag_ms) noexcept {
+        _max_lag_ms = _max_lag_ms ? std::max(*_max_lag_ms, lag_ms) : lag_ms;
+    }
+
+    // After each read and the events parsed from it; true when this read got the stream flagged
+    bool record_read(Clock::time_point at, uint32_t events) noexcept {
+        const std::optional<Clock::time_point> previous = std::exchange(_last_read, at);
+        const std::optional<double> lag = std::exchange(_max_lag_ms, std::nullopt);
+        if (events == 0) {
+            return false;
+        }
+
+        const bool after_gap = previous && at - *previous >= _settings.gap;
+        const bool burst = after_gap && events >= _settings.burst_events && (!lag || *lag >= _settings.lag_ms);
+        _history = static_cast<uint8_t>(_history << 1 | (burst ? 1 : 0));
+        _bursts += burst ? 1 : 0;
+        if (_buffering || static_cast<uint32_t>(std::popcount(_history)) < _settings.bursts_to_flag) {
+            return false;
+        }
+        _buffering = true;
+        return true;
+    }
+
+    bool buffering() const noexcept {
+        return _buffering;
+    }
+
+    // Bursts seen over every connection
+    uint64_t bursts() const noexcept {
+        return _bursts;
+    }
+
+    void reset() noexcept {
+        _last_read.reset();
+        _max_lag_ms.reset();
+        _history = 0;
+        _buffering = false;
+    }
+
+private:
+    Settings _settings;
+    std::optional<Clock::time_point> _last_read;
+    std::optional<double> _max_lag_ms;
+    // One bit per recent read with events, set for bursts
+    uint8_t _history = 0;
+    bool _buffering = false;
+    uint64_t _bursts = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "EventColumns.hpp"
+#include "EventSchema.hpp"
+#include "EventTypeTable.hpp"
+#include "JsonValue.hpp"
+#include "MemoryBudget.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * `schemas`: events of a registered type decoded into one column per field
+ * instead of an object each. The I/O thread appends a row as each event
+ * completes, JS takes every type's batch at once. Numbers accumulate as the
+ * bytes of a Float64Array, int32 fields of an Int32Array and booleans of a
+ * Uint8Array. Strings go into one table per batch, each distinct value once,
+ * and their columns hold Int32 indices into it. A batch of any size crosses
+ * into JS as a handful of buffers without converting a value.
+ * An event missing a required field, or with a field of the wrong type, is
+ * not appended and goes on as an ordinary event.
+ */
+class ColumnarDecoder {
+public:
+    explicit ColumnarDecoder(std::shared_ptr<MemoryBudget::Account> memory) noexcept : _memory(std::move(memory)) {}
+
+    // At create, before any row; a later schema for the same type replaces the earlier one
+    void add_schema(EventTypeTable::Id type, const EventSchema& schema) {
+        Schema compiled;
+        for (const SchemaField& field : schema.fields) {
+            compiled.fields.push_back(Field{field.pointer.value_or("/" + field.name), field.kind, field.required.value_or(true)});
+        }
+        if (type >= _schemas.size()) {
+            _schemas.resize(type + 1);
+        }
+        _schemas[type] = std::move(compiled);
+    }
+
+    bool decodes(EventTypeTable::Id type) const noexcept {
+        return type < _schemas.size() && _schemas[type].has_value();
+    }
+
+    // I/O thread: false, leaving the batch as it was, when `root` does not match the type's schema
+    bool append(EventTypeTable::Id type, const JsonValue& root, std::string_view id) {
+        const Schema& schema = *_schemas[type];
+        // Validated whole first, so a rejected event leaves no partial row behind
+        _values.assign(schema.fields.size(), nullptr);
+        for (size_t i = 0; i < schema.fields.size(); ++i) {
+            const Field& field = schema.fields[i];
+            const JsonValue* value = find_pointer(root, field.pointer);
+            if (!value || std::holds_alternative<std::nullptr_t>(value->value)) {
+                if (field.required) {
+                    return false;
+                }
+                continue;
+            }
+            if (!matches(field.kind, *value)) {
+                return false;
+            }
+            _values[i] = value;
+        }
+
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (type >= _batches.size()) {
+            _batches.resize(type + 1);
+        }
+        Batch& batch = _batches[type];
+        if (batch.rows == 0) {
+            batch.columns.resize(schema.fields.size());
+            _pending.push_back(type);
+        }
+        int64_t bytes = 0;
+        try {
+            append_row(schema, batch, bytes);
+        } catch (const std::bad_alloc&) {
+            // Columns of unequal length would misalign every later row, so the batch goes
+            _memory->charge(-batch.bytes);
+            batch = Batch();
+            _pending.erase(std::find(_pending.begin(), _pending.end(), type));
+            return false;
+        }
+        batch.last_id.assign(id);
+        ++batch.rows;
+        batch.bytes += bytes;
+        _memory->charge(bytes);
+        _rows.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // JS thread: every type's rows, in the order their first rows arrived, and starts over
+    std::vector<EventColumns> take(const EventTypeTable& types) {
+        std::vector<EventColumns> out;
+        const std::lock_guard<std::mutex> lock(_mutex);
+        out.reserve(_pending.size());
+        for (const EventTypeTable::Id type : _pending) {
+            Batch& batch = _batches[type];
+            std::vector<std::shared_ptr<ArrayBuffer>> columns;
+            columns.reserve(batch.columns.size());
+            for (std::vector<uint8_t>& column : batch.columns) {
+                // The rows' bytes become the typed array's buffer as they are
+                columns.push_back(ArrayBuffer::move(std::move(column)));
+            }
+            std::vector<std::string> strings(std::make_move_iterator(batch.strings.begin()),
+                                             std::make_move_iterator(batch.strings.end()));
+            out.emplace_back(types.name(type), static_cast<double>(batch.rows), std::move(batch.last_id), std::move(columns),
+                             std::move(strings));
+            _memory->charge(-batch.bytes);
+            batch = Batch();
+        }
+        _pending.clear();
+        _rows.store(0, std::memory_order_relaxed);
+        return out;
+    }
+
+    // Rows waiting for take(), counted against maxQueuedEvents like queued events
+    size_t rows() const noexcept {
+        return _rows.load(std::memory_order_relaxed);
+    }
+
+    void reset() {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        for (const EventTypeTable::Id type : _pending) {
+            _memory->charge(-_batches[type].bytes);
+            _batches[type] = Batch();
+        }
+        _pending.clear();
+        _rows.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Field {
+        std::string pointer;
+        SchemaFieldKind kind;
+        bool required;
+    };
+    struct Schema {
+        std::vector<Field> fields;
+    };
+    struct Batch {
+        size_t rows = 0;
+        int64_t bytes = 0;
+        std::string last_id;
+        // One per field, in schema order
+        std::vector<std::vector<uint8_t>> columns;
+        // The string table; a deque so the index's views stay valid as it grows
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, int32_t> string_ids;
+    };
+
+    template <typename T>
+    static void put(std::vector<uint8_t>& column, T value) {
+        const size_t at = column.size();
+        column.resize(at + sizeof(value));
+        std::memcpy(column.data() + at, &value, sizeof(value));
+    }
+
+    static int32_t intern(Batch& batch, std::string_view text, int64_t& bytes) {
+        const auto found = batch.string_ids.find(text);
+        if (found != batch.string_ids.end()) {
+            return found->second;
+        }
+        const auto id = static_cast<int32_t>(batch.strings.size());
+        const std::string& stored = batch.strings.emplace_back(text);
+        batch.string_ids.emplace(stored, id);
+        // The table entry and, roughly, its index node
+        bytes += static_cast<int64_t>(2 * sizeof(std::string) + stored.size());
+        return id;
+    }
+
+    void append_row(const Schema& schema, Batch& batch, int64_t& bytes) {
+        for (size_t i = 0; i < schema.fields.size(); ++i) {
+            const Field& field = schema.fields[i];
+            const JsonValue* value = _values[i];
+            std::vector<uint8_t>& column = batch.columns[i];
+            switch (field.kind) {
+                case SchemaFieldKind::NUMBER:
+                case SchemaFieldKind::INTEGER:
+                    // Absent optional numbers read NaN
+                    put(column, value ? std::get<double>(value->value) : std::numeric_limits<double>::quiet_NaN());
+                    bytes += sizeof(double);
+                    break;
+                case SchemaFieldKind::INT32:
+                    // matches() checked the range; absent optional ones read 0
+                    put(column, value ? static_cast<int32_t>(std::get<double>(value->value)) : int32_t{0});
+                    bytes += sizeof(int32_t);
+                    break;
+                case SchemaFieldKind::BOOLEAN:
+                    column.push_back(value && std::get<bool>(value->value) ? 1 : 0);
+                    bytes += 1;
+                    break;
+                case SchemaFieldKind::STRING: {
+                    // Absent optional strings read ''
+                    const std::string_view text = value ? std::string_view(std::get<JsonValue::String>(value->value)) : std::string_view();
+                    put(column, intern(batch, text, bytes));
+                    bytes += sizeof(int32_t);
+                    break;
+                }
+            }
+        }
+    }
+
+    static bool matches(SchemaFieldKind kind, const JsonValue& value) noexcept {
+        switch (kind) {
+            case SchemaFieldKind::NUMBER: return std::holds_alternative<double>(value.value);
+            case SchemaFieldKind::INTEGER: {
+                const auto* number = std::get_if<double>(&value.value);
+                return number && std::isfinite(*number) && std::trunc(*number) == *number;
+            }
+            case SchemaFieldKind::INT32: {
+                const auto* number = std::get_if<double>(&value.value);
+                return number && std::trunc(*number) == *number && *number >= std::numeric_limits<int32_t>::min() &&
+                       *number <= std::numeric_limits<int32_t>::max();
+            }
+            case SchemaFieldKind::BOOLEAN: return std::holds_alternative<bool>(value.value);
+            case SchemaFieldKind::STRING: return std::holds_alternative<JsonValue::String>(value.value);
+        }
+        return false;
+    }
+
+    const std::shared_ptr<MemoryBudget::Account> _memory;
+    // Indexed by type id, fixed once the stream is created
+    std::vector<std::optional<Schema>> _schemas;
+    // I/O thread scratch for append()
+    std::vector<const JsonValue*> _values;
+
+    std::mutex _mutex;
+    std::vector<Batch> _batches;
+    std::vector<EventTypeTable::Id> _pending;
+    std::atomic<size_t> _rows{0};
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,120 @@
+#include "ConnectionSpec.hpp"
+#include "StreamKey.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <variant>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr double DEFAULT_CONNECT_TIMEOUT_MS = 30000.0;
+constexpr double DEFAULT_LOW_SPEED_MS = 30000.0;
+
+std::optional<NitroEventSourceOptions> without_payloads(const std::optional<NitroEventSourceOptions>& options) {
+    std::optional<NitroEventSourceOptions> stripped = options;
+    if (stripped) {
+        stripped->zstdDictionary.reset();
+        stripped->body.reset();
+    }
+    return stripped;
+}
+
+std::optional<std::string> request_body(const std::optional<NitroEventSourceOptions>& options) {
+    if (!options || !options->body) {
+        return std::nullopt;
+    }
+    if (const auto* text = std::get_if<std::string>(&*options->body)) {
+        return *text;
+    }
+    if (const auto& buffer = std::get<std::shared_ptr<ArrayBuffer>>(*options->body)) {
+        return std::string(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+    }
+    return std::string();
+}
+
+TimeoutOptions timeouts(const std::optional<NitroEventSourceOptions>& options) {
+    return options && options->timeouts ? *options->timeouts : TimeoutOptions();
+}
+
+// The connect timeout spans DNS, TCP and the TLS handshake. Low-speed detection aborts
+// a transfer that stays below the rate for the whole window, which curl takes in seconds
+long to_low_speed_seconds(const TimeoutOptions& timeouts) {
+    return static_cast<long>(std::ceil(std::max(1000.0, timeouts.lowSpeedMs.value_or(DEFAULT_LOW_SPEED_MS)) / 1000.0));
+}
+
+} // namespace
+
+uint64_t ConnectionSpec::key_of(const std::string& url, const std::optional<NitroEventSourceOptions>& options) {
+    std::string_view body;
+    if (options && options->body) {
+        if (const auto* text = std::get_if<std::string>(&*options->body)) {
+            body = *text;
+        } else if (const auto& buffer = std::get<std::shared_ptr<ArrayBuffer>>(*options->body)) {
+            body = std::string_view(reinterpret_cast<const char*>(buffer->data()), buffer->size());
+        }
+    }
+    const std::string_view method = options && options->method ? std::string_view(*options->method) : (options && options->body ? "POST" : "GET");
+    return stream_key::compute(url, method, body, options && options->headers ? &*options->headers : nullptr);
+}
+
+ConnectionSpec::ConnectionSpec(const std::string& url, const std::optional<NitroEventSourceOptions>& options, bool zstd_dictionary)
+    : url(url),
+      options(without_payloads(options)),
+      zstd_dictionary(zstd_dictionary),
+      body(request_body(options)),
+      method(options && options->method ? *options->method : (body ? "POST" : "GET")),
+      user_agent(options && options->userAgent ? *options->userAgent : "nitro-event-source/1.0"),
+      with_credentials(options && options->withCredentials.value_or(false)),
+      key(key_of(url, options)),
+      key_hex(stream_key::to_hex(key)),
+      connect_timeout_ms(static_cast<long>(std::max(0.0, timeouts(options).connectMs.value_or(DEFAULT_CONNECT_TIMEOUT_MS)))),
+      low_speed_limit(static_cast<long>(std::max(0.0, timeouts(options).lowSpeedBytesPerSecond.value_or(0.0)))),
+      low_speed_seconds(to_low_speed_seconds(timeouts(options))),
+      _headers(build_headers(options && options->transport == StreamTransport::WEBSOCKET,
+                             options && options->headers ? &*options->headers : nullptr)) {}
+
+ConnectionSpec::~ConnectionSpec() {
+    curl_slist_free_all(_headers);
+}
+
+curl_slist* ConnectionSpec::build_headers(bool websocket, const std::unordered_map<std::string, std::string>* custom) const noexcept {
+    curl_slist* headers = nullptr;
+    const auto append_header = [&](const char* header) {
+        if (curl_slist* list = curl_slist_append(headers, header)) {
+            headers = list;
+        }
+    };
+
+    // fetchMode sends the caller's headers alone, as fetch() would; a WebSocket upgrade has none
+    // of the streaming ones either, and curl writes its Connection header, which keep-alive would replace
+    if (!(options && options->fetchMode.value_or(false)) && !websocket) {
+        switch (options ? options->format.value_or(StreamFormat::SSE) : StreamFormat::SSE) {
+            case StreamFormat::SSE: append_header("Accept: text/event-stream"); break;
+            case StreamFormat::NDJSON: append_header("Accept: application/x-ndjson, application/jsonl, application/json"); break;
+            case StreamFormat::JSON_SEQ: append_header("Accept: application/json-seq"); break;
+        }
+        append_header("Cache-Control: no-cache");
+        append_header("Connection: keep-alive");
+    }
+    if (zstd_dictionary) {
+        append_header("Accept-Encoding: zstd");
+    }
+
+    if (custom) {
+        std::string header;
+        for (const auto& [key, value] : *custom) {
+            try {
+                header.assign(key).append(": ").append(value);
+            } catch (const std::bad_alloc&) {
+                continue;
+            }
+            append_header(header.c_str());
+        }
+    }
+    return headers;
+}
+
+} // namespace margelo::nitro::nitroeventsource
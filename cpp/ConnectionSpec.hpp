@@ -0,0 +1,64 @@
+#pragma once
+
+#include "NitroEventSourceOptions.hpp"
+
+#include <curl/curl.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * What create() was given, converted once into what every attempt sends: the
+ * URL, the options, the request body, the timeouts as curl takes them and the
+ * fixed header block. Immutable, so the stream, its tasks and its metrics
+ * share one by reference instead of copying the options around, and a new
+ * handle after a network change or failover only sets what is already built.
+ * Last-Event-ID and the stateSync version, the only headers that change
+ * between attempts, are linked in front of headers() by the stream.
+ */
+class ConnectionSpec {
+public:
+    // The stream key of these, see StreamKey.hpp; read without building a spec, e.g. for streamKey()
+    static uint64_t key_of(const std::string& url, const std::optional<NitroEventSourceOptions>& options);
+
+    // JS thread, in create(); `zstd_dictionary` is whether the stream decodes the body itself
+    ConnectionSpec(const std::string& url, const std::optional<NitroEventSourceOptions>& options, bool zstd_dictionary);
+    ~ConnectionSpec();
+    ConnectionSpec(const ConnectionSpec&) = delete;
+    ConnectionSpec& operator=(const ConnectionSpec&) = delete;
+
+    const std::string url;
+    // As given, minus zstdDictionary and body: the stream keeps its decoder, and `body` is below
+    const std::optional<NitroEventSourceOptions> options;
+    const bool zstd_dictionary;
+    // method/body: a body implies POST; copied once and sent again on every reconnect
+    const std::optional<std::string> body;
+    const std::string method;
+    const std::string user_agent;
+    // withCredentials: cookies go out from and come back into the shared jar, see CookieJar.hpp
+    const bool with_credentials;
+    // URL, method, body and headers, canonicalized and hashed once; `key_hex` names files by it
+    const uint64_t key;
+    const std::string key_hex;
+    // timeouts; a low_speed_limit of 0 leaves low-speed detection off
+    const long connect_timeout_ms;
+    const long low_speed_limit;
+    const long low_speed_seconds;
+
+    // curl only reads the list; null when it could not be allocated
+    curl_slist* headers() const noexcept {
+        return _headers;
+    }
+
+    // The same block for another transport or after updateHeaders(), which the caller frees
+    curl_slist* build_headers(bool websocket, const std::unordered_map<std::string, std::string>* custom) const noexcept;
+
+private:
+    curl_slist* const _headers;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,101 @@
+#include "CookieJar.hpp"
+#include "StreamKey.hpp"
+
+#include <new>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+// An easy handle only serves to reach the share's jar
+CURL* share_easy(CURLSH* share) noexcept {
+    CURL* easy = share ? curl_easy_init() : nullptr;
+    if (easy && curl_easy_setopt(easy, CURLOPT_SHARE, share) != CURLE_OK) {
+        curl_easy_cleanup(easy);
+        return nullptr;
+    }
+    return easy;
+}
+
+// The host of `url`, without user info, port or IPv6 brackets
+std::string_view host_of(std::string_view url) noexcept {
+    const size_t scheme_end = url.find("://");
+    if (scheme_end != std::string_view::npos) {
+        url.remove_prefix(scheme_end + 3);
+    }
+    url = url.substr(0, url.find_first_of("/?#"));
+    if (const size_t at = url.rfind('@'); at != std::string_view::npos) {
+        url.remove_prefix(at + 1);
+    }
+    if (!url.empty() && url.front() == '[') {
+        return url.substr(1, url.find(']') - 1);
+    }
+    return url.substr(0, url.find(':'));
+}
+
+bool has_domain(std::string_view cookie) {
+    const std::string lowered = stream_key::lower(cookie);
+    for (size_t at = lowered.find(';'); at != std::string::npos; at = lowered.find(';', at + 1)) {
+        if (stream_key::trim(std::string_view(lowered).substr(at + 1)).substr(0, 7) == "domain=") {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+void set_cookies(CURLSH* share, const std::string& url, const std::vector<std::string>& cookies) noexcept {
+    CURL* easy = share_easy(share);
+    if (!easy) {
+        return;
+    }
+
+    const std::string_view host = host_of(url);
+    std::string line;
+    for (const std::string& cookie : cookies) {
+        try {
+            line.assign("Set-Cookie: ").append(cookie);
+            // With no request to take it from, curl would keep a cookie without a domain for no site
+            if (!host.empty() && !has_domain(cookie)) {
+                line.append("; Domain=").append(host);
+            }
+        } catch (const std::bad_alloc&) {
+            continue;
+        }
+        curl_easy_setopt(easy, CURLOPT_COOKIELIST, line.c_str());
+    }
+    curl_easy_cleanup(easy);
+}
+
+std::vector<std::string> list_cookies(CURLSH* share) noexcept {
+    std::vector<std::string> lines;
+    CURL* easy = share_easy(share);
+    if (!easy) {
+        return lines;
+    }
+
+    curl_slist* list = nullptr;
+    if (curl_easy_getinfo(easy, CURLINFO_COOKIELIST, &list) == CURLE_OK) {
+        try {
+            for (const curl_slist* node = list; node; node = node->next) {
+                lines.emplace_back(node->data);
+            }
+        } catch (const std::bad_alloc&) {
+            lines.clear();
+        }
+    }
+    curl_slist_free_all(list);
+    curl_easy_cleanup(easy);
+    return lines;
+}
+
+void clear_cookies(CURLSH* share) noexcept {
+    if (CURL* easy = share_easy(share)) {
+        curl_easy_setopt(easy, CURLOPT_COOKIELIST, "ALL");
+        curl_easy_cleanup(easy);
+    }
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The cookies withCredentials streams send, one in-memory jar in the
+ * TransferEngine's share handle: a Set-Cookie any of their responses carries
+ * goes out with every later request they make to that site, on any stream.
+ * Nothing is written to disk; JS keeps the jar in sync with the platform
+ * store by seeding it with set_cookies() and reading it back with list_cookies().
+ */
+
+// Adds Set-Cookie header values as if `url` had sent them, a cookie without Domain is its host's;
+// curl drops malformed ones without saying
+void set_cookies(CURLSH* share, const std::string& url, const std::vector<std::string>& cookies) noexcept;
+
+// Every cookie in the jar, one Netscape cookie-file line each
+std::vector<std::string> list_cookies(CURLSH* share) noexcept;
+
+void clear_cookies(CURLSH* share) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <time.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * `cpuAccounting`: thread CPU time the I/O thread spends on one stream, split
+ * into parsing, decoding (zstd and JSON) and dispatch. Phases nest, and a scope
+ * pauses the phase it interrupts, so each nanosecond is charged to exactly one.
+ * Costs two CLOCK_THREAD_CPUTIME_ID reads per scope, nothing while disabled.
+ * Scopes open on the I/O thread, WorkerScopes on decode workers, whose time
+ * adds up on its own; milliseconds() is read from any thread.
+ */
+class CpuTimeAccount {
+public:
+    enum class Phase : uint8_t { PARSE = 0, DECODE = 1, DISPATCH = 2 };
+
+    class Scope {
+    public:
+        Scope(CpuTimeAccount& account, Phase phase) noexcept : _account(account._enabled ? &account : nullptr) {
+            if (!_account) {
+                return;
+            }
+            const int64_t now = thread_cpu_ns();
+            _interrupted = _account->_active;
+            if (_interrupted) {
+                _account->charge(*_interrupted, now - _account->_since);
+            }
+            _account->_active = phase;
+            _account->_since = now;
+        }
+        ~Scope() {
+            if (!_account) {
+                return;
+            }
+            const int64_t now = thread_cpu_ns();
+            _account->charge(*_account->_active, now - _account->_since);
+            _account->_active = _interrupted;
+            _account->_since = now;
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        CpuTimeAccount* const _account;
+        std::optional<Phase> _interrupted;
+    };
+
+    // `parallelDecode`: a worker's time on one of the stream's events, charged whole as it ends
+    class WorkerScope {
+    public:
+        WorkerScope(CpuTimeAccount& account, Phase phase) noexcept
+            : _account(account._enabled ? &account : nullptr), _phase(phase), _since(_account ? thread_cpu_ns() : 0) {}
+        ~WorkerScope() {
+            if (_account) {
+                _account->charge(_phase, thread_cpu_ns() - _since);
+            }
+        }
+        WorkerScope(const WorkerScope&) = delete;
+        WorkerScope& operator=(const WorkerScope&) = delete;
+
+    private:
+        CpuTimeAccount* const _account;
+        const Phase _phase;
+        const int64_t _since;
+    };
+
+    void enable() noexcept {
+        _enabled = true;
+    }
+
+    double milliseconds(Phase phase) const noexcept {
+        return static_cast<double>(_ns[static_cast<size_t>(phase)].load(std::memory_order_relaxed)) / 1e6;
+    }
+
+private:
+    static int64_t thread_cpu_ns() noexcept {
+        timespec now{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+    }
+
+    void charge(Phase phase, int64_t ns) noexcept {
+        _ns[static_cast<size_t>(phase)].fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    // Set at create, before the I/O thread sees the stream
+    bool _enabled = false;
+    std::array<std::atomic<int64_t>, 3> _ns{};
+    // I/O thread only: the phase being charged and since when
+    std::optional<Phase> _active;
+    int64_t _since = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,128 @@
+#include "DecodePool.hpp"
+
+#include "Logger.hpp"
+#include "TransferEngine.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <new>
+#include <pthread.h>
+#include <string>
+#include <thread>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+constexpr auto TAG = "DecodePool";
+// The I/O thread keeps a core of its own; a phone gains little past a handful of decoders
+constexpr size_t MAX_WORKERS = 4;
+} // namespace
+
+DecodePool& DecodePool::shared() {
+    // Leaked like the engine, its workers never race static destruction at exit
+    static DecodePool* pool = new DecodePool();
+    return *pool;
+}
+
+DecodePool::DecodePool() {
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t count = std::clamp<size_t>(cores - 1, 1, MAX_WORKERS);
+    for (size_t i = 0; i < count; ++i) {
+        _queues.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        try {
+            // entry() deletes the argument, which stays ours until the thread is running
+            auto start = std::make_unique<Start>(Start{this, i});
+            TransferEngine::spawn_thread(&DecodePool::entry, start.get());
+            start.release();
+            ++_workers;
+        } catch (const std::exception& e) {
+            // Fewer workers, or none: streams then decode on the I/O thread as they would without the pool
+            NITRO_ES_LOG_ERROR(TAG, "Failed to start decode worker: " + std::string(e.what()));
+            break;
+        }
+    }
+}
+
+bool DecodePool::submit(Task task) noexcept {
+    if (_workers == 0) {
+        return false;
+    }
+    try {
+        Queue& queue = *_queues[_next.fetch_add(1, std::memory_order_relaxed) % _workers];
+        {
+            const std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        {
+            const std::lock_guard<std::mutex> lock(_idle_mutex);
+            ++_unclaimed;
+        }
+        _idle.notify_one();
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+void* DecodePool::entry(void* argument) noexcept {
+    const Start start = *static_cast<Start*>(argument);
+    delete static_cast<Start*>(argument);
+#if defined(__APPLE__)
+    pthread_setname_np("nitro-es-decode");
+#else
+    pthread_setname_np(pthread_self(), "nitro-es-decode");
+#endif
+    start.pool->run(start.index);
+    return nullptr;
+}
+
+void DecodePool::run(size_t index) noexcept {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(_idle_mutex);
+            _idle.wait(lock, [this]() { return _unclaimed > 0; });
+            --_unclaimed;
+        }
+        // Claimed: the task was queued before it was counted, so some queue holds it, or will
+        // once the worker that took ours instead finds its own
+        for (;;) {
+            std::optional<Task> task;
+            try {
+                task = take(index);
+            } catch (const std::exception&) {
+            }
+            if (task) {
+                (*task)();
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+std::optional<DecodePool::Task> DecodePool::take(size_t index) {
+    {
+        Queue& own = *_queues[index];
+        const std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            Task task = std::move(own.tasks.front());
+            own.tasks.pop_front();
+            return task;
+        }
+    }
+    for (size_t offset = 1; offset < _workers; ++offset) {
+        Queue& other = *_queues[(index + offset) % _workers];
+        const std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            Task task = std::move(other.tasks.back());
+            other.tasks.pop_back();
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * `parallelDecode`: a few worker threads decoding large JSON payloads for the
+ * I/O thread, shared by every stream. Tasks go to the workers' own queues in
+ * turn; a worker takes the oldest of its own and, once that runs dry, steals
+ * the newest of another's, so a burst from one stream spreads over every core
+ * and no worker idles while work waits elsewhere. The pool knows nothing about
+ * ordering: streams put their results back in sequence themselves.
+ */
+class DecodePool {
+public:
+    using Task = std::function<void()>;
+
+    static DecodePool& shared();
+
+    DecodePool(const DecodePool&) = delete;
+    DecodePool& operator=(const DecodePool&) = delete;
+
+    // Thread-safe: false when no worker runs or the task cannot be queued; the caller decodes itself then
+    bool submit(Task task) noexcept;
+
+private:
+    DecodePool();
+    ~DecodePool() = default;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    struct Start {
+        DecodePool* pool;
+        size_t index;
+    };
+
+    static void* entry(void* argument) noexcept;
+    void run(size_t index) noexcept;
+    std::optional<Task> take(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> _queues;
+    // Workers that started; tasks only go to their queues
+    size_t _workers = 0;
+    std::atomic<size_t> _next{0};
+
+    // Queued tasks no worker has claimed yet; each waking worker claims one before looking for it
+    std::mutex _idle_mutex;
+    std::condition_variable _idle;
+    size_t _unclaimed = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,137 @@
+#include "DeviceLoad.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <dispatch/dispatch.h>
+#include <notify.h>
+#if __has_include(<libkern/OSThermalNotification.h>)
+#include <libkern/OSThermalNotification.h>
+#endif
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+DeviceLoad& DeviceLoad::shared() {
+    // Intentionally leaked like the NetworkMonitor, the platform keeps reporting until exit
+    static DeviceLoad* load = [] {
+        auto* instance = new DeviceLoad();
+        start_platform_monitor();
+        return instance;
+    }();
+    return *load;
+}
+
+uint64_t DeviceLoad::subscribe(Listener listener) {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t id = _next_id++;
+    _listeners.emplace(id, std::move(listener));
+    return id;
+}
+
+void DeviceLoad::unsubscribe(uint64_t id) noexcept {
+    Listener listener;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _listeners.find(id);
+        if (it == _listeners.end()) {
+            return;
+        }
+        // Destroyed outside the lock, it may hold the last reference to a stream
+        listener = std::move(it->second);
+        _listeners.erase(it);
+    }
+}
+
+void DeviceLoad::report_memory(Level level) noexcept {
+    update(&DeviceLoad::_memory, level);
+}
+
+void DeviceLoad::report_thermal(Level level) noexcept {
+    update(&DeviceLoad::_thermal, level);
+}
+
+void DeviceLoad::update(Level DeviceLoad::*signal, Level level) noexcept {
+    std::vector<Listener> listeners;
+    Level combined;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        this->*signal = level;
+        combined = std::max(_memory, _thermal);
+        if (_level.exchange(combined, std::memory_order_acq_rel) == combined) {
+            return;
+        }
+        try {
+            listeners.reserve(_listeners.size());
+            for (const auto& [id, listener] : _listeners) {
+                listeners.push_back(listener);
+            }
+        } catch (...) {
+            return;
+        }
+    }
+
+    for (const Listener& listener : listeners) {
+        try {
+            listener(combined);
+        } catch (...) {
+            // A listener only posts to the I/O thread, there is nobody to report to
+        }
+    }
+}
+
+#if defined(__APPLE__)
+
+void DeviceLoad::start_platform_monitor() noexcept {
+    // Kept for the life of the process, so neither source is ever released. Reports wait on
+    // shared(), which is still being initialized here, so all of them come from the queue
+    dispatch_queue_t queue = dispatch_queue_create("com.nitroeventsource.load", DISPATCH_QUEUE_SERIAL);
+
+    // What UIKit's memory warnings are raised from; unlike them it also reports the way back
+    dispatch_source_t memory = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE, 0,
+                                                      DISPATCH_MEMORYPRESSURE_NORMAL | DISPATCH_MEMORYPRESSURE_WARN |
+                                                          DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                      queue);
+    if (memory) {
+        dispatch_source_set_event_handler(memory, ^{
+            const uintptr_t pressure = dispatch_source_get_data(memory);
+            DeviceLoad::shared().report_memory((pressure & DISPATCH_MEMORYPRESSURE_CRITICAL) ? Level::CRITICAL
+                                               : (pressure & DISPATCH_MEMORYPRESSURE_WARN)   ? Level::ELEVATED
+                                                                                             : Level::NORMAL);
+        });
+        dispatch_resume(memory);
+    }
+
+#if __has_include(<libkern/OSThermalNotification.h>)
+    // ProcessInfo.thermalState without Foundation: moderate is `fair`, heavy is `serious`
+    const auto report_thermal_state = [](int token) {
+        uint64_t state = kOSThermalPressureLevelNominal;
+        if (notify_get_state(token, &state) != NOTIFY_STATUS_OK) {
+            return;
+        }
+        DeviceLoad::shared().report_thermal(state >= kOSThermalPressureLevelHeavy      ? Level::CRITICAL
+                                            : state >= kOSThermalPressureLevelModerate ? Level::ELEVATED
+                                                                                       : Level::NORMAL);
+    };
+    int token = 0;
+    if (notify_register_dispatch(kOSThermalNotificationPressureLevelName, &token, queue, ^(int changed) {
+            report_thermal_state(changed);
+        }) == NOTIFY_STATUS_OK) {
+        // A device already throttling when the first stream opens
+        dispatch_async(queue, ^{
+            report_thermal_state(token);
+        });
+    }
+#endif
+}
+
+#elif !defined(__ANDROID__)
+
+void DeviceLoad::start_platform_monitor() noexcept {}
+
+#endif
+// Android: DeviceLoadAndroid.cpp, both signals are only reachable through Java
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Process-wide memory pressure and thermal state, fed by the platform: the
+ * memory pressure dispatch source and the thermal pressure notification on
+ * Apple platforms, onTrimMemory() and the thermal status listener on Android.
+ * Elsewhere nothing reports and the device never reads as loaded. The level
+ * is the worse of the two; listeners run on whichever thread the platform
+ * reports from, whenever it changes. Streams apply their `underLoad` policy.
+ */
+class DeviceLoad {
+public:
+    enum class Level : uint8_t { NORMAL, ELEVATED, CRITICAL };
+    using Listener = std::function<void(Level)>;
+
+    static DeviceLoad& shared();
+
+    DeviceLoad(const DeviceLoad&) = delete;
+    DeviceLoad& operator=(const DeviceLoad&) = delete;
+
+    uint64_t subscribe(Listener listener);
+    void unsubscribe(uint64_t id) noexcept;
+
+    Level level() const noexcept { return _level.load(std::memory_order_acquire); }
+
+    // Platform glue
+    void report_memory(Level level) noexcept;
+    void report_thermal(Level level) noexcept;
+
+private:
+    DeviceLoad() = default;
+    ~DeviceLoad() = default;
+
+    // Defined per platform, starts delivering report_*() calls
+    static void start_platform_monitor() noexcept;
+    void update(Level DeviceLoad::*signal, Level level) noexcept;
+
+    std::atomic<Level> _level{Level::NORMAL};
+    std::mutex _mutex;
+    Level _memory = Level::NORMAL;
+    Level _thermal = Level::NORMAL;
+    uint64_t _next_id = 1;
+    std::unordered_map<uint64_t, Listener> _listeners;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Log2 histogram of durations in microseconds, recorded from one thread and
+ * read from any. Bucket 0 holds samples under 1 µs, bucket i those in
+ * [2^(i-1), 2^i) µs, the last one everything longer. Counts are relaxed,
+ * so a snapshot taken mid-record may be off by that one sample.
+ */
+class DurationHistogram {
+public:
+    static constexpr size_t BUCKETS = 28;
+
+    void record(std::chrono::nanoseconds elapsed) noexcept {
+        const uint64_t micros = elapsed.count() > 0 ? static_cast<uint64_t>(elapsed.count()) / 1000 : 0;
+        size_t bucket = 0;
+        for (uint64_t rest = micros; rest != 0 && bucket + 1 < BUCKETS; rest >>= 1) {
+            ++bucket;
+        }
+        _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        _sum_us.fetch_add(micros, std::memory_order_relaxed);
+        if (micros > _max_us.load(std::memory_order_relaxed)) {
+            _max_us.store(micros, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyHistogram snapshot() const {
+        std::array<uint64_t, BUCKETS> counts{};
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            counts[i] = _buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        // Percentiles resolve to the upper bound of their bucket, capped by the largest sample
+        const double max_us = static_cast<double>(_max_us.load(std::memory_order_relaxed));
+        const auto percentile = [&](double fraction) {
+            const auto rank = static_cast<uint64_t>(fraction * static_cast<double>(total));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += counts[i];
+                if (seen > rank) {
+                    return std::min(max_us, static_cast<double>(uint64_t{1} << i));
+                }
+            }
+            return max_us;
+        };
+
+        return LatencyHistogram(static_cast<double>(total),
+                                static_cast<double>(_sum_us.load(std::memory_order_relaxed)),
+                                max_us,
+                                total ? percentile(0.5) : 0.0,
+                                total ? percentile(0.9) : 0.0,
+                                total ? percentile(0.99) : 0.0,
+                                std::vector<double>(counts.begin(), counts.end()));
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> _buckets{};
+    std::atomic<uint64_t> _sum_us{0};
+    std::atomic<uint64_t> _max_us{0};
+};
+
+} // namespace margelo::nitro::nitroeventsource
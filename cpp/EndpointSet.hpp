@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The URLs one stream may connect to and how each has fared. Attempts go to the
+ * healthy endpoint that opened fastest, with recent failures counting against it;
+ * one that fails sits out a cooldown that doubles per consecutive failure, so the
+ * next attempt rotates to another. Untried endpoints rank first and are each
+ * measured once. An endpoint's redirect can be cached for a while, attempts then
+ * connect straight to its target. Owned by the TransferEngine I/O thread.
+ */
+class EndpointSet {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t NONE = SIZE_MAX;
+
+    // The index of `url`, added unless it is there already
+    size_t add(const std::string& url) {
+        for (size_t i = 0; i < _endpoints.size(); ++i) {
+            if (_endpoints[i].url == url) {
+                return i;
+            }
+        }
+        _endpoints.push_back(Endpoint{url});
+        return _endpoints.size() - 1;
+    }
+
+    size_t size() const noexcept {
+        return _endpoints.size();
+    }
+
+    const std::string& url(size_t index) const noexcept {
+        return _endpoints[index].url;
+    }
+
+    // The endpoint to connect to next other than `excluded`, NONE when there is no other.
+    // Without a healthy one, the one whose cooldown ends first
+    size_t select(Clock::time_point now, size_t excluded = NONE) const noexcept {
+        size_t best = NONE;
+        for (size_t i = 0; i < _endpoints.size(); ++i) {
+            if (i != excluded && (best == NONE || ranks_before(_endpoints[i], _endpoints[best], now))) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    // `open_ms`: from starting the attempt until the response opened
+    void record_open(size_t index, double open_ms) noexcept {
+        Endpoint& endpoint = _endpoints[index];
+        endpoint.open_ms = endpoint.measured ? endpoint.open_ms + WEIGHT * (open_ms - endpoint.open_ms) : open_ms;
+        endpoint.measured = true;
+        endpoint.failure_rate -= WEIGHT * endpoint.failure_rate;
+        endpoint.consecutive_failures = 0;
+        endpoint.cooldown_until = Clock::time_point();
+    }
+
+    // redirectCache: `index` redirected to `url`, which attempts connect to directly until `until`
+    void record_redirect(size_t index, const std::string& url, Clock::time_point until) {
+        Endpoint& endpoint = _endpoints[index];
+        endpoint.redirect = url;
+        endpoint.redirect_until = until;
+    }
+
+    void forget_redirect(size_t index) noexcept {
+        _endpoints[index].redirect.clear();
+    }
+
+    // The URL an attempt at `index` connects to: its cached redirect target, or else its own
+    const std::string& target(size_t index, Clock::time_point now) const noexcept {
+        const Endpoint& endpoint = _endpoints[index];
+        return !endpoint.redirect.empty() && now < endpoint.redirect_until ? endpoint.redirect : endpoint.url;
+    }
+
+    void record_failure(size_t index, Clock::time_point now) noexcept {
+        constexpr uint32_t MAX_COOLDOWN_EXPONENT = 8;
+        Endpoint& endpoint = _endpoints[index];
+        endpoint.failure_rate += WEIGHT * (1.0 - endpoint.failure_rate);
+        const uint32_t exponent = std::min(endpoint.consecutive_failures++, MAX_COOLDOWN_EXPONENT);
+        endpoint.cooldown_until = now + std::min(BASE_COOLDOWN * (1 << exponent), MAX_COOLDOWN);
+    }
+
+private:
+    // Share of the newest sample in the moving averages
+    static constexpr double WEIGHT = 0.3;
+    // An endpoint failing every attempt ranks as if it opened this much slower
+    static constexpr double FAILURE_PENALTY_MS = 2000.0;
+    static constexpr std::chrono::milliseconds BASE_COOLDOWN{1000};
+    static constexpr std::chrono::milliseconds MAX_COOLDOWN{300000};
+
+    struct Endpoint {
+        std::string url;
+        double open_ms = 0.0;
+        double failure_rate = 0.0;
+        bool measured = false;
+        uint32_t consecutive_failures = 0;
+        Clock::time_point cooldown_until{};
+        std::string redirect{};
+        Clock::time_point redirect_until{};
+    };
+
+    static double score(const Endpoint& endpoint) noexcept {
+        return (endpoint.measured ? endpoint.open_ms : 0.0) + endpoint.failure_rate * FAILURE_PENALTY_MS;
+    }
+
+    // Ties keep the earlier endpoint, so the stream's own URL goes first
+    static bool ranks_before(const Endpoint& candidate, const Endpoint& best, Clock::time_point now) noexcept {
+        const bool candidate_ready = candidate.cooldown_until <= now;
+        const bool best_ready = best.cooldown_until <= now;
+        if (candidate_ready != best_ready) {
+            return candidate_ready;
+        }
+        if (!candidate_ready) {
+            return candidate.cooldown_until < best.cooldown_until;
+        }
+        return score(candidate) < score(best);
+    }
+
+    std::vector<Endpoint> _endpoints;
+};
+
+} // namespace margelo::nitro::nitroeventsource
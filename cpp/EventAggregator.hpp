@@ -0,0 +1,95 @@
+#pragma once
+
+#include "EventTypeTable.hpp"
+#include "JsonValue.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The `aggregation` window: per event type, how many events arrived and the
+ * count, sum, min and max of their numeric values. summarize() writes the
+ * window as one JSON object keyed by type and starts the next one. Owned by
+ * the I/O thread.
+ */
+class EventAggregator {
+public:
+    // An event of `type`, with its value when it carried a finite number
+    void add(EventTypeTable::Id type, std::optional<double> value) {
+        if (type >= _stats.size()) {
+            _stats.resize(type + 1);
+        }
+        Stats& stats = _stats[type];
+        if (stats.events++ == 0) {
+            _seen.push_back(type);
+        }
+        if (!value || !std::isfinite(*value)) {
+            return;
+        }
+        stats.min = stats.count == 0 ? *value : std::min(stats.min, *value);
+        stats.max = stats.count == 0 ? *value : std::max(stats.max, *value);
+        stats.sum += *value;
+        ++stats.count;
+    }
+
+    bool empty() const noexcept {
+        return _seen.empty();
+    }
+
+    // {"<type>":{"events":n,"count":n,"sum":x,"min":x,"max":x,"mean":x},...} in first-seen order;
+    // the value statistics are left out for a type none of whose events carried a number
+    void summarize(const EventTypeTable& types, std::string& out) {
+        out += '{';
+        for (size_t i = 0; i < _seen.size(); ++i) {
+            Stats& stats = _stats[_seen[i]];
+            if (i != 0) {
+                out += ',';
+            }
+            serialize_string(types.name(_seen[i]), out);
+            out += ":{\"events\":";
+            serialize_number(static_cast<double>(stats.events), out);
+            out += ",\"count\":";
+            serialize_number(static_cast<double>(stats.count), out);
+            if (stats.count > 0) {
+                out += ",\"sum\":";
+                serialize_number(stats.sum, out);
+                out += ",\"min\":";
+                serialize_number(stats.min, out);
+                out += ",\"max\":";
+                serialize_number(stats.max, out);
+                out += ",\"mean\":";
+                serialize_number(stats.sum / static_cast<double>(stats.count), out);
+            }
+            out += '}';
+            stats = Stats();
+        }
+        out += '}';
+        _seen.clear();
+    }
+
+    void reset() noexcept {
+        std::fill(_stats.begin(), _stats.end(), Stats());
+        _seen.clear();
+    }
+
+private:
+    struct Stats {
+        uint64_t events = 0;
+        uint64_t count = 0;
+        double sum = 0;
+        double min = 0;
+        double max = 0;
+    };
+
+    // Indexed by type id, only the types in _seen are not zero
+    std::vector<Stats> _stats;
+    std::vector<EventTypeTable::Id> _seen;
+};
+
+} // namespace margelo::nitro::nitroeventsource
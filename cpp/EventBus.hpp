@@ -0,0 +1,275 @@
+#pragma once
+
+#include "EventTypeTable.hpp"
+#include "SpscQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Fans the events of one stream out to its subscribers natively, each with
+ * its own queue, type filter and wake-up, so a consumer only pays for the
+ * events it wants. An entry is shared, not copied, by the queues it goes to.
+ * subscribe(), unsubscribe() and drain() run on the JS thread; publish(),
+ * set_types() and set_paused() on the I/O thread, which reads a copy of the
+ * subscriber list that is only refreshed after it changed. A paused
+ * subscriber, e.g. an off-screen consumer, keeps only the latest entry of
+ * each type but open and error, and is not woken for them until it resumes.
+ */
+template <typename Entry>
+class EventBus {
+public:
+    using Id = uint64_t;
+    using Wake = std::function<void()>;
+
+    Id subscribe(Wake wake) {
+        auto subscriber = std::make_shared<Subscriber>(std::move(wake));
+        const std::lock_guard<std::mutex> lock(_mutex);
+        const Id id = _next_id++;
+        _subscribers.emplace(id, std::move(subscriber));
+        _size.store(_subscribers.size(), std::memory_order_relaxed);
+        _version.fetch_add(1);
+        return id;
+    }
+
+    void unsubscribe(Id id) {
+        // Released outside the lock, the wake-up may hold a JS function
+        std::shared_ptr<Subscriber> removed;
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            const auto it = _subscribers.find(id);
+            if (it == _subscribers.end()) {
+                return;
+            }
+            removed = std::move(it->second);
+            _subscribers.erase(it);
+            _size.store(_subscribers.size(), std::memory_order_relaxed);
+            _version.fetch_add(1);
+        }
+        // The publisher's copy may still list it until its next refresh
+        removed->active.store(false);
+    }
+
+    void clear() {
+        std::unordered_map<Id, std::shared_ptr<Subscriber>> removed;
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            removed.swap(_subscribers);
+            _size.store(0, std::memory_order_relaxed);
+            _version.fetch_add(1);
+        }
+        for (auto& [id, subscriber] : removed) {
+            subscriber->active.store(false);
+        }
+    }
+
+    bool empty() const noexcept {
+        return _size.load(std::memory_order_relaxed) == 0;
+    }
+
+    // I/O thread: the types `id` receives, by interned id; unset receives every type
+    void set_types(Id id, std::optional<std::vector<bool>> types) {
+        if (const std::shared_ptr<Subscriber> subscriber = find(id)) {
+            subscriber->types = std::move(types);
+        }
+    }
+
+    // I/O thread: resuming queues what was held, oldest first, and wakes the subscriber
+    void set_paused(Id id, bool paused) {
+        const std::shared_ptr<Subscriber> subscriber = find(id);
+        if (!subscriber || subscriber->paused == paused) {
+            return;
+        }
+        subscriber->paused = paused;
+        if (paused) {
+            return;
+        }
+        std::vector<Held> held;
+        held.swap(subscriber->held);
+        size_t queued = 0;
+        for (Held& each : held) {
+            try {
+                (each.priority ? subscriber->priority_queue : subscriber->queue).push(std::move(each.entry));
+                ++queued;
+            } catch (const std::bad_alloc&) {
+            }
+        }
+        if (queued > 0) {
+            subscriber->queued.fetch_add(queued);
+            subscriber->wake_once();
+        }
+    }
+
+    // I/O thread: queues `entry` for every subscriber taking `type`, waking those that drained since.
+    // A subscriber already holding `max_queued` entries misses it, unless it is `priority`, which
+    // drains first; returns how many missed it
+    size_t publish(const std::shared_ptr<Entry>& entry, EventTypeTable::Id type, size_t max_queued, bool priority = false) noexcept {
+        refresh();
+        size_t missed = 0;
+        for (const std::shared_ptr<Subscriber>& subscriber : _snapshot) {
+            if (!subscriber->active.load(std::memory_order_relaxed) || !subscriber->takes(type)) {
+                continue;
+            }
+            // Connection events still go through, so a paused subscriber sees the stream end
+            if (subscriber->paused && type != EventTypeTable::OPEN && type != EventTypeTable::ERROR) {
+                if (!subscriber->hold(entry, type, priority)) {
+                    ++missed;
+                }
+                continue;
+            }
+            if (!priority && subscriber->queued.load() >= max_queued) {
+                ++missed;
+                continue;
+            }
+            try {
+                (priority ? subscriber->priority_queue : subscriber->queue).push(entry);
+            } catch (const std::bad_alloc&) {
+                ++missed;
+                continue;
+            }
+            subscriber->queued.fetch_add(1);
+            subscriber->wake_once();
+        }
+        return missed;
+    }
+
+    // I/O thread: entries waiting in the longest subscriber queue
+    size_t largest_queue() noexcept {
+        refresh();
+        size_t largest = 0;
+        for (const std::shared_ptr<Subscriber>& subscriber : _snapshot) {
+            largest = std::max(largest, subscriber->queued.load(std::memory_order_relaxed));
+        }
+        return largest;
+    }
+
+    // JS thread: up to `max_entries` of the entries queued for `id`, in order
+    std::vector<std::shared_ptr<Entry>> drain(Id id, size_t max_entries) {
+        std::vector<std::shared_ptr<Entry>> entries;
+        const std::shared_ptr<Subscriber> subscriber = find(id);
+        if (!subscriber) {
+            return entries;
+        }
+        // Re-arm before popping so anything published after the last pop wakes it again
+        subscriber->drain_pending.store(false);
+        while (entries.size() < max_entries) {
+            std::optional<std::shared_ptr<Entry>> entry = subscriber->priority_queue.pop();
+            if (!entry) {
+                entry = subscriber->queue.pop();
+            }
+            if (!entry) {
+                break;
+            }
+            entries.push_back(std::move(*entry));
+        }
+        subscriber->queued.fetch_sub(entries.size());
+        if (max_entries > 0 && entries.size() == max_entries && subscriber->queued.load() > 0) {
+            subscriber->wake_once();
+        }
+        return entries;
+    }
+
+private:
+    struct Held {
+        EventTypeTable::Id type;
+        std::shared_ptr<Entry> entry;
+        bool priority;
+    };
+
+    struct Subscriber {
+        explicit Subscriber(Wake wake) : wake(std::move(wake)) {}
+
+        bool takes(EventTypeTable::Id type) const noexcept {
+            // Types that were never interned cannot be in the filter
+            return !types || (type < types->size() && (*types)[type]);
+        }
+
+        // Replaces the entry held for `type`, which then counts as the newest
+        bool hold(const std::shared_ptr<Entry>& entry, EventTypeTable::Id type, bool priority) noexcept {
+            const auto it = std::find_if(held.begin(), held.end(), [type](const Held& each) { return each.type == type; });
+            if (it != held.end()) {
+                held.erase(it);
+            }
+            try {
+                held.push_back(Held{type, entry, priority});
+            } catch (const std::bad_alloc&) {
+                return false;
+            }
+            return true;
+        }
+
+        void wake_once() noexcept {
+            // One wake-up per drain cycle no matter how many entries were queued meanwhile
+            if (drain_pending.exchange(true) || !wake) {
+                return;
+            }
+            try {
+                wake();
+            } catch (...) {
+            }
+        }
+
+        const Wake wake;
+        SpscQueue<std::shared_ptr<Entry>> queue;
+        SpscQueue<std::shared_ptr<Entry>> priority_queue;
+        std::atomic<size_t> queued{0};
+        std::atomic<bool> drain_pending{false};
+        std::atomic<bool> active{true};
+        // I/O thread only
+        std::optional<std::vector<bool>> types;
+        bool paused = false;
+        std::vector<Held> held;
+    };
+
+    std::shared_ptr<Subscriber> find(Id id) {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _subscribers.find(id);
+        return it == _subscribers.end() ? nullptr : it->second;
+    }
+
+    void refresh() noexcept {
+        // Hot path: nothing changed since the last event, no lock and no allocation
+        if (_version.load() == _snapshot_version) {
+            return;
+        }
+        try {
+            std::vector<std::pair<Id, std::shared_ptr<Subscriber>>> ordered;
+            {
+                const std::lock_guard<std::mutex> lock(_mutex);
+                _snapshot_version = _version.load();
+                ordered.assign(_subscribers.begin(), _subscribers.end());
+            }
+            // Ids grow monotonically, so sorting by id keeps subscription order
+            std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+            _snapshot.clear();
+            for (auto& [id, subscriber] : ordered) {
+                _snapshot.push_back(std::move(subscriber));
+            }
+        } catch (const std::bad_alloc&) {
+            _snapshot_version = 0;
+        }
+    }
+
+    mutable std::mutex _mutex;
+    std::unordered_map<Id, std::shared_ptr<Subscriber>> _subscribers;
+    Id _next_id = 1;
+    std::atomic<uint64_t> _version{0};
+    std::atomic<size_t> _size{0};
+
+    // I/O thread only
+    std::vector<std::shared_ptr<Subscriber>> _snapshot;
+    uint64_t _snapshot_version = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
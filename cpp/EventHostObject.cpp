@@ -0,0 +1,163 @@
+#include "EventHostObject.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace jsi_utils {
+
+    jsi::Value to_jsi(jsi::Runtime& runtime, const JsonValue& json) {
+        return std::visit([&](const auto& value) -> jsi::Value {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_same_v<T, std::nullptr_t>) {
+                return jsi::Value::null();
+            } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, double>) {
+                return jsi::Value(value);
+            } else if constexpr (std::is_same_v<T, JsonValue::String>) {
+                return jsi::String::createFromUtf8(runtime, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+            } else if constexpr (std::is_same_v<T, JsonValue::Array>) {
+                jsi::Array array(runtime, value.size());
+                for (size_t i = 0; i < value.size(); ++i) {
+                    array.setValueAtIndex(runtime, i, to_jsi(runtime, value[i]));
+                }
+                return array;
+            } else {
+                jsi::Object object(runtime);
+                for (const auto& [key, member] : value) {
+                    object.setProperty(runtime, jsi::PropNameID::forUtf8(runtime, reinterpret_cast<const uint8_t*>(key.data()), key.size()), to_jsi(runtime, member));
+                }
+                return object;
+            }
+        }, json.value);
+    }
+    bool utf16_payloads(jsi::Runtime& runtime) {
+#if NITRO_ES_UTF16_STRINGS
+        // HermesRuntimeImpl, and the decorators wrapping it in debug builds, describe themselves so
+        return runtime.description().find("HermesRuntime") != std::string::npos;
+#else
+        (void)runtime;
+        return false;
+#endif
+    }
+
+    std::u16string utf8_to_utf16(std::string_view text) {
+        std::u16string out;
+        out.reserve(text.size());
+        const auto* bytes = reinterpret_cast<const uint8_t*>(text.data());
+        const size_t size = text.size();
+        for (size_t i = 0; i < size;) {
+            const uint8_t lead = bytes[i];
+            if (lead < 0x80) {
+                out.push_back(lead);
+                ++i;
+                continue;
+            }
+            size_t extra = 0;
+            uint32_t point = 0;
+            uint32_t min = 0;
+            if ((lead & 0xe0) == 0xc0) {
+                extra = 1;
+                point = lead & 0x1f;
+                min = 0x80;
+            } else if ((lead & 0xf0) == 0xe0) {
+                extra = 2;
+                point = lead & 0x0f;
+                min = 0x800;
+            } else if ((lead & 0xf8) == 0xf0) {
+                extra = 3;
+                point = lead & 0x07;
+                min = 0x10000;
+            }
+            bool valid = extra > 0 && i + extra < size;
+            for (size_t k = 1; valid && k <= extra; ++k) {
+                valid = (bytes[i + k] & 0xc0) == 0x80;
+                point = (point << 6) | (bytes[i + k] & 0x3f);
+            }
+            // Overlong forms, surrogates and code points past U+10FFFF are invalid too
+            if (!valid || point < min || point > 0x10ffff || (point >= 0xd800 && point <= 0xdfff)) {
+                out.push_back(u'\ufffd');
+                ++i;
+                continue;
+            }
+            if (point >= 0x10000) {
+                point -= 0x10000;
+                out.push_back(static_cast<char16_t>(0xd800 | (point >> 10)));
+                out.push_back(static_cast<char16_t>(0xdc00 | (point & 0x3ff)));
+            } else {
+                out.push_back(static_cast<char16_t>(point));
+            }
+            i += 1 + extra;
+        }
+        return out;
+    }
+} // namespace jsi_utils
+
+jsi::Value EventHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& name) {
+    const std::string property = name.utf8(runtime);
+
+    if (property == "type") {
+        return jsi::String::createFromUtf8(runtime, _payload.event.type);
+    }
+    if (property == "data") {
+        return jsi_utils::to_jsi_string(runtime, _payload.event.data, _payload.ascii, _payload.utf16 ? &*_payload.utf16 : nullptr);
+    }
+    if (property == "id") {
+        return jsi::String::createFromUtf8(runtime, _payload.event.id);
+    }
+    if (property == "json" && _payload.json) {
+        return jsi_utils::to_jsi(runtime, _payload.json->root);
+    }
+    if (property == "chunk" && _payload.event.chunk) {
+        return JSIConverter<DataChunk>::toJSI(runtime, *_payload.event.chunk);
+    }
+    if (property == "paths" && _payload.event.paths) {
+        return JSIConverter<std::vector<std::string>>::toJSI(runtime, *_payload.event.paths);
+    }
+    if (property == "error" && _payload.event.error) {
+        return JSIConverter<StreamError>::toJSI(runtime, *_payload.event.error);
+    }
+    if (property == "timing" && _payload.event.timing) {
+        return JSIConverter<ConnectionTiming>::toJSI(runtime, *_payload.event.timing);
+    }
+    if (property == "receivedAt" && _payload.event.receivedAt) {
+        return *_payload.event.receivedAt;
+    }
+    if (property == "sequence" && _payload.event.sequence) {
+        return *_payload.event.sequence;
+    }
+    return jsi::Value::undefined();
+}
+
+std::vector<jsi::PropNameID> EventHostObject::getPropertyNames(jsi::Runtime& runtime) {
+    std::vector<jsi::PropNameID> names;
+    names.push_back(jsi::PropNameID::forAscii(runtime, "id"));
+    names.push_back(jsi::PropNameID::forAscii(runtime, "type"));
+    names.push_back(jsi::PropNameID::forAscii(runtime, "data"));
+    if (_payload.json) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "json"));
+    }
+    if (_payload.event.chunk) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "chunk"));
+    }
+    if (_payload.event.paths) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "paths"));
+    }
+    if (_payload.event.error) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "error"));
+    }
+    if (_payload.event.timing) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "timing"));
+    }
+    if (_payload.event.receivedAt) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "receivedAt"));
+    }
+    if (_payload.event.sequence) {
+        names.push_back(jsi::PropNameID::forAscii(runtime, "sequence"));
+    }
+    return names;
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "JsonValue.hpp"
+#include "NitroEventSourceEvent.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// JSI 19 added String::createFromUtf16; Hermes, whose strings are UTF-16 inside, copies
+// such text as is instead of decoding UTF-8 on the JS thread
+#if defined(JSI_VERSION) && JSI_VERSION >= 19
+#define NITRO_ES_UTF16_STRINGS 1
+#else
+#define NITRO_ES_UTF16_STRINGS 0
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace jsi_utils {
+    jsi::Value to_jsi(jsi::Runtime& runtime, const JsonValue& json);
+    // Text the parser found to be ASCII only skips UTF-8 decoding; text converted to UTF-16 on
+    // the I/O thread skips it too, see utf16_payloads()
+    inline jsi::String to_jsi_string(jsi::Runtime& runtime, const std::string& text, bool ascii,
+                                     const std::u16string* utf16 = nullptr) {
+#if NITRO_ES_UTF16_STRINGS
+        if (utf16) {
+            return jsi::String::createFromUtf16(runtime, utf16->data(), utf16->size());
+        }
+#else
+        (void)utf16;
+#endif
+        return ascii ? jsi::String::createFromAscii(runtime, text) : jsi::String::createFromUtf8(runtime, text);
+    }
+
+    // Default utf16MinBytes: payloads at least this long and not ASCII are worth converting ahead of the drain
+    inline constexpr size_t UTF16_MIN_BYTES = 1024;
+
+    // Whether `runtime` takes UTF-16 without converting it; other engines' createFromUtf16
+    // goes through UTF-8 again, so only Hermes is worth it
+    bool utf16_payloads(jsi::Runtime& runtime);
+
+    // As Hermes decodes UTF-8: an invalid sequence becomes one U+FFFD per byte
+    std::u16string utf8_to_utf16(std::string_view text);
+} // namespace jsi_utils
+
+// What a lazy event reads from; shared by the subscribers of a stream's EventBus
+struct EventPayload {
+    NitroEventSourceEvent event;
+    std::optional<JsonDocument> json;
+    bool ascii = false;
+    // `data` as UTF-16, set for long non-ASCII payloads headed for Hermes
+    std::optional<std::u16string> utf16{};
+};
+
+/**
+ * Event handed to JS for `lazyPayloads` streams.
+ * Owns the native event and only converts `data` (or `json`) into a JS value
+ * when a handler actually reads it, so events that are filtered on `type`
+ * never pay for the UTF-8 conversion.
+ */
+class EventHostObject final : public jsi::HostObject {
+public:
+    EventHostObject(NitroEventSourceEvent event, std::optional<JsonDocument> json, bool ascii)
+        : _owned{std::move(event), std::move(json), ascii}, _payload(_owned) {}
+    // Keeps a payload other subscribers may be reading too
+    explicit EventHostObject(std::shared_ptr<const EventPayload> shared) : _shared(std::move(shared)), _payload(*_shared) {}
+
+    jsi::Value get(jsi::Runtime& runtime, const jsi::PropNameID& name) override;
+    std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& runtime) override;
+
+private:
+    const EventPayload _owned;
+    const std::shared_ptr<const EventPayload> _shared;
+    const EventPayload& _payload;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,623 @@
+#include "EventJournal.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <map>
+#include <new>
+#include <optional>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Defined by builds that link libzstd, see android/CMakeLists.txt and NitroEventSource.podspec
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4e45534b;        // "NESK"
+constexpr uint32_t LEGACY_MAGIC = 0x4e45534a; // "NESJ", fixed-width records
+constexpr std::string_view SEGMENT_SUFFIX = ".seg";
+constexpr std::string_view COMPRESSED_SUFFIX = ".zseg";
+constexpr std::string_view PARTIAL_SUFFIX = ".tmp";
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint32_t reserved;
+    // End of the last complete record, published after the record is written
+    std::atomic<uint64_t> used;
+};
+
+SegmentHeader& header_of(std::byte* mapping) noexcept {
+    return *reinterpret_cast<SegmentHeader*>(mapping);
+}
+
+bool ends_with(std::string_view name, std::string_view suffix) noexcept {
+    return name.size() > suffix.size() && name.substr(name.size() - suffix.size()) == suffix;
+}
+
+uint32_t fnv1a(uint32_t hash, uint32_t value) noexcept {
+    return (hash ^ value) * 16777619u;
+}
+
+// Records: a checksum, the varint size of the payload, then the payload. The payload
+// starts with a tag byte: how the id is stored in its low bits, NEW_TYPE when the type
+// name follows in full rather than its index
+enum IdEncoding : uint8_t { ID_SAME = 0, ID_DELTA = 1, ID_TEXT = 2 };
+constexpr uint8_t ID_MASK = 0x03;
+constexpr uint8_t NEW_TYPE = 0x04;
+constexpr size_t CHECKSUM_BYTES = sizeof(uint32_t);
+constexpr size_t MAX_VARINT_BYTES = 10;
+
+size_t varint_size(uint64_t value) noexcept {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+std::byte* put_varint(std::byte* out, uint64_t value) noexcept {
+    while (value >= 0x80) {
+        *out++ = static_cast<std::byte>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<std::byte>(value);
+    return out;
+}
+
+bool get_varint(const std::byte*& in, const std::byte* end, uint64_t& value) noexcept {
+    value = 0;
+    for (size_t i = 0; i < MAX_VARINT_BYTES && in < end; ++i) {
+        const auto byte = static_cast<uint8_t>(*in++);
+        value |= uint64_t{byte & 0x7fu} << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::byte* put_bytes(std::byte* out, std::string_view bytes) noexcept {
+    out = put_varint(out, bytes.size());
+    std::memcpy(out, bytes.data(), bytes.size());
+    return out + bytes.size();
+}
+
+bool get_bytes(const std::byte*& in, const std::byte* end, std::string_view& bytes) noexcept {
+    uint64_t size = 0;
+    if (!get_varint(in, end, size) || size > static_cast<uint64_t>(end - in)) {
+        return false;
+    }
+    bytes = std::string_view(reinterpret_cast<const char*>(in), size);
+    in += size;
+    return true;
+}
+
+// Only ids that print back the same: digits without a leading zero
+std::optional<uint64_t> decimal_id(std::string_view id) noexcept {
+    if (id.empty() || (id.size() > 1 && id.front() == '0')) {
+        return std::nullopt;
+    }
+    uint64_t value = 0;
+    const auto [end, error] = std::from_chars(id.data(), id.data() + id.size(), value);
+    if (error != std::errc() || end != id.data() + id.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+uint64_t zigzag(uint64_t difference) noexcept {
+    const auto value = static_cast<int64_t>(difference);
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint64_t unzigzag(uint64_t value) noexcept {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+uint32_t record_checksum(uint64_t payload_bytes, const std::byte* payload) noexcept {
+    uint32_t hash = fnv1a(2166136261u, static_cast<uint32_t>(payload_bytes));
+    for (uint64_t i = 0; i < payload_bytes; ++i) {
+        hash = fnv1a(hash, static_cast<uint32_t>(payload[i]));
+    }
+    return hash;
+}
+
+// What decoding a segment's records has to remember from one to the next
+struct DecodeState {
+    std::vector<std::string> types;
+    std::string last_id;
+};
+
+// Calls `on_record(id, type, data)` for each record in [begin, end) up to the first torn one,
+// whose start it returns
+template <typename OnRecord>
+const std::byte* read_records(const std::byte* begin, const std::byte* end, DecodeState& state, OnRecord&& on_record) {
+    const std::byte* record = begin;
+    while (static_cast<size_t>(end - record) > CHECKSUM_BYTES) {
+        uint32_t checksum = 0;
+        std::memcpy(&checksum, record, CHECKSUM_BYTES);
+        const std::byte* in = record + CHECKSUM_BYTES;
+        uint64_t payload_bytes = 0;
+        if (!get_varint(in, end, payload_bytes) || payload_bytes == 0 || payload_bytes > static_cast<uint64_t>(end - in) ||
+            checksum != record_checksum(payload_bytes, in)) {
+            break;
+        }
+        const std::byte* payload_end = in + payload_bytes;
+
+        const auto tag = static_cast<uint8_t>(*in++);
+        bool intact = true;
+        if ((tag & ID_MASK) == ID_DELTA) {
+            uint64_t difference = 0;
+            const std::optional<uint64_t> previous = decimal_id(state.last_id);
+            intact = previous && get_varint(in, payload_end, difference);
+            if (intact) {
+                state.last_id = std::to_string(*previous + unzigzag(difference));
+            }
+        } else if ((tag & ID_MASK) == ID_TEXT) {
+            std::string_view id;
+            intact = get_bytes(in, payload_end, id);
+            if (intact) {
+                state.last_id.assign(id);
+            }
+        }
+
+        std::string_view type;
+        if (intact && (tag & NEW_TYPE) != 0) {
+            intact = get_bytes(in, payload_end, type);
+            if (intact) {
+                state.types.emplace_back(type);
+            }
+        } else if (intact) {
+            uint64_t index = 0;
+            intact = get_varint(in, payload_end, index) && index < state.types.size();
+            if (intact) {
+                type = state.types[index];
+            }
+        }
+
+        std::string_view data;
+        if (!intact || !get_bytes(in, payload_end, data) || in != payload_end) {
+            break;
+        }
+        on_record(std::string_view(state.last_id), type, data);
+        record = payload_end;
+    }
+    return record;
+}
+
+// Segments written before the varint encoding: ids, types and data in full behind fixed headers
+struct LegacyRecordHeader {
+    uint32_t checksum;
+    uint32_t id_bytes;
+    uint32_t type_bytes;
+    uint32_t data_bytes;
+};
+
+constexpr size_t LEGACY_ALIGNMENT = 8;
+
+size_t legacy_record_size(size_t payload_bytes) noexcept {
+    return (sizeof(LegacyRecordHeader) + payload_bytes + LEGACY_ALIGNMENT - 1) & ~(LEGACY_ALIGNMENT - 1);
+}
+
+uint32_t legacy_checksum(const LegacyRecordHeader& header, const std::byte* payload) noexcept {
+    uint32_t hash = 2166136261u;
+    hash = fnv1a(hash, header.id_bytes);
+    hash = fnv1a(hash, header.type_bytes);
+    hash = fnv1a(hash, header.data_bytes);
+    const size_t payload_bytes = size_t{header.id_bytes} + header.type_bytes + header.data_bytes;
+    for (size_t i = 0; i < payload_bytes; ++i) {
+        hash = fnv1a(hash, static_cast<uint32_t>(payload[i]));
+    }
+    return hash;
+}
+
+template <typename OnRecord>
+void read_legacy_records(const std::byte* mapping, uint64_t used, OnRecord&& on_record) {
+    uint64_t offset = sizeof(SegmentHeader);
+    while (offset + sizeof(LegacyRecordHeader) <= used) {
+        LegacyRecordHeader header;
+        std::memcpy(&header, mapping + offset, sizeof(header));
+        const size_t payload_bytes = size_t{header.id_bytes} + header.type_bytes + header.data_bytes;
+        const std::byte* payload = mapping + offset + sizeof(LegacyRecordHeader);
+        // The rest of a segment with a torn record is unreadable
+        if (offset + legacy_record_size(payload_bytes) > used || header.checksum != legacy_checksum(header, payload)) {
+            return;
+        }
+        offset += legacy_record_size(payload_bytes);
+
+        const auto* text = reinterpret_cast<const char*>(payload);
+        on_record(std::string_view(text, header.id_bytes), std::string_view(text + header.id_bytes, header.type_bytes),
+                  std::string_view(text + header.id_bytes + header.type_bytes, header.data_bytes));
+    }
+}
+
+bool read_file(const std::string& path, std::string& contents) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info {};
+    bool read_all = ::fstat(fd, &info) == 0;
+    if (read_all) {
+        contents.resize(static_cast<size_t>(info.st_size));
+        size_t offset = 0;
+        while (offset < contents.size()) {
+            const ssize_t count = ::read(fd, contents.data() + offset, contents.size() - offset);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                read_all = false;
+                break;
+            }
+            offset += static_cast<size_t>(count);
+        }
+    }
+    ::close(fd);
+    return read_all;
+}
+
+bool write_file(const std::string& path, const char* bytes, size_t size) noexcept {
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    size_t offset = 0;
+    while (offset < size) {
+        const ssize_t count = ::write(fd, bytes + offset, size - offset);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        offset += static_cast<size_t>(count);
+    }
+    return ::close(fd) == 0 && offset == size;
+}
+
+} // namespace
+
+std::unique_ptr<EventJournal> EventJournal::open(const std::string& directory, size_t segment_bytes, size_t max_segments,
+                                                 bool compress) noexcept {
+    try {
+        if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+            return nullptr;
+        }
+        DIR* listing = ::opendir(directory.c_str());
+        if (!listing) {
+            return nullptr;
+        }
+
+        std::unique_ptr<EventJournal> journal(new EventJournal(directory, segment_bytes, std::max<size_t>(max_segments, 1), compress));
+        // Per segment number: whether a mapped and a compressed file exist
+        std::map<uint64_t, std::pair<bool, bool>> files;
+        while (const dirent* entry = ::readdir(listing)) {
+            const std::string_view name = entry->d_name;
+            if (ends_with(name, SEGMENT_SUFFIX)) {
+                files[std::strtoull(entry->d_name, nullptr, 10)].first = true;
+            } else if (ends_with(name, COMPRESSED_SUFFIX)) {
+                files[std::strtoull(entry->d_name, nullptr, 10)].second = true;
+            } else if (ends_with(name, PARTIAL_SUFFIX)) {
+                // A compression that did not finish, its segment is still there
+                ::unlink((directory + "/" + std::string(name)).c_str());
+            }
+        }
+        ::closedir(listing);
+
+        size_t remaining = files.size();
+        for (const auto& [number, kinds] : files) {
+            const auto [mapped, compressed] = kinds;
+            // Over the limit, or from a launch with a different segment size
+            if (remaining-- > journal->_max_segments) {
+                ::unlink(journal->segment_path(number).c_str());
+                ::unlink(journal->segment_path(number, true).c_str());
+                continue;
+            }
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+            if (compressed) {
+                // Compressed and renamed into place before the mapped file went
+                if (mapped) {
+                    ::unlink(journal->segment_path(number).c_str());
+                }
+                journal->_segments.push_back(Segment{number, nullptr});
+                continue;
+            }
+#else
+            if (compressed) {
+                ::unlink(journal->segment_path(number, true).c_str());
+            }
+#endif
+            if (mapped && !journal->map_segment(number, false)) {
+                ::unlink(journal->segment_path(number).c_str());
+            }
+        }
+        if (!journal->resume_last_segment()) {
+            const uint64_t next = journal->_segments.empty() ? 1 : journal->_segments.back().number + 1;
+            if (!journal->map_segment(next, true)) {
+                return nullptr;
+            }
+            journal->drop_oldest();
+        }
+        return journal;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+EventJournal::~EventJournal() {
+    for (const Segment& segment : _segments) {
+        if (segment.mapping) {
+            ::munmap(segment.mapping, _segment_bytes);
+        }
+    }
+}
+
+std::string EventJournal::segment_path(uint64_t number, bool compressed) const {
+    // Zero-padded so names sort like their numbers
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llu", static_cast<unsigned long long>(number));
+    return _directory + "/" + name + std::string(compressed ? COMPRESSED_SUFFIX : SEGMENT_SUFFIX);
+}
+
+bool EventJournal::map_segment(uint64_t number, bool create) noexcept {
+    try {
+        const std::string path = segment_path(number);
+        const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_TRUNC : 0), 0600);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat info {};
+        bool sized = create ? ::ftruncate(fd, static_cast<off_t>(_segment_bytes)) == 0
+                            : ::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) == _segment_bytes;
+        void* mapping = sized ? ::mmap(nullptr, _segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+
+        auto* bytes = static_cast<std::byte*>(mapping);
+        if (create) {
+            new (mapping) SegmentHeader{MAGIC, 0, {sizeof(SegmentHeader)}};
+            _types.clear();
+            _last_id.clear();
+        } else {
+            const SegmentHeader& header = header_of(bytes);
+            const uint64_t used = header.used.load(std::memory_order_relaxed);
+            if ((header.magic != MAGIC && header.magic != LEGACY_MAGIC) || used < sizeof(SegmentHeader) || used > _segment_bytes) {
+                ::munmap(mapping, _segment_bytes);
+                return false;
+            }
+        }
+
+        _segments.push_back(Segment{number, bytes});
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+bool EventJournal::resume_last_segment() noexcept {
+    if (_segments.empty() || !_segments.back().mapping) {
+        return false;
+    }
+    SegmentHeader& header = header_of(_segments.back().mapping);
+    if (header.magic != MAGIC) {
+        return false;
+    }
+    try {
+        DecodeState state;
+        const std::byte* begin = _segments.back().mapping + sizeof(SegmentHeader);
+        const std::byte* end = read_records(begin, _segments.back().mapping + header.used.load(std::memory_order_relaxed), state,
+                                            [](std::string_view, std::string_view, std::string_view) {});
+        _types.clear();
+        for (uint32_t index = 0; index < state.types.size(); ++index) {
+            _types.emplace(std::move(state.types[index]), index);
+        }
+        _last_id = std::move(state.last_id);
+        // Appends go after the last record that reads back, not behind a torn one
+        header.used.store(static_cast<uint64_t>(end - _segments.back().mapping), std::memory_order_release);
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+bool EventJournal::rotate() noexcept {
+    if (!map_segment(_segments.back().number + 1, true)) {
+        return false;
+    }
+    if (_compress) {
+        compress_segment(_segments[_segments.size() - 2]);
+    }
+    drop_oldest();
+    return true;
+}
+
+void EventJournal::drop_oldest() noexcept {
+    while (_segments.size() > _max_segments) {
+        const Segment oldest = _segments.front();
+        if (oldest.mapping) {
+            ::munmap(oldest.mapping, _segment_bytes);
+        }
+        try {
+            ::unlink(segment_path(oldest.number, !oldest.mapping).c_str());
+        } catch (const std::bad_alloc&) {
+            // The file stays behind and is dropped by the next open
+        }
+        _segments.erase(_segments.begin());
+    }
+}
+
+bool EventJournal::compress_segment(Segment& segment) noexcept {
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+    constexpr int COMPRESSION_LEVEL = 3;
+
+    const SegmentHeader& header = header_of(segment.mapping);
+    if (header.magic != MAGIC) {
+        return false;
+    }
+    // Only the records, the header is no use once the segment cannot grow
+    const std::byte* records = segment.mapping + sizeof(SegmentHeader);
+    const size_t bytes = header.used.load(std::memory_order_relaxed) - sizeof(SegmentHeader);
+    try {
+        std::string compressed(ZSTD_compressBound(bytes), '\0');
+        const size_t size = ZSTD_compress(compressed.data(), compressed.size(), records, bytes, COMPRESSION_LEVEL);
+        if (ZSTD_isError(size) || size >= bytes) {
+            return false;
+        }
+        // Renamed into place once complete, a crash before leaves the mapped segment
+        const std::string path = segment_path(segment.number, true);
+        const std::string partial = path + std::string(PARTIAL_SUFFIX);
+        if (!write_file(partial, compressed.data(), size) || ::rename(partial.c_str(), path.c_str()) != 0) {
+            ::unlink(partial.c_str());
+            return false;
+        }
+        ::munmap(segment.mapping, _segment_bytes);
+        segment.mapping = nullptr;
+        ::unlink(segment_path(segment.number).c_str());
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+#else
+    (void)segment;
+    return false;
+#endif
+}
+
+bool EventJournal::append(std::string_view id, std::string_view type, std::string_view data) noexcept {
+    const std::lock_guard<std::mutex> lock(_mutex);
+
+    // Against the state of the segment it lands in, which a rotation starts over
+    const auto payload_size = [&]() -> size_t {
+        size_t size = 1;
+        if (id != _last_id) {
+            const std::optional<uint64_t> previous = decimal_id(_last_id);
+            const std::optional<uint64_t> current = previous ? decimal_id(id) : std::nullopt;
+            size += current ? varint_size(zigzag(*current - *previous)) : varint_size(id.size()) + id.size();
+        }
+        const auto known = _types.find(std::string(type));
+        size += known != _types.end() ? varint_size(known->second) : varint_size(type.size()) + type.size();
+        return size + varint_size(data.size()) + data.size();
+    };
+    const auto record_size = [](size_t payload_bytes) {
+        return CHECKSUM_BYTES + varint_size(payload_bytes) + payload_bytes;
+    };
+    // Spelled out in full, as the first record of a segment may have to be
+    const size_t largest_payload = 1 + varint_size(id.size()) + id.size() + varint_size(type.size()) + type.size() +
+                                   varint_size(data.size()) + data.size();
+    if (record_size(largest_payload) > _segment_bytes - sizeof(SegmentHeader)) {
+        return false;
+    }
+
+    try {
+        size_t payload_bytes = payload_size();
+        uint64_t used = header_of(_segments.back().mapping).used.load(std::memory_order_relaxed);
+        if (used + record_size(payload_bytes) > _segment_bytes) {
+            if (!rotate()) {
+                return false;
+            }
+            used = sizeof(SegmentHeader);
+            payload_bytes = payload_size();
+        }
+
+        std::byte* record = _segments.back().mapping + used;
+        std::byte* payload = put_varint(record + CHECKSUM_BYTES, payload_bytes);
+        std::byte* out = payload + 1;
+        uint8_t tag = ID_SAME;
+        if (id != _last_id) {
+            const std::optional<uint64_t> previous = decimal_id(_last_id);
+            const std::optional<uint64_t> current = previous ? decimal_id(id) : std::nullopt;
+            if (current) {
+                tag = ID_DELTA;
+                out = put_varint(out, zigzag(*current - *previous));
+            } else {
+                tag = ID_TEXT;
+                out = put_bytes(out, id);
+            }
+            _last_id.assign(id);
+        }
+        auto [known, added] = _types.try_emplace(std::string(type), static_cast<uint32_t>(_types.size()));
+        if (added) {
+            tag |= NEW_TYPE;
+            out = put_bytes(out, type);
+        } else {
+            out = put_varint(out, known->second);
+        }
+        put_bytes(out, data);
+        *payload = static_cast<std::byte>(tag);
+        const uint32_t checksum = record_checksum(payload_bytes, payload);
+        std::memcpy(record, &checksum, CHECKSUM_BYTES);
+
+        header_of(_segments.back().mapping).used.store(used + record_size(payload_bytes), std::memory_order_release);
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+std::vector<NitroEventSourceEvent> EventJournal::replay(std::string_view from_id) const {
+    std::vector<NitroEventSourceEvent> events;
+    const auto on_record = [&](std::string_view id, std::string_view type, std::string_view data) {
+        if (!from_id.empty() && id == from_id) {
+            // Everything up to here was already seen by whoever holds this id
+            events.clear();
+            return;
+        }
+        NitroEventSourceEvent event;
+        event.id.assign(id);
+        event.type.assign(type);
+        event.data.assign(data);
+        events.push_back(std::move(event));
+    };
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    std::string contents;
+    for (const Segment& segment : _segments) {
+        DecodeState state;
+        if (!segment.mapping) {
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+            std::string plain;
+            const unsigned long long plain_size = read_file(segment_path(segment.number, true), contents)
+                                                      ? ZSTD_getFrameContentSize(contents.data(), contents.size())
+                                                      : ZSTD_CONTENTSIZE_ERROR;
+            if (plain_size == ZSTD_CONTENTSIZE_ERROR || plain_size == ZSTD_CONTENTSIZE_UNKNOWN || plain_size > _segment_bytes) {
+                continue;
+            }
+            plain.resize(static_cast<size_t>(plain_size));
+            if (ZSTD_isError(ZSTD_decompress(plain.data(), plain.size(), contents.data(), contents.size()))) {
+                continue;
+            }
+            const auto* begin = reinterpret_cast<const std::byte*>(plain.data());
+            read_records(begin, begin + plain.size(), state, on_record);
+#endif
+            continue;
+        }
+
+        const SegmentHeader& header = header_of(segment.mapping);
+        const uint64_t used = header.used.load(std::memory_order_acquire);
+        if (header.magic == LEGACY_MAGIC) {
+            read_legacy_records(segment.mapping, used, on_record);
+        } else {
+            read_records(segment.mapping + sizeof(SegmentHeader), segment.mapping + used, state, on_record);
+        }
+    }
+    return events;
+}
+
+} // namespace margelo::nitro::nitroeventsource
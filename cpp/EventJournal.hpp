@@ -0,0 +1,79 @@
+#pragma once
+
+#include "NitroEventSourceEvent.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Append-only on-disk log of parsed events, split into fixed-size memory-mapped
+ * segments. Appending is a copy into the active segment; once it is full the
+ * next segment starts and the oldest beyond the limit is deleted. Records are
+ * checksummed, so a process killed mid-append only loses that record.
+ * Appends come from the I/O thread and replays from the JS thread.
+ *
+ * Records are varint-framed and encode against the earlier records of their
+ * segment: each event type is spelled out once and then referenced by index, an
+ * id equal to the previous one takes no bytes, and a decimal id is stored as the
+ * difference to a decimal previous one. Each segment decodes on its own, so
+ * deleting the oldest never breaks the rest. With `compress`, a full segment is
+ * compressed with zstd into a file of its own when the next one starts, in
+ * builds with NITRO_EVENT_SOURCE_ZSTD. Segments from before this encoding still
+ * replay, the next append after them starts a new segment.
+ */
+class EventJournal {
+public:
+    // Returns nullptr when the directory cannot be read or the first segment cannot be mapped
+    static std::unique_ptr<EventJournal> open(const std::string& directory, size_t segment_bytes, size_t max_segments,
+                                              bool compress = false) noexcept;
+    ~EventJournal();
+
+    EventJournal(const EventJournal&) = delete;
+    EventJournal& operator=(const EventJournal&) = delete;
+
+    // Returns false when the event does not fit in a segment or a new segment cannot be created
+    bool append(std::string_view id, std::string_view type, std::string_view data) noexcept;
+
+    // Events recorded after the last one with `from_id`, or every retained event when no record has that id
+    std::vector<NitroEventSourceEvent> replay(std::string_view from_id) const;
+
+private:
+    struct Segment {
+        uint64_t number;
+        // nullptr once compressed, it is then read from its compressed file
+        std::byte* mapping;
+    };
+
+    EventJournal(std::string directory, size_t segment_bytes, size_t max_segments, bool compress) noexcept
+        : _directory(std::move(directory)), _segment_bytes(segment_bytes), _max_segments(max_segments), _compress(compress) {}
+
+    std::string segment_path(uint64_t number, bool compressed = false) const;
+    bool map_segment(uint64_t number, bool create) noexcept;
+    bool rotate() noexcept;
+    void drop_oldest() noexcept;
+    // Replaces the mapped `segment` by its compressed file, false when it stays as it is
+    bool compress_segment(Segment& segment) noexcept;
+    // Picks the encoder state up from the last segment, which then takes appends after its last intact record
+    bool resume_last_segment() noexcept;
+
+    const std::string _directory;
+    const size_t _segment_bytes;
+    const size_t _max_segments;
+    const bool _compress;
+
+    mutable std::mutex _mutex;
+    // Oldest first, the last one takes appends
+    std::vector<Segment> _segments;
+    // Encoder state of the last segment: the index of each type it spelled out, and its last id
+    std::unordered_map<std::string, uint32_t> _types;
+    std::string _last_id;
+};
+
+} // namespace margelo::nitro::nitroeventsource
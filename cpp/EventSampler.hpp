@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The `sampling` decisions, made per event before it is built for JS. With
+ * `every`, one event in that many is kept, starting with the first. With a
+ * reservoir of `size`, a window keeps a uniform sample of that many of its
+ * events (Vitter's Algorithm R); the caller holds them and starts the next
+ * window once it has sent them. Owned by the I/O thread.
+ */
+class EventSampler {
+public:
+    EventSampler(uint64_t every, size_t reservoir_size) noexcept
+        : _every(every), _reservoir_size(reservoir_size), _random(std::random_device{}()) {}
+
+    bool keeps_nth() noexcept {
+        return _every <= 1 || _seen++ % _every == 0;
+    }
+
+    bool has_reservoir() const noexcept {
+        return _reservoir_size > 0;
+    }
+
+    // The reservoir slot for this window's next event, which may replace the one held there;
+    // nullopt when it is not sampled. Slots below the window's count so far are filled in order
+    std::optional<size_t> reservoir_slot() noexcept {
+        const uint64_t index = _window_seen++;
+        if (index < _reservoir_size) {
+            return static_cast<size_t>(index);
+        }
+        const uint64_t slot = std::uniform_int_distribution<uint64_t>(0, index)(_random);
+        return slot < _reservoir_size ? std::optional(static_cast<size_t>(slot)) : std::nullopt;
+    }
+
+    void start_window() noexcept {
+        _window_seen = 0;
+    }
+
+private:
+    const uint64_t _every;
+    const size_t _reservoir_size;
+    uint64_t _seen = 0;
+    uint64_t _window_seen = 0;
+    std::minstd_rand _random;
+};
+
+} // namespace margelo::nitro::nitroeventsource
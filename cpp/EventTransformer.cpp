@@ -0,0 +1,47 @@
+#include "EventTransformer.hpp"
+#include "Logger.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+constexpr auto TAG = "EventTransformer";
+} // namespace
+
+EventTransformerRegistry& EventTransformerRegistry::shared() noexcept {
+    // Leaked like the TransferEngine, modules may register or remove at exit
+    static EventTransformerRegistry* registry = new EventTransformerRegistry();
+    return *registry;
+}
+
+void EventTransformerRegistry::add(const std::string& name, Factory factory) {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    _factories.insert_or_assign(name, std::move(factory));
+}
+
+void EventTransformerRegistry::remove(const std::string& name) noexcept {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    _factories.erase(name);
+}
+
+std::unique_ptr<EventTransformer> EventTransformerRegistry::create(const std::string& name, const std::string& url) const noexcept {
+    Factory factory;
+    try {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _factories.find(name);
+        if (it == _factories.end()) {
+            return nullptr;
+        }
+        factory = it->second;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+    // Outside the lock, a factory may look up another transformer
+    try {
+        return factory ? factory(url) : nullptr;
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Transformer '" + name + "' failed to start: " + e.what());
+        return nullptr;
+    }
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "JsonValue.hpp"
+#include "NitroEventSourceEvent.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Native code run on a stream's events, for hot domain logic that would
+ * otherwise run in JS. Another native module registers a factory under a
+ * name, typically at startup:
+ *
+ *     EventTransformerRegistry::shared().add("ticks", [](const std::string& url) {
+ *         return std::make_unique<TickFilter>();
+ *     });
+ *
+ * and streams opened with `transformers: ['ticks']` each get an instance of
+ * their own. It sees every event that passed the payload filters, in order, on
+ * the TransferEngine I/O thread, before coalescing, batching, sampling and the
+ * queue for JS; it must not block. It can drop an event, rewrite it, or fold
+ * it into state and emit what it aggregated later through the sink. Several
+ * transformers run in the order the stream names them, each emitted event
+ * going through the ones after its emitter.
+ */
+class EventTransformer {
+public:
+    // Takes the events a transformer adds, e.g. an aggregate, on the same thread
+    class Sink {
+    public:
+        virtual void emit(NitroEventSourceEvent event) noexcept = 0;
+
+    protected:
+        ~Sink() = default;
+    };
+
+    enum class Result {
+        // The event is not delivered, and counts as dropped
+        DROP,
+        // Handed on as it came in, or with only its id changed
+        PASS,
+        // Handed on after `type` or `data` changed, so the stream decodes `data` again where it needs JSON
+        REWRITTEN,
+    };
+
+    virtual ~EventTransformer() = default;
+
+    // `json` is the decoded `data` when the stream decoded it, valid during the call only.
+    // A transformer that throws drops the event
+    virtual Result transform(NitroEventSourceEvent& event, const JsonValue* json, Sink& sink) = 0;
+
+    // The transfer ended, before the stream reconnects or closes: emit what is still held
+    virtual void flush(Sink&) {}
+};
+
+class EventTransformerRegistry {
+public:
+    // Called when a stream opens with the transformer's name, on the JS thread
+    using Factory = std::function<std::unique_ptr<EventTransformer>(const std::string& url)>;
+
+    static EventTransformerRegistry& shared() noexcept;
+
+    // Any thread; replaces what `name` was registered with, streams already open keep theirs
+    void add(const std::string& name, Factory factory);
+    void remove(const std::string& name) noexcept;
+
+    // A new instance for one stream, nullptr when nothing is registered under `name` or the factory failed
+    std::unique_ptr<EventTransformer> create(const std::string& name, const std::string& url) const noexcept;
+
+private:
+    EventTransformerRegistry() = default;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<std::string, Factory> _factories;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Small intern table for SSE event names.
+ * Streams use a handful of distinct types, so a linear scan beats hashing and
+ * every known type maps to a stable id and a stable string that events copy
+ * from (short names stay in the small-string buffer, so no allocation).
+ */
+class EventTypeTable {
+public:
+    using Id = uint32_t;
+
+    static constexpr Id MESSAGE = 0;
+    static constexpr Id OPEN = 1;
+    static constexpr Id ERROR = 2;
+    static constexpr Id NONE = UINT32_MAX;
+
+    // Types sent by the server beyond this many are not interned, so a hostile stream cannot grow the table
+    static constexpr size_t MAX_SERVER_TYPES = 64;
+
+    EventTypeTable() {
+        _names.emplace_back("message");
+        _names.emplace_back("open");
+        _names.emplace_back("error");
+    }
+
+    Id find(std::string_view name) const noexcept {
+        for (size_t i = 0; i < _names.size(); ++i) {
+            if (_names[i] == name) {
+                return static_cast<Id>(i);
+            }
+        }
+        return NONE;
+    }
+
+    // Interns `name` unconditionally, used for types that have listeners
+    Id intern(std::string_view name) {
+        const Id id = find(name);
+        if (id != NONE) {
+            return id;
+        }
+        _names.emplace_back(name);
+        return static_cast<Id>(_names.size() - 1);
+    }
+
+    // Interns `name` only while the table is small, returns NONE otherwise
+    Id intern_from_server(std::string_view name) {
+        const Id id = find(name);
+        if (id != NONE || _names.size() >= MAX_SERVER_TYPES) {
+            return id;
+        }
+        _names.emplace_back(name);
+        return static_cast<Id>(_names.size() - 1);
+    }
+
+    // Deque storage keeps references stable while the table grows
+    const std::string& name(Id id) const noexcept {
+        return _names[id];
+    }
+
+    size_t size() const noexcept {
+        return _names.size();
+    }
+
+private:
+    std::deque<std::string> _names;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Tracks the network's delay from server heartbeats that carry the time they
+ * were sent. Server and device clocks differ by an unknown offset, so the
+ * lowest transit time of the connection is taken as its baseline and only the
+ * delay on top of it counts: smoothed, as a trend (rising when positive) and
+ * as RFC 3550 interarrival jitter. With the heartbeat interval, gaps between
+ * the times sent count the beats that never arrived. The quality score, 1 on an idle network,
+ * halves once delay plus twice the jitter reaches `good_delay_ms`, and scales
+ * with the share of beats that arrived. Recorded on the I/O thread, readings
+ * are atomics for getMetrics().
+ */
+class HeartbeatMonitor {
+public:
+    struct Settings {
+        std::optional<double> interval_ms;
+        double good_delay_ms = 250.0;
+    };
+
+    struct Reading {
+        double delay_ms;
+        double trend_ms;
+        double jitter_ms;
+        double quality;
+    };
+
+    explicit HeartbeatMonitor(Settings settings) noexcept : _settings(settings) {}
+
+    // A heartbeat sent at `sent_ms` by the server's clock and received at `received_ms` by ours
+    void record(double sent_ms, double received_ms) noexcept {
+        const double transit = received_ms - sent_ms;
+        if (!std::isfinite(transit)) {
+            return;
+        }
+        const std::optional<double> previous = std::exchange(_last_transit, transit);
+        const std::optional<double> last_sent = std::exchange(_last_sent, sent_ms);
+        if (!previous) {
+            _baseline = transit;
+            return;
+        }
+
+        _baseline = std::min(_baseline, transit);
+        const double delay = transit - _baseline;
+        _jitter += (std::abs(transit - *previous) - _jitter) / 16.0;
+        _fast += (delay - _fast) / 4.0;
+        _slow += (delay - _slow) / 16.0;
+
+        if (_settings.interval_ms && *_settings.interval_ms > 0.0 && last_sent) {
+            const double beats = std::clamp(std::round((sent_ms - *last_sent) / *_settings.interval_ms), 1.0, 1e9);
+            _missed.fetch_add(static_cast<uint64_t>(beats - 1.0), std::memory_order_relaxed);
+            _loss += ((beats - 1.0) / beats - _loss) / 8.0;
+        }
+
+        const double quality = (1.0 - _loss) * _settings.good_delay_ms / (_settings.good_delay_ms + _fast + 2.0 * _jitter);
+        _delay_ms.store(_fast, std::memory_order_relaxed);
+        _trend_ms.store(_fast - _slow, std::memory_order_relaxed);
+        _jitter_ms.store(_jitter, std::memory_order_relaxed);
+        _quality.store(std::clamp(quality, 0.0, 1.0), std::memory_order_relaxed);
+        _measured.store(true, std::memory_order_release);
+    }
+
+    // Any thread: nothing until two heartbeats of a connection arrived
+    std::optional<Reading> reading() const noexcept {
+        if (!_measured.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        return Reading{_delay_ms.load(std::memory_order_relaxed), _trend_ms.load(std::memory_order_relaxed),
+                       _jitter_ms.load(std::memory_order_relaxed), _quality.load(std::memory_order_relaxed)};
+    }
+
+    // Any thread: beats missed over every connection
+    uint64_t missed() const noexcept {
+        return _missed.load(std::memory_order_relaxed);
+    }
+
+    // A new connection may take another route, its baseline starts over
+    void reset() noexcept {
+        _last_transit.reset();
+        _last_sent.reset();
+        _baseline = 0.0;
+        _jitter = _fast = _slow = _loss = 0.0;
+        _measured.store(false, std::memory_order_release);
+    }
+
+private:
+    const Settings _settings;
+    // I/O thread only
+    std::optional<double> _last_transit;
+    std::optional<double> _last_sent;
+    double _baseline = 0.0;
+    double _jitter = 0.0;
+    double _fast = 0.0;
+    double _slow = 0.0;
+    double _loss = 0.0;
+    // Published for getMetrics()
+    std::atomic<bool> _measured{false};
+    std::atomic<double> _delay_ms{0.0};
+    std::atomic<double> _trend_ms{0.0};
+    std::atomic<double> _jitter_ms{0.0};
+    std::atomic<double> _quality{1.0};
+    std::atomic<uint64_t> _missed{0};
+};
+
+} // namespace margelo::nitro::nitroeventsource
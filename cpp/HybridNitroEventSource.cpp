@@ -1,23 +1,35 @@
 #include "HybridNitroEventSource.hpp"
+#include "AppLifecycle.hpp"
+#include "EventHostObject.hpp"
+#include "MessageHostObject.hpp"
+#include "EventJournal.hpp"
+#include "JsonPatch.hpp"
+#include "Logger.hpp"
+#include "NetworkMonitor.hpp"
+#include "StorageDirectory.hpp"
+#include "StreamKey.hpp"
+#include "Tracing.hpp"
+#include "WarmStartCache.hpp"
 
 #include <curl/curl.h>
+#include <sys/socket.h>
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <chrono>
-#include <iostream>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <utility>
 
 
 namespace margelo::nitro::nitroeventsource::curl_utils {
     
-    int progress_callback(void* userdata, curl_off_t, curl_off_t, curl_off_t, curl_off_t) noexcept {
-        if (!userdata) return 1;
-        
-        const auto* self = static_cast<const HybridNitroEventSource*>(userdata);
-        return (self->_running.load() && !self->_closed.load()) ? 0 : 1;
-    }
-
     size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) noexcept {
+        NITRO_ES_TRACE_SCOPE("write_callback");
         const size_t total_bytes = size * nmemb;
         
         if (!ptr || !userdata || total_bytes == 0) {
@@ -26,360 +38,4892 @@ namespace margelo::nitro::nitroeventsource::curl_utils {
 
         auto* self = static_cast<HybridNitroEventSource*>(userdata);
         
-        if (!self->_running.load() || self->_closed.load()) {
+        if (self->closed()) {
             return 0;
         }
+        self->_last_received = TransferEngine::Clock::now();
 
-        bool expected = false;
-        if (self->_open_event_sent.compare_exchange_strong(expected, true)) {
-            if (!self->_closed.load()) {
-                const NitroEventSourceEvent open_event(self->_last_event_id, "open", "");
-                self->dispatch_event(open_event);
-            }
+        // More urgent streams read first this iteration, curl redelivers the chunk once resumed
+        if (self->defer_write()) {
+            return CURL_WRITEFUNC_PAUSE;
         }
 
-        if (!self->_closed.load()) {
-            self->parse_sse_chunk(std::string_view(ptr, total_bytes));
+        self->open_response();
+
+        // Closed or ended meanwhile: the rest is swallowed until the transfer is torn down
+        if (!self->should_retry(std::memory_order_relaxed)) {
+            return total_bytes;
         }
-        
-        return total_bytes;
+
+        // Block backpressure: stop reading until JS has drained, curl redelivers this chunk on resume
+        if (self->pause_for_backpressure() || self->pause_for_rate_limit()) {
+            return CURL_WRITEFUNC_PAUSE;
+        }
+
+        if (self->_capture) {
+            self->_capture->append(self->_last_received, std::string_view(ptr, total_bytes));
+        }
+        // A body that cannot be decoded aborts the transfer, which then reconnects
+        const bool received = self->receive_body(std::string_view(ptr, total_bytes));
+        self->_parser_memory.update(static_cast<int64_t>(self->_parser.buffered_bytes() + self->_ws_message.capacity()));
+        return received ? total_bytes : 0;
+    }
+
+    size_t header_callback(char* buffer, size_t size, size_t nitems, void* userdata) noexcept {
+        const size_t total_bytes = size * nitems;
+        if (!buffer || !userdata) {
+            return total_bytes;
+        }
+        // A response that is not an event stream fails before its body reaches the parser
+        return static_cast<HybridNitroEventSource*>(userdata)->receive_header(std::string_view(buffer, total_bytes)) ? total_bytes : 0;
+    }
+
+    int sockopt_callback(void* clientp, curl_socket_t fd, curlsocktype purpose) noexcept {
+        const int receive_buffer_bytes = clientp ? *static_cast<const int*>(clientp) : 0;
+        if (purpose == CURLSOCKTYPE_IPCXN && receive_buffer_bytes > 0) {
+            // Best effort: the kernel clamps or rounds the size, and a refusal is no reason to fail
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer_bytes, sizeof(receive_buffer_bytes));
+        }
+        return CURL_SOCKOPT_OK;
+    }
+
+    bool supports_http2() noexcept {
+        static const bool supported = [] {
+            const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+            return info && (info->features & CURL_VERSION_HTTP2) != 0;
+        }();
+        return supported;
+    }
+
+    bool supports_http3() noexcept {
+        static const bool supported = [] {
+            const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+            return info && (info->features & CURL_VERSION_HTTP3) != 0;
+        }();
+        return supported;
+    }
+
+    bool supports_websockets() noexcept {
+        static const bool supported = [] {
+            const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+            if (!info || !info->protocols) {
+                return false;
+            }
+            for (const char* const* protocol = info->protocols; *protocol; ++protocol) {
+                if (std::strcmp(*protocol, "ws") == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }();
+        return supported;
+    }
+
+    bool supports_content_encoding() noexcept {
+        static const bool supported = [] {
+            const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+            return info && (info->features & (CURL_VERSION_LIBZ | CURL_VERSION_BROTLI | CURL_VERSION_ZSTD)) != 0;
+        }();
+        return supported;
     }
 } // namespace margelo::nitro::nitroeventsource::curl_utils
 
+#if NITRO_EVENT_SOURCE_PGO_GENERATE
+// From the compiler-rt profile runtime that -fprofile-generate links in
+extern "C" void __llvm_profile_set_filename(const char* name);
+extern "C" int __llvm_profile_write_file(void);
+#endif
+
 namespace margelo::nitro::nitroeventsource {
 
+#if NITRO_EVENT_SOURCE_PGO_GENERATE
+namespace {
+
+// Apps are killed rather than exit, so a training build writes its profile each time a stream closes
+void write_training_profile() noexcept {
+    static const std::string path = [] {
+        const std::string directory = resolve_storage_directory(std::nullopt);
+        return directory.empty() ? std::string() : directory + "/nitro-event-source.profraw";
+    }();
+    if (path.empty()) {
+        return;
+    }
+    __llvm_profile_set_filename(path.c_str());
+    if (__llvm_profile_write_file() == 0) {
+        NITRO_ES_LOG_INFO("NitroEventSource", "Wrote training profile to " + path);
+    }
+}
+
+} // namespace
+#endif
+
+namespace {
+
+// Every stream created so far that may still be alive, for close_all()
+struct LiveStreams {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<HybridNitroEventSource>> streams;
+    // Expired entries are dropped whenever the list doubles since the last sweep
+    size_t sweep_at = 16;
+};
+
+LiveStreams& live_streams() {
+    // Leaked like the TransferEngine, streams may still be destroyed at exit
+    static LiveStreams* live = new LiveStreams();
+    return *live;
+}
+
+void track_stream(const std::shared_ptr<HybridNitroEventSource>& stream) {
+    LiveStreams& live = live_streams();
+    const std::lock_guard<std::mutex> lock(live.mutex);
+    if (live.streams.size() >= live.sweep_at) {
+        std::erase_if(live.streams, [](const std::weak_ptr<HybridNitroEventSource>& each) { return each.expired(); });
+        live.sweep_at = std::max<size_t>(16, live.streams.size() * 2);
+    }
+    live.streams.push_back(stream);
+}
+
+// capture and replay files: absolute paths as given, others under the storage directory
+std::string resolve_data_path(const std::string& file, const std::optional<std::string>& storage_directory) {
+    if (file.starts_with('/')) {
+        return file;
+    }
+    const std::string directory = resolve_storage_directory(storage_directory);
+    return directory.empty() ? std::string() : directory + "/" + file;
+}
+
+std::vector<std::shared_ptr<HybridNitroEventSource>> open_streams() {
+    std::vector<std::shared_ptr<HybridNitroEventSource>> streams;
+    LiveStreams& live = live_streams();
+    const std::lock_guard<std::mutex> lock(live.mutex);
+    for (const std::weak_ptr<HybridNitroEventSource>& each : live.streams) {
+        std::shared_ptr<HybridNitroEventSource> stream = each.lock();
+        if (stream && !stream->closed()) {
+            streams.push_back(std::move(stream));
+        }
+    }
+    return streams;
+}
+
+std::atomic<uint64_t> next_stream_id{1};
+
+struct MetricsWatch {
+    std::mutex mutex;
+    std::shared_ptr<const HybridNitroEventSource::MetricsCallback> callback;
+    TransferEngine::Clock::duration interval{};
+    // Bumped by every watch and unwatch, which stops the sampling loop of the watch before
+    uint64_t generation = 0;
+};
+
+MetricsWatch& metrics_watch() {
+    static MetricsWatch* watch = new MetricsWatch();
+    return *watch;
+}
+
+} // namespace
+
 std::shared_ptr<HybridNitroEventSourceSpec> HybridNitroEventSource::create(
     const std::string& url,
     const std::optional<NitroEventSourceOptions>& options
 ) {
+    return open(url, options);
+}
+
+std::shared_ptr<HybridNitroEventSource> HybridNitroEventSource::open(const std::string& url, const std::optional<NitroEventSourceOptions>& options) {
     auto instance = std::make_shared<HybridNitroEventSource>();
-    instance->_url = url;
-    instance->_options = options;
+    instance->_stream_id = next_stream_id.fetch_add(1, std::memory_order_relaxed);
+    track_stream(instance);
+    // Buffers a closed stream left behind, so the first events are not allocated from scratch
+    StreamRecycler::shared().take_events(RECYCLED_EVENTS_PER_STREAM, [&](NitroEventSourceEvent&& event) {
+        instance->_event_pool.try_push(std::move(event));
+    });
+    // Copy the dictionary while still on the JS thread, the JS-owned buffer is not kept
+    if (options && options->zstdDictionary) {
+        if (const std::shared_ptr<ArrayBuffer>& dictionary = *options->zstdDictionary) {
+            if (!ZstdDictionaryDecoder::available()) {
+                NITRO_ES_LOG_WARN(TAG, "zstdDictionary set but the library was built without zstd, requesting an uncompressed stream");
+            } else {
+                const std::vector<uint8_t> bytes(dictionary->data(), dictionary->data() + dictionary->size());
+                auto decoder = std::make_unique<ZstdDictionaryDecoder>(bytes);
+                if (decoder->valid()) {
+                    instance->_decoder = std::move(decoder);
+                } else {
+                    NITRO_ES_LOG_ERROR(TAG, "Failed to load zstd dictionary, requesting an uncompressed stream");
+                }
+            }
+        }
+    }
+    // The one copy of url and options, which every attempt reads from then on
+    instance->_spec = std::make_shared<const ConnectionSpec>(url, options, instance->_decoder != nullptr);
+    if (instance->_spec->options) {
+        instance->_options = std::shared_ptr<const NitroEventSourceOptions>(instance->_spec, &*instance->_spec->options);
+    }
+    instance->_endpoints.add(url);
+    if (options && options->endpoints) {
+        for (const std::string& endpoint : *options->endpoints) {
+            instance->_endpoints.add(endpoint);
+        }
+    }
+    if (options && options->standby && options->standby->url) {
+        instance->_endpoints.add(*options->standby->url);
+    }
+    // Pull streams queue events from the start, for drainEvents() to take whenever JS asks;
+    // fetchMode queues them alongside its body
+    instance->_queued_delivery.store(options && (options->pull.value_or(false) || instance->fetch_mode()));
+    // lazyStart: filters set before start() apply here and now, without starting the engine for them
+    instance->_engine_attached = !(options && options->lazyStart);
+    instance->_parser.set_limits(instance->parser_limits());
+    if (options && options->cpuAccounting.value_or(false)) {
+        instance->_cpu_time.enable();
+    }
+    if (const std::optional<RecordFormat> format = instance->record_format()) {
+        instance->_framer.emplace(FramerSink{instance.get()}, *format, instance->parser_limits().max_event_bytes);
+    }
+    if (instance->raw_mode() && instance->_options->rawFraming) {
+        const LengthPrefix prefix = *instance->_options->rawFraming == RawFraming::VARINT ? LengthPrefix::VARINT : LengthPrefix::U32_BE;
+        instance->_message_framer.emplace(MessageBatchSink{instance.get()}, prefix, instance->parser_limits().max_event_bytes);
+    }
+    if (instance->_options && instance->_options->bufferingDetection) {
+        const BufferingDetectionOptions& detection = *instance->_options->bufferingDetection;
+        BufferingDetector::Settings settings;
+        if (detection.gapMs) {
+            settings.gap = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, *detection.gapMs)));
+        }
+        if (detection.burstEvents) {
+            settings.burst_events = static_cast<uint32_t>(std::max(1.0, *detection.burstEvents));
+        }
+        if (detection.lagMs) {
+            settings.lag_ms = *detection.lagMs;
+        }
+        instance->_buffering.emplace(settings);
+    }
+    instance->_message_schema = std::make_shared<const ProtoSchema>(
+        instance->_options && instance->_options->messageSchema ? *instance->_options->messageSchema : MessageSchema());
+
+    if (options && options->dedupWindow) {
+        instance->_seen_ids = RecentIdWindow(static_cast<size_t>(std::max(0.0, *options->dedupWindow)));
+    }
+    if (options && options->recentEvents) {
+        const RecentEventsOptions& recent = *options->recentEvents;
+        std::optional<std::chrono::steady_clock::duration> max_age;
+        if (recent.maxAgeMs && *recent.maxAgeMs > 0.0) {
+            max_age = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(*recent.maxAgeMs));
+        }
+        instance->_recent_events = std::make_unique<RecentEvents>(static_cast<size_t>(std::max(1.0, recent.maxEvents.value_or(64.0))), max_age);
+    }
+    if (options && options->resumeKey) {
+        const std::string directory = resolve_storage_directory(options->storageDirectory);
+        if (directory.empty()) {
+            NITRO_ES_LOG_WARN(TAG, "No storage directory, resumeKey is ignored");
+        } else if (auto store = LastEventIdStore::open(directory + "/" + storage_file_name("last-event-id", *options->resumeKey))) {
+            instance->_last_event_id = store->load();
+            instance->_id_store = std::move(store);
+        } else {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to open Last-Event-ID store, resumeKey is ignored");
+        }
+    }
+    if (options && options->journal) {
+        constexpr double DEFAULT_SEGMENT_BYTES = 1024 * 1024;
+        constexpr double DEFAULT_MAX_SEGMENTS = 4;
+        const std::string directory = resolve_storage_directory(options->storageDirectory);
+        const JournalOptions& journal = *options->journal;
+        if (directory.empty()) {
+            NITRO_ES_LOG_WARN(TAG, "No storage directory, journal is disabled");
+        } else if (!(instance->_journal = EventJournal::open(
+                       directory + "/" + storage_file_name("journal", journal.key.value_or(instance->_spec->key_hex)),
+                       static_cast<size_t>(std::max(4096.0, journal.segmentBytes.value_or(DEFAULT_SEGMENT_BYTES))),
+                       static_cast<size_t>(std::max(1.0, journal.maxSegments.value_or(DEFAULT_MAX_SEGMENTS))),
+                       journal.compress.value_or(false)))) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to open event journal, journal is disabled");
+        }
+    }
+    if (options && options->warmStart) {
+        constexpr double DEFAULT_MAX_EVENT_BYTES = 16 * 1024;
+        const std::string directory = resolve_storage_directory(options->storageDirectory);
+        const WarmStartOptions& warm_start = *options->warmStart;
+        if (directory.empty()) {
+            NITRO_ES_LOG_WARN(TAG, "No storage directory, warmStart is disabled");
+        } else if (!(instance->_warm_cache = WarmStartCache::open(
+                       directory + "/" + storage_file_name("warm-start", warm_start.key.value_or(instance->_spec->key_hex)),
+                       static_cast<size_t>(std::max(0.0, warm_start.maxEventBytes.value_or(DEFAULT_MAX_EVENT_BYTES)))))) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to open warm-start cache, warmStart is disabled");
+        }
+    }
+    if (options && options->tokenStream) {
+        instance->_token_type = instance->_event_types.intern(options->tokenStream->eventType.value_or("message"));
+        instance->_done_type = instance->_event_types.intern("done");
+    }
+    if (options && options->endOfStream && options->endOfStream->eventType) {
+        instance->_end_type = instance->_event_types.intern(*options->endOfStream->eventType);
+    }
+    if (options && options->priorityTypes) {
+        for (const std::string& type : *options->priorityTypes) {
+            const EventTypeTable::Id id = instance->_event_types.intern(type);
+            if (id >= instance->_priority_types.size()) {
+                instance->_priority_types.resize(id + 1, false);
+            }
+            instance->_priority_types[id] = true;
+        }
+    }
+    if (options && options->aggregation) {
+        for (const std::string& type : options->aggregation->types) {
+            const EventTypeTable::Id id = instance->_event_types.intern(type);
+            if (id >= instance->_aggregated_types.size()) {
+                instance->_aggregated_types.resize(id + 1, false);
+            }
+            instance->_aggregated_types[id] = true;
+        }
+        instance->_aggregate_type = instance->_event_types.intern(options->aggregation->eventType.value_or("aggregate"));
+        instance->_aggregator.emplace();
+    }
+    if (options && options->heartbeat) {
+        const HeartbeatOptions& heartbeat = *options->heartbeat;
+        HeartbeatMonitor::Settings settings;
+        settings.interval_ms = heartbeat.intervalMs;
+        if (heartbeat.goodDelayMs && *heartbeat.goodDelayMs > 0.0) {
+            settings.good_delay_ms = *heartbeat.goodDelayMs;
+        }
+        instance->_heartbeat.emplace(settings);
+        instance->_heartbeat_type = instance->_event_types.intern(heartbeat.event.value_or("heartbeat"));
+        if (heartbeat.qualityEvent) {
+            instance->_quality_type = instance->_event_types.intern(*heartbeat.qualityEvent);
+        }
+    }
+    if (options && options->transformers) {
+        for (const std::string& name : *options->transformers) {
+            if (std::unique_ptr<EventTransformer> transformer = EventTransformerRegistry::shared().create(name, url)) {
+                instance->_transformers.push_back(std::move(transformer));
+            } else {
+                NITRO_ES_LOG_ERROR(TAG, "No native transformer registered as '" + name + "', events skip it");
+            }
+        }
+    }
+    if (options && options->utf16MinBytes) {
+        instance->_utf16_min_bytes = static_cast<size_t>(std::min(1e15, std::max(0.0, *options->utf16MinBytes)));
+    }
+    if (options && options->parallelDecode) {
+        constexpr double DEFAULT_MIN_BYTES = 16 * 1024;
+        constexpr double DEFAULT_MAX_IN_FLIGHT = 16;
+        instance->_decode_min_bytes =
+            static_cast<size_t>(std::min(1e15, std::max(1.0, options->parallelDecode->minBytes.value_or(DEFAULT_MIN_BYTES))));
+        instance->_decode_max_in_flight =
+            static_cast<size_t>(std::min(1e6, std::max(1.0, options->parallelDecode->maxInFlight.value_or(DEFAULT_MAX_IN_FLIGHT))));
+    }
+    if (options && options->schemas && !options->schemas->empty()) {
+        instance->_columnar.emplace(instance->_memory);
+        for (const EventSchema& schema : *options->schemas) {
+            instance->_columnar->add_schema(instance->_event_types.intern(schema.type), schema);
+        }
+    }
+    if (options && options->sampling) {
+        const SamplingOptions& sampling = *options->sampling;
+        instance->_sampler.emplace(static_cast<uint64_t>(std::max(1.0, sampling.every.value_or(1.0))),
+                                   static_cast<size_t>(std::max(0.0, sampling.reservoir.value_or(0.0))));
+        if (sampling.types) {
+            std::vector<bool> types;
+            for (const std::string& type : *sampling.types) {
+                const EventTypeTable::Id id = instance->_event_types.intern(type);
+                if (id >= types.size()) {
+                    types.resize(id + 1, false);
+                }
+                types[id] = true;
+            }
+            instance->_sampled_types = std::move(types);
+        }
+    }
+    if (options && options->capture) {
+        constexpr double DEFAULT_MAX_CAPTURE_BYTES = 64 * 1024 * 1024;
+        const std::string path = resolve_data_path(options->capture->file, options->storageDirectory);
+        const double max_bytes = std::max(0.0, options->capture->maxBytes.value_or(DEFAULT_MAX_CAPTURE_BYTES));
+        if (path.empty() || !(instance->_capture = CaptureWriter::open(path, static_cast<size_t>(max_bytes)))) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to create capture file, capture is disabled");
+        }
+    }
+    if (options && options->stateSync) {
+        instance->_snapshot_type = instance->_event_types.intern(options->stateSync->snapshotEvent.value_or("snapshot"));
+        instance->_patch_type = instance->_event_types.intern(options->stateSync->patchEvent.value_or("patch"));
+    }
+    if (options && options->stateSync && options->stateSync->key) {
+        const std::string directory = resolve_storage_directory(options->storageDirectory);
+        if (directory.empty()) {
+            NITRO_ES_LOG_WARN(TAG, "No storage directory, stateSync.key is ignored");
+        } else {
+            instance->_state_store = std::make_unique<StateSnapshotStore>(directory + "/" + storage_file_name("state", *options->stateSync->key));
+            std::string version;
+            std::string json;
+            JsonDocument document;
+            // The server then only sends what changed since this version, a patch merges into it as usual
+            if (instance->_state_store->load(version, json) && parse_json(json, document)) {
+                instance->_state = std::move(document);
+                instance->_state_compacted_bytes = instance->_state->arena->reserved_bytes();
+                instance->_state_version = std::move(version);
+            }
+        }
+    }
+
+    if (instance->network_aware()) {
+        instance->_network_subscription = NetworkMonitor::shared().subscribe(
+            [weak_instance = std::weak_ptr<HybridNitroEventSource>(instance)](bool online, bool interface_changed) {
+                TransferEngine::shared().post([weak_instance, online, interface_changed]() noexcept {
+                    if (auto instance = weak_instance.lock()) {
+                        instance->on_network_change(online, interface_changed);
+                    }
+                });
+            });
+    }
+
+    if (instance->_options && instance->_options->background) {
+        instance->_lifecycle_subscription = AppLifecycle::shared().subscribe(
+            [weak_instance = std::weak_ptr<HybridNitroEventSource>(instance)](bool foreground) {
+                TransferEngine::shared().post([weak_instance, foreground]() noexcept {
+                    if (auto instance = weak_instance.lock()) {
+                        instance->on_app_state(foreground);
+                    }
+                });
+            });
+    }
+
+    if (options && options->underLoad) {
+        instance->_load_subscription = DeviceLoad::shared().subscribe(
+            [weak_instance = std::weak_ptr<HybridNitroEventSource>(instance)](DeviceLoad::Level level) {
+                TransferEngine::shared().post([weak_instance, level]() noexcept {
+                    if (auto instance = weak_instance.lock()) {
+                        instance->on_device_load(level);
+                    }
+                });
+            });
+        // Nothing runs on the I/O thread yet, so a device already loaded applies right away
+        instance->_under_load.store(instance->loaded_for(DeviceLoad::shared().level()));
+    }
+
+    // lazyStart: nothing touches the TransferEngine, and with it its thread, until start()
+    if (options && options->lazyStart) {
+        instance->_start_pending.store(true);
+        if (options->lazyStart->prefetch.value_or(false)) {
+            preconnect_origin(url);
+        }
+    } else {
+        instance->start_connecting();
+    }
+    return instance;
+}
+
+void HybridNitroEventSource::start() {
+    if (_start_pending.exchange(false) && !closed()) {
+        start_connecting();
+    }
+}
 
+void HybridNitroEventSource::start_connecting() {
+    _engine_attached = true;
     try {
-        instance->_curl_thread = std::thread([weak_instance = std::weak_ptr<HybridNitroEventSource>(instance)]() noexcept {
+        // efficiencyCores only means something for background streams
+        _retained_efficiency = engine_priority() == TransferEngine::Priority::BACKGROUND && _options && _options->efficiencyCores.value_or(false);
+        TransferEngine::shared().retain_priority(engine_priority(), _retained_efficiency);
+        _retained_priority = engine_priority();
+        TransferEngine::shared().post([weak_instance = std::weak_ptr<HybridNitroEventSource>(shared_cast<HybridNitroEventSource>())]() noexcept {
             if (auto instance = weak_instance.lock()) {
+                // Created while backgrounded: the grace period starts now
+                if (instance->_lifecycle_subscription != 0 && !AppLifecycle::shared().foreground()) {
+                    instance->on_app_state(false);
+                }
                 instance->connect();
             }
         });
     } catch (const std::system_error& e) {
-        instance->log("Failed to create connection thread: " + std::string(e.what()));
+        NITRO_ES_LOG_ERROR(TAG, "Failed to start transfer engine: " + std::string(e.what()));
         throw;
     }
-
-    return instance;
 }
 
 HybridNitroEventSource::~HybridNitroEventSource() {
-    close();
+    mark_closed();
+
+    // Engine tasks, timers and transfers all hold a strong reference, so nothing
+    // on the I/O thread can still use a stream that is being destroyed
+    StreamRecycler& recycler = StreamRecycler::shared();
+    recycler.give_handle(std::exchange(_curl, nullptr), !(_spec && _spec->with_credentials));
+    while (std::optional<NitroEventSourceEvent> event = _event_pool.pop()) {
+        recycler.give_event(std::move(*event));
+    }
+    for (NitroEventSourceEvent& event : _discarded_events) {
+        recycler.give_event(std::move(event));
+    }
+    free_request_headers();
+    if (curl_slist* resolve = std::exchange(_resolve, nullptr)) {
+        curl_slist_free_all(resolve);
+    }
 }
 
 void HybridNitroEventSource::close() {
-    if (_closed.exchange(true)) {
-        log("EventSource already closed, skipping...");
+    if (!mark_closed()) {
+        NITRO_ES_LOG_DEBUG(TAG, "EventSource already closed, skipping...");
         return;
     }
 
-    log("Closing EventSource...");
+    detach(nullptr);
+}
+
+std::shared_ptr<Promise<void>> HybridNitroEventSource::closeAsync() {
+    auto promise = Promise<void>::create();
 
-    _running.store(false);
-    _should_retry.store(false);
+    // Already closed: the detach task is queued first, so resolving after it still confirms teardown
+    mark_closed();
+    detach(promise);
 
+    return promise;
+}
 
-    {
-        const std::lock_guard<std::mutex> callback_lock(_callback_mutex);
-        _event_callback = nullptr;
+bool HybridNitroEventSource::mark_closed() noexcept {
+    if (_lifecycle.fetch_or(CLOSED | NO_RETRY, std::memory_order_acq_rel) & CLOSED) {
+        return false;
     }
 
-    {
-        const std::lock_guard<std::mutex> listeners_lock(_listeners_mutex);
-        _event_listeners.clear();
-    }
+    NITRO_ES_LOG_INFO(TAG, "Closing EventSource...");
 
-    if (_curl_thread.joinable()) {
+    set_ready_state(ReadyState::CLOSED);
+    if (const uint64_t subscription = std::exchange(_network_subscription, 0)) {
+        NetworkMonitor::shared().unsubscribe(subscription);
+    }
+    if (const uint64_t subscription = std::exchange(_lifecycle_subscription, 0)) {
+        AppLifecycle::shared().unsubscribe(subscription);
+    }
+    if (const uint64_t subscription = std::exchange(_load_subscription, 0)) {
+        DeviceLoad::shared().unsubscribe(subscription);
+    }
+    if (const auto priority = std::exchange(_retained_priority, std::nullopt)) {
         try {
-            _curl_thread.join();
-            log("Connection thread terminated");
-        } catch (const std::system_error& e) {
-            log("Error joining thread: " + std::string(e.what()));
+            TransferEngine::shared().release_priority(*priority, _retained_efficiency);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to release stream priority: " + std::string(e.what()));
         }
     }
 
+    // Release the snapshots outside the lock, their destructors may free JS function handles
+    std::shared_ptr<const EventCallback> event_callback;
+    std::shared_ptr<const BatchCallback> batch_callback;
+    std::shared_ptr<const DrainCallback> drain_callback;
+    std::shared_ptr<const DataCallback> data_callback;
+    std::shared_ptr<const MessagesCallback> messages_callback;
+    std::shared_ptr<const UnauthorizedCallback> unauthorized_callback;
     {
-        const std::lock_guard<std::mutex> buffer_lock(_buffer_mutex);
-        _buffer.clear();
-        _event_type.clear();
-        _event_data.clear();
+        const std::lock_guard<std::mutex> callback_lock(_callback_mutex);
+        event_callback.swap(_event_callback);
+        batch_callback.swap(_batch_callback);
+        drain_callback.swap(_drain_callback);
+        data_callback.swap(_data_callback);
+        messages_callback.swap(_messages_callback);
+        unauthorized_callback.swap(_unauthorized_callback);
     }
 
-    log("EventSource closed successfully");
-}
+    std::unordered_map<uint64_t, ListenerSlot> listeners;
+    {
+        const std::lock_guard<std::mutex> listeners_lock(_listeners_mutex);
+        listeners.swap(_listener_slots);
+        _listeners_version.fetch_add(1);
+    }
+    _bus.clear();
 
-void HybridNitroEventSource::setEventCallback(const std::function<void(const NitroEventSourceEvent&)>& callback) {
-    const std::lock_guard<std::mutex> lock(_callback_mutex);
-    _event_callback = callback;
+#if NITRO_EVENT_SOURCE_PGO_GENERATE
+    write_training_profile();
+#endif
+    return true;
 }
 
-void HybridNitroEventSource::addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent&)>& listener) {
-    if (_closed.load()) {
-        log("Cannot add listener to closed EventSource");
+void HybridNitroEventSource::detach(const std::shared_ptr<Promise<void>>& promise) {
+    if (!_engine_attached) {
+        if (promise) {
+            promise->resolve();
+        }
         return;
     }
-    
-    const std::lock_guard<std::mutex> lock(_listeners_mutex);
-    _event_listeners[type].emplace_back(listener);
-}
 
-void HybridNitroEventSource::removeEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent&)>& /* listener */) {
-    const std::lock_guard<std::mutex> lock(_listeners_mutex);
-    
-    const auto it = _event_listeners.find(type);
-    if (it == _event_listeners.end()) {
-        return;
-    }
-    
-    auto& listeners = it->second;
-    
-    // Since std::function objects can't be reliably compared,
-    // remove the most recently added listener for this type (LIFO)
-    // This provides predictable behavior for the JavaScript wrapper
-    if (!listeners.empty()) {
-        listeners.pop_back();
-        
-        // Remove empty entries to prevent memory bloat
-        if (listeners.empty()) {
-            _event_listeners.erase(it);
+    // Tear down on the I/O thread without blocking the caller; the task keeps the stream alive until then
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), promise]() noexcept {
+        self->teardown();
+        if (promise) {
+            promise->resolve();
         }
-    }
+    });
 }
 
-void HybridNitroEventSource::dispatch_event(const NitroEventSourceEvent& event) noexcept {
-    if (_closed.load()) {
-        return;
-    }
-    
-    // Dispatch to single event callback (legacy onmessage/onerror/onopen)
+std::shared_ptr<Promise<void>> HybridNitroEventSource::close_all() {
+    auto promise = Promise<void>::create();
+
+    std::vector<std::shared_ptr<HybridNitroEventSource>> closing;
     {
-        const std::lock_guard<std::mutex> lock(_callback_mutex);
-        if (_event_callback) {
-            try {
-                _event_callback(event);
-            } catch (const std::exception& e) {
-                log("Exception in event callback: " + std::string(e.what()));
-            } catch (...) {
-                log("Unknown exception in event callback");
+        LiveStreams& live = live_streams();
+        const std::lock_guard<std::mutex> lock(live.mutex);
+        for (const std::weak_ptr<HybridNitroEventSource>& each : live.streams) {
+            if (std::shared_ptr<HybridNitroEventSource> stream = each.lock()) {
+                closing.push_back(std::move(stream));
             }
         }
+        live.streams.clear();
     }
-    
-    // Dispatch to event-specific listeners (addEventListener)
-    // Copy listeners to avoid holding lock during callback execution
-    std::vector<std::function<void(const NitroEventSourceEvent&)>> listeners_copy;
-    {
-        const std::lock_guard<std::mutex> lock(_listeners_mutex);
-        const auto it = _event_listeners.find(event.type);
-        if (it != _event_listeners.end()) {
-            listeners_copy = it->second;
-        }
+    // Streams closed before are already being torn down by their own task, which runs first
+    std::erase_if(closing, [](const std::shared_ptr<HybridNitroEventSource>& stream) {
+        return !stream->mark_closed() || !stream->_engine_attached;
+    });
+    if (closing.empty()) {
+        promise->resolve();
+        return promise;
     }
-    
-    for (const auto& listener : listeners_copy) {
-        if (_closed.load()) break;
-        
-        try {
-            listener(event);
-        } catch (const std::exception& e) {
-            log("Exception in event listener [" + event.type + "]: " + std::string(e.what()));
-        } catch (...) {
-            log("Unknown exception in event listener [" + event.type + "]");
+
+    NITRO_ES_LOG_INFO(TAG, "Closing " + std::to_string(closing.size()) + " streams");
+    TransferEngine::shared().post([closing = std::move(closing), promise]() noexcept {
+        for (const std::shared_ptr<HybridNitroEventSource>& stream : closing) {
+            stream->teardown();
         }
-    }
+        promise->resolve();
+    });
+    return promise;
 }
 
-void HybridNitroEventSource::connect() noexcept {
-    constexpr auto RECONNECT_DELAY = std::chrono::seconds(3);
-    constexpr auto POLL_INTERVAL = std::chrono::milliseconds(100);
-    
-    while (_running.load() && _should_retry.load() && !_closed.load()) {
-        _open_event_sent.store(false);
+void HybridNitroEventSource::watch_metrics(double interval_ms, const MetricsCallback& callback) {
+    constexpr double MIN_INTERVAL_MS = 250.0;
 
-        if (!attempt_connection()) {
-            log("Connection failed, reconnecting in 3s...");
-            
-            const auto end_time = std::chrono::steady_clock::now() + RECONNECT_DELAY;
-            while (std::chrono::steady_clock::now() < end_time && 
-                   _running.load() && _should_retry.load() && !_closed.load()) {
-                std::this_thread::sleep_for(POLL_INTERVAL);
-            }
-        }
+    MetricsWatch& watch = metrics_watch();
+    uint64_t generation = 0;
+    {
+        const std::lock_guard<std::mutex> lock(watch.mutex);
+        watch.callback = std::make_shared<const MetricsCallback>(callback);
+        watch.interval = std::chrono::duration_cast<TransferEngine::Clock::duration>(
+            std::chrono::duration<double, std::milli>(std::max(MIN_INTERVAL_MS, interval_ms)));
+        generation = ++watch.generation;
     }
-    
-    log("Connection thread terminated");
+    TransferEngine::shared().post([generation]() noexcept { sample_metrics(generation); });
 }
 
-bool HybridNitroEventSource::attempt_connection() noexcept {
-    struct CurlHandle {
-        CURL* handle;
-        explicit CurlHandle() : handle(curl_easy_init()) {}
-        ~CurlHandle() { if (handle) curl_easy_cleanup(handle); }
-        operator CURL*() const { return handle; }
-        CURL* get() const { return handle; }
-    };
-    
-    struct CurlHeaders {
-        curl_slist* list = nullptr;
-        ~CurlHeaders() { if (list) curl_slist_free_all(list); }
-        void append(const char* header) {
-            list = curl_slist_append(list, header);
-        }
-        curl_slist* get() const { return list; }
-    };
-
-    CurlHandle curl;
-    if (!curl.get()) {
-        log("Failed to initialize CURL");
-        return false;
+void HybridNitroEventSource::unwatch_metrics() noexcept {
+    MetricsWatch& watch = metrics_watch();
+    // Released outside the lock, it holds a JS function
+    std::shared_ptr<const MetricsCallback> callback;
+    {
+        const std::lock_guard<std::mutex> lock(watch.mutex);
+        callback.swap(watch.callback);
+        ++watch.generation;
     }
+}
 
-    const auto set_option = [&](CURLoption option, auto value) -> bool {
-        const CURLcode result = curl_easy_setopt(curl.get(), option, value);
-        if (result != CURLE_OK) {
-            log("CURL option error: " + std::string(curl_easy_strerror(result)));
-            return false;
+void HybridNitroEventSource::sample_metrics(uint64_t generation) noexcept {
+    MetricsWatch& watch = metrics_watch();
+    std::shared_ptr<const MetricsCallback> callback;
+    TransferEngine::Clock::duration interval{};
+    {
+        const std::lock_guard<std::mutex> lock(watch.mutex);
+        if (watch.generation != generation || !watch.callback) {
+            return;
         }
-        return true;
-    };
-
-    if (!set_option(CURLOPT_URL, _url.c_str()) ||
-        !set_option(CURLOPT_WRITEFUNCTION, curl_utils::write_callback) ||
-        !set_option(CURLOPT_WRITEDATA, this) ||
-        !set_option(CURLOPT_XFERINFOFUNCTION, curl_utils::progress_callback) ||
-        !set_option(CURLOPT_XFERINFODATA, this) ||
-        !set_option(CURLOPT_NOPROGRESS, 0L) ||
-        !set_option(CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1) ||
-        !set_option(CURLOPT_USERAGENT, "nitro-event-source/1.0") ||
-        !set_option(CURLOPT_FOLLOWLOCATION, 1L) ||
-        !set_option(CURLOPT_MAXREDIRS, 5L)) {
-        return false;
+        callback = watch.callback;
+        interval = watch.interval;
     }
 
-    CurlHeaders headers;
-    headers.append("Accept: text/event-stream");
-    headers.append("Cache-Control: no-cache");
-    headers.append("Connection: keep-alive");
+    try {
+        const std::vector<std::shared_ptr<HybridNitroEventSource>> streams = open_streams();
+        const TransferEngine::Clock::time_point now = TransferEngine::Clock::now();
+        std::vector<StreamMetricsSample> samples;
+        samples.reserve(streams.size());
+        for (const std::shared_ptr<HybridNitroEventSource>& stream : streams) {
+            samples.push_back(stream->metrics_sample(now));
+        }
+        (*callback)(samples);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Exception in metrics callback: " + std::string(e.what()));
+    } catch (...) {
+        NITRO_ES_LOG_ERROR(TAG, "Unknown exception in metrics callback");
+    }
+    TransferEngine::shared().schedule(TransferEngine::Clock::now() + interval, [generation]() noexcept { sample_metrics(generation); },
+                                      TransferEngine::Priority::BACKGROUND);
+}
 
-    if (!_last_event_id.empty()) {
-        const std::string last_event_header = "Last-Event-ID: " + _last_event_id;
-        headers.append(last_event_header.c_str());
+std::vector<HybridNitroEventSource::LiveMetrics> HybridNitroEventSource::live_metrics() {
+    std::vector<LiveMetrics> metrics;
+    for (const std::shared_ptr<HybridNitroEventSource>& stream : open_streams()) {
+        metrics.push_back(LiveMetrics{stream->_stream_id, stream->_spec->url, stream->getMetrics()});
     }
+    return metrics;
+}
 
-    if (_options && _options->headers) {
-        for (const auto& [key, value] : *_options->headers) {
-            const std::string header = key + ": " + value;
-            headers.append(header.c_str());
+StreamMetricsSample HybridNitroEventSource::metrics_sample(TransferEngine::Clock::time_point now) {
+    const uint64_t events = _events_dispatched.load(std::memory_order_relaxed);
+    const uint64_t bytes = _bytes_received.load(std::memory_order_relaxed);
+    // Rates over the time since this stream's previous sample, none for its first
+    double events_per_second = 0;
+    double bytes_per_second = 0;
+    if (_metrics_sampled_at) {
+        const double seconds = std::chrono::duration<double>(now - *_metrics_sampled_at).count();
+        if (seconds > 0) {
+            events_per_second = static_cast<double>(events - _sampled_events) / seconds;
+            bytes_per_second = static_cast<double>(bytes - _sampled_bytes) / seconds;
         }
     }
+    _metrics_sampled_at = now;
+    _sampled_events = events;
+    _sampled_bytes = bytes;
 
-    if (!set_option(CURLOPT_HTTPHEADER, headers.get())) {
-        return false;
+    const uint64_t attempts = _connect_attempts.load(std::memory_order_relaxed);
+    const LatencyHistogram dispatch = _dispatch_latency.snapshot();
+    return StreamMetricsSample(
+        static_cast<double>(_stream_id),
+        _spec->url,
+        getReadyState(),
+        events_per_second,
+        bytes_per_second,
+        static_cast<double>(_queued_events.load(std::memory_order_relaxed)),
+        static_cast<double>(_dropped_events.load(std::memory_order_relaxed)),
+        static_cast<double>(attempts > 0 ? attempts - 1 : 0),
+        dispatch.p50Us,
+        dispatch.p99Us);
+}
+
+void HybridNitroEventSource::teardown() noexcept {
+    release_connection();
+
+    if (_flush_timer) {
+        TransferEngine::shared().cancel(*_flush_timer);
+        _flush_timer.reset();
+    }
+    if (_token_timer) {
+        TransferEngine::shared().cancel(*_token_timer);
+        _token_timer.reset();
+    }
+    if (_aggregate_timer) {
+        TransferEngine::shared().cancel(*_aggregate_timer);
+        _aggregate_timer.reset();
+    }
+    if (_aggregator) {
+        _aggregator->reset();
+    }
+    if (_sample_timer) {
+        TransferEngine::shared().cancel(*_sample_timer);
+        _sample_timer.reset();
+    }
+    _samples.clear();
+    if (_replay_timer) {
+        TransferEngine::shared().cancel(*_replay_timer);
+        _replay_timer.reset();
+    }
+    _replay.reset();
+    // Flushes what stdio still buffers
+    _capture.reset();
+    _pending_events.clear();
+    _overflow_events.clear();
+    _pending_keys.clear();
+    // Workers still decoding finish into slots nobody delivers
+    _decoding.clear();
+    if (_columnar) {
+        _columnar->reset();
+    }
+    {
+        const std::lock_guard<std::mutex> lock(_raw_mutex);
+        std::vector<uint8_t>().swap(_raw_bytes);
+        _raw_memory.update(0);
+        _raw_queued.store(0);
     }
 
-    const CURLcode result = curl_easy_perform(curl.get());
-    
-    if (result != CURLE_OK && result != CURLE_ABORTED_BY_CALLBACK) {
-        log("Connection error: " + std::string(curl_easy_strerror(result)));
-        
-        long response_code = 0;
-        curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &response_code);
-        if (response_code > 0) {
-            log("HTTP response code: " + std::to_string(response_code));
-            dispatch_event(NitroEventSourceEvent(_last_event_id, "error", std::to_string(response_code)));
-        }
+    _parser.reset();
+    if (_framer) {
+        _framer->reset();
+    }
+    if (_message_framer) {
+        _message_framer->reset();
+    }
+    _event_type.clear();
+    _event_type_id = EventTypeTable::MESSAGE;
+    _event_has_id = false;
+    _seen_ids.clear();
+    if (_state_save_timer) {
+        TransferEngine::shared().cancel(*_state_save_timer);
+        _state_save_timer.reset();
+    }
+    save_state();
+    {
+        const std::lock_guard<std::mutex> state_lock(_state_mutex);
+        _state.reset();
     }
 
-    return result == CURLE_OK || result == CURLE_ABORTED_BY_CALLBACK;
+    NITRO_ES_LOG_INFO(TAG, "EventSource closed successfully");
 }
 
-void HybridNitroEventSource::parse_sse_chunk(std::string_view chunk) noexcept {
-    if (chunk.empty() || _closed.load()) {
-        return;
-    }
-    
-    const std::lock_guard<std::mutex> lock(_buffer_mutex);
-    _buffer.append(chunk);
+void HybridNitroEventSource::setEventCallback(const std::function<void(const NitroEventSourceEvent&)>& callback) {
+    store_callback(_event_callback, callback);
+}
 
-    size_t start = 0;
-    size_t pos = 0;
-    
-    while ((pos = _buffer.find('\n', start)) != std::string::npos) {
-        std::string_view line(_buffer.data() + start, pos - start);
-        start = pos + 1;
-        if (!line.empty() && line.back() == '\r') {
-            line.remove_suffix(1);
-        }
+void HybridNitroEventSource::setBatchCallback(const std::function<void(const std::vector<NitroEventSourceEvent>&)>& callback) {
+    store_callback(_batch_callback, callback);
+}
 
-        if (line.empty()) {
-            process_sse_event();
-            continue;
-        }
+void HybridNitroEventSource::setDataCallback(const std::function<void(const std::shared_ptr<ArrayBuffer>&)>& callback) {
+    store_callback(_data_callback, callback);
+}
 
-        const size_t colon_pos = line.find(':');
-        if (colon_pos == std::string_view::npos) {
-            continue;
-        }
+void HybridNitroEventSource::setMessagesCallback(const std::function<void(const std::vector<std::shared_ptr<ArrayBuffer>>&)>& callback) {
+    store_callback(_messages_callback, callback);
+}
 
-        const std::string_view field = line.substr(0, colon_pos);
-        std::string_view value = line.substr(colon_pos + 1);
-        
-        if (!value.empty() && value.front() == ' ') {
-            value.remove_prefix(1);
-        }
+void HybridNitroEventSource::setUnauthorizedCallback(const std::function<void()>& callback) {
+    store_callback(_unauthorized_callback, callback);
+}
 
-        if (field == "data") {
-            if (!_event_data.empty()) {
-                _event_data += '\n';
-            }
-            _event_data.append(value);
-        } else if (field == "event") {
-            _event_type.assign(value);
-        } else if (field == "id") {
-            _last_event_id.assign(value);
-        } else if (field == "retry") {
-            try {
-                const int retry_ms = std::stoi(std::string(value));
-                const int clamped_retry = std::clamp(retry_ms, 100, 60000);
-                // TODO: Actually use the retry value for reconnection timing
-                static_cast<void>(clamped_retry);
-            } catch (const std::exception&) {
-                log("Invalid retry value: " + std::string(value));
-            }
-        }
+void HybridNitroEventSource::updateHeaders(const std::unordered_map<std::string, std::string>& headers) {
+    if (closed()) {
+        return;
     }
-    
-    _buffer.erase(0, start);
+    // The header list belongs to the handle, which the I/O thread drives
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), headers]() {
+        self->_header_override = headers;
+        self->_headers_stale = true;
+        if (std::exchange(self->_awaiting_credentials, false)) {
+            self->connect();
+        }
+    });
 }
 
-void HybridNitroEventSource::process_sse_event() noexcept {
-    if (_event_data.empty() || _closed.load()) {
+void HybridNitroEventSource::setTypeFilter(const std::optional<std::vector<std::string>>& types) {
+    if (!_engine_attached) {
+        apply_type_filter(types);
         return;
     }
-    
+
+    // The filter and the type table belong to the parser, which runs on the I/O thread
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), types]() {
+        self->apply_type_filter(types);
+    });
+}
+
+void HybridNitroEventSource::apply_type_filter(const std::optional<std::vector<std::string>>& types) {
+    _type_filter = build_type_filter(types);
+}
+
+std::optional<std::vector<bool>> HybridNitroEventSource::build_type_filter(const std::optional<std::vector<std::string>>& types) {
+    if (!types) {
+        return std::nullopt;
+    }
+
+    std::vector<bool> filter(EventTypeTable::ERROR + 1, false);
+    filter[EventTypeTable::OPEN] = true;
+    filter[EventTypeTable::ERROR] = true;
+    for (const auto& type : *types) {
+        const EventTypeTable::Id id = _event_types.intern(type);
+        if (id >= filter.size()) {
+            filter.resize(id + 1, false);
+        }
+        filter[id] = true;
+    }
+    return filter;
+}
+
+bool HybridNitroEventSource::accepts_type(EventTypeTable::Id type) const noexcept {
+    if (!_type_filter) {
+        return true;
+    }
+    // Types that were never interned cannot be in the filter
+    return type < _type_filter->size() && (*_type_filter)[type];
+}
+
+void HybridNitroEventSource::setPayloadFilters(const std::vector<PayloadFilter>& filters) {
+    if (!_engine_attached) {
+        _payload_filters = filters;
+        return;
+    }
+
+    // Filters are evaluated by the parser, so swap them in on the I/O thread
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), filters]() {
+        self->_payload_filters = filters;
+    });
+}
+
+bool HybridNitroEventSource::is_duplicate_id(std::string_view id) noexcept {
+    if (id.empty()) {
+        return false;
+    }
+    try {
+        return _seen_ids.check_and_insert(id);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+bool HybridNitroEventSource::needs_json(EventTypeTable::Id type) const noexcept {
+    if (type == EventTypeTable::OPEN || type == EventTypeTable::ERROR) {
+        return false;
+    }
+    if (_options && _options->parseJson.value_or(false)) {
+        return true;
+    }
+    if (_columnar && _columnar->decodes(type)) {
+        return true;
+    }
+    if (_options && _options->latencyTracing && _options->latencyTracing->pointer) {
+        return true;
+    }
+    return std::any_of(_payload_filters.begin(), _payload_filters.end(), [](const PayloadFilter& filter) {
+        return filter.pointer.has_value();
+    });
+}
+
+bool HybridNitroEventSource::is_state_event(EventTypeTable::Id type) const noexcept {
+    return type != EventTypeTable::NONE && (type == _snapshot_type || type == _patch_type);
+}
+
+std::optional<std::vector<std::string>> HybridNitroEventSource::apply_state_event(EventTypeTable::Id type, std::string_view data) noexcept {
+    constexpr size_t MIN_COMPACT_BYTES = 64 * 1024;
+
+    try {
+        JsonDocument payload;
+        if (!decode_json(data, payload)) {
+            NITRO_ES_LOG_WARN(TAG, "Ignoring stateSync event whose data is not JSON");
+            return std::nullopt;
+        }
+
+        std::vector<std::string> paths;
+        const std::lock_guard<std::mutex> lock(_state_mutex);
+        if (type == _snapshot_type) {
+            _state = std::move(payload);
+            _state_compacted_bytes = _state->arena->reserved_bytes();
+            update_state_version();
+            paths.emplace_back();
+            return paths;
+        }
+
+        if (!_state) {
+            NITRO_ES_LOG_WARN(TAG, "Ignoring stateSync patch received before a snapshot");
+            return std::nullopt;
+        }
+        if (!apply_json_patch(*_state, payload.root, paths)) {
+            // The operations before the failing one are already applied, so the document
+            // cannot be trusted again until the next snapshot
+            _state.reset();
+            // Nothing to tell the server any more, the next connect asks for a full snapshot
+            _state_version.clear();
+            if (_state_store) {
+                _state_store->clear();
+                _state_dirty = false;
+            }
+            NITRO_ES_LOG_ERROR(TAG, "Failed to apply stateSync patch, waiting for the next snapshot");
+            return std::nullopt;
+        }
+
+        // Values a patch replaced stay in the arena until the document is rebuilt
+        const size_t reserved = _state->arena->reserved_bytes();
+        if (reserved > MIN_COMPACT_BYTES && reserved > 4 * _state_compacted_bytes && compact_json(*_state)) {
+            _state_compacted_bytes = _state->arena->reserved_bytes();
+        }
+        update_state_version();
+        return paths;
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to apply stateSync event, dropping it");
+        return std::nullopt;
+    }
+}
+
+void HybridNitroEventSource::update_state_version() noexcept {
+    // A burst of patches is written out once, the file holds the whole document
+    constexpr std::chrono::milliseconds SAVE_DELAY{1000};
+
+    const std::optional<std::string>& pointer = _options->stateSync->versionPointer;
+    const JsonValue* version = pointer ? find_pointer(_state->root, *pointer) : nullptr;
+    try {
+        if (!pointer) {
+            _state_version = _last_event_id;
+        } else if (!version) {
+            _state_version.clear();
+        } else if (const auto* text = std::get_if<JsonValue::String>(&version->value)) {
+            _state_version.assign(text->data(), text->size());
+        } else {
+            _state_version.clear();
+            serialize_json(*version, _state_version);
+        }
+    } catch (const std::bad_alloc&) {
+        _state_version.clear();
+    }
+
+    if (!_state_store || std::exchange(_state_dirty, true)) {
+        return;
+    }
+    try {
+        _state_save_timer = TransferEngine::shared().schedule(
+            TransferEngine::Clock::now() + SAVE_DELAY,
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->_state_save_timer.reset();
+                self->save_state();
+            },
+            TransferEngine::Priority::BACKGROUND);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule stateSync save: " + std::string(e.what()));
+        _state_dirty = false;
+    }
+}
+
+void HybridNitroEventSource::save_state() noexcept {
+    if (!std::exchange(_state_dirty, false) || !_state_store) {
+        return;
+    }
+    try {
+        std::string json;
+        {
+            const std::lock_guard<std::mutex> lock(_state_mutex);
+            if (!_state) {
+                return;
+            }
+            serialize_json(_state->root, json);
+        }
+        if (!_state_store->save(_state_version, json)) {
+            NITRO_ES_LOG_WARN(TAG, "Failed to save the stateSync document");
+        }
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to serialize the stateSync document");
+    }
+}
+
+void HybridNitroEventSource::preconnect(const std::string& url) {
+    preconnect_origin(url);
+}
+
+void HybridNitroEventSource::warmUp() {
+    TransferEngine::warm_up();
+}
+
+void HybridNitroEventSource::setConnectionLimits(double maxConnections, double maxConnectionsPerHost) {
+    set_connection_limits(maxConnections, maxConnectionsPerHost);
+}
+
+void HybridNitroEventSource::setMemoryBudget(double maxBufferedBytes) {
+    set_memory_budget(maxBufferedBytes);
+}
+
+void HybridNitroEventSource::setForeground(bool foreground) {
+    AppLifecycle::shared().report(foreground);
+}
+
+void HybridNitroEventSource::preconnect_origin(const std::string& url) noexcept {
+    try {
+        TransferEngine::shared().preconnect(url);
+    } catch (const std::system_error& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to start transfer engine: " + std::string(e.what()));
+    }
+}
+
+void HybridNitroEventSource::set_connection_limits(double maxConnections, double maxConnectionsPerHost) noexcept {
+    const auto to_limit = [](double value) {
+        return value >= 1.0 ? static_cast<long>(std::min(value, static_cast<double>(std::numeric_limits<long>::max()))) : 0L;
+    };
+    try {
+        TransferEngine::shared().set_connection_limits(to_limit(maxConnections), to_limit(maxConnectionsPerHost));
+    } catch (const std::system_error& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to start transfer engine: " + std::string(e.what()));
+    }
+}
+
+void HybridNitroEventSource::set_memory_budget(double maxBufferedBytes) noexcept {
+    MemoryBudget::shared().set_limit(maxBufferedBytes >= 1.0 ? static_cast<size_t>(std::min(maxBufferedBytes, static_cast<double>(SIZE_MAX))) : 0);
+}
+
+std::optional<NitroEventSourceEvent> HybridNitroEventSource::getWarmEvent(const std::string& type) {
+    if (!_warm_cache) {
+        return std::nullopt;
+    }
+    return _warm_cache->load(type);
+}
+
+std::vector<NitroEventSourceEvent> HybridNitroEventSource::getRecentEvents(const std::string& type) {
+    if (!_recent_events) {
+        return {};
+    }
+    return _recent_events->of_type(type, TransferEngine::Clock::now());
+}
+
+void HybridNitroEventSource::reportSlowListener(const std::string& type, const std::string& listener, double durationMs) {
+    _slow_listener_calls.fetch_add(1, std::memory_order_relaxed);
+    const std::lock_guard<std::mutex> lock(_slow_listener_mutex);
+    if (!_slowest_listener || durationMs > _slowest_listener->second) {
+        _slowest_listener.emplace(type + ": " + listener, durationMs);
+    }
+}
+
+std::vector<NitroEventSourceEvent> HybridNitroEventSource::replay(const std::string& fromId) {
+    if (!_journal) {
+        return {};
+    }
+    return _journal->replay(fromId);
+}
+
+std::optional<std::string> HybridNitroEventSource::getState(const std::string& pointer) {
+    const std::lock_guard<std::mutex> lock(_state_mutex);
+    if (!_state) {
+        return std::nullopt;
+    }
+    const JsonValue* value = find_pointer(_state->root, pointer);
+    if (!value) {
+        return std::nullopt;
+    }
+    std::string text;
+    serialize_json(*value, text);
+    return text;
+}
+
+bool HybridNitroEventSource::accepts_payload(const NitroEventSourceEvent& event, const JsonValue* json) const noexcept {
+    for (const PayloadFilter& filter : _payload_filters) {
+        // A typed filter only constrains events of that type
+        if (filter.type && *filter.type != event.type) {
+            continue;
+        }
+
+        if (filter.idPrefix && event.id.compare(0, filter.idPrefix->size(), *filter.idPrefix) != 0) {
+            return false;
+        }
+
+        if (!filter.pointer) {
+            continue;
+        }
+
+        // Payloads that are not JSON, or lack the field, never match a pointer filter
+        const JsonValue* value = json ? find_pointer(*json, *filter.pointer) : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (filter.equals && !scalar_equals(*value, *filter.equals)) {
+            return false;
+        }
+        if (filter.oneOf && std::none_of(filter.oneOf->begin(), filter.oneOf->end(), [&](const std::string& candidate) {
+                return scalar_equals(*value, candidate);
+            })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HybridNitroEventSource::setDrainCallback(const std::function<void()>& callback) {
+    store_callback(_drain_callback, callback);
+    // `pull` and fetchMode streams queue events for drainEvents() with or without a callback
+    _queued_delivery.store(static_cast<bool>(callback) || (_options && _options->pull.value_or(false)) || fetch_mode());
+}
+
+namespace {
+// Well inside the two minutes curl keeps an idle pooled connection
+std::chrono::milliseconds standby_keep_warm(const StandbyOptions& standby) noexcept {
+    constexpr double DEFAULT_KEEP_WARM_MS = 60000.0;
+    constexpr double MIN_KEEP_WARM_MS = 1000.0;
+    return std::chrono::milliseconds(static_cast<int64_t>(std::max(MIN_KEEP_WARM_MS, standby.keepWarmMs.value_or(DEFAULT_KEEP_WARM_MS))));
+}
+
+// receivedAt: milliseconds since the Unix epoch, as Date.now() but with sub-millisecond precision
+double epoch_ms(std::chrono::system_clock::time_point at) noexcept {
+    return std::chrono::duration<double, std::milli>(at.time_since_epoch()).count();
+}
+
+size_t to_max_events(std::optional<double> max_events) noexcept {
+    if (!max_events || !(*max_events < static_cast<double>(SIZE_MAX))) {
+        return SIZE_MAX;
+    }
+    return static_cast<size_t>(std::max(0.0, *max_events));
+}
+} // namespace
+
+std::vector<NitroEventSourceEvent> HybridNitroEventSource::drainEvents(std::optional<double> maxEvents) {
+    std::vector<QueuedEvent> queued = drain_queue(to_max_events(maxEvents));
+
+    std::vector<NitroEventSourceEvent> events;
+    events.reserve(queued.size());
+    for (auto& entry : queued) {
+        events.emplace_back(std::move(entry.event));
+    }
+    return events;
+}
+
+PackedEvents HybridNitroEventSource::drainPacked(std::optional<double> maxEvents) {
+    std::vector<QueuedEvent> events = drain_queue(to_max_events(maxEvents));
+    NITRO_ES_TRACE_SCOPE("pack_events");
+
+    // Sized first, so the batch's bytes take one allocation; offsets are Uint32 for JS, and
+    // a single drain never holds 4 GiB of events on a phone
+    size_t total = 0;
+    bool timestamped = false;
+    bool sequenced = false;
+    for (const QueuedEvent& entry : events) {
+        total += entry.event.id.size() + entry.event.data.size();
+        timestamped = timestamped || entry.event.receivedAt.has_value();
+        sequenced = sequenced || entry.event.sequence.has_value();
+    }
+
+    std::vector<uint8_t> bytes(total);
+    std::vector<uint8_t> index(events.size() * PACKED_INDEX_STRIDE * sizeof(uint32_t));
+    std::vector<uint8_t> received_at(timestamped ? events.size() * sizeof(double) : 0);
+    std::vector<uint8_t> sequences(sequenced ? events.size() * sizeof(double) : 0);
+    std::vector<std::string> types;
+    std::vector<NitroEventSourceEvent> details;
+    uint8_t* out = bytes.data();
+    for (size_t i = 0; i < events.size(); ++i) {
+        NitroEventSourceEvent& event = events[i].event;
+        // A stream uses a handful of types, each crosses once per batch
+        auto type = std::find(types.begin(), types.end(), event.type);
+        if (type == types.end()) {
+            type = types.insert(types.end(), event.type);
+        }
+        const uint32_t entry[PACKED_INDEX_STRIDE] = {
+            static_cast<uint32_t>(out - bytes.data()),
+            static_cast<uint32_t>(out - bytes.data() + event.id.size()),
+            static_cast<uint32_t>(type - types.begin()),
+            0,
+        };
+        std::memcpy(index.data() + i * sizeof(entry), entry, sizeof(entry));
+        out = std::copy(event.id.begin(), event.id.end(), out);
+        out = std::copy(event.data.begin(), event.data.end(), out);
+        if (timestamped) {
+            const double at = event.receivedAt.value_or(std::numeric_limits<double>::quiet_NaN());
+            std::memcpy(received_at.data() + i * sizeof(at), &at, sizeof(at));
+        }
+        if (sequenced) {
+            const double sequence = event.sequence.value_or(std::numeric_limits<double>::quiet_NaN());
+            std::memcpy(sequences.data() + i * sizeof(sequence), &sequence, sizeof(sequence));
+        }
+
+        // Connection events carry more than the buffer holds; they are rare and go whole
+        if (event.chunk || event.paths || event.error || event.timing) {
+            const auto detail = static_cast<uint32_t>(details.size() + 1);
+            std::memcpy(index.data() + i * sizeof(entry) + (PACKED_INDEX_STRIDE - 1) * sizeof(uint32_t), &detail, sizeof(detail));
+            details.push_back(std::move(event));
+        } else {
+            recycle_event(std::move(event));
+        }
+    }
+
+    std::optional<std::shared_ptr<ArrayBuffer>> received;
+    if (timestamped) {
+        received = ArrayBuffer::move(std::move(received_at));
+    }
+    std::optional<std::shared_ptr<ArrayBuffer>> sequence;
+    if (sequenced) {
+        sequence = ArrayBuffer::move(std::move(sequences));
+    }
+    return PackedEvents(static_cast<double>(events.size()), ArrayBuffer::move(std::move(bytes)), ArrayBuffer::move(std::move(index)),
+                        std::move(types), std::move(details), std::move(received), std::move(sequence));
+}
+
+std::vector<HybridNitroEventSource::QueuedEvent> HybridNitroEventSource::drain_queue(size_t max_events) {
+    NITRO_ES_TRACE_SCOPE("drain_events");
+    // Re-arm before popping so anything published after the last pop triggers a new drain
+    _drain_pending.store(false);
+
+    std::vector<QueuedEvent> events;
+    while (events.size() < max_events) {
+        // priorityTypes go first, however long the backlog behind them
+        auto event = _priority_queue.pop();
+        if (!event) {
+            event = _event_queue.pop();
+        }
+        if (!event) {
+            break;
+        }
+        events.emplace_back(std::move(*event));
+    }
+    _queued_events.fetch_sub(events.size());
+    // Stopped short of the end: nothing new may arrive to wake the drain callback for the rest
+    if (max_events > 0 && events.size() == max_events && _queued_events.load() > 0) {
+        notify_drain();
+    }
+
+    // Room freed up: let the I/O thread move held-back events in and resume a paused transfer
+    if (_overflowed.load() && !closed()) {
+        TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept {
+            self->refill_queue();
+        });
+    }
+
+    if (closed()) {
+        events.clear();
+    }
+    const auto now = TransferEngine::Clock::now();
+    for (const QueuedEvent& event : events) {
+        _dispatch_latency.record(now - event.dispatched_at);
+    }
+    _events_dispatched.fetch_add(events.size(), std::memory_order_relaxed);
+    return events;
+}
+
+void HybridNitroEventSource::loadHybridMethods() {
+    HybridNitroEventSourceSpec::loadHybridMethods();
+    // Shadows the generated drainEvents() with a conversion tuned for many small events
+    registerHybrids(this, [](Prototype& prototype) {
+        prototype.registerRawHybridMethod("drainEvents", 1, &HybridNitroEventSource::drain_events_to_jsi);
+        prototype.registerRawHybridMethod("drainSubscription", 2, &HybridNitroEventSource::drain_subscription_to_jsi);
+        // Likewise decodeMessage(), whose fields decode when read instead of all up front
+        prototype.registerRawHybridMethod("decodeMessage", 1, &HybridNitroEventSource::decode_message_to_jsi);
+    });
+}
+
+std::shared_ptr<AnyMap> HybridNitroEventSource::decodeMessage(const std::shared_ptr<ArrayBuffer>& message) {
+    auto map = AnyMap::make();
+    if (!message || !_message_schema) {
+        return map;
+    }
+
+    // AnyMap holds no binary, so `bytes` fields are left out here; the host object has them
+    const std::vector<ProtoSchema::Entry>& entries = _message_schema->entries();
+    std::vector<AnyArray> repeated(entries.size());
+    const std::string_view bytes(reinterpret_cast<const char*>(message->data()), message->size());
+    _message_schema->for_each_field(bytes, [&](size_t index, const proto_wire::Field& field) {
+        const ProtoSchema::Entry& entry = entries[index];
+        if (entry.type == ProtoFieldType::BYTES) {
+            return;
+        }
+        if (entry.type == ProtoFieldType::STRING) {
+            if (field.wire != proto_wire::WireType::LEN) {
+                return;
+            }
+            if (entry.repeated) {
+                repeated[index].emplace_back(std::string(field.bytes));
+            } else {
+                map->setString(entry.name, std::string(field.bytes));
+            }
+            return;
+        }
+        proto_wire::for_each_scalar(field, entry.type, [&](uint64_t bits) {
+            const std::variant<double, bool> value = proto_wire::scalar_value(bits, entry.type);
+            if (entry.repeated) {
+                std::visit([&](auto scalar) { repeated[index].emplace_back(scalar); }, value);
+            } else if (const bool* flag = std::get_if<bool>(&value)) {
+                map->setBoolean(entry.name, *flag);
+            } else {
+                map->setDouble(entry.name, std::get<double>(value));
+            }
+        });
+    });
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].repeated) {
+            map->setArray(entries[i].name, repeated[i]);
+        }
+    }
+    return map;
+}
+
+jsi::Value HybridNitroEventSource::decode_message_to_jsi(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+    if (count == 0 || !args[0].isObject()) {
+        return jsi::Value::undefined();
+    }
+    std::shared_ptr<ArrayBuffer> message = JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, args[0]);
+    if (!message) {
+        return jsi::Value::undefined();
+    }
+    return jsi::Object::createFromHostObject(runtime, std::make_shared<MessageHostObject>(std::move(message), _message_schema));
+}
+
+jsi::Value HybridNitroEventSource::drain_events_to_jsi(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+    std::optional<double> max_events;
+    if (count > 0 && args[0].isNumber()) {
+        max_events = args[0].getNumber();
+    }
+    detect_engine(runtime);
+    std::vector<QueuedEvent> events = drain_queue(to_max_events(max_events));
+
+    if (_options && _options->lazyPayloads.value_or(false)) {
+        jsi::Array array(runtime, events.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            auto host_object = std::make_shared<EventHostObject>(std::move(events[i].event), std::move(events[i].json), events[i].ascii);
+            array.setValueAtIndex(runtime, i, jsi::Object::createFromHostObject(runtime, std::move(host_object)));
+        }
+        return array;
+    }
+
+    std::vector<EventView> views;
+    views.reserve(events.size());
+    for (const QueuedEvent& event : events) {
+        views.push_back(EventView{&event.event, event.json ? &*event.json : nullptr, event.ascii, event.utf16 ? &*event.utf16 : nullptr});
+    }
+    jsi::Value array = events_to_jsi(runtime, views);
+
+    // JS now holds its own copies, hand the native strings back to the parser
+    for (QueuedEvent& event : events) {
+        recycle_event(std::move(event.event));
+    }
+    return array;
+}
+
+void HybridNitroEventSource::detect_engine(jsi::Runtime& runtime) {
+    if (_engine_detected) {
+        return;
+    }
+    _engine_detected = true;
+    // Lazy payloads may never read `data`, converting them ahead would be wasted
+    if (_utf16_min_bytes > 0 && !(_options && _options->lazyPayloads.value_or(false)) && jsi_utils::utf16_payloads(runtime)) {
+        _utf16_payloads.store(true, std::memory_order_relaxed);
+    }
+}
+
+jsi::Value HybridNitroEventSource::events_to_jsi(jsi::Runtime& runtime, const std::vector<EventView>& events) {
+    // Property names and repeated strings are created once per drain instead of once per event;
+    // they are not kept across calls because JSI values must not outlive their runtime
+    const jsi::PropNameID id_name = jsi::PropNameID::forAscii(runtime, "id");
+    const jsi::PropNameID type_name = jsi::PropNameID::forAscii(runtime, "type");
+    const jsi::PropNameID data_name = jsi::PropNameID::forAscii(runtime, "data");
+    const jsi::PropNameID received_at_name = jsi::PropNameID::forAscii(runtime, "receivedAt");
+    const jsi::PropNameID sequence_name = jsi::PropNameID::forAscii(runtime, "sequence");
+
+    // A stream only uses a handful of types and consecutive events usually share the last event id
+    std::vector<std::pair<const std::string*, jsi::Value>> types;
+    const std::string* last_id = nullptr;
+    jsi::Value last_id_value;
+
+    jsi::Array array(runtime, events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        const NitroEventSourceEvent& event = *events[i].event;
+
+        if (!last_id || *last_id != event.id) {
+            last_id = &event.id;
+            last_id_value = jsi::String::createFromUtf8(runtime, event.id);
+        }
+
+        auto type = std::find_if(types.begin(), types.end(), [&](const auto& entry) {
+            return *entry.first == event.type;
+        });
+        if (type == types.end()) {
+            types.emplace_back(&event.type, jsi::String::createFromUtf8(runtime, event.type));
+            type = std::prev(types.end());
+        }
+
+        jsi::Object object(runtime);
+        object.setProperty(runtime, id_name, jsi::Value(runtime, last_id_value));
+        object.setProperty(runtime, type_name, jsi::Value(runtime, type->second));
+        object.setProperty(runtime, data_name, jsi_utils::to_jsi_string(runtime, event.data, events[i].ascii, events[i].utf16));
+        if (event.receivedAt) {
+            object.setProperty(runtime, received_at_name, *event.receivedAt);
+        }
+        if (event.sequence) {
+            object.setProperty(runtime, sequence_name, *event.sequence);
+        }
+        if (events[i].json) {
+            object.setProperty(runtime, "json", jsi_utils::to_jsi(runtime, events[i].json->root));
+        }
+        if (event.chunk) {
+            object.setProperty(runtime, "chunk", JSIConverter<DataChunk>::toJSI(runtime, *event.chunk));
+        }
+        if (event.paths) {
+            object.setProperty(runtime, "paths", JSIConverter<std::vector<std::string>>::toJSI(runtime, *event.paths));
+        }
+        if (event.error) {
+            object.setProperty(runtime, "error", JSIConverter<StreamError>::toJSI(runtime, *event.error));
+        }
+        if (event.timing) {
+            object.setProperty(runtime, "timing", JSIConverter<ConnectionTiming>::toJSI(runtime, *event.timing));
+        }
+        array.setValueAtIndex(runtime, i, std::move(object));
+    }
+    return array;
+}
+
+double HybridNitroEventSource::subscribe(const std::function<void()>& callback) {
+    if (closed()) {
+        NITRO_ES_LOG_WARN(TAG, "Cannot subscribe to closed EventSource");
+        return 0;
+    }
+    const uint64_t id = _bus.subscribe(callback);
+    // Subscribers drain their own queues, so events are queued even without a drain callback
+    _queued_delivery.store(true);
+    return static_cast<double>(id);
+}
+
+void HybridNitroEventSource::setSubscriptionTypes(double subscriptionId, const std::optional<std::vector<std::string>>& types) {
+    if (subscriptionId < 1) {
+        return;
+    }
+    const auto id = static_cast<uint64_t>(subscriptionId);
+    if (!_engine_attached) {
+        _bus.set_types(id, build_type_filter(types));
+        return;
+    }
+
+    // Interned on the I/O thread, as setTypeFilter() does
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), id, types]() {
+        self->_bus.set_types(id, self->build_type_filter(types));
+    });
+}
+
+void HybridNitroEventSource::setSubscriptionActive(double subscriptionId, bool active) {
+    if (subscriptionId < 1) {
+        return;
+    }
+    const auto id = static_cast<uint64_t>(subscriptionId);
+    if (!_engine_attached) {
+        _bus.set_paused(id, !active);
+        return;
+    }
+
+    // What an inactive subscription holds is the publisher's, on the I/O thread
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), id, active]() {
+        self->_bus.set_paused(id, !active);
+    });
+}
+
+std::vector<NitroEventSourceEvent> HybridNitroEventSource::drainSubscription(double subscriptionId, std::optional<double> maxEvents) {
+    std::vector<NitroEventSourceEvent> events;
+    if (subscriptionId < 1) {
+        return events;
+    }
+    const std::vector<std::shared_ptr<const SharedEvent>> shared = drain_subscription(static_cast<uint64_t>(subscriptionId), to_max_events(maxEvents));
+    events.reserve(shared.size());
+    for (const auto& entry : shared) {
+        events.push_back(entry->event);
+    }
+    return events;
+}
+
+void HybridNitroEventSource::unsubscribe(double subscriptionId) {
+    if (subscriptionId >= 1) {
+        _bus.unsubscribe(static_cast<uint64_t>(subscriptionId));
+    }
+}
+
+std::vector<std::shared_ptr<const HybridNitroEventSource::SharedEvent>> HybridNitroEventSource::drain_subscription(uint64_t id, size_t max_events) {
+    NITRO_ES_TRACE_SCOPE("drain_subscription");
+    std::vector<std::shared_ptr<const SharedEvent>> events = _bus.drain(id, max_events);
+    if (closed()) {
+        events.clear();
+    }
+    const auto now = TransferEngine::Clock::now();
+    for (const auto& event : events) {
+        _dispatch_latency.record(now - event->dispatched_at);
+    }
+    _events_dispatched.fetch_add(events.size(), std::memory_order_relaxed);
+
+    // As in drain_queue(): a transfer the slowest subscriber paused may resume
+    if (_overflowed.load() && !closed()) {
+        TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept {
+            self->refill_queue();
+        });
+    }
+    return events;
+}
+
+jsi::Value HybridNitroEventSource::drain_subscription_to_jsi(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+    if (count == 0 || !args[0].isNumber() || args[0].getNumber() < 1) {
+        return jsi::Array(runtime, 0);
+    }
+    std::optional<double> max_events;
+    if (count > 1 && args[1].isNumber()) {
+        max_events = args[1].getNumber();
+    }
+    detect_engine(runtime);
+    const std::vector<std::shared_ptr<const SharedEvent>> events =
+        drain_subscription(static_cast<uint64_t>(args[0].getNumber()), to_max_events(max_events));
+
+    if (_options && _options->lazyPayloads.value_or(false)) {
+        jsi::Array array(runtime, events.size());
+        for (size_t i = 0; i < events.size(); ++i) {
+            auto host_object = std::make_shared<EventHostObject>(std::shared_ptr<const EventPayload>(events[i]));
+            array.setValueAtIndex(runtime, i, jsi::Object::createFromHostObject(runtime, std::move(host_object)));
+        }
+        return array;
+    }
+
+    // The events stay with the other subscribers' queues, so none go back to the pool
+    std::vector<EventView> views;
+    views.reserve(events.size());
+    for (const auto& event : events) {
+        views.push_back(EventView{&event->event, event->json ? &*event->json : nullptr, event->ascii, event->utf16 ? &*event->utf16 : nullptr});
+    }
+    return events_to_jsi(runtime, views);
+}
+
+double HybridNitroEventSource::addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent&)>& listener) {
+    if (closed()) {
+        NITRO_ES_LOG_WARN(TAG, "Cannot add listener to closed EventSource");
+        return 0;
+    }
+    
+    uint64_t id = 0;
+    {
+        const std::lock_guard<std::mutex> lock(_listeners_mutex);
+        id = _next_listener_id++;
+        _listener_slots.emplace(id, ListenerSlot{type, listener});
+        _listeners_version.fetch_add(1);
+    }
+
+    // Paint from the previous session right away, outside the lock in case the listener subscribes again
+    if (std::optional<NitroEventSourceEvent> cached = getWarmEvent(type)) {
+        listener(*cached);
+    }
+    return static_cast<double>(id);
+}
+
+void HybridNitroEventSource::removeEventListener(double subscriptionId) {
+    if (subscriptionId < 1) {
+        return;
+    }
+
+    // Declared before the lock so the removed JS function is released after unlocking
+    std::optional<ListenerSlot> removed;
+    const std::lock_guard<std::mutex> lock(_listeners_mutex);
+
+    auto node = _listener_slots.extract(static_cast<uint64_t>(subscriptionId));
+    if (node.empty()) {
+        return;
+    }
+
+    removed.emplace(std::move(node.mapped()));
+    _listeners_version.fetch_add(1);
+}
+
+std::shared_ptr<const HybridNitroEventSource::ListenerTable> HybridNitroEventSource::listeners_snapshot() noexcept {
+    // Hot path: nothing changed since the last event, no lock and no allocation
+    if (_listeners_version.load() == _listeners_snapshot_version) {
+        return _listeners_snapshot;
+    }
+
+    try {
+        auto table = std::make_shared<ListenerTable>();
+        bool has_listeners = false;
+        std::vector<std::pair<uint64_t, const ListenerSlot*>> ordered;
+        {
+            const std::lock_guard<std::mutex> lock(_listeners_mutex);
+            _listeners_snapshot_version = _listeners_version.load();
+
+            // Subscription ids grow monotonically, so sorting by id restores registration order
+            ordered.reserve(_listener_slots.size());
+            for (const auto& [id, slot] : _listener_slots) {
+                ordered.emplace_back(id, &slot);
+            }
+            std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            });
+            for (const auto& [id, slot] : ordered) {
+                const EventTypeTable::Id type = _event_types.intern(slot->type);
+                if (type >= table->size()) {
+                    table->resize(type + 1);
+                }
+                (*table)[type].push_back(slot->callback);
+                has_listeners = true;
+            }
+        }
+        _listeners_snapshot = has_listeners ? std::move(table) : nullptr;
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to rebuild listener table: " + std::string(e.what()));
+        _listeners_snapshot_version = 0;
+    }
+
+    return _listeners_snapshot;
+}
+
+void HybridNitroEventSource::dispatch_event(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json,
+                                            bool ascii) noexcept {
+    NITRO_ES_TRACE_SCOPE("dispatch_event");
+    const CpuTimeAccount::Scope dispatching(_cpu_time, CpuTimeAccount::Phase::DISPATCH);
+    if (closed()) {
+        return;
+    }
+    // Parsed events carry their chunk's arrival, the ones native raises itself happen now
+    if (!event.receivedAt) {
+        event.receivedAt = epoch_ms(std::chrono::system_clock::now());
+    }
+    if (!_decoding.empty() && !_delivering_decoded) {
+        queue_behind_decodes(event, type, json, ascii);
+        return;
+    }
+    // Only what the stream said: connection events and the pieces of a chunked event are not replayed
+    if (_recent_events && type != EventTypeTable::OPEN && type != EventTypeTable::ERROR && !event.chunk) {
+        _recent_events->record(event, TransferEngine::Clock::now());
+    }
+
+    // Coalescing needs a window to merge in, so it implies batching
+    if (_options && (_options->batch || _options->coalesce || _under_load.load(std::memory_order_relaxed))) {
+        enqueue_event(QueuedEvent{std::move(event), type, std::move(json), ascii});
+        return;
+    }
+
+    if (_queued_delivery.load()) {
+        publish_event(QueuedEvent{std::move(event), type, std::move(json), ascii});
+        notify_drain();
+        return;
+    }
+
+    // Direct delivery, for spec consumers only: each of these converts and crosses into JS separately.
+    // EventSource takes the queued path above, one drain per burst fanned out in JS
+    _events_dispatched.fetch_add(1, std::memory_order_relaxed);
+    notify_callback(event);
+    notify_listeners(event, type);
+}
+
+void HybridNitroEventSource::arm_idle_timer() noexcept {
+    if (!_stall_timer) {
+        arm_stall_timer(_last_received);
+    }
+    const double idle_ms = (_options && _options->timeouts) ? _options->timeouts->idleMs.value_or(0.0) : 0.0;
+    if (idle_ms <= 0.0) {
+        return;
+    }
+
+    // Fires once per idle period rather than per chunk; data since then only pushes the next check out
+    const auto deadline = _last_received + std::chrono::duration_cast<TransferEngine::Clock::duration>(std::chrono::duration<double, std::milli>(idle_ms));
+    try {
+        _idle_timer = TransferEngine::shared().schedule(
+            deadline,
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->_idle_timer.reset();
+                if (self->check_idle()) {
+                    self->arm_idle_timer();
+                } else {
+                    self->abort_transfer();
+                }
+            },
+            engine_priority());
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule idle timeout: " + std::string(e.what()));
+    }
+}
+
+void HybridNitroEventSource::cancel_idle_timer() noexcept {
+    if (_idle_timer) {
+        TransferEngine::shared().cancel(*_idle_timer);
+        _idle_timer.reset();
+    }
+    if (_stall_timer) {
+        TransferEngine::shared().cancel(*_stall_timer);
+        _stall_timer.reset();
+    }
+    // A hedge still handshaking answers for a transfer that is gone
+    ++_hedge_generation;
+    _hedged_silence.reset();
+}
+
+void HybridNitroEventSource::arm_stall_timer(TransferEngine::Clock::time_point from) noexcept {
+    const double stall_ms = (_options && _options->timeouts) ? _options->timeouts->stallMs.value_or(0.0) : 0.0;
+    if (stall_ms <= 0.0) {
+        return;
+    }
+    try {
+        _stall_timer = TransferEngine::shared().schedule(
+            from + std::chrono::duration_cast<TransferEngine::Clock::duration>(std::chrono::duration<double, std::milli>(stall_ms)),
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->_stall_timer.reset();
+                self->check_stall();
+            },
+            engine_priority());
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule stall check: " + std::string(e.what()));
+    }
+}
+
+void HybridNitroEventSource::check_stall() noexcept {
+    const double stall_ms = (_options && _options->timeouts) ? _options->timeouts->stallMs.value_or(0.0) : 0.0;
+    const auto now = TransferEngine::Clock::now();
+    // Before the stream opened the connect timeout is in charge, and backpressure silence is ours
+    if (!_open_event_sent.load() || _transfer_paused || !should_retry()) {
+        arm_stall_timer(now);
+        return;
+    }
+    if (now - _last_received < std::chrono::duration<double, std::milli>(stall_ms)) {
+        arm_stall_timer(_last_received);
+        return;
+    }
+    // One hedge per silence; it already failed or is still on its way
+    if (_hedged_silence == _last_received) {
+        arm_stall_timer(now);
+        return;
+    }
+
+    NITRO_ES_LOG_INFO(TAG, "Stalled for timeouts.stallMs, opening a fresh connection alongside");
+    _hedged_silence = _last_received;
+    const uint64_t generation = ++_hedge_generation;
+    try {
+        TransferEngine::shared().preconnect(request_url(), true, [self = shared_cast<HybridNitroEventSource>(), generation](CURLcode result) {
+            // Switching removes the stalled transfer, which is not done from within another one's completion
+            TransferEngine::shared().post([self, generation, result]() noexcept {
+                self->on_hedge_done(generation, result);
+            });
+        });
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to open a fresh connection: " + std::string(e.what()));
+    }
+    arm_stall_timer(now);
+}
+
+void HybridNitroEventSource::on_hedge_done(uint64_t generation, CURLcode result) noexcept {
+    // Data arrived meanwhile, or the transfer already ended: the old connection stays or is gone anyway
+    if (generation != _hedge_generation || _hedged_silence != _last_received || !_curl) {
+        return;
+    }
+    if (result != CURLE_OK) {
+        NITRO_ES_LOG_DEBUG(TAG, "Fresh connection failed, leaving the stalled one to timeouts.idleMs");
+        return;
+    }
+
+    // The network works but this connection does not: close it rather than let the reconnect
+    // multiplex onto it again, and resume over the fresh one straight away
+    NITRO_ES_LOG_INFO(TAG, "Fresh connection got through first, switching to it");
+    _idle_timed_out = true;
+    _stall_switch = true;
+    curl_easy_setopt(_curl, CURLOPT_FORBID_REUSE, 1L);
+    abort_transfer();
+    _stall_switch = false;
+    if (_curl) {
+        curl_easy_setopt(_curl, CURLOPT_FORBID_REUSE, 0L);
+    }
+}
+
+void HybridNitroEventSource::abort_transfer() noexcept {
+    // Nothing to do when the transfer already finished or was detached
+    if (_curl && TransferEngine::shared().remove_transfer(_curl)) {
+        on_transfer_done(CURLE_ABORTED_BY_CALLBACK);
+    }
+}
+
+bool HybridNitroEventSource::check_idle() noexcept {
+    const double idle_ms = (_options && _options->timeouts) ? _options->timeouts->idleMs.value_or(0.0) : 0.0;
+    const auto now = TransferEngine::Clock::now();
+    // Nothing is read while paused for backpressure, that silence is ours
+    if (idle_ms <= 0.0 || _transfer_paused) {
+        _last_received = now;
+        return true;
+    }
+
+    // Comments and heartbeats count too, anything at all proves the connection is alive
+    if (now - _last_received < std::chrono::duration<double, std::milli>(idle_ms)) {
+        return true;
+    }
+    _idle_timed_out = true;
+    return false;
+}
+
+bool HybridNitroEventSource::receive_body(std::string_view bytes) noexcept {
+    const CpuTimeAccount::Scope parsing(_cpu_time, CpuTimeAccount::Phase::PARSE);
+    if (_decode_body) {
+        const CpuTimeAccount::Scope decoding(_cpu_time, CpuTimeAccount::Phase::DECODE);
+        _decoded.clear();
+        if (!_decoder->decode(bytes, _decoded)) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to decode zstd response body");
+            return false;
+        }
+        bytes = _decoded;
+    }
+
+    _bytes_received.fetch_add(bytes.size(), std::memory_order_relaxed);
+    // Every event parsed from this chunk carries its arrival as receivedAt
+    _chunk_received_wall = std::chrono::system_clock::now();
+    if (_options && _options->latencyTracing) {
+        _chunk_received_at = TransferEngine::Clock::now();
+    }
+
+    if (websocket()) {
+        receive_ws_frame(bytes);
+        return true;
+    }
+    // rawMode bypasses SSE framing entirely and forwards the bytes as they arrive, or split into messages
+    if (_message_framer) {
+        const bool in_step = _message_framer->feed(bytes);
+        dispatch_messages();
+        if (!in_step) {
+            NITRO_ES_LOG_ERROR(TAG, "Malformed length prefix in framed response body");
+            return false;
+        }
+    } else if (raw_mode()) {
+        dispatch_chunk(bytes);
+    } else {
+        // Includes handing complete events on, i.e. everything this chunk costs the I/O thread
+        const auto started = TransferEngine::Clock::now();
+        const uint64_t parsed_before = _events_parsed.load(std::memory_order_relaxed);
+        if (_framer) {
+            _framer->feed(bytes);
+        } else {
+            parse_sse_chunk(bytes);
+        }
+        _parse_time.record(TransferEngine::Clock::now() - started);
+        if (_buffering) {
+            detect_buffering(started, _events_parsed.load(std::memory_order_relaxed) - parsed_before);
+        }
+    }
+    return true;
+}
+
+namespace {
+
+// A timestamp's unit in microseconds, milliseconds by default
+double timestamp_unit_us(std::optional<TimestampUnit> unit) noexcept {
+    switch (unit.value_or(TimestampUnit::MS)) {
+        case TimestampUnit::S: return 1e6;
+        case TimestampUnit::MS: return 1e3;
+        case TimestampUnit::US: return 1.0;
+    }
+    return 1e3;
+}
+
+// A whole numeric string such as `1718000000123` or `1718000000.123`
+std::optional<double> parse_timestamp(std::string_view text) noexcept {
+    // strtod needs a terminated buffer; timestamps are short enough for the stack
+    char terminated[32];
+    if (text.empty() || text.size() >= sizeof(terminated)) {
+        return std::nullopt;
+    }
+    std::memcpy(terminated, text.data(), text.size());
+    terminated[text.size()] = '\0';
+    char* end = nullptr;
+    const double value = std::strtod(terminated, &end);
+    if (end != terminated + text.size() || !std::isfinite(value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Header value when `header` is `name: value`, `name` given in lower case
+std::optional<std::string_view> header_value(std::string_view header, std::string_view name) noexcept {
+    if (header.size() <= name.size() || header[name.size()] != ':') {
+        return std::nullopt;
+    }
+    for (size_t i = 0; i < name.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(header[i])) != name[i]) {
+            return std::nullopt;
+        }
+    }
+    std::string_view value = header.substr(name.size() + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equals_ignoring_case(std::string_view a, std::string_view b) noexcept {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+struct ContentCodings {
+    std::string_view outermost;
+    size_t count = 0;
+};
+
+// A Content-Encoding value lists its codings in the order they were applied, the last one is
+// undone first; `identity` changes nothing and is left out
+ContentCodings content_codings(std::string_view value) noexcept {
+    ContentCodings codings;
+    while (!value.empty()) {
+        const size_t comma = std::min(value.find(','), value.size());
+        std::string_view coding = value.substr(0, comma);
+        value.remove_prefix(std::min(comma + 1, value.size()));
+        while (!coding.empty() && (coding.front() == ' ' || coding.front() == '\t')) {
+            coding.remove_prefix(1);
+        }
+        while (!coding.empty() && (coding.back() == ' ' || coding.back() == '\t')) {
+            coding.remove_suffix(1);
+        }
+        if (coding.empty() || equals_ignoring_case(coding, "identity")) {
+            continue;
+        }
+        codings.outermost = coding;
+        ++codings.count;
+    }
+    return codings;
+}
+
+} // namespace
+
+bool HybridNitroEventSource::receive_header(std::string_view header) noexcept {
+    // Every response, including redirects, starts with its status line: `HTTP/1.1 200 OK`, `HTTP/2 200`
+    if (header.substr(0, 5) == "HTTP/") {
+        const size_t space = std::min(header.find(' '), header.size());
+        _response_status = 0;
+        for (size_t i = space + 1; i < header.size() && std::isdigit(static_cast<unsigned char>(header[i])); ++i) {
+            _response_status = _response_status * 10 + (header[i] - '0');
+        }
+        if (_response_status == 301 || _response_status == 302 || _response_status == 303 || _response_status == 307 || _response_status == 308) {
+            _redirects_permanent &= _response_status == 301 || _response_status == 308;
+            _redirects_keep_method &= _response_status == 307 || _response_status == 308;
+        }
+        _response_content_type.clear();
+        _response_headers.clear();
+        _rejected_content_type = false;
+        _decode_body = false;
+        if (_decoder) {
+            _decoder->reset();
+        }
+        return true;
+    }
+
+    // The blank line closing the headers
+    if (header == "\r\n" || header == "\n") {
+        return accepts_response();
+    }
+
+    if (fetch_mode()) {
+        collect_response_header(header);
+    }
+    if (const auto content_type = header_value(header, "content-type")) {
+        _response_content_type.assign(*content_type);
+    } else if (const auto encoding = header_value(header, "content-encoding"); encoding && _decoder) {
+        // Only a zstd layer on the outside is ours to undo; curl's decoding is off with a dictionary
+        const ContentCodings codings = content_codings(*encoding);
+        _decode_body = equals_ignoring_case(codings.outermost, "zstd");
+        if (codings.count > (_decode_body ? 1 : 0)) {
+            NITRO_ES_LOG_WARN(TAG, "Response body is encoded as \"" + std::string(*encoding) + "\", only a dictionary zstd layer is decoded");
+        }
+    }
+    return true;
+}
+
+void HybridNitroEventSource::collect_response_header(std::string_view header) noexcept {
+    const size_t colon = header.find(':');
+    if (colon == std::string_view::npos || colon == 0) {
+        return;
+    }
+    std::string_view value = header.substr(colon + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+        value.remove_suffix(1);
+    }
+    try {
+        std::string name(header.substr(0, colon));
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        // Repeated headers read as one, the way fetch's Headers.get() joins them
+        auto [it, inserted] = _response_headers.try_emplace(std::move(name), value);
+        if (!inserted) {
+            it->second.append(", ").append(value);
+        }
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_WARN(TAG, "Dropped a response header, out of memory");
+    }
+}
+
+bool HybridNitroEventSource::accepts_response() noexcept {
+    // fetchMode takes whatever final response arrives, its status is for the caller to judge
+    if (fetch_mode()) {
+        if (_response_status >= 200) {
+            const std::lock_guard<std::mutex> lock(_response_head_mutex);
+            _response_head = ResponseHead(static_cast<double>(_response_status), std::move(_response_headers));
+        }
+        _response_headers.clear();
+        return true;
+    }
+    // Interim responses and redirects curl follows itself; a 204 or other endOfStream status ends in on_transfer_done()
+    if (_response_status < 200 || (_response_status >= 300 && _response_status < 400) || is_terminal_status(_response_status)) {
+        return true;
+    }
+    // Per the EventSource spec anything but a 200 fails the connection, on_transfer_done() reports the status
+    if (_response_status != 200) {
+        NITRO_ES_LOG_WARN(TAG, "Rejected response with HTTP status " + std::to_string(_response_status));
+        return false;
+    }
+
+    // Media type without parameters, e.g. `text/event-stream; charset=utf-8`
+    std::string media_type = _response_content_type.substr(0, _response_content_type.find(';'));
+    while (!media_type.empty() && std::isspace(static_cast<unsigned char>(media_type.back()))) {
+        media_type.pop_back();
+    }
+    std::transform(media_type.begin(), media_type.end(), media_type.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    std::vector<std::string> defaults;
+    switch (stream_format()) {
+        case StreamFormat::SSE: defaults = {"text/event-stream"}; break;
+        case StreamFormat::NDJSON: defaults = {"application/x-ndjson", "application/jsonl", "application/json"}; break;
+        case StreamFormat::JSON_SEQ: defaults = {"application/json-seq"}; break;
+    }
+    const std::vector<std::string>& accepted = (_options && _options->contentTypes) ? *_options->contentTypes : defaults;
+    if (accepted.empty()) {
+        return true;
+    }
+    for (const std::string& type : accepted) {
+        if (type.size() == media_type.size() &&
+            std::equal(type.begin(), type.end(), media_type.begin(), [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; })) {
+            return true;
+        }
+    }
+    NITRO_ES_LOG_WARN(TAG, "Rejected response with Content-Type '" + _response_content_type + "'");
+    _rejected_content_type = true;
+    return false;
+}
+
+void HybridNitroEventSource::dispatch_chunk(std::string_view chunk) noexcept {
+    if (fetch_mode()) {
+        queue_chunk(chunk);
+        return;
+    }
+    const auto callback = load_callback(_data_callback);
+    if (!callback) {
+        return;
+    }
+
+    // curl reuses its receive buffer, so the bytes are copied exactly once into a buffer JS then owns
+    try {
+        std::vector<uint8_t> bytes(chunk.begin(), chunk.end());
+        (*callback)(ArrayBuffer::move(std::move(bytes)));
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Exception in data callback: " + std::string(e.what()));
+    } catch (...) {
+        NITRO_ES_LOG_ERROR(TAG, "Unknown exception in data callback");
+    }
+}
+
+void HybridNitroEventSource::queue_chunk(std::string_view chunk) noexcept {
+    {
+        const std::lock_guard<std::mutex> lock(_raw_mutex);
+        try {
+            _raw_bytes.insert(_raw_bytes.end(), chunk.begin(), chunk.end());
+        } catch (const std::bad_alloc&) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to queue response bytes, dropping them");
+            return;
+        }
+        _raw_memory.update(static_cast<int64_t>(_raw_bytes.capacity()));
+        _raw_queued.store(_raw_bytes.size());
+    }
+    notify_drain();
+}
+
+std::optional<std::shared_ptr<ArrayBuffer>> HybridNitroEventSource::drainData() {
+    NITRO_ES_TRACE_SCOPE("drain_data");
+    // Re-armed first, as in drain_queue(), so bytes queued after the take wake JS again
+    _drain_pending.store(false);
+
+    std::vector<uint8_t> bytes;
+    {
+        const std::lock_guard<std::mutex> lock(_raw_mutex);
+        bytes.swap(_raw_bytes);
+        _raw_memory.update(0);
+        _raw_queued.store(0);
+    }
+    // The transfer paused on maxQueuedBytes picks up again, from its own thread
+    if (_overflowed.load() && !closed()) {
+        TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept {
+            self->refill_queue();
+        });
+    }
+    if (bytes.empty() || closed()) {
+        return std::nullopt;
+    }
+    // Everything that arrived since the last take crosses as one buffer JS owns, without another copy
+    return ArrayBuffer::move(std::move(bytes));
+}
+
+bool HybridNitroEventSource::append_row(EventTypeTable::Id type, const JsonValue& root, std::string_view id) noexcept {
+    try {
+        if (!_columnar->append(type, root, id)) {
+            return false;
+        }
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to decode event into columns: " + std::string(e.what()));
+        return false;
+    }
+    notify_drain();
+    return true;
+}
+
+std::vector<EventColumns> HybridNitroEventSource::drainColumns() {
+    if (!_columnar) {
+        return {};
+    }
+    NITRO_ES_TRACE_SCOPE("drain_columns");
+    // Re-armed first, as in drain_queue(), so rows appended after the take wake JS again
+    _drain_pending.store(false);
+    std::vector<EventColumns> batches = _columnar->take(_event_types);
+
+    // Room freed up: a transfer paused on maxQueuedEvents picks up again
+    if (_overflowed.load() && !closed()) {
+        TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept {
+            self->refill_queue();
+        });
+    }
+    if (closed()) {
+        return {};
+    }
+    uint64_t rows = 0;
+    for (const EventColumns& batch : batches) {
+        rows += static_cast<uint64_t>(batch.count);
+    }
+    _events_dispatched.fetch_add(rows, std::memory_order_relaxed);
+    return batches;
+}
+
+std::optional<ResponseHead> HybridNitroEventSource::getResponseHead() {
+    const std::lock_guard<std::mutex> lock(_response_head_mutex);
+    return _response_head;
+}
+
+void HybridNitroEventSource::detect_buffering(TransferEngine::Clock::time_point at, uint64_t events) noexcept {
+    const bool flagged = _buffering->record_read(at, static_cast<uint32_t>(std::min<uint64_t>(events, UINT32_MAX)));
+    _buffered_bursts.store(_buffering->bursts(), std::memory_order_relaxed);
+    if (!flagged) {
+        return;
+    }
+    _proxy_buffering.store(true, std::memory_order_relaxed);
+    NITRO_ES_LOG_WARN(TAG, "Events arrive in delayed bursts, something on the way buffers the stream");
+    fall_back_from_buffering();
+}
+
+void HybridNitroEventSource::fall_back_from_buffering() noexcept {
+    const BufferingDetectionOptions& options = *_options->bufferingDetection;
+    const bool to_websocket = options.fallback == StreamTransport::WEBSOCKET && !websocket() && curl_utils::supports_websockets();
+    if ((!to_websocket && !options.fallbackUrl) || std::exchange(_buffering_fallen_back, true)) {
+        return;
+    }
+
+    // Posted: the transfer cannot be taken away inside its own write callback
+    TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>(), to_websocket]() {
+        if (self->closed() || !self->_curl || !self->should_retry()) {
+            return;
+        }
+        if (to_websocket) {
+            NITRO_ES_LOG_INFO(TAG, "Switching to the WebSocket transport");
+            // Only the I/O thread reads the transport; the handle and its headers are rebuilt for it
+            self->_websocket_fallback = true;
+            self->release_connection();
+        } else {
+            const std::string& url = *self->_options->bufferingDetection->fallbackUrl;
+            NITRO_ES_LOG_INFO(TAG, "Switching to " + url);
+            // The buffered endpoint cools down, so the next attempts stay away from it too
+            self->_endpoints.record_failure(self->_endpoint, TransferEngine::Clock::now());
+            self->_failover_endpoint = self->_endpoints.add(url);
+            self->cancel_idle_timer();
+            TransferEngine::shared().remove_transfer(self->_curl);
+        }
+        self->connect();
+    });
+}
+
+void HybridNitroEventSource::receive_ws_frame(std::string_view bytes) noexcept {
+    const curl_ws_frame* frame = curl_ws_meta(_curl);
+    // curl answers pings and the closing handshake itself, the transfer then ends as any other
+    if (!frame || (frame->flags & (CURLWS_TEXT | CURLWS_BINARY)) == 0) {
+        return;
+    }
+    const size_t max_bytes = parser_limits().max_event_bytes;
+    // More of this frame in a later callback, or more frames of this message
+    const bool complete = frame->bytesleft == 0 && (frame->flags & CURLWS_CONT) == 0;
+    const bool binary = (frame->flags & CURLWS_BINARY) != 0;
+
+    // A whole message in one callback goes on without a copy, as most do
+    if (complete && _ws_message.empty() && !_ws_oversized) {
+        deliver_ws_message(bytes, bytes.size() > max_bytes, binary);
+        return;
+    }
+    if (!_ws_oversized && _ws_message.size() + bytes.size() > max_bytes) {
+        std::string().swap(_ws_message);
+        _ws_oversized = true;
+    }
+    if (!_ws_oversized) {
+        _ws_message.append(bytes);
+    }
+    if (complete) {
+        deliver_ws_message(_ws_message, std::exchange(_ws_oversized, false), binary);
+        _ws_message.clear();
+    }
+}
+
+void HybridNitroEventSource::deliver_ws_message(std::string_view message, bool oversized, bool binary) noexcept {
+    // Text is an event's data as with the record formats, binary goes out like rawFraming messages
+    if (!binary) {
+        process_record(oversized ? std::string_view() : message, oversized);
+        return;
+    }
+    collect_message(oversized ? std::string_view() : message, oversized);
+    dispatch_messages();
+}
+
+void HybridNitroEventSource::collect_message(std::string_view message, bool oversized) noexcept {
+    if (oversized) {
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    _events_parsed.fetch_add(1, std::memory_order_relaxed);
+    try {
+        _message_bytes.insert(_message_bytes.end(), message.begin(), message.end());
+        _message_ends.push_back(_message_bytes.size());
+    } catch (...) {
+        NITRO_ES_LOG_ERROR(TAG, "Out of memory collecting a framed message");
+    }
+}
+
+void HybridNitroEventSource::dispatch_messages() noexcept {
+    if (_message_ends.empty()) {
+        return;
+    }
+    const auto callback = load_callback(_messages_callback);
+    if (!callback) {
+        _message_bytes.clear();
+        _message_ends.clear();
+        return;
+    }
+
+    // One copy out of curl's buffer for the whole read: every message views the shared block, which
+    // lives until JS has let go of the last of them
+    try {
+        const auto block = std::make_shared<std::vector<uint8_t>>(std::move(_message_bytes));
+        std::vector<std::shared_ptr<ArrayBuffer>> messages;
+        messages.reserve(_message_ends.size());
+        size_t begin = 0;
+        for (const size_t end : _message_ends) {
+            messages.push_back(ArrayBuffer::wrap(block->data() + begin, end - begin, [block]() {}));
+            begin = end;
+        }
+        (*callback)(messages);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Exception in messages callback: " + std::string(e.what()));
+    } catch (...) {
+        NITRO_ES_LOG_ERROR(TAG, "Unknown exception in messages callback");
+    }
+    _message_bytes.clear();
+    _message_ends.clear();
+}
+
+void HybridNitroEventSource::publish_event(QueuedEvent queued) noexcept {
+    try {
+        // A filter may have decoded the payload without parseJson; JS only sees it when asked for
+        if (queued.json && !(_options && _options->parseJson.value_or(false))) {
+            queued.json.reset();
+        }
+        // Hermes: a long non-ASCII payload is converted here, off the JS thread, where the
+        // drain would have decoded it while JS waits
+        if (!queued.ascii && queued.event.data.size() >= _utf16_min_bytes && _utf16_payloads.load(std::memory_order_relaxed)) {
+            queued.utf16 = jsi_utils::utf8_to_utf16(queued.event.data);
+        }
+        const NitroEventSourceEvent& event = queued.event;
+        queued.charge = MemoryBudget::Charge(
+            _memory, static_cast<int64_t>(sizeof(QueuedEvent) + event.data.capacity() + event.id.size() + event.type.size() +
+                                          (queued.json && queued.json->arena ? queued.json->arena->reserved_bytes() : 0) +
+                                          (queued.utf16 ? queued.utf16->capacity() * sizeof(char16_t) : 0)));
+
+        if (!_bus.empty()) {
+            publish_to_bus(std::move(queued));
+            return;
+        }
+
+        // Never held back, dropped or merged: the lane bypasses the bound
+        if (is_priority(queued.type)) {
+            _priority_queue.push(std::move(queued));
+            _queued_events.fetch_add(1);
+            return;
+        }
+
+        // Keep FIFO order: once events are held back, newer ones queue up behind them
+        if (!_overflow_events.empty() || queue_full()) {
+            overflow_event(std::move(queued));
+            return;
+        }
+
+        _event_queue.push(std::move(queued));
+        _queued_events.fetch_add(1);
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to queue event, dropping it");
+    }
+}
+
+void HybridNitroEventSource::publish_to_bus(QueuedEvent queued) {
+    auto shared = std::make_shared<SharedEvent>();
+    shared->event = std::move(queued.event);
+    shared->json = std::move(queued.json);
+    shared->ascii = queued.ascii;
+    shared->utf16 = std::move(queued.utf16);
+    shared->type = queued.type;
+    shared->dispatched_at = queued.dispatched_at;
+    shared->charge = std::move(queued.charge);
+
+    // With the block policy the slowest subscriber pauses the transfer instead, see queue_full();
+    // otherwise one that fell behind misses events rather than holding back the others
+    const size_t limit = overflow_policy() == OverflowPolicy::BLOCK ? SIZE_MAX : max_queued_events();
+    if (const size_t missed = _bus.publish(shared, queued.type, limit, is_priority(queued.type))) {
+        _dropped_events.fetch_add(missed, std::memory_order_relaxed);
+    }
+}
+
+NitroEventSourceEvent HybridNitroEventSource::acquire_event() noexcept {
+    std::optional<NitroEventSourceEvent> pooled;
+    if (!_discarded_events.empty()) {
+        pooled = std::move(_discarded_events.back());
+        _discarded_events.pop_back();
+    } else {
+        pooled = _event_pool.pop();
+    }
+    if (pooled) {
+        _pool_hits.fetch_add(1, std::memory_order_relaxed);
+        pooled->chunk.reset();
+        pooled->paths.reset();
+        pooled->error.reset();
+        pooled->timing.reset();
+        pooled->receivedAt.reset();
+        pooled->sequence.reset();
+        return std::move(*pooled);
+    }
+    _pool_misses.fetch_add(1, std::memory_order_relaxed);
+    return NitroEventSourceEvent();
+}
+
+void HybridNitroEventSource::recycle_event(NitroEventSourceEvent event) noexcept {
+    constexpr size_t MAX_POOLED_DATA_BYTES = 64 * 1024;
+
+    if (closed()) {
+        return;
+    }
+
+    // Over the memory budget nothing is kept for later
+    if (MemoryBudget::shared().exceeded()) {
+        return;
+    }
+
+    // A one-off snapshot must not pin megabytes for the rest of the stream
+    if (event.data.capacity() > MAX_POOLED_DATA_BYTES) {
+        std::string().swap(event.data);
+    }
+
+    // A full pool simply lets the surplus event go
+    _event_pool.try_push(std::move(event));
+}
+
+void HybridNitroEventSource::discard_event(NitroEventSourceEvent event) noexcept {
+    constexpr size_t MAX_KEPT_DATA_BYTES = 64 * 1024;
+
+    // Kept by the same rules as recycle_event(), in a list of the I/O thread's own
+    if (closed() || MemoryBudget::shared().exceeded() || _discarded_events.size() >= MAX_DISCARDED_EVENTS) {
+        return;
+    }
+    if (event.data.capacity() > MAX_KEPT_DATA_BYTES) {
+        std::string().swap(event.data);
+    }
+    try {
+        _discarded_events.reserve(MAX_DISCARDED_EVENTS);
+        _discarded_events.push_back(std::move(event));
+    } catch (const std::bad_alloc&) {
+        // Not kept then, as with a full pool
+    }
+}
+
+EventSourceMetrics HybridNitroEventSource::getMetrics() {
+    const uint64_t attempts = _connect_attempts.load(std::memory_order_relaxed);
+    int64_t connected_ns = _connected_ns.load(std::memory_order_relaxed);
+    if (const int64_t since = _open_since_ns.load(std::memory_order_relaxed)) {
+        connected_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(TransferEngine::Clock::now().time_since_epoch()).count() - since;
+    }
+    std::optional<ConnectionTiming> last_connection;
+    std::optional<std::pair<std::string, double>> slowest_listener;
+    {
+        std::lock_guard<std::mutex> lock(_slow_listener_mutex);
+        slowest_listener = _slowest_listener;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_connection_timing_mutex);
+        last_connection = _last_connection_timing;
+    }
+    const int64_t last_comment_ns = _last_comment_ns.load(std::memory_order_relaxed);
+    const std::optional<HeartbeatMonitor::Reading> heartbeat = _heartbeat ? _heartbeat->reading() : std::nullopt;
+    return EventSourceMetrics(
+        static_cast<double>(_event_pool.size()),
+        static_cast<double>(_pool_hits.load(std::memory_order_relaxed)),
+        static_cast<double>(_pool_misses.load(std::memory_order_relaxed)),
+        static_cast<double>(_bytes_received.load(std::memory_order_relaxed)),
+        static_cast<double>(_events_parsed.load(std::memory_order_relaxed)),
+        static_cast<double>(_events_dispatched.load(std::memory_order_relaxed)),
+        static_cast<double>(_dropped_events.load(std::memory_order_relaxed)),
+        static_cast<double>(attempts > 0 ? attempts - 1 : 0),
+        static_cast<double>(connected_ns) / 1e6,
+        _parse_time.snapshot(),
+        _dispatch_latency.snapshot(),
+        _server_latency.snapshot(),
+        _native_latency.snapshot(),
+        std::move(last_connection),
+        _time_to_first_byte.snapshot(),
+        static_cast<double>(_comments_received.load(std::memory_order_relaxed)),
+        last_comment_ns != 0 ? std::optional(static_cast<double>(last_comment_ns) / 1e6) : std::nullopt,
+        _proxy_buffering.load(std::memory_order_relaxed),
+        static_cast<double>(_buffered_bursts.load(std::memory_order_relaxed)),
+        static_cast<double>(_sampled_out.load(std::memory_order_relaxed)),
+        static_cast<double>(_events_aggregated.load(std::memory_order_relaxed)),
+        static_cast<double>(std::max<int64_t>(0, _memory->bytes())),
+        static_cast<double>(_ids_ignored.load(std::memory_order_relaxed)),
+        _cpu_time.milliseconds(CpuTimeAccount::Phase::PARSE),
+        _cpu_time.milliseconds(CpuTimeAccount::Phase::DECODE),
+        _cpu_time.milliseconds(CpuTimeAccount::Phase::DISPATCH),
+        static_cast<double>(_heartbeat ? _heartbeat->missed() : 0),
+        heartbeat ? std::optional(heartbeat->delay_ms) : std::nullopt,
+        heartbeat ? std::optional(heartbeat->trend_ms) : std::nullopt,
+        heartbeat ? std::optional(heartbeat->jitter_ms) : std::nullopt,
+        heartbeat ? std::optional(heartbeat->quality) : std::nullopt,
+        static_cast<double>(_slow_listener_calls.load(std::memory_order_relaxed)),
+        slowest_listener ? std::optional(slowest_listener->first) : std::nullopt,
+        slowest_listener ? std::optional(slowest_listener->second) : std::nullopt);
+}
+
+void HybridNitroEventSource::set_ready_state(ReadyState state) noexcept {
+    // CLOSED is final, a late write from the I/O thread must not reopen a closed stream
+    ReadyState current = _ready_state.load(std::memory_order_relaxed);
+    while (current != ReadyState::CLOSED && !_ready_state.compare_exchange_weak(current, state, std::memory_order_release)) {
+    }
+    if (current == ReadyState::CLOSED || current == state) {
+        return;
+    }
+
+    // Time connected is summed up whenever the stream leaves OPEN
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(TransferEngine::Clock::now().time_since_epoch()).count();
+    if (state == ReadyState::OPEN) {
+        _open_since_ns.store(now, std::memory_order_relaxed);
+    } else if (const int64_t since = _open_since_ns.exchange(0, std::memory_order_relaxed)) {
+        _connected_ns.fetch_add(now - since, std::memory_order_relaxed);
+    }
+}
+
+size_t HybridNitroEventSource::max_queued_events() const noexcept {
+    size_t limit = SIZE_MAX;
+    if (_options && _options->backpressure && _options->backpressure->maxQueuedEvents) {
+        limit = static_cast<size_t>(std::max(1.0, *_options->backpressure->maxQueuedEvents));
+    }
+    if (_under_load.load(std::memory_order_relaxed) && _options->underLoad->maxQueuedEvents) {
+        limit = std::min(limit, static_cast<size_t>(std::max(1.0, *_options->underLoad->maxQueuedEvents)));
+    }
+    return limit;
+}
+
+OverflowPolicy HybridNitroEventSource::overflow_policy() const noexcept {
+    if (!_options || !_options->backpressure) {
+        return OverflowPolicy::BLOCK;
+    }
+    return _options->backpressure->overflow.value_or(OverflowPolicy::BLOCK);
+}
+
+bool HybridNitroEventSource::is_priority(EventTypeTable::Id type) const noexcept {
+    return type < _priority_types.size() && _priority_types[type];
+}
+
+void HybridNitroEventSource::overflow_event(QueuedEvent event) {
+    const size_t limit = max_queued_events();
+    _overflowed.store(true);
+
+    // Connection state changes, partial chunks and state changes are never dropped or merged
+    const bool is_control = event.type == EventTypeTable::OPEN || event.type == EventTypeTable::ERROR || event.event.chunk ||
+                            event.event.paths;
+
+    switch (is_control ? OverflowPolicy::BLOCK : overflow_policy()) {
+        case OverflowPolicy::BLOCK:
+            // The write callback pauses the transfer, only events from the chunk in flight land here
+            _overflow_events.push_back(std::move(event));
+            return;
+        case OverflowPolicy::DROP_NEWEST:
+            _dropped_events.fetch_add(1, std::memory_order_relaxed);
+            return;
+        case OverflowPolicy::COALESCE: {
+            // A newer event with the same type and id replaces the held-back one in place
+            const auto same_key = std::find_if(_overflow_events.rbegin(), _overflow_events.rend(), [&](const QueuedEvent& held) {
+                return held.event.type == event.event.type && held.event.id == event.event.id;
+            });
+            if (same_key != _overflow_events.rend()) {
+                *same_key = std::move(event);
+                _dropped_events.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        }
+        case OverflowPolicy::DROP_OLDEST:
+            break;
+    }
+
+    // Over the memory budget only the latest held-back event is kept
+    _overflow_events.push_back(std::move(event));
+    if (_overflow_events.size() > (MemoryBudget::shared().exceeded() ? 1 : limit)) {
+        _overflow_events.pop_front();
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void HybridNitroEventSource::refill_queue() noexcept {
+    _overflowed.store(false);
+    if (closed()) {
+        return;
+    }
+
+    bool published = false;
+    while (!_overflow_events.empty() && !queue_full()) {
+        try {
+            _event_queue.push(std::move(_overflow_events.front()));
+            _queued_events.fetch_add(1);
+            published = true;
+        } catch (const std::bad_alloc&) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to queue event, dropping it");
+            _dropped_events.fetch_add(1, std::memory_order_relaxed);
+        }
+        _overflow_events.pop_front();
+    }
+
+    if (!_overflow_events.empty()) {
+        _overflowed.store(true);
+    }
+    if (published) {
+        notify_drain();
+    }
+
+    // A rate-limit pause is the timer's to end
+    if (_transfer_paused && !should_pause_transfer() && !_rate_timer && _curl) {
+        _transfer_paused = false;
+        // May deliver the held chunk right away through the write callback
+        curl_easy_pause(_curl, CURLPAUSE_CONT);
+    }
+}
+
+bool HybridNitroEventSource::pause_for_rate_limit() noexcept {
+    double rate = _options && _options->rateLimit ? _options->rateLimit->maxEventsPerSecond.value_or(0.0) : 0.0;
+    if (_under_load.load(std::memory_order_relaxed) && _options->underLoad->maxEventsPerSecond.value_or(0.0) > 0.0) {
+        const double load_rate = *_options->underLoad->maxEventsPerSecond;
+        rate = rate > 0.0 ? std::min(rate, load_rate) : load_rate;
+    }
+    if (rate <= 0.0) {
+        return false;
+    }
+
+    const auto now = TransferEngine::Clock::now();
+    const double burst = std::max(1.0, rate);
+    if (_rate_refilled_at == TransferEngine::Clock::time_point()) {
+        _rate_tokens = burst;
+    } else {
+        _rate_tokens = std::min(burst, _rate_tokens + rate * std::chrono::duration<double>(now - _rate_refilled_at).count());
+    }
+    _rate_refilled_at = now;
+    if (_rate_tokens >= 1.0) {
+        return false;
+    }
+
+    // Paused only once the timer is armed, or nothing would resume the transfer
+    const auto wait = std::chrono::duration_cast<TransferEngine::Clock::duration>(std::chrono::duration<double>((1.0 - _rate_tokens) / rate));
+    try {
+        _rate_timer = TransferEngine::shared().schedule(
+            now + wait,
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->_rate_timer.reset();
+                self->resume_after_rate_limit();
+            },
+            engine_priority());
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule the rate limit: " + std::string(e.what()));
+        return false;
+    }
+    _transfer_paused = true;
+    return true;
+}
+
+void HybridNitroEventSource::resume_after_rate_limit() noexcept {
+    // Backpressure that set in meanwhile keeps it paused, the next drain resumes it
+    if (_transfer_paused && !should_pause_transfer() && _curl) {
+        _transfer_paused = false;
+        curl_easy_pause(_curl, CURLPAUSE_CONT);
+    }
+}
+
+bool HybridNitroEventSource::pause_for_backpressure() noexcept {
+    if (!should_pause_transfer()) {
+        return false;
+    }
+
+    // The next drain posts refill_queue(), which resumes the transfer
+    _transfer_paused = true;
+    _overflowed.store(true);
+    return true;
+}
+
+bool HybridNitroEventSource::should_pause_transfer() noexcept {
+    if (!_queued_delivery.load() || overflow_policy() != OverflowPolicy::BLOCK) {
+        return false;
+    }
+    return !_overflow_events.empty() || queue_full();
+}
+
+bool HybridNitroEventSource::queue_full() noexcept {
+    // Shared streams count the longest subscriber queue; schemas rows wait like events
+    const size_t queued = (_bus.empty() ? _queued_events.load() : std::max(_queued_events.load(), _bus.largest_queue())) + (_columnar ? _columnar->rows() : 0);
+    if (queued >= max_queued_events()) {
+        return true;
+    }
+    // A stream with nothing queued keeps going: no drain of its own would resume it, so one
+    // event at a time still moves in over a byte limit
+    if (queued == 0 && _raw_queued.load() == 0) {
+        return false;
+    }
+    const double max_bytes = _options && _options->backpressure ? _options->backpressure->maxQueuedBytes.value_or(0.0) : 0.0;
+    return (max_bytes >= 1.0 && static_cast<double>(_memory->bytes()) >= max_bytes) || MemoryBudget::shared().exceeded();
+}
+
+void HybridNitroEventSource::notify_drain() noexcept {
+    // One wake-up per drain cycle no matter how many events were published meanwhile
+    if (_drain_pending.exchange(true)) {
+        return;
+    }
+
+    if (const auto callback = load_callback(_drain_callback)) {
+        try {
+            (*callback)();
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in drain callback: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in drain callback");
+        }
+    }
+}
+
+void HybridNitroEventSource::enqueue_event(QueuedEvent event) noexcept {
+    constexpr double DEFAULT_MAX_BATCH_SIZE = 256.0;
+    constexpr double DEFAULT_MAX_BATCH_LATENCY_MS = 16.0;
+    constexpr double DEFAULT_LOAD_BATCH_LATENCY_MS = 100.0;
+
+    const BatchOptions batch = _options->batch.value_or(BatchOptions());
+    const auto max_size = static_cast<size_t>(std::max(1.0, batch.maxSize.value_or(DEFAULT_MAX_BATCH_SIZE)));
+
+    // Connection state changes and priorityTypes are never held back behind the flush window
+    const bool flush_now = event.type == EventTypeTable::OPEN || event.type == EventTypeTable::ERROR || is_priority(event.type);
+
+    try {
+        // Latest value wins: a newer event with the same key replaces the undelivered one in place
+        if (std::optional<std::string> key = coalesce_key(event)) {
+            const auto [it, inserted] = _pending_keys.try_emplace(std::move(*key), _pending_events.size());
+            if (!inserted) {
+                _pending_events[it->second] = std::move(event);
+                return;
+            }
+        }
+
+        _pending_events.push_back(std::move(event));
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to queue event, flushing pending batch");
+        flush_events();
+        return;
+    }
+
+    if (flush_now || _pending_events.size() >= max_size) {
+        flush_events();
+        return;
+    }
+
+    if (!_flush_timer) {
+        double latency_ms = std::max(0.0, batch.maxLatencyMs.value_or(DEFAULT_MAX_BATCH_LATENCY_MS));
+        if (_under_load.load(std::memory_order_relaxed)) {
+            latency_ms = std::max(latency_ms, _options->underLoad->batchLatencyMs.value_or(DEFAULT_LOAD_BATCH_LATENCY_MS));
+        }
+        const auto latency = std::chrono::milliseconds(static_cast<int64_t>(latency_ms));
+        try {
+            _flush_timer = TransferEngine::shared().schedule(
+                TransferEngine::Clock::now() + latency,
+                [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                    self->_flush_timer.reset();
+                    self->flush_events();
+                });
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to schedule batch flush: " + std::string(e.what()));
+            flush_events();
+        }
+    }
+}
+
+std::optional<std::string> HybridNitroEventSource::coalesce_key(const QueuedEvent& queued) const {
+    // underLoad coalesces by type unless `coalesce` says how
+    const bool load_coalesces = _under_load.load(std::memory_order_relaxed) && _options && _options->underLoad &&
+                                _options->underLoad->coalesce.value_or(true);
+    // Chunks of one event would replace each other, as would the changed paths of state patches
+    if (!_options || (!_options->coalesce && !load_coalesces) || queued.type == EventTypeTable::OPEN ||
+        queued.type == EventTypeTable::ERROR || is_priority(queued.type) || queued.event.chunk || queued.event.paths) {
+        return std::nullopt;
+    }
+
+    const NitroEventSourceEvent& event = queued.event;
+    const CoalesceOptions& coalesce = _options->coalesce ? *_options->coalesce : _load_coalesce;
+    if (coalesce.types && std::find(coalesce.types->begin(), coalesce.types->end(), event.type) == coalesce.types->end()) {
+        return std::nullopt;
+    }
+
+    // NUL separators keep "a"+"bc" and "ab"+"c" apart
+    std::string key = event.type;
+    if (coalesce.byId.value_or(false)) {
+        key += '\0';
+        key += event.id;
+    }
+
+    if (coalesce.keyField) {
+        // Events whose payload has no such top-level field are delivered as-is
+        JsonDocument parsed;
+        if (!queued.json && !decode_json(event.data, parsed)) {
+            return std::nullopt;
+        }
+        const JsonValue& json = queued.json ? queued.json->root : parsed.root;
+        const auto* object = std::get_if<JsonValue::Object>(&json.value);
+        if (!object) {
+            return std::nullopt;
+        }
+        const auto field = std::find_if(object->rbegin(), object->rend(), [&](const auto& member) {
+            return std::string_view(member.first) == *coalesce.keyField;
+        });
+        if (field == object->rend()) {
+            return std::nullopt;
+        }
+
+        key += '\0';
+        if (const auto* text = std::get_if<JsonValue::String>(&field->second.value)) {
+            key += *text;
+        } else if (const auto* number = std::get_if<double>(&field->second.value)) {
+            key += std::to_string(*number);
+        } else if (const auto* flag = std::get_if<bool>(&field->second.value)) {
+            key += *flag ? "true" : "false";
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    return key;
+}
+
+void HybridNitroEventSource::flush_events() noexcept {
+    if (_flush_timer) {
+        TransferEngine::shared().cancel(*_flush_timer);
+        _flush_timer.reset();
+    }
+
+    if (_pending_events.empty()) {
+        return;
+    }
+
+    std::vector<QueuedEvent> events;
+    events.swap(_pending_events);
+    _pending_keys.clear();
+
+    if (closed()) {
+        return;
+    }
+
+    if (_queued_delivery.load()) {
+        for (QueuedEvent& event : events) {
+            publish_event(std::move(event));
+        }
+        events.clear();
+        _pending_events.swap(events);
+        notify_drain();
+        return;
+    }
+
+    // One JSI hop for the whole batch; without a batch callback fall back to per-event delivery
+    bool delivered = false;
+    if (const auto callback = load_callback(_batch_callback)) {
+        try {
+            std::vector<NitroEventSourceEvent> batch;
+            batch.reserve(events.size());
+            for (const QueuedEvent& event : events) {
+                batch.push_back(event.event);
+            }
+            (*callback)(batch);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in batch callback: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in batch callback");
+        }
+        delivered = true;
+    }
+
+    const auto now = TransferEngine::Clock::now();
+    for (const QueuedEvent& event : events) {
+        _dispatch_latency.record(now - event.dispatched_at);
+        if (!delivered) {
+            notify_callback(event.event);
+        }
+        notify_listeners(event.event, event.type);
+    }
+    _events_dispatched.fetch_add(events.size(), std::memory_order_relaxed);
+
+    // Hand the capacity back for the next batch
+    events.clear();
+    if (_pending_events.empty()) {
+        _pending_events.swap(events);
+    }
+}
+
+void HybridNitroEventSource::notify_callback(const NitroEventSourceEvent& event) noexcept {
+    // Dispatch to single event callback (legacy onmessage/onerror/onopen)
+    if (const auto callback = load_callback(_event_callback)) {
+        try {
+            (*callback)(event);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in event callback: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in event callback");
+        }
+    }
+}
+
+void HybridNitroEventSource::notify_listeners(const NitroEventSourceEvent& event, EventTypeTable::Id type) noexcept {
+    // Types that are not interned can have no listeners
+    if (closed() || type == EventTypeTable::NONE) {
+        return;
+    }
+
+    // Dispatch to event-specific listeners (addEventListener)
+    // The snapshot stays valid while listeners run even if they add or remove listeners
+    const std::shared_ptr<const ListenerTable> table = listeners_snapshot();
+    if (!table) {
+        return;
+    }
+
+    if (type >= table->size()) {
+        return;
+    }
+    
+    for (const auto& listener : (*table)[type]) {
+        if (closed(std::memory_order_relaxed)) break;
+        
+        try {
+            listener(event);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in event listener [" + event.type + "]: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in event listener [" + event.type + "]");
+        }
+    }
+}
+
+void HybridNitroEventSource::connect() noexcept {
+    _reconnect_timer.reset();
+    // Started some other way than by the gate: the queued start must not connect a second time
+    if (_reconnect_queued) {
+        finish_reconnect(false);
+    }
+
+    if (!should_retry()) {
+        NITRO_ES_LOG_INFO(TAG, "Connection loop terminated");
+        return;
+    }
+    // Put to sleep by the background policy, on_app_state() resumes
+    if (_suspended) {
+        return;
+    }
+
+    // Rotates away from an endpoint that just failed, or back to a faster one that recovered
+    _endpoint = _failover_endpoint != EndpointSet::NONE ? std::exchange(_failover_endpoint, EndpointSet::NONE)
+                                                        : _endpoints.select(TransferEngine::Clock::now());
+
+    _open_event_sent.store(false);
+    _redirects_permanent = true;
+    _redirects_keep_method = true;
+    _connect_attempts.fetch_add(1, std::memory_order_relaxed);
+    set_ready_state(ReadyState::CONNECTING);
+    _transfer_paused = false;
+    // The bucket carries over, a pause of the previous transfer does not
+    if (_rate_timer) {
+        TransferEngine::shared().cancel(*_rate_timer);
+        _rate_timer.reset();
+    }
+    // The idle clock covers waiting for the response too, the connect timeout only the handshake
+    _last_received = TransferEngine::Clock::now();
+    _idle_timed_out = false;
+
+    if (_options && _options->replay) {
+        start_replay();
+        return;
+    }
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // The attempt waits for the test's script_open(), script_chunk() and script_close()
+    _script_attempt = true;
+    _script_status = 0;
+    return;
+#endif
+    if (!attempt_connection()) {
+        schedule_reconnect(next_reconnect_delay());
+    }
+}
+
+void HybridNitroEventSource::open_response() noexcept {
+    bool expected = false;
+    if (!_open_event_sent.compare_exchange_strong(expected, true) || closed(std::memory_order_relaxed)) {
+        return;
+    }
+    set_ready_state(ReadyState::OPEN);
+    NITRO_ES_TRACE_ASYNC_END("connect", this);
+    // A new body: what the last one left half-parsed is discarded, and it may lead with a BOM
+    _parser.reset();
+    if (_framer) {
+        _framer->reset();
+    }
+    if (_message_framer) {
+        _message_framer->reset();
+    }
+    _ws_message.clear();
+    _ws_oversized = false;
+    if (_buffering) {
+        _buffering->reset();
+        _proxy_buffering.store(false, std::memory_order_relaxed);
+    }
+    if (_heartbeat) {
+        _heartbeat->reset();
+    }
+    TransferEngine::shared().persist_tls_sessions();
+    finish_reconnect(true);
+    keep_standby_warm();
+    _opened_at = _last_received;
+    std::optional<ConnectionTiming> timing = record_connection_timing();
+    remember_redirect();
+    dispatch_event(NitroEventSourceEvent(_last_event_id, "open", "", std::nullopt, std::nullopt, std::nullopt, std::move(timing), std::nullopt, std::nullopt), EventTypeTable::OPEN);
+}
+
+void HybridNitroEventSource::start_replay() noexcept {
+    const std::string path = resolve_data_path(_options->replay->file, _options->storageDirectory);
+    if (path.empty() || !(_replay = CaptureReader::open(path))) {
+        NITRO_ES_LOG_ERROR(TAG, "Cannot read replay capture " + _options->replay->file);
+        end_stream();
+        return;
+    }
+
+    // Opens like a response would, without a connection or its timing
+    _open_event_sent.store(true);
+    set_ready_state(ReadyState::OPEN);
+    _parser.reset();
+    if (_framer) {
+        _framer->reset();
+    }
+    if (_message_framer) {
+        _message_framer->reset();
+    }
+    dispatch_event(NitroEventSourceEvent(_last_event_id, "open", "", std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt), EventTypeTable::OPEN);
+
+    _replay_started = TransferEngine::Clock::now();
+    _replay_pending = false;
+    replay_next();
+}
+
+void HybridNitroEventSource::replay_next() noexcept {
+    constexpr size_t MAX_CHUNKS_PER_TASK = 64;
+
+    _replay_timer.reset();
+    // 0 replays as fast as the pipeline takes it
+    const double speed = std::max(0.0, _options->replay->speed.value_or(1.0));
+    try {
+        for (size_t fed = 0; fed < MAX_CHUNKS_PER_TASK; ++fed) {
+            if (!should_retry() || !_replay) {
+                return;
+            }
+            if (!_replay_pending) {
+                std::chrono::microseconds at{};
+                if (!_replay->next(at, _replay_chunk)) {
+                    NITRO_ES_LOG_INFO(TAG, "Replay finished");
+                    _replay.reset();
+                    end_stream();
+                    return;
+                }
+                _replay_due = speed > 0.0 ? _replay_started + std::chrono::duration_cast<TransferEngine::Clock::duration>(
+                                                                  std::chrono::duration<double, std::micro>(static_cast<double>(at.count()) / speed))
+                                          : _replay_started;
+                _replay_pending = true;
+            }
+            const TransferEngine::Clock::time_point now = TransferEngine::Clock::now();
+            if (_replay_due > now) {
+                _replay_timer = TransferEngine::shared().schedule(
+                    _replay_due, [self = shared_cast<HybridNitroEventSource>()]() noexcept { self->replay_next(); }, engine_priority());
+                return;
+            }
+            _replay_pending = false;
+            _last_received = now;
+            if (!receive_body(_replay_chunk)) {
+                NITRO_ES_LOG_ERROR(TAG, "Cannot decode replay capture");
+                _replay.reset();
+                end_stream();
+                return;
+            }
+            _parser_memory.update(static_cast<int64_t>(_parser.buffered_bytes()));
+        }
+        // Lets the other streams' transfers in between runs of a fast replay
+        TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept { self->replay_next(); });
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to continue replay: " + std::string(e.what()));
+        _replay.reset();
+        end_stream();
+    }
+}
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+void HybridNitroEventSource::script_open() noexcept {
+    if (!_script_attempt) {
+        NITRO_ES_LOG_WARN(TAG, "script_open() without a connection attempt");
+        return;
+    }
+    _script_status = 200;
+    _last_received = TransferEngine::Clock::now();
+    open_response();
+}
+
+bool HybridNitroEventSource::script_chunk(std::string_view bytes) noexcept {
+    if (!_script_attempt || !_open_event_sent.load()) {
+        NITRO_ES_LOG_WARN(TAG, "script_chunk() without an open response");
+        return false;
+    }
+    _last_received = TransferEngine::Clock::now();
+    if (!should_retry(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (pause_for_backpressure() || pause_for_rate_limit()) {
+        return false;
+    }
+    if (_capture) {
+        _capture->append(_last_received, bytes);
+    }
+    if (!receive_body(bytes)) {
+        // curl aborts the transfer with a write error
+        script_close(CURLE_WRITE_ERROR);
+        return true;
+    }
+    _parser_memory.update(static_cast<int64_t>(_parser.buffered_bytes() + _ws_message.capacity()));
+    return true;
+}
+
+void HybridNitroEventSource::script_close(CURLcode result, long status) noexcept {
+    if (!std::exchange(_script_attempt, false)) {
+        NITRO_ES_LOG_WARN(TAG, "script_close() without a connection attempt");
+        return;
+    }
+    if (status != 0) {
+        _script_status = status;
+    }
+    on_transfer_done(result);
+}
+#endif
+
+HybridNitroEventSource::CloseReason HybridNitroEventSource::classify_close(CURLcode result, long status,
+                                                                           const std::optional<StreamError>& error) const noexcept {
+    constexpr auto MIN_CLEAN_UPTIME = std::chrono::seconds(1);
+
+    if (!error) {
+        // Closed right after it opened, or never opened: the server is not rotating, it is refusing
+        const bool routine = _open_event_sent.load() && TransferEngine::Clock::now() - _opened_at >= MIN_CLEAN_UPTIME;
+        return result == CURLE_OK && routine ? CloseReason::CLEAN : CloseReason::OTHER;
+    }
+    if (result == CURLE_ABORTED_BY_CALLBACK || result == CURLE_OPERATION_TIMEDOUT) {
+        return CloseReason::TIMEOUT;
+    }
+    if (error->phase == ErrorPhase::RESPONSE && status != 200 && !_rejected_content_type) {
+        return CloseReason::HTTP_ERROR;
+    }
+    switch (result) {
+        case CURLE_RECV_ERROR:
+        case CURLE_SEND_ERROR:
+        case CURLE_PARTIAL_FILE:
+        case CURLE_GOT_NOTHING:
+        case CURLE_HTTP2:
+        case CURLE_HTTP2_STREAM:
+            return CloseReason::RESET;
+        default:
+            return CloseReason::OTHER;
+    }
+}
+
+std::chrono::milliseconds HybridNitroEventSource::next_reconnect_delay(CloseReason reason) noexcept {
+    constexpr double DEFAULT_INITIAL_DELAY_MS = 3000.0;
+    constexpr double DEFAULT_MAX_DELAY_MS = 60000.0;
+    constexpr double DEFAULT_MULTIPLIER = 2.0;
+    constexpr uint32_t MAX_BACKOFF_EXPONENT = 16;
+
+    const ReconnectPolicy policy = (_options && _options->reconnect) ? *_options->reconnect : ReconnectPolicy();
+
+    std::optional<double> reason_ms;
+    if (policy.byReason) {
+        switch (reason) {
+            case CloseReason::CLEAN: reason_ms = policy.byReason->cleanCloseMs; break;
+            case CloseReason::RESET: reason_ms = policy.byReason->resetMs; break;
+            case CloseReason::TIMEOUT: reason_ms = policy.byReason->timeoutMs; break;
+            case CloseReason::HTTP_ERROR: reason_ms = policy.byReason->httpErrorMs; break;
+            case CloseReason::OTHER: break;
+        }
+    }
+    // A server-sent `retry:` replaces the configured base delay (per SSE spec)
+    const double base_ms = _server_retry_ms > 0
+        ? static_cast<double>(_server_retry_ms)
+        : std::max(0.0, reason_ms.value_or(policy.initialDelayMs.value_or(DEFAULT_INITIAL_DELAY_MS)));
+    const double max_ms = std::max(base_ms, policy.maxDelayMs.value_or(DEFAULT_MAX_DELAY_MS));
+    const double multiplier = std::max(1.0, policy.multiplier.value_or(DEFAULT_MULTIPLIER));
+
+    const uint32_t exponent = std::min(_reconnect_attempts, MAX_BACKOFF_EXPONENT);
+    double delay_ms = std::min(max_ms, base_ms * std::pow(multiplier, static_cast<double>(exponent)));
+    ++_reconnect_attempts;
+
+    // Full jitter spreads out clients that lost their connection at the same moment
+    if (policy.jitter.value_or(true)) {
+        std::uniform_real_distribution<double> distribution(0.0, delay_ms);
+        delay_ms = distribution(_backoff_rng);
+    }
+
+    return std::chrono::milliseconds(static_cast<int64_t>(delay_ms));
+}
+
+std::optional<std::chrono::milliseconds> HybridNitroEventSource::trip_breaker(CURLcode result) noexcept {
+    constexpr double DEFAULT_FAILURE_THRESHOLD = 8.0;
+    constexpr double DEFAULT_OPEN_MS = 300000.0;
+    constexpr double DEFAULT_MAX_OPEN_MS = 1800000.0;
+    constexpr uint32_t MAX_TRIP_EXPONENT = 16;
+
+    const CircuitBreakerOptions breaker = (_options && _options->circuitBreaker) ? *_options->circuitBreaker : CircuitBreakerOptions();
+    const double threshold = breaker.failureThreshold.value_or(DEFAULT_FAILURE_THRESHOLD);
+    if (threshold < 1.0) {
+        return std::nullopt;
+    }
+
+    // Retrying cannot heal these until something outside the stream changes, e.g. the network
+    // behind a captive portal, so they open the breaker straight away rather than end the stream
+    const bool permanent = result == CURLE_UNSUPPORTED_PROTOCOL || result == CURLE_URL_MALFORMAT ||
+                           result == CURLE_PEER_FAILED_VERIFICATION || result == CURLE_SSL_CERTPROBLEM ||
+                           result == CURLE_SSL_CACERT_BADFILE || result == CURLE_SSL_PINNEDPUBKEYNOTMATCH ||
+                           result == CURLE_TOO_MANY_REDIRECTS;
+    const auto failures = static_cast<uint32_t>(std::min(threshold, static_cast<double>(UINT32_MAX)));
+    _breaker_failures = permanent ? std::max(_breaker_failures + 1, failures) : _breaker_failures + 1;
+    if (_breaker_failures < failures) {
+        return std::nullopt;
+    }
+
+    // Every attempt past the threshold is a half-open probe; one that fails reopens it for twice as long
+    const double open_ms = std::max(0.0, breaker.openMs.value_or(DEFAULT_OPEN_MS));
+    const double max_open_ms = std::max(open_ms, breaker.maxOpenMs.value_or(DEFAULT_MAX_OPEN_MS));
+    const double delay_ms = std::min(max_open_ms, open_ms * std::pow(2.0, static_cast<double>(std::min(_breaker_trips, MAX_TRIP_EXPONENT))));
+    ++_breaker_trips;
+    NITRO_ES_LOG_WARN(TAG, "Circuit open after " + std::to_string(_breaker_failures) + " failed attempts");
+    return std::chrono::milliseconds(static_cast<int64_t>(delay_ms));
+}
+
+void HybridNitroEventSource::schedule_reconnect(std::chrono::milliseconds delay, bool align) noexcept {
+    // Retrying offline only burns radio time, on_network_change() connects once a network is back
+    if (network_aware() && !NetworkMonitor::shared().online()) {
+        NITRO_ES_LOG_INFO(TAG, "Offline, reconnecting once the network returns");
+        _waiting_for_network = true;
+        return;
+    }
+
+    const auto now = TransferEngine::Clock::now();
+    _reconnect_due = now + delay;
+    const auto deadline = align ? background_aligned(_reconnect_due) : _reconnect_due;
+    NITRO_ES_LOG_INFO(TAG, "Reconnecting in " +
+                               std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count()) + "ms...");
+    arm_reconnect(deadline);
+}
+
+void HybridNitroEventSource::arm_reconnect(TransferEngine::Clock::time_point deadline) noexcept {
+    try {
+        _reconnect_timer = TransferEngine::shared().schedule(
+            deadline,
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->connect();
+            },
+            engine_priority());
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule reconnect: " + std::string(e.what()));
+    }
+}
+
+// Backgrounded, every stream's retry waits for the same boundary of a shared grid, so the
+// radio wakes once per window for all of them rather than once per stream and attempt
+TransferEngine::Clock::time_point HybridNitroEventSource::background_aligned(TransferEngine::Clock::time_point due) const noexcept {
+    constexpr double DEFAULT_ALIGN_MS = 30000.0;
+
+    if (!_options || !_options->background || AppLifecycle::shared().foreground()) {
+        return due;
+    }
+    const double align_ms = _options->background->reconnectAlignMs.value_or(DEFAULT_ALIGN_MS);
+    if (!(align_ms >= 1.0)) {
+        return due;
+    }
+    const auto period = std::chrono::duration_cast<TransferEngine::Clock::duration>(
+        std::chrono::milliseconds(static_cast<int64_t>(std::min(align_ms, static_cast<double>(INT32_MAX)))));
+    const auto since_epoch = due.time_since_epoch();
+    return TransferEngine::Clock::time_point(((since_epoch + period - TransferEngine::Clock::duration(1)) / period) * period);
+}
+
+void HybridNitroEventSource::keep_standby_warm() noexcept {
+    if (!_options || !_options->standby || _standby_timer || !should_retry()) {
+        return;
+    }
+
+    // A pooled connection curl retired, or one the standby host dropped, is reopened here.
+    // Same-origin HTTP/2 multiplexes onto the stream's own connection, so there a separate
+    // standby host is what buys the failover a connection of its own
+    try {
+        TransferEngine::shared().preconnect(_endpoints.url(standby_endpoint()));
+        _standby_timer = TransferEngine::shared().schedule(
+            TransferEngine::Clock::now() + standby_keep_warm(*_options->standby),
+            [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->_standby_timer.reset();
+                self->keep_standby_warm();
+            },
+            TransferEngine::Priority::BACKGROUND);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to keep the standby connection warm: " + std::string(e.what()));
+    }
+}
+
+void HybridNitroEventSource::cancel_standby() noexcept {
+    if (_standby_timer) {
+        TransferEngine::shared().cancel(*_standby_timer);
+        _standby_timer.reset();
+    }
+}
+
+const std::string& HybridNitroEventSource::stream_url() const noexcept {
+    return _endpoints.url(_endpoint);
+}
+
+std::string HybridNitroEventSource::request_url() const {
+    const std::string& url = _endpoints.target(_endpoint, TransferEngine::Clock::now());
+    if (!websocket()) {
+        return url;
+    }
+    // Endpoints stay http(s) URLs for preconnect and metrics; curl picks the protocol by scheme
+    if (url.compare(0, 8, "https://") == 0) {
+        return "wss://" + url.substr(8);
+    }
+    if (url.compare(0, 7, "http://") == 0) {
+        return "ws://" + url.substr(7);
+    }
+    return url;
+}
+
+// The best endpoint besides the current one; with a single endpoint, a second connection to it
+size_t HybridNitroEventSource::standby_endpoint() const noexcept {
+    const size_t other = _endpoints.select(TransferEngine::Clock::now(), _endpoint);
+    return other == EndpointSet::NONE ? _endpoint : other;
+}
+
+namespace {
+
+// scheme://host[:port] of `url`, what curl shares a connection by
+std::string origin_of(std::string_view url) {
+    const size_t authority = url.find("://");
+    const size_t start = authority == std::string_view::npos ? 0 : authority + 3;
+    const size_t end = url.find_first_of("/?#", start);
+    return std::string(url.substr(0, end));
+}
+
+} // namespace
+
+void HybridNitroEventSource::on_network_change(bool online, bool interface_changed) noexcept {
+    // Going offline needs nothing here: the open transfer fails or idles out, and
+    // schedule_reconnect() then holds the retry back
+    if (!online || !should_retry()) {
+        return;
+    }
+    // Already waiting for the gate, which connects on the network that is there by then
+    if (_reconnect_queued) {
+        return;
+    }
+
+    // Between attempts: skip whatever is left of the backoff, the network just came back
+    const bool between_attempts = _waiting_for_network || _reconnect_timer;
+    if (!between_attempts && !(interface_changed && _curl)) {
+        return;
+    }
+    if (_reconnect_timer) {
+        TransferEngine::shared().cancel(*_reconnect_timer);
+        _reconnect_timer.reset();
+    }
+    _waiting_for_network = false;
+    _reconnect_attempts = 0;
+
+    // Mid-transfer on another interface: the old socket is bound to a network that is gone
+    // and would only fail after a timeout, so start over on the new one right away
+    if (!between_attempts) {
+        NITRO_ES_LOG_INFO(TAG, "Network interface changed, reconnecting");
+        cancel_idle_timer();
+        TransferEngine::shared().remove_transfer(_curl);
+    } else {
+        NITRO_ES_LOG_INFO(TAG, "Network is back, reconnecting");
+    }
+
+    // Every stream sees the network return at once; background ones wait their turn
+    // so the handshakes of urgent streams are not competing with them. Not aligned: the
+    // return is already shared, and may be a Doze maintenance window that soon closes
+    constexpr std::chrono::milliseconds BACKGROUND_RECONNECT_DELAY{2000};
+    if (engine_priority() == TransferEngine::Priority::BACKGROUND) {
+        schedule_reconnect(BACKGROUND_RECONNECT_DELAY, false);
+        return;
+    }
+    // The rest take turns through the engine's gate, a few origins at a time
+    finish_reconnect(false);
+    const uint64_t ticket = TransferEngine::shared().admit_reconnect(
+        origin_of(_endpoints.url(_endpoint)), engine_priority(), [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+            if (self->_reconnect_queued) {
+                self->_reconnect_queued = false;
+                self->connect();
+            }
+        });
+    if (ticket == 0) {
+        connect();
+        return;
+    }
+    _reconnect_ticket = ticket;
+    _reconnect_queued = true;
+}
+
+void HybridNitroEventSource::finish_reconnect(bool warmed) noexcept {
+    _reconnect_queued = false;
+    if (const std::optional<uint64_t> ticket = std::exchange(_reconnect_ticket, std::nullopt)) {
+        TransferEngine::shared().finish_reconnect(*ticket, warmed);
+    }
+}
+
+bool HybridNitroEventSource::defer_write() noexcept {
+    return TransferEngine::shared().defer_write(_curl, engine_priority());
+}
+
+TransferEngine::Priority HybridNitroEventSource::engine_priority() const noexcept {
+    switch (_options && _options->priority ? *_options->priority : StreamPriority::NORMAL) {
+        case StreamPriority::INTERACTIVE: return TransferEngine::Priority::INTERACTIVE;
+        case StreamPriority::BACKGROUND: return TransferEngine::Priority::BACKGROUND;
+        default: return TransferEngine::Priority::DEFAULT;
+    }
+}
+
+BackgroundPolicy HybridNitroEventSource::background_policy() const noexcept {
+    return (_options && _options->background) ? _options->background->policy.value_or(BackgroundPolicy::KEEP) : BackgroundPolicy::KEEP;
+}
+
+void HybridNitroEventSource::on_app_state(bool foreground) noexcept {
+    constexpr double DEFAULT_GRACE_MS = 30000.0;
+
+    if (closed()) {
+        return;
+    }
+
+    if (foreground) {
+        if (_background_timer) {
+            TransferEngine::shared().cancel(*_background_timer);
+            _background_timer.reset();
+        }
+        // A retry held for the background grid runs when it would have otherwise
+        if (_reconnect_timer && _reconnect_timer->deadline > _reconnect_due) {
+            TransferEngine::shared().cancel(*_reconnect_timer);
+            _reconnect_timer.reset();
+            arm_reconnect(_reconnect_due);
+        }
+        // Resumes with Last-Event-ID, so the server can replay what was missed
+        if (std::exchange(_suspended, false) && should_retry()) {
+            NITRO_ES_LOG_INFO(TAG, "Foregrounded, resuming");
+            _reconnect_attempts = 0;
+            connect();
+        }
+        return;
+    }
+
+    // `keep` only listens to align its reconnects
+    const BackgroundPolicy policy = background_policy();
+    if (_background_timer || _suspended || policy == BackgroundPolicy::KEEP) {
+        return;
+    }
+    const double grace_ms = std::max(0.0, _options->background->graceMs.value_or(DEFAULT_GRACE_MS));
+    try {
+        _background_timer = TransferEngine::shared().schedule(
+            TransferEngine::Clock::now() + std::chrono::milliseconds(static_cast<int64_t>(grace_ms)),
+            [weak_self = std::weak_ptr<HybridNitroEventSource>(shared_cast<HybridNitroEventSource>()), policy]() noexcept {
+                if (auto self = weak_self.lock()) {
+                    self->_background_timer.reset();
+                    self->suspend(policy);
+                }
+            });
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to schedule background policy: " + std::string(e.what()));
+    }
+}
+
+bool HybridNitroEventSource::loaded_for(DeviceLoad::Level level) const noexcept {
+    const DeviceLoadLevel from = _options->underLoad->from.value_or(DeviceLoadLevel::ELEVATED);
+    return level >= (from == DeviceLoadLevel::CRITICAL ? DeviceLoad::Level::CRITICAL : DeviceLoad::Level::ELEVATED);
+}
+
+void HybridNitroEventSource::on_device_load(DeviceLoad::Level level) noexcept {
+    if (closed()) {
+        return;
+    }
+    // Memory is short: the pooled events only keep string capacity around
+    if (level == DeviceLoad::Level::CRITICAL) {
+        while (_event_pool.pop()) {
+        }
+        std::vector<NitroEventSourceEvent>().swap(_discarded_events);
+    }
+    const bool loaded = loaded_for(level);
+    if (_under_load.exchange(loaded) == loaded) {
+        return;
+    }
+    NITRO_ES_LOG_INFO(TAG, loaded ? "Device under load, degrading delivery" : "Device load back to normal, restoring delivery");
+    // What was held back for the longer window goes out now, ahead of events delivered directly again
+    if (!loaded) {
+        flush_events();
+    }
+}
+
+void HybridNitroEventSource::suspend(BackgroundPolicy policy) noexcept {
+    if (closed()) {
+        return;
+    }
+
+    // Tear down the transfer but keep the easy handle and its caches for the resume
+    if (_reconnect_timer) {
+        TransferEngine::shared().cancel(*_reconnect_timer);
+        _reconnect_timer.reset();
+    }
+    cancel_idle_timer();
+    cancel_standby();
+    if (_curl) {
+        TransferEngine::shared().remove_transfer(_curl);
+    }
+    _waiting_for_network = false;
+
+    if (policy == BackgroundPolicy::CLOSE) {
+        // JS closes every EventSource on this error, which releases the stream
+        NITRO_ES_LOG_INFO(TAG, "Backgrounded, closing");
+        end_stream();
+        return;
+    }
+    NITRO_ES_LOG_INFO(TAG, "Backgrounded, pausing until foregrounded");
+    _suspended = true;
+    set_ready_state(ReadyState::CONNECTING);
+    dispatch_event(NitroEventSourceEvent(_last_event_id, "error", "paused", std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt), EventTypeTable::ERROR);
+}
+
+bool HybridNitroEventSource::init_connection() noexcept {
+    _curl = StreamRecycler::shared().take_handle();
+    if (!_curl) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to initialize CURL");
+        return false;
+    }
+
+    const auto set_option = [&](CURLoption option, auto value) -> bool {
+        const CURLcode result = curl_easy_setopt(_curl, option, value);
+        if (result != CURLE_OK) {
+            NITRO_ES_LOG_ERROR(TAG, "CURL option error: " + std::string(curl_easy_strerror(result)));
+            return false;
+        }
+        return true;
+    };
+
+    if (websocket() && !curl_utils::supports_websockets()) {
+        NITRO_ES_LOG_ERROR(TAG, "WebSocket transport requested but libcurl was built without WebSocket support");
+        release_connection();
+        return false;
+    }
+
+    const ConnectionSpec& spec = *_spec;
+    _handle_url = request_url();
+    if (!set_option(CURLOPT_URL, _handle_url.c_str()) ||
+        !set_option(CURLOPT_WRITEFUNCTION, curl_utils::write_callback) ||
+        !set_option(CURLOPT_WRITEDATA, this) ||
+        !set_option(CURLOPT_USERAGENT, spec.user_agent.c_str()) ||
+        !set_option(CURLOPT_FOLLOWLOCATION, 1L) ||
+        !set_option(CURLOPT_MAXREDIRS, 5L)) {
+        release_connection();
+        return false;
+    }
+
+    if (CURLSH* share = TransferEngine::shared().share_handle()) {
+        set_option(CURLOPT_SHARE, share);
+    }
+    // "" turns the cookie engine on without reading a file; the jar itself is the share's
+    if (spec.with_credentials) {
+        set_option(CURLOPT_COOKIEFILE, "");
+    }
+
+    // The upgrade is a plain GET, curl adds its own headers for it; everything past the request
+    // itself, timeouts, socket, DNS and the header callback, applies to it all the same
+    if (!websocket()) {
+        // A body implies POST; any other method goes out verbatim, with or without a body
+        if (spec.body) {
+            if (!set_option(CURLOPT_POSTFIELDS, spec.body->data()) ||
+                !set_option(CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(spec.body->size()))) {
+                release_connection();
+                return false;
+            }
+        }
+        if (spec.method != (spec.body ? "POST" : "GET") && !set_option(CURLOPT_CUSTOMREQUEST, spec.method.c_str())) {
+            release_connection();
+            return false;
+        }
+#if LIBCURL_VERSION_NUM >= 0x080b00
+        // A resumed TLS 1.3 session can carry the request in 0-RTT early data. An attacker can
+        // replay early data, so only a body-less GET, which subscribes and changes nothing, goes there
+        if (spec.method == "GET" && !spec.body) {
+            set_option(CURLOPT_SSL_OPTIONS, CURLSSLOPT_EARLYDATA);
+        }
+#endif
+    }
+
+    set_option(CURLOPT_CONNECTTIMEOUT_MS, spec.connect_timeout_ms);
+    if (spec.low_speed_limit > 0) {
+        set_option(CURLOPT_LOW_SPEED_LIMIT, spec.low_speed_limit);
+        set_option(CURLOPT_LOW_SPEED_TIME, spec.low_speed_seconds);
+    }
+
+    // Keepalive probes hold carrier NAT mappings open and let the kernel notice a peer that
+    // vanished with a network switch, far cheaper than a reconnect. curl takes whole seconds
+    const SocketOptions socket = (_options && _options->socket) ? *_options->socket : SocketOptions();
+    const auto to_seconds = [](double ms) { return std::max(1L, static_cast<long>(std::ceil(ms / 1000.0))); };
+    if (socket.keepalive.value_or(true)) {
+        set_option(CURLOPT_TCP_KEEPALIVE, 1L);
+        if (socket.keepaliveIdleMs) {
+            set_option(CURLOPT_TCP_KEEPIDLE, to_seconds(*socket.keepaliveIdleMs));
+        }
+        if (socket.keepaliveIntervalMs) {
+            set_option(CURLOPT_TCP_KEEPINTVL, to_seconds(*socket.keepaliveIntervalMs));
+        }
+    } else {
+        set_option(CURLOPT_TCP_KEEPALIVE, 0L);
+    }
+    set_option(CURLOPT_TCP_NODELAY, socket.noDelay.value_or(true) ? 1L : 0L);
+    // rateLimit.maxBytesPerSecond: curl stops reading the socket for a while once ahead of the rate
+    if (_options && _options->rateLimit && _options->rateLimit->maxBytesPerSecond.value_or(0.0) > 0.0) {
+        set_option(CURLOPT_MAX_RECV_SPEED_LARGE, static_cast<curl_off_t>(*_options->rateLimit->maxBytesPerSecond));
+    }
+    if (socket.receiveBufferBytes && *socket.receiveBufferBytes > 0) {
+        _receive_buffer_bytes = static_cast<int>(std::min<double>(*socket.receiveBufferBytes, std::numeric_limits<int>::max()));
+        set_option(CURLOPT_SOCKOPTFUNCTION, curl_utils::sockopt_callback);
+        set_option(CURLOPT_SOCKOPTDATA, &_receive_buffer_bytes);
+    }
+    // Happy eyeballs races IPv4 against IPv6 once the head start runs out; on networks with
+    // broken IPv6 a short head start, or IPv4 only, avoids stalling every connect
+    if (socket.happyEyeballsTimeoutMs) {
+        set_option(CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, static_cast<long>(std::max(0.0, *socket.happyEyeballsTimeoutMs)));
+    }
+    if (socket.ipFamily) {
+        set_option(CURLOPT_IPRESOLVE, *socket.ipFamily == IpFamily::V4 ? CURL_IPRESOLVE_V4 : CURL_IPRESOLVE_V6);
+    }
+
+    // Resolution is shared with every stream through the share handle, so the cache outlives
+    // this handle; a pinned address or DoH resolver spares slow carrier DNS on every reconnect
+    if (_options && _options->dns) {
+        const DnsOptions& dns = *_options->dns;
+        if (dns.cacheTtlMs) {
+            // Whole seconds, -1 keeps entries forever
+            set_option(CURLOPT_DNS_CACHE_TIMEOUT, *dns.cacheTtlMs < 0 ? -1L : static_cast<long>(std::ceil(*dns.cacheTtlMs / 1000.0)));
+        }
+        if (dns.resolve) {
+            for (const std::string& entry : *dns.resolve) {
+                if (curl_slist* list = curl_slist_append(_resolve, entry.c_str())) {
+                    _resolve = list;
+                }
+            }
+            if (_resolve) {
+                set_option(CURLOPT_RESOLVE, _resolve);
+            }
+        }
+        if (dns.dohUrl && !set_option(CURLOPT_DOH_URL, dns.dohUrl->c_str())) {
+            release_connection();
+            return false;
+        }
+    }
+
+    // Status and Content-Type are checked in receive_header before the body is parsed
+    if (!set_option(CURLOPT_HEADERFUNCTION, curl_utils::header_callback) ||
+        !set_option(CURLOPT_HEADERDATA, this)) {
+        release_connection();
+        return false;
+    }
+
+    // With a shared dictionary the body is decoded by receive_body, curl must pass it through untouched
+    if (_decoder) {
+        if (!set_option(CURLOPT_HTTP_CONTENT_DECODING, 0L)) {
+            release_connection();
+            return false;
+        }
+    } else if (!websocket() && (!_options || _options->compression.value_or(true))) {
+        // An empty string advertises every encoding this libcurl can decode; the body is
+        // decompressed as it streams in, so the parser only ever sees plain text
+        if (curl_utils::supports_content_encoding()) {
+            set_option(CURLOPT_ACCEPT_ENCODING, "");
+        } else if (_options && _options->compression) {
+            NITRO_ES_LOG_WARN(TAG, "Compression requested but libcurl was built without zlib, brotli or zstd");
+        }
+    }
+
+    // HTTP/2 multiplexes every stream to an origin over one connection,
+    // PIPEWAIT makes new streams wait for an existing connection instead of opening another
+    // WebSocket upgrades are HTTP/1.1 only
+    bool use_http2 = !websocket() && _options && _options->http2.value_or(false);
+    if (use_http2 && !curl_utils::supports_http2()) {
+        NITRO_ES_LOG_WARN(TAG, "HTTP/2 requested but libcurl was built without HTTP/2 support, using HTTP/1.1");
+        use_http2 = false;
+    }
+    // HTTP/3 races QUIC against TCP and keeps whichever connects first, so a network that
+    // blocks UDP costs at most the happy-eyeballs delay before HTTP/2 or HTTP/1.1 take over
+    bool use_http3 = !websocket() && _options && _options->http3.value_or(false);
+    if (use_http3 && !curl_utils::supports_http3()) {
+        NITRO_ES_LOG_WARN(TAG, "HTTP/3 requested but libcurl was built without HTTP/3 support, falling back");
+        use_http3 = false;
+    }
+
+    if (use_http2 || use_http3) {
+        if (!set_option(CURLOPT_HTTP_VERSION, use_http3 ? CURL_HTTP_VERSION_3 : CURL_HTTP_VERSION_2TLS) ||
+            !set_option(CURLOPT_PIPEWAIT, 1L)) {
+            release_connection();
+            return false;
+        }
+        // Streams sharing a connection split its bandwidth by weight
+        const long weights[] = {1, 16, 256};
+        set_option(CURLOPT_STREAM_WEIGHT, weights[static_cast<size_t>(engine_priority())]);
+    } else if (!set_option(CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1)) {
+        release_connection();
+        return false;
+    }
+
+    return true;
+}
+
+bool HybridNitroEventSource::attempt_connection() noexcept {
+    // The easy handle lives as long as the stream, so reconnects keep its
+    // connection, DNS and TLS session caches and only rebuild per-request state
+    if (!_curl && !init_connection()) {
+        return false;
+    }
+    if (std::string url = request_url(); url != _handle_url) {
+        const CURLcode url_result = curl_easy_setopt(_curl, CURLOPT_URL, url.c_str());
+        if (url_result != CURLE_OK) {
+            NITRO_ES_LOG_ERROR(TAG, "CURL option error: " + std::string(curl_easy_strerror(url_result)));
+            release_connection();
+            return false;
+        }
+        _handle_url = std::move(url);
+    }
+    const bool cross_origin = !websocket() && _handle_url != stream_url() && origin_of(_handle_url) != origin_of(stream_url());
+    if (cross_origin != _headers_cross_origin) {
+        _headers_cross_origin = cross_origin;
+        _headers_stale = true;
+    }
+
+    // The fixed headers are built once per handle. Only Last-Event-ID changes between attempts,
+    // so it sits in a node of its own linked in front of them and is replaced when the id moves on
+    if (_headers_stale) {
+        _headers_stale = false;
+        free_request_headers();
+    }
+    // Only updateHeaders(), a switch to WebSocket or a redirect to another origin needs a block other than the spec's
+    if (!_headers && (_header_override || _websocket_fallback || _headers_cross_origin)) {
+        build_request_headers();
+    }
+    curl_slist* const fixed = _headers ? _headers : _spec->headers();
+    curl_slist* headers = fixed;
+    if (!_last_event_id.empty()) {
+        constexpr std::string_view PREFIX = "Last-Event-ID: ";
+        if (!_last_event_id_header || std::string_view(_last_event_id_header->data).substr(PREFIX.size()) != _last_event_id) {
+            free_last_event_id_header();
+            const std::string header = std::string(PREFIX) + _last_event_id;
+            _last_event_id_header = curl_slist_append(nullptr, header.c_str());
+        }
+        if (_last_event_id_header) {
+            _last_event_id_header->next = fixed;
+            headers = _last_event_id_header;
+        }
+    }
+    // stateSync: which version of the document the server only has to bring up to date
+    if (!_state_version.empty()) {
+        const std::string header = _options->stateSync->versionHeader.value_or("X-State-Version") + ": " + _state_version;
+        if (!_state_version_header || header != _state_version_header->data) {
+            free_state_version_header();
+            _state_version_header = curl_slist_append(nullptr, header.c_str());
+        }
+        if (_state_version_header) {
+            _state_version_header->next = headers;
+            headers = _state_version_header;
+        }
+    } else {
+        free_state_version_header();
+    }
+
+    const CURLcode header_result = curl_easy_setopt(_curl, CURLOPT_HTTPHEADER, headers);
+    if (header_result != CURLE_OK) {
+        NITRO_ES_LOG_ERROR(TAG, "CURL option error: " + std::string(curl_easy_strerror(header_result)));
+        release_connection();
+        return false;
+    }
+
+    std::shared_ptr<HybridNitroEventSource> self;
+    try {
+        self = shared_cast<HybridNitroEventSource>();
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to retain EventSource: " + std::string(e.what()));
+        release_connection();
+        return false;
+    }
+
+    // Until the first body byte, or the end of a transfer that never got there
+    NITRO_ES_TRACE_ASYNC_BEGIN("connect", this);
+
+    // The engine keeps the stream alive until the transfer completes or is detached by close()
+    const bool added = TransferEngine::shared().add_transfer(_curl, [self = std::move(self)](CURLcode result) noexcept {
+        self->on_transfer_done(result);
+    }, engine_priority());
+
+    if (!added) {
+        NITRO_ES_TRACE_ASYNC_END("connect", this);
+        release_connection();
+        return false;
+    }
+    arm_idle_timer();
+    return true;
+}
+
+std::optional<ConnectionTiming> HybridNitroEventSource::record_connection_timing() noexcept {
+    // Cumulative from the start of the request; zero for steps a reused connection skipped
+    curl_off_t dns_us = 0, connect_us = 0, tls_us = 0, first_byte_us = 0, total_us = 0;
+    long new_connections = 0;
+    if (curl_easy_getinfo(_curl, CURLINFO_STARTTRANSFER_TIME_T, &first_byte_us) != CURLE_OK) {
+        return std::nullopt;
+    }
+    curl_easy_getinfo(_curl, CURLINFO_NAMELOOKUP_TIME_T, &dns_us);
+    curl_easy_getinfo(_curl, CURLINFO_CONNECT_TIME_T, &connect_us);
+    curl_easy_getinfo(_curl, CURLINFO_APPCONNECT_TIME_T, &tls_us);
+    curl_easy_getinfo(_curl, CURLINFO_TOTAL_TIME_T, &total_us);
+    curl_easy_getinfo(_curl, CURLINFO_NUM_CONNECTS, &new_connections);
+    // The address family that won the happy-eyeballs race, or served the reused connection
+    const char* primary_ip = nullptr;
+    std::optional<IpFamily> family;
+    if (curl_easy_getinfo(_curl, CURLINFO_PRIMARY_IP, &primary_ip) == CURLE_OK && primary_ip && *primary_ip) {
+        family = std::strchr(primary_ip, ':') ? IpFamily::V6 : IpFamily::V4;
+    }
+    NITRO_ES_TRACE_VALUE("dns_us", dns_us);
+    NITRO_ES_TRACE_VALUE("connect_us", connect_us);
+    NITRO_ES_TRACE_VALUE("tls_us", tls_us);
+    NITRO_ES_TRACE_VALUE("first_byte_us", first_byte_us);
+
+    // Split into the time each phase took, so a slow start points at DNS, TLS or the server
+    const auto phase_ms = [](curl_off_t end_us, curl_off_t start_us) {
+        return end_us > start_us ? static_cast<double>(end_us - start_us) / 1000.0 : 0.0;
+    };
+    const curl_off_t handshake_us = std::max(connect_us, tls_us);
+    ConnectionTiming timing(phase_ms(dns_us, 0),
+                            phase_ms(connect_us, dns_us),
+                            tls_us > 0 ? phase_ms(tls_us, connect_us) : 0.0,
+                            phase_ms(first_byte_us, handshake_us),
+                            phase_ms(total_us, 0),
+                            new_connections == 0,
+                            family,
+                            stream_url());
+    _time_to_first_byte.record(std::chrono::microseconds(first_byte_us));
+    _endpoints.record_open(_endpoint, timing.totalMs);
+
+    std::lock_guard<std::mutex> lock(_connection_timing_mutex);
+    _last_connection_timing = timing;
+    return timing;
+}
+
+void HybridNitroEventSource::remember_redirect() noexcept {
+    constexpr double DEFAULT_PERMANENT_MS = 3600000.0;
+    constexpr double DEFAULT_TEMPORARY_MS = 60000.0;
+
+    // The WebSocket fallback goes back to the endpoint's http(s) URL, a ws(s) target would not do
+    long redirects = 0;
+    const char* effective_url = nullptr;
+    if (websocket() || curl_easy_getinfo(_curl, CURLINFO_REDIRECT_COUNT, &redirects) != CURLE_OK || redirects <= 0 ||
+        curl_easy_getinfo(_curl, CURLINFO_EFFECTIVE_URL, &effective_url) != CURLE_OK || !effective_url) {
+        return;
+    }
+    // Sent straight to the target, the request has to be the one curl sent there: 307 and 308
+    // keep the method and body, the others turn a POST into a GET
+    if (!_redirects_keep_method && (_spec->method != "GET" || _spec->body)) {
+        return;
+    }
+
+    const RedirectCacheOptions cache = _options && _options->redirectCache ? *_options->redirectCache : RedirectCacheOptions();
+    const double ttl_ms = _redirects_permanent ? cache.permanentMs.value_or(DEFAULT_PERMANENT_MS) : cache.temporaryMs.value_or(DEFAULT_TEMPORARY_MS);
+    if (ttl_ms <= 0) {
+        return;
+    }
+    try {
+        const auto ttl = std::chrono::duration_cast<TransferEngine::Clock::duration>(std::chrono::duration<double, std::milli>(ttl_ms));
+        _endpoints.record_redirect(_endpoint, effective_url, TransferEngine::Clock::now() + ttl);
+    } catch (const std::bad_alloc&) {
+        // The next attempt follows the redirect again
+    }
+}
+
+std::optional<StreamError> HybridNitroEventSource::describe_failure(CURLcode result, long status) const {
+    const bool idle = result == CURLE_ABORTED_BY_CALLBACK && _idle_timed_out;
+    if (result == CURLE_OK || (result == CURLE_ABORTED_BY_CALLBACK && !idle)) {
+        return std::nullopt;
+    }
+
+    const ErrorPhase phase = status == 0 ? ErrorPhase::CONNECT : _open_event_sent.load() ? ErrorPhase::STREAM : ErrorPhase::RESPONSE;
+    std::string message;
+    if (idle) {
+        message = _stall_switch ? "No data within timeouts.stallMs" : "No data within timeouts.idleMs";
+    } else if (_rejected_content_type) {
+        message = "Unexpected Content-Type '" + _response_content_type + "'";
+    } else if (phase == ErrorPhase::RESPONSE && status != 200) {
+        message = "HTTP status " + std::to_string(status);
+    } else {
+        message = curl_easy_strerror(result);
+    }
+    return StreamError(phase, static_cast<double>(result), status > 0 ? std::optional<double>(status) : std::nullopt, std::move(message), 0, std::nullopt, std::nullopt);
+}
+
+void HybridNitroEventSource::on_transfer_done(CURLcode result) noexcept {
+    cancel_idle_timer();
+    finish_reconnect(false);
+    flush_transformers();
+    if (!_open_event_sent.load()) {
+        NITRO_ES_TRACE_ASYNC_END("connect", this);
+    }
+
+    long status = 0;
+    curl_easy_getinfo(_curl, CURLINFO_RESPONSE_CODE, &status);
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    if (!_curl) {
+        status = _script_status;
+    }
+#endif
+
+    // A finite stream the server says is complete, e.g. 204 No Content
+    if (should_retry() && is_terminal_status(status)) {
+        end_stream();
+    }
+
+    // Backoff starts over once a connection actually delivered data, and so does the 401 refresh
+    if (_open_event_sent.load()) {
+        _reconnect_attempts = 0;
+        _credentials_refreshed = false;
+        _breaker_failures = 0;
+        _breaker_trips = 0;
+    }
+
+    std::optional<StreamError> error = describe_failure(result, status);
+    const auto now = TransferEngine::Clock::now();
+    if (error) {
+        _endpoints.record_failure(_endpoint, now);
+    }
+    // A cached redirect target that did not open sends the next attempt through the redirect again
+    if (error && !_open_event_sent.load()) {
+        _endpoints.forget_redirect(_endpoint);
+    }
+    // A client error is final, the same request would only be refused again; 408 and 429 ask for a retry
+    const bool refused = error && error->phase == ErrorPhase::RESPONSE && status >= 400 && status < 500 && status != 408 && status != 429;
+    // With an unauthorized callback, JS gets one chance to refresh the credentials on a 401;
+    // its updateHeaders() reconnects straight away rather than after a backoff
+    const auto unauthorized_callback = refused && status == 401 && should_retry() && !_credentials_refreshed
+                                           ? load_callback(_unauthorized_callback)
+                                           : nullptr;
+    // fetchMode is one request: its response, or its failure, ends the stream
+    const bool retrying = should_retry() && !refused && !fetch_mode();
+    const uint32_t attempt = _reconnect_attempts + 1;
+    std::optional<std::chrono::milliseconds> delay =
+        retrying ? std::optional(next_reconnect_delay(classify_close(result, status, error))) : std::nullopt;
+
+    // A stream that was open fails over at once, onto the connection kept warm for it
+    if (delay && _open_event_sent.load() && _options && _options->standby &&
+        (!_last_failover || now - *_last_failover >= standby_keep_warm(*_options->standby))) {
+        _last_failover = now;
+        _failover_endpoint = standby_endpoint();
+        NITRO_ES_LOG_INFO(TAG, "Failing over to " + _endpoints.url(_failover_endpoint));
+        delay = std::chrono::milliseconds(0);
+    }
+    // timeouts.stallMs: a fresh connection is already waiting
+    if (std::exchange(_stall_switch, false) && delay) {
+        delay = std::chrono::milliseconds(0);
+    }
+    // An attempt that never opened counts towards the circuit breaker, which stretches the delay once open
+    if (delay && error && !_open_event_sent.load()) {
+        if (const std::optional<std::chrono::milliseconds> open_for = trip_breaker(result)) {
+            delay = open_for;
+            error->circuitOpen = true;
+        }
+    }
+
+    if (error) {
+        NITRO_ES_LOG_WARN(TAG, "Connection error: " + error->message);
+        error->attempt = static_cast<double>(attempt);
+        // Offline, the retry waits for the network rather than a timer
+        if (delay && !(network_aware() && !NetworkMonitor::shared().online())) {
+            error->retryInMs = static_cast<double>(delay->count());
+        }
+
+        // `data` keeps its short code for listeners that only look at that
+        std::string code = "network";
+        if (result == CURLE_ABORTED_BY_CALLBACK || result == CURLE_OPERATION_TIMEDOUT) {
+            code = "timeout";
+        } else if (_rejected_content_type) {
+            code = "content-type";
+        } else if (error->phase == ErrorPhase::RESPONSE && status != 200) {
+            code = std::to_string(status);
+        }
+        dispatch_event(NitroEventSourceEvent(_last_event_id, "error", std::move(code), std::nullopt, std::nullopt, std::move(error), std::nullopt, std::nullopt, std::nullopt), EventTypeTable::ERROR);
+    }
+
+    if (unauthorized_callback) {
+        _credentials_refreshed = true;
+        _awaiting_credentials = true;
+        set_ready_state(ReadyState::CONNECTING);
+        try {
+            (*unauthorized_callback)();
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in unauthorized callback: " + std::string(e.what()));
+        }
+        return;
+    }
+    if ((refused || fetch_mode()) && !closed()) {
+        end_stream();
+    }
+    if (!delay) {
+        set_ready_state(ReadyState::CLOSED);
+        release_connection();
+        NITRO_ES_LOG_INFO(TAG, "Connection loop terminated");
+        return;
+    }
+
+    set_ready_state(ReadyState::CONNECTING);
+    schedule_reconnect(*delay);
+}
+
+void HybridNitroEventSource::build_request_headers() noexcept {
+    const auto* custom = _header_override ? &*_header_override : (_options && _options->headers ? &*_options->headers : nullptr);
+    if (!_headers_cross_origin || !custom) {
+        _headers = _spec->build_headers(websocket(), custom);
+        return;
+    }
+    std::unordered_map<std::string, std::string> forwarded;
+    try {
+        for (const auto& [name, value] : *custom) {
+            const std::string lowered = stream_key::lower(stream_key::trim(name));
+            if (lowered != "authorization" && lowered != "cookie") {
+                forwarded.emplace(name, value);
+            }
+        }
+    } catch (const std::bad_alloc&) {
+        // Without the custom headers rather than with the credentials
+        forwarded.clear();
+    }
+    _headers = _spec->build_headers(websocket(), &forwarded);
+}
+
+void HybridNitroEventSource::free_last_event_id_header() noexcept {
+    if (curl_slist* header = std::exchange(_last_event_id_header, nullptr)) {
+        // Linked in front of the fixed headers, which are not ours to free here
+        header->next = nullptr;
+        curl_slist_free_all(header);
+    }
+}
+
+void HybridNitroEventSource::free_state_version_header() noexcept {
+    if (curl_slist* header = std::exchange(_state_version_header, nullptr)) {
+        header->next = nullptr;
+        curl_slist_free_all(header);
+    }
+}
+
+void HybridNitroEventSource::free_request_headers() noexcept {
+    free_state_version_header();
+    free_last_event_id_header();
+    if (curl_slist* headers = std::exchange(_headers, nullptr)) {
+        curl_slist_free_all(headers);
+    }
+}
+
+void HybridNitroEventSource::release_connection() noexcept {
+    // A pending reconnect holds a strong reference, drop it now rather than when it fires
+    if (_reconnect_timer) {
+        TransferEngine::shared().cancel(*_reconnect_timer);
+        _reconnect_timer.reset();
+    }
+    if (_background_timer) {
+        TransferEngine::shared().cancel(*_background_timer);
+        _background_timer.reset();
+    }
+    if (_rate_timer) {
+        TransferEngine::shared().cancel(*_rate_timer);
+        _rate_timer.reset();
+    }
+    cancel_idle_timer();
+    cancel_standby();
+
+    finish_reconnect(false);
+    if (CURL* curl = std::exchange(_curl, nullptr)) {
+        TransferEngine::shared().remove_transfer(curl);
+        StreamRecycler::shared().give_handle(curl, !(_spec && _spec->with_credentials));
+    }
+
+    free_request_headers();
+    if (curl_slist* resolve = std::exchange(_resolve, nullptr)) {
+        curl_slist_free_all(resolve);
+    }
+}
+
+void HybridNitroEventSource::parse_sse_chunk(std::string_view chunk) noexcept {
+    NITRO_ES_TRACE_SCOPE("parse_sse_chunk");
+    if (chunk.empty() || closed()) {
+        return;
+    }
+
+    // Only the I/O thread feeds the parser, so the hot path takes no lock
+    _parser.feed(chunk);
+}
+
+std::optional<RecordFormat> HybridNitroEventSource::record_format() const noexcept {
+    switch (stream_format()) {
+        case StreamFormat::NDJSON: return RecordFormat::NDJSON;
+        case StreamFormat::JSON_SEQ: return RecordFormat::JSON_SEQ;
+        case StreamFormat::SSE: break;
+    }
+    return std::nullopt;
+}
+
+bool HybridNitroEventSource::decode_json(std::string_view data, JsonDocument& out) const noexcept {
+    const CpuTimeAccount::Scope decoding(_cpu_time, CpuTimeAccount::Phase::DECODE);
+    return parse_json(data, out);
+}
+
+size_t HybridNitroEventSource::max_id_bytes() const noexcept {
+    if (!_options || !_options->maxIdBytes) {
+        return LastEventIdStore::MAX_ID_BYTES;
+    }
+    return static_cast<size_t>(std::max(0.0, *_options->maxIdBytes));
+}
+
+SseLimits HybridNitroEventSource::parser_limits() const noexcept {
+    SseLimits limits;
+    if (!_options) {
+        return limits;
+    }
+    if (_options->maxLineBytes) {
+        limits.max_line_bytes = static_cast<size_t>(std::max(1.0, *_options->maxLineBytes));
+    }
+    if (_options->maxEventBytes) {
+        limits.max_event_bytes = static_cast<size_t>(std::max(1.0, *_options->maxEventBytes));
+    }
+    if (_options->dataChunkBytes) {
+        limits.chunk_bytes = static_cast<size_t>(std::max(1.0, *_options->dataChunkBytes));
+    }
+    switch (_options->oversize.value_or(OversizePolicy::DROP)) {
+        case OversizePolicy::DROP: limits.oversize = SseLimits::Oversize::DROP; break;
+        case OversizePolicy::TRUNCATE: limits.oversize = SseLimits::Oversize::TRUNCATE; break;
+        case OversizePolicy::CHUNK: limits.oversize = SseLimits::Oversize::CHUNK; break;
+    }
+    return limits;
+}
+
+bool HybridNitroEventSource::emit_data_chunk(std::string& data, SseChunk position) noexcept {
+    if (position == SseChunk::BEGIN) {
+        // The first chunk decides for the whole event, so type and id must precede the data to apply;
+        // chunks are never decoded as JSON, so pointer filters do not match them
+        const bool has_id = std::exchange(_event_has_id, false);
+        NitroEventSourceEvent probe;
+        probe.id = _last_event_id;
+        probe.type = _event_type_id == EventTypeTable::NONE ? _event_type : _event_types.name(_event_type_id);
+        if ((has_id && is_duplicate_id(_last_event_id)) || !accepts_type(_event_type_id) || !accepts_payload(probe, nullptr)) {
+            return false;
+        }
+    }
+    if (closed()) {
+        return false;
+    }
+
+    NitroEventSourceEvent event = acquire_event();
+    event.id.assign(_last_event_id);
+    event.receivedAt = epoch_ms(_chunk_received_wall);
+    const EventTypeTable::Id type = _event_type_id;
+    event.type.assign(type == EventTypeTable::NONE ? _event_type : _event_types.name(type));
+    event.chunk = position == SseChunk::BEGIN ? DataChunk::BEGIN : position == SseChunk::END ? DataChunk::END : DataChunk::CONTINUE;
+    event.data.swap(data);
+    dispatch_event(std::move(event), type);
+    return true;
+}
+
+void HybridNitroEventSource::process_sse_field(SseField field, std::string_view name, std::string_view value) noexcept {
+    // A latencyTracing field named `retry` takes that field over, one named `event` or `id` does not
+    if (field != SseField::EVENT && field != SseField::ID && _options && _options->latencyTracing &&
+        _options->latencyTracing->field == name) {
+        _event_sent_at = parse_timestamp(value);
+        return;
+    }
+
+    switch (field) {
+        case SseField::EVENT:
+            // Known types are kept as ids; only unknown ones past the intern limit keep their own string
+            _event_type_id = _event_types.intern_from_server(value);
+            if (_event_type_id == EventTypeTable::NONE) {
+                _event_type.assign(value);
+            } else {
+                _event_type.clear();
+            }
+            break;
+        case SseField::ID:
+            // Per spec an id containing NUL is ignored and an empty one resets the id. One over
+            // maxIdBytes is ignored too, so the id resumed with stays one the server sent whole
+            if (value.find('\0') != std::string_view::npos || value.size() > max_id_bytes()) {
+                _ids_ignored.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            _last_event_id.assign(value);
+            _event_has_id = true;
+            break;
+        case SseField::RETRY: {
+            // Per spec only ASCII digits count; from_chars would also take a sign. Too large to
+            // represent is still a valid delay, just one past the cap
+            constexpr int MIN_RETRY_MS = 100;
+            constexpr int MAX_RETRY_MS = 60000;
+            int retry_ms = 0;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), retry_ms);
+            if (value.empty() || value.front() < '0' || value.front() > '9' || end != value.data() + value.size()) {
+                NITRO_ES_LOG_WARN(TAG, "Invalid retry value: " + std::string(value));
+                break;
+            }
+            _server_retry_ms = error == std::errc::result_out_of_range ? MAX_RETRY_MS : std::clamp(retry_ms, MIN_RETRY_MS, MAX_RETRY_MS);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void HybridNitroEventSource::process_sse_comment() noexcept {
+    // The chunk's arrival is already taken, a keepalive costs two relaxed stores and no clock read
+    _comments_received.fetch_add(1, std::memory_order_relaxed);
+    _last_comment_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(_chunk_received_wall.time_since_epoch()).count(),
+                           std::memory_order_relaxed);
+}
+
+void HybridNitroEventSource::process_record(std::string_view record, bool oversized) noexcept {
+    NITRO_ES_TRACE_SCOPE("process_record");
+    if (oversized) {
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Records have no fields: each is the data of a `message` event, deduplicated, filtered and decoded like one
+    _record_data.assign(record);
+    process_sse_event(_record_data, false, sse_scan::find_non_ascii(record) == std::string_view::npos);
+}
+
+void HybridNitroEventSource::process_sse_event(std::string& data, bool oversized, bool ascii) noexcept {
+    NITRO_ES_TRACE_SCOPE("process_sse_event");
+    const std::optional<double> sent_at = std::exchange(_event_sent_at, std::nullopt);
+    if (sent_at && _buffering) {
+        _buffering->record_lag(epoch_ms(_chunk_received_wall) - *sent_at * timestamp_scale_us() / 1000.0);
+    }
+
+    // A new id is saved as soon as its event is complete, so a cold start resumes after it
+    if (_event_has_id && _id_store) {
+        _id_store->store(_last_event_id);
+    }
+
+    // Events without their own `id:` inherit the last one, so only explicit ids are deduplicated
+    const bool has_id = std::exchange(_event_has_id, false);
+
+    // Per spec an event without data still resets the type; so does the end of a chunked event
+    if (data.empty() || closed()) {
+        _event_type.clear();
+        _event_type_id = EventTypeTable::MESSAGE;
+        return;
+    }
+
+    _events_parsed.fetch_add(1, std::memory_order_relaxed);
+
+    // Over maxEventBytes or a replay after reconnecting with Last-Event-ID
+    bool dropped = oversized || (has_id && is_duplicate_id(_last_event_id));
+    if (dropped) {
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The journal and the warm-start cache record the stream as received, whether or not anyone listens
+    if (!dropped && (_journal || _warm_cache)) {
+        const std::string& type_name = _event_type_id == EventTypeTable::NONE ? _event_type : _event_types.name(_event_type_id);
+        if (_journal) {
+            _journal->append(_last_event_id, type_name, data);
+        }
+        if (_warm_cache) {
+            _warm_cache->store(type_name, _last_event_id, data);
+        }
+    }
+
+    // heartbeat: measured whether or not anyone listens to it
+    if (!dropped && _heartbeat && _event_type_id == _heartbeat_type) {
+        record_heartbeat(data);
+    }
+
+    // stateSync snapshots and patches keep the native document current even when nobody listens,
+    // JS only ever receives the paths they changed
+    std::optional<std::vector<std::string>> paths;
+    if (!dropped && is_state_event(_event_type_id)) {
+        paths = apply_state_event(_event_type_id, data);
+        dropped = !paths;
+        data.clear();
+    }
+
+    // tokenStream: the delta joins the pending text instead of going out on its own
+    if (!dropped && _event_type_id == _token_type && _token_type != EventTypeTable::NONE) {
+        append_token(data);
+        dropped = true;
+    }
+
+    // aggregation: the event only adds to its type's window
+    if (!dropped && _aggregator && _event_type_id < _aggregated_types.size() && _aggregated_types[_event_type_id]) {
+        aggregate_event(_event_type_id, data);
+        dropped = true;
+    }
+
+    // endOfStream: the sentinel is not delivered, an event of the terminal type is, and then the stream ends
+    if (!dropped && _options && _options->endOfStream && _options->endOfStream->data == data) {
+        end_stream();
+        dropped = true;
+    }
+    const bool terminal = !dropped && _end_type != EventTypeTable::NONE && _event_type_id == _end_type;
+
+    // Nobody subscribed to this type: drop it before building anything for JS
+    const bool filtered = !dropped && !accepts_type(_event_type_id);
+    if (filtered) {
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+        // Kept for a listener of this type that attaches later; it has no sequence, it was never delivered
+        if (_recent_events) {
+            NitroEventSourceEvent event;
+            event.id = _last_event_id;
+            event.type = _event_type_id == EventTypeTable::NONE ? _event_type : _event_types.name(_event_type_id);
+            event.data = data;
+            event.receivedAt = epoch_ms(_chunk_received_wall);
+            _recent_events->record(std::move(event), TransferEngine::Clock::now());
+        }
+    }
+    // sampling: one in `every` is decided here too, so the rest are never decoded
+    const bool sampled_out = !dropped && !filtered && !terminal && samples_type(_event_type_id) && !_sampler->keeps_nth();
+    if (sampled_out) {
+        _sampled_out.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (dropped || filtered || sampled_out) {
+        _event_type.clear();
+        _event_type_id = EventTypeTable::MESSAGE;
+        if (terminal) {
+            end_stream();
+        }
+        return;
+    }
+
+
+    // Swap the accumulated payload into a pooled event so it is never copied on its way out,
+    // and the pooled buffer becomes the next accumulator; the generated constructor copies
+    // its arguments, so fill the fields directly
+    NitroEventSourceEvent event = acquire_event();
+    event.id.assign(_last_event_id);
+    event.receivedAt = epoch_ms(_chunk_received_wall);
     // Use default event type if none specified (per SSE spec)
-    const std::string event_type = _event_type.empty() ? "message" : _event_type;
-    
-    // Create event and dispatch if still active
-    if (!_closed.load()) {
-        const NitroEventSourceEvent event(_last_event_id, event_type, _event_data);
-        dispatch_event(event);
+    const EventTypeTable::Id type = _event_type_id;
+    if (type == EventTypeTable::NONE) {
+        event.type.swap(_event_type);
+    } else {
+        event.type.assign(_event_types.name(type));
     }
-    
-    // Reset event state for next event
+    event.data.swap(data);
+    event.paths = std::move(paths);
+    // Numbered once it is built for delivery, so a gap downstream is an event a later stage dropped
+    event.sequence = static_cast<double>(++_event_sequence);
+    _rate_tokens -= 1.0;
+
+    // Reset event state for next event, the parser sizes the new accumulator
     _event_type.clear();
-    _event_data.clear();
+    _event_type_id = EventTypeTable::MESSAGE;
+
+    // Decode once here; payload filters, coalescing and parseJson all share the result.
+    // parallelDecode: a large payload goes to a worker instead, and anything after it waits
+    const bool decode = !event.paths && needs_json(type);
+    if (_decode_min_bytes > 0 && (!_decoding.empty() || (decode && event.data.size() >= _decode_min_bytes)) &&
+        defer_event(event, type, decode, ascii, terminal, sent_at)) {
+        return;
+    }
+    std::optional<JsonDocument> json;
+    if (decode) {
+        json.emplace();
+        if (!decode_json(event.data, *json)) {
+            json.reset();
+        }
+    }
+    finish_event(std::move(event), type, std::move(json), ascii, terminal, sent_at, _chunk_received_at, _chunk_received_wall);
+}
+
+void HybridNitroEventSource::finish_event(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json, bool ascii,
+                                          bool terminal, std::optional<double> sent_at, TransferEngine::Clock::time_point received_at,
+                                          std::chrono::system_clock::time_point received_wall) noexcept {
+    if (!accepts_payload(event, json ? &json->root : nullptr)) {
+        _dropped_events.fetch_add(1, std::memory_order_relaxed);
+    } else if (!closed()) {
+        if (_options && _options->latencyTracing) {
+            trace_latency(sent_at, json ? &json->root : nullptr, received_at, received_wall);
+        }
+        if (!_transformers.empty() && !transform_event(0, event, type, json, ascii)) {
+            // Dropped by a transformer
+        } else if (!terminal && json && _columnar && _columnar->decodes(type) && append_row(type, json->root, event.id)) {
+            // A row now, the event itself is not needed any more
+        } else if (!terminal && samples_type(type) && _sampler->has_reservoir()) {
+            hold_sample(std::move(event), type, std::move(json), ascii);
+        } else {
+            dispatch_event(std::move(event), type, std::move(json), ascii);
+        }
+    }
+    if (terminal) {
+        end_stream();
+    }
+}
+
+class HybridNitroEventSource::TransformerSink final : public EventTransformer::Sink {
+public:
+    TransformerSink(HybridNitroEventSource& stream, size_t next) noexcept : _stream(stream), _next(next) {}
+
+    void emit(NitroEventSourceEvent event) noexcept override {
+        _stream.dispatch_transformed(_next, std::move(event));
+    }
+
+private:
+    HybridNitroEventSource& _stream;
+    const size_t _next;
+};
+
+bool HybridNitroEventSource::transform_event(size_t first, NitroEventSourceEvent& event, EventTypeTable::Id& type,
+                                             std::optional<JsonDocument>& json, bool& ascii) noexcept {
+    _transformed_since_flush = true;
+    for (size_t i = first; i < _transformers.size(); ++i) {
+        TransformerSink sink(*this, i + 1);
+        EventTransformer::Result result = EventTransformer::Result::DROP;
+        try {
+            result = _transformers[i]->transform(event, json ? &json->root : nullptr, sink);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Transformer failed, dropping the event: " + std::string(e.what()));
+        }
+        if (result == EventTransformer::Result::DROP) {
+            _dropped_events.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (result == EventTransformer::Result::REWRITTEN) {
+            type = _event_types.find(event.type);
+            ascii = sse_scan::find_non_ascii(event.data) == std::string_view::npos;
+            json.reset();
+            if (!event.paths && needs_json(type)) {
+                json.emplace();
+                if (!decode_json(event.data, *json)) {
+                    json.reset();
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void HybridNitroEventSource::dispatch_transformed(size_t first, NitroEventSourceEvent event) noexcept {
+    if (closed()) {
+        return;
+    }
+    if (!event.receivedAt) {
+        event.receivedAt = epoch_ms(std::chrono::system_clock::now());
+    }
+    EventTypeTable::Id type = _event_types.find(event.type);
+    bool ascii = sse_scan::find_non_ascii(event.data) == std::string_view::npos;
+    std::optional<JsonDocument> json;
+    if (!event.paths && needs_json(type)) {
+        json.emplace();
+        if (!decode_json(event.data, *json)) {
+            json.reset();
+        }
+    }
+    if (transform_event(first, event, type, json, ascii)) {
+        dispatch_event(std::move(event), type, std::move(json), ascii);
+    }
+}
+
+void HybridNitroEventSource::flush_transformers() noexcept {
+    if (!_transformed_since_flush) {
+        return;
+    }
+    for (size_t i = 0; i < _transformers.size(); ++i) {
+        TransformerSink sink(*this, i + 1);
+        try {
+            _transformers[i]->flush(sink);
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Transformer failed to flush: " + std::string(e.what()));
+        }
+    }
+    // What the flush emitted went through the later ones, which are flushed after it
+    _transformed_since_flush = false;
+}
+
+bool HybridNitroEventSource::defer_event(NitroEventSourceEvent& event, EventTypeTable::Id type, bool decode, bool ascii, bool terminal,
+                                         std::optional<double> sent_at) noexcept {
+    std::shared_ptr<DecodeSlot> slot;
+    try {
+        slot = std::make_shared<DecodeSlot>();
+        _decoding.push_back(slot);
+    } catch (const std::bad_alloc&) {
+        // Nothing queued: the caller goes on with the event inline
+        return false;
+    }
+    slot->type = type;
+    slot->ascii = ascii;
+    slot->terminal = terminal;
+    slot->sent_at = sent_at;
+    slot->received_at = _chunk_received_at;
+    slot->received_wall = _chunk_received_wall;
+    slot->event = std::move(event);
+    slot->charge = MemoryBudget::Charge(_memory, static_cast<int64_t>(sizeof(DecodeSlot) + slot->event.data.capacity()));
+
+    // Small or past maxInFlight: decoded here as before, and still delivered in its turn
+    if (decode && slot->event.data.size() >= _decode_min_bytes && _decode_in_flight < _decode_max_in_flight) {
+        try {
+            const bool submitted = DecodePool::shared().submit([self = shared_cast<HybridNitroEventSource>(), slot]() mutable noexcept {
+                {
+                    const CpuTimeAccount::WorkerScope decoding(self->_cpu_time, CpuTimeAccount::Phase::DECODE);
+                    slot->json.emplace();
+                    if (!parse_json(slot->event.data, *slot->json)) {
+                        slot->json.reset();
+                    }
+                }
+                slot->decoded.store(true, std::memory_order_release);
+                try {
+                    // The stream's last reference goes with the task, never on a worker
+                    TransferEngine::shared().post([self = std::move(self)]() noexcept {
+                        --self->_decode_in_flight;
+                        self->deliver_decoded();
+                    });
+                } catch (const std::exception& e) {
+                    NITRO_ES_LOG_ERROR(TAG, "Failed to hand back decoded event: " + std::string(e.what()));
+                }
+            });
+            if (submitted) {
+                ++_decode_in_flight;
+                return true;
+            }
+        } catch (const std::bad_alloc&) {
+            // Decoded here instead
+        }
+    }
+    if (decode) {
+        slot->json.emplace();
+        if (!decode_json(slot->event.data, *slot->json)) {
+            slot->json.reset();
+        }
+    }
+    slot->decoded.store(true, std::memory_order_relaxed);
+    deliver_decoded();
+    return true;
+}
+
+void HybridNitroEventSource::queue_behind_decodes(NitroEventSourceEvent& event, EventTypeTable::Id type, std::optional<JsonDocument>& json,
+                                                  bool ascii) noexcept {
+    try {
+        auto slot = std::make_shared<DecodeSlot>();
+        _decoding.push_back(slot);
+        slot->event = std::move(event);
+        slot->type = type;
+        slot->json = std::move(json);
+        slot->ascii = ascii;
+        slot->dispatch_only = true;
+        slot->decoded.store(true, std::memory_order_relaxed);
+    } catch (const std::bad_alloc&) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to queue event behind decodes, dropping it");
+    }
+}
+
+void HybridNitroEventSource::deliver_decoded() noexcept {
+    // finish_event() dispatches, and dispatch_event() must not queue these behind themselves
+    if (_delivering_decoded) {
+        return;
+    }
+    _delivering_decoded = true;
+    while (!_decoding.empty() && _decoding.front()->decoded.load(std::memory_order_acquire)) {
+        const std::shared_ptr<DecodeSlot> slot = std::move(_decoding.front());
+        _decoding.pop_front();
+        if (slot->dispatch_only) {
+            dispatch_event(std::move(slot->event), slot->type, std::move(slot->json), slot->ascii);
+        } else {
+            finish_event(std::move(slot->event), slot->type, std::move(slot->json), slot->ascii, slot->terminal, slot->sent_at,
+                         slot->received_at, slot->received_wall);
+        }
+    }
+    _delivering_decoded = false;
+}
+
+double HybridNitroEventSource::timestamp_scale_us() const noexcept {
+    return timestamp_unit_us(_options && _options->latencyTracing ? _options->latencyTracing->unit : std::nullopt);
+}
+
+void HybridNitroEventSource::aggregate_event(EventTypeTable::Id type, std::string_view data) noexcept {
+    constexpr double DEFAULT_WINDOW_MS = 1000.0;
+    const AggregationOptions& aggregation = *_options->aggregation;
+
+    try {
+        // The value is a number at the pointer, or all of `data`
+        std::optional<double> number;
+        JsonDocument json;
+        if (decode_json(data, json)) {
+            const JsonValue* value = aggregation.field ? find_pointer(json.root, *aggregation.field) : &json.root;
+            if (const auto* found = value ? std::get_if<double>(&value->value) : nullptr) {
+                number = *found;
+            }
+        }
+        _aggregator->add(type, number);
+        _events_aggregated.fetch_add(1, std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to aggregate event: " + std::string(e.what()));
+        return;
+    }
+
+    // The window opens with its first event, as the tokenStream cadence does
+    if (!_aggregate_timer) {
+        const double window_ms = std::max(1.0, aggregation.windowMs.value_or(DEFAULT_WINDOW_MS));
+        try {
+            _aggregate_timer = TransferEngine::shared().schedule(
+                TransferEngine::Clock::now() + std::chrono::microseconds(static_cast<int64_t>(window_ms * 1000.0)),
+                [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                    self->_aggregate_timer.reset();
+                    self->flush_aggregate();
+                },
+                engine_priority());
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to schedule aggregation window: " + std::string(e.what()));
+            flush_aggregate();
+        }
+    }
+}
+
+void HybridNitroEventSource::flush_aggregate() noexcept {
+    if (_aggregator->empty() || closed()) {
+        return;
+    }
+    // The pooled buffer becomes the next accumulator, as in process_sse_event()
+    NitroEventSourceEvent event = acquire_event();
+    event.id.assign(_last_event_id);
+    event.receivedAt = epoch_ms(std::chrono::system_clock::now());
+    event.type.assign(_event_types.name(_aggregate_type));
+    event.data.clear();
+    try {
+        _aggregator->summarize(_event_types, event.data);
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to summarize aggregation window: " + std::string(e.what()));
+        _aggregator->reset();
+        discard_event(std::move(event));
+        return;
+    }
+    dispatch_event(std::move(event), _aggregate_type);
+}
+
+bool HybridNitroEventSource::samples_type(EventTypeTable::Id type) const noexcept {
+    if (!_sampler) {
+        return false;
+    }
+    return !_sampled_types || (type < _sampled_types->size() && (*_sampled_types)[type]);
+}
+
+void HybridNitroEventSource::hold_sample(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json, bool ascii) noexcept {
+    constexpr double DEFAULT_WINDOW_MS = 1000.0;
+    const std::optional<size_t> slot = _sampler->reservoir_slot();
+    if (!slot) {
+        _sampled_out.fetch_add(1, std::memory_order_relaxed);
+        discard_event(std::move(event));
+        return;
+    }
+
+    try {
+        HeldSample sample{_sample_sequence++, std::move(event), type, std::move(json), ascii};
+        if (*slot < _samples.size()) {
+            _sampled_out.fetch_add(1, std::memory_order_relaxed);
+            discard_event(std::move(_samples[*slot].event));
+            _samples[*slot] = std::move(sample);
+        } else {
+            _samples.push_back(std::move(sample));
+        }
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to hold a sampled event: " + std::string(e.what()));
+        return;
+    }
+
+    // The window opens with its first event and sends its sample when it closes
+    if (!_sample_timer) {
+        const double window_ms = std::max(1.0, _options->sampling->windowMs.value_or(DEFAULT_WINDOW_MS));
+        try {
+            _sample_timer = TransferEngine::shared().schedule(
+                TransferEngine::Clock::now() + std::chrono::microseconds(static_cast<int64_t>(window_ms * 1000.0)),
+                [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                    self->_sample_timer.reset();
+                    self->flush_samples();
+                },
+                engine_priority());
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to schedule sampling window: " + std::string(e.what()));
+            flush_samples();
+        }
+    }
+}
+
+void HybridNitroEventSource::flush_samples() noexcept {
+    std::vector<HeldSample> samples;
+    samples.swap(_samples);
+    _sampler->start_window();
+    // Replacements break arrival order, which JS gets back
+    std::sort(samples.begin(), samples.end(), [](const HeldSample& a, const HeldSample& b) { return a.sequence < b.sequence; });
+    for (HeldSample& sample : samples) {
+        if (closed()) {
+            break;
+        }
+        dispatch_event(std::move(sample.event), sample.type, std::move(sample.json), sample.ascii);
+    }
+}
+
+void HybridNitroEventSource::trace_latency(std::optional<double> sent_at, const JsonValue* json, TransferEngine::Clock::time_point received_at,
+                                           std::chrono::system_clock::time_point received_wall) noexcept {
+    const LatencyTracingOptions& tracing = *_options->latencyTracing;
+    _native_latency.record(TransferEngine::Clock::now() - received_at);
+
+    // The SSE field wins over the payload, a number or a numeric string at the pointer
+    if (!sent_at && tracing.pointer && json) {
+        if (const JsonValue* value = find_pointer(*json, *tracing.pointer)) {
+            if (const auto* number = std::get_if<double>(&value->value)) {
+                sent_at = *number;
+            } else if (const auto* text = std::get_if<JsonValue::String>(&value->value)) {
+                sent_at = parse_timestamp(std::string_view(text->data(), text->size()));
+            }
+        }
+    }
+    if (!sent_at) {
+        return;
+    }
+
+    // Server and device clocks differ, a server ahead of us records as 0
+    const double received_us = std::chrono::duration<double, std::micro>(received_wall.time_since_epoch()).count();
+    const double elapsed_us = received_us - *sent_at * timestamp_scale_us();
+    if (std::isfinite(elapsed_us)) {
+        _server_latency.record(std::chrono::nanoseconds(static_cast<int64_t>(std::clamp(elapsed_us, 0.0, 1e12) * 1000.0)));
+    }
+}
+
+void HybridNitroEventSource::record_heartbeat(std::string_view data) noexcept {
+    constexpr double REPORT_STEP = 0.1;
+    const HeartbeatOptions& options = *_options->heartbeat;
+
+    // The time sent is a number or numeric string at the pointer, or all of `data`
+    std::optional<double> sent_at;
+    if (options.field) {
+        JsonDocument json;
+        if (const JsonValue* value = decode_json(data, json) ? find_pointer(json.root, *options.field) : nullptr) {
+            if (const auto* number = std::get_if<double>(&value->value)) {
+                sent_at = *number;
+            } else if (const auto* text = std::get_if<JsonValue::String>(&value->value)) {
+                sent_at = parse_timestamp(std::string_view(text->data(), text->size()));
+            }
+        }
+    } else {
+        sent_at = parse_timestamp(data);
+    }
+    if (!sent_at) {
+        return;
+    }
+    _heartbeat->record(*sent_at * timestamp_unit_us(options.unit) / 1000.0, epoch_ms(_chunk_received_wall));
+
+    const std::optional<HeartbeatMonitor::Reading> reading = _heartbeat->reading();
+    if (_quality_type == EventTypeTable::NONE || !reading ||
+        (_quality_reported && std::abs(reading->quality - *_quality_reported) < REPORT_STEP)) {
+        return;
+    }
+    _quality_reported = reading->quality;
+    NitroEventSourceEvent event = acquire_event();
+    event.id.assign(_last_event_id);
+    event.receivedAt = epoch_ms(_chunk_received_wall);
+    event.type.assign(_event_types.name(_quality_type));
+    event.data.clear();
+    try {
+        const std::pair<const char*, double> fields[] = {
+            {"{\"quality\":", reading->quality},
+            {",\"delayMs\":", reading->delay_ms},
+            {",\"delayTrendMs\":", reading->trend_ms},
+            {",\"jitterMs\":", reading->jitter_ms},
+            {",\"missed\":", static_cast<double>(_heartbeat->missed())},
+        };
+        for (const auto& [key, value] : fields) {
+            event.data += key;
+            serialize_number(value, event.data);
+        }
+        event.data += '}';
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to report connection quality: " + std::string(e.what()));
+        discard_event(std::move(event));
+        return;
+    }
+    dispatch_event(std::move(event), _quality_type);
+}
+
+void HybridNitroEventSource::append_token(std::string_view data) noexcept {
+    constexpr double DEFAULT_INTERVAL_MS = 50.0;
+    const TokenStreamOptions& tokens = *_options->tokenStream;
+
+    if (data == tokens.doneSentinel.value_or("[DONE]")) {
+        finish_tokens();
+        return;
+    }
+
+    try {
+        std::string_view delta = data;
+        JsonDocument json;
+        if (tokens.field) {
+            // Deltas without text, e.g. the role or finish_reason chunks of a completion, add nothing
+            const JsonValue* value = decode_json(data, json) ? find_pointer(json.root, *tokens.field) : nullptr;
+            const auto* text = value ? std::get_if<JsonValue::String>(&value->value) : nullptr;
+            if (!text) {
+                return;
+            }
+            delta = std::string_view(text->data(), text->size());
+        }
+        _token_pending.append(delta);
+        _token_text.append(delta);
+
+        if (!_token_timer && !_token_pending.empty()) {
+            const auto interval = std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, tokens.intervalMs.value_or(DEFAULT_INTERVAL_MS))));
+            _token_timer = TransferEngine::shared().schedule(
+                TransferEngine::Clock::now() + interval,
+                [self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                    self->_token_timer.reset();
+                    self->flush_tokens();
+                },
+                engine_priority());
+        }
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to collect token: " + std::string(e.what()));
+        flush_tokens();
+    }
+}
+
+void HybridNitroEventSource::flush_tokens() noexcept {
+    if (_token_pending.empty() || closed()) {
+        return;
+    }
+    // The pooled buffer becomes the next accumulator, as in process_sse_event()
+    NitroEventSourceEvent event = acquire_event();
+    event.id.assign(_last_event_id);
+    event.receivedAt = epoch_ms(_chunk_received_wall);
+    event.type.assign(_event_types.name(_token_type));
+    event.data.swap(_token_pending);
+    _token_pending.clear();
+    dispatch_event(std::move(event), _token_type);
+}
+
+void HybridNitroEventSource::finish_tokens() noexcept {
+    if (_token_timer) {
+        TransferEngine::shared().cancel(*_token_timer);
+        _token_timer.reset();
+    }
+    flush_tokens();
+
+    // The whole response once more, then the stream ends
+    NITRO_ES_LOG_INFO(TAG, "Token stream done");
+    dispatch_event(NitroEventSourceEvent(_last_event_id, "done", std::exchange(_token_text, {}), std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt), _done_type);
+    end_stream();
+}
+
+void HybridNitroEventSource::end_stream() noexcept {
+    if (_lifecycle.fetch_or(NO_RETRY, std::memory_order_acq_rel) & NO_RETRY) {
+        return;
+    }
+    // JS closes every EventSource on this error
+    NITRO_ES_LOG_INFO(TAG, "End of stream, not reconnecting");
+    // Ahead of `closed`, which JS closes the EventSource on
+    flush_transformers();
+    set_ready_state(ReadyState::CLOSED);
+    dispatch_event(NitroEventSourceEvent(_last_event_id, "error", "closed", std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt), EventTypeTable::ERROR);
+
+    // A transfer still running is ended from a task, curl may be calling us right now;
+    // on_transfer_done() then releases the connection
+    if (_engine_attached) {
+        try {
+            TransferEngine::shared().post([self = shared_cast<HybridNitroEventSource>()]() noexcept {
+                self->abort_transfer();
+            });
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to end transfer: " + std::string(e.what()));
+        }
+    }
 }
 
-void HybridNitroEventSource::log(std::string_view message) const noexcept {
-    std::cout << "[" << TAG << "] " << message << std::endl;
+bool HybridNitroEventSource::is_terminal_status(long status) const noexcept {
+    // Per the EventSource spec a 204 No Content tells the client to stop reconnecting
+    if (!_options || !_options->endOfStream || !_options->endOfStream->statusCodes) {
+        return status == 204;
+    }
+    const std::vector<double>& codes = *_options->endOfStream->statusCodes;
+    return std::find(codes.begin(), codes.end(), static_cast<double>(status)) != codes.end();
 }
 
 } // namespace margelo::nitro::nitroeventsource
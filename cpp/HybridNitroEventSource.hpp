@@ -1,16 +1,52 @@
 #pragma once
 
+#include "AppLifecycle.hpp"
+#include "BufferingDetector.hpp"
+#include "ConnectionSpec.hpp"
+#include "ColumnarDecoder.hpp"
+#include "CpuTimeAccount.hpp"
+#include "DecodePool.hpp"
+#include "DeviceLoad.hpp"
+#include "DurationHistogram.hpp"
+#include "EndpointSet.hpp"
+#include "EventAggregator.hpp"
+#include "EventBus.hpp"
+#include "EventHostObject.hpp"
+#include "EventJournal.hpp"
+#include "EventSampler.hpp"
+#include "EventTransformer.hpp"
+#include "EventTypeTable.hpp"
+#include "HeartbeatMonitor.hpp"
 #include "HybridNitroEventSourceSpec.hpp"
+#include "JsonValue.hpp"
+#include "LastEventIdStore.hpp"
+#include "MemoryBudget.hpp"
+#include "MessageFramer.hpp"
+#include "NetworkMonitor.hpp"
+#include "ProtoMessage.hpp"
+#include "RecentEvents.hpp"
+#include "RecentIdWindow.hpp"
+#include "RecordFramer.hpp"
+#include "SpscQueue.hpp"
+#include "SseParser.hpp"
+#include "StateSnapshotStore.hpp"
+#include "StreamCapture.hpp"
+#include "StreamMetricsSample.hpp"
+#include "StreamRecycler.hpp"
+#include "TransferEngine.hpp"
+#include "WarmStartCache.hpp"
+#include "ZstdDictionaryDecoder.hpp"
 
 #include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <random>
 #include <string>
 #include <string_view>
-#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -19,44 +55,694 @@ class HybridNitroEventSource : public HybridNitroEventSourceSpec {
 public:
     HybridNitroEventSource() : HybridObject(TAG), HybridNitroEventSourceSpec() {}
     ~HybridNitroEventSource() override;
+
+    double getReadyState() override { return static_cast<double>(_ready_state.load(std::memory_order_acquire)); }
     
+    // Kept for spec consumers; NitroEventSourceFactory creates streams without an instance to call it on
     std::shared_ptr<HybridNitroEventSourceSpec> create(const std::string& url, const std::optional<NitroEventSourceOptions>& options) override;
+    void start() override;
     void close() override;
+    std::shared_ptr<Promise<void>> closeAsync() override;
     void setEventCallback(const std::function<void(const NitroEventSourceEvent& /* event */)>& callback) override;
-    void addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) override;
-    void removeEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) override;
-    
-    
+    void setBatchCallback(const std::function<void(const std::vector<NitroEventSourceEvent>& /* events */)>& callback) override;
+    void setDrainCallback(const std::function<void()>& callback) override;
+    std::vector<NitroEventSourceEvent> drainEvents(std::optional<double> maxEvents) override;
+    double subscribe(const std::function<void()>& callback) override;
+    void setSubscriptionTypes(double subscriptionId, const std::optional<std::vector<std::string>>& types) override;
+    void setSubscriptionActive(double subscriptionId, bool active) override;
+    std::vector<NitroEventSourceEvent> drainSubscription(double subscriptionId, std::optional<double> maxEvents) override;
+    PackedEvents drainPacked(std::optional<double> maxEvents) override;
+    void unsubscribe(double subscriptionId) override;
+    double addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) override;
+    void removeEventListener(double subscriptionId) override;
+    void setDataCallback(const std::function<void(const std::shared_ptr<ArrayBuffer>& /* chunk */)>& callback) override;
+    void setMessagesCallback(const std::function<void(const std::vector<std::shared_ptr<ArrayBuffer>>& /* messages */)>& callback) override;
+    std::optional<std::shared_ptr<ArrayBuffer>> drainData() override;
+    std::optional<ResponseHead> getResponseHead() override;
+    std::vector<EventColumns> drainColumns() override;
+    std::shared_ptr<AnyMap> decodeMessage(const std::shared_ptr<ArrayBuffer>& message) override;
+    void setTypeFilter(const std::optional<std::vector<std::string>>& types) override;
+    void setPayloadFilters(const std::vector<PayloadFilter>& filters) override;
+    EventSourceMetrics getMetrics() override;
+    std::optional<std::string> getState(const std::string& pointer) override;
+    std::vector<NitroEventSourceEvent> replay(const std::string& fromId) override;
+    std::optional<NitroEventSourceEvent> getWarmEvent(const std::string& type) override;
+    std::vector<NitroEventSourceEvent> getRecentEvents(const std::string& type) override;
+    void reportSlowListener(const std::string& type, const std::string& listener, double durationMs) override;
+    void preconnect(const std::string& url) override;
+    void warmUp() override;
+    void setConnectionLimits(double maxConnections, double maxConnectionsPerHost) override;
+    void setMemoryBudget(double maxBufferedBytes) override;
+    void setForeground(bool foreground) override;
+    void updateHeaders(const std::unordered_map<std::string, std::string>& headers) override;
+    void setUnauthorizedCallback(const std::function<void()>& callback) override;
+
+    // What create() and the process-wide methods do, for NitroEventSourceFactory too
+    static std::shared_ptr<HybridNitroEventSource> open(const std::string& url, const std::optional<NitroEventSourceOptions>& options);
+    static void preconnect_origin(const std::string& url) noexcept;
+    static void set_connection_limits(double maxConnections, double maxConnectionsPerHost) noexcept;
+    static void set_memory_budget(double maxBufferedBytes) noexcept;
+    // Closes every live stream and tears them all down in one I/O thread task
+    static std::shared_ptr<Promise<void>> close_all();
+    // Samples every live stream each `interval_ms` (at least 250) until unwatch_metrics() or
+    // another watch; one watch per process, samples go to `callback` on the I/O thread
+    using MetricsCallback = std::function<void(const std::vector<StreamMetricsSample>&)>;
+    static void watch_metrics(double interval_ms, const MetricsCallback& callback);
+    static void unwatch_metrics() noexcept;
+    // getMetrics() of every open stream, for MetricsReporter
+    struct LiveMetrics {
+        uint64_t id;
+        std::string url;
+        EventSourceMetrics metrics;
+    };
+    static std::vector<LiveMetrics> live_metrics();
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // Test engine only, on its I/O thread: the response to the pending connection attempt.
+    // script_open() answers 200 with an event stream; script_chunk() is false while paused for
+    // backpressure or a rate limit, feed it again later; script_close() ends the transfer with
+    // `result` and `status`, 0 for whatever script_open() answered, and the stream reconnects
+    // on TransferEngine timers like it would after a real one
+    bool script_pending() const noexcept { return _script_attempt; }
+    void script_open() noexcept;
+    bool script_chunk(std::string_view bytes) noexcept;
+    void script_close(CURLcode result, long status = 0) noexcept;
+#endif
+
+protected:
+    void loadHybridMethods() override;
+
 public:
-    // Cleanup state
-    std::atomic<bool> _closed{false};
+    // Cleanup state: close() and a finished token stream set bits in one word, so the
+    // write callback checks both with a single acquire load per chunk
+    enum LifecycleFlags : uint8_t { CLOSED = 1 << 0, NO_RETRY = 1 << 1 };
+    std::atomic<uint8_t> _lifecycle{0};
     std::atomic<bool> _open_event_sent{false};
-    std::atomic<bool> _running{true};
+    // The first body chunk of a response opens the stream, once per connection
+    void open_response() noexcept;
+    bool closed(std::memory_order order = std::memory_order_acquire) const noexcept { return _lifecycle.load(order) & CLOSED; }
+    // Neither closed nor done, closing always sets NO_RETRY as well
+    bool should_retry(std::memory_order order = std::memory_order_acquire) const noexcept { return !(_lifecycle.load(order) & NO_RETRY); }
+    // Same values as the JS EventSourceReadyState, written by the TransferEngine I/O thread and close()
+    enum class ReadyState : uint8_t { CONNECTING = 0, OPEN = 1, CLOSED = 2 };
+    std::atomic<ReadyState> _ready_state{ReadyState::CONNECTING};
+    void set_ready_state(ReadyState state) noexcept;
 
-    // SSE parsing
-    std::string _buffer, _event_type, _event_data, _last_event_id;
-    std::mutex _buffer_mutex;
+    // timeouts.idleMs: when the last body byte arrived, owned by the TransferEngine I/O thread;
+    // a timer checks it once per idle period instead of curl polling a progress callback
+    TransferEngine::Clock::time_point _last_received{};
+    // reconnect.byReason: when the current transfer opened, which tells a routine clean
+    // close from a server that hangs up as soon as it answers
+    TransferEngine::Clock::time_point _opened_at{};
+    bool _idle_timed_out = false;
+    std::optional<TransferEngine::Timer> _idle_timer;
+    bool check_idle() noexcept;
+    void arm_idle_timer() noexcept;
+    void cancel_idle_timer() noexcept;
+    // timeouts.stallMs: a fresh connection opened while the stream is silent, switched to once it gets through.
+    // A hedge answers for the silence that started at `_hedged_silence`, later ones bump the generation
+    std::optional<TransferEngine::Timer> _stall_timer;
+    std::optional<TransferEngine::Clock::time_point> _hedged_silence;
+    uint64_t _hedge_generation = 0;
+    bool _stall_switch = false;
+    void arm_stall_timer(TransferEngine::Clock::time_point from) noexcept;
+    void check_stall() noexcept;
+    void on_hedge_done(uint64_t generation, CURLcode result) noexcept;
+    // Ends the running transfer like a curl abort and runs on_transfer_done(); not from within a curl callback
+    void abort_transfer() noexcept;
+    TransferEngine::Priority engine_priority() const noexcept;
+    bool defer_write() noexcept;
+    // DNS, connect, TLS and first-byte times of the attempt that just opened, for metrics and the open event
+    std::optional<ConnectionTiming> record_connection_timing() noexcept;
+    // redirectCache: where the attempt that just opened was redirected to, for the next ones to connect to directly
+    void remember_redirect() noexcept;
+    // standby: preconnects the standby URL now and again every keep-warm period while the stream runs
+    void keep_standby_warm() noexcept;
+    // Gives the reconnect gate back its slot, `warmed` when the connection opened
+    void finish_reconnect(bool warmed) noexcept;
+
+    // SSE parsing: framing in _parser, field and event semantics here. The parser, the filters
+    // and the id window belong to the TransferEngine I/O thread; setters and close() post to it
+    struct ParserSink {
+        HybridNitroEventSource* self;
+        void on_field(SseField field, std::string_view name, std::string_view value) noexcept { self->process_sse_field(field, name, value); }
+        void on_comment() noexcept { self->process_sse_comment(); }
+        void on_event(std::string& data, bool dropped, bool ascii) noexcept { self->process_sse_event(data, dropped, ascii); }
+        bool on_data_chunk(std::string& data, SseChunk position) noexcept { return self->emit_data_chunk(data, position); }
+    };
+    SseParser<ParserSink> _parser{ParserSink{this}};
+    // format ndjson / json-seq: records framed here instead, each one a `message` event
+    struct FramerSink {
+        HybridNitroEventSource* self;
+        void on_record(std::string_view record, bool oversized) noexcept { self->process_record(record, oversized); }
+    };
+    std::optional<RecordFramer<FramerSink>> _framer;
+    std::string _record_data;
+    std::string _event_type, _last_event_id;
+    bool _event_has_id = false;
+    // Ids already delivered, kept across reconnects so server replays are dropped
+    RecentIdWindow _seen_ids;
+    // resumeKey: _last_event_id as of the previous process, kept up to date on disk
+    std::unique_ptr<LastEventIdStore> _id_store;
+    // Set at create and synchronised internally, replayed from the JS thread
+    std::unique_ptr<EventJournal> _journal;
+    std::unique_ptr<WarmStartCache> _warm_cache;
+    // recentEvents: filled on the I/O thread, read by late listeners on the JS thread
+    std::unique_ptr<RecentEvents> _recent_events;
+    // capture: the response chunks write_callback receives, recorded on the TransferEngine I/O thread
+    std::unique_ptr<CaptureWriter> _capture;
+    // replay: a capture fed to the parser in place of a connection, and the chunk waiting for its time
+    std::unique_ptr<CaptureReader> _replay;
+    std::string _replay_chunk;
+    bool _replay_pending = false;
+    TransferEngine::Clock::time_point _replay_started{};
+    TransferEngine::Clock::time_point _replay_due{};
+    std::optional<TransferEngine::Timer> _replay_timer;
+    void start_replay() noexcept;
+    void replay_next() noexcept;
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // A connect() waiting for the script, and the status it answered with
+    bool _script_attempt = false;
+    long _script_status = 0;
+#endif
+    EventTypeTable _event_types;
+    EventTypeTable::Id _event_type_id = EventTypeTable::MESSAGE;
+    // Per type id: whether anyone wants the event, unset delivers everything
+    std::optional<std::vector<bool>> _type_filter;
+    // Every filter must match for an event to be delivered
+    std::vector<PayloadFilter> _payload_filters;
+    // stateSync: interned at create, NONE when the stream does not sync state
+    EventTypeTable::Id _snapshot_type = EventTypeTable::NONE;
+    EventTypeTable::Id _patch_type = EventTypeTable::NONE;
+    // tokenStream: deltas of _token_type collect in _token_pending until the cadence timer
+    // sends them, _token_text is the whole response for the final `done` event
+    EventTypeTable::Id _token_type = EventTypeTable::NONE;
+    EventTypeTable::Id _done_type = EventTypeTable::NONE;
+    std::string _token_pending;
+    std::string _token_text;
+    std::optional<TransferEngine::Timer> _token_timer;
+    // aggregation: events of _aggregated_types add to the window, which _aggregate_timer closes
+    // with one _aggregate_type event
+    std::optional<EventAggregator> _aggregator;
+    std::vector<bool> _aggregated_types;
+    EventTypeTable::Id _aggregate_type = EventTypeTable::NONE;
+    std::optional<TransferEngine::Timer> _aggregate_timer;
+    std::atomic<uint64_t> _events_aggregated{0};
+    // schemas: events of these types become rows of their type's columns, taken by drainColumns()
+    std::optional<ColumnarDecoder> _columnar;
+    bool append_row(EventTypeTable::Id type, const JsonValue& root, std::string_view id) noexcept;
+    void aggregate_event(EventTypeTable::Id type, std::string_view data) noexcept;
+    void flush_aggregate() noexcept;
+    // sampling: types it applies to, unset for every type; a reservoir's events wait in _samples
+    // until _sample_timer closes their window
+    std::optional<EventSampler> _sampler;
+    std::optional<std::vector<bool>> _sampled_types;
+    struct HeldSample {
+        uint64_t sequence;
+        NitroEventSourceEvent event;
+        EventTypeTable::Id type;
+        std::optional<JsonDocument> json;
+        bool ascii;
+    };
+    std::vector<HeldSample> _samples;
+    uint64_t _sample_sequence = 0;
+    std::optional<TransferEngine::Timer> _sample_timer;
+    std::atomic<uint64_t> _sampled_out{0};
+    bool samples_type(EventTypeTable::Id type) const noexcept;
+    void hold_sample(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json, bool ascii) noexcept;
+    void flush_samples() noexcept;
+    // transformers: the stream's instances of the named native transformers, in order, run on the
+    // TransferEngine I/O thread; see EventTransformer.hpp
+    class TransformerSink;
+    std::vector<std::unique_ptr<EventTransformer>> _transformers;
+    // Runs `event` through the transformers from `first` on, false when one of them dropped it
+    bool transform_event(size_t first, NitroEventSourceEvent& event, EventTypeTable::Id& type, std::optional<JsonDocument>& json,
+                         bool& ascii) noexcept;
+    // An event transformer `first - 1` emitted: through the rest of them, then dispatched
+    void dispatch_transformed(size_t first, NitroEventSourceEvent event) noexcept;
+    // At the end of a transfer or the stream, once per run of events
+    void flush_transformers() noexcept;
+    bool _transformed_since_flush = false;
+    // endOfStream: a terminal event type, interned at create
+    EventTypeTable::Id _end_type = EventTypeTable::NONE;
 
     void parse_sse_chunk(std::string_view chunk) noexcept;
-    void dispatch_event(const NitroEventSourceEvent& event) noexcept;
+    // `ascii`: `data` is known to be ASCII only, so JS strings are created from it without decoding
+    void dispatch_event(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json = std::nullopt,
+                        bool ascii = false) noexcept;
+    void dispatch_chunk(std::string_view chunk) noexcept;
+    // rawFraming: messages split in place, collected back to back until dispatch_messages() sends them in one call
+    struct MessageBatchSink {
+        HybridNitroEventSource* self;
+        void on_message(std::string_view message, bool oversized) noexcept { self->collect_message(message, oversized); }
+    };
+    std::optional<MessageFramer<MessageBatchSink>> _message_framer;
+    std::vector<uint8_t> _message_bytes;
+    std::vector<size_t> _message_ends;
+    void collect_message(std::string_view message, bool oversized) noexcept;
+    void dispatch_messages() noexcept;
+    // transport websocket: a message fragmented across frames or callbacks, up to maxEventBytes
+    std::string _ws_message;
+    bool _ws_oversized = false;
+    void receive_ws_frame(std::string_view bytes) noexcept;
+    void deliver_ws_message(std::string_view message, bool oversized, bool binary) noexcept;
+    // bufferingDetection: fed per parsed read; the fallback is taken once per stream
+    std::optional<BufferingDetector> _buffering;
+    // heartbeat: restarts with each connection like _buffering
+    std::optional<HeartbeatMonitor> _heartbeat;
+    bool _buffering_fallen_back = false;
+    // fallback 'websocket' taken: the transport the options asked for no longer applies
+    bool _websocket_fallback = false;
+    // For getMetrics(), as of the current connection and over all of them
+    std::atomic<bool> _proxy_buffering{false};
+    std::atomic<uint64_t> _buffered_bursts{0};
+    // The memory budget: this stream's account, which queued events and the parser buffers charge
+    const std::shared_ptr<MemoryBudget::Account> _memory = std::make_shared<MemoryBudget::Account>();
+    MemoryBudget::Charge _parser_memory{_memory, 0};
+    void detect_buffering(TransferEngine::Clock::time_point at, uint64_t events) noexcept;
+    void fall_back_from_buffering() noexcept;
+    // messageSchema, indexed at create and shared with every message decoded through it
+    std::shared_ptr<const ProtoSchema> _message_schema;
+    bool receive_body(std::string_view bytes) noexcept;
+    bool receive_header(std::string_view header) noexcept;
+    // fetchMode reads the body raw as well, only queued for drainData() rather than called back
+    bool raw_mode() const noexcept { return _options && (_options->rawMode.value_or(false) || fetch_mode()); }
+    bool fetch_mode() const noexcept { return _options && _options->fetchMode.value_or(false); }
+    bool websocket() const noexcept { return _websocket_fallback || (_options && _options->transport == StreamTransport::WEBSOCKET); }
+    StreamFormat stream_format() const noexcept { return _options ? _options->format.value_or(StreamFormat::SSE) : StreamFormat::SSE; }
+    // The framer a format other than SSE needs, none for SSE
+    std::optional<RecordFormat> record_format() const noexcept;
+    bool pause_for_backpressure() noexcept;
+    bool pause_for_rate_limit() noexcept;
     
 private:
+    struct QueuedEvent {
+        NitroEventSourceEvent event;
+        EventTypeTable::Id type = EventTypeTable::NONE;
+        // Set when `data` is valid JSON and parseJson or a payload filter decoded it
+        std::optional<JsonDocument> json;
+        bool ascii = false;
+        // `data` as UTF-16 for Hermes, see publish_event()
+        std::optional<std::u16string> utf16{};
+        // Dispatch latency runs from here to the drain or callback that hands the event to JS
+        TransferEngine::Clock::time_point dispatched_at = TransferEngine::Clock::now();
+        // Against the memory budget from when it is queued until it is handed to JS or dropped
+        MemoryBudget::Charge charge{};
+    };
+
+    bool mark_closed() noexcept;
+    void detach(const std::shared_ptr<Promise<void>>& promise);
+    // I/O thread: releases the connection, timers and buffers of a closed stream
+    void teardown() noexcept;
+    void enqueue_event(QueuedEvent event) noexcept;
+    void flush_events() noexcept;
+    std::optional<std::string> coalesce_key(const QueuedEvent& event) const;
+    std::vector<QueuedEvent> drain_queue(size_t max_events = SIZE_MAX);
+    // drainPacked() index, per event: offsets of its id and data, its type's index, and 1 + its detail's, 0 for none
+    static constexpr size_t PACKED_INDEX_STRIDE = 4;
+    jsi::Value drain_events_to_jsi(jsi::Runtime& runtime, const jsi::Value& this_value, const jsi::Value* args, size_t count);
+    jsi::Value drain_subscription_to_jsi(jsi::Runtime& runtime, const jsi::Value& this_value, const jsi::Value* args, size_t count);
+    // What a drain converts for JS, from the stream's queue or a subscriber's
+    struct EventView {
+        const NitroEventSourceEvent* event;
+        const JsonDocument* json;
+        bool ascii;
+        const std::u16string* utf16;
+    };
+    jsi::Value events_to_jsi(jsi::Runtime& runtime, const std::vector<EventView>& events);
+    // JS thread, on the first drain: whether the engine draining takes UTF-16 strings as they are
+    void detect_engine(jsi::Runtime& runtime);
+    bool _engine_detected = false;
+    std::atomic<bool> _utf16_payloads{false};
+    // utf16MinBytes, 0 when off
+    size_t _utf16_min_bytes = jsi_utils::UTF16_MIN_BYTES;
+    // Subscribers of a shared stream: each event is queued once, for every subscriber taking its type
+    struct SharedEvent : EventPayload {
+        EventTypeTable::Id type = EventTypeTable::NONE;
+        TransferEngine::Clock::time_point dispatched_at;
+        MemoryBudget::Charge charge{};
+    };
+    EventBus<const SharedEvent> _bus;
+    void publish_to_bus(QueuedEvent queued);
+    std::vector<std::shared_ptr<const SharedEvent>> drain_subscription(uint64_t id, size_t max_events);
+    jsi::Value decode_message_to_jsi(jsi::Runtime& runtime, const jsi::Value& this_value, const jsi::Value* args, size_t count);
+    void publish_event(QueuedEvent event) noexcept;
+    NitroEventSourceEvent acquire_event() noexcept;
+    void recycle_event(NitroEventSourceEvent event) noexcept;
+    void discard_event(NitroEventSourceEvent event) noexcept;
+    void overflow_event(QueuedEvent event);
+    void refill_queue() noexcept;
+    size_t max_queued_events() const noexcept;
+    // maxQueuedEvents, maxQueuedBytes or the memory budget reached: new events are held back
+    bool queue_full() noexcept;
+    bool should_pause_transfer() noexcept;
+    OverflowPolicy overflow_policy() const noexcept;
+    void notify_drain() noexcept;
+    void notify_callback(const NitroEventSourceEvent& event) noexcept;
+    void notify_listeners(const NitroEventSourceEvent& event, EventTypeTable::Id type) noexcept;
+    std::shared_ptr<const std::vector<std::vector<std::function<void(const NitroEventSourceEvent&)>>>> listeners_snapshot() noexcept;
     void connect() noexcept;
+    bool init_connection() noexcept;
     bool attempt_connection() noexcept;
-    void process_sse_event() noexcept;
-    void log(std::string_view message) const noexcept;
+    void on_transfer_done(CURLcode result) noexcept;
+    void schedule_reconnect(std::chrono::milliseconds delay, bool align = true) noexcept;
+    void arm_reconnect(TransferEngine::Clock::time_point deadline) noexcept;
+    TransferEngine::Clock::time_point background_aligned(TransferEngine::Clock::time_point due) const noexcept;
+    void on_network_change(bool online, bool interface_changed) noexcept;
+    void on_app_state(bool foreground) noexcept;
+    // underLoad: whether the device's load reaches the policy's level
+    bool loaded_for(DeviceLoad::Level level) const noexcept;
+    void on_device_load(DeviceLoad::Level level) noexcept;
+    void suspend(BackgroundPolicy policy) noexcept;
+    BackgroundPolicy background_policy() const noexcept;
+    bool network_aware() const noexcept { return !_options || _options->networkAware.value_or(true); }
+    // reconnect.byReason: why the last transfer ended picks its base delay
+    enum class CloseReason : uint8_t { CLEAN, RESET, TIMEOUT, HTTP_ERROR, OTHER };
+    CloseReason classify_close(CURLcode result, long status, const std::optional<StreamError>& error) const noexcept;
+    std::chrono::milliseconds next_reconnect_delay(CloseReason reason = CloseReason::OTHER) noexcept;
+    std::optional<std::chrono::milliseconds> trip_breaker(CURLcode result) noexcept;
+    void cancel_standby() noexcept;
+    const std::string& stream_url() const noexcept;
+    // stream_url(), or the redirect it is cached to, with the ws(s) scheme for the WebSocket transport
+    std::string request_url() const;
+    size_t standby_endpoint() const noexcept;
+    void release_connection() noexcept;
+    void build_request_headers() noexcept;
+    void free_last_event_id_header() noexcept;
+    void free_state_version_header() noexcept;
+    void free_request_headers() noexcept;
+    SseLimits parser_limits() const noexcept;
+    // maxIdBytes, what LastEventIdStore persists by default
+    size_t max_id_bytes() const noexcept;
+    // `id:` fields with NUL or over maxIdBytes, left out of the id
+    std::atomic<uint64_t> _ids_ignored{0};
+    // listenerBudget: listener calls JS reported over budget, and the slowest as "type: name" with its time
+    std::atomic<uint64_t> _slow_listener_calls{0};
+    std::mutex _slow_listener_mutex;
+    std::optional<std::pair<std::string, double>> _slowest_listener;
+    // cpuAccounting; parse_json charged to the decode phase, for I/O thread callers
+    mutable CpuTimeAccount _cpu_time;
+    bool decode_json(std::string_view data, JsonDocument& out) const noexcept;
+    bool emit_data_chunk(std::string& data, SseChunk position) noexcept;
+    void process_sse_field(SseField field, std::string_view name, std::string_view value) noexcept;
+    void process_sse_comment() noexcept;
+    void process_sse_event(std::string& data, bool oversized, bool ascii) noexcept;
+    // The part of process_sse_event() after decoding, run again for each event a worker decoded
+    void finish_event(NitroEventSourceEvent event, EventTypeTable::Id type, std::optional<JsonDocument> json, bool ascii, bool terminal,
+                      std::optional<double> sent_at, TransferEngine::Clock::time_point received_at,
+                      std::chrono::system_clock::time_point received_wall) noexcept;
+    // parallelDecode: events behind or in a DecodePool worker, delivered by the I/O thread in
+    // arrival order as the front of the line is decoded. Everything dispatched meanwhile waits
+    // its turn too, so an `error` or `open` never overtakes the events before it
+    struct DecodeSlot {
+        NitroEventSourceEvent event;
+        EventTypeTable::Id type = EventTypeTable::NONE;
+        std::optional<JsonDocument> json;
+        bool ascii = false;
+        bool terminal = false;
+        // Queued by dispatch_event(), decoded already or not at all
+        bool dispatch_only = false;
+        std::optional<double> sent_at;
+        TransferEngine::Clock::time_point received_at{};
+        std::chrono::system_clock::time_point received_wall{};
+        MemoryBudget::Charge charge{};
+        // Written by the worker, so json is the I/O thread's once this reads true
+        std::atomic<bool> decoded{false};
+    };
+    // 0 while parallelDecode is off
+    size_t _decode_min_bytes = 0;
+    size_t _decode_max_in_flight = 0;
+    std::deque<std::shared_ptr<DecodeSlot>> _decoding;
+    size_t _decode_in_flight = 0;
+    bool _delivering_decoded = false;
+    bool defer_event(NitroEventSourceEvent& event, EventTypeTable::Id type, bool decode, bool ascii, bool terminal,
+                     std::optional<double> sent_at) noexcept;
+    void queue_behind_decodes(NitroEventSourceEvent& event, EventTypeTable::Id type, std::optional<JsonDocument>& json, bool ascii) noexcept;
+    void deliver_decoded() noexcept;
+    void process_record(std::string_view record, bool oversized) noexcept;
+    void apply_type_filter(const std::optional<std::vector<std::string>>& types);
+    std::optional<std::vector<bool>> build_type_filter(const std::optional<std::vector<std::string>>& types);
+    bool accepts_type(EventTypeTable::Id type) const noexcept;
+    bool is_duplicate_id(std::string_view id) noexcept;
+    bool needs_json(EventTypeTable::Id type) const noexcept;
+    bool accepts_payload(const NitroEventSourceEvent& event, const JsonValue* json) const noexcept;
+    bool is_state_event(EventTypeTable::Id type) const noexcept;
+    std::optional<std::vector<std::string>> apply_state_event(EventTypeTable::Id type, std::string_view data) noexcept;
+    void append_token(std::string_view data) noexcept;
+    void flush_tokens() noexcept;
+    void finish_tokens() noexcept;
+    void end_stream() noexcept;
+    bool is_terminal_status(long status) const noexcept;
     
-    std::string _url;
-    std::thread _curl_thread;
+    // url and options as converted at create, immutable from then on
+    std::shared_ptr<const ConnectionSpec> _spec;
+    // JS thread: whether the stream's state belongs to the I/O thread, with lazyStart from start() on
+    bool _engine_attached = false;
+    // Numbers streams in open order, for metrics samples to tell them apart
+    uint64_t _stream_id = 0;
+
+    // watchMetrics: the totals of this stream's previous sample, owned by the TransferEngine I/O thread
+    static void sample_metrics(uint64_t generation) noexcept;
+    StreamMetricsSample metrics_sample(TransferEngine::Clock::time_point now);
+    std::optional<TransferEngine::Clock::time_point> _metrics_sampled_at;
+    uint64_t _sampled_events = 0;
+    uint64_t _sampled_bytes = 0;
+
+    // Long-lived easy handle reused across reconnects, owned by the TransferEngine I/O thread
+    CURL* _curl = nullptr;
+    // After updateHeaders() or a switch to WebSocket: the block sent instead of the spec's,
+    // built with the handle and again after the next updateHeaders()
+    curl_slist* _headers = nullptr;
+    // updateHeaders(): replaces options.headers, owned by the TransferEngine I/O thread like the flags below
+    std::optional<std::unordered_map<std::string, std::string>> _header_override;
+    bool _headers_stale = false;
+    // A 401 went to the unauthorized callback, the next updateHeaders() reconnects at once;
+    // only one per run of failures, a second 401 in a row is final
+    bool _awaiting_credentials = false;
+    bool _credentials_refreshed = false;
+    // `Last-Event-ID: <id>` of the latest attempt, its `next` points into _headers
+    curl_slist* _last_event_id_header = nullptr;
+    // stateSync.versionHeader, linked in front of the Last-Event-ID node the same way
+    curl_slist* _state_version_header = nullptr;
+    // dns.resolve, curl reads it for as long as the handle lives
+    curl_slist* _resolve = nullptr;
+    // socket.receiveBufferBytes, read by curl_utils::sockopt_callback for every new socket
+    int _receive_buffer_bytes = 0;
+
+    // zstdDictionary: the body is decoded here instead of by curl, owned by the TransferEngine I/O thread
+    std::unique_ptr<ZstdDictionaryDecoder> _decoder;
+    bool _decode_body = false;
+    std::string _decoded;
+
+    // The response being received, checked before any of its body is parsed; reset by every status line
+    long _response_status = 0;
+    std::string _response_content_type;
+    bool _rejected_content_type = false;
+    // fetchMode: the headers so far, published for getResponseHead() with the blank line ending them
+    std::unordered_map<std::string, std::string> _response_headers;
+    std::mutex _response_head_mutex;
+    std::optional<ResponseHead> _response_head;
+    void collect_response_header(std::string_view header) noexcept;
+    bool accepts_response() noexcept;
+    std::optional<StreamError> describe_failure(CURLcode result, long status) const;
+
+    // Reconnect backoff, owned by the TransferEngine I/O thread
+    int _server_retry_ms = 0;
+    uint32_t _reconnect_attempts = 0;
+    std::minstd_rand _backoff_rng{std::random_device{}()};
+    std::optional<TransferEngine::Timer> _reconnect_timer;
+    // When the reconnect would have run had background alignment not pushed it later
+    TransferEngine::Clock::time_point _reconnect_due{};
+    // circuitBreaker: attempts in a row that failed before opening, and how often it opened since
+    uint32_t _breaker_failures = 0;
+    uint32_t _breaker_trips = 0;
+    // networkAware: set while a reconnect is held back until the device is online again
+    bool _waiting_for_network = false;
+    // The network-return reconnect's ticket with the engine's gate, until the attempt opens or fails
+    std::optional<uint64_t> _reconnect_ticket;
+    bool _reconnect_queued = false;
+    // The stream's URL, `endpoints` and the standby URL, with the one in use; connect() picks
+    // the best of them unless a failover already chose its target
+    EndpointSet _endpoints;
+    size_t _endpoint = 0;
+    size_t _failover_endpoint = EndpointSet::NONE;
+    // What CURLOPT_URL holds on _curl; another endpoint or a cached redirect changes it
+    std::string _handle_url;
+    // redirectCache: whether every redirect of the attempt so far was permanent (301, 308) and
+    // kept the method and body (307, 308); reset per attempt
+    bool _redirects_permanent = true;
+    bool _redirects_keep_method = true;
+    // A cached redirect to another origin: the block leaves out the Authorization and Cookie
+    // headers, which curl would not have followed the redirect there with
+    bool _headers_cross_origin = false;
+    // standby: re-warms the standby connection while the stream is open. Failovers skip the
+    // backoff at most once per keep-warm period, so a flapping server still backs off
+    std::optional<TransferEngine::Timer> _standby_timer;
+    std::optional<TransferEngine::Clock::time_point> _last_failover;
+    // background: the grace timer runs while backgrounded, a suspended stream reconnects on foreground
+    std::optional<TransferEngine::Timer> _background_timer;
+    bool _suspended = false;
+    // Subscribed at create, dropped by mark_closed()
+    uint64_t _network_subscription = 0;
+    uint64_t _lifecycle_subscription = 0;
+    uint64_t _load_subscription = 0;
+    // lazyStart: set at create until start() begins connecting, on the JS thread
+    std::atomic<bool> _start_pending{false};
+    // Retains the stream's priority with the engine and posts the first connect()
+    void start_connecting();
+    // priority: counted towards the I/O thread's QoS from start until mark_closed()
+    std::optional<TransferEngine::Priority> _retained_priority;
+    bool _retained_efficiency = false;
+
+    using EventCallback = std::function<void(const NitroEventSourceEvent&)>;
+    using BatchCallback = std::function<void(const std::vector<NitroEventSourceEvent>&)>;
+    using DrainCallback = std::function<void()>;
+    using DataCallback = std::function<void(const std::shared_ptr<ArrayBuffer>&)>;
+    using MessagesCallback = std::function<void(const std::vector<std::shared_ptr<ArrayBuffer>>&)>;
+    using UnauthorizedCallback = std::function<void()>;
+
+    // Callbacks are immutable snapshots: the mutex only guards swapping the pointer,
+    // so a slow handler never blocks setEventCallback() or close()
+    template <typename Callback>
+    std::shared_ptr<const Callback> load_callback(const std::shared_ptr<const Callback>& slot) noexcept {
+        const std::lock_guard<std::mutex> lock(_callback_mutex);
+        return slot;
+    }
+    template <typename Callback>
+    void store_callback(std::shared_ptr<const Callback>& slot, const Callback& callback) {
+        auto snapshot = callback ? std::make_shared<const Callback>(callback) : nullptr;
+        const std::lock_guard<std::mutex> lock(_callback_mutex);
+        slot.swap(snapshot);
+    }
+
     std::mutex _callback_mutex;
-    std::optional<NitroEventSourceOptions> _options;
-    std::function<void(const NitroEventSourceEvent&)> _event_callback;
+    // Into _spec, null without options
+    std::shared_ptr<const NitroEventSourceOptions> _options;
+    std::shared_ptr<const EventCallback> _event_callback;
+    std::shared_ptr<const BatchCallback> _batch_callback;
+    std::shared_ptr<const DataCallback> _data_callback;
+    std::shared_ptr<const MessagesCallback> _messages_callback;
+    std::shared_ptr<const UnauthorizedCallback> _unauthorized_callback;
+
+    // Queued delivery: the I/O thread produces, the JS thread drains
+    SpscQueue<QueuedEvent> _event_queue;
+    // priorityTypes: their own lane, drained ahead of _event_queue; _bus subscribers have one each
+    SpscQueue<QueuedEvent> _priority_queue;
+    std::vector<bool> _priority_types;
+    bool is_priority(EventTypeTable::Id type) const noexcept;
+    std::atomic<bool> _queued_delivery{false};
+    std::atomic<bool> _drain_pending{false};
+    std::shared_ptr<const DrainCallback> _drain_callback;
+    // fetchMode: body bytes waiting for drainData(), appended by the I/O thread and taken
+    // by JS all at once; they count towards maxQueuedBytes and the memory budget
+    std::mutex _raw_mutex;
+    std::vector<uint8_t> _raw_bytes;
+    MemoryBudget::Charge _raw_memory{_memory, 0};
+    std::atomic<size_t> _raw_queued{0};
+    void queue_chunk(std::string_view chunk) noexcept;
+
+    // Backpressure: undrained events in the queue are bounded, the rest wait in the overflow
+    // buffer (or are dropped/coalesced) until JS drains, owned by the TransferEngine I/O thread
+    std::atomic<size_t> _queued_events{0};
+    std::atomic<bool> _overflowed{false};
+    std::deque<QueuedEvent> _overflow_events;
+    std::atomic<uint64_t> _dropped_events{0};
+    bool _transfer_paused = false;
+    // rateLimit.maxEventsPerSecond: a token bucket of up to a second's events, which each parsed
+    // event draws from, into debt within a chunk; while it holds less than one event the transfer
+    // stays paused and the timer resumes it. Owned by the TransferEngine I/O thread
+    double _rate_tokens = 0.0;
+    TransferEngine::Clock::time_point _rate_refilled_at{};
+    std::optional<TransferEngine::Timer> _rate_timer;
+    void resume_after_rate_limit() noexcept;
+
+    // Delivered events travel back to the parser so their strings keep their capacity:
+    // the JS thread recycles, the I/O thread acquires
+    static constexpr size_t MAX_POOLED_EVENTS = 256;
+    // Enough for a first burst; the rest stay for the streams created next
+    static constexpr size_t RECYCLED_EVENTS_PER_STREAM = 32;
+    BoundedSpscQueue<NitroEventSourceEvent, MAX_POOLED_EVENTS> _event_pool;
+    // Events the I/O thread lets go itself, e.g. sampled out, which must not go into the pool
+    // it only pops from; acquire_event() takes these first. I/O thread only
+    static constexpr size_t MAX_DISCARDED_EVENTS = 8;
+    std::vector<NitroEventSourceEvent> _discarded_events;
+    std::atomic<uint64_t> _pool_hits{0};
+    std::atomic<uint64_t> _pool_misses{0};
+    // The last event's `sequence`; I/O thread only, kept across reconnects
+    uint64_t _event_sequence = 0;
+
+    // getMetrics(): counted with relaxed atomics where things happen, read on the JS thread
+    std::atomic<uint64_t> _bytes_received{0};
+    std::atomic<uint64_t> _events_parsed{0};
+    std::atomic<uint64_t> _events_dispatched{0};
+    std::atomic<uint64_t> _comments_received{0};
+    // Clock time of the chunk holding the last comment, 0 before the first
+    std::atomic<int64_t> _last_comment_ns{0};
+    std::atomic<uint64_t> _connect_attempts{0};
+    std::atomic<int64_t> _connected_ns{0};
+    // Clock time of the last open, 0 while not open
+    std::atomic<int64_t> _open_since_ns{0};
+    DurationHistogram _parse_time;
+    DurationHistogram _dispatch_latency;
+    DurationHistogram _time_to_first_byte;
+    std::mutex _connection_timing_mutex;
+    std::optional<ConnectionTiming> _last_connection_timing;
+
+    // latencyTracing: when the chunk being parsed arrived and the current event's server timestamp,
+    // owned by the TransferEngine I/O thread
+    TransferEngine::Clock::time_point _chunk_received_at{};
+    std::chrono::system_clock::time_point _chunk_received_wall{};
+    std::optional<double> _event_sent_at;
+    DurationHistogram _server_latency;
+    DurationHistogram _native_latency;
+    void trace_latency(std::optional<double> sent_at, const JsonValue* json, TransferEngine::Clock::time_point received_at,
+                       std::chrono::system_clock::time_point received_wall) noexcept;
+    // latencyTracing.unit in microseconds
+    double timestamp_scale_us() const noexcept;
+    // heartbeat: events of _heartbeat_type feed _heartbeat; a _quality_type event goes out
+    // whenever the score moved by a tenth since the last one
+    EventTypeTable::Id _heartbeat_type = EventTypeTable::NONE;
+    EventTypeTable::Id _quality_type = EventTypeTable::NONE;
+    std::optional<double> _quality_reported;
+    void record_heartbeat(std::string_view data) noexcept;
+
+    // stateSync document: patched on the I/O thread, read by getState on the JS thread
+    std::mutex _state_mutex;
+    std::optional<JsonDocument> _state;
+    size_t _state_compacted_bytes = 0;
+    // stateSync.key: the document and its version kept across launches, saved a moment after it changes.
+    // The version is what the request tells the server the document is at; owned by the I/O thread
+    std::unique_ptr<StateSnapshotStore> _state_store;
+    std::string _state_version;
+    bool _state_dirty = false;
+    std::optional<TransferEngine::Timer> _state_save_timer;
+    // Under _state_mutex, after the document changed
+    void update_state_version() noexcept;
+    void save_state() noexcept;
+
+    // Batched delivery, owned by the TransferEngine I/O thread
+    std::vector<QueuedEvent> _pending_events;
+    std::unordered_map<std::string, size_t> _pending_keys;
+    std::optional<TransferEngine::Timer> _flush_timer;
+    // underLoad: set while the policy applies, batching and coalescing by type as if configured
+    std::atomic<bool> _under_load{false};
+    CoalesceOptions _load_coalesce;
     
-    // Event listeners storage - simpler approach using the callback function as key
-    std::unordered_map<std::string, std::vector<std::function<void(const NitroEventSourceEvent&)>>> _event_listeners;
+    // Listeners are keyed by subscription id for O(1) add/remove; every change bumps
+    // the version and the I/O thread rebuilds its immutable table, indexed by type id, lazily
+    struct ListenerSlot {
+        std::string type;
+        EventCallback callback;
+    };
+    using ListenerTable = std::vector<std::vector<EventCallback>>;
+    std::unordered_map<uint64_t, ListenerSlot> _listener_slots;
+    uint64_t _next_listener_id = 1;
     std::mutex _listeners_mutex;
-    
-    std::atomic<bool> _should_retry{true};
+    std::atomic<uint64_t> _listeners_version{0};
+
+    // Dispatch snapshot, owned by the TransferEngine I/O thread
+    std::shared_ptr<const ListenerTable> _listeners_snapshot;
+    uint64_t _listeners_snapshot_version = 0;
 };
 }; // namespace margelo::nitro::nitroeventsource
 
@@ -0,0 +1,80 @@
+#include "HybridNitroEventSourceFactory.hpp"
+
+#include "AppLifecycle.hpp"
+#include "ConnectionSpec.hpp"
+#include "CookieJar.hpp"
+#include "HybridNitroEventSource.hpp"
+#include "MetricsReporter.hpp"
+#include "StreamKey.hpp"
+#include "TransferEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace margelo::nitro::nitroeventsource {
+
+std::shared_ptr<HybridNitroEventSourceSpec> HybridNitroEventSourceFactory::create(const std::string& url,
+                                                                                  const std::optional<NitroEventSourceOptions>& options) {
+    return HybridNitroEventSource::open(url, options);
+}
+
+std::string HybridNitroEventSourceFactory::streamKey(const std::string& url, const std::optional<NitroEventSourceOptions>& options) {
+    return stream_key::to_hex(ConnectionSpec::key_of(url, options));
+}
+
+void HybridNitroEventSourceFactory::preconnect(const std::string& url) {
+    HybridNitroEventSource::preconnect_origin(url);
+}
+
+void HybridNitroEventSourceFactory::warmUp() {
+    TransferEngine::warm_up();
+}
+
+void HybridNitroEventSourceFactory::setConnectionLimits(double maxConnections, double maxConnectionsPerHost) {
+    HybridNitroEventSource::set_connection_limits(maxConnections, maxConnectionsPerHost);
+}
+
+void HybridNitroEventSourceFactory::setMemoryBudget(double maxBufferedBytes) {
+    HybridNitroEventSource::set_memory_budget(maxBufferedBytes);
+}
+
+void HybridNitroEventSourceFactory::setCookies(const std::string& url, const std::vector<std::string>& cookies) {
+    set_cookies(TransferEngine::shared().share_handle(), url, cookies);
+}
+
+std::vector<std::string> HybridNitroEventSourceFactory::getCookies() {
+    return list_cookies(TransferEngine::shared().share_handle());
+}
+
+void HybridNitroEventSourceFactory::clearCookies() {
+    clear_cookies(TransferEngine::shared().share_handle());
+}
+
+void HybridNitroEventSourceFactory::setForeground(bool foreground) {
+    AppLifecycle::shared().report(foreground);
+}
+
+std::shared_ptr<Promise<void>> HybridNitroEventSourceFactory::closeAll() {
+    return HybridNitroEventSource::close_all();
+}
+
+void HybridNitroEventSourceFactory::watchMetrics(double intervalMs, const std::function<void(const std::vector<StreamMetricsSample>&)>& callback) {
+    HybridNitroEventSource::watch_metrics(intervalMs, callback);
+}
+
+void HybridNitroEventSourceFactory::unwatchMetrics() {
+    HybridNitroEventSource::unwatch_metrics();
+}
+
+void HybridNitroEventSourceFactory::setMetricsReport(const std::optional<MetricsReportOptions>& options) {
+    if (!options) {
+        MetricsReporter::shared().report_to_file(std::nullopt);
+        return;
+    }
+    const double interval_ms = options->intervalMs.value_or(static_cast<double>(MetricsReporter::DEFAULT_INTERVAL.count()));
+    const double max_bytes = options->maxFileBytes.value_or(static_cast<double>(MetricsReporter::DEFAULT_MAX_FILE_BYTES));
+    MetricsReporter::shared().report_to_file(options->file, static_cast<size_t>(std::max(0.0, max_bytes)),
+                                             std::chrono::milliseconds(static_cast<int64_t>(std::max(0.0, interval_ms))));
+}
+
+} // namespace margelo::nitro::nitroeventsource
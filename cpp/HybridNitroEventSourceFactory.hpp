@@ -0,0 +1,38 @@
+#pragma once
+
+#include "HybridNitroEventSourceFactorySpec.hpp"
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The object JS creates once to open streams and reach process-wide state.
+ * Holds nothing itself, so every stream is the one HybridNitroEventSource
+ * create() makes, instead of a second one next to a stream used as factory.
+ */
+class HybridNitroEventSourceFactory : public HybridNitroEventSourceFactorySpec {
+public:
+    HybridNitroEventSourceFactory() : HybridObject(TAG), HybridNitroEventSourceFactorySpec() {}
+
+    std::shared_ptr<HybridNitroEventSourceSpec> create(const std::string& url, const std::optional<NitroEventSourceOptions>& options) override;
+    std::string streamKey(const std::string& url, const std::optional<NitroEventSourceOptions>& options) override;
+    void preconnect(const std::string& url) override;
+    void warmUp() override;
+    void setConnectionLimits(double maxConnections, double maxConnectionsPerHost) override;
+    void setMemoryBudget(double maxBufferedBytes) override;
+    void setCookies(const std::string& url, const std::vector<std::string>& cookies) override;
+    std::vector<std::string> getCookies() override;
+    void clearCookies() override;
+    void setForeground(bool foreground) override;
+    std::shared_ptr<Promise<void>> closeAll() override;
+    void watchMetrics(double intervalMs, const std::function<void(const std::vector<StreamMetricsSample>&)>& callback) override;
+    void unwatchMetrics() override;
+    void setMetricsReport(const std::optional<MetricsReportOptions>& options) override;
+};
+
+} // namespace margelo::nitro::nitroeventsource
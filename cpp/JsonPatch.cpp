@@ -0,0 +1,283 @@
+#include "JsonPatch.hpp"
+
+#include <algorithm>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+// Later duplicates win, as with JSON.parse and find_pointer
+template <typename Object>
+auto find_member(Object& object, std::string_view key) {
+    const auto member = std::find_if(object.rbegin(), object.rend(), [&](const auto& entry) {
+        return std::string_view(entry.first) == key;
+    });
+    return member == object.rend() ? nullptr : &*member;
+}
+
+JsonValue::String make_string(std::string_view text, MonotonicArena& arena) {
+    return JsonValue::String(text.data(), text.size(), ArenaAllocator<char>(&arena));
+}
+
+JsonValue clone(const JsonValue& value, MonotonicArena& arena) {
+    JsonValue copy;
+    std::visit([&](const auto& item) {
+        using T = std::decay_t<decltype(item)>;
+        if constexpr (std::is_same_v<T, JsonValue::String>) {
+            copy.value = make_string(item, arena);
+        } else if constexpr (std::is_same_v<T, JsonValue::Array>) {
+            JsonValue::Array items{ArenaAllocator<JsonValue>(&arena)};
+            items.reserve(item.size());
+            for (const JsonValue& element : item) {
+                items.push_back(clone(element, arena));
+            }
+            copy.value = std::move(items);
+        } else if constexpr (std::is_same_v<T, JsonValue::Object>) {
+            JsonValue::Object members{ArenaAllocator<std::pair<JsonValue::String, JsonValue>>(&arena)};
+            members.reserve(item.size());
+            for (const auto& [key, member] : item) {
+                members.emplace_back(make_string(key, arena), clone(member, arena));
+            }
+            copy.value = std::move(members);
+        } else {
+            copy.value = item;
+        }
+    }, value.value);
+    return copy;
+}
+
+// Structural equality for `test`: numbers numerically, objects regardless of member order
+bool equals(const JsonValue& a, const JsonValue& b) {
+    if (a.value.index() != b.value.index()) {
+        return false;
+    }
+    if (const auto* items = std::get_if<JsonValue::Array>(&a.value)) {
+        const auto& other = std::get<JsonValue::Array>(b.value);
+        return std::equal(items->begin(), items->end(), other.begin(), other.end(), equals);
+    }
+    if (const auto* members = std::get_if<JsonValue::Object>(&a.value)) {
+        const auto& other = std::get<JsonValue::Object>(b.value);
+        for (const auto& entry : *members) {
+            const auto* match = find_member(other, entry.first);
+            if (!match || !equals(find_member(*members, entry.first)->second, match->second)) {
+                return false;
+            }
+        }
+        return std::all_of(other.begin(), other.end(), [&](const auto& entry) {
+            return find_member(*members, entry.first) != nullptr;
+        });
+    }
+    if (const auto* text = std::get_if<JsonValue::String>(&a.value)) {
+        return std::string_view(*text) == std::string_view(std::get<JsonValue::String>(b.value));
+    }
+    if (const auto* number = std::get_if<double>(&a.value)) {
+        return *number == std::get<double>(b.value);
+    }
+    if (const auto* flag = std::get_if<bool>(&a.value)) {
+        return *flag == std::get<bool>(b.value);
+    }
+    return true;
+}
+
+class PatchApplier {
+public:
+    PatchApplier(JsonDocument& document, std::vector<std::string>& changed_paths)
+        : _document(document), _changed_paths(changed_paths) {}
+
+    bool apply(const JsonValue& operation) {
+        const auto* fields = std::get_if<JsonValue::Object>(&operation.value);
+        if (!fields) {
+            return false;
+        }
+        const JsonValue::String* op = string_field(*fields, "op");
+        const JsonValue::String* path = string_field(*fields, "path");
+        if (!op || !path) {
+            return false;
+        }
+        const auto* value = find_member(*fields, "value");
+        const JsonValue::String* from = string_field(*fields, "from");
+
+        const std::string_view name = *op;
+        if (name == "add") {
+            return value && add(*path, clone(value->second, arena())) && changed(*path);
+        }
+        if (name == "remove") {
+            return remove(*path, nullptr) && changed(*path);
+        }
+        if (name == "replace") {
+            JsonValue* target = resolve(*path);
+            if (!value || !target) {
+                return false;
+            }
+            *target = clone(value->second, arena());
+            return changed(*path);
+        }
+        if (name == "move") {
+            return from && move(*from, *path) && changed(*from) && changed(*path);
+        }
+        if (name == "copy") {
+            const JsonValue* source = from ? resolve(*from) : nullptr;
+            return source && add(*path, clone(*source, arena())) && changed(*path);
+        }
+        if (name == "test") {
+            const JsonValue* target = resolve(*path);
+            return value && target && equals(*target, value->second);
+        }
+        return false;
+    }
+
+private:
+    static const JsonValue::String* string_field(const JsonValue::Object& fields, std::string_view key) {
+        const auto* member = find_member(fields, key);
+        return member ? std::get_if<JsonValue::String>(&member->second.value) : nullptr;
+    }
+
+    MonotonicArena& arena() {
+        return *_document.arena;
+    }
+
+    JsonValue* resolve(std::string_view pointer) {
+        return const_cast<JsonValue*>(find_pointer(_document.root, pointer));
+    }
+
+    bool add(std::string_view path, JsonValue value) {
+        if (path.empty()) {
+            _document.root = std::move(value);
+            return true;
+        }
+
+        std::string_view parent_path;
+        if (!split_pointer(path, parent_path, _token)) {
+            return false;
+        }
+        JsonValue* parent = resolve(parent_path);
+        if (!parent) {
+            return false;
+        }
+
+        if (auto* members = std::get_if<JsonValue::Object>(&parent->value)) {
+            if (auto* member = find_member(*members, _token)) {
+                member->second = std::move(value);
+            } else {
+                members->emplace_back(make_string(_token, arena()), std::move(value));
+            }
+            return true;
+        }
+        if (auto* items = std::get_if<JsonValue::Array>(&parent->value)) {
+            size_t index = 0;
+            if (_token == "-") {
+                items->push_back(std::move(value));
+            } else if (parse_array_index(_token, index) && index <= items->size()) {
+                items->insert(items->begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+            } else {
+                return false;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    bool remove(std::string_view path, JsonValue* removed) {
+        std::string_view parent_path;
+        if (!split_pointer(path, parent_path, _token)) {
+            return false;
+        }
+        JsonValue* parent = resolve(parent_path);
+        if (!parent) {
+            return false;
+        }
+
+        if (auto* members = std::get_if<JsonValue::Object>(&parent->value)) {
+            auto* member = find_member(*members, _token);
+            if (!member) {
+                return false;
+            }
+            if (removed) {
+                *removed = std::move(member->second);
+            }
+            // Shadowed duplicates go too, or they would resurface
+            members->erase(std::remove_if(members->begin(), members->end(), [&](const auto& entry) {
+                return std::string_view(entry.first) == _token;
+            }), members->end());
+            return true;
+        }
+        if (auto* items = std::get_if<JsonValue::Array>(&parent->value)) {
+            size_t index = 0;
+            if (!parse_array_index(_token, index) || index >= items->size()) {
+                return false;
+            }
+            if (removed) {
+                *removed = std::move((*items)[index]);
+            }
+            items->erase(items->begin() + static_cast<std::ptrdiff_t>(index));
+            return true;
+        }
+        return false;
+    }
+
+    bool move(std::string_view from, std::string_view path) {
+        if (!resolve(from)) {
+            return false;
+        }
+        if (from == path) {
+            return true;
+        }
+        // A value cannot move into one of its own children
+        if (path.size() > from.size() && path.substr(0, from.size()) == from && path[from.size()] == '/') {
+            return false;
+        }
+
+        JsonValue value;
+        return remove(from, &value) && add(path, std::move(value));
+    }
+
+    bool changed(std::string_view path) {
+        if (std::find(_changed_paths.begin(), _changed_paths.end(), path) == _changed_paths.end()) {
+            _changed_paths.emplace_back(path);
+        }
+        return true;
+    }
+
+    JsonDocument& _document;
+    std::vector<std::string>& _changed_paths;
+    std::string _token;
+};
+
+} // namespace
+
+bool apply_json_patch(JsonDocument& document, const JsonValue& patch, std::vector<std::string>& changed_paths) noexcept {
+    const auto* operations = std::get_if<JsonValue::Array>(&patch.value);
+    if (!operations || !document.arena) {
+        return false;
+    }
+
+    try {
+        PatchApplier applier(document, changed_paths);
+        return std::all_of(operations->begin(), operations->end(), [&](const JsonValue& operation) {
+            return applier.apply(operation);
+        });
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+bool compact_json(JsonDocument& document) noexcept {
+    try {
+        std::string text;
+        serialize_json(document.root, text);
+        JsonDocument compacted;
+        if (!parse_json(text, compacted)) {
+            return false;
+        }
+        document = std::move(compacted);
+        return true;
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+} // namespace margelo::nitro::nitroeventsource
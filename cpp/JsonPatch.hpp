@@ -0,0 +1,23 @@
+#pragma once
+
+#include "JsonValue.hpp"
+
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * RFC 6902 patches applied in place to a document held natively for `stateSync` streams.
+ * Values taken from the patch are copied into the document's arena, so the patch can be
+ * released as soon as it has been applied.
+ */
+
+// Applies every operation of `patch` to `document` and appends each pointer it changed to `changed_paths`.
+// Returns false on the first operation that fails, the operations before it stay applied
+bool apply_json_patch(JsonDocument& document, const JsonValue& patch, std::vector<std::string>& changed_paths) noexcept;
+
+// Rebuilds the document in a fresh arena, giving back the memory of values patches replaced
+bool compact_json(JsonDocument& document) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource
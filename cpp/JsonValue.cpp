@@ -0,0 +1,556 @@
+#include "JsonValue.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr size_t MAX_DEPTH = 128;
+// Decoded trees are usually about the size of their text; larger ones take a second block
+constexpr size_t MIN_ARENA_BYTES = 256;
+constexpr size_t MAX_INITIAL_ARENA_BYTES = 64 * 1024;
+
+class JsonParser {
+public:
+    JsonParser(std::string_view text, MonotonicArena& arena) : _text(text), _arena(&arena) {}
+
+    bool parse(JsonValue& out) {
+        skip_whitespace();
+        if (!parse_value(out, 0)) {
+            return false;
+        }
+        skip_whitespace();
+        return _pos == _text.size();
+    }
+
+private:
+    bool parse_value(JsonValue& out, size_t depth) {
+        if (_pos >= _text.size()) {
+            return false;
+        }
+
+        switch (_text[_pos]) {
+            case '{':
+                return parse_object(out, depth + 1);
+            case '[':
+                return parse_array(out, depth + 1);
+            case '"': {
+                JsonValue::String text(allocator());
+                if (!parse_string(text)) {
+                    return false;
+                }
+                out.value = std::move(text);
+                return true;
+            }
+            case 't':
+                return parse_literal("true", out, true);
+            case 'f':
+                return parse_literal("false", out, false);
+            case 'n':
+                return parse_literal("null", out, nullptr);
+            default:
+                return parse_number(out);
+        }
+    }
+
+    bool parse_object(JsonValue& out, size_t depth) {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+
+        ++_pos;
+        JsonValue::Object members(allocator());
+        skip_whitespace();
+        if (consume('}')) {
+            out.value = std::move(members);
+            return true;
+        }
+
+        while (true) {
+            skip_whitespace();
+            JsonValue::String key(allocator());
+            if (_pos >= _text.size() || _text[_pos] != '"' || !parse_string(key)) {
+                return false;
+            }
+
+            skip_whitespace();
+            if (!consume(':')) {
+                return false;
+            }
+
+            skip_whitespace();
+            JsonValue member;
+            if (!parse_value(member, depth)) {
+                return false;
+            }
+            members.emplace_back(std::move(key), std::move(member));
+
+            skip_whitespace();
+            if (consume('}')) {
+                break;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+        }
+
+        out.value = std::move(members);
+        return true;
+    }
+
+    bool parse_array(JsonValue& out, size_t depth) {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+
+        ++_pos;
+        JsonValue::Array items(allocator());
+        skip_whitespace();
+        if (consume(']')) {
+            out.value = std::move(items);
+            return true;
+        }
+
+        while (true) {
+            skip_whitespace();
+            JsonValue item;
+            if (!parse_value(item, depth)) {
+                return false;
+            }
+            items.emplace_back(std::move(item));
+
+            skip_whitespace();
+            if (consume(']')) {
+                break;
+            }
+            if (!consume(',')) {
+                return false;
+            }
+        }
+
+        out.value = std::move(items);
+        return true;
+    }
+
+    bool parse_string(JsonValue::String& out) {
+        ++_pos;
+
+        while (_pos < _text.size()) {
+            // Copy unescaped runs in one go
+            const size_t run_start = _pos;
+            while (_pos < _text.size() && _text[_pos] != '"' && _text[_pos] != '\\') {
+                if (static_cast<unsigned char>(_text[_pos]) < 0x20) {
+                    return false;
+                }
+                ++_pos;
+            }
+            out.append(_text.data() + run_start, _pos - run_start);
+
+            if (_pos >= _text.size()) {
+                return false;
+            }
+            if (_text[_pos] == '"') {
+                ++_pos;
+                return true;
+            }
+
+            ++_pos;
+            if (_pos >= _text.size()) {
+                return false;
+            }
+
+            const char escape = _text[_pos++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u':
+                    if (!parse_unicode_escape(out)) {
+                        return false;
+                    }
+                    break;
+                default:
+                    return false;
+            }
+        }
+
+        return false;
+    }
+
+    bool parse_unicode_escape(JsonValue::String& out) {
+        uint32_t code_point = 0;
+        if (!parse_hex4(code_point)) {
+            return false;
+        }
+
+        // Surrogate pairs encode code points above U+FFFF
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            uint32_t low = 0;
+            if (_pos + 1 < _text.size() && _text[_pos] == '\\' && _text[_pos + 1] == 'u') {
+                _pos += 2;
+                if (!parse_hex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                    return false;
+                }
+                code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+            } else {
+                code_point = 0xFFFD;
+            }
+        } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+            code_point = 0xFFFD;
+        }
+
+        append_utf8(out, code_point);
+        return true;
+    }
+
+    bool parse_hex4(uint32_t& out) {
+        if (_text.size() - _pos < 4) {
+            return false;
+        }
+
+        out = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const char c = _text[_pos++];
+            out <<= 4;
+            if (c >= '0' && c <= '9') {
+                out |= static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                out |= static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                out |= static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void append_utf8(JsonValue::String& out, uint32_t code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    bool parse_number(JsonValue& out) {
+        const size_t start = _pos;
+
+        consume('-');
+        if (consume('0')) {
+            // No leading zeros
+        } else if (!consume_digits()) {
+            return false;
+        }
+        if (consume('.') && !consume_digits()) {
+            return false;
+        }
+        if (consume('e') || consume('E')) {
+            if (!consume('+')) {
+                consume('-');
+            }
+            if (!consume_digits()) {
+                return false;
+            }
+        }
+
+        // strtod needs a terminated buffer; numbers are short enough for the stack
+        const std::string_view literal = _text.substr(start, _pos - start);
+        char buffer[64];
+        std::string heap_buffer;
+        const char* terminated = buffer;
+        if (literal.size() < sizeof(buffer)) {
+            literal.copy(buffer, literal.size());
+            buffer[literal.size()] = '\0';
+        } else {
+            heap_buffer.assign(literal);
+            terminated = heap_buffer.c_str();
+        }
+
+        out.value = std::strtod(terminated, nullptr);
+        return true;
+    }
+
+    template <typename T>
+    bool parse_literal(std::string_view literal, JsonValue& out, T value) {
+        if (_text.substr(_pos, literal.size()) != literal) {
+            return false;
+        }
+        _pos += literal.size();
+        out.value = value;
+        return true;
+    }
+
+    bool consume_digits() {
+        const size_t start = _pos;
+        while (_pos < _text.size() && _text[_pos] >= '0' && _text[_pos] <= '9') {
+            ++_pos;
+        }
+        return _pos != start;
+    }
+
+    bool consume(char c) {
+        if (_pos < _text.size() && _text[_pos] == c) {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    void skip_whitespace() {
+        while (_pos < _text.size()) {
+            const char c = _text[_pos];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                return;
+            }
+            ++_pos;
+        }
+    }
+
+    ArenaAllocator<char> allocator() const noexcept {
+        return ArenaAllocator<char>(_arena);
+    }
+
+    std::string_view _text;
+    MonotonicArena* _arena;
+    size_t _pos = 0;
+};
+
+// Decodes one pointer reference token, where "~1" stands for '/' and "~0" for '~'
+bool decode_token(std::string_view token, std::string& out) {
+    out.clear();
+    for (size_t i = 0; i < token.size(); ++i) {
+        if (token[i] != '~') {
+            out += token[i];
+            continue;
+        }
+        if (i + 1 >= token.size() || (token[i + 1] != '0' && token[i + 1] != '1')) {
+            return false;
+        }
+        out += token[++i] == '0' ? '~' : '/';
+    }
+    return true;
+}
+
+} // namespace
+
+void serialize_string(std::string_view text, std::string& out) {
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    out += '"';
+    size_t run_start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text.data() + run_start, i - run_start);
+        run_start = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += HEX[c >> 4];
+                out += HEX[c & 0xF];
+                break;
+        }
+    }
+    out.append(text.data() + run_start, text.size() - run_start);
+    out += '"';
+}
+
+void serialize_number(double number, std::string& out) {
+    constexpr double MAX_SAFE_INTEGER = 9007199254740991.0;
+
+    // JSON.stringify writes non-finite numbers as null
+    if (!std::isfinite(number)) {
+        out += "null";
+        return;
+    }
+
+    char buffer[32];
+    if (number == std::trunc(number) && std::fabs(number) <= MAX_SAFE_INTEGER) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", number == 0 ? 0.0 : number);
+        out += buffer;
+        return;
+    }
+
+    // 15 significant digits cover most values, 17 always round-trip
+    std::snprintf(buffer, sizeof(buffer), "%.15g", number);
+    if (std::strtod(buffer, nullptr) != number) {
+        std::snprintf(buffer, sizeof(buffer), "%.17g", number);
+    }
+    out += buffer;
+}
+
+bool parse_json(std::string_view text, JsonDocument& out) noexcept {
+    try {
+        out.root = JsonValue();
+        out.arena = std::make_unique<MonotonicArena>(std::clamp(text.size() * 2, MIN_ARENA_BYTES, MAX_INITIAL_ARENA_BYTES));
+        JsonParser parser(text, *out.arena);
+        return parser.parse(out.root);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+const JsonValue* find_pointer(const JsonValue& root, std::string_view pointer) noexcept {
+    try {
+        const JsonValue* current = &root;
+        std::string token;
+        while (!pointer.empty()) {
+            if (pointer[0] != '/') {
+                return nullptr;
+            }
+            pointer.remove_prefix(1);
+            const size_t end = std::min(pointer.find('/'), pointer.size());
+            if (!decode_token(pointer.substr(0, end), token)) {
+                return nullptr;
+            }
+            pointer.remove_prefix(end);
+
+            if (const auto* object = std::get_if<JsonValue::Object>(&current->value)) {
+                // Later duplicates win, as with JSON.parse
+                const auto member = std::find_if(object->rbegin(), object->rend(), [&](const auto& entry) {
+                    return std::string_view(entry.first) == token;
+                });
+                if (member == object->rend()) {
+                    return nullptr;
+                }
+                current = &member->second;
+            } else if (const auto* array = std::get_if<JsonValue::Array>(&current->value)) {
+                size_t index = 0;
+                if (!parse_array_index(token, index) || index >= array->size()) {
+                    return nullptr;
+                }
+                current = &(*array)[index];
+            } else {
+                return nullptr;
+            }
+        }
+        return current;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+bool parse_array_index(std::string_view token, size_t& out) noexcept {
+    // No leading zeros, no signs
+    if (token.empty() || token.size() > 9 || (token.size() > 1 && token[0] == '0')) {
+        return false;
+    }
+    out = 0;
+    for (const char c : token) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        out = out * 10 + static_cast<size_t>(c - '0');
+    }
+    return true;
+}
+
+bool split_pointer(std::string_view pointer, std::string_view& parent, std::string& last) noexcept {
+    const size_t slash = pointer.rfind('/');
+    if (pointer.empty() || slash == std::string_view::npos || pointer[0] != '/') {
+        return false;
+    }
+    try {
+        parent = pointer.substr(0, slash);
+        return decode_token(pointer.substr(slash + 1), last);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+void serialize_json(const JsonValue& value, std::string& out) {
+    std::visit([&](const auto& item) {
+        using T = std::decay_t<decltype(item)>;
+        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            out += "null";
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out += item ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, double>) {
+            serialize_number(item, out);
+        } else if constexpr (std::is_same_v<T, JsonValue::String>) {
+            serialize_string(item, out);
+        } else if constexpr (std::is_same_v<T, JsonValue::Array>) {
+            out += '[';
+            for (size_t i = 0; i < item.size(); ++i) {
+                if (i != 0) {
+                    out += ',';
+                }
+                serialize_json(item[i], out);
+            }
+            out += ']';
+        } else {
+            out += '{';
+            for (size_t i = 0; i < item.size(); ++i) {
+                if (i != 0) {
+                    out += ',';
+                }
+                serialize_string(item[i].first, out);
+                out += ':';
+                serialize_json(item[i].second, out);
+            }
+            out += '}';
+        }
+    }, value.value);
+}
+
+bool scalar_equals(const JsonValue& value, std::string_view text) noexcept {
+    if (const auto* string = std::get_if<JsonValue::String>(&value.value)) {
+        return std::string_view(*string) == text;
+    }
+    if (const auto* number = std::get_if<double>(&value.value)) {
+        // Parsing a number never allocates from the arena
+        try {
+            MonotonicArena arena(64);
+            JsonParser parser(text, arena);
+            JsonValue parsed;
+            if (!parser.parse(parsed)) {
+                return false;
+            }
+            const auto* expected = std::get_if<double>(&parsed.value);
+            return expected && *expected == *number;
+        } catch (const std::bad_alloc&) {
+            return false;
+        }
+    }
+    if (const auto* flag = std::get_if<bool>(&value.value)) {
+        return text == (*flag ? "true" : "false");
+    }
+    if (std::holds_alternative<std::nullptr_t>(value.value)) {
+        return text == "null";
+    }
+    return false;
+}
+
+} // namespace margelo::nitro::nitroeventsource
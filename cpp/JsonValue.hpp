@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MonotonicArena.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Parsed JSON value produced on the I/O thread for `parseJson` streams.
+ * Objects keep their members in document order; later duplicates win when
+ * converted to JS, matching `JSON.parse`. Strings and containers live in
+ * the arena of the JsonDocument that owns the value.
+ */
+struct JsonValue {
+    using String = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+    using Array = std::vector<JsonValue, ArenaAllocator<JsonValue>>;
+    using Object = std::vector<std::pair<String, JsonValue>, ArenaAllocator<std::pair<String, JsonValue>>>;
+
+    std::variant<std::nullptr_t, bool, double, String, Array, Object> value = nullptr;
+};
+
+// A decoded payload and the arena holding all of it, released together with the event
+struct JsonDocument {
+    JsonDocument() = default;
+    JsonDocument(JsonDocument&&) noexcept = default;
+
+    JsonDocument& operator=(JsonDocument&& other) noexcept {
+        // Member-wise assignment would free the arena while the old tree still lives in it
+        root = JsonValue();
+        arena = std::move(other.arena);
+        root = std::move(other.root);
+        return *this;
+    }
+
+    // Declared first so the tree is destroyed before its memory
+    std::unique_ptr<MonotonicArena> arena;
+    JsonValue root;
+};
+
+// Parses a complete RFC 8259 document, returns false on malformed input or when nesting is too deep
+bool parse_json(std::string_view text, JsonDocument& out) noexcept;
+
+// Resolves an RFC 6901 pointer such as "/room/id", returns nullptr when nothing is at that path
+const JsonValue* find_pointer(const JsonValue& root, std::string_view pointer) noexcept;
+
+// Parses an array index token of a pointer, no leading zeros or signs
+bool parse_array_index(std::string_view token, size_t& out) noexcept;
+
+// Splits a pointer into its parent and its decoded last token, returns false when it is malformed or the root
+bool split_pointer(std::string_view pointer, std::string_view& parent, std::string& last) noexcept;
+
+// Appends `value` as compact JSON text, numbers in the shortest form JSON.parse reads back exactly
+void serialize_json(const JsonValue& value, std::string& out);
+void serialize_string(std::string_view text, std::string& out);
+void serialize_number(double number, std::string& out);
+
+// Compares a scalar against its textual form: strings exactly, numbers numerically, "true"/"false"/"null" literally
+bool scalar_equals(const JsonValue& value, std::string_view text) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource
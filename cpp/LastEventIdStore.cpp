@@ -0,0 +1,107 @@
+#include "LastEventIdStore.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4e45534c; // "NESL"
+
+uint32_t checksum(const char* bytes, uint32_t length) noexcept {
+    uint32_t hash = 2166136261u ^ length;
+    for (uint32_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+struct LastEventIdStore::Layout {
+    struct Slot {
+        uint32_t length;
+        uint32_t checksum;
+        char bytes[MAX_ID_BYTES];
+    };
+
+    uint32_t magic;
+    // Odd sequences use the second slot; bumped only once the slot is complete
+    std::atomic<uint64_t> sequence;
+    Slot slots[2];
+};
+
+std::unique_ptr<LastEventIdStore> LastEventIdStore::open(const std::string& path) noexcept {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat info {};
+    const bool sized = ::fstat(fd, &info) == 0 &&
+                       (static_cast<size_t>(info.st_size) >= sizeof(Layout) || ::ftruncate(fd, sizeof(Layout)) == 0);
+    void* mapping = sized ? ::mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    // The mapping keeps the file open
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto* layout = static_cast<Layout*>(mapping);
+    if (layout->magic != MAGIC) {
+        // New or foreign file: start over from empty slots
+        layout = new (mapping) Layout{};
+        layout->magic = MAGIC;
+    }
+
+    std::unique_ptr<LastEventIdStore> store(new (std::nothrow) LastEventIdStore(layout));
+    if (!store) {
+        ::munmap(mapping, sizeof(Layout));
+    }
+    return store;
+}
+
+LastEventIdStore::~LastEventIdStore() {
+    ::munmap(_layout, sizeof(Layout));
+}
+
+std::string LastEventIdStore::load() const {
+    const uint64_t sequence = _layout->sequence.load(std::memory_order_acquire);
+    // Fall back to the older slot if the newer one was left half written
+    for (const uint64_t candidate : {sequence, sequence + 1}) {
+        const Layout::Slot& slot = _layout->slots[candidate & 1];
+        if (slot.length <= MAX_ID_BYTES && slot.checksum == checksum(slot.bytes, slot.length)) {
+            return std::string(slot.bytes, slot.length);
+        }
+    }
+    return {};
+}
+
+void LastEventIdStore::store(std::string_view id) noexcept {
+    if (id.size() > MAX_ID_BYTES) {
+        return;
+    }
+
+    const uint64_t sequence = _layout->sequence.load(std::memory_order_relaxed);
+    const Layout::Slot& current = _layout->slots[sequence & 1];
+    if (current.length == id.size() && std::memcmp(current.bytes, id.data(), id.size()) == 0) {
+        return;
+    }
+
+    Layout::Slot& next = _layout->slots[(sequence + 1) & 1];
+    const auto length = static_cast<uint32_t>(id.size());
+    std::memcpy(next.bytes, id.data(), id.size());
+    next.length = length;
+    next.checksum = checksum(next.bytes, length);
+    _layout->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+} // namespace margelo::nitro::nitroeventsource
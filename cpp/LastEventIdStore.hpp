@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Last-Event-ID of one stream key, kept in a small memory-mapped file so a cold
+ * start can resume where the previous process stopped. Storing is a copy into
+ * the mapping; the kernel writes it back even if the process is killed.
+ * Two slots alternate so a write cut short never corrupts the id in use.
+ */
+class LastEventIdStore {
+public:
+    // Ids longer than this are not persisted, the previous id stays
+    static constexpr size_t MAX_ID_BYTES = 1024;
+
+    // Returns nullptr when the file cannot be created or mapped
+    static std::unique_ptr<LastEventIdStore> open(const std::string& path) noexcept;
+    ~LastEventIdStore();
+
+    LastEventIdStore(const LastEventIdStore&) = delete;
+    LastEventIdStore& operator=(const LastEventIdStore&) = delete;
+
+    // The stored id, empty when nothing valid was stored yet
+    std::string load() const;
+    void store(std::string_view id) noexcept;
+
+private:
+    struct Layout;
+
+    explicit LastEventIdStore(Layout* layout) noexcept : _layout(layout) {}
+
+    Layout* _layout;
+};
+
+} // namespace margelo::nitro::nitroeventsource
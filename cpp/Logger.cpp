@@ -0,0 +1,75 @@
+#include "Logger.hpp"
+
+#include <string>
+
+#if defined(__APPLE__)
+#include <os/log.h>
+#elif defined(__ANDROID__)
+#include <android/log.h>
+#else
+#include <cstdio>
+#endif
+
+namespace margelo::nitro::nitroeventsource::logging {
+
+#if defined(__APPLE__)
+
+namespace {
+
+os_log_t apple_log() noexcept {
+    static const os_log_t instance = os_log_create("com.nitroeventsource", "stream");
+    return instance;
+}
+
+os_log_type_t apple_type(Level level) noexcept {
+    switch (level) {
+        case Level::DEBUG: return OS_LOG_TYPE_DEBUG;
+        case Level::INFO: return OS_LOG_TYPE_INFO;
+        case Level::WARN: return OS_LOG_TYPE_DEFAULT;
+        case Level::ERROR: return OS_LOG_TYPE_ERROR;
+    }
+    return OS_LOG_TYPE_DEFAULT;
+}
+
+} // namespace
+
+bool enabled(Level level) noexcept {
+    return os_log_type_enabled(apple_log(), apple_type(level));
+}
+
+void write(Level level, const char* tag, std::string_view message) noexcept {
+    // %.*s takes the view as is, no terminated copy needed
+    os_log_with_type(apple_log(), apple_type(level), "[%{public}s] %{public}.*s", tag, static_cast<int>(message.size()), message.data());
+}
+
+#elif defined(__ANDROID__)
+
+bool enabled(Level) noexcept {
+    // __android_log_is_loggable needs API 30; below the compile-time level everything goes to logcat
+    return true;
+}
+
+void write(Level level, const char* tag, std::string_view message) noexcept {
+    int priority = ANDROID_LOG_DEBUG;
+    switch (level) {
+        case Level::DEBUG: priority = ANDROID_LOG_DEBUG; break;
+        case Level::INFO: priority = ANDROID_LOG_INFO; break;
+        case Level::WARN: priority = ANDROID_LOG_WARN; break;
+        case Level::ERROR: priority = ANDROID_LOG_ERROR; break;
+    }
+    __android_log_print(priority, tag, "%.*s", static_cast<int>(message.size()), message.data());
+}
+
+#else
+
+bool enabled(Level) noexcept {
+    return true;
+}
+
+void write(Level, const char* tag, std::string_view message) noexcept {
+    std::fprintf(stderr, "[%s] %.*s\n", tag, static_cast<int>(message.size()), message.data());
+}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource::logging
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string_view>
+
+/**
+ * Leveled logging to os_log on Apple platforms and logcat on Android, stderr
+ * elsewhere. Levels below NITRO_EVENT_SOURCE_LOG_LEVEL are compiled out together
+ * with the expression building their message; by default debug builds keep
+ * everything and release builds nothing. Release means NDEBUG, or on Apple
+ * platforms the absence of the DEBUG=1 that Xcode's Debug configuration sets. Enabled levels still skip
+ * formatting when the platform would not record them.
+ *
+ *   NITRO_ES_LOG_WARN(TAG, "Invalid retry value: " + std::string(value));
+ */
+
+#define NITRO_ES_LOG_LEVEL_DEBUG 0
+#define NITRO_ES_LOG_LEVEL_INFO 1
+#define NITRO_ES_LOG_LEVEL_WARN 2
+#define NITRO_ES_LOG_LEVEL_ERROR 3
+#define NITRO_ES_LOG_LEVEL_NONE 4
+
+#if !defined(NITRO_EVENT_SOURCE_LOG_LEVEL)
+#if defined(NDEBUG) || (defined(__APPLE__) && !defined(DEBUG))
+#define NITRO_EVENT_SOURCE_LOG_LEVEL NITRO_ES_LOG_LEVEL_NONE
+#else
+#define NITRO_EVENT_SOURCE_LOG_LEVEL NITRO_ES_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+namespace margelo::nitro::nitroeventsource::logging {
+
+enum class Level { DEBUG = NITRO_ES_LOG_LEVEL_DEBUG, INFO = NITRO_ES_LOG_LEVEL_INFO, WARN = NITRO_ES_LOG_LEVEL_WARN, ERROR = NITRO_ES_LOG_LEVEL_ERROR };
+
+// Whether the platform records `level` right now, e.g. os_log drops debug messages unless streamed
+bool enabled(Level level) noexcept;
+void write(Level level, const char* tag, std::string_view message) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource::logging
+
+#define NITRO_ES_LOG(level, tag, message)                                                               \
+    do {                                                                                               \
+        if (::margelo::nitro::nitroeventsource::logging::enabled(level)) {                             \
+            ::margelo::nitro::nitroeventsource::logging::write(level, tag, message);                   \
+        }                                                                                              \
+    } while (false)
+
+#if NITRO_EVENT_SOURCE_LOG_LEVEL <= NITRO_ES_LOG_LEVEL_DEBUG
+#define NITRO_ES_LOG_DEBUG(tag, message) NITRO_ES_LOG(::margelo::nitro::nitroeventsource::logging::Level::DEBUG, tag, message)
+#else
+#define NITRO_ES_LOG_DEBUG(tag, message) static_cast<void>(0)
+#endif
+
+#if NITRO_EVENT_SOURCE_LOG_LEVEL <= NITRO_ES_LOG_LEVEL_INFO
+#define NITRO_ES_LOG_INFO(tag, message) NITRO_ES_LOG(::margelo::nitro::nitroeventsource::logging::Level::INFO, tag, message)
+#else
+#define NITRO_ES_LOG_INFO(tag, message) static_cast<void>(0)
+#endif
+
+#if NITRO_EVENT_SOURCE_LOG_LEVEL <= NITRO_ES_LOG_LEVEL_WARN
+#define NITRO_ES_LOG_WARN(tag, message) NITRO_ES_LOG(::margelo::nitro::nitroeventsource::logging::Level::WARN, tag, message)
+#else
+#define NITRO_ES_LOG_WARN(tag, message) static_cast<void>(0)
+#endif
+
+#if NITRO_EVENT_SOURCE_LOG_LEVEL <= NITRO_ES_LOG_LEVEL_ERROR
+#define NITRO_ES_LOG_ERROR(tag, message) NITRO_ES_LOG(::margelo::nitro::nitroeventsource::logging::Level::ERROR, tag, message)
+#else
+#define NITRO_ES_LOG_ERROR(tag, message) static_cast<void>(0)
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The process-wide budget for bytes every stream together holds natively on
+ * the way to JS: queued events and the parser's buffers. Each stream charges
+ * an Account of its own; while the total is over the limit, streams stop
+ * queueing new events (their `backpressure.overflow` policy decides what
+ * happens to them), pause reading and stop pooling buffers, until JS drains.
+ * No limit is set by default.
+ */
+class MemoryBudget {
+public:
+    class Account {
+    public:
+        void charge(int64_t bytes) noexcept {
+            _bytes.fetch_add(bytes, std::memory_order_relaxed);
+            MemoryBudget::shared()._total.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        int64_t bytes() const noexcept {
+            return _bytes.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<int64_t> _bytes{0};
+    };
+
+    // Bytes charged to an account while it lives; moves with the event it belongs to
+    class Charge {
+    public:
+        Charge() = default;
+        Charge(std::shared_ptr<Account> account, int64_t bytes) noexcept : _account(std::move(account)), _bytes(bytes) {
+            if (_account) {
+                _account->charge(_bytes);
+            }
+        }
+        Charge(Charge&& other) noexcept : _account(std::move(other._account)), _bytes(std::exchange(other._bytes, 0)) {}
+        Charge& operator=(Charge&& other) noexcept {
+            if (this != &other) {
+                release();
+                _account = std::move(other._account);
+                _bytes = std::exchange(other._bytes, 0);
+            }
+            return *this;
+        }
+        ~Charge() {
+            release();
+        }
+
+        // Charges `bytes` instead of what it held so far
+        void update(int64_t bytes) noexcept {
+            if (_account && bytes != _bytes) {
+                _account->charge(bytes - _bytes);
+                _bytes = bytes;
+            }
+        }
+
+    private:
+        void release() noexcept {
+            if (_account) {
+                _account->charge(-_bytes);
+                _account.reset();
+            }
+            _bytes = 0;
+        }
+
+        std::shared_ptr<Account> _account;
+        int64_t _bytes = 0;
+    };
+
+    static MemoryBudget& shared() noexcept {
+        static MemoryBudget budget;
+        return budget;
+    }
+
+    // 0 lifts the limit
+    void set_limit(size_t bytes) noexcept {
+        _limit.store(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    }
+
+    bool exceeded() const noexcept {
+        const int64_t limit = _limit.load(std::memory_order_relaxed);
+        return limit > 0 && _total.load(std::memory_order_relaxed) > limit;
+    }
+
+    int64_t total() const noexcept {
+        return _total.load(std::memory_order_relaxed);
+    }
+
+private:
+    MemoryBudget() = default;
+
+    std::atomic<int64_t> _limit{0};
+    std::atomic<int64_t> _total{0};
+};
+
+} // namespace margelo::nitro::nitroeventsource
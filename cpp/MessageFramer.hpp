@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+// How each binary message announces its length
+enum class LengthPrefix { VARINT, U32_BE };
+
+template <typename Sink>
+concept MessageSink = requires(Sink& sink, std::string_view message, bool flag) {
+    { sink.on_message(message, flag) } -> std::same_as<void>;
+};
+
+/**
+ * Splits a rawMode body into length-prefixed binary messages: a protobuf-style
+ * unsigned varint or a 32-bit big-endian length, then that many bytes. Like
+ * RecordFramer, feed() takes pieces split anywhere, hands complete messages
+ * over in place and copies only one that spans reads. A message over
+ * `max_message_bytes` is skipped without being buffered and reaches
+ * on_message() empty, with `oversized` set. One thread feeds it.
+ */
+template <MessageSink Sink>
+class MessageFramer {
+public:
+    MessageFramer(Sink sink, LengthPrefix prefix, size_t max_message_bytes = SIZE_MAX) noexcept
+        : _sink(std::move(sink)), _prefix(prefix), _max_message_bytes(max_message_bytes) {}
+
+    // False on a malformed prefix, a varint past 64 bits: the body is out of step from there on
+    bool feed(std::string_view chunk) noexcept {
+        size_t at = 0;
+        while (at < chunk.size()) {
+            if (_skip > 0) {
+                const size_t skipped = static_cast<size_t>(std::min<uint64_t>(_skip, chunk.size() - at));
+                _skip -= skipped;
+                at += skipped;
+                continue;
+            }
+
+            if (!_length_known) {
+                if (!read_prefix(chunk, at)) {
+                    return false;
+                }
+                if (!_length_known) {
+                    break;
+                }
+                if (_length > _max_message_bytes) {
+                    _skip = _length;
+                    next_message();
+                    _sink.on_message({}, true);
+                    continue;
+                }
+            }
+
+            const size_t length = static_cast<size_t>(_length);
+            const size_t available = chunk.size() - at;
+            if (_partial.empty() && available >= length) {
+                next_message();
+                _sink.on_message(chunk.substr(at, length), false);
+                at += length;
+                continue;
+            }
+            const size_t taken = std::min(length - _partial.size(), available);
+            _partial.append(chunk.substr(at, taken));
+            at += taken;
+            if (_partial.size() == length) {
+                next_message();
+                _sink.on_message(_partial, false);
+                _partial.clear();
+            }
+        }
+        return true;
+    }
+
+    // Forgets the message in progress, e.g. when the connection it came from is gone
+    void reset() noexcept {
+        _partial.clear();
+        _skip = 0;
+        _prefix_bytes = 0;
+        next_message();
+    }
+
+private:
+    static constexpr size_t MAX_VARINT_BYTES = 10;
+
+    // Consumes prefix bytes from `at`; _length_known once the whole prefix is in
+    bool read_prefix(std::string_view chunk, size_t& at) noexcept {
+        while (at < chunk.size()) {
+            const auto byte = static_cast<uint8_t>(chunk[at++]);
+            if (_prefix == LengthPrefix::U32_BE) {
+                _length = _length << 8 | byte;
+                if (++_prefix_bytes == 4) {
+                    return finish_prefix();
+                }
+                continue;
+            }
+            // The tenth byte holds the 64th bit and nothing more
+            if (_prefix_bytes == MAX_VARINT_BYTES - 1 && byte > 1) {
+                return false;
+            }
+            _length |= static_cast<uint64_t>(byte & 0x7F) << (7 * _prefix_bytes++);
+            if ((byte & 0x80) == 0) {
+                return finish_prefix();
+            }
+        }
+        return true;
+    }
+
+    void next_message() noexcept {
+        _length = 0;
+        _length_known = false;
+    }
+
+    bool finish_prefix() noexcept {
+        _prefix_bytes = 0;
+        _length_known = true;
+        return true;
+    }
+
+    Sink _sink;
+    const LengthPrefix _prefix;
+    const size_t _max_message_bytes;
+    // The length being read, or of the message in progress once _length_known
+    uint64_t _length = 0;
+    bool _length_known = false;
+    size_t _prefix_bytes = 0;
+    // The message spanning reads so far
+    std::string _partial;
+    // Bytes left of an oversized message
+    uint64_t _skip = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
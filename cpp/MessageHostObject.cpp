@@ -0,0 +1,84 @@
+#include "MessageHostObject.hpp"
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace margelo::nitro::nitroeventsource {
+
+const std::vector<std::vector<proto_wire::Field>>& MessageHostObject::fields() {
+    if (!_fields) {
+        _fields.emplace(_schema->entries().size());
+        const std::string_view message(reinterpret_cast<const char*>(_message->data()), _message->size());
+        _schema->for_each_field(message, [&](size_t entry, const proto_wire::Field& field) { (*_fields)[entry].push_back(field); });
+    }
+    return *_fields;
+}
+
+jsi::Value MessageHostObject::to_jsi(jsi::Runtime& runtime, const proto_wire::Field& field, ProtoFieldType type) {
+    if (type == ProtoFieldType::STRING) {
+        return jsi::String::createFromUtf8(runtime, reinterpret_cast<const uint8_t*>(field.bytes.data()), field.bytes.size());
+    }
+    // A view into the message, which it keeps alive
+    auto* bytes = reinterpret_cast<uint8_t*>(const_cast<char*>(field.bytes.data()));
+    return JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, ArrayBuffer::wrap(bytes, field.bytes.size(), [message = _message]() {}));
+}
+
+jsi::Value MessageHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& name) {
+    const std::optional<size_t> index = _schema->find_name(name.utf8(runtime));
+    if (!index) {
+        return jsi::Value::undefined();
+    }
+    const ProtoSchema::Entry& entry = _schema->entries()[*index];
+    const std::vector<proto_wire::Field>& found = fields()[*index];
+    const bool length_delimited = proto_wire::is_length_delimited(entry.type);
+    const auto scalar = [&](uint64_t bits) {
+        return std::visit([](auto value) { return jsi::Value(value); }, proto_wire::scalar_value(bits, entry.type));
+    };
+
+    if (entry.repeated) {
+        std::vector<jsi::Value> values;
+        for (const proto_wire::Field& field : found) {
+            if (length_delimited) {
+                if (field.wire == proto_wire::WireType::LEN) {
+                    values.push_back(to_jsi(runtime, field, entry.type));
+                }
+            } else {
+                proto_wire::for_each_scalar(field, entry.type, [&](uint64_t bits) { values.push_back(scalar(bits)); });
+            }
+        }
+        jsi::Array array(runtime, values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            array.setValueAtIndex(runtime, i, std::move(values[i]));
+        }
+        return array;
+    }
+
+    // Per protobuf, the last occurrence of a singular field wins
+    for (auto it = found.rbegin(); it != found.rend(); ++it) {
+        if (length_delimited) {
+            if (it->wire == proto_wire::WireType::LEN) {
+                return to_jsi(runtime, *it, entry.type);
+            }
+            continue;
+        }
+        std::optional<uint64_t> last;
+        proto_wire::for_each_scalar(*it, entry.type, [&](uint64_t bits) { last = bits; });
+        if (last) {
+            return scalar(*last);
+        }
+    }
+    return jsi::Value::undefined();
+}
+
+std::vector<jsi::PropNameID> MessageHostObject::getPropertyNames(jsi::Runtime& runtime) {
+    std::vector<jsi::PropNameID> names;
+    names.reserve(_schema->entries().size());
+    for (const ProtoSchema::Entry& entry : _schema->entries()) {
+        names.push_back(jsi::PropNameID::forUtf8(runtime, entry.name));
+    }
+    return names;
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ProtoMessage.hpp"
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/JSIConverter.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * A binary message handed to JS by decodeMessage(), read through the stream's
+ * `messageSchema`. Keeps the ArrayBuffer and decodes a field only when JS
+ * reads it: strings are created from the message bytes, `bytes` fields are
+ * ArrayBuffers viewing them, and absent fields read as undefined. The message
+ * is walked once, on the first read.
+ */
+class MessageHostObject final : public jsi::HostObject {
+public:
+    MessageHostObject(std::shared_ptr<ArrayBuffer> message, std::shared_ptr<const ProtoSchema> schema)
+        : _message(std::move(message)), _schema(std::move(schema)) {}
+
+    jsi::Value get(jsi::Runtime& runtime, const jsi::PropNameID& name) override;
+    std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& runtime) override;
+
+private:
+    // Per schema entry, its fields in wire order
+    const std::vector<std::vector<proto_wire::Field>>& fields();
+    jsi::Value to_jsi(jsi::Runtime& runtime, const proto_wire::Field& field, ProtoFieldType type);
+
+    const std::shared_ptr<ArrayBuffer> _message;
+    const std::shared_ptr<const ProtoSchema> _schema;
+    std::optional<std::vector<std::vector<proto_wire::Field>>> _fields;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,250 @@
+#include "MetricsReporter.hpp"
+
+#include "HybridNitroEventSource.hpp"
+#include "JsonValue.hpp"
+#include "Logger.hpp"
+#include "TransferEngine.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr auto TAG = "MetricsReporter";
+
+// Writes the members of one JSON object, commas included
+class ObjectWriter {
+public:
+    explicit ObjectWriter(std::string& out) : _out(out) {
+        _out += '{';
+    }
+    ~ObjectWriter() {
+        _out += '}';
+    }
+
+    std::string& key(std::string_view name) {
+        if (!_first) {
+            _out += ',';
+        }
+        _first = false;
+        serialize_string(name, _out);
+        _out += ':';
+        return _out;
+    }
+
+    void number(std::string_view name, double value) {
+        serialize_number(value, key(name));
+    }
+
+    void boolean(std::string_view name, bool value) {
+        key(name) += value ? "true" : "false";
+    }
+
+    void string(std::string_view name, std::string_view value) {
+        serialize_string(value, key(name));
+    }
+
+private:
+    std::string& _out;
+    bool _first = true;
+};
+
+void write_histogram(std::string_view name, const LatencyHistogram& histogram, ObjectWriter& parent) {
+    ObjectWriter object(parent.key(name));
+    object.number("count", histogram.count);
+    object.number("sumUs", histogram.sumUs);
+    object.number("maxUs", histogram.maxUs);
+    object.number("p50Us", histogram.p50Us);
+    object.number("p90Us", histogram.p90Us);
+    object.number("p99Us", histogram.p99Us);
+    std::string& out = object.key("buckets");
+    out += '[';
+    for (size_t i = 0; i < histogram.buckets.size(); ++i) {
+        if (i != 0) {
+            out += ',';
+        }
+        serialize_number(histogram.buckets[i], out);
+    }
+    out += ']';
+}
+
+void write_metrics(const EventSourceMetrics& metrics, std::string& out) {
+    ObjectWriter object(out);
+    object.number("pooledEvents", metrics.pooledEvents);
+    object.number("poolHits", metrics.poolHits);
+    object.number("poolMisses", metrics.poolMisses);
+    object.number("bytesReceived", metrics.bytesReceived);
+    object.number("eventsParsed", metrics.eventsParsed);
+    object.number("eventsDispatched", metrics.eventsDispatched);
+    object.number("eventsDropped", metrics.eventsDropped);
+    object.number("reconnects", metrics.reconnects);
+    object.number("connectedMs", metrics.connectedMs);
+    write_histogram("parseTime", metrics.parseTime, object);
+    write_histogram("dispatchLatency", metrics.dispatchLatency, object);
+    write_histogram("serverLatency", metrics.serverLatency, object);
+    write_histogram("nativeLatency", metrics.nativeLatency, object);
+    if (metrics.lastConnection) {
+        const ConnectionTiming& timing = *metrics.lastConnection;
+        ObjectWriter connection(object.key("lastConnection"));
+        connection.number("dnsMs", timing.dnsMs);
+        connection.number("connectMs", timing.connectMs);
+        connection.number("tlsMs", timing.tlsMs);
+        connection.number("firstByteMs", timing.firstByteMs);
+        connection.number("totalMs", timing.totalMs);
+        connection.boolean("reused", timing.reused);
+    }
+    write_histogram("timeToFirstByte", metrics.timeToFirstByte, object);
+    object.number("commentsReceived", metrics.commentsReceived);
+    if (metrics.lastCommentAt) {
+        object.number("lastCommentAt", *metrics.lastCommentAt);
+    }
+    object.boolean("proxyBuffering", metrics.proxyBuffering);
+    object.number("bufferedBursts", metrics.bufferedBursts);
+    object.number("eventsSampledOut", metrics.eventsSampledOut);
+    object.number("eventsAggregated", metrics.eventsAggregated);
+    object.number("bufferedBytes", metrics.bufferedBytes);
+    object.number("idsIgnored", metrics.idsIgnored);
+    object.number("cpuParseMs", metrics.cpuParseMs);
+    object.number("cpuDecodeMs", metrics.cpuDecodeMs);
+    object.number("cpuDispatchMs", metrics.cpuDispatchMs);
+    object.number("heartbeatsMissed", metrics.heartbeatsMissed);
+    if (metrics.connectionQuality) {
+        object.number("heartbeatDelayMs", metrics.heartbeatDelayMs.value_or(0.0));
+        object.number("heartbeatDelayTrendMs", metrics.heartbeatDelayTrendMs.value_or(0.0));
+        object.number("heartbeatJitterMs", metrics.heartbeatJitterMs.value_or(0.0));
+        object.number("connectionQuality", *metrics.connectionQuality);
+    }
+    object.number("slowListenerCalls", metrics.slowListenerCalls);
+    if (metrics.slowestListener) {
+        object.string("slowestListener", *metrics.slowestListener);
+        object.number("slowestListenerMs", metrics.slowestListenerMs.value_or(0.0));
+    }
+}
+
+bool write_all(int fd, std::string_view bytes) noexcept {
+    while (!bytes.empty()) {
+        const ssize_t written = ::write(fd, bytes.data(), bytes.size());
+        if (written < 0) {
+            return false;
+        }
+        bytes.remove_prefix(static_cast<size_t>(written));
+    }
+    return true;
+}
+
+} // namespace
+
+MetricsReporter& MetricsReporter::shared() {
+    // Leaked like the TransferEngine its loop runs on
+    static MetricsReporter* reporter = new MetricsReporter();
+    return *reporter;
+}
+
+void MetricsReporter::report_to_file(std::optional<std::string> path, size_t max_bytes, std::chrono::milliseconds interval) {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    _path = std::move(path);
+    _max_bytes = max_bytes;
+    restart(interval);
+}
+
+void MetricsReporter::set_sink(Sink sink, std::chrono::milliseconds interval) {
+    // Released outside the lock, it may hold the SDK's own state
+    std::shared_ptr<const Sink> previous;
+    const std::lock_guard<std::mutex> lock(_mutex);
+    previous = std::exchange(_sink, sink ? std::make_shared<const Sink>(std::move(sink)) : nullptr);
+    restart(interval);
+}
+
+void MetricsReporter::restart(std::chrono::milliseconds interval) {
+    constexpr std::chrono::milliseconds MIN_INTERVAL{1000};
+
+    _interval = std::max(MIN_INTERVAL, interval);
+    const uint64_t generation = ++_generation;
+    if (!_path && !_sink) {
+        return;
+    }
+    // Reports start one interval from now
+    TransferEngine::shared().schedule(TransferEngine::Clock::now() + _interval, [generation]() noexcept { shared().report(generation); },
+                                      TransferEngine::Priority::BACKGROUND);
+}
+
+void MetricsReporter::report(uint64_t generation) noexcept {
+    std::optional<std::string> path;
+    size_t max_bytes = 0;
+    std::shared_ptr<const Sink> sink;
+    std::chrono::milliseconds interval{};
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (_generation != generation) {
+            return;
+        }
+        path = _path;
+        max_bytes = _max_bytes;
+        sink = _sink;
+        interval = _interval;
+    }
+
+    try {
+        const std::vector<HybridNitroEventSource::LiveMetrics> streams = HybridNitroEventSource::live_metrics();
+        if (!streams.empty()) {
+            std::string line;
+            {
+                ObjectWriter report(line);
+                const auto now = std::chrono::system_clock::now().time_since_epoch();
+                report.number("at", static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count()));
+                std::string& out = report.key("streams");
+                out += '[';
+                for (size_t i = 0; i < streams.size(); ++i) {
+                    if (i != 0) {
+                        out += ',';
+                    }
+                    ObjectWriter stream(out);
+                    stream.number("id", static_cast<double>(streams[i].id));
+                    serialize_string(streams[i].url, stream.key("url"));
+                    write_metrics(streams[i].metrics, stream.key("metrics"));
+                }
+                out += ']';
+            }
+            if (path) {
+                append(*path, max_bytes, line + '\n');
+            }
+            if (sink) {
+                (*sink)(line);
+            }
+        }
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to report metrics: " + std::string(e.what()));
+    } catch (...) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to report metrics");
+    }
+
+    TransferEngine::shared().schedule(TransferEngine::Clock::now() + interval, [generation]() noexcept { shared().report(generation); },
+                                      TransferEngine::Priority::BACKGROUND);
+}
+
+void MetricsReporter::append(const std::string& path, size_t max_bytes, std::string_view line) noexcept {
+    struct stat existing {};
+    if (max_bytes > 0 && ::stat(path.c_str(), &existing) == 0 && existing.st_size > 0 &&
+        static_cast<size_t>(existing.st_size) + line.size() > max_bytes) {
+        // Keeps one full file for an upload that has not picked it up yet
+        std::rename(path.c_str(), (path + ".1").c_str());
+    }
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        NITRO_ES_LOG_WARN(TAG, "Cannot open metrics report file " + path);
+        return;
+    }
+    // O_APPEND writes land at the end even while a reader truncates the file
+    if (!write_all(fd, line)) {
+        NITRO_ES_LOG_WARN(TAG, "Failed to append to metrics report file " + path);
+    }
+    ::close(fd);
+}
+
+} // namespace margelo::nitro::nitroeventsource
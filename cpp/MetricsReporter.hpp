@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Reports getMetrics() of every open stream natively, without JS: each
+ * interval (default 60 s) the I/O thread writes one JSON line holding all of
+ * them. The line is appended to the `metricsReport` file JS configured, and/or
+ * handed to the sink an app's native telemetry SDK installed with set_sink().
+ * Counters are totals since each stream opened; histograms carry their log2
+ * microsecond buckets, so reports can be diffed and merged downstream.
+ *
+ *   {"at":<epoch ms>,"streams":[{"id":1,"url":"...","metrics":{...}}]}
+ */
+class MetricsReporter {
+public:
+    // One report without its trailing newline, called on the I/O thread
+    using Sink = std::function<void(std::string_view report)>;
+
+    static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{60000};
+    static constexpr size_t DEFAULT_MAX_FILE_BYTES = 1024 * 1024;
+
+    static MetricsReporter& shared();
+
+    MetricsReporter(const MetricsReporter&) = delete;
+    MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+    // Appends reports to `path`; past `max_bytes` it moves to `path`.1, replacing the one before.
+    // nullopt stops appending. The interval is shared with the sink, the last one set wins
+    void report_to_file(std::optional<std::string> path, size_t max_bytes = DEFAULT_MAX_FILE_BYTES,
+                        std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+    // For native callers; nullptr removes the sink
+    void set_sink(Sink sink, std::chrono::milliseconds interval = DEFAULT_INTERVAL);
+
+private:
+    MetricsReporter() = default;
+    ~MetricsReporter() = default;
+
+    // With _mutex held: stops the current loop and starts one if anything receives reports
+    void restart(std::chrono::milliseconds interval);
+    void report(uint64_t generation) noexcept;
+    static void append(const std::string& path, size_t max_bytes, std::string_view line) noexcept;
+
+    std::mutex _mutex;
+    std::optional<std::string> _path;
+    size_t _max_bytes = DEFAULT_MAX_FILE_BYTES;
+    std::shared_ptr<const Sink> _sink;
+    std::chrono::milliseconds _interval = DEFAULT_INTERVAL;
+    // Bumped by every change, which stops the reporting loop started before
+    uint64_t _generation = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
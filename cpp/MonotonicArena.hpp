@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Bump allocator for short-lived, same-lifetime allocations.
+ * Memory is handed out from large blocks and only released all at once when the
+ * arena is destroyed, so a whole decoded payload costs one or two
+ * heap allocations instead of one per string and container.
+ */
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t initial_block_size = 1024)
+        : _next_block_size(std::max<size_t>(initial_block_size, 64)) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment) {
+        uintptr_t aligned = align_up(_cursor, alignment);
+        if (_cursor == 0 || aligned + bytes > _end) {
+            grow(bytes + alignment);
+            aligned = align_up(_cursor, alignment);
+        }
+        _cursor = aligned + bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Bytes held in blocks, used or not
+    size_t reserved_bytes() const noexcept {
+        return _reserved_bytes;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size;
+    };
+
+    static uintptr_t align_up(uintptr_t value, size_t alignment) noexcept {
+        return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    }
+
+    void grow(size_t min_bytes) {
+        const size_t size = std::max(_next_block_size, min_bytes);
+        // Left uninitialised: every byte is constructed over before it is read
+        _blocks.push_back(Block{std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+        _cursor = reinterpret_cast<uintptr_t>(_blocks.back().data.get());
+        _end = _cursor + size;
+        _reserved_bytes += size;
+        _next_block_size = size * 2;
+    }
+
+    std::vector<Block> _blocks;
+    uintptr_t _cursor = 0;
+    uintptr_t _end = 0;
+    size_t _reserved_bytes = 0;
+    size_t _next_block_size;
+};
+
+// STL allocator drawing from a MonotonicArena; deallocation is a no-op
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(MonotonicArena* arena) noexcept : _arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.arena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    MonotonicArena* arena() const noexcept {
+        return _arena;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return _arena == other.arena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return _arena != other.arena();
+    }
+
+private:
+    MonotonicArena* _arena;
+};
+
+} // namespace margelo::nitro::nitroeventsource
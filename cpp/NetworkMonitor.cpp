@@ -0,0 +1,106 @@
+#include "NetworkMonitor.hpp"
+
+#include <utility>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <Network/Network.h>
+#include <dispatch/dispatch.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+NetworkMonitor& NetworkMonitor::shared() {
+    // Intentionally leaked like the TransferEngine, the platform keeps reporting until exit
+    static NetworkMonitor* monitor = [] {
+        auto* instance = new NetworkMonitor();
+        start_platform_monitor();
+        return instance;
+    }();
+    return *monitor;
+}
+
+uint64_t NetworkMonitor::subscribe(Listener listener) {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t id = _next_id++;
+    _listeners.emplace(id, std::move(listener));
+    return id;
+}
+
+void NetworkMonitor::unsubscribe(uint64_t id) noexcept {
+    Listener listener;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _listeners.find(id);
+        if (it == _listeners.end()) {
+            return;
+        }
+        // Destroyed outside the lock, it may hold the last reference to a stream
+        listener = std::move(it->second);
+        _listeners.erase(it);
+    }
+}
+
+void NetworkMonitor::report(bool online, uint64_t interface_id) noexcept {
+    std::vector<Listener> listeners;
+    bool interface_changed = false;
+    {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        const bool was_online = _online.load(std::memory_order_relaxed);
+        interface_changed = online && was_online && _reported && interface_id != _interface_id;
+        _reported = true;
+        _interface_id = interface_id;
+        if (online == was_online && !interface_changed) {
+            return;
+        }
+        _online.store(online, std::memory_order_release);
+
+        try {
+            listeners.reserve(_listeners.size());
+            for (const auto& [id, listener] : _listeners) {
+                listeners.push_back(listener);
+            }
+        } catch (...) {
+            return;
+        }
+    }
+
+    for (const Listener& listener : listeners) {
+        try {
+            listener(online, interface_changed);
+        } catch (...) {
+            // A listener only posts to the I/O thread, there is nobody to report to
+        }
+    }
+}
+
+#if defined(__APPLE__)
+
+void NetworkMonitor::start_platform_monitor() noexcept {
+    // Kept for the life of the process, so neither object is ever released
+    nw_path_monitor_t monitor = nw_path_monitor_create();
+    if (!monitor) {
+        return;
+    }
+    dispatch_queue_t queue = dispatch_queue_create("com.nitroeventsource.network", DISPATCH_QUEUE_SERIAL);
+    nw_path_monitor_set_queue(monitor, queue);
+    nw_path_monitor_set_update_handler(monitor, ^(nw_path_t path) {
+        // The first interface is the one new connections use
+        __block uint64_t interface_id = 0;
+        nw_path_enumerate_interfaces(path, ^bool(nw_interface_t interface) {
+            interface_id = nw_interface_get_index(interface);
+            return false;
+        });
+        NetworkMonitor::shared().report(nw_path_get_status(path) == nw_path_status_satisfied, interface_id);
+    });
+    nw_path_monitor_start(monitor);
+}
+
+#elif !defined(__ANDROID__)
+
+void NetworkMonitor::start_platform_monitor() noexcept {}
+
+#endif
+// Android: NetworkMonitorAndroid.cpp, ConnectivityManager is only reachable through Java
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Process-wide view of the device's connectivity, fed by the platform:
+ * NWPathMonitor on Apple platforms and ConnectivityManager's default network
+ * callback on Android. Elsewhere nothing reports and the device always reads
+ * as online. Listeners run on whichever thread the platform reports from.
+ */
+class NetworkMonitor {
+public:
+    // `interface_changed`: still online, but over another interface, e.g. Wi-Fi to cellular
+    using Listener = std::function<void(bool /* online */, bool /* interface_changed */)>;
+
+    static NetworkMonitor& shared();
+
+    NetworkMonitor(const NetworkMonitor&) = delete;
+    NetworkMonitor& operator=(const NetworkMonitor&) = delete;
+
+    uint64_t subscribe(Listener listener);
+    void unsubscribe(uint64_t id) noexcept;
+
+    bool online() const noexcept { return _online.load(std::memory_order_acquire); }
+
+    // Platform glue: the current reachability and an id for the interface in use, 0 when unknown
+    void report(bool online, uint64_t interface_id) noexcept;
+
+private:
+    NetworkMonitor() = default;
+    ~NetworkMonitor() = default;
+
+    // Defined per platform, starts delivering report() calls
+    static void start_platform_monitor() noexcept;
+
+    std::atomic<bool> _online{true};
+    std::mutex _mutex;
+    bool _reported = false;
+    uint64_t _interface_id = 0;
+    uint64_t _next_id = 1;
+    std::unordered_map<uint64_t, Listener> _listeners;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "MessageSchema.hpp"
+#include "ProtoFieldType.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Protobuf wire format, read in place: no generated code and no copy of the
+ * message. Groups and malformed input end the walk, fields decode lazily
+ * from the views it yields.
+ */
+namespace proto_wire {
+
+    enum class WireType : uint8_t { VARINT = 0, I64 = 1, LEN = 2, I32 = 5 };
+
+    struct Field {
+        uint32_t number = 0;
+        WireType wire = WireType::VARINT;
+        // VARINT, I64 and I32 values
+        uint64_t bits = 0;
+        // LEN contents
+        std::string_view bytes;
+    };
+
+    inline bool read_varint(std::string_view message, size_t& at, uint64_t& value) noexcept {
+        value = 0;
+        for (size_t shift = 0; shift < 64 && at < message.size(); shift += 7) {
+            const auto byte = static_cast<uint8_t>(message[at++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline bool read_fixed(std::string_view message, size_t& at, size_t size, uint64_t& value) noexcept {
+        if (message.size() - at < size) {
+            return false;
+        }
+        // Little-endian on the wire as on every platform this builds for
+        value = 0;
+        std::memcpy(&value, message.data() + at, size);
+        at += size;
+        return true;
+    }
+
+    // The field at `at`, which moves past it; false at the end of the message or on malformed input
+    inline bool next_field(std::string_view message, size_t& at, Field& field) noexcept {
+        uint64_t tag = 0;
+        if (at >= message.size() || !read_varint(message, at, tag) || (tag >> 3) == 0 || (tag >> 3) > UINT32_MAX) {
+            return false;
+        }
+        field.number = static_cast<uint32_t>(tag >> 3);
+        field.bytes = {};
+        switch (tag & 7) {
+            case 0:
+                field.wire = WireType::VARINT;
+                return read_varint(message, at, field.bits);
+            case 1:
+                field.wire = WireType::I64;
+                return read_fixed(message, at, 8, field.bits);
+            case 5:
+                field.wire = WireType::I32;
+                return read_fixed(message, at, 4, field.bits);
+            case 2: {
+                uint64_t length = 0;
+                if (!read_varint(message, at, length) || length > message.size() - at) {
+                    return false;
+                }
+                field.wire = WireType::LEN;
+                field.bytes = message.substr(at, static_cast<size_t>(length));
+                at += static_cast<size_t>(length);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    constexpr bool is_length_delimited(ProtoFieldType type) noexcept {
+        return type == ProtoFieldType::STRING || type == ProtoFieldType::BYTES;
+    }
+
+    constexpr WireType wire_type_of(ProtoFieldType type) noexcept {
+        switch (type) {
+            case ProtoFieldType::DOUBLE:
+            case ProtoFieldType::FIXED64:
+            case ProtoFieldType::SFIXED64:
+                return WireType::I64;
+            case ProtoFieldType::FLOAT:
+            case ProtoFieldType::FIXED32:
+            case ProtoFieldType::SFIXED32:
+                return WireType::I32;
+            case ProtoFieldType::STRING:
+            case ProtoFieldType::BYTES:
+                return WireType::LEN;
+            default:
+                return WireType::VARINT;
+        }
+    }
+
+    // A number or bool as JS sees it; 64-bit integers past 2^53 lose precision
+    inline std::variant<double, bool> scalar_value(uint64_t bits, ProtoFieldType type) noexcept {
+        const auto zigzag = [](uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); };
+        switch (type) {
+            case ProtoFieldType::BOOL: return bits != 0;
+            case ProtoFieldType::INT32:
+            case ProtoFieldType::SFIXED32: return static_cast<double>(static_cast<int32_t>(static_cast<uint32_t>(bits)));
+            case ProtoFieldType::UINT32:
+            case ProtoFieldType::FIXED32: return static_cast<double>(static_cast<uint32_t>(bits));
+            case ProtoFieldType::INT64:
+            case ProtoFieldType::SFIXED64: return static_cast<double>(static_cast<int64_t>(bits));
+            case ProtoFieldType::SINT32: return static_cast<double>(static_cast<int32_t>(zigzag(bits & 0xFFFFFFFFu)));
+            case ProtoFieldType::SINT64: return static_cast<double>(zigzag(bits));
+            case ProtoFieldType::DOUBLE: {
+                double value = 0;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            case ProtoFieldType::FLOAT: {
+                const auto narrow = static_cast<uint32_t>(bits);
+                float value = 0;
+                std::memcpy(&value, &narrow, sizeof(value));
+                return static_cast<double>(value);
+            }
+            default: return static_cast<double>(bits);
+        }
+    }
+
+    // Calls `visit(bits)` per element of a numeric field, whether sent packed or one by one
+    template <typename Visit>
+    bool for_each_scalar(const Field& field, ProtoFieldType type, Visit&& visit) noexcept {
+        const WireType expected = wire_type_of(type);
+        if (field.wire == expected) {
+            visit(field.bits);
+            return true;
+        }
+        if (field.wire != WireType::LEN) {
+            return false;
+        }
+        size_t at = 0;
+        while (at < field.bytes.size()) {
+            uint64_t bits = 0;
+            const bool read = expected == WireType::VARINT ? read_varint(field.bytes, at, bits)
+                                                           : read_fixed(field.bytes, at, expected == WireType::I64 ? 8 : 4, bits);
+            if (!read) {
+                return false;
+            }
+            visit(bits);
+        }
+        return true;
+    }
+
+} // namespace proto_wire
+
+/**
+ * A `messageSchema` indexed for decoding: field names for JS, numbers for the
+ * wire. Built once when the stream is created and shared by every message.
+ */
+class ProtoSchema {
+public:
+    struct Entry {
+        std::string name;
+        uint32_t number;
+        ProtoFieldType type;
+        bool repeated;
+    };
+
+    explicit ProtoSchema(const MessageSchema& schema) {
+        _entries.reserve(schema.fields.size());
+        for (const ProtoField& field : schema.fields) {
+            if (field.number < 1 || field.number > 536870911.0) {
+                continue;
+            }
+            _entries.push_back(Entry{field.name, static_cast<uint32_t>(field.number), field.type, field.repeated.value_or(false)});
+        }
+        for (size_t i = 0; i < _entries.size(); ++i) {
+            _by_name.emplace(_entries[i].name, i);
+            _by_number.emplace(_entries[i].number, i);
+        }
+    }
+
+    const std::vector<Entry>& entries() const noexcept {
+        return _entries;
+    }
+
+    std::optional<size_t> find_name(const std::string& name) const noexcept {
+        const auto it = _by_name.find(name);
+        return it == _by_name.end() ? std::nullopt : std::optional(it->second);
+    }
+
+    std::optional<size_t> find_number(uint32_t number) const noexcept {
+        const auto it = _by_number.find(number);
+        return it == _by_number.end() ? std::nullopt : std::optional(it->second);
+    }
+
+    // Calls `visit(entry, field)` for each field of `message` the schema names, in wire order
+    template <typename Visit>
+    void for_each_field(std::string_view message, Visit&& visit) const noexcept {
+        size_t at = 0;
+        proto_wire::Field field;
+        while (proto_wire::next_field(message, at, field)) {
+            if (const std::optional<size_t> entry = find_number(field.number)) {
+                visit(*entry, field);
+            }
+        }
+    }
+
+private:
+    std::vector<Entry> _entries;
+    std::unordered_map<std::string, size_t> _by_name;
+    std::unordered_map<uint32_t, size_t> _by_number;
+};
+
+} // namespace margelo::nitro::nitroeventsource
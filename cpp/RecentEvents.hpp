@@ -0,0 +1,74 @@
+#pragma once
+
+#include "NitroEventSourceEvent.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The last `max_events` events of a stream, of every type, for listeners that
+ * attach late. Written on the I/O thread, read on the JS thread; each entry is
+ * a copy, the event itself goes on to JS. Entries older than `max_age` are
+ * neither replayed nor kept.
+ */
+class RecentEvents {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RecentEvents(size_t max_events, std::optional<Clock::duration> max_age) : _max_events(max_events), _max_age(max_age) {}
+
+    void record(NitroEventSourceEvent event, Clock::time_point now) noexcept {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        expire(now);
+        if (_entries.size() == _max_events) {
+            _entries.pop_front();
+        }
+        try {
+            _entries.emplace_back(now, std::move(event));
+        } catch (const std::bad_alloc&) {
+        }
+    }
+
+    // The kept events of `type`, oldest first
+    std::vector<NitroEventSourceEvent> of_type(std::string_view type, Clock::time_point now) {
+        std::vector<NitroEventSourceEvent> events;
+        const std::lock_guard<std::mutex> lock(_mutex);
+        expire(now);
+        for (const auto& [received, event] : _entries) {
+            if (event.type == type) {
+                events.push_back(event);
+            }
+        }
+        return events;
+    }
+
+    void clear() noexcept {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+private:
+    void expire(Clock::time_point now) noexcept {
+        if (!_max_age) {
+            return;
+        }
+        while (!_entries.empty() && now - _entries.front().first > *_max_age) {
+            _entries.pop_front();
+        }
+    }
+
+    const size_t _max_events;
+    const std::optional<Clock::duration> _max_age;
+    std::mutex _mutex;
+    std::deque<std::pair<Clock::time_point, NitroEventSourceEvent>> _entries;
+};
+
+} // namespace margelo::nitro::nitroeventsource
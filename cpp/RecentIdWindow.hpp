@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Remembers the last `capacity` event ids so replays can be recognised.
+ * Ids live in a fixed ring, the set only views them, so a full window
+ * recycles the oldest slot instead of allocating.
+ */
+class RecentIdWindow {
+public:
+    explicit RecentIdWindow(size_t capacity = 0) : _slots(capacity) {
+        _lookup.reserve(capacity);
+    }
+
+    size_t capacity() const noexcept {
+        return _slots.size();
+    }
+
+    // Returns true when `id` was already seen, otherwise records it
+    bool check_and_insert(std::string_view id) {
+        if (_slots.empty()) {
+            return false;
+        }
+        if (_lookup.count(id) != 0) {
+            return true;
+        }
+
+        std::string& slot = _slots[_next];
+        if (_size == _slots.size()) {
+            _lookup.erase(slot);
+        } else {
+            ++_size;
+        }
+        slot.assign(id);
+        _lookup.insert(slot);
+        _next = (_next + 1) % _slots.size();
+        return false;
+    }
+
+    void clear() noexcept {
+        _lookup.clear();
+        for (std::string& slot : _slots) {
+            slot.clear();
+        }
+        _size = 0;
+        _next = 0;
+    }
+
+private:
+    std::vector<std::string> _slots;
+    std::unordered_set<std::string_view> _lookup;
+    size_t _size = 0;
+    size_t _next = 0;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Admits the reconnects that all fire when the network comes back a few at a
+ * time, most urgent first, instead of every stream handshaking at once. At
+ * most `max_handshakes` origins connect together, one stream each; once that
+ * stream gets through, the others waiting for its origin go at once and ride
+ * the warm connection (HTTP/2 multiplexes them, HTTP/1.1 resumes its TLS
+ * session). Owned by the I/O thread; the engine bounds how long a stream may
+ * hold its origin's slot.
+ */
+class ReconnectGate {
+public:
+    using Ticket = uint64_t;
+    using Task = std::function<void()>;
+
+    explicit ReconnectGate(size_t max_handshakes) noexcept : _max_handshakes(max_handshakes) {}
+
+    // Queues `start`, higher `priority` first and in order within one; admit() hands it out
+    Ticket enqueue(std::string origin, int priority, Task start) {
+        const Ticket ticket = _next_ticket++;
+        _waiting.push_back(Waiting{ticket, std::move(origin), priority, std::move(start)});
+        return ticket;
+    }
+
+    // The queued starts that may run now. Those that took an origin's slot are also listed in
+    // `holding` and must be finished; the rest follow a warm connection and hold nothing
+    std::vector<std::pair<Ticket, Task>> admit(std::vector<Ticket>* holding) {
+        std::vector<std::pair<Ticket, Task>> admitted;
+        for (Waiting& released : _released) {
+            admitted.emplace_back(released.ticket, std::move(released.start));
+        }
+        _released.clear();
+        while (_handshaking.size() < _max_handshakes) {
+            auto next = _waiting.end();
+            for (auto it = _waiting.begin(); it != _waiting.end(); ++it) {
+                if (!_handshaking.contains(it->origin) && (next == _waiting.end() || it->priority > next->priority)) {
+                    next = it;
+                }
+            }
+            if (next == _waiting.end()) {
+                break;
+            }
+            _handshaking.emplace(next->origin, next->ticket);
+            if (holding) {
+                holding->push_back(next->ticket);
+            }
+            admitted.emplace_back(next->ticket, std::move(next->start));
+            _waiting.erase(next);
+        }
+        return admitted;
+    }
+
+    // Gives up `ticket`'s place in the queue or its origin's slot; `warmed` when its connection
+    // got through, which releases everyone waiting for that origin. Unknown tickets are ignored
+    void finish(Ticket ticket, bool warmed) {
+        for (auto it = _waiting.begin(); it != _waiting.end(); ++it) {
+            if (it->ticket == ticket) {
+                _waiting.erase(it);
+                return;
+            }
+        }
+        for (auto it = _handshaking.begin(); it != _handshaking.end(); ++it) {
+            if (it->second != ticket) {
+                continue;
+            }
+            const std::string origin = it->first;
+            _handshaking.erase(it);
+            if (warmed) {
+                std::erase_if(_waiting, [&](Waiting& waiting) {
+                    if (waiting.origin != origin) {
+                        return false;
+                    }
+                    _released.push_back(std::move(waiting));
+                    return true;
+                });
+            }
+            return;
+        }
+    }
+
+private:
+    struct Waiting {
+        Ticket ticket;
+        std::string origin;
+        int priority;
+        Task start;
+    };
+
+    const size_t _max_handshakes;
+    Ticket _next_ticket = 1;
+    // Queued in arrival order; a few dozen streams at most, so scanning beats keeping a heap
+    std::vector<Waiting> _waiting;
+    std::vector<Waiting> _released;
+    // Origin to the ticket handshaking with it
+    std::unordered_map<std::string, Ticket> _handshaking;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "SseScanner.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+// The bodies besides text/event-stream that carry one JSON text per record
+enum class RecordFormat { NDJSON, JSON_SEQ };
+
+template <typename Sink>
+concept RecordSink = requires(Sink& sink, std::string_view record, bool flag) {
+    { sink.on_record(record, flag) } -> std::same_as<void>;
+};
+
+/**
+ * Splits a body into JSON records for the `format` options that are not SSE:
+ * NDJSON / JSON Lines, one text per line with blank lines skipped, and JSON
+ * text sequences (RFC 7464), each text led by RS (0x1E) and ended by LF. A
+ * sequence text may be pretty-printed over several lines, so its end is the
+ * first LF outside a string with every bracket closed; one that an RS cuts
+ * off before that may be truncated and is dropped, as the RFC advises.
+ *
+ * Like SseParser, feed() takes pieces split anywhere, hands complete records
+ * over in place and copies only a trailing partial one, and one thread feeds
+ * it. A record over `max_record_bytes` is not buffered past the limit and
+ * reaches on_record() empty, with `oversized` set.
+ */
+template <RecordSink Sink>
+class RecordFramer {
+public:
+    RecordFramer(Sink sink, RecordFormat format, size_t max_record_bytes = SIZE_MAX) noexcept
+        : _sink(std::move(sink)), _format(format), _max_record_bytes(max_record_bytes) {}
+
+    void feed(std::string_view chunk) noexcept {
+        if (_format == RecordFormat::NDJSON) {
+            feed_lines(chunk);
+        } else {
+            feed_sequence(chunk);
+        }
+    }
+
+    // Forgets the partial record, e.g. when the connection it came from is gone
+    void reset() noexcept {
+        _partial.clear();
+        _oversized = false;
+        _in_record = false;
+        reset_text();
+    }
+
+private:
+    static constexpr char RS = '\x1E';
+
+    void feed_lines(std::string_view chunk) noexcept {
+        size_t start = 0;
+        size_t pos = 0;
+        while ((pos = sse_scan::find_newline(chunk, start)) != std::string_view::npos) {
+            complete(chunk.substr(start, pos - start));
+            start = pos + 1;
+        }
+        buffer(chunk.substr(start));
+    }
+
+    void feed_sequence(std::string_view chunk) noexcept {
+        // Where the unbuffered part of the open record starts in `chunk`
+        size_t start = 0;
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            const char c = chunk[i];
+            // Never part of a text, JSON escapes it in strings: a record starts, whatever was open
+            if (c == RS) {
+                if (_in_record) {
+                    drop_partial();
+                }
+                _in_record = true;
+                reset_text();
+                start = i + 1;
+                continue;
+            }
+            if (!_in_record) {
+                continue;
+            }
+
+            if (_in_string) {
+                if (_escaped) {
+                    _escaped = false;
+                } else if (c == '\\') {
+                    _escaped = true;
+                } else if (c == '"') {
+                    _in_string = false;
+                }
+                continue;
+            }
+            switch (c) {
+                case '"':
+                    _in_string = true;
+                    _has_text = true;
+                    break;
+                case '{':
+                case '[':
+                    ++_depth;
+                    _has_text = true;
+                    break;
+                case '}':
+                case ']':
+                    _depth -= _depth > 0 ? 1 : 0;
+                    break;
+                case '\n':
+                    if (_depth == 0 && _has_text) {
+                        complete(chunk.substr(start, i - start));
+                        _in_record = false;
+                    }
+                    break;
+                case ' ':
+                case '\t':
+                case '\r':
+                    break;
+                default:
+                    _has_text = true;
+                    break;
+            }
+        }
+        if (_in_record) {
+            buffer(chunk.substr(start));
+        }
+    }
+
+    void buffer(std::string_view part) noexcept {
+        if (_oversized || part.empty()) {
+            return;
+        }
+        if (_partial.size() + part.size() > _max_record_bytes) {
+            std::string().swap(_partial);
+            _oversized = true;
+            return;
+        }
+        _partial.append(part);
+    }
+
+    // `tail`: the record's last piece, after whatever earlier reads left in _partial
+    void complete(std::string_view tail) noexcept {
+        if (std::exchange(_oversized, false)) {
+            _partial.clear();
+            _sink.on_record({}, true);
+            return;
+        }
+
+        std::string_view record = tail;
+        if (!_partial.empty()) {
+            buffer(tail);
+            if (std::exchange(_oversized, false)) {
+                _sink.on_record({}, true);
+                return;
+            }
+            record = _partial;
+        } else if (record.size() > _max_record_bytes) {
+            _sink.on_record({}, true);
+            return;
+        }
+
+        while (!record.empty() && (record.back() == '\r' || record.back() == ' ' || record.back() == '\t')) {
+            record.remove_suffix(1);
+        }
+        if (!record.empty()) {
+            _sink.on_record(record, false);
+        }
+        _partial.clear();
+    }
+
+    void drop_partial() noexcept {
+        _partial.clear();
+        _oversized = false;
+    }
+
+    void reset_text() noexcept {
+        _depth = 0;
+        _in_string = false;
+        _escaped = false;
+        _has_text = false;
+    }
+
+    Sink _sink;
+    const RecordFormat _format;
+    const size_t _max_record_bytes;
+    // The record still waiting for its end
+    std::string _partial;
+    bool _oversized = false;
+    // JSON_SEQ: inside a record, and where its text stands
+    bool _in_record = false;
+    uint32_t _depth = 0;
+    bool _in_string = false;
+    bool _escaped = false;
+    bool _has_text = false;
+};
+
+} // namespace margelo::nitro::nitroeventsource
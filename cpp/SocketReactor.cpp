@@ -0,0 +1,182 @@
+#include "SocketReactor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <sys/event.h>
+#include <sys/time.h>
+#elif defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+// Events taken per wait; more ready sockets are reported by the next one, which does not block
+constexpr size_t MAX_EVENTS = 64;
+}
+
+#if defined(__APPLE__)
+
+namespace {
+constexpr uintptr_t WAKE_IDENT = 1;
+}
+
+SocketReactor::SocketReactor() noexcept : _reactor(kqueue()) {
+    if (_reactor < 0) {
+        return;
+    }
+    struct kevent change;
+    EV_SET(&change, WAKE_IDENT, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, nullptr);
+    if (kevent(_reactor, &change, 1, nullptr, 0, nullptr) != 0) {
+        close(_reactor);
+        _reactor = -1;
+    }
+}
+
+SocketReactor::~SocketReactor() {
+    if (_reactor >= 0) {
+        close(_reactor);
+    }
+}
+
+bool SocketReactor::valid() const noexcept {
+    return _reactor >= 0;
+}
+
+bool SocketReactor::watch(int fd, bool readable, bool writable) noexcept {
+    // A direction not asked for stays registered but disabled, so it never fires
+    struct kevent changes[2];
+    EV_SET(&changes[0], fd, EVFILT_READ, EV_ADD | (readable ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+    EV_SET(&changes[1], fd, EVFILT_WRITE, EV_ADD | (writable ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+    return kevent(_reactor, changes, 2, nullptr, 0, nullptr) == 0;
+}
+
+void SocketReactor::unwatch(int fd) noexcept {
+    // Each delete on its own: one that was never added must not keep the other
+    for (const int16_t filter : {EVFILT_READ, EVFILT_WRITE}) {
+        struct kevent change;
+        EV_SET(&change, fd, filter, EV_DELETE, 0, 0, nullptr);
+        kevent(_reactor, &change, 1, nullptr, 0, nullptr);
+    }
+}
+
+void SocketReactor::wake() noexcept {
+    struct kevent change;
+    EV_SET(&change, WAKE_IDENT, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+    kevent(_reactor, &change, 1, nullptr, 0, nullptr);
+}
+
+size_t SocketReactor::wait(int timeout_ms, Event* events, size_t capacity) noexcept {
+    std::array<struct kevent, MAX_EVENTS> ready;
+    struct timespec timeout;
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = static_cast<long>(timeout_ms % 1000) * 1000000L;
+    const int count = kevent(_reactor, nullptr, 0, ready.data(), static_cast<int>(std::min(capacity, ready.size())),
+                             timeout_ms < 0 ? nullptr : &timeout);
+
+    // kqueue reports each direction on its own; curl takes them one at a time just as well
+    size_t reported = 0;
+    for (int i = 0; i < count; ++i) {
+        const struct kevent& event = ready[static_cast<size_t>(i)];
+        if (event.filter == EVFILT_USER) {
+            continue;
+        }
+        events[reported++] = Event{static_cast<int>(event.ident), event.filter == EVFILT_READ, event.filter == EVFILT_WRITE,
+                                   (event.flags & (EV_EOF | EV_ERROR)) != 0};
+    }
+    return reported;
+}
+
+#elif defined(__linux__)
+
+SocketReactor::SocketReactor() noexcept
+    : _reactor(epoll_create1(EPOLL_CLOEXEC)), _wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    if (_reactor < 0 || _wake_fd < 0) {
+        return;
+    }
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.fd = _wake_fd;
+    if (epoll_ctl(_reactor, EPOLL_CTL_ADD, _wake_fd, &event) != 0) {
+        close(_wake_fd);
+        _wake_fd = -1;
+    }
+}
+
+SocketReactor::~SocketReactor() {
+    if (_wake_fd >= 0) {
+        close(_wake_fd);
+    }
+    if (_reactor >= 0) {
+        close(_reactor);
+    }
+}
+
+bool SocketReactor::valid() const noexcept {
+    return _reactor >= 0 && _wake_fd >= 0;
+}
+
+bool SocketReactor::watch(int fd, bool readable, bool writable) noexcept {
+    struct epoll_event event {};
+    event.events = (readable ? EPOLLIN : 0u) | (writable ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    if (epoll_ctl(_reactor, EPOLL_CTL_MOD, fd, &event) == 0) {
+        return true;
+    }
+    return errno == ENOENT && epoll_ctl(_reactor, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+void SocketReactor::unwatch(int fd) noexcept {
+    epoll_ctl(_reactor, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+void SocketReactor::wake() noexcept {
+    const uint64_t one = 1;
+    // EAGAIN only when the counter is saturated, and then a wake-up is pending anyway
+    [[maybe_unused]] const ssize_t written = write(_wake_fd, &one, sizeof(one));
+}
+
+size_t SocketReactor::wait(int timeout_ms, Event* events, size_t capacity) noexcept {
+    std::array<struct epoll_event, MAX_EVENTS> ready;
+    const int count = epoll_wait(_reactor, ready.data(), static_cast<int>(std::min(capacity, ready.size())), timeout_ms);
+
+    size_t reported = 0;
+    for (int i = 0; i < count; ++i) {
+        const struct epoll_event& event = ready[static_cast<size_t>(i)];
+        if (event.data.fd == _wake_fd) {
+            uint64_t wakeups = 0;
+            [[maybe_unused]] const ssize_t drained = read(_wake_fd, &wakeups, sizeof(wakeups));
+            continue;
+        }
+        events[reported++] = Event{event.data.fd, (event.events & EPOLLIN) != 0, (event.events & EPOLLOUT) != 0,
+                                   (event.events & (EPOLLERR | EPOLLHUP)) != 0};
+    }
+    return reported;
+}
+
+#else
+
+// No reactor: TransferEngine falls back to curl_multi_poll()
+SocketReactor::SocketReactor() noexcept = default;
+SocketReactor::~SocketReactor() = default;
+bool SocketReactor::valid() const noexcept {
+    return false;
+}
+bool SocketReactor::watch(int, bool, bool) noexcept {
+    return false;
+}
+void SocketReactor::unwatch(int) noexcept {}
+void SocketReactor::wake() noexcept {}
+size_t SocketReactor::wait(int, Event*, size_t) noexcept {
+    return 0;
+}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Readiness notification for the sockets libcurl hands out: epoll on Linux and
+ * Android, kqueue on Apple platforms. A wait costs in proportion to the sockets
+ * that are ready, not to every one that is open, and another thread can cut it
+ * short with wake(). Everything but wake() belongs to the thread that waits.
+ */
+class SocketReactor {
+public:
+    struct Event {
+        int fd;
+        bool readable;
+        bool writable;
+        // Hung up or failed; curl finds out which on its next read
+        bool error;
+    };
+
+    SocketReactor() noexcept;
+    ~SocketReactor();
+
+    SocketReactor(const SocketReactor&) = delete;
+    SocketReactor& operator=(const SocketReactor&) = delete;
+
+    // False when the platform refused a reactor or a wake-up channel
+    bool valid() const noexcept;
+
+    // Starts or changes watching `fd`; neither direction stops watching it
+    bool watch(int fd, bool readable, bool writable) noexcept;
+    // Before curl closes `fd`
+    void unwatch(int fd) noexcept;
+
+    // Thread-safe: ends the current or next wait early
+    void wake() noexcept;
+
+    // Blocks until a socket is ready, a wake() or `timeout_ms` (-1: no limit); fills up to
+    // `capacity` events and returns how many, with wake-ups consumed and not reported
+    size_t wait(int timeout_ms, Event* events, size_t capacity) noexcept;
+
+private:
+    int _reactor = -1;
+    // Linux: an eventfd in the epoll set; Apple wakes through an EVFILT_USER event instead
+    int _wake_fd = -1;
+};
+
+} // namespace margelo::nitro::nitroeventsource
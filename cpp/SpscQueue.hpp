@@ -0,0 +1,164 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Unbounded lock-free single-producer/single-consumer queue.
+ * Items live in fixed-size blocks linked in FIFO order: the producer only ever
+ * appends to the tail block and the consumer frees blocks it has drained, so
+ * `push` never waits for the consumer and neither side takes a lock.
+ */
+template <typename T, size_t BlockSize = 256>
+class SpscQueue {
+    static_assert(BlockSize > 0, "SpscQueue blocks must hold at least one item");
+
+public:
+    SpscQueue()
+        : _head(new Block()), _tail(_head) {}
+
+    ~SpscQueue() {
+        while (_head) {
+            const size_t committed = _head->committed.load(std::memory_order_acquire);
+            for (size_t i = _read; i < committed; ++i) {
+                _head->slot(i)->~T();
+            }
+            Block* next = _head->next.load(std::memory_order_acquire);
+            delete _head;
+            _head = next;
+            _read = 0;
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        if (_written == BlockSize) {
+            auto* block = new Block();
+            // Publish the fresh block only after the full one is completely committed
+            _tail->next.store(block, std::memory_order_release);
+            _tail = block;
+            _written = 0;
+        }
+
+        new (_tail->slot(_written)) T(std::forward<Args>(args)...);
+        ++_written;
+        _tail->committed.store(_written, std::memory_order_release);
+    }
+
+    void push(T value) {
+        emplace(std::move(value));
+    }
+
+    // Consumer only
+    std::optional<T> pop() {
+        while (true) {
+            if (_read < _head->committed.load(std::memory_order_acquire)) {
+                T* item = _head->slot(_read++);
+                std::optional<T> value(std::move(*item));
+                item->~T();
+                return value;
+            }
+
+            if (_read < BlockSize) {
+                return std::nullopt;
+            }
+
+            Block* next = _head->next.load(std::memory_order_acquire);
+            if (!next) {
+                return std::nullopt;
+            }
+            delete _head;
+            _head = next;
+            _read = 0;
+        }
+    }
+
+private:
+    struct Block {
+        alignas(T) unsigned char storage[BlockSize * sizeof(T)];
+        std::atomic<size_t> committed{0};
+        std::atomic<Block*> next{nullptr};
+
+        T* slot(size_t index) noexcept {
+            return std::launder(reinterpret_cast<T*>(storage + index * sizeof(T)));
+        }
+    };
+
+    // Consumer side
+    alignas(64) Block* _head;
+    size_t _read = 0;
+
+    // Producer side, kept on its own cache line
+    alignas(64) Block* _tail;
+    size_t _written = 0;
+};
+
+/**
+ * Fixed-capacity single-producer/single-consumer ring.
+ * Never allocates after construction; `try_push` fails instead of growing,
+ * which suits pools where dropping a surplus item is fine.
+ */
+template <typename T, size_t Capacity>
+class BoundedSpscQueue {
+    static_assert(Capacity > 0, "BoundedSpscQueue must hold at least one item");
+
+public:
+    BoundedSpscQueue() = default;
+
+    ~BoundedSpscQueue() {
+        while (pop()) {
+        }
+    }
+
+    BoundedSpscQueue(const BoundedSpscQueue&) = delete;
+    BoundedSpscQueue& operator=(const BoundedSpscQueue&) = delete;
+
+    // Producer only
+    bool try_push(T&& value) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        new (slot(tail)) T(std::move(value));
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    std::optional<T> pop() {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        T* item = slot(head);
+        std::optional<T> value(std::move(*item));
+        item->~T();
+        _head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Approximate when called while the other side is active
+    size_t size() const noexcept {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+private:
+    T* slot(size_t index) noexcept {
+        return std::launder(reinterpret_cast<T*>(_storage + (index % Capacity) * sizeof(T)));
+    }
+
+    alignas(T) unsigned char _storage[Capacity * sizeof(T)];
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,564 @@
+#pragma once
+
+#include "SseScanner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+// Position of a chunk within an event that outgrew SseLimits::chunk_bytes
+enum class SseChunk { BEGIN, CONTINUE, END };
+
+// The fields the spec defines, anything else is OTHER and left to the sink by name
+enum class SseField { DATA, EVENT, ID, RETRY, OTHER };
+
+// One switch on the length, then a single fixed-size compare; no run of string comparisons per line
+constexpr SseField classify_sse_field(std::string_view name) noexcept {
+    switch (name.size()) {
+        case 2: return name == "id" ? SseField::ID : SseField::OTHER;
+        case 4: return name == "data" ? SseField::DATA : SseField::OTHER;
+        case 5:
+            switch (name.front()) {
+                case 'e': return name == "event" ? SseField::EVENT : SseField::OTHER;
+                case 'r': return name == "retry" ? SseField::RETRY : SseField::OTHER;
+                default: return SseField::OTHER;
+            }
+        default: return SseField::OTHER;
+    }
+}
+
+struct SseLimits {
+    // What happens to a line over max_line_bytes or an event over max_event_bytes
+    enum class Oversize { DROP, TRUNCATE, CHUNK };
+
+    size_t max_line_bytes = SIZE_MAX;
+    size_t max_event_bytes = SIZE_MAX;
+    // Data past this many bytes streams out in chunks, SIZE_MAX never chunks
+    size_t chunk_bytes = SIZE_MAX;
+    Oversize oversize = Oversize::DROP;
+
+    size_t chunk_threshold() const noexcept {
+        // The chunk policy turns the size limits into the chunk size instead of a cap
+        return oversize == Oversize::CHUNK ? std::min({chunk_bytes, max_line_bytes, max_event_bytes}) : chunk_bytes;
+    }
+};
+
+// What SseParser needs from its sink, see below
+template <typename Sink>
+concept SseSink = requires(Sink& sink, SseField field, std::string_view text, std::string& data, bool flag, SseChunk position) {
+    { sink.on_field(field, text, text) } -> std::same_as<void>;
+    { sink.on_comment() } -> std::same_as<void>;
+    { sink.on_event(data, flag, flag) } -> std::same_as<void>;
+    { sink.on_data_chunk(data, position) } -> std::same_as<bool>;
+};
+
+/**
+ * Incremental text/event-stream parser. feed() takes the body in pieces split
+ * anywhere; decoding, line framing, CRLF, the size limits and chunked delivery
+ * of large events happen here, and what fields and events mean is up to the
+ * sink. A leading BOM is stripped and ill-formed UTF-8 is replaced by U+FFFD,
+ * so every name, value and data the sink sees is valid UTF-8. The
+ * sink is a template parameter so its calls inline, and the parser neither
+ * locks nor touches JSI: one thread feeds it.
+ *
+ * A sink provides
+ *
+ *   void on_field(SseField field, std::string_view name, std::string_view value);  // every field but `data`
+ *   void on_comment();                                                              // each `:` line, e.g. a keepalive
+ *   void on_event(std::string& data, bool dropped, bool ascii);                     // each blank line
+ *   bool on_data_chunk(std::string& data, SseChunk position);                       // only with chunk_bytes set
+ *
+ * on_event() sees the accumulated data, empty when the event had none or went
+ * out in chunks, and `dropped` when the DROP policy rejected it as oversized.
+ * `ascii` promises every byte of the data is below 0x80, so it converts to a
+ * JS string without decoding. It comes from the UTF-8 scan, which only notes
+ * the first and last non-ASCII byte per read: an ASCII event between two in
+ * the same read misses out, but the promise always holds.
+ * Both data callbacks may swap the string out; the parser clears it afterwards.
+ * on_data_chunk() returns false to skip the rest of the event.
+ *
+ * However the body is split, the sink sees the same fields and events, limits
+ * included; only where chunk boundaries fall depends on the reads. That is the
+ * property to fuzz: feed one input whole and in random pieces and compare.
+ */
+template <SseSink Sink>
+class SseParser {
+public:
+    explicit SseParser(Sink sink, SseLimits limits = {}) noexcept : _sink(std::move(sink)), _limits(limits) {}
+
+    void set_limits(SseLimits limits) noexcept { _limits = limits; }
+    const SseLimits& limits() const noexcept { return _limits; }
+    const Sink& sink() const noexcept { return _sink; }
+
+    void feed(std::string_view chunk) noexcept {
+        if (_bom_pending) {
+            chunk = strip_bom(chunk);
+        }
+        if (_utf8_carry_size > 0) {
+            chunk = complete_carried_sequence(chunk);
+        }
+
+        // Well-formed text is framed in place; the rare ill-formed sequence splits it around a U+FFFD
+        while (!chunk.empty()) {
+            const sse_scan::Utf8Scan scan = sse_scan::scan_utf8(chunk);
+            feed_text(chunk.substr(0, scan.valid), scan.first_non_ascii, scan.last_non_ascii);
+            if (scan.valid == chunk.size()) {
+                return;
+            }
+            if (scan.invalid == 0) {
+                // Cut short by the end of the chunk, the next one completes it
+                _utf8_carry_size = chunk.size() - scan.valid;
+                chunk.copy(_utf8_carry.data(), _utf8_carry_size, scan.valid);
+                return;
+            }
+            feed_text(REPLACEMENT_CHARACTER, 0, REPLACEMENT_CHARACTER.size() - 1);
+            chunk.remove_prefix(scan.valid + scan.invalid);
+        }
+    }
+
+    // What the line and data accumulators hold on to, for the memory budget
+    size_t buffered_bytes() const noexcept {
+        return _line.capacity() + _data.capacity();
+    }
+
+    // Forgets the partial line and event, e.g. when the connection they came from is gone;
+    // what is fed next starts a new body, which may open with a BOM
+    void reset() noexcept {
+        _line.clear();
+        _data.clear();
+        _skipping_line = false;
+        _event_oversized = false;
+        _chunk_state = ChunkState::NONE;
+        _data_line_open = false;
+        _bom_pending = true;
+        _bom_matched = 0;
+        _utf8_carry_size = 0;
+        _event_ascii = true;
+        _data_lines.clear();
+        _data_line_bytes = 0;
+    }
+
+private:
+    // Capacity above this is given back once a burst is over, i.e. after enough small events in a row
+    static constexpr size_t RETAINED_BUFFER_BYTES = 64 * 1024;
+    static constexpr uint32_t SMALL_EVENTS_BEFORE_TRIM = 32;
+    static constexpr size_t MAX_RESERVED_DATA_BYTES = 1024 * 1024;
+    static constexpr std::string_view DATA_FIELD = "data:";
+    static constexpr std::string_view BOM = "\xEF\xBB\xBF";
+    static constexpr std::string_view REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";
+
+    // An event streams out in chunks once it outgrows the threshold, and an open data line
+    // appends straight to _data instead of waiting in _line for its newline
+    enum class ChunkState { NONE, STREAMING, SKIPPING };
+
+    // A data line still in the caller's buffer, and whether a newline goes before it
+    struct DataLine {
+        std::string_view value;
+        bool separator;
+    };
+
+    // The BOM may arrive split too; bytes that turn out not to be one are fed after all
+    std::string_view strip_bom(std::string_view chunk) noexcept {
+        while (_bom_matched < BOM.size() && !chunk.empty() && chunk.front() == BOM[_bom_matched]) {
+            ++_bom_matched;
+            chunk.remove_prefix(1);
+        }
+        if (_bom_matched < BOM.size() && chunk.empty()) {
+            return chunk;
+        }
+        _bom_pending = false;
+        if (_bom_matched < BOM.size()) {
+            feed(BOM.substr(0, _bom_matched));
+        }
+        return chunk;
+    }
+
+    // A sequence split across reads: completed from the front of `chunk`, or replaced once it cannot be
+    std::string_view complete_carried_sequence(std::string_view chunk) noexcept {
+        const auto lead = static_cast<unsigned char>(_utf8_carry[0]);
+        const size_t length = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+        const size_t taken = std::min(length - _utf8_carry_size, chunk.size());
+        std::array<char, 4> sequence = _utf8_carry;
+        chunk.copy(sequence.data() + _utf8_carry_size, taken);
+
+        const sse_scan::Utf8Scan scan = sse_scan::scan_utf8(std::string_view(sequence.data(), _utf8_carry_size + taken));
+        if (scan.valid == length) {
+            feed_text(std::string_view(sequence.data(), length), 0, length - 1);
+        } else if (scan.invalid == 0) {
+            // Still short, e.g. a four-byte sequence arriving a byte per read
+            _utf8_carry = sequence;
+            _utf8_carry_size += taken;
+            return {};
+        } else {
+            // The carried bytes were a valid start, so the ill-formed part covers them all
+            feed_text(REPLACEMENT_CHARACTER, 0, REPLACEMENT_CHARACTER.size() - 1);
+            chunk.remove_prefix(scan.invalid - _utf8_carry_size);
+            _utf8_carry_size = 0;
+            return chunk;
+        }
+        chunk.remove_prefix(taken);
+        _utf8_carry_size = 0;
+        return chunk;
+    }
+
+    // `first_non_ascii` and `last_non_ascii` bound where `chunk` has bytes outside ASCII, npos for none
+    void feed_text(std::string_view chunk, size_t first_non_ascii, size_t last_non_ascii) noexcept {
+        if (chunk.empty()) {
+            return;
+        }
+        _first_non_ascii = first_non_ascii;
+        _last_non_ascii = last_non_ascii;
+        _event_start = 0;
+
+        size_t start = 0;
+        size_t pos = 0;
+
+        // Complete the line carried over from the previous chunk, if any
+        if (!_line.empty() || _skipping_line || _data_line_open) {
+            pos = sse_scan::find_newline(chunk);
+            if (pos == std::string_view::npos) {
+                buffer_partial_line(chunk);
+                _event_ascii = _event_ascii && !non_ascii_within(0, chunk.size() - 1);
+                return;
+            }
+
+            buffer_partial_line(chunk.substr(0, pos));
+            if (_data_line_open) {
+                // The streamed line is already in _data, minus the CR of a CRLF ending
+                _data_line_open = false;
+                if (!_data.empty() && _data.back() == '\r') {
+                    _data.pop_back();
+                }
+            } else {
+                // A dropped line leaves nothing behind; it must not read as the blank line ending the event
+                const bool dropped = _skipping_line && _line.empty();
+                _skipping_line = false;
+                if (!dropped) {
+                    _line_end = pos;
+                    process_line(_line);
+                }
+            }
+            _line.clear();
+            start = pos + 1;
+        }
+
+        // Complete lines are parsed in place from the caller's buffer, where data lines stay until
+        // their event ends or the buffer is handed back
+        _line_in_place = true;
+        while ((pos = sse_scan::find_newline(chunk, start)) != std::string_view::npos) {
+            _line_end = pos;
+            process_line(chunk.substr(start, pos - start));
+            start = pos + 1;
+        }
+        _line_in_place = false;
+        join_data_lines();
+
+        // Only a trailing partial line is copied
+        if (start < chunk.size()) {
+            buffer_partial_line(chunk.substr(start));
+        }
+        // The event still being read carries on into the next text
+        _event_ascii = _event_ascii && !non_ascii_within(_event_start, chunk.size() - 1);
+
+        // A long line left its peak capacity behind; give it back once the stream is back to small events
+        if (_small_events == SMALL_EVENTS_BEFORE_TRIM && _line.capacity() > RETAINED_BUFFER_BYTES &&
+            _line.size() <= RETAINED_BUFFER_BYTES) {
+            _line.shrink_to_fit();
+        }
+    }
+
+    void buffer_partial_line(std::string_view part) noexcept {
+        if (_skipping_line) {
+            return;
+        }
+        if (_data_line_open) {
+            append_data(part);
+            return;
+        }
+
+        // A data line too long to wait for streams its value out as it arrives; one read is
+        // appended first so the field name is known
+        if (_line.size() + part.size() > _limits.chunk_threshold()) {
+            _line.append(part);
+            if (open_data_line()) {
+                return;
+            }
+            // Still too short to tell, at most the five bytes of `data:` wait for more
+            if (DATA_FIELD.substr(0, _line.size()) == _line) {
+                return;
+            }
+            part = {};
+        }
+
+        // A CR just past the limit may be the first half of a CRLF, which does not count towards it
+        const size_t max_line = _limits.max_line_bytes;
+        const size_t size = _line.size() + part.size();
+        if (size <= max_line || (size == max_line + 1 && (part.empty() ? _line.back() : part.back()) == '\r')) {
+            _line.append(part);
+            return;
+        }
+
+        // Never buffer much past the limit: keep what truncating needs, then ignore the rest of the line
+        if (_limits.oversize == SseLimits::Oversize::TRUNCATE) {
+            // Two bytes past the limit are kept so process_line() cuts exactly as it would the whole line:
+            // one shows whether the cut splits a UTF-8 sequence, the other whether that one is the CR of a CRLF
+            const size_t lookahead = max_line + 2;
+            if (_line.size() < lookahead) {
+                _line.append(part.substr(0, lookahead - _line.size()));
+            }
+        } else {
+            _line.clear();
+            // With chunked delivery only non-data lines end up here, the event itself is fine
+            _event_oversized = _limits.oversize == SseLimits::Oversize::DROP;
+        }
+        _skipping_line = true;
+    }
+
+    bool open_data_line() noexcept {
+        // Wait for the byte after the colon so an optional leading space can be stripped
+        if (_line.size() <= DATA_FIELD.size() || std::string_view(_line).substr(0, DATA_FIELD.size()) != DATA_FIELD) {
+            return false;
+        }
+
+        std::string_view value = std::string_view(_line).substr(DATA_FIELD.size());
+        if (value.front() == ' ') {
+            value.remove_prefix(1);
+        }
+        if (!_data.empty() || _chunk_state != ChunkState::NONE) {
+            _data += '\n';
+        }
+        _data_line_open = true;
+        append_data(value);
+        _line.clear();
+        return true;
+    }
+
+    void append_data(std::string_view data) noexcept {
+        if (_chunk_state == ChunkState::SKIPPING) {
+            return;
+        }
+        _data.append(data);
+        if (_data.size() >= _limits.chunk_threshold()) {
+            emit_chunk(false);
+        }
+    }
+
+    void emit_chunk(bool last) noexcept {
+        if (_chunk_state == ChunkState::SKIPPING) {
+            _data.clear();
+            return;
+        }
+
+        // Half a UTF-8 sequence, or the CR of a CRLF still being read, waits for the next chunk
+        size_t length = last ? _data.size() : sse_scan::utf8_complete_length(_data);
+        if (!last && _data_line_open && length > 0 && _data[length - 1] == '\r') {
+            --length;
+        }
+        if (length == 0 && !last) {
+            return;
+        }
+
+        const SseChunk position = _chunk_state == ChunkState::NONE ? SseChunk::BEGIN : last ? SseChunk::END : SseChunk::CONTINUE;
+        const std::string held = _data.substr(length);
+        _data.resize(length);
+        if (_sink.on_data_chunk(_data, position)) {
+            _chunk_state = ChunkState::STREAMING;
+            _data.assign(held);
+        } else {
+            _chunk_state = ChunkState::SKIPPING;
+            _data.clear();
+        }
+    }
+
+    void process_line(std::string_view line) noexcept {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+
+        if (line.empty()) {
+            end_event();
+            return;
+        }
+
+        if (line.size() > _limits.max_line_bytes) {
+            if (_limits.oversize == SseLimits::Oversize::TRUNCATE) {
+                line = sse_scan::utf8_prefix(line, _limits.max_line_bytes);
+            } else if (_limits.oversize == SseLimits::Oversize::DROP) {
+                _event_oversized = true;
+                return;
+            } else if (line.substr(0, 5) != "data:") {
+                // Data lines are chunked below, other fields this long are ignored
+                return;
+            }
+        }
+
+        // Keepalives are comments, told apart on the first byte without a colon search or a field
+        if (line.front() == ':') {
+            _sink.on_comment();
+            return;
+        }
+
+        const size_t colon_pos = sse_scan::find_colon(line);
+        if (colon_pos == std::string_view::npos) {
+            return;
+        }
+
+        const std::string_view field = line.substr(0, colon_pos);
+        std::string_view value = line.substr(colon_pos + 1);
+        if (!value.empty() && value.front() == ' ') {
+            value.remove_prefix(1);
+        }
+
+        const SseField kind = classify_sse_field(field);
+        if (kind != SseField::DATA) {
+            _sink.on_field(kind, field, value);
+            return;
+        }
+        if (_event_oversized || _chunk_state == ChunkState::SKIPPING) {
+            return;
+        }
+
+        const size_t data_size = _data.size() + _data_line_bytes;
+        const size_t separator = data_size == 0 && _chunk_state == ChunkState::NONE ? 0 : 1;
+        // With the chunk policy the limit is the chunk size, enforced by append_data
+        const size_t max_event = _limits.oversize == SseLimits::Oversize::CHUNK ? SIZE_MAX : _limits.max_event_bytes;
+        if (data_size + separator + value.size() > max_event) {
+            _event_oversized = true;
+            if (_limits.oversize == SseLimits::Oversize::TRUNCATE && data_size + separator < max_event) {
+                join_data_lines();
+                _data.append(separator, '\n');
+                _data.append(sse_scan::utf8_prefix(value, max_event - _data.size()));
+            } else if (_limits.oversize == SseLimits::Oversize::DROP) {
+                // Give the memory back now instead of holding it until the event ends
+                std::string().swap(_data);
+                _data_lines.clear();
+                _data_line_bytes = 0;
+            }
+            return;
+        }
+
+        // Without chunking nothing needs the data before the event ends, so the lines are joined
+        // in one sized append instead of growing the string line by line
+        if (_line_in_place && _limits.chunk_threshold() == SIZE_MAX) {
+            _data_lines.push_back(DataLine{value, separator != 0});
+            _data_line_bytes += separator + value.size();
+            return;
+        }
+        join_data_lines();
+        if (separator) {
+            _data += '\n';
+        }
+        append_data(value);
+    }
+
+    void join_data_lines() noexcept {
+        if (_data_lines.empty()) {
+            return;
+        }
+        _data.reserve(_data.size() + _data_line_bytes);
+        for (const DataLine& line : _data_lines) {
+            if (line.separator) {
+                _data += '\n';
+            }
+            _data.append(line.value);
+        }
+        _data_lines.clear();
+        _data_line_bytes = 0;
+    }
+
+    // Whether bytes `from` to `to` of the text being framed may hold any outside ASCII
+    bool non_ascii_within(size_t from, size_t to) const noexcept {
+        return _first_non_ascii != std::string_view::npos && _first_non_ascii <= to && _last_non_ascii >= from;
+    }
+
+    void end_event() noexcept {
+        join_data_lines();
+        // The rest of a chunked event goes out as its final chunk
+        if (_chunk_state != ChunkState::NONE) {
+            emit_chunk(true);
+            _chunk_state = ChunkState::NONE;
+            _data.clear();
+        }
+
+        const bool dropped = std::exchange(_event_oversized, false) && _limits.oversize == SseLimits::Oversize::DROP;
+        const size_t data_size = _data.size();
+        _sink.on_event(_data, dropped, _event_ascii && !non_ascii_within(_event_start, _line_end));
+        // The next event starts on the line after this blank one
+        _event_ascii = true;
+        _event_start = _line_end + 1;
+
+        // Sized for a payload like the last one, unless a burst of large ones is over
+        _data.clear();
+        if (data_size > RETAINED_BUFFER_BYTES) {
+            _small_events = 0;
+        } else if (_small_events < SMALL_EVENTS_BEFORE_TRIM) {
+            ++_small_events;
+        }
+        if (_small_events == SMALL_EVENTS_BEFORE_TRIM && _data.capacity() > RETAINED_BUFFER_BYTES) {
+            std::string().swap(_data);
+        }
+        _data.reserve(std::min(data_size, MAX_RESERVED_DATA_BYTES));
+    }
+
+    Sink _sink;
+    SseLimits _limits;
+    // The line still waiting for its newline, and the data of the event being read
+    std::string _line;
+    std::string _data;
+    // The event's data lines after _data, bytes included, not copied yet
+    std::vector<DataLine> _data_lines;
+    size_t _data_line_bytes = 0;
+    bool _line_in_place = false;
+    // The rest of an over-long line is skipped, an oversized event is dropped or truncated
+    bool _skipping_line = false;
+    bool _event_oversized = false;
+    ChunkState _chunk_state = ChunkState::NONE;
+    bool _data_line_open = false;
+    uint32_t _small_events = 0;
+    // Bytes of a BOM seen at the start of the body so far, and a UTF-8 sequence a read cut short
+    bool _bom_pending = true;
+    uint8_t _bom_matched = 0;
+    std::array<char, 4> _utf8_carry{};
+    size_t _utf8_carry_size = 0;
+    // ASCII tracking: where the text being framed has non-ASCII bytes, the offset in it of the
+    // line being processed and of the event's start, and whether the event's earlier text was ASCII
+    size_t _first_non_ascii = std::string_view::npos;
+    size_t _last_non_ascii = std::string_view::npos;
+    size_t _line_end = 0;
+    size_t _event_start = 0;
+    bool _event_ascii = true;
+};
+
+/**
+ * Counts what the parser produces and keeps nothing, for measuring the framing
+ * on its own: SseParser<SseCountingSink> does no more work per event than
+ * the counters, which also keep the compiler from discarding the parse.
+ */
+struct SseCountingSink {
+    size_t fields = 0;
+    size_t events = 0;
+    size_t data_bytes = 0;
+
+    void on_field(SseField, std::string_view, std::string_view) noexcept { ++fields; }
+    void on_comment() noexcept {}
+    void on_event(std::string& data, bool, bool) noexcept {
+        events += data.empty() ? 0 : 1;
+        data_bytes += data.size();
+    }
+    bool on_data_chunk(std::string& data, SseChunk position) noexcept {
+        // An event that went out in chunks reaches on_event() empty
+        events += position == SseChunk::END ? 1 : 0;
+        data_bytes += data.size();
+        return true;
+    }
+};
+
+} // namespace margelo::nitro::nitroeventsource
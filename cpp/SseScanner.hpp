@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NITRO_SSE_SCAN_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#define NITRO_SSE_SCAN_SSE2 1
+#endif
+
+namespace margelo::nitro::nitroeventsource::sse_scan {
+
+/**
+ * Returns the offset of the first `needle` in `text` at or after `start`, or `npos`.
+ * Scans 16 bytes per step with NEON (arm64-v8a) or SSE2 (x86_64), 32 with AVX2.
+ */
+inline size_t find_byte(std::string_view text, char needle, size_t start = 0) noexcept {
+    if (start >= text.size()) {
+        return std::string_view::npos;
+    }
+
+    const char* const begin = text.data();
+    const char* first = begin + start;
+    const char* const last = begin + text.size();
+
+#if defined(NITRO_SSE_SCAN_NEON)
+    const uint8x16_t pattern = vdupq_n_u8(static_cast<uint8_t>(needle));
+    while (last - first >= 16) {
+        const uint8x16_t matches = vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(first)), pattern);
+        // Narrow each byte of the comparison to a nibble so the block fits one 64-bit mask
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+        if (mask != 0) {
+            return static_cast<size_t>(first - begin) + (static_cast<size_t>(__builtin_ctzll(mask)) >> 2);
+        }
+        first += 16;
+    }
+#elif defined(NITRO_SSE_SCAN_SSE2)
+#if defined(__AVX2__)
+    const __m256i wide_pattern = _mm256_set1_epi8(needle);
+    while (last - first >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, wide_pattern)));
+        if (mask != 0) {
+            return static_cast<size_t>(first - begin) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        first += 32;
+    }
+#endif
+    const __m128i pattern = _mm_set1_epi8(needle);
+    while (last - first >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0) {
+            return static_cast<size_t>(first - begin) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        first += 16;
+    }
+#endif
+
+    for (; first != last; ++first) {
+        if (*first == needle) {
+            return static_cast<size_t>(first - begin);
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Offset of the first byte at or after `start` that is not ASCII, or `npos`; same block widths as find_byte()
+inline size_t find_non_ascii(std::string_view text, size_t start = 0) noexcept {
+    if (start >= text.size()) {
+        return std::string_view::npos;
+    }
+
+    const char* const begin = text.data();
+    const char* first = begin + start;
+    const char* const last = begin + text.size();
+
+#if defined(NITRO_SSE_SCAN_NEON)
+    while (last - first >= 16) {
+        // The block's largest byte tells whether any has its top bit set, the scalar loop finds which
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(first))) >= 0x80) {
+            break;
+        }
+        first += 16;
+    }
+#elif defined(NITRO_SSE_SCAN_SSE2)
+#if defined(__AVX2__)
+    while (last - first >= 32) {
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first))));
+        if (mask != 0) {
+            return static_cast<size_t>(first - begin) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        first += 32;
+    }
+#endif
+    while (last - first >= 16) {
+        // movemask gathers exactly the top bits
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first))));
+        if (mask != 0) {
+            return static_cast<size_t>(first - begin) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        first += 16;
+    }
+#endif
+
+    for (; first != last; ++first) {
+        if (static_cast<unsigned char>(*first) >= 0x80) {
+            return static_cast<size_t>(first - begin);
+        }
+    }
+    return std::string_view::npos;
+}
+
+inline size_t find_newline(std::string_view text, size_t start = 0) noexcept {
+    return find_byte(text, '\n', start);
+}
+
+inline size_t find_colon(std::string_view line) noexcept {
+    return find_byte(line, ':');
+}
+
+// Longest prefix of at most `max_bytes` that does not end inside a UTF-8 sequence
+inline std::string_view utf8_prefix(std::string_view text, size_t max_bytes) noexcept {
+    if (text.size() <= max_bytes) {
+        return text;
+    }
+    size_t lead = max_bytes;
+    while (lead > 0 && (static_cast<unsigned char>(text[lead]) & 0xC0) == 0x80) {
+        --lead;
+    }
+    // Stray continuation bytes belong to no sequence, only a lead byte moves the cut back
+    return text.substr(0, static_cast<unsigned char>(text[lead]) >= 0xC0 ? lead : max_bytes);
+}
+
+struct Utf8Scan {
+    // Well-formed bytes from the start
+    size_t valid = 0;
+    // Bytes of the ill-formed sequence after those, to be replaced by one U+FFFD as the
+    // Encoding standard decodes; 0 when they run to the end or to a sequence the end cuts short
+    size_t invalid = 0;
+    // Where the well-formed bytes have any outside ASCII, npos for none
+    size_t first_non_ascii = std::string_view::npos;
+    size_t last_non_ascii = std::string_view::npos;
+};
+
+/**
+ * How much of `text` is well-formed UTF-8, per Unicode table 3-7: no overlong forms,
+ * surrogates or code points past U+10FFFF. ASCII runs go by a block at a time with
+ * find_non_ascii(), only the multi-byte sequences are decoded one by one.
+ */
+inline Utf8Scan scan_utf8(std::string_view text) noexcept {
+    Utf8Scan scan;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t at = 0;
+    while ((at = find_non_ascii(text, at)) != std::string_view::npos) {
+        if (scan.first_non_ascii == std::string_view::npos) {
+            scan.first_non_ascii = at;
+        }
+        scan.valid = at;
+
+        const unsigned char lead = bytes[at];
+        size_t length = 0;
+        // Range of the second byte, narrower after the leads where the full range would be overlong or out of range
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            low = lead == 0xE0 ? 0xA0 : 0x80;
+            high = lead == 0xED ? 0x9F : 0xBF;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            low = lead == 0xF0 ? 0x90 : 0x80;
+            high = lead == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            scan.invalid = 1;
+            return scan;
+        }
+
+        for (size_t i = 1; i < length; ++i) {
+            if (at + i == text.size()) {
+                return scan;
+            }
+            if (bytes[at + i] < low || bytes[at + i] > high) {
+                scan.invalid = i;
+                return scan;
+            }
+            low = 0x80;
+            high = 0xBF;
+        }
+        at += length;
+        scan.last_non_ascii = at - 1;
+    }
+    scan.valid = text.size();
+    return scan;
+}
+
+// Length of `text` without a trailing UTF-8 sequence that is still missing bytes
+inline size_t utf8_complete_length(std::string_view text) noexcept {
+    size_t i = text.size();
+    for (size_t back = 1; i > 0 && back <= 4; ++back) {
+        const auto c = static_cast<unsigned char>(text[--i]);
+        if ((c & 0xC0) == 0x80) {
+            continue;
+        }
+        const size_t length = c < 0x80 ? 1 : (c >> 5) == 0x6 ? 2 : (c >> 4) == 0xE ? 3 : (c >> 3) == 0x1E ? 4 : 1;
+        return back >= length ? text.size() : i;
+    }
+    return text.size();
+}
+
+} // namespace margelo::nitro::nitroeventsource::sse_scan
@@ -0,0 +1,109 @@
+#include "StateSnapshotStore.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4e455353; // "NESS"
+
+struct Header {
+    uint32_t magic;
+    uint32_t version_bytes;
+    uint64_t json_bytes;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+uint32_t checksum(std::string_view version, std::string_view json) noexcept {
+    uint32_t hash = 2166136261u;
+    for (const std::string_view part : {version, json}) {
+        for (const char byte : part) {
+            hash ^= static_cast<unsigned char>(byte);
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+bool write_all(int fd, const void* bytes, size_t length) noexcept {
+    const auto* next = static_cast<const char*>(bytes);
+    while (length > 0) {
+        const ssize_t written = ::write(fd, next, length);
+        if (written < 0) {
+            return false;
+        }
+        next += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool read_all(int fd, void* bytes, size_t length) noexcept {
+    auto* next = static_cast<char*>(bytes);
+    while (length > 0) {
+        const ssize_t read = ::read(fd, next, length);
+        if (read <= 0) {
+            return false;
+        }
+        next += read;
+        length -= static_cast<size_t>(read);
+    }
+    return true;
+}
+
+} // namespace
+
+bool StateSnapshotStore::load(std::string& version, std::string& json) const {
+    const int fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    Header header{};
+    struct stat info {};
+    bool intact = ::fstat(fd, &info) == 0 && read_all(fd, &header, sizeof(header)) && header.magic == MAGIC &&
+                  sizeof(header) + header.version_bytes + header.json_bytes == static_cast<uint64_t>(info.st_size);
+    if (intact) {
+        version.resize(header.version_bytes);
+        json.resize(static_cast<size_t>(header.json_bytes));
+        intact = read_all(fd, version.data(), version.size()) && read_all(fd, json.data(), json.size()) &&
+                 checksum(version, json) == header.checksum;
+    }
+    ::close(fd);
+    if (!intact) {
+        version.clear();
+        json.clear();
+    }
+    return intact;
+}
+
+bool StateSnapshotStore::save(std::string_view version, std::string_view json) const noexcept {
+    const std::string temporary = _path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    const Header header{MAGIC, static_cast<uint32_t>(version.size()), json.size(), checksum(version, json), 0};
+    const bool written = write_all(fd, &header, sizeof(header)) && write_all(fd, version.data(), version.size()) &&
+                         write_all(fd, json.data(), json.size());
+    ::close(fd);
+    if (!written || std::rename(temporary.c_str(), _path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+void StateSnapshotStore::clear() const noexcept {
+    ::unlink(_path.c_str());
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The stateSync document of one stream key and the version it is at, kept in
+ * a file so a cold start can tell the server what it already has and only be
+ * sent what changed since. A save writes a new file and renames it over the
+ * old one, so a save cut short leaves the previous document readable.
+ */
+class StateSnapshotStore {
+public:
+    explicit StateSnapshotStore(std::string path) : _path(std::move(path)) {}
+
+    // False when nothing intact was saved yet
+    bool load(std::string& version, std::string& json) const;
+    bool save(std::string_view version, std::string_view json) const noexcept;
+    void clear() const noexcept;
+
+private:
+    const std::string _path;
+};
+
+} // namespace margelo::nitro::nitroeventsource
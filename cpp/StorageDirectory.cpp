@@ -0,0 +1,81 @@
+#include "StorageDirectory.hpp"
+#include "StreamKey.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fcntl.h>
+#include <new>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr std::string_view SUBDIRECTORY = "nitro-event-source";
+
+bool make_directory(const std::string& path) noexcept {
+    return ::mkdir(path.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+std::string platform_cache_directory() {
+#if defined(__APPLE__)
+    // HOME is the app container inside the iOS sandbox
+    if (const char* home = std::getenv("HOME")) {
+        return std::string(home) + "/Library/Caches";
+    }
+    return {};
+#elif defined(__ANDROID__)
+    // The package name is the process name, and app data lives under the Android user it runs as
+    char name[256] = {};
+    const int fd = ::open("/proc/self/cmdline", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return {};
+    }
+    const ssize_t length = ::read(fd, name, sizeof(name) - 1);
+    ::close(fd);
+    if (length <= 0) {
+        return {};
+    }
+    std::string package(name);
+    // Secondary processes are named "package:process"
+    package = package.substr(0, package.find(':'));
+    if (package.empty()) {
+        return {};
+    }
+    constexpr uid_t PER_USER_RANGE = 100000;
+    return "/data/user/" + std::to_string(::getuid() / PER_USER_RANGE) + "/" + package + "/cache";
+#else
+    if (const char* temp = std::getenv("TMPDIR")) {
+        return temp;
+    }
+    return "/tmp";
+#endif
+}
+
+} // namespace
+
+std::string resolve_storage_directory(const std::optional<std::string>& configured) noexcept {
+    try {
+        if (configured) {
+            return make_directory(*configured) ? *configured : std::string();
+        }
+
+        const std::string base = platform_cache_directory();
+        if (base.empty()) {
+            return {};
+        }
+        std::string directory = base + "/" + std::string(SUBDIRECTORY);
+        return make_directory(directory) ? directory : std::string();
+    } catch (const std::bad_alloc&) {
+        return {};
+    }
+}
+
+std::string storage_file_name(std::string_view prefix, std::string_view key) {
+    return std::string(prefix) + "-" + stream_key::to_hex(stream_key::fnv1a(key));
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Where streams keep the state they carry across app restarts.
+ * Everything stored there can be rebuilt from the network, so the platform
+ * cache directory is used unless `storageDirectory` names another one.
+ */
+
+// Returns the directory, created if needed, or an empty string when there is nowhere to write
+std::string resolve_storage_directory(const std::optional<std::string>& configured) noexcept;
+
+// File name safe for any stream key, stable across launches
+std::string storage_file_name(std::string_view prefix, std::string_view key);
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,105 @@
+#include "StreamCapture.hpp"
+
+#include <cstring>
+#include <new>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr char MAGIC[4] = {'N', 'E', 'S', 'C'};
+constexpr uint32_t VERSION = 1;
+constexpr size_t HEADER_BYTES = sizeof(MAGIC) + sizeof(VERSION);
+constexpr size_t RECORD_HEADER_BYTES = sizeof(uint64_t) + sizeof(uint32_t);
+// Refuses records no response chunk comes near, so a corrupt length cannot allocate gigabytes
+constexpr uint32_t MAX_CHUNK_BYTES = 64 * 1024 * 1024;
+
+} // namespace
+
+std::unique_ptr<CaptureWriter> CaptureWriter::open(const std::string& path, size_t max_bytes) noexcept {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return nullptr;
+    }
+    if (std::fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC) || std::fwrite(&VERSION, sizeof(VERSION), 1, file) != 1) {
+        std::fclose(file);
+        return nullptr;
+    }
+    std::unique_ptr<CaptureWriter> writer(new (std::nothrow) CaptureWriter(file, max_bytes));
+    if (!writer) {
+        std::fclose(file);
+        return nullptr;
+    }
+    writer->_written = HEADER_BYTES;
+    return writer;
+}
+
+CaptureWriter::~CaptureWriter() {
+    std::fclose(_file);
+}
+
+void CaptureWriter::append(std::chrono::steady_clock::time_point at, std::string_view bytes) noexcept {
+    if (_full || bytes.size() > MAX_CHUNK_BYTES) {
+        return;
+    }
+    if (_max_bytes > 0 && _written + RECORD_HEADER_BYTES + bytes.size() > _max_bytes) {
+        _full = true;
+        return;
+    }
+    if (!_started) {
+        _first = at;
+        _started = true;
+    }
+    const auto offset = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(at - _first).count());
+    const auto length = static_cast<uint32_t>(bytes.size());
+    // stdio buffers the records, so a chunk usually costs a copy rather than a write()
+    if (std::fwrite(&offset, sizeof(offset), 1, _file) != 1 || std::fwrite(&length, sizeof(length), 1, _file) != 1 ||
+        std::fwrite(bytes.data(), 1, bytes.size(), _file) != bytes.size()) {
+        _full = true;
+        return;
+    }
+    _written += RECORD_HEADER_BYTES + bytes.size();
+}
+
+std::unique_ptr<CaptureReader> CaptureReader::open(const std::string& path) noexcept {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return nullptr;
+    }
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        std::fread(&version, sizeof(version), 1, file) != 1 || version != VERSION) {
+        std::fclose(file);
+        return nullptr;
+    }
+    std::unique_ptr<CaptureReader> reader(new (std::nothrow) CaptureReader(file));
+    if (!reader) {
+        std::fclose(file);
+    }
+    return reader;
+}
+
+CaptureReader::~CaptureReader() {
+    std::fclose(_file);
+}
+
+bool CaptureReader::next(std::chrono::microseconds& at, std::string& bytes) noexcept {
+    uint64_t offset = 0;
+    uint32_t length = 0;
+    if (std::fread(&offset, sizeof(offset), 1, _file) != 1 || std::fread(&length, sizeof(length), 1, _file) != 1 || length > MAX_CHUNK_BYTES) {
+        return false;
+    }
+    try {
+        bytes.resize(length);
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+    if (std::fread(bytes.data(), 1, length, _file) != length) {
+        return false;
+    }
+    at = std::chrono::microseconds(static_cast<int64_t>(offset));
+    return true;
+}
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * `capture` and `replay` files: the raw response bytes a stream received, each
+ * chunk as curl handed it over with its arrival time, so production traffic
+ * can be fed back through the parser and dispatch later. After an 8-byte
+ * header ("NESC", version) every record is
+ *
+ *   [u64 µs since the first chunk][u32 length][bytes]
+ *
+ * little-endian, like every platform this builds for. Both ends are used from
+ * the I/O thread alone.
+ */
+class CaptureWriter {
+public:
+    // Truncates `path`; nullptr when it cannot be created
+    static std::unique_ptr<CaptureWriter> open(const std::string& path, size_t max_bytes) noexcept;
+    ~CaptureWriter();
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    // Chunks past `max_bytes` or after a failed write are left out, the file stays readable
+    void append(std::chrono::steady_clock::time_point at, std::string_view bytes) noexcept;
+
+private:
+    CaptureWriter(std::FILE* file, size_t max_bytes) noexcept : _file(file), _max_bytes(max_bytes) {}
+
+    std::FILE* _file;
+    const size_t _max_bytes;
+    size_t _written = 0;
+    bool _full = false;
+    std::chrono::steady_clock::time_point _first{};
+    bool _started = false;
+};
+
+class CaptureReader {
+public:
+    // nullptr when `path` cannot be read or is not a capture
+    static std::unique_ptr<CaptureReader> open(const std::string& path) noexcept;
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    // The next chunk and when it arrived after the first; false at the end, or at a record cut short
+    bool next(std::chrono::microseconds& at, std::string& bytes) noexcept;
+
+private:
+    explicit CaptureReader(std::FILE* file) noexcept : _file(file) {}
+
+    std::FILE* _file;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * What tells one stream's requests from another's, hashed: the URL, method,
+ * body and headers in a canonical form, so `HTTP://Example.com:443/feed#top`
+ * and `https://example.com/feed`, or the same headers in another order or case,
+ * key alike. Computed once per stream at create; the journal and warm-start
+ * cache default to it, and JS asks for it to share connections. FNV-1a, keys
+ * are app-chosen URLs and names rather than adversarial input.
+ */
+namespace stream_key {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+inline uint64_t fnv1a(std::string_view data, uint64_t hash = FNV_OFFSET) noexcept {
+    for (const char c : data) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline std::string to_hex(uint64_t hash) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(hex, 16);
+}
+
+inline std::string lower(std::string_view text) {
+    std::string out(text);
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+
+inline std::string_view trim(std::string_view text) noexcept {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Scheme and host lowercased, a default port and the fragment dropped, an empty path made `/`.
+// Path and query are kept as sent, a server may tell their case apart
+inline std::string normalize_url(std::string_view url) {
+    url = url.substr(0, url.find('#'));
+    const size_t scheme_end = url.find("://");
+    if (scheme_end == std::string_view::npos) {
+        return std::string(url);
+    }
+    const std::string scheme = lower(url.substr(0, scheme_end));
+    std::string_view rest = url.substr(scheme_end + 3);
+    const size_t authority_end = std::min(rest.find_first_of("/?"), rest.size());
+    std::string authority = lower(rest.substr(0, authority_end));
+    rest.remove_prefix(authority_end);
+
+    const std::string_view default_port = scheme == "https" || scheme == "wss" ? ":443" : scheme == "http" || scheme == "ws" ? ":80" : "";
+    if (!default_port.empty() && authority.size() > default_port.size() &&
+        std::string_view(authority).substr(authority.size() - default_port.size()) == default_port) {
+        authority.resize(authority.size() - default_port.size());
+    }
+    std::string out = scheme + "://" + authority;
+    if (rest.empty() || rest.front() == '?') {
+        out += '/';
+    }
+    out.append(rest);
+    return out;
+}
+
+inline uint64_t compute(std::string_view url, std::string_view method, std::string_view body,
+                        const std::unordered_map<std::string, std::string>* headers) {
+    // Names are case-insensitive in HTTP, and a map has no order of its own
+    std::vector<std::pair<std::string, std::string_view>> sorted;
+    if (headers) {
+        sorted.reserve(headers->size());
+        for (const auto& [name, value] : *headers) {
+            sorted.emplace_back(lower(trim(name)), trim(value));
+        }
+        std::sort(sorted.begin(), sorted.end());
+    }
+
+    uint64_t hash = fnv1a(normalize_url(url));
+    hash = fnv1a("\n", hash);
+    std::string upper_method(method);
+    std::transform(upper_method.begin(), upper_method.end(), upper_method.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    hash = fnv1a(upper_method, hash);
+    for (const auto& [name, value] : sorted) {
+        hash = fnv1a("\n", hash);
+        hash = fnv1a(name, hash);
+        hash = fnv1a(":", hash);
+        hash = fnv1a(value, hash);
+    }
+    // The body last and length-prefixed, so no header can run into it
+    hash = fnv1a("\n\n" + std::to_string(body.size()) + "\n", hash);
+    return fnv1a(body, hash);
+}
+
+} // namespace stream_key
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "MemoryBudget.hpp"
+#include "NitroEventSourceEvent.hpp"
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * What closed streams leave for the next ones: their easy handles, reset but
+ * keeping their DNS, TLS session and connection caches, and the event buffers
+ * their pools held, capacity and all. Screens that open and close short-lived
+ * streams then skip curl_easy_init() and the first events' allocations.
+ * Thread-safe; nothing is kept while over the memory budget.
+ */
+class StreamRecycler {
+public:
+    static constexpr size_t MAX_HANDLES = 8;
+    static constexpr size_t MAX_EVENTS = 256;
+
+    static StreamRecycler& shared() noexcept {
+        // Leaked like the TransferEngine, streams released at exit may still hand things back
+        static StreamRecycler* recycler = new StreamRecycler();
+        return *recycler;
+    }
+
+    // A handle no multi handle holds any more; cleaned up when there is no room for it, or when
+    // not `reusable`: a reset leaves the cookie engine on, so a withCredentials handle is not passed on
+    void give_handle(CURL* easy, bool reusable = true) noexcept {
+        if (!easy) {
+            return;
+        }
+        if (!reusable) {
+            curl_easy_cleanup(easy);
+            return;
+        }
+        curl_easy_reset(easy);
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            if (_handles.size() < MAX_HANDLES && !MemoryBudget::shared().exceeded()) {
+                try {
+                    _handles.push_back(easy);
+                    return;
+                } catch (const std::bad_alloc&) {
+                }
+            }
+        }
+        curl_easy_cleanup(easy);
+    }
+
+    // A recycled handle with default options, or a new one; nullptr when curl cannot make one
+    CURL* take_handle() noexcept {
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            if (!_handles.empty()) {
+                CURL* easy = _handles.back();
+                _handles.pop_back();
+                return easy;
+            }
+        }
+        return curl_easy_init();
+    }
+
+    void give_event(NitroEventSourceEvent&& event) noexcept {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        if (_events.size() >= MAX_EVENTS || MemoryBudget::shared().exceeded()) {
+            return;
+        }
+        try {
+            _events.push_back(std::move(event));
+        } catch (const std::bad_alloc&) {
+        }
+    }
+
+    // Up to `max_events` recycled events, handed to `sink` outside the lock
+    template <typename Sink>
+    void take_events(size_t max_events, Sink&& sink) noexcept {
+        std::vector<NitroEventSourceEvent> taken;
+        {
+            const std::lock_guard<std::mutex> lock(_mutex);
+            const size_t count = std::min(max_events, _events.size());
+            try {
+                taken.reserve(count);
+            } catch (const std::bad_alloc&) {
+                return;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                taken.push_back(std::move(_events.back()));
+                _events.pop_back();
+            }
+        }
+        for (NitroEventSourceEvent& event : taken) {
+            sink(std::move(event));
+        }
+    }
+
+private:
+    StreamRecycler() = default;
+
+    std::mutex _mutex;
+    std::vector<CURL*> _handles;
+    std::vector<NitroEventSourceEvent> _events;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Hierarchical timing wheel with millisecond ticks: seven levels of 64 slots,
+ * with deadlines more than about two years out filed as if two years out.
+ * Inserting and cancelling are O(1), and finding the next deadline looks at one
+ * occupancy word per level. A timer is filed in the level where its tick first
+ * differs from the current one and moves down as that slot comes up, so each is
+ * touched at most once per level. Cancelled timers only leave the index; their
+ * slot entry is dropped when the slot comes up. Timers never fire early:
+ * deadlines round up to the next tick.
+ */
+template <typename Payload>
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(Clock::time_point origin) : _origin(origin) {}
+
+    bool empty() const noexcept {
+        return _entries.empty();
+    }
+
+    void insert(uint64_t id, Clock::time_point deadline, Payload payload) {
+        const uint64_t tick = tick_at_or_after(deadline);
+        _entries.insert_or_assign(id, Entry{deadline, tick, std::move(payload)});
+        file(id, tick);
+    }
+
+    bool erase(uint64_t id) noexcept {
+        return _entries.erase(id) > 0;
+    }
+
+    // When the next slot comes up: the earliest deadline or a little before it, never after
+    std::optional<Clock::time_point> next_deadline() const noexcept {
+        if (_entries.empty()) {
+            return std::nullopt;
+        }
+        if (!_overdue.empty()) {
+            return _origin + std::chrono::milliseconds(_current);
+        }
+        const std::optional<uint64_t> tick = next_slot_tick();
+        return tick ? std::optional(_origin + std::chrono::milliseconds(*tick)) : std::nullopt;
+    }
+
+    // Moves every timer due by `now` into `due`, earliest deadline first
+    void expire(Clock::time_point now, std::vector<std::pair<Clock::time_point, Payload>>& due) {
+        const size_t first = due.size();
+        collect(_overdue, due);
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - _origin).count();
+        const uint64_t now_tick = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+        while (true) {
+            const std::optional<uint64_t> tick = next_slot_tick();
+            if (!tick || *tick > now_tick) {
+                break;
+            }
+            _current = *tick;
+            // Higher levels first, so what cascades from them lands in slots still to be read
+            for (size_t level = LEVELS; level-- > 0;) {
+                const uint64_t slot = slot_index(_current, level);
+                if ((_occupied[level] >> slot & 1) != 0 && slot_start(level, slot) == _current) {
+                    std::vector<uint64_t> ids;
+                    ids.swap(_slots[level][slot]);
+                    _occupied[level] &= ~(uint64_t{1} << slot);
+                    for (const uint64_t id : ids) {
+                        const auto it = _entries.find(id);
+                        if (it == _entries.end()) {
+                            continue;
+                        }
+                        if (it->second.tick <= _current) {
+                            _overdue.push_back(id);
+                        } else {
+                            file(id, it->second.tick);
+                        }
+                    }
+                }
+            }
+            collect(_overdue, due);
+        }
+        _current = std::max(_current, now_tick);
+
+        // Ids break ties as the map this replaced did; they were handed out in scheduling order
+        std::stable_sort(due.begin() + static_cast<std::ptrdiff_t>(first), due.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+    }
+
+private:
+    static constexpr size_t LEVELS = 7;
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t{1} << SLOT_BITS;
+    // Below the top level's reach even where adding it carries into the next rotation
+    static constexpr uint64_t MAX_AHEAD = uint64_t{1} << (SLOT_BITS * (LEVELS - 1));
+
+    struct Entry {
+        Clock::time_point deadline;
+        uint64_t tick;
+        Payload payload;
+    };
+
+    uint64_t tick_at_or_after(Clock::time_point deadline) const noexcept {
+        if (deadline <= _origin) {
+            return 0;
+        }
+        return static_cast<uint64_t>(std::chrono::ceil<std::chrono::milliseconds>(deadline - _origin).count());
+    }
+
+    static uint64_t slot_index(uint64_t tick, size_t level) noexcept {
+        return (tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    }
+
+    // The tick `slot` of `level` stands for in the current rotation of that level
+    uint64_t slot_start(size_t level, uint64_t slot) const noexcept {
+        const size_t shift = SLOT_BITS * (level + 1);
+        const uint64_t rotation = shift < 64 ? (_current >> shift) << shift : 0;
+        return rotation + (slot << (SLOT_BITS * level));
+    }
+
+    void file(uint64_t id, uint64_t tick) {
+        if (tick <= _current) {
+            _overdue.push_back(id);
+            return;
+        }
+        // Filed by the tick it would have, a slot coming up early only files it again
+        tick = std::min(tick, _current + MAX_AHEAD);
+        // The level where the tick first differs from the current one
+        const uint64_t differing = tick ^ _current;
+        size_t level = 0;
+        while (level + 1 < LEVELS && (differing >> (SLOT_BITS * (level + 1))) != 0) {
+            ++level;
+        }
+        const uint64_t slot = slot_index(tick, level);
+        _slots[level][slot].push_back(id);
+        _occupied[level] |= uint64_t{1} << slot;
+    }
+
+    // Slots of a level ahead of the current one, within its rotation, are the only ones in use
+    std::optional<uint64_t> next_slot_tick() const noexcept {
+        std::optional<uint64_t> next;
+        for (size_t level = 0; level < LEVELS; ++level) {
+            const uint64_t current_slot = slot_index(_current, level);
+            const uint64_t ahead = current_slot + 1 < SLOTS ? _occupied[level] & (~uint64_t{0} << (current_slot + 1)) : 0;
+            if (ahead == 0) {
+                continue;
+            }
+            const uint64_t tick = slot_start(level, static_cast<uint64_t>(__builtin_ctzll(ahead)));
+            next = next ? std::min(*next, tick) : tick;
+        }
+        return next;
+    }
+
+    void collect(std::vector<uint64_t>& ids, std::vector<std::pair<Clock::time_point, Payload>>& due) {
+        for (const uint64_t id : ids) {
+            auto node = _entries.extract(id);
+            if (!node.empty()) {
+                due.emplace_back(node.mapped().deadline, std::move(node.mapped().payload));
+            }
+        }
+        ids.clear();
+    }
+
+    Clock::time_point _origin;
+    // Ticks up to and including this one have been expired
+    uint64_t _current = 0;
+    std::unordered_map<uint64_t, Entry> _entries;
+    std::array<std::array<std::vector<uint64_t>, SLOTS>, LEVELS> _slots;
+    std::array<uint64_t, LEVELS> _occupied{};
+    std::vector<uint64_t> _overdue;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,225 @@
+#include "TlsSessionCache.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <new>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+#if LIBCURL_VERSION_NUM >= 0x080c00
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4e455354; // "NEST"
+// A few sessions per origin the app streams from; anything larger is not ours
+constexpr size_t MAX_FILE_BYTES = 256 * 1024;
+
+// Header: magic, then the checksum of everything after it
+constexpr size_t HEADER_BYTES = 2 * sizeof(uint32_t);
+
+// Each record: valid_until, key, shmac and data lengths, then the three byte strings.
+// Native byte order, the file never leaves the device
+struct RecordHeader {
+    int64_t valid_until;
+    uint32_t key_length;
+    uint32_t shmac_length;
+    uint32_t data_length;
+};
+
+uint32_t checksum(const char* bytes, size_t length) noexcept {
+    uint32_t hash = 2166136261u ^ static_cast<uint32_t>(length);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(bytes[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool expired(int64_t valid_until) noexcept {
+    // 0 when the TLS library did not say
+    return valid_until > 0 && valid_until <= static_cast<int64_t>(std::time(nullptr));
+}
+
+// An easy handle only serves to reach the share's session cache
+CURL* share_easy(CURLSH* share) noexcept {
+    CURL* easy = share ? curl_easy_init() : nullptr;
+    if (easy && curl_easy_setopt(easy, CURLOPT_SHARE, share) != CURLE_OK) {
+        curl_easy_cleanup(easy);
+        return nullptr;
+    }
+    return easy;
+}
+
+CURLcode export_session(CURL*, void* userptr, const char* session_key, const unsigned char* shmac, size_t shmac_length,
+                        const unsigned char* data, size_t data_length, curl_off_t valid_until, int, const char*, size_t) {
+    auto* out = static_cast<std::string*>(userptr);
+    const size_t key_length = session_key ? std::strlen(session_key) : 0;
+    if (expired(valid_until) || out->size() + sizeof(RecordHeader) + key_length + shmac_length + data_length > MAX_FILE_BYTES) {
+        return CURLE_OK;
+    }
+
+    const RecordHeader header{static_cast<int64_t>(valid_until), static_cast<uint32_t>(key_length),
+                              static_cast<uint32_t>(shmac_length), static_cast<uint32_t>(data_length)};
+    try {
+        out->append(reinterpret_cast<const char*>(&header), sizeof(header));
+        out->append(session_key ? session_key : "", key_length);
+        out->append(reinterpret_cast<const char*>(shmac), shmac_length);
+        out->append(reinterpret_cast<const char*>(data), data_length);
+    } catch (const std::bad_alloc&) {
+        return CURLE_OUT_OF_MEMORY;
+    }
+    return CURLE_OK;
+}
+
+bool read_file(const std::string& path, std::string& contents) noexcept {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    bool ok = ::fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(HEADER_BYTES) &&
+              static_cast<size_t>(info.st_size) <= MAX_FILE_BYTES + HEADER_BYTES;
+    if (ok) {
+        try {
+            contents.resize(static_cast<size_t>(info.st_size));
+        } catch (const std::bad_alloc&) {
+            ok = false;
+        }
+    }
+    size_t offset = 0;
+    while (ok && offset < contents.size()) {
+        const ssize_t count = ::read(fd, contents.data() + offset, contents.size() - offset);
+        ok = count > 0;
+        offset += ok ? static_cast<size_t>(count) : 0;
+    }
+    ::close(fd);
+    return ok;
+}
+
+bool write_file(const std::string& path, const std::string& contents) noexcept {
+    std::string temporary;
+    try {
+        temporary = path + ".tmp";
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    size_t offset = 0;
+    bool ok = true;
+    while (ok && offset < contents.size()) {
+        const ssize_t count = ::write(fd, contents.data() + offset, contents.size() - offset);
+        ok = count > 0;
+        offset += ok ? static_cast<size_t>(count) : 0;
+    }
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+size_t load_tls_sessions(CURLSH* share, const std::string& path) noexcept {
+    std::string contents;
+    if (!read_file(path, contents)) {
+        return 0;
+    }
+
+    uint32_t magic = 0;
+    uint32_t expected = 0;
+    std::memcpy(&magic, contents.data(), sizeof(magic));
+    std::memcpy(&expected, contents.data() + sizeof(magic), sizeof(expected));
+    if (magic != MAGIC || expected != checksum(contents.data() + HEADER_BYTES, contents.size() - HEADER_BYTES)) {
+        return 0;
+    }
+
+    CURL* easy = share_easy(share);
+    if (!easy) {
+        return 0;
+    }
+
+    size_t imported = 0;
+    size_t offset = HEADER_BYTES;
+    while (contents.size() - offset >= sizeof(RecordHeader)) {
+        RecordHeader header{};
+        std::memcpy(&header, contents.data() + offset, sizeof(header));
+        offset += sizeof(header);
+        const size_t length = static_cast<size_t>(header.key_length) + header.shmac_length + header.data_length;
+        if (length > contents.size() - offset) {
+            break;
+        }
+
+        const char* key = contents.data() + offset;
+        const auto* shmac = reinterpret_cast<const unsigned char*>(key + header.key_length);
+        const unsigned char* data = shmac + header.shmac_length;
+        offset += length;
+        if (expired(header.valid_until)) {
+            continue;
+        }
+
+        // Keys are saved without their terminator
+        std::string session_key;
+        try {
+            session_key.assign(key, header.key_length);
+        } catch (const std::bad_alloc&) {
+            break;
+        }
+        if (curl_easy_ssls_import(easy, session_key.empty() ? nullptr : session_key.c_str(), shmac, header.shmac_length,
+                                  data, header.data_length) == CURLE_OK) {
+            ++imported;
+        }
+    }
+
+    curl_easy_cleanup(easy);
+    return imported;
+}
+
+bool save_tls_sessions(CURLSH* share, const std::string& path) noexcept {
+    CURL* easy = share_easy(share);
+    if (!easy) {
+        return false;
+    }
+
+    std::string contents;
+    CURLcode result = CURLE_OUT_OF_MEMORY;
+    try {
+        contents.assign(HEADER_BYTES, '\0');
+        result = curl_easy_ssls_export(easy, export_session, &contents);
+    } catch (const std::bad_alloc&) {
+    }
+    curl_easy_cleanup(easy);
+    if (result != CURLE_OK) {
+        return false;
+    }
+
+    const uint32_t sum = checksum(contents.data() + HEADER_BYTES, contents.size() - HEADER_BYTES);
+    std::memcpy(contents.data(), &MAGIC, sizeof(MAGIC));
+    std::memcpy(contents.data() + sizeof(MAGIC), &sum, sizeof(sum));
+    return write_file(path, contents);
+}
+
+#else
+
+size_t load_tls_sessions(CURLSH*, const std::string&) noexcept {
+    return 0;
+}
+
+bool save_tls_sessions(CURLSH*, const std::string&) noexcept {
+    return false;
+}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource
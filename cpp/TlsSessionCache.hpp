@@ -0,0 +1,24 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <cstddef>
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * TLS sessions of the shared connection pool, kept in a file so the first
+ * connection after a cold start resumes a session instead of running a full
+ * handshake. A save writes the whole file under a temporary name and renames
+ * it over the previous one, so one cut short leaves the older sessions.
+ * Needs libcurl 8.12 or later; with older builds nothing is stored.
+ */
+
+// Imports the unexpired sessions saved in `path` into `share`, returns how many
+size_t load_tls_sessions(CURLSH* share, const std::string& path) noexcept;
+
+// Replaces `path` with the unexpired sessions in `share`, false when it could not be written
+bool save_tls_sessions(CURLSH* share, const std::string& path) noexcept;
+
+} // namespace margelo::nitro::nitroeventsource
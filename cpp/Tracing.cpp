@@ -0,0 +1,89 @@
+#include "Tracing.hpp"
+
+#if defined(NITRO_EVENT_SOURCE_TRACING)
+
+#if defined(__ANDROID__)
+#include <android/trace.h>
+#include <dlfcn.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource::trace {
+
+#if defined(__APPLE__)
+
+os_log_t log() noexcept {
+    static const os_log_t instance = os_log_create("com.nitroeventsource", OS_LOG_CATEGORY_POINTS_OF_INTEREST);
+    return instance;
+}
+
+#elif defined(__ANDROID__)
+
+namespace {
+
+// Async sections and counters arrived in API 29, above our minSdk, so they are looked up at runtime
+struct AsyncTrace {
+    void (*begin_async)(const char*, int32_t) = nullptr;
+    void (*end_async)(const char*, int32_t) = nullptr;
+    void (*set_counter)(const char*, int64_t) = nullptr;
+};
+
+const AsyncTrace& async_trace() noexcept {
+    static const AsyncTrace functions = [] {
+        AsyncTrace resolved;
+        if (void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_NOLOAD)) {
+            resolved.begin_async = reinterpret_cast<void (*)(const char*, int32_t)>(dlsym(library, "ATrace_beginAsyncSection"));
+            resolved.end_async = reinterpret_cast<void (*)(const char*, int32_t)>(dlsym(library, "ATrace_endAsyncSection"));
+            resolved.set_counter = reinterpret_cast<void (*)(const char*, int64_t)>(dlsym(library, "ATrace_setCounter"));
+        }
+        return resolved;
+    }();
+    return functions;
+}
+
+int32_t cookie_of(const void* cookie) noexcept {
+    const auto bits = reinterpret_cast<uintptr_t>(cookie);
+    return static_cast<int32_t>(bits ^ (bits >> 32));
+}
+
+} // namespace
+
+void begin_section(const char* name) noexcept {
+    ATrace_beginSection(name);
+}
+
+void end_section() noexcept {
+    ATrace_endSection();
+}
+
+void begin_async(const char* name, const void* cookie) noexcept {
+    if (const auto begin = async_trace().begin_async; begin && ATrace_isEnabled()) {
+        begin(name, cookie_of(cookie));
+    }
+}
+
+void end_async(const char* name, const void* cookie) noexcept {
+    if (const auto end = async_trace().end_async; end && ATrace_isEnabled()) {
+        end(name, cookie_of(cookie));
+    }
+}
+
+void counter(const char* name, int64_t sample) noexcept {
+    if (const auto set_counter = async_trace().set_counter; set_counter && ATrace_isEnabled()) {
+        set_counter(name, sample);
+    }
+}
+
+#else
+
+// No platform tracer, the markers are accepted and dropped
+void begin_section(const char*) noexcept {}
+void end_section() noexcept {}
+void begin_async(const char*, const void*) noexcept {}
+void end_async(const char*, const void*) noexcept {}
+void counter(const char*, int64_t) noexcept {}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource::trace
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * Hot-path markers for Instruments and Perfetto: os_signpost intervals on Apple
+ * platforms, ATrace sections on Android (recorded by Perfetto's `atrace` data
+ * source, app category). Built only with NITRO_EVENT_SOURCE_TRACING, otherwise
+ * every macro expands to nothing.
+ *
+ * Names must be string literals, os_signpost keeps them in the binary.
+ *
+ *   NITRO_ES_TRACE_SCOPE("parse")                  // interval until the end of the scope
+ *   NITRO_ES_TRACE_ASYNC_BEGIN("connect", this)    // interval across callbacks, keyed by a pointer
+ *   NITRO_ES_TRACE_ASYNC_END("connect", this)
+ *   NITRO_ES_TRACE_VALUE("ttfb_us", micros)        // a sample on a named track
+ */
+
+#if defined(NITRO_EVENT_SOURCE_TRACING)
+
+#include <cstdint>
+
+#if defined(__APPLE__)
+#include <os/signpost.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource::trace {
+
+#if defined(__APPLE__)
+// Points of Interest, so markers show up without adding a custom instrument
+os_log_t log() noexcept;
+#else
+void begin_section(const char* name) noexcept;
+void end_section() noexcept;
+// Android 10+, earlier versions drop these
+void begin_async(const char* name, const void* cookie) noexcept;
+void end_async(const char* name, const void* cookie) noexcept;
+void counter(const char* name, int64_t sample) noexcept;
+#endif
+
+template <typename End>
+class ScopeEnd {
+public:
+    explicit ScopeEnd(End end) noexcept : _end(end) {}
+    ~ScopeEnd() { _end(); }
+    ScopeEnd(const ScopeEnd&) = delete;
+    ScopeEnd& operator=(const ScopeEnd&) = delete;
+
+private:
+    End _end;
+};
+
+} // namespace margelo::nitro::nitroeventsource::trace
+
+#define NITRO_ES_TRACE_CONCAT_INNER(a, b) a##b
+#define NITRO_ES_TRACE_CONCAT(a, b) NITRO_ES_TRACE_CONCAT_INNER(a, b)
+
+#if defined(__APPLE__)
+
+#define NITRO_ES_TRACE_SCOPE(name)                                                                                          \
+    const os_signpost_id_t NITRO_ES_TRACE_CONCAT(nitro_es_trace_id_, __LINE__) =                                            \
+        os_signpost_id_generate(::margelo::nitro::nitroeventsource::trace::log());                                          \
+    os_signpost_interval_begin(::margelo::nitro::nitroeventsource::trace::log(),                                            \
+                               NITRO_ES_TRACE_CONCAT(nitro_es_trace_id_, __LINE__), name);                                  \
+    const ::margelo::nitro::nitroeventsource::trace::ScopeEnd NITRO_ES_TRACE_CONCAT(nitro_es_trace_end_, __LINE__)([=] {    \
+        os_signpost_interval_end(::margelo::nitro::nitroeventsource::trace::log(),                                          \
+                                 NITRO_ES_TRACE_CONCAT(nitro_es_trace_id_, __LINE__), name);                                \
+    })
+#define NITRO_ES_TRACE_ASYNC_BEGIN(name, cookie)                                                                            \
+    os_signpost_interval_begin(::margelo::nitro::nitroeventsource::trace::log(),                                            \
+                               os_signpost_id_make_with_pointer(::margelo::nitro::nitroeventsource::trace::log(), cookie), \
+                               name)
+#define NITRO_ES_TRACE_ASYNC_END(name, cookie)                                                                              \
+    os_signpost_interval_end(::margelo::nitro::nitroeventsource::trace::log(),                                              \
+                             os_signpost_id_make_with_pointer(::margelo::nitro::nitroeventsource::trace::log(), cookie),   \
+                             name)
+#define NITRO_ES_TRACE_VALUE(name, sample)                                                                                  \
+    os_signpost_event_emit(::margelo::nitro::nitroeventsource::trace::log(), OS_SIGNPOST_ID_EXCLUSIVE, name, "%lld",        \
+                           static_cast<long long>(sample))
+
+#else
+
+#define NITRO_ES_TRACE_SCOPE(name)                                                                                          \
+    ::margelo::nitro::nitroeventsource::trace::begin_section(name);                                                         \
+    const ::margelo::nitro::nitroeventsource::trace::ScopeEnd NITRO_ES_TRACE_CONCAT(nitro_es_trace_end_, __LINE__)([] {     \
+        ::margelo::nitro::nitroeventsource::trace::end_section();                                                           \
+    })
+#define NITRO_ES_TRACE_ASYNC_BEGIN(name, cookie) ::margelo::nitro::nitroeventsource::trace::begin_async(name, cookie)
+#define NITRO_ES_TRACE_ASYNC_END(name, cookie) ::margelo::nitro::nitroeventsource::trace::end_async(name, cookie)
+#define NITRO_ES_TRACE_VALUE(name, sample) ::margelo::nitro::nitroeventsource::trace::counter(name, static_cast<int64_t>(sample))
+
+#endif
+
+#else
+
+#define NITRO_ES_TRACE_SCOPE(name) static_cast<void>(0)
+#define NITRO_ES_TRACE_ASYNC_BEGIN(name, cookie) static_cast<void>(0)
+#define NITRO_ES_TRACE_ASYNC_END(name, cookie) static_cast<void>(0)
+#define NITRO_ES_TRACE_VALUE(name, sample) static_cast<void>(0)
+
+#endif
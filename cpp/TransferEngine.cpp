@@ -0,0 +1,749 @@
+#include "TransferEngine.hpp"
+#include "Logger.hpp"
+#include "StorageDirectory.hpp"
+#include "TlsSessionCache.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <optional>
+#include <pthread.h>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#if defined(__APPLE__)
+#include <pthread/qos.h>
+#else
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+constexpr auto TAG = "TransferEngine";
+constexpr long DEFAULT_MAX_CONNECTIONS = 32;
+constexpr long DEFAULT_MAX_CONNECTIONS_PER_HOST = 6;
+
+// The engine's threads get this stack rather than the platform's default for secondary threads,
+// 1 MiB with bionic and 512 KiB on iOS. Their deepest stacks are a TLS handshake and a JSON
+// document nested to the parser's depth limit, well below it
+#ifndef NITRO_EVENT_SOURCE_THREAD_STACK_BYTES
+#define NITRO_EVENT_SOURCE_THREAD_STACK_BYTES (256 * 1024)
+#endif
+
+#if !defined(__APPLE__)
+// The cores of a big.LITTLE SoC's slowest cluster: those whose top frequency is the lowest.
+// None on a SoC whose cores are all alike, or where cpufreq cannot be read
+std::optional<cpu_set_t> efficiency_cores() noexcept {
+    const long count = std::min<long>(sysconf(_SC_NPROCESSORS_CONF), CPU_SETSIZE);
+    std::vector<long> max_khz;
+    for (long cpu = 0; cpu < count; ++cpu) {
+        char path[96];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%ld/cpufreq/cpuinfo_max_freq", cpu);
+        long khz = 0;
+        if (FILE* file = std::fopen(path, "r")) {
+            if (std::fscanf(file, "%ld", &khz) != 1) {
+                khz = 0;
+            }
+            std::fclose(file);
+        }
+        max_khz.push_back(khz);
+    }
+    const auto [slowest, fastest] = std::minmax_element(max_khz.begin(), max_khz.end());
+    if (max_khz.empty() || *slowest <= 0 || *slowest == *fastest) {
+        return std::nullopt;
+    }
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (size_t cpu = 0; cpu < max_khz.size(); ++cpu) {
+        if (max_khz[cpu] == *slowest) {
+            CPU_SET(cpu, &cores);
+        }
+    }
+    return cores;
+}
+
+// I/O thread only: an affinity of 0 applies to the calling thread
+void pin_to_efficiency_cores(bool pin) noexcept {
+    static const std::optional<cpu_set_t> efficiency = efficiency_cores();
+    // The mask the thread had before the first pin, restored afterwards
+    static std::optional<cpu_set_t> original;
+    if (!efficiency || (!pin && !original)) {
+        return;
+    }
+    if (pin && !original) {
+        cpu_set_t current;
+        if (sched_getaffinity(0, sizeof(current), &current) != 0) {
+            return;
+        }
+        original = current;
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set_t), pin ? &*efficiency : &*original) != 0) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to set I/O thread affinity");
+    }
+}
+#endif
+
+// Once, before any other libcurl call; left implicit, the first curl_easy_init() would do it
+// unsynchronized, on whichever thread happens to connect first
+CURLM* init_multi() noexcept {
+    const CURLcode result = curl_global_init(CURL_GLOBAL_DEFAULT);
+    if (result != CURLE_OK) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to initialize libcurl: " + std::string(curl_easy_strerror(result)));
+        return nullptr;
+    }
+    TransferEngine::prepare_platform_resolver();
+    return curl_multi_init();
+}
+} // namespace
+
+#if !(defined(__ANDROID__) && NITRO_EVENT_SOURCE_ARES)
+// The threaded resolver asks the system; c-ares reads the DNS servers itself, on iOS from libresolv
+void TransferEngine::prepare_platform_resolver() noexcept {}
+#endif
+
+// std::thread has no say over the stack, so the engine's threads are started detached through pthreads
+pthread_t TransferEngine::spawn_thread(void* (*entry)(void*), void* argument) {
+    constexpr size_t STACK_ALIGNMENT = 16 * 1024;
+    const size_t requested = std::max<size_t>(NITRO_EVENT_SOURCE_THREAD_STACK_BYTES, PTHREAD_STACK_MIN);
+    const size_t stack_bytes = (requested + STACK_ALIGNMENT - 1) / STACK_ALIGNMENT * STACK_ALIGNMENT;
+
+    pthread_attr_t attributes;
+    int result = pthread_attr_init(&attributes);
+    if (result == 0) {
+        pthread_attr_setstacksize(&attributes, stack_bytes);
+        pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+        pthread_t thread{};
+        result = pthread_create(&thread, &attributes, entry, argument);
+        pthread_attr_destroy(&attributes);
+        if (result == 0) {
+            return thread;
+        }
+    }
+    throw std::system_error(result, std::generic_category(), "pthread_create");
+}
+
+TransferEngine& TransferEngine::shared() {
+    // Intentionally leaked so the I/O thread never races static destruction at exit
+    static TransferEngine* engine = new TransferEngine();
+    return *engine;
+}
+
+void TransferEngine::warm_up() noexcept {
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // The first thread to use the engine becomes its I/O thread, it must be the test's
+    return;
+#endif
+    static std::atomic<bool> started{false};
+    if (started.exchange(true)) {
+        return;
+    }
+    try {
+        spawn_thread(
+            [](void*) noexcept -> void* {
+                try {
+                    shared();
+                } catch (const std::exception& e) {
+                    NITRO_ES_LOG_ERROR(TAG, "Failed to start transfer engine: " + std::string(e.what()));
+                }
+                return nullptr;
+            },
+            nullptr);
+    } catch (const std::system_error& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to start warm-up thread: " + std::string(e.what()));
+    }
+}
+
+TransferEngine::TransferEngine() : _multi(init_multi()) {
+    if (!_multi) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to initialize CURL multi handle");
+        return;
+    }
+
+    // Let HTTP/2 capable transfers to the same origin share one connection
+    curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    // A runaway loop opening streams queues them instead of opening sockets without end;
+    // six per host as browsers allow, HTTP/2 streams to one origin count as one
+    curl_multi_setopt(_multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, DEFAULT_MAX_CONNECTIONS);
+    curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, DEFAULT_MAX_CONNECTIONS_PER_HOST);
+    // libcurl's own deadlines come from curl_multi_timeout() each iteration, no timer callback needed
+    _use_reactor = _reactor.valid() && curl_multi_setopt(_multi, CURLMOPT_SOCKETFUNCTION, on_socket) == CURLM_OK &&
+                   curl_multi_setopt(_multi, CURLMOPT_SOCKETDATA, this) == CURLM_OK;
+    if (!_use_reactor) {
+        curl_multi_setopt(_multi, CURLMOPT_SOCKETFUNCTION, nullptr);
+        NITRO_ES_LOG_WARN(TAG, "No socket reactor, polling every transfer instead");
+    }
+
+    init_share();
+    // First in the queue, so even the first transfer can resume a session from the previous launch
+    post([this]() {
+        restore_tls_sessions();
+    });
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    _thread = pthread_self();
+#else
+    // The engine is never destroyed, so its thread runs detached
+    _thread = spawn_thread(
+        [](void* engine) noexcept -> void* {
+            static_cast<TransferEngine*>(engine)->run();
+            return nullptr;
+        },
+        this);
+#endif
+}
+
+void TransferEngine::post(Task task) {
+    {
+        const std::lock_guard<std::mutex> lock(_tasks_mutex);
+        _tasks.emplace_back(std::move(task));
+    }
+
+    if (_use_reactor) {
+        _reactor.wake();
+    } else if (_multi) {
+        curl_multi_wakeup(_multi);
+    }
+}
+
+TransferEngine::Timer TransferEngine::schedule(Clock::time_point deadline, Task task, Priority priority) {
+    const Timer timer{deadline, _next_timer_id.fetch_add(1, std::memory_order_relaxed)};
+    // Filed at once on the I/O thread, so a cancel() later in the same iteration finds it
+    if (is_io_thread()) {
+        _timers.insert(timer.id, timer.deadline, ScheduledTask{std::move(task), priority});
+        return timer;
+    }
+    post([this, timer, task = std::move(task), priority]() mutable {
+        _timers.insert(timer.id, timer.deadline, ScheduledTask{std::move(task), priority});
+    });
+    return timer;
+}
+
+void TransferEngine::cancel(const Timer& timer) {
+    if (is_io_thread()) {
+        _timers.erase(timer.id);
+        return;
+    }
+
+    post([this, timer]() {
+        _timers.erase(timer.id);
+    });
+}
+
+void TransferEngine::preconnect(std::string url, bool fresh, Completion on_done) {
+    constexpr long PRECONNECT_TIMEOUT_MS = 10000;
+
+    post([this, url = std::move(url), fresh, on_done = std::move(on_done)]() {
+        CURL* easy = curl_easy_init();
+        if (!easy) {
+            NITRO_ES_LOG_ERROR(TAG, "Failed to initialize CURL for preconnect");
+            if (on_done) {
+                on_done(CURLE_FAILED_INIT);
+            }
+            return;
+        }
+
+        // "OPTIONS *" asks about the server rather than a resource, so the stream endpoint never sees a request;
+        // DNS, the TLS session and the kept-alive connection then stay in the shared caches
+        curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, "OPTIONS");
+        curl_easy_setopt(easy, CURLOPT_REQUEST_TARGET, "*");
+        curl_easy_setopt(easy, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, PRECONNECT_TIMEOUT_MS);
+        if (fresh) {
+            curl_easy_setopt(easy, CURLOPT_FRESH_CONNECT, 1L);
+        }
+        if (_share) {
+            curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+        }
+
+        if (!add_transfer(easy, [easy, on_done](CURLcode result) {
+                curl_easy_cleanup(easy);
+                if (on_done) {
+                    on_done(result);
+                }
+            })) {
+            curl_easy_cleanup(easy);
+            if (on_done) {
+                on_done(CURLE_FAILED_INIT);
+            }
+        }
+    });
+}
+
+uint64_t TransferEngine::admit_reconnect(std::string origin, Priority priority, Task start) noexcept {
+    try {
+        const uint64_t ticket = _reconnects.enqueue(std::move(origin), static_cast<int>(priority), std::move(start));
+        start_admitted_reconnects();
+        return ticket;
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to queue reconnect: " + std::string(e.what()));
+        return 0;
+    }
+}
+
+void TransferEngine::finish_reconnect(uint64_t ticket, bool warmed) noexcept {
+    try {
+        _reconnects.finish(ticket, warmed);
+        start_admitted_reconnects();
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to finish reconnect: " + std::string(e.what()));
+    }
+}
+
+void TransferEngine::start_admitted_reconnects() noexcept {
+    // A handshake that neither opens nor fails in time, e.g. stuck behind curl's connection
+    // limits, lets the next origin go rather than holding up the queue
+    constexpr std::chrono::seconds SLOT_LEASE{10};
+
+    try {
+        std::vector<uint64_t> holding;
+        std::vector<std::pair<uint64_t, Task>> admitted = _reconnects.admit(&holding);
+        for (const uint64_t ticket : holding) {
+            _timers.insert(_next_timer_id.fetch_add(1, std::memory_order_relaxed), Clock::now() + SLOT_LEASE,
+                           ScheduledTask{[this, ticket]() { finish_reconnect(ticket, false); }, Priority::DEFAULT});
+        }
+        // Posted rather than run here, a start that fails straight away finishes its ticket re-entrantly
+        for (auto& [ticket, start] : admitted) {
+            post(std::move(start));
+        }
+    } catch (const std::exception& e) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to start reconnects: " + std::string(e.what()));
+    }
+}
+
+void TransferEngine::set_connection_limits(long max_connections, long max_connections_per_host) {
+    post([this, max_connections, max_connections_per_host]() {
+        curl_multi_setopt(_multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, max_connections);
+        curl_multi_setopt(_multi, CURLMOPT_MAX_HOST_CONNECTIONS, max_connections_per_host);
+    });
+}
+
+void TransferEngine::retain_priority(Priority priority, bool efficiency) {
+    {
+        const std::lock_guard<std::mutex> lock(_priority_mutex);
+        ++_priority_counts[static_cast<size_t>(priority)];
+        _efficiency_count += efficiency ? 1 : 0;
+    }
+    post([this]() { update_priority(); });
+}
+
+void TransferEngine::release_priority(Priority priority, bool efficiency) {
+    {
+        const std::lock_guard<std::mutex> lock(_priority_mutex);
+        size_t& count = _priority_counts[static_cast<size_t>(priority)];
+        count -= count > 0 ? 1 : 0;
+        _efficiency_count -= efficiency && _efficiency_count > 0 ? 1 : 0;
+    }
+    post([this]() { update_priority(); });
+}
+
+void TransferEngine::update_priority() noexcept {
+    // With no stream open there is nothing to prioritise, fall back to the default
+    Priority wanted = Priority::DEFAULT;
+    bool efficiency = false;
+    {
+        const std::lock_guard<std::mutex> lock(_priority_mutex);
+        for (size_t i = _priority_counts.size(); i-- > 0;) {
+            if (_priority_counts[i] > 0) {
+                wanted = static_cast<Priority>(i);
+                break;
+            }
+        }
+        // One thread serves every stream, so it only leaves the fast cores when no stream needs them
+        efficiency = wanted == Priority::BACKGROUND && _efficiency_count > 0;
+    }
+    if (wanted != _applied_priority || efficiency != _applied_efficiency) {
+        apply_priority(wanted, efficiency);
+    }
+}
+
+void TransferEngine::apply_priority(Priority priority, bool efficiency) noexcept {
+    _applied_priority = priority;
+    _applied_efficiency = efficiency;
+#if defined(__APPLE__)
+    // Only the calling thread's QoS can be changed, hence the I/O thread applies its own
+    const qos_class_t classes[] = {QOS_CLASS_UTILITY, QOS_CLASS_DEFAULT, QOS_CLASS_USER_INITIATED};
+    if (pthread_set_qos_class_self_np(classes[static_cast<size_t>(priority)], 0) != 0) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to set I/O thread QoS");
+    }
+#else
+    // Linux nice values are per thread, and `0` names the calling one. Android's
+    // THREAD_PRIORITY_BACKGROUND / DEFAULT / DISPLAY
+    const int nice_values[] = {10, 0, -4};
+    if (setpriority(PRIO_PROCESS, 0, nice_values[static_cast<size_t>(priority)]) != 0) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to set I/O thread priority");
+    }
+    pin_to_efficiency_cores(efficiency);
+#endif
+}
+
+bool TransferEngine::add_transfer(CURL* easy, Completion on_done, Priority priority) noexcept {
+    if (!_multi || !easy) {
+        return false;
+    }
+
+    const CURLMcode result = curl_multi_add_handle(_multi, easy);
+    if (result != CURLM_OK) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to add transfer: " + std::string(curl_multi_strerror(result)));
+        return false;
+    }
+
+    auto [it, inserted] = _transfers.insert_or_assign(easy, Transfer{std::move(on_done), priority});
+    if (inserted) {
+        ++_transfer_counts[static_cast<size_t>(priority)];
+    }
+    return true;
+}
+
+bool TransferEngine::remove_transfer(CURL* easy) noexcept {
+    if (!_multi || !easy) {
+        return false;
+    }
+
+    // Keep the completion alive until the handle is detached, it may own the stream
+    auto node = _transfers.extract(easy);
+    if (node.empty()) {
+        return false;
+    }
+    --_transfer_counts[static_cast<size_t>(node.mapped().priority)];
+    curl_multi_remove_handle(_multi, easy);
+    _deferred.erase(std::remove(_deferred.begin(), _deferred.end(), easy), _deferred.end());
+    return true;
+}
+
+bool TransferEngine::defer_write(CURL* easy, Priority priority) noexcept {
+    if (!_first_pass) {
+        return false;
+    }
+    for (size_t more_urgent = static_cast<size_t>(priority) + 1; more_urgent < _transfer_counts.size(); ++more_urgent) {
+        if (_transfer_counts[more_urgent] > 0) {
+            try {
+                _deferred.push_back(easy);
+            } catch (const std::bad_alloc&) {
+                return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransferEngine::resume_deferred() noexcept {
+    // Unpausing may deliver the held chunk right away, by now outside the first pass
+    std::vector<CURL*> deferred;
+    deferred.swap(_deferred);
+    for (CURL* easy : deferred) {
+        curl_easy_pause(easy, CURLPAUSE_CONT);
+    }
+    deferred.clear();
+    if (_deferred.empty()) {
+        _deferred.swap(deferred);
+    }
+}
+
+void TransferEngine::init_share() noexcept {
+    _share = curl_share_init();
+    if (!_share) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to initialize CURL share handle");
+        return;
+    }
+
+    curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, lock_share);
+    curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+    curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+
+    for (const curl_lock_data data : {CURL_LOCK_DATA_DNS, CURL_LOCK_DATA_SSL_SESSION, CURL_LOCK_DATA_CONNECT, CURL_LOCK_DATA_COOKIE}) {
+        const CURLSHcode result = curl_share_setopt(_share, CURLSHOPT_SHARE, data);
+        if (result != CURLSHE_OK) {
+            NITRO_ES_LOG_ERROR(TAG, "CURL share option error: " + std::string(curl_share_strerror(result)));
+        }
+    }
+}
+
+void TransferEngine::lock_share(CURL*, curl_lock_data data, curl_lock_access, void* userptr) noexcept {
+    auto* self = static_cast<TransferEngine*>(userptr);
+    if (self && data >= 0 && data < CURL_LOCK_DATA_LAST) {
+        self->_share_locks[data].lock();
+    }
+}
+
+void TransferEngine::unlock_share(CURL*, curl_lock_data data, void* userptr) noexcept {
+    auto* self = static_cast<TransferEngine*>(userptr);
+    if (self && data >= 0 && data < CURL_LOCK_DATA_LAST) {
+        self->_share_locks[data].unlock();
+    }
+}
+
+void TransferEngine::restore_tls_sessions() noexcept {
+    // Scripted transfers never handshake, so a test build neither reads nor writes the session file
+#if !defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    if (!_share) {
+        return;
+    }
+    try {
+        const std::string directory = resolve_storage_directory(std::nullopt);
+        if (directory.empty()) {
+            return;
+        }
+        _tls_session_path = directory + "/tls-sessions";
+    } catch (const std::bad_alloc&) {
+        return;
+    }
+
+    const size_t restored = load_tls_sessions(_share, _tls_session_path);
+    if (restored > 0) {
+        NITRO_ES_LOG_DEBUG(TAG, "Restored " + std::to_string(restored) + " TLS sessions");
+    }
+#endif
+}
+
+void TransferEngine::persist_tls_sessions() noexcept {
+#if !defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // TLS 1.3 servers send their tickets after the handshake, often after the response headers
+    constexpr auto SAVE_DELAY = std::chrono::seconds(5);
+
+    if (_tls_save_pending || _tls_session_path.empty()) {
+        return;
+    }
+    try {
+        schedule(Clock::now() + SAVE_DELAY, [this]() {
+            _tls_save_pending = false;
+            if (!save_tls_sessions(_share, _tls_session_path)) {
+                NITRO_ES_LOG_DEBUG(TAG, "Could not save TLS sessions");
+            }
+        }, Priority::BACKGROUND);
+        _tls_save_pending = true;
+    } catch (const std::bad_alloc&) {
+    }
+#endif
+}
+
+bool TransferEngine::is_io_thread() const noexcept {
+    return pthread_equal(pthread_self(), _thread) != 0;
+}
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+void TransferEngine::run_pending() noexcept {
+    while (true) {
+        run_posted_tasks();
+        run_due_timers();
+        const std::lock_guard<std::mutex> lock(_tasks_mutex);
+        if (_tasks.empty()) {
+            return;
+        }
+    }
+}
+
+void TransferEngine::advance(Clock::duration duration) noexcept {
+    // Timers scheduled from other threads are only filed once their posted task ran
+    run_pending();
+    const Clock::time_point until = Clock::now() + duration;
+    // A slot may come up a little before its deadline, the loop then stops at the next one
+    while (const std::optional<Clock::time_point> deadline = _timers.next_deadline()) {
+        if (*deadline > until) {
+            break;
+        }
+        VirtualClock::advance_to(*deadline);
+        run_pending();
+    }
+    VirtualClock::advance_to(until);
+    run_pending();
+}
+#endif
+
+void TransferEngine::run() noexcept {
+    // Named for profilers and traces; Linux allows 15 characters
+#if defined(__APPLE__)
+    pthread_setname_np("nitro-es-io");
+#else
+    pthread_setname_np(pthread_self(), "nitro-es-io");
+#endif
+
+    if (_use_reactor) {
+        run_reactor();
+    } else {
+        run_polling();
+    }
+}
+
+void TransferEngine::run_reactor() noexcept {
+    constexpr size_t MAX_READY_SOCKETS = 64;
+    std::array<SocketReactor::Event, MAX_READY_SOCKETS> ready;
+
+    while (true) {
+        run_posted_tasks();
+        run_due_timers();
+
+        const size_t count = _reactor.wait(next_poll_timeout_ms(), ready.data(), ready.size());
+
+        // First pass: less urgent transfers pause in their write callback, so the most
+        // urgent class parses and publishes its events before anyone else this iteration
+        _first_pass = true;
+        for (size_t i = 0; i < count; ++i) {
+            const SocketReactor::Event& event = ready[i];
+            socket_action(event.fd, (event.readable ? CURL_CSELECT_IN : 0) | (event.writable ? CURL_CSELECT_OUT : 0) |
+                                        (event.error ? CURL_CSELECT_ERR : 0));
+        }
+        run_curl_timeouts();
+        _first_pass = false;
+        read_finished_transfers();
+
+        // Second pass: unpausing makes the held back transfers due at once
+        if (!_deferred.empty()) {
+            resume_deferred();
+            run_curl_timeouts();
+            read_finished_transfers();
+        }
+    }
+}
+
+void TransferEngine::socket_action(curl_socket_t socket, int events) noexcept {
+    int running_transfers = 0;
+    const CURLMcode result = curl_multi_socket_action(_multi, socket, events, &running_transfers);
+    if (result != CURLM_OK) {
+        NITRO_ES_LOG_ERROR(TAG, "curl_multi_socket_action error: " + std::string(curl_multi_strerror(result)));
+    }
+}
+
+void TransferEngine::run_curl_timeouts() noexcept {
+    // Rounded up by curl, so 0 means due: new and unpaused transfers, connect and transfer timeouts
+    long timeout_ms = -1;
+    if (curl_multi_timeout(_multi, &timeout_ms) == CURLM_OK && timeout_ms == 0) {
+        socket_action(CURL_SOCKET_TIMEOUT, 0);
+    }
+}
+
+int TransferEngine::on_socket(CURL*, curl_socket_t socket, int what, void* userp, void*) noexcept {
+    auto* self = static_cast<TransferEngine*>(userp);
+    if (what == CURL_POLL_REMOVE) {
+        self->_reactor.unwatch(socket);
+    } else if (!self->_reactor.watch(socket, (what & CURL_POLL_IN) != 0, (what & CURL_POLL_OUT) != 0)) {
+        NITRO_ES_LOG_ERROR(TAG, "Failed to watch socket " + std::to_string(socket));
+    }
+    return 0;
+}
+
+void TransferEngine::run_polling() noexcept {
+    while (true) {
+        run_posted_tasks();
+        run_due_timers();
+
+        // First pass: less urgent transfers pause in their write callback, so the most
+        // urgent class parses and publishes its events before anyone else this iteration
+        _first_pass = true;
+        int running_transfers = 0;
+        const CURLMcode perform_result = curl_multi_perform(_multi, &running_transfers);
+        if (perform_result != CURLM_OK) {
+            NITRO_ES_LOG_ERROR(TAG, "curl_multi_perform error: " + std::string(curl_multi_strerror(perform_result)));
+        }
+        _first_pass = false;
+        read_finished_transfers();
+
+        // Second pass: everything that was held back
+        if (!_deferred.empty()) {
+            resume_deferred();
+            const CURLMcode deferred_result = curl_multi_perform(_multi, &running_transfers);
+            if (deferred_result != CURLM_OK) {
+                NITRO_ES_LOG_ERROR(TAG, "curl_multi_perform error: " + std::string(curl_multi_strerror(deferred_result)));
+            }
+            read_finished_transfers();
+        }
+
+        const CURLMcode poll_result = curl_multi_poll(_multi, nullptr, 0, next_poll_timeout_ms(), nullptr);
+        if (poll_result != CURLM_OK) {
+            NITRO_ES_LOG_ERROR(TAG, "curl_multi_poll error: " + std::string(curl_multi_strerror(poll_result)));
+        }
+    }
+}
+
+void TransferEngine::run_posted_tasks() noexcept {
+    std::vector<Task> tasks;
+    {
+        const std::lock_guard<std::mutex> lock(_tasks_mutex);
+        tasks.swap(_tasks);
+    }
+
+    for (auto& task : tasks) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in engine task: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in engine task");
+        }
+    }
+}
+
+void TransferEngine::run_due_timers() noexcept {
+    // Detach due timers first, a timer task may schedule new timers
+    std::vector<std::pair<Clock::time_point, ScheduledTask>> due;
+    _timers.expire(Clock::now(), due);
+    if (due.empty()) {
+        return;
+    }
+
+    // Reconnects that came due together start most urgent first
+    std::stable_sort(due.begin(), due.end(), [](const auto& a, const auto& b) {
+        return a.second.priority > b.second.priority;
+    });
+
+    for (auto& [deadline, scheduled] : due) {
+        try {
+            scheduled.task();
+        } catch (const std::exception& e) {
+            NITRO_ES_LOG_ERROR(TAG, "Exception in engine timer: " + std::string(e.what()));
+        } catch (...) {
+            NITRO_ES_LOG_ERROR(TAG, "Unknown exception in engine timer");
+        }
+    }
+}
+
+void TransferEngine::read_finished_transfers() noexcept {
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read(_multi, &queued)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        CURL* easy = message->easy_handle;
+        const CURLcode result = message->data.result;
+
+        auto node = _transfers.extract(easy);
+        curl_multi_remove_handle(_multi, easy);
+        if (node.empty()) {
+            continue;
+        }
+        --_transfer_counts[static_cast<size_t>(node.mapped().priority)];
+        _deferred.erase(std::remove(_deferred.begin(), _deferred.end(), easy), _deferred.end());
+
+        if (node.mapped().on_done) {
+            node.mapped().on_done(result);
+        }
+    }
+}
+
+int TransferEngine::next_poll_timeout_ms() const noexcept {
+    constexpr long IDLE_TIMEOUT_MS = 60000;
+
+    long timeout_ms = -1;
+    curl_multi_timeout(_multi, &timeout_ms);
+    if (timeout_ms < 0) {
+        timeout_ms = IDLE_TIMEOUT_MS;
+    }
+
+    if (const auto deadline = _timers.next_deadline()) {
+        const auto until_timer = std::chrono::ceil<std::chrono::milliseconds>(*deadline - Clock::now());
+        timeout_ms = std::min<long>(timeout_ms, std::max<long>(0, static_cast<long>(until_timer.count())));
+    }
+
+    return static_cast<int>(std::min<long>(timeout_ms, std::numeric_limits<int>::max()));
+}
+
+} // namespace margelo::nitro::nitroeventsource
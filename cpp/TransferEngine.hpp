@@ -0,0 +1,213 @@
+#pragma once
+
+#include "ReconnectGate.hpp"
+#include "SocketReactor.hpp"
+#include "TimerWheel.hpp"
+
+#include <curl/curl.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <pthread.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+/**
+ * Host tests and benchmarks only: time that stands still until
+ * TransferEngine::advance() moves it. It shares steady_clock's time points, so
+ * everything keyed on TransferEngine::Clock reads it unchanged; it starts an
+ * hour in, as a default constructed time point means "never" to the streams.
+ */
+struct VirtualClock {
+    using duration = std::chrono::steady_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::steady_clock::time_point;
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept {
+        return time_point(duration(_now.load(std::memory_order_acquire)));
+    }
+    // Never backwards
+    static void advance_to(time_point at) noexcept {
+        rep current = _now.load(std::memory_order_relaxed);
+        while (at.time_since_epoch().count() > current &&
+               !_now.compare_exchange_weak(current, at.time_since_epoch().count(), std::memory_order_acq_rel)) {
+        }
+    }
+
+private:
+    static inline std::atomic<rep> _now{std::chrono::duration_cast<duration>(std::chrono::hours(1)).count()};
+};
+#endif
+
+/**
+ * Process-wide transfer engine.
+ * A single I/O thread drives every EventSource connection through one
+ * `curl_multi` handle. curl reports the sockets it waits on to a SocketReactor
+ * (epoll or kqueue), and the thread sleeps in it until a socket is ready, a
+ * timer is due or another thread posts work; then only the ready sockets are
+ * serviced. Without a reactor it falls back to `curl_multi_poll`.
+ *
+ * Built with NITRO_EVENT_SOURCE_TEST_ENGINE, for host tests and benchmarks and
+ * never for an app, there is no I/O thread: the thread that first uses the
+ * engine is its I/O thread, and posted tasks and timers run only from
+ * run_pending() and advance(), on a VirtualClock. Streams open no transfers and
+ * take their responses from HybridNitroEventSource's script_*() calls instead,
+ * and no TLS sessions are saved or restored. test/transfer_engine_test.cpp is
+ * built this way by the top-level CMakeLists.txt.
+ */
+class TransferEngine {
+public:
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    using Clock = VirtualClock;
+#else
+    using Clock = std::chrono::steady_clock;
+#endif
+    using Task = std::function<void()>;
+    using Completion = std::function<void(CURLcode /* result */)>;
+
+    // Ordered by urgency, the I/O thread runs at the highest one any open stream holds
+    enum class Priority { BACKGROUND = 0, DEFAULT = 1, INTERACTIVE = 2 };
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t id = 0;
+    };
+
+    static TransferEngine& shared();
+    // Thread-safe: creates the shared engine on a background thread, so initializing libcurl
+    // and TLS lands neither on the caller nor on whichever stream happens to connect first
+    static void warm_up() noexcept;
+
+    // Set-up the resolver needs before libcurl's first lookup, once; defined per platform, only
+    // c-ares on Android needs any (NetworkMonitorAndroid.cpp)
+    static void prepare_platform_resolver() noexcept;
+
+    // Starts a detached thread with the engine's stack size, see NITRO_EVENT_SOURCE_THREAD_STACK_BYTES;
+    // throws std::system_error like std::thread when it cannot be created
+    static pthread_t spawn_thread(void* (*entry)(void*), void* argument);
+
+    TransferEngine(const TransferEngine&) = delete;
+    TransferEngine& operator=(const TransferEngine&) = delete;
+
+    // Thread-safe: run `task` on the I/O thread as soon as possible
+    void post(Task task);
+    // Thread-safe: run `task` on the I/O thread once `deadline` has passed; timers due together run most urgent first
+    Timer schedule(Clock::time_point deadline, Task task, Priority priority = Priority::DEFAULT);
+    // Thread-safe: drop a pending timer together with everything its task captured
+    void cancel(const Timer& timer);
+    // Thread-safe: resolve, connect and handshake with the origin of `url` so the first stream finds a pooled connection.
+    // `fresh` opens a new connection even when the pool has one; `on_done` runs on the I/O thread once it got through or failed
+    void preconnect(std::string url, bool fresh = false, Completion on_done = nullptr);
+    // Thread-safe: cap the connections all transfers together hold, in total and per host, 0 for no cap.
+    // Transfers beyond them wait in curl's queue until a connection frees up or can be multiplexed onto
+    void set_connection_limits(long max_connections, long max_connections_per_host);
+    // Thread-safe: count an open stream of `priority` towards the I/O thread's QoS, or stop counting it.
+    // `efficiency`: a background stream asking for efficiency cores, which the thread keeps to on
+    // Android while every open stream is background
+    void retain_priority(Priority priority, bool efficiency = false);
+    void release_priority(Priority priority, bool efficiency = false);
+
+    // I/O thread only: start driving `easy`, `on_done` runs once it finishes
+    bool add_transfer(CURL* easy, Completion on_done, Priority priority = Priority::DEFAULT) noexcept;
+    // I/O thread only: stop driving `easy` without running its completion, false when it was not running
+    bool remove_transfer(CURL* easy) noexcept;
+    // I/O thread only, from a write callback: true when `easy` must return CURL_WRITEFUNC_PAUSE so that
+    // more urgent transfers are serviced first; it is resumed later in the same loop iteration
+    bool defer_write(CURL* easy, Priority priority) noexcept;
+    // I/O thread only: save the pool's TLS sessions for the next launch, shortly after a connection opens
+    void persist_tls_sessions() noexcept;
+    // I/O thread only: run `start` once a reconnect to `origin` may handshake, see ReconnectGate;
+    // the ticket goes back through finish_reconnect() once the connection opens or gives up
+    uint64_t admit_reconnect(std::string origin, Priority priority, Task start) noexcept;
+    // I/O thread only: `warmed` when the connection opened; unknown or finished tickets are ignored
+    void finish_reconnect(uint64_t ticket, bool warmed) noexcept;
+
+    bool is_io_thread() const noexcept;
+
+#if defined(NITRO_EVENT_SOURCE_TEST_ENGINE)
+    // I/O thread only: run posted tasks and due timers until none is left
+    void run_pending() noexcept;
+    // I/O thread only: move the clock `duration` ahead, stopping at each timer deadline on the way to run what came due
+    void advance(Clock::duration duration) noexcept;
+#endif
+
+    // Share handle that pools DNS, TLS sessions, connections and the cookie jar across every stream
+    CURLSH* share_handle() const noexcept { return _share; }
+
+private:
+    TransferEngine();
+    ~TransferEngine() = default;
+
+    void run() noexcept;
+    void run_reactor() noexcept;
+    void run_polling() noexcept;
+    void socket_action(curl_socket_t socket, int events) noexcept;
+    void run_curl_timeouts() noexcept;
+    void run_posted_tasks() noexcept;
+    void run_due_timers() noexcept;
+    void read_finished_transfers() noexcept;
+    void resume_deferred() noexcept;
+    int next_poll_timeout_ms() const noexcept;
+    void update_priority() noexcept;
+    void apply_priority(Priority priority, bool efficiency) noexcept;
+    void init_share() noexcept;
+    void start_admitted_reconnects() noexcept;
+    void restore_tls_sessions() noexcept;
+
+    static void lock_share(CURL* handle, curl_lock_data data, curl_lock_access access, void* userptr) noexcept;
+    static void unlock_share(CURL* handle, curl_lock_data data, void* userptr) noexcept;
+    static int on_socket(CURL* easy, curl_socket_t socket, int what, void* userp, void* socketp) noexcept;
+
+    CURLM* _multi = nullptr;
+    CURLSH* _share = nullptr;
+    SocketReactor _reactor;
+    // Set once at construction: curl's sockets go to _reactor rather than curl_multi_poll()
+    bool _use_reactor = false;
+    std::array<std::mutex, CURL_LOCK_DATA_LAST> _share_locks;
+    pthread_t _thread{};
+
+    std::mutex _tasks_mutex;
+    std::vector<Task> _tasks;
+    std::atomic<uint64_t> _next_timer_id{1};
+
+    std::mutex _priority_mutex;
+    std::array<size_t, 3> _priority_counts{};
+    size_t _efficiency_count = 0;
+    // Owned by the I/O thread
+    Priority _applied_priority = Priority::DEFAULT;
+    bool _applied_efficiency = false;
+    std::string _tls_session_path;
+    bool _tls_save_pending = false;
+
+    struct ScheduledTask {
+        Task task;
+        Priority priority;
+    };
+    struct Transfer {
+        Completion on_done;
+        Priority priority;
+    };
+
+    // Owned by the I/O thread: reconnect backoffs, idle timeouts, batch flushes and keep-warm
+    // timers of every stream, so arming and cancelling them stays O(1) with thousands pending
+    TimerWheel<ScheduledTask> _timers{Clock::now()};
+    std::unordered_map<CURL*, Transfer> _transfers;
+    // Owned by the I/O thread: reconnects after the network returns, a few origins at a time
+    ReconnectGate _reconnects{4};
+    // Open transfers per priority, the most urgent class with any is serviced in the first pass
+    std::array<size_t, 3> _transfer_counts{};
+    bool _first_pass = false;
+    std::vector<CURL*> _deferred;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,194 @@
+#include "WarmStartCache.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::nitroeventsource {
+
+namespace {
+
+constexpr uint32_t MAGIC = 0x4e455357; // "NESW"
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t capacity;
+};
+
+struct RecordHeader {
+    uint32_t checksum;
+    uint32_t id_bytes;
+    uint32_t data_bytes;
+    uint32_t reserved;
+};
+
+constexpr size_t ALIGNMENT = 8;
+
+size_t align_up(size_t value) noexcept {
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+uint32_t checksum(const RecordHeader& header, const std::byte* payload) noexcept {
+    uint32_t hash = 2166136261u ^ header.id_bytes;
+    hash = (hash ^ header.data_bytes) * 16777619u;
+    const size_t payload_bytes = size_t{header.id_bytes} + header.data_bytes;
+    for (size_t i = 0; i < payload_bytes; ++i) {
+        hash ^= static_cast<uint32_t>(payload[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+} // namespace
+
+struct WarmStartCache::SlotHeader {
+    // Written once when a type first claims the slot, length last
+    uint32_t type_bytes;
+    char type[MAX_TYPE_BYTES];
+    // Odd sequences use the second record, bumped once it is complete; 0 means empty
+    std::atomic<uint64_t> sequence;
+};
+
+std::unique_ptr<WarmStartCache> WarmStartCache::open(const std::string& path, size_t max_event_bytes) noexcept {
+    const size_t capacity = align_up(max_event_bytes);
+    const size_t mapping_bytes = align_up(sizeof(FileHeader)) +
+                                 MAX_TYPES * (align_up(sizeof(SlotHeader)) + 2 * (sizeof(RecordHeader) + capacity));
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    // A file of another size is emptied and regrown sparse, slots nobody writes take no disk space
+    struct stat info {};
+    const bool known = ::fstat(fd, &info) == 0;
+    const bool resized = known && static_cast<size_t>(info.st_size) != mapping_bytes;
+    const bool sized = known && (!resized || (::ftruncate(fd, 0) == 0 && ::ftruncate(fd, static_cast<off_t>(mapping_bytes)) == 0));
+    void* mapping = sized ? ::mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    std::unique_ptr<WarmStartCache> cache(new (std::nothrow) WarmStartCache(static_cast<std::byte*>(mapping), mapping_bytes, capacity));
+    if (!cache) {
+        ::munmap(mapping, mapping_bytes);
+        return nullptr;
+    }
+
+    auto* header = static_cast<FileHeader*>(mapping);
+    if (header->magic != MAGIC || header->capacity != capacity) {
+        // New or foreign file: start empty
+        if (!resized) {
+            std::memset(mapping, 0, mapping_bytes);
+        }
+        header->magic = MAGIC;
+        header->capacity = static_cast<uint32_t>(capacity);
+        for (size_t i = 0; i < MAX_TYPES; ++i) {
+            new (cache->slot(i)) SlotHeader{};
+        }
+    }
+    return cache;
+}
+
+WarmStartCache::~WarmStartCache() {
+    ::munmap(_mapping, _mapping_bytes);
+}
+
+size_t WarmStartCache::slot_bytes() const noexcept {
+    return align_up(sizeof(SlotHeader)) + 2 * (sizeof(RecordHeader) + _capacity);
+}
+
+WarmStartCache::SlotHeader* WarmStartCache::slot(size_t index) const noexcept {
+    return reinterpret_cast<SlotHeader*>(_mapping + align_up(sizeof(FileHeader)) + index * slot_bytes());
+}
+
+std::byte* WarmStartCache::record(const SlotHeader* slot, uint64_t sequence) const noexcept {
+    return reinterpret_cast<std::byte*>(const_cast<SlotHeader*>(slot)) + align_up(sizeof(SlotHeader)) +
+           (sequence & 1) * (sizeof(RecordHeader) + _capacity);
+}
+
+WarmStartCache::SlotHeader* WarmStartCache::find_slot(std::string_view type) const noexcept {
+    for (size_t i = 0; i < MAX_TYPES; ++i) {
+        SlotHeader* candidate = slot(i);
+        if (candidate->type_bytes == type.size() && std::memcmp(candidate->type, type.data(), type.size()) == 0) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+void WarmStartCache::store(std::string_view type, std::string_view id, std::string_view data) noexcept {
+    if (type.empty() || type.size() > MAX_TYPE_BYTES) {
+        return;
+    }
+
+    const std::lock_guard<std::mutex> lock(_mutex);
+    SlotHeader* target = find_slot(type);
+    if (!target) {
+        // Claim the first free slot, types beyond MAX_TYPES are not cached
+        for (size_t i = 0; i < MAX_TYPES && !target; ++i) {
+            if (slot(i)->type_bytes == 0) {
+                target = slot(i);
+            }
+        }
+        if (!target) {
+            return;
+        }
+        std::memcpy(target->type, type.data(), type.size());
+        target->type_bytes = static_cast<uint32_t>(type.size());
+    }
+
+    // Too large to cache: an older event must not be served in its place
+    if (id.size() + data.size() > _capacity) {
+        target->sequence.store(0, std::memory_order_release);
+        return;
+    }
+
+    const uint64_t sequence = target->sequence.load(std::memory_order_relaxed) + 1;
+    std::byte* next = record(target, sequence);
+    std::byte* payload = next + sizeof(RecordHeader);
+    RecordHeader header{0, static_cast<uint32_t>(id.size()), static_cast<uint32_t>(data.size()), 0};
+    std::memcpy(payload, id.data(), id.size());
+    std::memcpy(payload + id.size(), data.data(), data.size());
+    header.checksum = checksum(header, payload);
+    std::memcpy(next, &header, sizeof(header));
+    target->sequence.store(sequence, std::memory_order_release);
+}
+
+std::optional<NitroEventSourceEvent> WarmStartCache::load(std::string_view type) const {
+    const std::lock_guard<std::mutex> lock(_mutex);
+    const SlotHeader* source = find_slot(type);
+    const uint64_t sequence = source ? source->sequence.load(std::memory_order_acquire) : 0;
+    if (sequence == 0) {
+        return std::nullopt;
+    }
+
+    // Fall back to the older record if the newer one was left half written
+    for (const uint64_t candidate : {sequence, sequence - 1}) {
+        if (candidate == 0) {
+            break;
+        }
+        const std::byte* stored = record(source, candidate);
+        RecordHeader header;
+        std::memcpy(&header, stored, sizeof(header));
+        const std::byte* payload = stored + sizeof(RecordHeader);
+        if (size_t{header.id_bytes} + header.data_bytes > _capacity || header.checksum != checksum(header, payload)) {
+            continue;
+        }
+
+        const auto* text = reinterpret_cast<const char*>(payload);
+        NitroEventSourceEvent event;
+        event.id.assign(text, header.id_bytes);
+        event.type.assign(type);
+        event.data.assign(text + header.id_bytes, header.data_bytes);
+        return event;
+    }
+    return std::nullopt;
+}
+
+} // namespace margelo::nitro::nitroeventsource
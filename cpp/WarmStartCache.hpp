@@ -0,0 +1,54 @@
+#pragma once
+
+#include "NitroEventSourceEvent.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * The most recent event of each type, kept in a memory-mapped file so a screen
+ * subscribing after a cold start can paint from the previous session at once.
+ * Each type owns a fixed slot with two alternating records, so a write cut short
+ * leaves the previous event readable. Stores come from the I/O thread and loads
+ * from the JS thread.
+ */
+class WarmStartCache {
+public:
+    static constexpr size_t MAX_TYPES = 32;
+    static constexpr size_t MAX_TYPE_BYTES = 64;
+
+    // Returns nullptr when the file cannot be created or mapped
+    static std::unique_ptr<WarmStartCache> open(const std::string& path, size_t max_event_bytes) noexcept;
+    ~WarmStartCache();
+
+    WarmStartCache(const WarmStartCache&) = delete;
+    WarmStartCache& operator=(const WarmStartCache&) = delete;
+
+    // Events whose id and data exceed max_event_bytes clear their type's slot instead
+    void store(std::string_view type, std::string_view id, std::string_view data) noexcept;
+    std::optional<NitroEventSourceEvent> load(std::string_view type) const;
+
+private:
+    struct SlotHeader;
+
+    WarmStartCache(std::byte* mapping, size_t mapping_bytes, size_t capacity) noexcept
+        : _mapping(mapping), _mapping_bytes(mapping_bytes), _capacity(capacity) {}
+
+    size_t slot_bytes() const noexcept;
+    SlotHeader* slot(size_t index) const noexcept;
+    std::byte* record(const SlotHeader* slot, uint64_t sequence) const noexcept;
+    SlotHeader* find_slot(std::string_view type) const noexcept;
+
+    std::byte* const _mapping;
+    const size_t _mapping_bytes;
+    const size_t _capacity;
+    mutable std::mutex _mutex;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,108 @@
+#include "ZstdDictionaryDecoder.hpp"
+
+#include <new>
+
+// Defined by builds that link libzstd, see android/CMakeLists.txt and NitroEventSource.podspec
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+#if defined(NITRO_EVENT_SOURCE_ZSTD)
+
+struct ZstdDictionaryDecoder::State {
+    ZSTD_DCtx* context = nullptr;
+    ZSTD_DDict* dictionary = nullptr;
+};
+
+ZstdDictionaryDecoder::ZstdDictionaryDecoder(const std::vector<uint8_t>& dictionary)
+    : _state(new (std::nothrow) State()) {
+    if (!_state) {
+        return;
+    }
+
+    // The digested dictionary is built once and referenced by every frame of every response
+    _state->dictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+    _state->context = ZSTD_createDCtx();
+    if (_state->context && _state->dictionary) {
+        ZSTD_DCtx_refDDict(_state->context, _state->dictionary);
+    }
+}
+
+ZstdDictionaryDecoder::~ZstdDictionaryDecoder() {
+    if (_state) {
+        ZSTD_freeDCtx(_state->context);
+        ZSTD_freeDDict(_state->dictionary);
+        delete _state;
+    }
+}
+
+bool ZstdDictionaryDecoder::available() noexcept {
+    return true;
+}
+
+bool ZstdDictionaryDecoder::valid() const noexcept {
+    return _state && _state->context && _state->dictionary;
+}
+
+void ZstdDictionaryDecoder::reset() noexcept {
+    if (valid()) {
+        ZSTD_DCtx_reset(_state->context, ZSTD_reset_session_only);
+    }
+}
+
+bool ZstdDictionaryDecoder::decode(std::string_view input, std::string& out) noexcept {
+    if (!valid()) {
+        return false;
+    }
+
+    try {
+        const size_t step = ZSTD_DStreamOutSize();
+        ZSTD_inBuffer in{input.data(), input.size(), 0};
+        while (true) {
+            const size_t written = out.size();
+            out.resize(written + step);
+            ZSTD_outBuffer output{out.data() + written, step, 0};
+
+            const size_t result = ZSTD_decompressStream(_state->context, &output, &in);
+            out.resize(written + output.pos);
+            if (ZSTD_isError(result)) {
+                return false;
+            }
+
+            // A full output buffer may leave decoded bytes behind even once the input is consumed
+            if (in.pos == in.size && output.pos < output.size) {
+                return true;
+            }
+        }
+    } catch (const std::bad_alloc&) {
+        return false;
+    }
+}
+
+#else
+
+struct ZstdDictionaryDecoder::State {};
+
+ZstdDictionaryDecoder::ZstdDictionaryDecoder(const std::vector<uint8_t>&) {}
+
+ZstdDictionaryDecoder::~ZstdDictionaryDecoder() = default;
+
+bool ZstdDictionaryDecoder::available() noexcept {
+    return false;
+}
+
+bool ZstdDictionaryDecoder::valid() const noexcept {
+    return false;
+}
+
+void ZstdDictionaryDecoder::reset() noexcept {}
+
+bool ZstdDictionaryDecoder::decode(std::string_view, std::string&) noexcept {
+    return false;
+}
+
+#endif
+
+} // namespace margelo::nitro::nitroeventsource
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+/**
+ * Streaming zstd decoder primed with a pre-shared dictionary.
+ * Small, similar events compress poorly on their own; both sides agreeing on
+ * a dictionary up front lets every frame reference it instead. Only
+ * functional in builds with NITRO_EVENT_SOURCE_ZSTD, which link libzstd;
+ * `available()` reports whether that is the case.
+ */
+class ZstdDictionaryDecoder {
+public:
+    explicit ZstdDictionaryDecoder(const std::vector<uint8_t>& dictionary);
+    ~ZstdDictionaryDecoder();
+
+    ZstdDictionaryDecoder(const ZstdDictionaryDecoder&) = delete;
+    ZstdDictionaryDecoder& operator=(const ZstdDictionaryDecoder&) = delete;
+
+    static bool available() noexcept;
+
+    // False when the dictionary could not be loaded
+    bool valid() const noexcept;
+
+    // Starts a new response body, keeping the dictionary
+    void reset() noexcept;
+
+    // Appends the plain bytes of `input` to `out`, returns false on corrupt input
+    bool decode(std::string_view input, std::string& out) noexcept;
+
+private:
+    struct State;
+    State* _state = nullptr;
+};
+
+} // namespace margelo::nitro::nitroeventsource
@@ -16,6 +16,8 @@ import {
 import EventSource, {
   type NitroEventSourceEvent,
 } from 'react-native-nitro-event-source';
+import { DeliveryBenchmark } from './bench/DeliveryBenchmark';
+import { LoadBenchmark } from './bench/LoadBenchmark';
 
 const { width } = Dimensions.get('window');
 
@@ -56,6 +58,7 @@ function App(): React.JSX.Element {
   const [eventSource, setEventSource] = useState<EventSource | null>(null);
   const [isDarkMode, setIsDarkMode] = useState(false);
   const [soundEnabled, setSoundEnabled] = useState(true);
+  const [showBenchmark, setShowBenchmark] = useState(false);
   const [selectedFilter, setSelectedFilter] = useState<string>('all');
   const [eventStats, setEventStats] = useState<EventStats>({
     message: 0,
@@ -512,6 +515,19 @@ function App(): React.JSX.Element {
                 thumbColor={isDarkMode ? '#f4f3f4' : '#f4f3f4'}
               />
             </View>
+            <View style={styles.themeToggle}>
+              <Text
+                style={[styles.toggleLabel, { color: theme.onSurfaceVariant }]}
+              >
+                ⏱️
+              </Text>
+              <Switch
+                value={showBenchmark}
+                onValueChange={setShowBenchmark}
+                trackColor={{ false: '#767577', true: theme.primary }}
+                thumbColor="#f4f3f4"
+              />
+            </View>
           </View>
         </View>
       </View>
@@ -576,6 +592,13 @@ function App(): React.JSX.Element {
         </View>
       </View>
 
+      {showBenchmark && (
+        <>
+          <LoadBenchmark />
+          <DeliveryBenchmark />
+        </>
+      )}
+
       {/* Event Statistics */}
       <View style={[styles.statsCard, { backgroundColor: theme.surface }]}>
         <Text style={[styles.statsTitle, { color: theme.onSurface }]}>
@@ -0,0 +1,295 @@
+import React, { useCallback, useState } from 'react';
+import {
+  Platform,
+  StyleSheet,
+  Text,
+  TextInput,
+  TouchableOpacity,
+  View,
+} from 'react-native';
+import { NitroModules } from 'react-native-nitro-modules';
+import type {
+  NitroEventSourceEvent,
+  NitroEventSourceOptions,
+} from 'react-native-nitro-event-source';
+import { reportBenchmark } from './report';
+
+// The native object the EventSource wrapper drives, used directly so each delivery path can be picked
+interface NativeEventSource {
+  create(url: string, options?: NitroEventSourceOptions): NativeEventSource;
+  close(): void;
+  setEventCallback(callback: (event: NitroEventSourceEvent) => void): void;
+  setBatchCallback(callback: (events: NitroEventSourceEvent[]) => void): void;
+  setDrainCallback(callback: () => void): void;
+  drainEvents(): NitroEventSourceEvent[];
+  addEventListener(
+    type: string,
+    listener: (event: NitroEventSourceEvent) => void,
+  ): number;
+  setDataCallback(callback: (chunk: ArrayBuffer) => void): void;
+}
+
+const factory =
+  NitroModules.createHybridObject<any>('NitroEventSource') as NativeEventSource;
+
+// Served by `npm run bench-server`, see bench/server.js
+const benchUrl = Platform.select({
+  ios: 'http://localhost:8090/bench',
+  android: 'http://10.0.2.2:8090/bench',
+});
+
+const EVENTS = 10000;
+const TIMEOUT_MS = 30000;
+
+// Every handler reads `data`, which is what makes lazy host objects convert it
+function read(events: NitroEventSourceEvent[]): number {
+  let length = 0;
+  for (const event of events) {
+    length += event.data.length;
+  }
+  return length;
+}
+
+interface Strategy {
+  name: string;
+  options?: NitroEventSourceOptions;
+  // Wires `onEvents` to the stream, called with how many events and `data` characters just arrived
+  attach(
+    source: NativeEventSource,
+    onEvents: (count: number, length: number) => void,
+  ): void;
+}
+
+const strategies: Strategy[] = [
+  {
+    name: 'Per-event callback',
+    attach: (source, onEvents) =>
+      source.setEventCallback(event => onEvents(1, read([event]))),
+  },
+  {
+    // What dispatch_event does when a callback and a listener are both set
+    name: 'Callback + listener',
+    attach: (source, onEvents) => {
+      source.setEventCallback(event => onEvents(1, read([event])));
+      source.addEventListener('message', event => {
+        read([event]);
+      });
+    },
+  },
+  {
+    name: 'Batched arrays',
+    options: { batch: {} },
+    attach: (source, onEvents) =>
+      source.setBatchCallback(events => {
+        onEvents(events.length, read(events));
+      }),
+  },
+  {
+    // The EventSource wrapper's path
+    name: 'Drain',
+    attach: (source, onEvents) =>
+      source.setDrainCallback(() => {
+        const events = source.drainEvents();
+        onEvents(events.length, read(events));
+      }),
+  },
+  {
+    name: 'Drain, lazy host objects',
+    options: { lazyPayloads: true },
+    attach: (source, onEvents) =>
+      source.setDrainCallback(() => {
+        const events = source.drainEvents();
+        onEvents(events.length, read(events));
+      }),
+  },
+  {
+    // Raw bytes, counting frame ends is the least a JS parser would do
+    name: 'ArrayBuffer (rawMode)',
+    options: { rawMode: true },
+    attach: (source, onEvents) => {
+      let previous = 0;
+      source.setDataCallback(chunk => {
+        const bytes = new Uint8Array(chunk);
+        let events = 0;
+        for (let i = 0; i < bytes.length; i++) {
+          if (bytes[i] === 10 && previous === 10) {
+            events++;
+          }
+          previous = bytes[i];
+        }
+        onEvents(events, bytes.length);
+      });
+    },
+  },
+];
+
+interface StrategyResult {
+  name: string;
+  // From the first event arriving in JS to the last one, the JS thread being the bottleneck
+  wallMs: number;
+  // `data` that reached JS, to check every strategy materialized the payloads
+  length: number;
+  completed: boolean;
+}
+
+function measure(url: string, strategy: Strategy): Promise<StrategyResult> {
+  return new Promise(resolve => {
+    const source = factory.create(url, strategy.options);
+    let received = 0;
+    let firstAt = 0;
+    let length = 0;
+    let done = false;
+
+    const finish = (completed: boolean) => {
+      if (done) {
+        return;
+      }
+      done = true;
+      clearTimeout(timeout);
+      source.close();
+      resolve({
+        name: strategy.name,
+        wallMs: firstAt ? performance.now() - firstAt : 0,
+        length,
+        completed,
+      });
+    };
+    const timeout = setTimeout(() => finish(false), TIMEOUT_MS);
+
+    strategy.attach(source, (count, chars) => {
+      if (!firstAt && count > 0) {
+        firstAt = performance.now();
+      }
+      received += count;
+      length += chars;
+      if (received >= EVENTS) {
+        finish(true);
+      }
+    });
+  });
+}
+
+export function DeliveryBenchmark(): React.JSX.Element {
+  const [url, setUrl] = useState(benchUrl!);
+  const [size, setSize] = useState(64);
+  const [running, setRunning] = useState(false);
+  const [results, setResults] = useState<StrategyResult[]>([]);
+
+  const run = useCallback(async () => {
+    setRunning(true);
+    setResults([]);
+    // One burst per strategy, so delivery rather than the network sets the pace
+    const burstUrl = `${url}?count=${EVENTS}&rate=1000000&size=${size}`;
+    const metrics: Record<string, number> = {};
+    for (const strategy of strategies) {
+      const result = await measure(burstUrl, strategy);
+      setResults(prev => [...prev, result]);
+      // A run that timed out has no meaningful time to compare
+      if (result.completed) {
+        metrics[`${result.name} wallMs`] = result.wallMs;
+      }
+    }
+    setRunning(false);
+    reportBenchmark(url, {
+      benchmark: 'delivery',
+      config: { events: EVENTS, size },
+      metrics,
+    });
+  }, [url, size]);
+
+  return (
+    <View style={styles.card}>
+      <Text style={styles.title}>🔀 Delivery Benchmark</Text>
+      <TextInput
+        style={styles.input}
+        value={url}
+        onChangeText={setUrl}
+        editable={!running}
+      />
+      <View style={styles.row}>
+        <Text style={styles.label}>Bytes/event</Text>
+        <TextInput
+          style={[styles.input, styles.sizeInput]}
+          keyboardType="number-pad"
+          value={String(size)}
+          onChangeText={text => setSize(Number(text) || 0)}
+          editable={!running}
+        />
+      </View>
+      <TouchableOpacity
+        style={[styles.button, running && styles.buttonDisabled]}
+        onPress={run}
+        disabled={running}
+      >
+        <Text style={styles.buttonText}>
+          {running ? '⏳ Running...' : `▶️ Deliver ${EVENTS} events`}
+        </Text>
+      </TouchableOpacity>
+      {results.map(result => (
+        <Text key={result.name} style={styles.result}>
+          {result.name}:{' '}
+          {result.completed
+            ? `${result.wallMs.toFixed(1)} ms, ${(result.length / 1024).toFixed(0)} KB read`
+            : 'timed out'}
+        </Text>
+      ))}
+    </View>
+  );
+}
+
+const styles = StyleSheet.create({
+  card: {
+    marginHorizontal: 16,
+    marginTop: 12,
+    padding: 16,
+    borderRadius: 16,
+    backgroundColor: '#ffffff',
+  },
+  title: {
+    fontSize: 16,
+    fontWeight: '600',
+    marginBottom: 12,
+  },
+  row: {
+    flexDirection: 'row',
+    alignItems: 'center',
+    gap: 8,
+    marginTop: 8,
+  },
+  label: {
+    fontSize: 11,
+    fontWeight: '500',
+    color: '#6c757d',
+  },
+  input: {
+    borderWidth: 1,
+    borderColor: '#dee2e6',
+    borderRadius: 12,
+    paddingHorizontal: 12,
+    paddingVertical: 8,
+    fontSize: 14,
+  },
+  sizeInput: {
+    flex: 1,
+  },
+  button: {
+    marginTop: 12,
+    paddingVertical: 12,
+    borderRadius: 12,
+    alignItems: 'center',
+    backgroundColor: '#6200ea',
+  },
+  buttonDisabled: {
+    backgroundColor: '#6c757d',
+  },
+  buttonText: {
+    fontSize: 14,
+    fontWeight: '600',
+    color: '#ffffff',
+  },
+  result: {
+    marginTop: 8,
+    fontFamily: Platform.OS === 'ios' ? 'Menlo' : 'monospace',
+    fontSize: 12,
+  },
+});
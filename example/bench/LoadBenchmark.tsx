@@ -0,0 +1,314 @@
+import React, { useCallback, useRef, useState } from 'react';
+import {
+  Platform,
+  StyleSheet,
+  Text,
+  TextInput,
+  TouchableOpacity,
+  View,
+} from 'react-native';
+import EventSource, {
+  type LatencyHistogram,
+} from 'react-native-nitro-event-source';
+import { reportBenchmark } from './report';
+
+// Served by `npm run bench-server`, see bench/server.js
+const benchUrl = Platform.select({
+  ios: 'http://localhost:8090/bench',
+  android: 'http://10.0.2.2:8090/bench',
+});
+
+interface BenchConfig {
+  streams: number;
+  rate: number;
+  size: number;
+  seconds: number;
+  // Impairments bench/server.js applies, 0 turns one off
+  splitBytes: number;
+  jitterMs: number;
+  dropEvery: number;
+}
+
+interface BenchResult {
+  eventsPerSecond: number;
+  megabytesPerSecond: number;
+  delivered: number;
+  dropped: number;
+  reconnects: number;
+  serverP50Ms: number;
+  serverP99Ms: number;
+  dispatchP99Ms: number;
+  // Bytes per second of CPU time the parser spent, independent of the network
+  parserMBps: number;
+  // From constructing each EventSource to its `open`, median
+  startP50Ms: number;
+  // Peak of the bytes each stream held natively for JS
+  perStreamBufferedBytes: number;
+  // Worst delay of a 100 ms JS timer, how busy delivery kept the JS thread
+  jsStallMs: number;
+}
+
+// Percentile over histograms of several streams, same bucket bounds as the native side
+function percentileMs(histograms: LatencyHistogram[], fraction: number): number {
+  const buckets: number[] = [];
+  let total = 0;
+  let max = 0;
+  for (const histogram of histograms) {
+    histogram.buckets.forEach((count, i) => {
+      buckets[i] = (buckets[i] ?? 0) + count;
+      total += count;
+    });
+    max = Math.max(max, histogram.maxUs);
+  }
+  const rank = Math.floor(fraction * total);
+  let seen = 0;
+  for (let i = 0; i < buckets.length; i++) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return Math.min(max, 2 ** i) / 1000;
+    }
+  }
+  return max / 1000;
+}
+
+export function LoadBenchmark(): React.JSX.Element {
+  const [url, setUrl] = useState(benchUrl!);
+  const [config, setConfig] = useState<BenchConfig>({
+    streams: 4,
+    rate: 1000,
+    size: 256,
+    seconds: 10,
+    splitBytes: 0,
+    jitterMs: 0,
+    dropEvery: 0,
+  });
+  // Weighted event type mix, e.g. `message:8,update:1,ping:1`
+  const [types, setTypes] = useState('message');
+  const [running, setRunning] = useState(false);
+  const [result, setResult] = useState<BenchResult | null>(null);
+  const sources = useRef<EventSource[]>([]);
+
+  const run = useCallback(() => {
+    setRunning(true);
+    setResult(null);
+
+    let delivered = 0;
+    const count = () => {
+      delivered++;
+    };
+    const startMs: number[] = [];
+    let peakBufferedBytes = 0;
+    // A query per stream keeps them from sharing one connection
+    sources.current = Array.from({ length: config.streams }, (_, i) => {
+      const query =
+        `rate=${config.rate}&size=${config.size}&stream=${i}` +
+        `&types=${encodeURIComponent(types)}&splitBytes=${config.splitBytes}` +
+        `&jitterMs=${config.jitterMs}&dropEvery=${config.dropEvery}`;
+      const createdAt = performance.now();
+      const source = new EventSource(`${url}?${query}`, {
+        latencyTracing: { field: 'ts' },
+        cpuAccounting: true,
+      });
+      source.onmessage = count;
+      // Only the first open, dropEvery reconnects would skew it
+      let opened = false;
+      source.onopen = () => {
+        if (!opened) {
+          opened = true;
+          startMs.push(performance.now() - createdAt);
+        }
+      };
+      return source;
+    });
+
+    let jsStallMs = 0;
+    let lastTick = Date.now();
+    const stallTimer = setInterval(() => {
+      const now = Date.now();
+      jsStallMs = Math.max(jsStallMs, now - lastTick - 100);
+      lastTick = now;
+      for (const source of sources.current) {
+        peakBufferedBytes = Math.max(
+          peakBufferedBytes,
+          source.getMetrics().bufferedBytes,
+        );
+      }
+    }, 100);
+
+    const started = Date.now();
+    setTimeout(() => {
+      clearInterval(stallTimer);
+      const elapsedSeconds = (Date.now() - started) / 1000;
+      const metrics = sources.current.map(source => source.getMetrics());
+      sources.current.forEach(source => source.close());
+      sources.current = [];
+
+      const bytes = metrics.reduce((sum, m) => sum + m.bytesReceived, 0);
+      const cpuParseMs = metrics.reduce((sum, m) => sum + m.cpuParseMs, 0);
+      startMs.sort((a, b) => a - b);
+      const benchResult: BenchResult = {
+        eventsPerSecond: delivered / elapsedSeconds,
+        megabytesPerSecond: bytes / elapsedSeconds / 1e6,
+        delivered,
+        dropped: metrics.reduce((sum, m) => sum + m.eventsDropped, 0),
+        reconnects: metrics.reduce((sum, m) => sum + m.reconnects, 0),
+        serverP50Ms: percentileMs(metrics.map(m => m.serverLatency), 0.5),
+        serverP99Ms: percentileMs(metrics.map(m => m.serverLatency), 0.99),
+        dispatchP99Ms: percentileMs(metrics.map(m => m.dispatchLatency), 0.99),
+        parserMBps: cpuParseMs > 0 ? bytes / cpuParseMs / 1e3 : 0,
+        startP50Ms: startMs[Math.floor(startMs.length / 2)] ?? 0,
+        perStreamBufferedBytes: peakBufferedBytes,
+        jsStallMs,
+      };
+      setResult(benchResult);
+      setRunning(false);
+      reportBenchmark(url, {
+        benchmark: 'load',
+        config: { ...config, types },
+        metrics: { ...benchResult },
+      });
+    }, config.seconds * 1000);
+  }, [url, config, types]);
+
+  const field = (key: keyof BenchConfig, label: string) => (
+    <View style={styles.field}>
+      <Text style={styles.label}>{label}</Text>
+      <TextInput
+        style={styles.input}
+        keyboardType="number-pad"
+        value={String(config[key])}
+        onChangeText={text =>
+          setConfig(prev => ({ ...prev, [key]: Number(text) || 0 }))
+        }
+        editable={!running}
+      />
+    </View>
+  );
+
+  return (
+    <View style={styles.card}>
+      <Text style={styles.title}>⏱️ Load Benchmark</Text>
+      <TextInput
+        style={styles.input}
+        value={url}
+        onChangeText={setUrl}
+        editable={!running}
+      />
+      <View style={styles.row}>
+        {field('streams', 'Streams')}
+        {field('rate', 'Events/s each')}
+        {field('size', 'Bytes/event')}
+        {field('seconds', 'Seconds')}
+      </View>
+      <View style={styles.row}>
+        {field('splitBytes', 'Split bytes')}
+        {field('jitterMs', 'Jitter ms')}
+        {field('dropEvery', 'Drop every s')}
+      </View>
+      <View style={styles.field}>
+        <Text style={[styles.label, styles.labelSpaced]}>Type mix</Text>
+        <TextInput
+          style={styles.input}
+          value={types}
+          onChangeText={setTypes}
+          autoCapitalize="none"
+          editable={!running}
+        />
+      </View>
+      <TouchableOpacity
+        style={[styles.button, running && styles.buttonDisabled]}
+        onPress={run}
+        disabled={running}
+      >
+        <Text style={styles.buttonText}>
+          {running ? '⏳ Running...' : '▶️ Run'}
+        </Text>
+      </TouchableOpacity>
+      {result && (
+        <View>
+          <Text style={styles.result}>
+            {result.eventsPerSecond.toFixed(0)} events/s •{' '}
+            {result.megabytesPerSecond.toFixed(2)} MB/s
+          </Text>
+          <Text style={styles.result}>
+            Delivered {result.delivered} • dropped {result.dropped} •
+            reconnects {result.reconnects}
+          </Text>
+          <Text style={styles.result}>
+            Server → native p50 {result.serverP50Ms.toFixed(2)} ms • p99{' '}
+            {result.serverP99Ms.toFixed(2)} ms
+          </Text>
+          <Text style={styles.result}>
+            Native → JS p99 {result.dispatchP99Ms.toFixed(2)} ms • JS stall{' '}
+            {result.jsStallMs} ms
+          </Text>
+          <Text style={styles.result}>
+            Parser {result.parserMBps.toFixed(1)} MB/s CPU • start p50{' '}
+            {result.startP50Ms.toFixed(0)} ms • buffered peak{' '}
+            {(result.perStreamBufferedBytes / 1024).toFixed(0)} KB
+          </Text>
+        </View>
+      )}
+    </View>
+  );
+}
+
+const styles = StyleSheet.create({
+  card: {
+    marginHorizontal: 16,
+    marginTop: 12,
+    padding: 16,
+    borderRadius: 16,
+    backgroundColor: '#ffffff',
+  },
+  title: {
+    fontSize: 16,
+    fontWeight: '600',
+    marginBottom: 12,
+  },
+  row: {
+    flexDirection: 'row',
+    gap: 8,
+    marginTop: 8,
+  },
+  field: {
+    flex: 1,
+  },
+  label: {
+    fontSize: 11,
+    fontWeight: '500',
+    marginBottom: 4,
+    color: '#6c757d',
+  },
+  labelSpaced: {
+    marginTop: 8,
+  },
+  input: {
+    borderWidth: 1,
+    borderColor: '#dee2e6',
+    borderRadius: 12,
+    paddingHorizontal: 12,
+    paddingVertical: 8,
+    fontSize: 14,
+  },
+  button: {
+    marginTop: 12,
+    paddingVertical: 12,
+    borderRadius: 12,
+    alignItems: 'center',
+    backgroundColor: '#6200ea',
+  },
+  buttonDisabled: {
+    backgroundColor: '#6c757d',
+  },
+  buttonText: {
+    fontSize: 14,
+    fontWeight: '600',
+    color: '#ffffff',
+  },
+  result: {
+    marginTop: 8,
+    fontFamily: Platform.OS === 'ios' ? 'Menlo' : 'monospace',
+    fontSize: 12,
+  },
+});
@@ -0,0 +1,98 @@
+/**
+ * Checks benchmark reports against the committed baselines, so a native change
+ * that slows streaming down shows up before it ships.
+ *
+ *   node bench/compare.js [reports] [--tolerance 0.1] [--update]
+ *
+ * `reports` is bench/results.ndjson by default, where bench/server.js appends
+ * what the app posts; a saved Metro or logcat log works too, only lines with
+ * NITRO_ES_BENCH are read. The latest report per platform, benchmark and
+ * config is compared with bench/baselines.json. Metrics whose name ends in
+ * `Ms` or `Bytes` regress by growing, all others by shrinking, beyond
+ * `tolerance` (default 10%). Exits 1 on a regression. `--update` records the
+ * reports as the new baselines instead, e.g. on a reference device after an
+ * intended change.
+ */
+const fs = require('fs');
+const path = require('path');
+
+const PREFIX = 'NITRO_ES_BENCH ';
+const BASELINES = path.join(__dirname, 'baselines.json');
+
+const args = process.argv.slice(2);
+const update = args.includes('--update');
+const toleranceAt = args.indexOf('--tolerance');
+const tolerance = toleranceAt >= 0 ? Number(args[toleranceAt + 1]) : 0.1;
+const input =
+  args.find((arg, i) => !arg.startsWith('--') && args[i - 1] !== '--tolerance') ||
+  path.join(__dirname, 'results.ndjson');
+
+// Platform, benchmark and config, keys sorted so the same run always lands on the same baseline
+function keyOf(report) {
+  const config = Object.keys(report.config || {})
+    .sort()
+    .map(name => `${name}=${report.config[name]}`)
+    .join(',');
+  return `${report.platform}/${report.benchmark}/${config}`;
+}
+
+function lowerIsBetter(metric) {
+  return /(Ms|Bytes)$/.test(metric);
+}
+
+const latest = new Map();
+for (const line of fs.readFileSync(input, 'utf8').split('\n')) {
+  const at = line.indexOf(PREFIX);
+  const json = at >= 0 ? line.slice(at + PREFIX.length) : line.trim();
+  if (!json.startsWith('{')) {
+    continue;
+  }
+  try {
+    const report = JSON.parse(json);
+    if (report.benchmark && report.metrics) {
+      latest.set(keyOf(report), report);
+    }
+  } catch {
+    // Half a line in a truncated log
+  }
+}
+if (latest.size === 0) {
+  console.error(`No benchmark reports in ${input}`);
+  process.exit(2);
+}
+
+const baselines = fs.existsSync(BASELINES) ? JSON.parse(fs.readFileSync(BASELINES, 'utf8')) : {};
+
+if (update) {
+  for (const [key, report] of latest) {
+    baselines[key] = { recorded: report.at, osVersion: report.osVersion, metrics: report.metrics };
+  }
+  const sorted = Object.fromEntries(Object.keys(baselines).sort().map(key => [key, baselines[key]]));
+  fs.writeFileSync(BASELINES, JSON.stringify(sorted, null, 2) + '\n');
+  console.log(`Recorded ${latest.size} baselines in ${path.relative(process.cwd(), BASELINES)}`);
+  process.exit(0);
+}
+
+let regressions = 0;
+for (const [key, report] of latest) {
+  const baseline = baselines[key];
+  console.log(`\n${key}`);
+  if (!baseline) {
+    console.log('  no baseline, record one with --update');
+    continue;
+  }
+  for (const [metric, value] of Object.entries(report.metrics)) {
+    const expected = baseline.metrics[metric];
+    if (typeof expected !== 'number' || expected === 0) {
+      console.log(`  ${metric}: ${value} (no baseline)`);
+      continue;
+    }
+    const change = (value - expected) / expected;
+    const worse = lowerIsBetter(metric) ? change > tolerance : change < -tolerance;
+    regressions += worse ? 1 : 0;
+    const percent = `${change >= 0 ? '+' : ''}${(change * 100).toFixed(1)}%`;
+    console.log(`  ${worse ? 'REGRESSED' : 'ok       '} ${metric}: ${value} vs ${expected} (${percent})`);
+  }
+}
+console.log(`\n${regressions} regression${regressions === 1 ? '' : 's'} beyond ${(tolerance * 100).toFixed(0)}%`);
+process.exit(regressions > 0 ? 1 : 0);
@@ -0,0 +1,34 @@
+import { Platform } from 'react-native';
+
+export interface BenchReport {
+  benchmark: string;
+  // What the numbers depend on; only a baseline recorded with the same config is compared
+  config: Record<string, number | string>;
+  // Names ending in `Ms` or `Bytes` are better lower, the rest higher, see bench/compare.js
+  metrics: Record<string, number>;
+}
+
+// Marks report lines in Metro and device logs, for `bench-compare` to pick out
+export const REPORT_PREFIX = 'NITRO_ES_BENCH ';
+
+/**
+ * Logs `report` as one JSON line and posts it to bench/server.js, which appends
+ * it to bench/results.ndjson; `npm run bench-compare` checks that file against
+ * the committed baselines.
+ */
+export function reportBenchmark(benchUrl: string, report: BenchReport): void {
+  const line = JSON.stringify({
+    ...report,
+    platform: Platform.OS,
+    osVersion: String(Platform.Version),
+    at: new Date().toISOString(),
+  });
+  console.log(REPORT_PREFIX + line);
+  fetch(benchUrl.replace(/\/bench(\?.*)?$/, '/results'), {
+    method: 'POST',
+    headers: { 'Content-Type': 'application/json' },
+    body: line,
+  }).catch(() => {
+    // A server without /results, the log line is still there
+  });
+}
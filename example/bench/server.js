@@ -0,0 +1,162 @@
+/**
+ * Load generator for the benchmark screen: an SSE endpoint streaming events at a
+ * fixed rate and payload size, each stamped with the send time in a `ts:` field
+ * that `latencyTracing: { field: 'ts' }` picks up.
+ *
+ *   node bench/server.js [port]
+ *   GET /bench?rate=1000&size=256   events per second, data bytes per event
+ *   GET /bench?count=10000&rate=1e6  stop after `count` events, here one burst
+ *   POST /results                    appends a benchmark report to bench/results.ndjson
+ *
+ * Traffic shape, all optional:
+ *   types=message:8,update:1,ping:1  event types mixed by weight (default only `message`)
+ *   sizeJitter=0.5                   payload sizes spread uniformly over size ±50%
+ *
+ * Network impairments, all optional:
+ *   splitBytes=7       cut every write into pieces this small, lines and events straddle reads
+ *   jitterMs=50        hold each tick's write back by up to this long
+ *   stallEvery=5&stallMs=2000  go silent for stallMs every stallEvery seconds
+ *   dropEvery=10       drop the connection every this many seconds; ids resume from
+ *                      Last-Event-ID on reconnect, as a real server's would
+ *
+ * Events for one 10 ms tick go out in a single write, like a busy upstream would,
+ * unless splitBytes cuts it up.
+ */
+const fs = require('fs');
+const http = require('http');
+const path = require('path');
+
+const port = Number(process.argv[2] || process.env.PORT || 8090);
+const TICK_MS = 10;
+const RESULTS = path.join(__dirname, 'results.ndjson');
+
+// `message:8,update:1` to a picker honouring the weights
+function typePicker(spec) {
+  const entries = (spec || 'message')
+    .split(',')
+    .map(entry => {
+      const [type, weight] = entry.split(':');
+      return { type: type.trim(), weight: Math.max(0, Number(weight ?? 1) || 0) };
+    })
+    .filter(entry => entry.type && entry.weight > 0);
+  const total = entries.reduce((sum, entry) => sum + entry.weight, 0);
+  if (total === 0) {
+    return () => 'message';
+  }
+  return () => {
+    let pick = Math.random() * total;
+    for (const entry of entries) {
+      pick -= entry.weight;
+      if (pick < 0) {
+        return entry.type;
+      }
+    }
+    return entries[entries.length - 1].type;
+  };
+}
+
+function stream(request, response, params) {
+  const rate = Math.max(1, Number(params.get('rate')) || 1000);
+  const size = Math.max(0, Number(params.get('size')) || 256);
+  const count = Number(params.get('count')) || Infinity;
+  const sizeJitter = Math.min(1, Math.max(0, Number(params.get('sizeJitter')) || 0));
+  const pickType = typePicker(params.get('types'));
+  const splitBytes = Math.max(0, Number(params.get('splitBytes')) || 0);
+  const jitterMs = Math.max(0, Number(params.get('jitterMs')) || 0);
+  const stallEveryMs = Math.max(0, Number(params.get('stallEvery')) || 0) * 1000;
+  const stallMs = Math.max(0, Number(params.get('stallMs')) || 0);
+  const dropEveryMs = Math.max(0, Number(params.get('dropEvery')) || 0) * 1000;
+  const payload = 'x'.repeat(Math.ceil(size * (1 + sizeJitter)));
+  // A reconnect continues the sequence, so gaps show up as missing ids
+  const resumeFrom = Number(request.headers['last-event-id']);
+  const firstId = Number.isFinite(resumeFrom) ? resumeFrom + 1 : 0;
+
+  response.writeHead(200, {
+    'Content-Type': 'text/event-stream',
+    'Cache-Control': 'no-cache',
+    Connection: 'keep-alive',
+  });
+  response.socket.setNoDelay(true);
+
+  const write = chunk => {
+    if (splitBytes === 0) {
+      response.write(chunk);
+      return;
+    }
+    for (let i = 0; i < chunk.length; i += splitBytes) {
+      response.write(chunk.slice(i, i + splitBytes));
+    }
+  };
+
+  let sent = 0;
+  const started = Date.now();
+  const timers = new Set();
+  let releaseAt = 0;
+  const timer = setInterval(() => {
+    const elapsed = Date.now() - started;
+    if (dropEveryMs > 0 && elapsed >= dropEveryMs) {
+      response.socket.destroy();
+      return;
+    }
+    // Stalled: the schedule keeps running, so the backlog arrives in one burst afterwards
+    if (stallEveryMs > 0 && elapsed % stallEveryMs >= stallEveryMs - stallMs) {
+      return;
+    }
+    // Catch up to the schedule rather than assuming every tick fired on time
+    const due =
+      Math.min(Math.floor((elapsed * rate) / 1000), count - firstId) - sent;
+    if (due <= 0) {
+      return;
+    }
+    let chunk = '';
+    const now = Date.now();
+    for (let i = 0; i < due; i++) {
+      const type = pickType();
+      const length = Math.round(size * (1 + sizeJitter * (Math.random() * 2 - 1)));
+      chunk += `id: ${firstId + sent + i}\n`;
+      if (type !== 'message') {
+        chunk += `event: ${type}\n`;
+      }
+      chunk += `ts: ${now}\ndata: ${payload.slice(0, length)}\n\n`;
+    }
+    sent += due;
+    if (jitterMs === 0) {
+      write(chunk);
+      return;
+    }
+    // Never before the tick held back ahead of it, so the stream stays in order
+    releaseAt = Math.max(releaseAt, now + Math.random() * jitterMs);
+    const delayed = setTimeout(() => {
+      timers.delete(delayed);
+      write(chunk);
+    }, releaseAt - now);
+    timers.add(delayed);
+  }, TICK_MS);
+
+  request.on('close', () => {
+    clearInterval(timer);
+    timers.forEach(clearTimeout);
+  });
+}
+
+http
+  .createServer((request, response) => {
+    const url = new URL(request.url, 'http://localhost');
+    if (url.pathname === '/bench') {
+      stream(request, response, url.searchParams);
+      return;
+    }
+    if (url.pathname === '/results' && request.method === 'POST') {
+      let body = '';
+      request.on('data', chunk => (body += chunk));
+      request.on('end', () => {
+        fs.appendFileSync(RESULTS, body.replace(/\n/g, ' ') + '\n');
+        response.writeHead(204).end();
+      });
+      return;
+    }
+    response.writeHead(404).end();
+  })
+  .listen(port, () => {
+    console.log(`SSE load server on http://localhost:${port}/bench`);
+  });
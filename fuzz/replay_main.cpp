@@ -0,0 +1,74 @@
+/**
+ * Runs a fuzz target without libFuzzer: every file named on the command line,
+ * or in a directory named there, then `--random N` inputs from a fixed seed,
+ * so a run under ctest checks the same inputs every time.
+ *
+ *   build/sse_parser_fuzzer_replay fuzz/corpus --random 20000
+ *   build/sse_parser_fuzzer_replay crash-0123abcd
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+namespace {
+
+void run(const std::vector<uint8_t>& input) {
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+void run_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    run(std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+}
+
+// Mostly the bytes streams are made of, so the inputs reach past the framing into fields and events
+void run_random(size_t count) {
+    constexpr std::string_view ALPHABET = "data: x\r\n:ide\xC3\xA9\xE2\x82\xAC\xF0\x9F\x91\x8B\xEF\xBB\xBF\x80\xFF";
+    std::mt19937 random(20250101);
+    std::vector<uint8_t> input;
+    for (size_t i = 0; i < count; ++i) {
+        input.clear();
+        // The header: oversize policy, then a limit of 1 to 64 or none for each of line, event and chunk
+        input.push_back(static_cast<uint8_t>(random() % 3));
+        for (int limit = 0; limit < 3; ++limit) {
+            input.push_back(static_cast<uint8_t>(random() % 2 == 0 ? '0' : 0x40 | (random() % 64)));
+        }
+        const size_t length = random() % 400;
+        for (size_t k = 0; k < length; ++k) {
+            input.push_back(static_cast<uint8_t>(ALPHABET[random() % ALPHABET.size()]));
+        }
+        run(input);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument == "--random" && i + 1 < argc) {
+            run_random(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::filesystem::is_directory(argument)) {
+            for (const auto& entry : std::filesystem::directory_iterator(argument)) {
+                run_file(entry.path());
+            }
+        } else if (std::filesystem::exists(argument)) {
+            run_file(argument);
+        } else {
+            std::fprintf(stderr, "No such input: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    std::puts("ok");
+    return 0;
+}
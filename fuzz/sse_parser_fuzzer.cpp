@@ -0,0 +1,171 @@
+/**
+ * libFuzzer target for SseParser, also usable with AFL++ (afl-clang-fast
+ * -fsanitize=fuzzer). The first four bytes of an input pick the limits, the
+ * rest is the body; see limits_from(). Each body is parsed whole, in pieces
+ * derived from its bytes and one byte at a time, and the sink must see the
+ * same fields and events every time, as SseParser promises. Whatever came out
+ * must also be valid UTF-8, and data reported as ASCII must be.
+ *
+ * Without -DNITRO_EVENT_SOURCE_FUZZ=ON the same checks build into
+ * sse_parser_fuzzer_replay, which runs fuzz/corpus and a fixed set of random
+ * inputs under ctest; a crash file from the fuzzer replays with it too.
+ */
+#include "SseParser.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace margelo::nitro::nitroeventsource;
+
+namespace {
+
+// What a sink saw, in order; data that went out in chunks is joined, where the chunks fall may differ
+struct Recording {
+    std::vector<std::string> log;
+    std::string chunked;
+};
+
+struct RecordingSink {
+    Recording* out;
+
+    void on_field(SseField field, std::string_view name, std::string_view value) {
+        check_text(name);
+        check_text(value);
+        out->log.push_back("F" + std::to_string(static_cast<int>(field)) + std::string(name) + "=" + std::string(value));
+    }
+    void on_comment() { out->log.emplace_back("C"); }
+    void on_event(std::string& data, bool dropped, bool ascii) {
+        check_text(data);
+        if (ascii) {
+            for (const char c : data) {
+                require(static_cast<unsigned char>(c) < 0x80, "data reported as ASCII is not");
+            }
+        }
+        out->log.push_back(std::string(dropped ? "D" : "E") + out->chunked + data);
+        out->chunked.clear();
+    }
+    bool on_data_chunk(std::string& data, SseChunk) {
+        check_text(data);
+        out->chunked += data;
+        return true;
+    }
+
+    static void require(bool condition, const char* what) {
+        if (!condition) {
+            std::fprintf(stderr, "sse_parser_fuzzer: %s\n", what);
+            std::abort();
+        }
+    }
+
+    static void check_text(std::string_view text) {
+        require(valid_utf8(text), "the sink got ill-formed UTF-8");
+    }
+
+    static bool valid_utf8(std::string_view text) {
+        for (size_t i = 0; i < text.size();) {
+            const auto lead = static_cast<unsigned char>(text[i]);
+            size_t length = 0;
+            uint32_t code_point = 0;
+            if (lead < 0x80) {
+                ++i;
+                continue;
+            } else if (lead >= 0xC2 && lead <= 0xDF) {
+                length = 2;
+                code_point = lead & 0x1F;
+            } else if (lead >= 0xE0 && lead <= 0xEF) {
+                length = 3;
+                code_point = lead & 0x0F;
+            } else if (lead >= 0xF0 && lead <= 0xF4) {
+                length = 4;
+                code_point = lead & 0x07;
+            } else {
+                return false;
+            }
+            if (text.size() - i < length) {
+                return false;
+            }
+            for (size_t k = 1; k < length; ++k) {
+                const auto continuation = static_cast<unsigned char>(text[i + k]);
+                if ((continuation & 0xC0) != 0x80) {
+                    return false;
+                }
+                code_point = (code_point << 6) | (continuation & 0x3F);
+            }
+            // Overlong forms, surrogates and anything past U+10FFFF
+            if ((length == 3 && code_point < 0x800) || (length == 4 && (code_point < 0x10000 || code_point > 0x10FFFF)) ||
+                (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+                return false;
+            }
+            i += length;
+        }
+        return true;
+    }
+};
+
+// A byte with bit 6 set, e.g. a letter, is a limit of 1 to 64; anything else, e.g. a digit, is no limit
+size_t limit_from(uint8_t byte) {
+    return (byte & 0x40) != 0 ? (byte & 0x3F) + 1 : SIZE_MAX;
+}
+
+// Byte 0 picks the oversize policy, bytes 1 to 3 max_line_bytes, max_event_bytes and chunk_bytes
+SseLimits limits_from(const uint8_t* header) {
+    SseLimits limits;
+    limits.oversize = static_cast<SseLimits::Oversize>(header[0] % 3);
+    limits.max_line_bytes = limit_from(header[1]);
+    limits.max_event_bytes = limit_from(header[2]);
+    limits.chunk_bytes = limit_from(header[3]);
+    return limits;
+}
+
+std::vector<std::string> parse(std::string_view body, SseLimits limits, size_t seed) {
+    Recording recording;
+    SseParser<RecordingSink> parser{RecordingSink{&recording}, limits};
+    if (seed == 0) {
+        parser.feed(body);
+        return recording.log;
+    }
+    // Pieces of 1 to 16 bytes from a linear congruential generator
+    size_t state = seed;
+    for (size_t offset = 0; offset < body.size();) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const size_t length = seed == 1 ? 1 : (state >> 33) % 16 + 1;
+        parser.feed(body.substr(offset, length));
+        offset += length;
+    }
+    return recording.log;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    constexpr size_t HEADER_BYTES = 4;
+    if (size < HEADER_BYTES) {
+        return 0;
+    }
+    const SseLimits limits = limits_from(data);
+    const std::string_view body(reinterpret_cast<const char*>(data) + HEADER_BYTES, size - HEADER_BYTES);
+
+    const std::vector<std::string> whole = parse(body, limits, 0);
+    RecordingSink::require(parse(body, limits, 1) == whole, "byte-at-a-time reads changed what the sink saw");
+    // Seeded by the body, so a crash file replays the same split
+    size_t seed = 2;
+    for (const char c : body) {
+        seed = seed * 31 + static_cast<unsigned char>(c);
+    }
+    RecordingSink::require(parse(body, limits, seed | 2) == whole, "split reads changed what the sink saw");
+
+    // reset() starts a new body: the same bytes again give the same result
+    Recording recording;
+    SseParser<RecordingSink> parser{RecordingSink{&recording}, limits};
+    parser.feed(body.substr(0, body.size() / 2));
+    parser.reset();
+    recording = {};
+    parser.feed(body);
+    RecordingSink::require(recording.log == whole, "reset() kept state of the old body");
+    return 0;
+}
@@ -28,6 +28,7 @@ target_sources(
   ../nitrogen/generated/android/NitroEventSourceOnLoad.cpp
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridNitroEventSourceSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridNitroEventSourceFactorySpec.cpp
   # Android-specific Nitrogen C++ sources
   
 )
@@ -16,6 +16,7 @@
 #include <NitroModules/HybridObjectRegistry.hpp>
 
 #include "HybridNitroEventSource.hpp"
+#include "HybridNitroEventSourceFactory.hpp"
 
 namespace margelo::nitro::nitroeventsource {
 
@@ -38,6 +39,15 @@ int initialize(JavaVM* vm) {
         return std::make_shared<HybridNitroEventSource>();
       }
     );
+    HybridObjectRegistry::registerHybridObjectConstructor(
+      "NitroEventSourceFactory",
+      []() -> std::shared_ptr<HybridObject> {
+        static_assert(std::is_default_constructible_v<HybridNitroEventSourceFactory>,
+                      "The HybridObject \"HybridNitroEventSourceFactory\" is not default-constructible! "
+                      "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+        return std::make_shared<HybridNitroEventSourceFactory>();
+      }
+    );
   });
 }
 
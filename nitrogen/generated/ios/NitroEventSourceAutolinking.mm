@@ -11,6 +11,7 @@
 #import <type_traits>
 
 #include "HybridNitroEventSource.hpp"
+#include "HybridNitroEventSourceFactory.hpp"
 
 @interface NitroEventSourceAutolinking : NSObject
 @end
@@ -30,6 +31,15 @@
       return std::make_shared<HybridNitroEventSource>();
     }
   );
+  HybridObjectRegistry::registerHybridObjectConstructor(
+    "NitroEventSourceFactory",
+    []() -> std::shared_ptr<HybridObject> {
+      static_assert(std::is_default_constructible_v<HybridNitroEventSourceFactory>,
+                    "The HybridObject \"HybridNitroEventSourceFactory\" is not default-constructible! "
+                    "Create a public constructor that takes zero arguments to be able to autolink this HybridObject.");
+      return std::make_shared<HybridNitroEventSourceFactory>();
+    }
+  );
 }
 
 @end
@@ -0,0 +1,83 @@
+///
+/// AggregationOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <vector>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (AggregationOptions).
+   */
+  struct AggregationOptions {
+  public:
+    std::vector<std::string> types     SWIFT_PRIVATE;
+    std::optional<std::string> field     SWIFT_PRIVATE;
+    std::optional<double> windowMs     SWIFT_PRIVATE;
+    std::optional<std::string> eventType     SWIFT_PRIVATE;
+
+  public:
+    AggregationOptions() = default;
+    explicit AggregationOptions(std::vector<std::string> types, std::optional<std::string> field, std::optional<double> windowMs, std::optional<std::string> eventType): types(types), field(field), windowMs(windowMs), eventType(eventType) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ AggregationOptions <> JS AggregationOptions (object)
+  template <>
+  struct JSIConverter<AggregationOptions> final {
+    static inline AggregationOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return AggregationOptions(
+        JSIConverter<std::vector<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "types")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "field")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "windowMs")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "eventType"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const AggregationOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "types", JSIConverter<std::vector<std::string>>::toJSI(runtime, arg.types));
+      obj.setProperty(runtime, "field", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.field));
+      obj.setProperty(runtime, "windowMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.windowMs));
+      obj.setProperty(runtime, "eventType", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.eventType));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::vector<std::string>>::canConvert(runtime, obj.getProperty(runtime, "types"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "field"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "windowMs"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "eventType"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
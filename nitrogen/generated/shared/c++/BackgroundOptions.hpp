@@ -0,0 +1,79 @@
+///
+/// BackgroundOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `BackgroundPolicy` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class BackgroundPolicy; }
+
+#include "BackgroundPolicy.hpp"
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (BackgroundOptions).
+   */
+  struct BackgroundOptions {
+  public:
+    std::optional<BackgroundPolicy> policy     SWIFT_PRIVATE;
+    std::optional<double> graceMs     SWIFT_PRIVATE;
+    std::optional<double> reconnectAlignMs     SWIFT_PRIVATE;
+
+  public:
+    BackgroundOptions() = default;
+    explicit BackgroundOptions(std::optional<BackgroundPolicy> policy, std::optional<double> graceMs, std::optional<double> reconnectAlignMs): policy(policy), graceMs(graceMs), reconnectAlignMs(reconnectAlignMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ BackgroundOptions <> JS BackgroundOptions (object)
+  template <>
+  struct JSIConverter<BackgroundOptions> final {
+    static inline BackgroundOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return BackgroundOptions(
+        JSIConverter<std::optional<BackgroundPolicy>>::fromJSI(runtime, obj.getProperty(runtime, "policy")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "graceMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "reconnectAlignMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const BackgroundOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "policy", JSIConverter<std::optional<BackgroundPolicy>>::toJSI(runtime, arg.policy));
+      obj.setProperty(runtime, "graceMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.graceMs));
+      obj.setProperty(runtime, "reconnectAlignMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.reconnectAlignMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<BackgroundPolicy>>::canConvert(runtime, obj.getProperty(runtime, "policy"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "graceMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "reconnectAlignMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,82 @@
+///
+/// BackgroundPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (BackgroundPolicy).
+   */
+  enum class BackgroundPolicy {
+    KEEP      SWIFT_NAME(keep) = 0,
+    PAUSE      SWIFT_NAME(pause) = 1,
+    CLOSE      SWIFT_NAME(close) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ BackgroundPolicy <> JS BackgroundPolicy (union)
+  template <>
+  struct JSIConverter<BackgroundPolicy> final {
+    static inline BackgroundPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("keep"): return BackgroundPolicy::KEEP;
+        case hashString("pause"): return BackgroundPolicy::PAUSE;
+        case hashString("close"): return BackgroundPolicy::CLOSE;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum BackgroundPolicy - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, BackgroundPolicy arg) {
+      switch (arg) {
+        case BackgroundPolicy::KEEP: return JSIConverter<std::string>::toJSI(runtime, "keep");
+        case BackgroundPolicy::PAUSE: return JSIConverter<std::string>::toJSI(runtime, "pause");
+        case BackgroundPolicy::CLOSE: return JSIConverter<std::string>::toJSI(runtime, "close");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert BackgroundPolicy to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("keep"):
+        case hashString("pause"):
+        case hashString("close"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,79 @@
+///
+/// BackpressureOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `OverflowPolicy` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class OverflowPolicy; }
+
+#include <optional>
+#include "OverflowPolicy.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (BackpressureOptions).
+   */
+  struct BackpressureOptions {
+  public:
+    std::optional<double> maxQueuedEvents     SWIFT_PRIVATE;
+    std::optional<OverflowPolicy> overflow     SWIFT_PRIVATE;
+    std::optional<double> maxQueuedBytes     SWIFT_PRIVATE;
+
+  public:
+    BackpressureOptions() = default;
+    explicit BackpressureOptions(std::optional<double> maxQueuedEvents, std::optional<OverflowPolicy> overflow, std::optional<double> maxQueuedBytes): maxQueuedEvents(maxQueuedEvents), overflow(overflow), maxQueuedBytes(maxQueuedBytes) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ BackpressureOptions <> JS BackpressureOptions (object)
+  template <>
+  struct JSIConverter<BackpressureOptions> final {
+    static inline BackpressureOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return BackpressureOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxQueuedEvents")),
+        JSIConverter<std::optional<OverflowPolicy>>::fromJSI(runtime, obj.getProperty(runtime, "overflow")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxQueuedBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const BackpressureOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "maxQueuedEvents", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxQueuedEvents));
+      obj.setProperty(runtime, "overflow", JSIConverter<std::optional<OverflowPolicy>>::toJSI(runtime, arg.overflow));
+      obj.setProperty(runtime, "maxQueuedBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxQueuedBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxQueuedEvents"))) return false;
+      if (!JSIConverter<std::optional<OverflowPolicy>>::canConvert(runtime, obj.getProperty(runtime, "overflow"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxQueuedBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
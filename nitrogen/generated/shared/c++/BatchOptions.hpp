@@ -0,0 +1,73 @@
+///
+/// BatchOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (BatchOptions).
+   */
+  struct BatchOptions {
+  public:
+    std::optional<double> maxSize     SWIFT_PRIVATE;
+    std::optional<double> maxLatencyMs     SWIFT_PRIVATE;
+
+  public:
+    BatchOptions() = default;
+    explicit BatchOptions(std::optional<double> maxSize, std::optional<double> maxLatencyMs): maxSize(maxSize), maxLatencyMs(maxLatencyMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ BatchOptions <> JS BatchOptions (object)
+  template <>
+  struct JSIConverter<BatchOptions> final {
+    static inline BatchOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return BatchOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxSize")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxLatencyMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const BatchOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "maxSize", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxSize));
+      obj.setProperty(runtime, "maxLatencyMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxLatencyMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxSize"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxLatencyMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,88 @@
+///
+/// BufferingDetectionOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `StreamTransport` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class StreamTransport; }
+
+#include <optional>
+#include "StreamTransport.hpp"
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (BufferingDetectionOptions).
+   */
+  struct BufferingDetectionOptions {
+  public:
+    std::optional<double> gapMs     SWIFT_PRIVATE;
+    std::optional<double> burstEvents     SWIFT_PRIVATE;
+    std::optional<double> lagMs     SWIFT_PRIVATE;
+    std::optional<StreamTransport> fallback     SWIFT_PRIVATE;
+    std::optional<std::string> fallbackUrl     SWIFT_PRIVATE;
+
+  public:
+    BufferingDetectionOptions() = default;
+    explicit BufferingDetectionOptions(std::optional<double> gapMs, std::optional<double> burstEvents, std::optional<double> lagMs, std::optional<StreamTransport> fallback, std::optional<std::string> fallbackUrl): gapMs(gapMs), burstEvents(burstEvents), lagMs(lagMs), fallback(fallback), fallbackUrl(fallbackUrl) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ BufferingDetectionOptions <> JS BufferingDetectionOptions (object)
+  template <>
+  struct JSIConverter<BufferingDetectionOptions> final {
+    static inline BufferingDetectionOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return BufferingDetectionOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "gapMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "burstEvents")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "lagMs")),
+        JSIConverter<std::optional<StreamTransport>>::fromJSI(runtime, obj.getProperty(runtime, "fallback")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "fallbackUrl"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const BufferingDetectionOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "gapMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.gapMs));
+      obj.setProperty(runtime, "burstEvents", JSIConverter<std::optional<double>>::toJSI(runtime, arg.burstEvents));
+      obj.setProperty(runtime, "lagMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.lagMs));
+      obj.setProperty(runtime, "fallback", JSIConverter<std::optional<StreamTransport>>::toJSI(runtime, arg.fallback));
+      obj.setProperty(runtime, "fallbackUrl", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.fallbackUrl));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "gapMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "burstEvents"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "lagMs"))) return false;
+      if (!JSIConverter<std::optional<StreamTransport>>::canConvert(runtime, obj.getProperty(runtime, "fallback"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "fallbackUrl"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,74 @@
+///
+/// CaptureOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CaptureOptions).
+   */
+  struct CaptureOptions {
+  public:
+    std::string file     SWIFT_PRIVATE;
+    std::optional<double> maxBytes     SWIFT_PRIVATE;
+
+  public:
+    CaptureOptions() = default;
+    explicit CaptureOptions(std::string file, std::optional<double> maxBytes): file(file), maxBytes(maxBytes) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ CaptureOptions <> JS CaptureOptions (object)
+  template <>
+  struct JSIConverter<CaptureOptions> final {
+    static inline CaptureOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return CaptureOptions(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "file")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const CaptureOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "file", JSIConverter<std::string>::toJSI(runtime, arg.file));
+      obj.setProperty(runtime, "maxBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "file"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
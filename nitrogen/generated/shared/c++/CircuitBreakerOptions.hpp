@@ -0,0 +1,77 @@
+///
+/// CircuitBreakerOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CircuitBreakerOptions).
+   */
+  struct CircuitBreakerOptions {
+  public:
+    std::optional<double> failureThreshold     SWIFT_PRIVATE;
+    std::optional<double> openMs     SWIFT_PRIVATE;
+    std::optional<double> maxOpenMs     SWIFT_PRIVATE;
+
+  public:
+    CircuitBreakerOptions() = default;
+    explicit CircuitBreakerOptions(std::optional<double> failureThreshold, std::optional<double> openMs, std::optional<double> maxOpenMs): failureThreshold(failureThreshold), openMs(openMs), maxOpenMs(maxOpenMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ CircuitBreakerOptions <> JS CircuitBreakerOptions (object)
+  template <>
+  struct JSIConverter<CircuitBreakerOptions> final {
+    static inline CircuitBreakerOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return CircuitBreakerOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "failureThreshold")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "openMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxOpenMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const CircuitBreakerOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "failureThreshold", JSIConverter<std::optional<double>>::toJSI(runtime, arg.failureThreshold));
+      obj.setProperty(runtime, "openMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.openMs));
+      obj.setProperty(runtime, "maxOpenMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxOpenMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "failureThreshold"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "openMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxOpenMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
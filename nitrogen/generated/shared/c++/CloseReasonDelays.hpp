@@ -0,0 +1,81 @@
+///
+/// CloseReasonDelays.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CloseReasonDelays).
+   */
+  struct CloseReasonDelays {
+  public:
+    std::optional<double> cleanCloseMs     SWIFT_PRIVATE;
+    std::optional<double> resetMs     SWIFT_PRIVATE;
+    std::optional<double> timeoutMs     SWIFT_PRIVATE;
+    std::optional<double> httpErrorMs     SWIFT_PRIVATE;
+
+  public:
+    CloseReasonDelays() = default;
+    explicit CloseReasonDelays(std::optional<double> cleanCloseMs, std::optional<double> resetMs, std::optional<double> timeoutMs, std::optional<double> httpErrorMs): cleanCloseMs(cleanCloseMs), resetMs(resetMs), timeoutMs(timeoutMs), httpErrorMs(httpErrorMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ CloseReasonDelays <> JS CloseReasonDelays (object)
+  template <>
+  struct JSIConverter<CloseReasonDelays> final {
+    static inline CloseReasonDelays fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return CloseReasonDelays(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "cleanCloseMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "resetMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "timeoutMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "httpErrorMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const CloseReasonDelays& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "cleanCloseMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.cleanCloseMs));
+      obj.setProperty(runtime, "resetMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.resetMs));
+      obj.setProperty(runtime, "timeoutMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.timeoutMs));
+      obj.setProperty(runtime, "httpErrorMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.httpErrorMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "cleanCloseMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "resetMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "timeoutMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "httpErrorMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
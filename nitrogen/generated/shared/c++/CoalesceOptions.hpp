@@ -0,0 +1,79 @@
+///
+/// CoalesceOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <vector>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CoalesceOptions).
+   */
+  struct CoalesceOptions {
+  public:
+    std::optional<std::vector<std::string>> types     SWIFT_PRIVATE;
+    std::optional<bool> byId     SWIFT_PRIVATE;
+    std::optional<std::string> keyField     SWIFT_PRIVATE;
+
+  public:
+    CoalesceOptions() = default;
+    explicit CoalesceOptions(std::optional<std::vector<std::string>> types, std::optional<bool> byId, std::optional<std::string> keyField): types(types), byId(byId), keyField(keyField) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ CoalesceOptions <> JS CoalesceOptions (object)
+  template <>
+  struct JSIConverter<CoalesceOptions> final {
+    static inline CoalesceOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return CoalesceOptions(
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "types")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "byId")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "keyField"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const CoalesceOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "types", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.types));
+      obj.setProperty(runtime, "byId", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.byId));
+      obj.setProperty(runtime, "keyField", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.keyField));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "types"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "byId"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "keyField"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,100 @@
+///
+/// ConnectionTiming.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `IpFamily` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class IpFamily; }
+
+#include "IpFamily.hpp"
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ConnectionTiming).
+   */
+  struct ConnectionTiming {
+  public:
+    double dnsMs     SWIFT_PRIVATE;
+    double connectMs     SWIFT_PRIVATE;
+    double tlsMs     SWIFT_PRIVATE;
+    double firstByteMs     SWIFT_PRIVATE;
+    double totalMs     SWIFT_PRIVATE;
+    bool reused     SWIFT_PRIVATE;
+    std::optional<IpFamily> ipFamily     SWIFT_PRIVATE;
+    std::optional<std::string> url     SWIFT_PRIVATE;
+
+  public:
+    ConnectionTiming() = default;
+    explicit ConnectionTiming(double dnsMs, double connectMs, double tlsMs, double firstByteMs, double totalMs, bool reused, std::optional<IpFamily> ipFamily, std::optional<std::string> url): dnsMs(dnsMs), connectMs(connectMs), tlsMs(tlsMs), firstByteMs(firstByteMs), totalMs(totalMs), reused(reused), ipFamily(ipFamily), url(url) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ConnectionTiming <> JS ConnectionTiming (object)
+  template <>
+  struct JSIConverter<ConnectionTiming> final {
+    static inline ConnectionTiming fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ConnectionTiming(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "dnsMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "connectMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "tlsMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "firstByteMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "totalMs")),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "reused")),
+        JSIConverter<std::optional<IpFamily>>::fromJSI(runtime, obj.getProperty(runtime, "ipFamily")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "url"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ConnectionTiming& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "dnsMs", JSIConverter<double>::toJSI(runtime, arg.dnsMs));
+      obj.setProperty(runtime, "connectMs", JSIConverter<double>::toJSI(runtime, arg.connectMs));
+      obj.setProperty(runtime, "tlsMs", JSIConverter<double>::toJSI(runtime, arg.tlsMs));
+      obj.setProperty(runtime, "firstByteMs", JSIConverter<double>::toJSI(runtime, arg.firstByteMs));
+      obj.setProperty(runtime, "totalMs", JSIConverter<double>::toJSI(runtime, arg.totalMs));
+      obj.setProperty(runtime, "reused", JSIConverter<bool>::toJSI(runtime, arg.reused));
+      obj.setProperty(runtime, "ipFamily", JSIConverter<std::optional<IpFamily>>::toJSI(runtime, arg.ipFamily));
+      obj.setProperty(runtime, "url", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.url));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "dnsMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "connectMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "tlsMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "firstByteMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "totalMs"))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "reused"))) return false;
+      if (!JSIConverter<std::optional<IpFamily>>::canConvert(runtime, obj.getProperty(runtime, "ipFamily"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "url"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
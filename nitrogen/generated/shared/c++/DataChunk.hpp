@@ -0,0 +1,82 @@
+///
+/// DataChunk.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (DataChunk).
+   */
+  enum class DataChunk {
+    BEGIN      SWIFT_NAME(begin) = 0,
+    CONTINUE      SWIFT_NAME(continue) = 1,
+    END      SWIFT_NAME(end) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ DataChunk <> JS DataChunk (union)
+  template <>
+  struct JSIConverter<DataChunk> final {
+    static inline DataChunk fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("begin"): return DataChunk::BEGIN;
+        case hashString("continue"): return DataChunk::CONTINUE;
+        case hashString("end"): return DataChunk::END;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum DataChunk - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, DataChunk arg) {
+      switch (arg) {
+        case DataChunk::BEGIN: return JSIConverter<std::string>::toJSI(runtime, "begin");
+        case DataChunk::CONTINUE: return JSIConverter<std::string>::toJSI(runtime, "continue");
+        case DataChunk::END: return JSIConverter<std::string>::toJSI(runtime, "end");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert DataChunk to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("begin"):
+        case hashString("continue"):
+        case hashString("end"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
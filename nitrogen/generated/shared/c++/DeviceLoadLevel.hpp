@@ -0,0 +1,78 @@
+///
+/// DeviceLoadLevel.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (DeviceLoadLevel).
+   */
+  enum class DeviceLoadLevel {
+    ELEVATED      SWIFT_NAME(elevated) = 0,
+    CRITICAL      SWIFT_NAME(critical) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ DeviceLoadLevel <> JS DeviceLoadLevel (union)
+  template <>
+  struct JSIConverter<DeviceLoadLevel> final {
+    static inline DeviceLoadLevel fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("elevated"): return DeviceLoadLevel::ELEVATED;
+        case hashString("critical"): return DeviceLoadLevel::CRITICAL;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum DeviceLoadLevel - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, DeviceLoadLevel arg) {
+      switch (arg) {
+        case DeviceLoadLevel::ELEVATED: return JSIConverter<std::string>::toJSI(runtime, "elevated");
+        case DeviceLoadLevel::CRITICAL: return JSIConverter<std::string>::toJSI(runtime, "critical");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert DeviceLoadLevel to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("elevated"):
+        case hashString("critical"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
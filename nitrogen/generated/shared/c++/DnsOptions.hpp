@@ -0,0 +1,79 @@
+///
+/// DnsOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (DnsOptions).
+   */
+  struct DnsOptions {
+  public:
+    std::optional<double> cacheTtlMs     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> resolve     SWIFT_PRIVATE;
+    std::optional<std::string> dohUrl     SWIFT_PRIVATE;
+
+  public:
+    DnsOptions() = default;
+    explicit DnsOptions(std::optional<double> cacheTtlMs, std::optional<std::vector<std::string>> resolve, std::optional<std::string> dohUrl): cacheTtlMs(cacheTtlMs), resolve(resolve), dohUrl(dohUrl) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ DnsOptions <> JS DnsOptions (object)
+  template <>
+  struct JSIConverter<DnsOptions> final {
+    static inline DnsOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return DnsOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "cacheTtlMs")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "resolve")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "dohUrl"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const DnsOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "cacheTtlMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.cacheTtlMs));
+      obj.setProperty(runtime, "resolve", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.resolve));
+      obj.setProperty(runtime, "dohUrl", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.dohUrl));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "cacheTtlMs"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "resolve"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "dohUrl"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
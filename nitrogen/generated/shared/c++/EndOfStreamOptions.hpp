@@ -0,0 +1,79 @@
+///
+/// EndOfStreamOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (EndOfStreamOptions).
+   */
+  struct EndOfStreamOptions {
+  public:
+    std::optional<std::string> data     SWIFT_PRIVATE;
+    std::optional<std::string> eventType     SWIFT_PRIVATE;
+    std::optional<std::vector<double>> statusCodes     SWIFT_PRIVATE;
+
+  public:
+    EndOfStreamOptions() = default;
+    explicit EndOfStreamOptions(std::optional<std::string> data, std::optional<std::string> eventType, std::optional<std::vector<double>> statusCodes): data(data), eventType(eventType), statusCodes(statusCodes) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ EndOfStreamOptions <> JS EndOfStreamOptions (object)
+  template <>
+  struct JSIConverter<EndOfStreamOptions> final {
+    static inline EndOfStreamOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return EndOfStreamOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "data")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "eventType")),
+        JSIConverter<std::optional<std::vector<double>>>::fromJSI(runtime, obj.getProperty(runtime, "statusCodes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const EndOfStreamOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "data", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.data));
+      obj.setProperty(runtime, "eventType", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.eventType));
+      obj.setProperty(runtime, "statusCodes", JSIConverter<std::optional<std::vector<double>>>::toJSI(runtime, arg.statusCodes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "data"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "eventType"))) return false;
+      if (!JSIConverter<std::optional<std::vector<double>>>::canConvert(runtime, obj.getProperty(runtime, "statusCodes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
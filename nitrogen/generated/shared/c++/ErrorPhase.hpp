@@ -0,0 +1,82 @@
+///
+/// ErrorPhase.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (ErrorPhase).
+   */
+  enum class ErrorPhase {
+    CONNECT      SWIFT_NAME(connect) = 0,
+    RESPONSE      SWIFT_NAME(response) = 1,
+    STREAM      SWIFT_NAME(stream) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ErrorPhase <> JS ErrorPhase (union)
+  template <>
+  struct JSIConverter<ErrorPhase> final {
+    static inline ErrorPhase fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("connect"): return ErrorPhase::CONNECT;
+        case hashString("response"): return ErrorPhase::RESPONSE;
+        case hashString("stream"): return ErrorPhase::STREAM;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum ErrorPhase - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, ErrorPhase arg) {
+      switch (arg) {
+        case ErrorPhase::CONNECT: return JSIConverter<std::string>::toJSI(runtime, "connect");
+        case ErrorPhase::RESPONSE: return JSIConverter<std::string>::toJSI(runtime, "response");
+        case ErrorPhase::STREAM: return JSIConverter<std::string>::toJSI(runtime, "stream");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert ErrorPhase to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("connect"):
+        case hashString("response"):
+        case hashString("stream"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
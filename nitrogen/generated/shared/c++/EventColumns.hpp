@@ -0,0 +1,87 @@
+///
+/// EventColumns.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (EventColumns).
+   */
+  struct EventColumns {
+  public:
+    std::string type     SWIFT_PRIVATE;
+    double count     SWIFT_PRIVATE;
+    std::string lastEventId     SWIFT_PRIVATE;
+    std::vector<std::shared_ptr<ArrayBuffer>> columns     SWIFT_PRIVATE;
+    std::vector<std::string> strings     SWIFT_PRIVATE;
+
+  public:
+    EventColumns() = default;
+    explicit EventColumns(std::string type, double count, std::string lastEventId, std::vector<std::shared_ptr<ArrayBuffer>> columns, std::vector<std::string> strings): type(type), count(count), lastEventId(lastEventId), columns(columns), strings(strings) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ EventColumns <> JS EventColumns (object)
+  template <>
+  struct JSIConverter<EventColumns> final {
+    static inline EventColumns fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return EventColumns(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "type")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "count")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "lastEventId")),
+        JSIConverter<std::vector<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "columns")),
+        JSIConverter<std::vector<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "strings"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const EventColumns& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "type", JSIConverter<std::string>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, "count", JSIConverter<double>::toJSI(runtime, arg.count));
+      obj.setProperty(runtime, "lastEventId", JSIConverter<std::string>::toJSI(runtime, arg.lastEventId));
+      obj.setProperty(runtime, "columns", JSIConverter<std::vector<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.columns));
+      obj.setProperty(runtime, "strings", JSIConverter<std::vector<std::string>>::toJSI(runtime, arg.strings));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "count"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "lastEventId"))) return false;
+      if (!JSIConverter<std::vector<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "columns"))) return false;
+      if (!JSIConverter<std::vector<std::string>>::canConvert(runtime, obj.getProperty(runtime, "strings"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
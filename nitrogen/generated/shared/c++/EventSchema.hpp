@@ -0,0 +1,76 @@
+///
+/// EventSchema.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `SchemaField` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct SchemaField; }
+
+#include <string>
+#include "SchemaField.hpp"
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (EventSchema).
+   */
+  struct EventSchema {
+  public:
+    std::string type     SWIFT_PRIVATE;
+    std::vector<SchemaField> fields     SWIFT_PRIVATE;
+
+  public:
+    EventSchema() = default;
+    explicit EventSchema(std::string type, std::vector<SchemaField> fields): type(type), fields(fields) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ EventSchema <> JS EventSchema (object)
+  template <>
+  struct JSIConverter<EventSchema> final {
+    static inline EventSchema fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return EventSchema(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "type")),
+        JSIConverter<std::vector<SchemaField>>::fromJSI(runtime, obj.getProperty(runtime, "fields"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const EventSchema& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "type", JSIConverter<std::string>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, "fields", JSIConverter<std::vector<SchemaField>>::toJSI(runtime, arg.fields));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
+      if (!JSIConverter<std::vector<SchemaField>>::canConvert(runtime, obj.getProperty(runtime, "fields"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
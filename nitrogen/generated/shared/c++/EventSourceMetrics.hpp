@@ -0,0 +1,207 @@
+///
+/// EventSourceMetrics.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `LatencyHistogram` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct LatencyHistogram; }
+// Forward declaration of `ConnectionTiming` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ConnectionTiming; }
+
+#include "LatencyHistogram.hpp"
+#include "ConnectionTiming.hpp"
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (EventSourceMetrics).
+   */
+  struct EventSourceMetrics {
+  public:
+    double pooledEvents     SWIFT_PRIVATE;
+    double poolHits     SWIFT_PRIVATE;
+    double poolMisses     SWIFT_PRIVATE;
+    double bytesReceived     SWIFT_PRIVATE;
+    double eventsParsed     SWIFT_PRIVATE;
+    double eventsDispatched     SWIFT_PRIVATE;
+    double eventsDropped     SWIFT_PRIVATE;
+    double reconnects     SWIFT_PRIVATE;
+    double connectedMs     SWIFT_PRIVATE;
+    LatencyHistogram parseTime     SWIFT_PRIVATE;
+    LatencyHistogram dispatchLatency     SWIFT_PRIVATE;
+    LatencyHistogram serverLatency     SWIFT_PRIVATE;
+    LatencyHistogram nativeLatency     SWIFT_PRIVATE;
+    std::optional<ConnectionTiming> lastConnection     SWIFT_PRIVATE;
+    LatencyHistogram timeToFirstByte     SWIFT_PRIVATE;
+    double commentsReceived     SWIFT_PRIVATE;
+    std::optional<double> lastCommentAt     SWIFT_PRIVATE;
+    bool proxyBuffering     SWIFT_PRIVATE;
+    double bufferedBursts     SWIFT_PRIVATE;
+    double eventsSampledOut     SWIFT_PRIVATE;
+    double eventsAggregated     SWIFT_PRIVATE;
+    double bufferedBytes     SWIFT_PRIVATE;
+    double idsIgnored     SWIFT_PRIVATE;
+    double cpuParseMs     SWIFT_PRIVATE;
+    double cpuDecodeMs     SWIFT_PRIVATE;
+    double cpuDispatchMs     SWIFT_PRIVATE;
+    double heartbeatsMissed     SWIFT_PRIVATE;
+    std::optional<double> heartbeatDelayMs     SWIFT_PRIVATE;
+    std::optional<double> heartbeatDelayTrendMs     SWIFT_PRIVATE;
+    std::optional<double> heartbeatJitterMs     SWIFT_PRIVATE;
+    std::optional<double> connectionQuality     SWIFT_PRIVATE;
+    double slowListenerCalls     SWIFT_PRIVATE;
+    std::optional<std::string> slowestListener     SWIFT_PRIVATE;
+    std::optional<double> slowestListenerMs     SWIFT_PRIVATE;
+
+  public:
+    EventSourceMetrics() = default;
+    explicit EventSourceMetrics(double pooledEvents, double poolHits, double poolMisses, double bytesReceived, double eventsParsed, double eventsDispatched, double eventsDropped, double reconnects, double connectedMs, LatencyHistogram parseTime, LatencyHistogram dispatchLatency, LatencyHistogram serverLatency, LatencyHistogram nativeLatency, std::optional<ConnectionTiming> lastConnection, LatencyHistogram timeToFirstByte, double commentsReceived, std::optional<double> lastCommentAt, bool proxyBuffering, double bufferedBursts, double eventsSampledOut, double eventsAggregated, double bufferedBytes, double idsIgnored, double cpuParseMs, double cpuDecodeMs, double cpuDispatchMs, double heartbeatsMissed, std::optional<double> heartbeatDelayMs, std::optional<double> heartbeatDelayTrendMs, std::optional<double> heartbeatJitterMs, std::optional<double> connectionQuality, double slowListenerCalls, std::optional<std::string> slowestListener, std::optional<double> slowestListenerMs): pooledEvents(pooledEvents), poolHits(poolHits), poolMisses(poolMisses), bytesReceived(bytesReceived), eventsParsed(eventsParsed), eventsDispatched(eventsDispatched), eventsDropped(eventsDropped), reconnects(reconnects), connectedMs(connectedMs), parseTime(parseTime), dispatchLatency(dispatchLatency), serverLatency(serverLatency), nativeLatency(nativeLatency), lastConnection(lastConnection), timeToFirstByte(timeToFirstByte), commentsReceived(commentsReceived), lastCommentAt(lastCommentAt), proxyBuffering(proxyBuffering), bufferedBursts(bufferedBursts), eventsSampledOut(eventsSampledOut), eventsAggregated(eventsAggregated), bufferedBytes(bufferedBytes), idsIgnored(idsIgnored), cpuParseMs(cpuParseMs), cpuDecodeMs(cpuDecodeMs), cpuDispatchMs(cpuDispatchMs), heartbeatsMissed(heartbeatsMissed), heartbeatDelayMs(heartbeatDelayMs), heartbeatDelayTrendMs(heartbeatDelayTrendMs), heartbeatJitterMs(heartbeatJitterMs), connectionQuality(connectionQuality), slowListenerCalls(slowListenerCalls), slowestListener(slowestListener), slowestListenerMs(slowestListenerMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ EventSourceMetrics <> JS EventSourceMetrics (object)
+  template <>
+  struct JSIConverter<EventSourceMetrics> final {
+    static inline EventSourceMetrics fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return EventSourceMetrics(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "pooledEvents")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "poolHits")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "poolMisses")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesReceived")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsParsed")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsDispatched")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsDropped")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "reconnects")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "connectedMs")),
+        JSIConverter<LatencyHistogram>::fromJSI(runtime, obj.getProperty(runtime, "parseTime")),
+        JSIConverter<LatencyHistogram>::fromJSI(runtime, obj.getProperty(runtime, "dispatchLatency")),
+        JSIConverter<LatencyHistogram>::fromJSI(runtime, obj.getProperty(runtime, "serverLatency")),
+        JSIConverter<LatencyHistogram>::fromJSI(runtime, obj.getProperty(runtime, "nativeLatency")),
+        JSIConverter<std::optional<ConnectionTiming>>::fromJSI(runtime, obj.getProperty(runtime, "lastConnection")),
+        JSIConverter<LatencyHistogram>::fromJSI(runtime, obj.getProperty(runtime, "timeToFirstByte")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "commentsReceived")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "lastCommentAt")),
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, "proxyBuffering")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bufferedBursts")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsSampledOut")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsAggregated")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bufferedBytes")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "idsIgnored")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuParseMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuDecodeMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "cpuDispatchMs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "heartbeatsMissed")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "heartbeatDelayMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "heartbeatDelayTrendMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "heartbeatJitterMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "connectionQuality")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "slowListenerCalls")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "slowestListener")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "slowestListenerMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const EventSourceMetrics& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "pooledEvents", JSIConverter<double>::toJSI(runtime, arg.pooledEvents));
+      obj.setProperty(runtime, "poolHits", JSIConverter<double>::toJSI(runtime, arg.poolHits));
+      obj.setProperty(runtime, "poolMisses", JSIConverter<double>::toJSI(runtime, arg.poolMisses));
+      obj.setProperty(runtime, "bytesReceived", JSIConverter<double>::toJSI(runtime, arg.bytesReceived));
+      obj.setProperty(runtime, "eventsParsed", JSIConverter<double>::toJSI(runtime, arg.eventsParsed));
+      obj.setProperty(runtime, "eventsDispatched", JSIConverter<double>::toJSI(runtime, arg.eventsDispatched));
+      obj.setProperty(runtime, "eventsDropped", JSIConverter<double>::toJSI(runtime, arg.eventsDropped));
+      obj.setProperty(runtime, "reconnects", JSIConverter<double>::toJSI(runtime, arg.reconnects));
+      obj.setProperty(runtime, "connectedMs", JSIConverter<double>::toJSI(runtime, arg.connectedMs));
+      obj.setProperty(runtime, "parseTime", JSIConverter<LatencyHistogram>::toJSI(runtime, arg.parseTime));
+      obj.setProperty(runtime, "dispatchLatency", JSIConverter<LatencyHistogram>::toJSI(runtime, arg.dispatchLatency));
+      obj.setProperty(runtime, "serverLatency", JSIConverter<LatencyHistogram>::toJSI(runtime, arg.serverLatency));
+      obj.setProperty(runtime, "nativeLatency", JSIConverter<LatencyHistogram>::toJSI(runtime, arg.nativeLatency));
+      obj.setProperty(runtime, "lastConnection", JSIConverter<std::optional<ConnectionTiming>>::toJSI(runtime, arg.lastConnection));
+      obj.setProperty(runtime, "timeToFirstByte", JSIConverter<LatencyHistogram>::toJSI(runtime, arg.timeToFirstByte));
+      obj.setProperty(runtime, "commentsReceived", JSIConverter<double>::toJSI(runtime, arg.commentsReceived));
+      obj.setProperty(runtime, "lastCommentAt", JSIConverter<std::optional<double>>::toJSI(runtime, arg.lastCommentAt));
+      obj.setProperty(runtime, "proxyBuffering", JSIConverter<bool>::toJSI(runtime, arg.proxyBuffering));
+      obj.setProperty(runtime, "bufferedBursts", JSIConverter<double>::toJSI(runtime, arg.bufferedBursts));
+      obj.setProperty(runtime, "eventsSampledOut", JSIConverter<double>::toJSI(runtime, arg.eventsSampledOut));
+      obj.setProperty(runtime, "eventsAggregated", JSIConverter<double>::toJSI(runtime, arg.eventsAggregated));
+      obj.setProperty(runtime, "bufferedBytes", JSIConverter<double>::toJSI(runtime, arg.bufferedBytes));
+      obj.setProperty(runtime, "idsIgnored", JSIConverter<double>::toJSI(runtime, arg.idsIgnored));
+      obj.setProperty(runtime, "cpuParseMs", JSIConverter<double>::toJSI(runtime, arg.cpuParseMs));
+      obj.setProperty(runtime, "cpuDecodeMs", JSIConverter<double>::toJSI(runtime, arg.cpuDecodeMs));
+      obj.setProperty(runtime, "cpuDispatchMs", JSIConverter<double>::toJSI(runtime, arg.cpuDispatchMs));
+      obj.setProperty(runtime, "heartbeatsMissed", JSIConverter<double>::toJSI(runtime, arg.heartbeatsMissed));
+      obj.setProperty(runtime, "heartbeatDelayMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.heartbeatDelayMs));
+      obj.setProperty(runtime, "heartbeatDelayTrendMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.heartbeatDelayTrendMs));
+      obj.setProperty(runtime, "heartbeatJitterMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.heartbeatJitterMs));
+      obj.setProperty(runtime, "connectionQuality", JSIConverter<std::optional<double>>::toJSI(runtime, arg.connectionQuality));
+      obj.setProperty(runtime, "slowListenerCalls", JSIConverter<double>::toJSI(runtime, arg.slowListenerCalls));
+      obj.setProperty(runtime, "slowestListener", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.slowestListener));
+      obj.setProperty(runtime, "slowestListenerMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.slowestListenerMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "pooledEvents"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "poolHits"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "poolMisses"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesReceived"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsParsed"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsDispatched"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsDropped"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "reconnects"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "connectedMs"))) return false;
+      if (!JSIConverter<LatencyHistogram>::canConvert(runtime, obj.getProperty(runtime, "parseTime"))) return false;
+      if (!JSIConverter<LatencyHistogram>::canConvert(runtime, obj.getProperty(runtime, "dispatchLatency"))) return false;
+      if (!JSIConverter<LatencyHistogram>::canConvert(runtime, obj.getProperty(runtime, "serverLatency"))) return false;
+      if (!JSIConverter<LatencyHistogram>::canConvert(runtime, obj.getProperty(runtime, "nativeLatency"))) return false;
+      if (!JSIConverter<std::optional<ConnectionTiming>>::canConvert(runtime, obj.getProperty(runtime, "lastConnection"))) return false;
+      if (!JSIConverter<LatencyHistogram>::canConvert(runtime, obj.getProperty(runtime, "timeToFirstByte"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "commentsReceived"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "lastCommentAt"))) return false;
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, "proxyBuffering"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bufferedBursts"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsSampledOut"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsAggregated"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bufferedBytes"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "idsIgnored"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuParseMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuDecodeMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "cpuDispatchMs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "heartbeatsMissed"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "heartbeatDelayMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "heartbeatDelayTrendMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "heartbeatJitterMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "connectionQuality"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "slowListenerCalls"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "slowestListener"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "slowestListenerMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
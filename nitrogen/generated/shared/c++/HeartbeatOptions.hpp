@@ -0,0 +1,92 @@
+///
+/// HeartbeatOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `TimestampUnit` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class TimestampUnit; }
+
+#include <string>
+#include <optional>
+#include "TimestampUnit.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (HeartbeatOptions).
+   */
+  struct HeartbeatOptions {
+  public:
+    std::optional<std::string> event     SWIFT_PRIVATE;
+    std::optional<std::string> field     SWIFT_PRIVATE;
+    std::optional<TimestampUnit> unit     SWIFT_PRIVATE;
+    std::optional<double> intervalMs     SWIFT_PRIVATE;
+    std::optional<double> goodDelayMs     SWIFT_PRIVATE;
+    std::optional<std::string> qualityEvent     SWIFT_PRIVATE;
+
+  public:
+    HeartbeatOptions() = default;
+    explicit HeartbeatOptions(std::optional<std::string> event, std::optional<std::string> field, std::optional<TimestampUnit> unit, std::optional<double> intervalMs, std::optional<double> goodDelayMs, std::optional<std::string> qualityEvent): event(event), field(field), unit(unit), intervalMs(intervalMs), goodDelayMs(goodDelayMs), qualityEvent(qualityEvent) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ HeartbeatOptions <> JS HeartbeatOptions (object)
+  template <>
+  struct JSIConverter<HeartbeatOptions> final {
+    static inline HeartbeatOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return HeartbeatOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "event")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "field")),
+        JSIConverter<std::optional<TimestampUnit>>::fromJSI(runtime, obj.getProperty(runtime, "unit")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "intervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "goodDelayMs")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "qualityEvent"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const HeartbeatOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "event", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.event));
+      obj.setProperty(runtime, "field", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.field));
+      obj.setProperty(runtime, "unit", JSIConverter<std::optional<TimestampUnit>>::toJSI(runtime, arg.unit));
+      obj.setProperty(runtime, "intervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.intervalMs));
+      obj.setProperty(runtime, "goodDelayMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.goodDelayMs));
+      obj.setProperty(runtime, "qualityEvent", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.qualityEvent));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "event"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "field"))) return false;
+      if (!JSIConverter<std::optional<TimestampUnit>>::canConvert(runtime, obj.getProperty(runtime, "unit"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "intervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "goodDelayMs"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "qualityEvent"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,34 @@
+///
+/// HybridNitroEventSourceFactorySpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#include "HybridNitroEventSourceFactorySpec.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  void HybridNitroEventSourceFactorySpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridMethod("create", &HybridNitroEventSourceFactorySpec::create);
+      prototype.registerHybridMethod("streamKey", &HybridNitroEventSourceFactorySpec::streamKey);
+      prototype.registerHybridMethod("preconnect", &HybridNitroEventSourceFactorySpec::preconnect);
+      prototype.registerHybridMethod("warmUp", &HybridNitroEventSourceFactorySpec::warmUp);
+      prototype.registerHybridMethod("setConnectionLimits", &HybridNitroEventSourceFactorySpec::setConnectionLimits);
+      prototype.registerHybridMethod("setMemoryBudget", &HybridNitroEventSourceFactorySpec::setMemoryBudget);
+      prototype.registerHybridMethod("setCookies", &HybridNitroEventSourceFactorySpec::setCookies);
+      prototype.registerHybridMethod("getCookies", &HybridNitroEventSourceFactorySpec::getCookies);
+      prototype.registerHybridMethod("clearCookies", &HybridNitroEventSourceFactorySpec::clearCookies);
+      prototype.registerHybridMethod("setForeground", &HybridNitroEventSourceFactorySpec::setForeground);
+      prototype.registerHybridMethod("closeAll", &HybridNitroEventSourceFactorySpec::closeAll);
+      prototype.registerHybridMethod("watchMetrics", &HybridNitroEventSourceFactorySpec::watchMetrics);
+      prototype.registerHybridMethod("unwatchMetrics", &HybridNitroEventSourceFactorySpec::unwatchMetrics);
+      prototype.registerHybridMethod("setMetricsReport", &HybridNitroEventSourceFactorySpec::setMetricsReport);
+    });
+  }
+
+} // namespace margelo::nitro::nitroeventsource
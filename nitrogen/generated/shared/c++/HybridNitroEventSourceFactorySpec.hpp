@@ -0,0 +1,91 @@
+///
+/// HybridNitroEventSourceFactorySpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `HybridNitroEventSourceSpec` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { class HybridNitroEventSourceSpec; }
+// Forward declaration of `NitroEventSourceOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct NitroEventSourceOptions; }
+// Forward declaration of `MetricsReportOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct MetricsReportOptions; }
+// Forward declaration of `StreamMetricsSample` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct StreamMetricsSample; }
+
+#include <memory>
+#include "HybridNitroEventSourceSpec.hpp"
+#include <string>
+#include "NitroEventSourceOptions.hpp"
+#include <optional>
+#include <NitroModules/Promise.hpp>
+#include "StreamMetricsSample.hpp"
+#include <functional>
+#include <vector>
+#include "MetricsReportOptions.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `NitroEventSourceFactory`
+   * Inherit this class to create instances of `HybridNitroEventSourceFactorySpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridNitroEventSourceFactory: public HybridNitroEventSourceFactorySpec {
+   * public:
+   *   HybridNitroEventSourceFactory(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridNitroEventSourceFactorySpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridNitroEventSourceFactorySpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridNitroEventSourceFactorySpec() override = default;
+
+    public:
+      // Properties
+      
+
+    public:
+      // Methods
+      virtual std::shared_ptr<margelo::nitro::nitroeventsource::HybridNitroEventSourceSpec> create(const std::string& url, const std::optional<NitroEventSourceOptions>& options) = 0;
+      virtual std::string streamKey(const std::string& url, const std::optional<NitroEventSourceOptions>& options) = 0;
+      virtual void preconnect(const std::string& url) = 0;
+      virtual void warmUp() = 0;
+      virtual void setConnectionLimits(double maxConnections, double maxConnectionsPerHost) = 0;
+      virtual void setMemoryBudget(double maxBufferedBytes) = 0;
+      virtual void setCookies(const std::string& url, const std::vector<std::string>& cookies) = 0;
+      virtual std::vector<std::string> getCookies() = 0;
+      virtual void clearCookies() = 0;
+      virtual void setForeground(bool foreground) = 0;
+      virtual std::shared_ptr<Promise<void>> closeAll() = 0;
+      virtual void watchMetrics(double intervalMs, const std::function<void(const std::vector<StreamMetricsSample>& /* samples */)>& callback) = 0;
+      virtual void unwatchMetrics() = 0;
+      virtual void setMetricsReport(const std::optional<MetricsReportOptions>& options) = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "NitroEventSourceFactory";
+  };
+
+} // namespace margelo::nitro::nitroeventsource
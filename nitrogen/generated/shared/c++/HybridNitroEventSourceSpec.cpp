@@ -14,11 +14,44 @@ namespace margelo::nitro::nitroeventsource {
     HybridObject::loadHybridMethods();
     // load custom methods/properties
     registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("readyState", &HybridNitroEventSourceSpec::getReadyState);
       prototype.registerHybridMethod("create", &HybridNitroEventSourceSpec::create);
+      prototype.registerHybridMethod("start", &HybridNitroEventSourceSpec::start);
       prototype.registerHybridMethod("close", &HybridNitroEventSourceSpec::close);
+      prototype.registerHybridMethod("closeAsync", &HybridNitroEventSourceSpec::closeAsync);
       prototype.registerHybridMethod("setEventCallback", &HybridNitroEventSourceSpec::setEventCallback);
+      prototype.registerHybridMethod("setBatchCallback", &HybridNitroEventSourceSpec::setBatchCallback);
+      prototype.registerHybridMethod("setDrainCallback", &HybridNitroEventSourceSpec::setDrainCallback);
+      prototype.registerHybridMethod("drainEvents", &HybridNitroEventSourceSpec::drainEvents);
+      prototype.registerHybridMethod("subscribe", &HybridNitroEventSourceSpec::subscribe);
+      prototype.registerHybridMethod("setSubscriptionTypes", &HybridNitroEventSourceSpec::setSubscriptionTypes);
+      prototype.registerHybridMethod("setSubscriptionActive", &HybridNitroEventSourceSpec::setSubscriptionActive);
+      prototype.registerHybridMethod("drainSubscription", &HybridNitroEventSourceSpec::drainSubscription);
+      prototype.registerHybridMethod("drainPacked", &HybridNitroEventSourceSpec::drainPacked);
+      prototype.registerHybridMethod("unsubscribe", &HybridNitroEventSourceSpec::unsubscribe);
       prototype.registerHybridMethod("addEventListener", &HybridNitroEventSourceSpec::addEventListener);
       prototype.registerHybridMethod("removeEventListener", &HybridNitroEventSourceSpec::removeEventListener);
+      prototype.registerHybridMethod("setDataCallback", &HybridNitroEventSourceSpec::setDataCallback);
+      prototype.registerHybridMethod("setMessagesCallback", &HybridNitroEventSourceSpec::setMessagesCallback);
+      prototype.registerHybridMethod("drainData", &HybridNitroEventSourceSpec::drainData);
+      prototype.registerHybridMethod("getResponseHead", &HybridNitroEventSourceSpec::getResponseHead);
+      prototype.registerHybridMethod("drainColumns", &HybridNitroEventSourceSpec::drainColumns);
+      prototype.registerHybridMethod("decodeMessage", &HybridNitroEventSourceSpec::decodeMessage);
+      prototype.registerHybridMethod("setTypeFilter", &HybridNitroEventSourceSpec::setTypeFilter);
+      prototype.registerHybridMethod("setPayloadFilters", &HybridNitroEventSourceSpec::setPayloadFilters);
+      prototype.registerHybridMethod("getMetrics", &HybridNitroEventSourceSpec::getMetrics);
+      prototype.registerHybridMethod("getState", &HybridNitroEventSourceSpec::getState);
+      prototype.registerHybridMethod("replay", &HybridNitroEventSourceSpec::replay);
+      prototype.registerHybridMethod("getWarmEvent", &HybridNitroEventSourceSpec::getWarmEvent);
+      prototype.registerHybridMethod("getRecentEvents", &HybridNitroEventSourceSpec::getRecentEvents);
+      prototype.registerHybridMethod("reportSlowListener", &HybridNitroEventSourceSpec::reportSlowListener);
+      prototype.registerHybridMethod("preconnect", &HybridNitroEventSourceSpec::preconnect);
+      prototype.registerHybridMethod("warmUp", &HybridNitroEventSourceSpec::warmUp);
+      prototype.registerHybridMethod("setConnectionLimits", &HybridNitroEventSourceSpec::setConnectionLimits);
+      prototype.registerHybridMethod("setMemoryBudget", &HybridNitroEventSourceSpec::setMemoryBudget);
+      prototype.registerHybridMethod("setForeground", &HybridNitroEventSourceSpec::setForeground);
+      prototype.registerHybridMethod("updateHeaders", &HybridNitroEventSourceSpec::updateHeaders);
+      prototype.registerHybridMethod("setUnauthorizedCallback", &HybridNitroEventSourceSpec::setUnauthorizedCallback);
     });
   }
 
@@ -19,14 +19,34 @@ namespace margelo::nitro::nitroeventsource { class HybridNitroEventSourceSpec; }
 namespace margelo::nitro::nitroeventsource { struct NitroEventSourceOptions; }
 // Forward declaration of `NitroEventSourceEvent` to properly resolve imports.
 namespace margelo::nitro::nitroeventsource { struct NitroEventSourceEvent; }
+// Forward declaration of `PayloadFilter` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct PayloadFilter; }
+// Forward declaration of `EventSourceMetrics` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct EventSourceMetrics; }
+// Forward declaration of `ResponseHead` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ResponseHead; }
+// Forward declaration of `EventColumns` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct EventColumns; }
+// Forward declaration of `PackedEvents` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct PackedEvents; }
 
 #include <memory>
 #include "HybridNitroEventSourceSpec.hpp"
 #include <string>
 #include "NitroEventSourceOptions.hpp"
 #include <optional>
+#include <NitroModules/Promise.hpp>
 #include "NitroEventSourceEvent.hpp"
 #include <functional>
+#include <vector>
+#include <NitroModules/ArrayBuffer.hpp>
+#include "PayloadFilter.hpp"
+#include "EventSourceMetrics.hpp"
+#include <NitroModules/AnyMap.hpp>
+#include <unordered_map>
+#include "ResponseHead.hpp"
+#include "EventColumns.hpp"
+#include "PackedEvents.hpp"
 
 namespace margelo::nitro::nitroeventsource {
 
@@ -55,15 +75,47 @@ namespace margelo::nitro::nitroeventsource {
 
     public:
       // Properties
-      
+      virtual double getReadyState() = 0;
 
     public:
       // Methods
       virtual std::shared_ptr<margelo::nitro::nitroeventsource::HybridNitroEventSourceSpec> create(const std::string& url, const std::optional<NitroEventSourceOptions>& options) = 0;
+      virtual void start() = 0;
       virtual void close() = 0;
+      virtual std::shared_ptr<Promise<void>> closeAsync() = 0;
       virtual void setEventCallback(const std::function<void(const NitroEventSourceEvent& /* event */)>& callback) = 0;
-      virtual void addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) = 0;
-      virtual void removeEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) = 0;
+      virtual void setBatchCallback(const std::function<void(const std::vector<NitroEventSourceEvent>& /* events */)>& callback) = 0;
+      virtual void setDrainCallback(const std::function<void()>& callback) = 0;
+      virtual std::vector<NitroEventSourceEvent> drainEvents(std::optional<double> maxEvents) = 0;
+      virtual double subscribe(const std::function<void()>& callback) = 0;
+      virtual void setSubscriptionTypes(double subscriptionId, const std::optional<std::vector<std::string>>& types) = 0;
+      virtual void setSubscriptionActive(double subscriptionId, bool active) = 0;
+      virtual std::vector<NitroEventSourceEvent> drainSubscription(double subscriptionId, std::optional<double> maxEvents) = 0;
+      virtual PackedEvents drainPacked(std::optional<double> maxEvents) = 0;
+      virtual void unsubscribe(double subscriptionId) = 0;
+      virtual double addEventListener(const std::string& type, const std::function<void(const NitroEventSourceEvent& /* event */)>& listener) = 0;
+      virtual void removeEventListener(double subscriptionId) = 0;
+      virtual void setDataCallback(const std::function<void(const std::shared_ptr<ArrayBuffer>& /* chunk */)>& callback) = 0;
+      virtual void setMessagesCallback(const std::function<void(const std::vector<std::shared_ptr<ArrayBuffer>>& /* messages */)>& callback) = 0;
+      virtual std::optional<std::shared_ptr<ArrayBuffer>> drainData() = 0;
+      virtual std::optional<ResponseHead> getResponseHead() = 0;
+      virtual std::vector<EventColumns> drainColumns() = 0;
+      virtual std::shared_ptr<AnyMap> decodeMessage(const std::shared_ptr<ArrayBuffer>& message) = 0;
+      virtual void setTypeFilter(const std::optional<std::vector<std::string>>& types) = 0;
+      virtual void setPayloadFilters(const std::vector<PayloadFilter>& filters) = 0;
+      virtual EventSourceMetrics getMetrics() = 0;
+      virtual std::optional<std::string> getState(const std::string& pointer) = 0;
+      virtual std::vector<NitroEventSourceEvent> replay(const std::string& fromId) = 0;
+      virtual std::optional<NitroEventSourceEvent> getWarmEvent(const std::string& type) = 0;
+      virtual std::vector<NitroEventSourceEvent> getRecentEvents(const std::string& type) = 0;
+      virtual void reportSlowListener(const std::string& type, const std::string& listener, double durationMs) = 0;
+      virtual void preconnect(const std::string& url) = 0;
+      virtual void warmUp() = 0;
+      virtual void setConnectionLimits(double maxConnections, double maxConnectionsPerHost) = 0;
+      virtual void setMemoryBudget(double maxBufferedBytes) = 0;
+      virtual void setForeground(bool foreground) = 0;
+      virtual void updateHeaders(const std::unordered_map<std::string, std::string>& headers) = 0;
+      virtual void setUnauthorizedCallback(const std::function<void()>& callback) = 0;
 
     protected:
       // Hybrid Setup
@@ -0,0 +1,78 @@
+///
+/// IpFamily.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (IpFamily).
+   */
+  enum class IpFamily {
+    V4      SWIFT_NAME(v4) = 0,
+    V6      SWIFT_NAME(v6) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ IpFamily <> JS IpFamily (union)
+  template <>
+  struct JSIConverter<IpFamily> final {
+    static inline IpFamily fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("v4"): return IpFamily::V4;
+        case hashString("v6"): return IpFamily::V6;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum IpFamily - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, IpFamily arg) {
+      switch (arg) {
+        case IpFamily::V4: return JSIConverter<std::string>::toJSI(runtime, "v4");
+        case IpFamily::V6: return JSIConverter<std::string>::toJSI(runtime, "v6");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert IpFamily to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("v4"):
+        case hashString("v6"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
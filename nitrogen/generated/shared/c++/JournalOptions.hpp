@@ -0,0 +1,82 @@
+///
+/// JournalOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (JournalOptions).
+   */
+  struct JournalOptions {
+  public:
+    std::optional<std::string> key     SWIFT_PRIVATE;
+    std::optional<double> segmentBytes     SWIFT_PRIVATE;
+    std::optional<double> maxSegments     SWIFT_PRIVATE;
+    std::optional<bool> compress     SWIFT_PRIVATE;
+
+  public:
+    JournalOptions() = default;
+    explicit JournalOptions(std::optional<std::string> key, std::optional<double> segmentBytes, std::optional<double> maxSegments, std::optional<bool> compress): key(key), segmentBytes(segmentBytes), maxSegments(maxSegments), compress(compress) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ JournalOptions <> JS JournalOptions (object)
+  template <>
+  struct JSIConverter<JournalOptions> final {
+    static inline JournalOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return JournalOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "key")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "segmentBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxSegments")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "compress"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const JournalOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "key", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.key));
+      obj.setProperty(runtime, "segmentBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.segmentBytes));
+      obj.setProperty(runtime, "maxSegments", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxSegments));
+      obj.setProperty(runtime, "compress", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.compress));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "key"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "segmentBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxSegments"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "compress"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,93 @@
+///
+/// LatencyHistogram.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (LatencyHistogram).
+   */
+  struct LatencyHistogram {
+  public:
+    double count     SWIFT_PRIVATE;
+    double sumUs     SWIFT_PRIVATE;
+    double maxUs     SWIFT_PRIVATE;
+    double p50Us     SWIFT_PRIVATE;
+    double p90Us     SWIFT_PRIVATE;
+    double p99Us     SWIFT_PRIVATE;
+    std::vector<double> buckets     SWIFT_PRIVATE;
+
+  public:
+    LatencyHistogram() = default;
+    explicit LatencyHistogram(double count, double sumUs, double maxUs, double p50Us, double p90Us, double p99Us, std::vector<double> buckets): count(count), sumUs(sumUs), maxUs(maxUs), p50Us(p50Us), p90Us(p90Us), p99Us(p99Us), buckets(buckets) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ LatencyHistogram <> JS LatencyHistogram (object)
+  template <>
+  struct JSIConverter<LatencyHistogram> final {
+    static inline LatencyHistogram fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return LatencyHistogram(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "count")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "sumUs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "maxUs")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p50Us")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p90Us")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "p99Us")),
+        JSIConverter<std::vector<double>>::fromJSI(runtime, obj.getProperty(runtime, "buckets"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const LatencyHistogram& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "count", JSIConverter<double>::toJSI(runtime, arg.count));
+      obj.setProperty(runtime, "sumUs", JSIConverter<double>::toJSI(runtime, arg.sumUs));
+      obj.setProperty(runtime, "maxUs", JSIConverter<double>::toJSI(runtime, arg.maxUs));
+      obj.setProperty(runtime, "p50Us", JSIConverter<double>::toJSI(runtime, arg.p50Us));
+      obj.setProperty(runtime, "p90Us", JSIConverter<double>::toJSI(runtime, arg.p90Us));
+      obj.setProperty(runtime, "p99Us", JSIConverter<double>::toJSI(runtime, arg.p99Us));
+      obj.setProperty(runtime, "buckets", JSIConverter<std::vector<double>>::toJSI(runtime, arg.buckets));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "count"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "sumUs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "maxUs"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p50Us"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p90Us"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "p99Us"))) return false;
+      if (!JSIConverter<std::vector<double>>::canConvert(runtime, obj.getProperty(runtime, "buckets"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,80 @@
+///
+/// LatencyTracingOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `TimestampUnit` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class TimestampUnit; }
+
+#include <string>
+#include <optional>
+#include "TimestampUnit.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (LatencyTracingOptions).
+   */
+  struct LatencyTracingOptions {
+  public:
+    std::optional<std::string> field     SWIFT_PRIVATE;
+    std::optional<std::string> pointer     SWIFT_PRIVATE;
+    std::optional<TimestampUnit> unit     SWIFT_PRIVATE;
+
+  public:
+    LatencyTracingOptions() = default;
+    explicit LatencyTracingOptions(std::optional<std::string> field, std::optional<std::string> pointer, std::optional<TimestampUnit> unit): field(field), pointer(pointer), unit(unit) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ LatencyTracingOptions <> JS LatencyTracingOptions (object)
+  template <>
+  struct JSIConverter<LatencyTracingOptions> final {
+    static inline LatencyTracingOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return LatencyTracingOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "field")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "pointer")),
+        JSIConverter<std::optional<TimestampUnit>>::fromJSI(runtime, obj.getProperty(runtime, "unit"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const LatencyTracingOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "field", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.field));
+      obj.setProperty(runtime, "pointer", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.pointer));
+      obj.setProperty(runtime, "unit", JSIConverter<std::optional<TimestampUnit>>::toJSI(runtime, arg.unit));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "field"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "pointer"))) return false;
+      if (!JSIConverter<std::optional<TimestampUnit>>::canConvert(runtime, obj.getProperty(runtime, "unit"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
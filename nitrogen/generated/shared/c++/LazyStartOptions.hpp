@@ -0,0 +1,69 @@
+///
+/// LazyStartOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (LazyStartOptions).
+   */
+  struct LazyStartOptions {
+  public:
+    std::optional<bool> prefetch     SWIFT_PRIVATE;
+
+  public:
+    LazyStartOptions() = default;
+    explicit LazyStartOptions(std::optional<bool> prefetch): prefetch(prefetch) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ LazyStartOptions <> JS LazyStartOptions (object)
+  template <>
+  struct JSIConverter<LazyStartOptions> final {
+    static inline LazyStartOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return LazyStartOptions(
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "prefetch"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const LazyStartOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "prefetch", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.prefetch));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "prefetch"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
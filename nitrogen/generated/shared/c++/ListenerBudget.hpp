@@ -0,0 +1,77 @@
+///
+/// ListenerBudget.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ListenerBudget).
+   */
+  struct ListenerBudget {
+  public:
+    std::optional<double> budgetMs     SWIFT_PRIVATE;
+    std::optional<bool> coalesceSlow     SWIFT_PRIVATE;
+    std::optional<double> coalesceMs     SWIFT_PRIVATE;
+
+  public:
+    ListenerBudget() = default;
+    explicit ListenerBudget(std::optional<double> budgetMs, std::optional<bool> coalesceSlow, std::optional<double> coalesceMs): budgetMs(budgetMs), coalesceSlow(coalesceSlow), coalesceMs(coalesceMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ListenerBudget <> JS ListenerBudget (object)
+  template <>
+  struct JSIConverter<ListenerBudget> final {
+    static inline ListenerBudget fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ListenerBudget(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "budgetMs")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "coalesceSlow")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "coalesceMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ListenerBudget& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "budgetMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.budgetMs));
+      obj.setProperty(runtime, "coalesceSlow", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.coalesceSlow));
+      obj.setProperty(runtime, "coalesceMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.coalesceMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "budgetMs"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "coalesceSlow"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "coalesceMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,87 @@
+///
+/// LoadPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `DeviceLoadLevel` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class DeviceLoadLevel; }
+
+#include "DeviceLoadLevel.hpp"
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (LoadPolicy).
+   */
+  struct LoadPolicy {
+  public:
+    std::optional<DeviceLoadLevel> from     SWIFT_PRIVATE;
+    std::optional<double> batchLatencyMs     SWIFT_PRIVATE;
+    std::optional<bool> coalesce     SWIFT_PRIVATE;
+    std::optional<double> maxEventsPerSecond     SWIFT_PRIVATE;
+    std::optional<double> maxQueuedEvents     SWIFT_PRIVATE;
+
+  public:
+    LoadPolicy() = default;
+    explicit LoadPolicy(std::optional<DeviceLoadLevel> from, std::optional<double> batchLatencyMs, std::optional<bool> coalesce, std::optional<double> maxEventsPerSecond, std::optional<double> maxQueuedEvents): from(from), batchLatencyMs(batchLatencyMs), coalesce(coalesce), maxEventsPerSecond(maxEventsPerSecond), maxQueuedEvents(maxQueuedEvents) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ LoadPolicy <> JS LoadPolicy (object)
+  template <>
+  struct JSIConverter<LoadPolicy> final {
+    static inline LoadPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return LoadPolicy(
+        JSIConverter<std::optional<DeviceLoadLevel>>::fromJSI(runtime, obj.getProperty(runtime, "from")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "batchLatencyMs")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "coalesce")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxEventsPerSecond")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxQueuedEvents"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const LoadPolicy& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "from", JSIConverter<std::optional<DeviceLoadLevel>>::toJSI(runtime, arg.from));
+      obj.setProperty(runtime, "batchLatencyMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.batchLatencyMs));
+      obj.setProperty(runtime, "coalesce", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.coalesce));
+      obj.setProperty(runtime, "maxEventsPerSecond", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEventsPerSecond));
+      obj.setProperty(runtime, "maxQueuedEvents", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxQueuedEvents));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<DeviceLoadLevel>>::canConvert(runtime, obj.getProperty(runtime, "from"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "batchLatencyMs"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "coalesce"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxEventsPerSecond"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxQueuedEvents"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,71 @@
+///
+/// MessageSchema.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ProtoField` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ProtoField; }
+
+#include "ProtoField.hpp"
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (MessageSchema).
+   */
+  struct MessageSchema {
+  public:
+    std::vector<ProtoField> fields     SWIFT_PRIVATE;
+
+  public:
+    MessageSchema() = default;
+    explicit MessageSchema(std::vector<ProtoField> fields): fields(fields) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ MessageSchema <> JS MessageSchema (object)
+  template <>
+  struct JSIConverter<MessageSchema> final {
+    static inline MessageSchema fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return MessageSchema(
+        JSIConverter<std::vector<ProtoField>>::fromJSI(runtime, obj.getProperty(runtime, "fields"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const MessageSchema& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "fields", JSIConverter<std::vector<ProtoField>>::toJSI(runtime, arg.fields));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::vector<ProtoField>>::canConvert(runtime, obj.getProperty(runtime, "fields"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,78 @@
+///
+/// MetricsReportOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (MetricsReportOptions).
+   */
+  struct MetricsReportOptions {
+  public:
+    std::string file     SWIFT_PRIVATE;
+    std::optional<double> intervalMs     SWIFT_PRIVATE;
+    std::optional<double> maxFileBytes     SWIFT_PRIVATE;
+
+  public:
+    MetricsReportOptions() = default;
+    explicit MetricsReportOptions(std::string file, std::optional<double> intervalMs, std::optional<double> maxFileBytes): file(file), intervalMs(intervalMs), maxFileBytes(maxFileBytes) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ MetricsReportOptions <> JS MetricsReportOptions (object)
+  template <>
+  struct JSIConverter<MetricsReportOptions> final {
+    static inline MetricsReportOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return MetricsReportOptions(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "file")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "intervalMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxFileBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const MetricsReportOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "file", JSIConverter<std::string>::toJSI(runtime, arg.file));
+      obj.setProperty(runtime, "intervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.intervalMs));
+      obj.setProperty(runtime, "maxFileBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxFileBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "file"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "intervalMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxFileBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
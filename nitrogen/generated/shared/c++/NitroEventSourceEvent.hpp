@@ -18,9 +18,19 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
-
+// Forward declaration of `DataChunk` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class DataChunk; }
+// Forward declaration of `StreamError` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct StreamError; }
+// Forward declaration of `ConnectionTiming` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ConnectionTiming; }
 
 #include <string>
+#include "DataChunk.hpp"
+#include <optional>
+#include <vector>
+#include "StreamError.hpp"
+#include "ConnectionTiming.hpp"
 
 namespace margelo::nitro::nitroeventsource {
 
@@ -32,10 +42,16 @@ namespace margelo::nitro::nitroeventsource {
     std::string id     SWIFT_PRIVATE;
     std::string type     SWIFT_PRIVATE;
     std::string data     SWIFT_PRIVATE;
+    std::optional<DataChunk> chunk     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> paths     SWIFT_PRIVATE;
+    std::optional<StreamError> error     SWIFT_PRIVATE;
+    std::optional<ConnectionTiming> timing     SWIFT_PRIVATE;
+    std::optional<double> receivedAt     SWIFT_PRIVATE;
+    std::optional<double> sequence     SWIFT_PRIVATE;
 
   public:
     NitroEventSourceEvent() = default;
-    explicit NitroEventSourceEvent(std::string id, std::string type, std::string data): id(id), type(type), data(data) {}
+    explicit NitroEventSourceEvent(std::string id, std::string type, std::string data, std::optional<DataChunk> chunk, std::optional<std::vector<std::string>> paths, std::optional<StreamError> error, std::optional<ConnectionTiming> timing, std::optional<double> receivedAt, std::optional<double> sequence): id(id), type(type), data(data), chunk(chunk), paths(paths), error(error), timing(timing), receivedAt(receivedAt), sequence(sequence) {}
   };
 
 } // namespace margelo::nitro::nitroeventsource
@@ -52,7 +68,13 @@ namespace margelo::nitro {
       return NitroEventSourceEvent(
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "id")),
         JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "type")),
-        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "data"))
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "data")),
+        JSIConverter<std::optional<DataChunk>>::fromJSI(runtime, obj.getProperty(runtime, "chunk")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "paths")),
+        JSIConverter<std::optional<StreamError>>::fromJSI(runtime, obj.getProperty(runtime, "error")),
+        JSIConverter<std::optional<ConnectionTiming>>::fromJSI(runtime, obj.getProperty(runtime, "timing")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "receivedAt")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "sequence"))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const NitroEventSourceEvent& arg) {
@@ -60,6 +82,12 @@ namespace margelo::nitro {
       obj.setProperty(runtime, "id", JSIConverter<std::string>::toJSI(runtime, arg.id));
       obj.setProperty(runtime, "type", JSIConverter<std::string>::toJSI(runtime, arg.type));
       obj.setProperty(runtime, "data", JSIConverter<std::string>::toJSI(runtime, arg.data));
+      obj.setProperty(runtime, "chunk", JSIConverter<std::optional<DataChunk>>::toJSI(runtime, arg.chunk));
+      obj.setProperty(runtime, "paths", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.paths));
+      obj.setProperty(runtime, "error", JSIConverter<std::optional<StreamError>>::toJSI(runtime, arg.error));
+      obj.setProperty(runtime, "timing", JSIConverter<std::optional<ConnectionTiming>>::toJSI(runtime, arg.timing));
+      obj.setProperty(runtime, "receivedAt", JSIConverter<std::optional<double>>::toJSI(runtime, arg.receivedAt));
+      obj.setProperty(runtime, "sequence", JSIConverter<std::optional<double>>::toJSI(runtime, arg.sequence));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -70,6 +98,12 @@ namespace margelo::nitro {
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "id"))) return false;
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
       if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "data"))) return false;
+      if (!JSIConverter<std::optional<DataChunk>>::canConvert(runtime, obj.getProperty(runtime, "chunk"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "paths"))) return false;
+      if (!JSIConverter<std::optional<StreamError>>::canConvert(runtime, obj.getProperty(runtime, "error"))) return false;
+      if (!JSIConverter<std::optional<ConnectionTiming>>::canConvert(runtime, obj.getProperty(runtime, "timing"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "receivedAt"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "sequence"))) return false;
       return true;
     }
   };
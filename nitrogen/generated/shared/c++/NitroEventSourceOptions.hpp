@@ -18,11 +18,121 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
-
+// Forward declaration of `ReconnectPolicy` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ReconnectPolicy; }
+// Forward declaration of `BatchOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct BatchOptions; }
+// Forward declaration of `BackpressureOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct BackpressureOptions; }
+// Forward declaration of `CoalesceOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct CoalesceOptions; }
+// Forward declaration of `OversizePolicy` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class OversizePolicy; }
+// Forward declaration of `StateSyncOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct StateSyncOptions; }
+// Forward declaration of `JournalOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct JournalOptions; }
+// Forward declaration of `WarmStartOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct WarmStartOptions; }
+// Forward declaration of `TimeoutOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct TimeoutOptions; }
+// Forward declaration of `SocketOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct SocketOptions; }
+// Forward declaration of `BackgroundOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct BackgroundOptions; }
+// Forward declaration of `StreamPriority` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class StreamPriority; }
+// Forward declaration of `TokenStreamOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct TokenStreamOptions; }
+// Forward declaration of `EndOfStreamOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct EndOfStreamOptions; }
+// Forward declaration of `LatencyTracingOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct LatencyTracingOptions; }
+// Forward declaration of `DnsOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct DnsOptions; }
+// Forward declaration of `StandbyOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct StandbyOptions; }
+// Forward declaration of `CircuitBreakerOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct CircuitBreakerOptions; }
+// Forward declaration of `StreamFormat` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class StreamFormat; }
+// Forward declaration of `RawFraming` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class RawFraming; }
+// Forward declaration of `MessageSchema` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct MessageSchema; }
+// Forward declaration of `StreamTransport` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class StreamTransport; }
+// Forward declaration of `BufferingDetectionOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct BufferingDetectionOptions; }
+// Forward declaration of `SamplingOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct SamplingOptions; }
+// Forward declaration of `AggregationOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct AggregationOptions; }
+// Forward declaration of `CaptureOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct CaptureOptions; }
+// Forward declaration of `ReplayOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ReplayOptions; }
+// Forward declaration of `EventSchema` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct EventSchema; }
+// Forward declaration of `ParallelDecodeOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ParallelDecodeOptions; }
+// Forward declaration of `RedirectCacheOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct RedirectCacheOptions; }
+// Forward declaration of `RateLimitOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct RateLimitOptions; }
+// Forward declaration of `LazyStartOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct LazyStartOptions; }
+// Forward declaration of `RecentEventsOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct RecentEventsOptions; }
+// Forward declaration of `HeartbeatOptions` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct HeartbeatOptions; }
+// Forward declaration of `LoadPolicy` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct LoadPolicy; }
+// Forward declaration of `ListenerBudget` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct ListenerBudget; }
 
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include "ReconnectPolicy.hpp"
+#include "BatchOptions.hpp"
+#include "BackpressureOptions.hpp"
+#include "CoalesceOptions.hpp"
+#include "OversizePolicy.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include "StateSyncOptions.hpp"
+#include "JournalOptions.hpp"
+#include "WarmStartOptions.hpp"
+#include "TimeoutOptions.hpp"
+#include "SocketOptions.hpp"
+#include "BackgroundOptions.hpp"
+#include "StreamPriority.hpp"
+#include <variant>
+#include "TokenStreamOptions.hpp"
+#include "EndOfStreamOptions.hpp"
+#include <vector>
+#include "LatencyTracingOptions.hpp"
+#include "DnsOptions.hpp"
+#include "StandbyOptions.hpp"
+#include "CircuitBreakerOptions.hpp"
+#include "StreamFormat.hpp"
+#include "RawFraming.hpp"
+#include "MessageSchema.hpp"
+#include "StreamTransport.hpp"
+#include "BufferingDetectionOptions.hpp"
+#include "SamplingOptions.hpp"
+#include "AggregationOptions.hpp"
+#include "CaptureOptions.hpp"
+#include "ReplayOptions.hpp"
+#include "EventSchema.hpp"
+#include "ParallelDecodeOptions.hpp"
+#include "RedirectCacheOptions.hpp"
+#include "RateLimitOptions.hpp"
+#include "LazyStartOptions.hpp"
+#include "RecentEventsOptions.hpp"
+#include "HeartbeatOptions.hpp"
+#include "LoadPolicy.hpp"
+#include "ListenerBudget.hpp"
 
 namespace margelo::nitro::nitroeventsource {
 
@@ -34,10 +144,74 @@ namespace margelo::nitro::nitroeventsource {
     std::optional<bool> withCredentials     SWIFT_PRIVATE;
     std::optional<std::unordered_map<std::string, std::string>> headers     SWIFT_PRIVATE;
     std::optional<bool> rawMode     SWIFT_PRIVATE;
+    std::optional<bool> http2     SWIFT_PRIVATE;
+    std::optional<ReconnectPolicy> reconnect     SWIFT_PRIVATE;
+    std::optional<BatchOptions> batch     SWIFT_PRIVATE;
+    std::optional<bool> parseJson     SWIFT_PRIVATE;
+    std::optional<bool> lazyPayloads     SWIFT_PRIVATE;
+    std::optional<BackpressureOptions> backpressure     SWIFT_PRIVATE;
+    std::optional<CoalesceOptions> coalesce     SWIFT_PRIVATE;
+    std::optional<bool> frameAligned     SWIFT_PRIVATE;
+    std::optional<double> dedupWindow     SWIFT_PRIVATE;
+    std::optional<double> maxLineBytes     SWIFT_PRIVATE;
+    std::optional<double> maxEventBytes     SWIFT_PRIVATE;
+    std::optional<OversizePolicy> oversize     SWIFT_PRIVATE;
+    std::optional<double> dataChunkBytes     SWIFT_PRIVATE;
+    std::optional<bool> compression     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> zstdDictionary     SWIFT_PRIVATE;
+    std::optional<StateSyncOptions> stateSync     SWIFT_PRIVATE;
+    std::optional<std::string> resumeKey     SWIFT_PRIVATE;
+    std::optional<std::string> storageDirectory     SWIFT_PRIVATE;
+    std::optional<JournalOptions> journal     SWIFT_PRIVATE;
+    std::optional<WarmStartOptions> warmStart     SWIFT_PRIVATE;
+    std::optional<bool> shareConnection     SWIFT_PRIVATE;
+    std::optional<TimeoutOptions> timeouts     SWIFT_PRIVATE;
+    std::optional<SocketOptions> socket     SWIFT_PRIVATE;
+    std::optional<bool> networkAware     SWIFT_PRIVATE;
+    std::optional<BackgroundOptions> background     SWIFT_PRIVATE;
+    std::optional<StreamPriority> priority     SWIFT_PRIVATE;
+    std::optional<std::string> method     SWIFT_PRIVATE;
+    std::optional<std::variant<std::string, std::shared_ptr<ArrayBuffer>>> body     SWIFT_PRIVATE;
+    std::optional<TokenStreamOptions> tokenStream     SWIFT_PRIVATE;
+    std::optional<EndOfStreamOptions> endOfStream     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> contentTypes     SWIFT_PRIVATE;
+    std::optional<LatencyTracingOptions> latencyTracing     SWIFT_PRIVATE;
+    std::optional<bool> http3     SWIFT_PRIVATE;
+    std::optional<DnsOptions> dns     SWIFT_PRIVATE;
+    std::optional<bool> pull     SWIFT_PRIVATE;
+    std::optional<std::string> userAgent     SWIFT_PRIVATE;
+    std::optional<StandbyOptions> standby     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> endpoints     SWIFT_PRIVATE;
+    std::optional<CircuitBreakerOptions> circuitBreaker     SWIFT_PRIVATE;
+    std::optional<StreamFormat> format     SWIFT_PRIVATE;
+    std::optional<RawFraming> rawFraming     SWIFT_PRIVATE;
+    std::optional<MessageSchema> messageSchema     SWIFT_PRIVATE;
+    std::optional<StreamTransport> transport     SWIFT_PRIVATE;
+    std::optional<BufferingDetectionOptions> bufferingDetection     SWIFT_PRIVATE;
+    std::optional<SamplingOptions> sampling     SWIFT_PRIVATE;
+    std::optional<AggregationOptions> aggregation     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> priorityTypes     SWIFT_PRIVATE;
+    std::optional<double> maxIdBytes     SWIFT_PRIVATE;
+    std::optional<bool> cpuAccounting     SWIFT_PRIVATE;
+    std::optional<CaptureOptions> capture     SWIFT_PRIVATE;
+    std::optional<ReplayOptions> replay     SWIFT_PRIVATE;
+    std::optional<bool> fetchMode     SWIFT_PRIVATE;
+    std::optional<std::vector<EventSchema>> schemas     SWIFT_PRIVATE;
+    std::optional<double> utf16MinBytes     SWIFT_PRIVATE;
+    std::optional<bool> efficiencyCores     SWIFT_PRIVATE;
+    std::optional<ParallelDecodeOptions> parallelDecode     SWIFT_PRIVATE;
+    std::optional<RedirectCacheOptions> redirectCache     SWIFT_PRIVATE;
+    std::optional<RateLimitOptions> rateLimit     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> transformers     SWIFT_PRIVATE;
+    std::optional<LazyStartOptions> lazyStart     SWIFT_PRIVATE;
+    std::optional<RecentEventsOptions> recentEvents     SWIFT_PRIVATE;
+    std::optional<HeartbeatOptions> heartbeat     SWIFT_PRIVATE;
+    std::optional<LoadPolicy> underLoad     SWIFT_PRIVATE;
+    std::optional<ListenerBudget> listenerBudget     SWIFT_PRIVATE;
 
   public:
     NitroEventSourceOptions() = default;
-    explicit NitroEventSourceOptions(std::optional<bool> withCredentials, std::optional<std::unordered_map<std::string, std::string>> headers, std::optional<bool> rawMode): withCredentials(withCredentials), headers(headers), rawMode(rawMode) {}
+    explicit NitroEventSourceOptions(std::optional<bool> withCredentials, std::optional<std::unordered_map<std::string, std::string>> headers, std::optional<bool> rawMode, std::optional<bool> http2, std::optional<ReconnectPolicy> reconnect, std::optional<BatchOptions> batch, std::optional<bool> parseJson, std::optional<bool> lazyPayloads, std::optional<BackpressureOptions> backpressure, std::optional<CoalesceOptions> coalesce, std::optional<bool> frameAligned, std::optional<double> dedupWindow, std::optional<double> maxLineBytes, std::optional<double> maxEventBytes, std::optional<OversizePolicy> oversize, std::optional<double> dataChunkBytes, std::optional<bool> compression, std::optional<std::shared_ptr<ArrayBuffer>> zstdDictionary, std::optional<StateSyncOptions> stateSync, std::optional<std::string> resumeKey, std::optional<std::string> storageDirectory, std::optional<JournalOptions> journal, std::optional<WarmStartOptions> warmStart, std::optional<bool> shareConnection, std::optional<TimeoutOptions> timeouts, std::optional<SocketOptions> socket, std::optional<bool> networkAware, std::optional<BackgroundOptions> background, std::optional<StreamPriority> priority, std::optional<std::string> method, std::optional<std::variant<std::string, std::shared_ptr<ArrayBuffer>>> body, std::optional<TokenStreamOptions> tokenStream, std::optional<EndOfStreamOptions> endOfStream, std::optional<std::vector<std::string>> contentTypes, std::optional<LatencyTracingOptions> latencyTracing, std::optional<bool> http3, std::optional<DnsOptions> dns, std::optional<bool> pull, std::optional<std::string> userAgent, std::optional<StandbyOptions> standby, std::optional<std::vector<std::string>> endpoints, std::optional<CircuitBreakerOptions> circuitBreaker, std::optional<StreamFormat> format, std::optional<RawFraming> rawFraming, std::optional<MessageSchema> messageSchema, std::optional<StreamTransport> transport, std::optional<BufferingDetectionOptions> bufferingDetection, std::optional<SamplingOptions> sampling, std::optional<AggregationOptions> aggregation, std::optional<std::vector<std::string>> priorityTypes, std::optional<double> maxIdBytes, std::optional<bool> cpuAccounting, std::optional<CaptureOptions> capture, std::optional<ReplayOptions> replay, std::optional<bool> fetchMode, std::optional<std::vector<EventSchema>> schemas, std::optional<double> utf16MinBytes, std::optional<bool> efficiencyCores, std::optional<ParallelDecodeOptions> parallelDecode, std::optional<RedirectCacheOptions> redirectCache, std::optional<RateLimitOptions> rateLimit, std::optional<std::vector<std::string>> transformers, std::optional<LazyStartOptions> lazyStart, std::optional<RecentEventsOptions> recentEvents, std::optional<HeartbeatOptions> heartbeat, std::optional<LoadPolicy> underLoad, std::optional<ListenerBudget> listenerBudget): withCredentials(withCredentials), headers(headers), rawMode(rawMode), http2(http2), reconnect(reconnect), batch(batch), parseJson(parseJson), lazyPayloads(lazyPayloads), backpressure(backpressure), coalesce(coalesce), frameAligned(frameAligned), dedupWindow(dedupWindow), maxLineBytes(maxLineBytes), maxEventBytes(maxEventBytes), oversize(oversize), dataChunkBytes(dataChunkBytes), compression(compression), zstdDictionary(zstdDictionary), stateSync(stateSync), resumeKey(resumeKey), storageDirectory(storageDirectory), journal(journal), warmStart(warmStart), shareConnection(shareConnection), timeouts(timeouts), socket(socket), networkAware(networkAware), background(background), priority(priority), method(method), body(body), tokenStream(tokenStream), endOfStream(endOfStream), contentTypes(contentTypes), latencyTracing(latencyTracing), http3(http3), dns(dns), pull(pull), userAgent(userAgent), standby(standby), endpoints(endpoints), circuitBreaker(circuitBreaker), format(format), rawFraming(rawFraming), messageSchema(messageSchema), transport(transport), bufferingDetection(bufferingDetection), sampling(sampling), aggregation(aggregation), priorityTypes(priorityTypes), maxIdBytes(maxIdBytes), cpuAccounting(cpuAccounting), capture(capture), replay(replay), fetchMode(fetchMode), schemas(schemas), utf16MinBytes(utf16MinBytes), efficiencyCores(efficiencyCores), parallelDecode(parallelDecode), redirectCache(redirectCache), rateLimit(rateLimit), transformers(transformers), lazyStart(lazyStart), recentEvents(recentEvents), heartbeat(heartbeat), underLoad(underLoad), listenerBudget(listenerBudget) {}
   };
 
 } // namespace margelo::nitro::nitroeventsource
@@ -54,7 +228,71 @@ namespace margelo::nitro {
       return NitroEventSourceOptions(
         JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "withCredentials")),
         JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "headers")),
-        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "rawMode"))
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "rawMode")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "http2")),
+        JSIConverter<std::optional<ReconnectPolicy>>::fromJSI(runtime, obj.getProperty(runtime, "reconnect")),
+        JSIConverter<std::optional<BatchOptions>>::fromJSI(runtime, obj.getProperty(runtime, "batch")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "parseJson")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "lazyPayloads")),
+        JSIConverter<std::optional<BackpressureOptions>>::fromJSI(runtime, obj.getProperty(runtime, "backpressure")),
+        JSIConverter<std::optional<CoalesceOptions>>::fromJSI(runtime, obj.getProperty(runtime, "coalesce")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "frameAligned")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "dedupWindow")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxLineBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxEventBytes")),
+        JSIConverter<std::optional<OversizePolicy>>::fromJSI(runtime, obj.getProperty(runtime, "oversize")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "dataChunkBytes")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "compression")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "zstdDictionary")),
+        JSIConverter<std::optional<StateSyncOptions>>::fromJSI(runtime, obj.getProperty(runtime, "stateSync")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "resumeKey")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "storageDirectory")),
+        JSIConverter<std::optional<JournalOptions>>::fromJSI(runtime, obj.getProperty(runtime, "journal")),
+        JSIConverter<std::optional<WarmStartOptions>>::fromJSI(runtime, obj.getProperty(runtime, "warmStart")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "shareConnection")),
+        JSIConverter<std::optional<TimeoutOptions>>::fromJSI(runtime, obj.getProperty(runtime, "timeouts")),
+        JSIConverter<std::optional<SocketOptions>>::fromJSI(runtime, obj.getProperty(runtime, "socket")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "networkAware")),
+        JSIConverter<std::optional<BackgroundOptions>>::fromJSI(runtime, obj.getProperty(runtime, "background")),
+        JSIConverter<std::optional<StreamPriority>>::fromJSI(runtime, obj.getProperty(runtime, "priority")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "method")),
+        JSIConverter<std::optional<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>>::fromJSI(runtime, obj.getProperty(runtime, "body")),
+        JSIConverter<std::optional<TokenStreamOptions>>::fromJSI(runtime, obj.getProperty(runtime, "tokenStream")),
+        JSIConverter<std::optional<EndOfStreamOptions>>::fromJSI(runtime, obj.getProperty(runtime, "endOfStream")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "contentTypes")),
+        JSIConverter<std::optional<LatencyTracingOptions>>::fromJSI(runtime, obj.getProperty(runtime, "latencyTracing")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "http3")),
+        JSIConverter<std::optional<DnsOptions>>::fromJSI(runtime, obj.getProperty(runtime, "dns")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "pull")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "userAgent")),
+        JSIConverter<std::optional<StandbyOptions>>::fromJSI(runtime, obj.getProperty(runtime, "standby")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "endpoints")),
+        JSIConverter<std::optional<CircuitBreakerOptions>>::fromJSI(runtime, obj.getProperty(runtime, "circuitBreaker")),
+        JSIConverter<std::optional<StreamFormat>>::fromJSI(runtime, obj.getProperty(runtime, "format")),
+        JSIConverter<std::optional<RawFraming>>::fromJSI(runtime, obj.getProperty(runtime, "rawFraming")),
+        JSIConverter<std::optional<MessageSchema>>::fromJSI(runtime, obj.getProperty(runtime, "messageSchema")),
+        JSIConverter<std::optional<StreamTransport>>::fromJSI(runtime, obj.getProperty(runtime, "transport")),
+        JSIConverter<std::optional<BufferingDetectionOptions>>::fromJSI(runtime, obj.getProperty(runtime, "bufferingDetection")),
+        JSIConverter<std::optional<SamplingOptions>>::fromJSI(runtime, obj.getProperty(runtime, "sampling")),
+        JSIConverter<std::optional<AggregationOptions>>::fromJSI(runtime, obj.getProperty(runtime, "aggregation")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "priorityTypes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxIdBytes")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "cpuAccounting")),
+        JSIConverter<std::optional<CaptureOptions>>::fromJSI(runtime, obj.getProperty(runtime, "capture")),
+        JSIConverter<std::optional<ReplayOptions>>::fromJSI(runtime, obj.getProperty(runtime, "replay")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "fetchMode")),
+        JSIConverter<std::optional<std::vector<EventSchema>>>::fromJSI(runtime, obj.getProperty(runtime, "schemas")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "utf16MinBytes")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "efficiencyCores")),
+        JSIConverter<std::optional<ParallelDecodeOptions>>::fromJSI(runtime, obj.getProperty(runtime, "parallelDecode")),
+        JSIConverter<std::optional<RedirectCacheOptions>>::fromJSI(runtime, obj.getProperty(runtime, "redirectCache")),
+        JSIConverter<std::optional<RateLimitOptions>>::fromJSI(runtime, obj.getProperty(runtime, "rateLimit")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "transformers")),
+        JSIConverter<std::optional<LazyStartOptions>>::fromJSI(runtime, obj.getProperty(runtime, "lazyStart")),
+        JSIConverter<std::optional<RecentEventsOptions>>::fromJSI(runtime, obj.getProperty(runtime, "recentEvents")),
+        JSIConverter<std::optional<HeartbeatOptions>>::fromJSI(runtime, obj.getProperty(runtime, "heartbeat")),
+        JSIConverter<std::optional<LoadPolicy>>::fromJSI(runtime, obj.getProperty(runtime, "underLoad")),
+        JSIConverter<std::optional<ListenerBudget>>::fromJSI(runtime, obj.getProperty(runtime, "listenerBudget"))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const NitroEventSourceOptions& arg) {
@@ -62,6 +300,70 @@ namespace margelo::nitro {
       obj.setProperty(runtime, "withCredentials", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.withCredentials));
       obj.setProperty(runtime, "headers", JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::toJSI(runtime, arg.headers));
       obj.setProperty(runtime, "rawMode", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.rawMode));
+      obj.setProperty(runtime, "http2", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.http2));
+      obj.setProperty(runtime, "reconnect", JSIConverter<std::optional<ReconnectPolicy>>::toJSI(runtime, arg.reconnect));
+      obj.setProperty(runtime, "batch", JSIConverter<std::optional<BatchOptions>>::toJSI(runtime, arg.batch));
+      obj.setProperty(runtime, "parseJson", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.parseJson));
+      obj.setProperty(runtime, "lazyPayloads", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.lazyPayloads));
+      obj.setProperty(runtime, "backpressure", JSIConverter<std::optional<BackpressureOptions>>::toJSI(runtime, arg.backpressure));
+      obj.setProperty(runtime, "coalesce", JSIConverter<std::optional<CoalesceOptions>>::toJSI(runtime, arg.coalesce));
+      obj.setProperty(runtime, "frameAligned", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.frameAligned));
+      obj.setProperty(runtime, "dedupWindow", JSIConverter<std::optional<double>>::toJSI(runtime, arg.dedupWindow));
+      obj.setProperty(runtime, "maxLineBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxLineBytes));
+      obj.setProperty(runtime, "maxEventBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEventBytes));
+      obj.setProperty(runtime, "oversize", JSIConverter<std::optional<OversizePolicy>>::toJSI(runtime, arg.oversize));
+      obj.setProperty(runtime, "dataChunkBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.dataChunkBytes));
+      obj.setProperty(runtime, "compression", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.compression));
+      obj.setProperty(runtime, "zstdDictionary", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.zstdDictionary));
+      obj.setProperty(runtime, "stateSync", JSIConverter<std::optional<StateSyncOptions>>::toJSI(runtime, arg.stateSync));
+      obj.setProperty(runtime, "resumeKey", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.resumeKey));
+      obj.setProperty(runtime, "storageDirectory", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.storageDirectory));
+      obj.setProperty(runtime, "journal", JSIConverter<std::optional<JournalOptions>>::toJSI(runtime, arg.journal));
+      obj.setProperty(runtime, "warmStart", JSIConverter<std::optional<WarmStartOptions>>::toJSI(runtime, arg.warmStart));
+      obj.setProperty(runtime, "shareConnection", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.shareConnection));
+      obj.setProperty(runtime, "timeouts", JSIConverter<std::optional<TimeoutOptions>>::toJSI(runtime, arg.timeouts));
+      obj.setProperty(runtime, "socket", JSIConverter<std::optional<SocketOptions>>::toJSI(runtime, arg.socket));
+      obj.setProperty(runtime, "networkAware", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.networkAware));
+      obj.setProperty(runtime, "background", JSIConverter<std::optional<BackgroundOptions>>::toJSI(runtime, arg.background));
+      obj.setProperty(runtime, "priority", JSIConverter<std::optional<StreamPriority>>::toJSI(runtime, arg.priority));
+      obj.setProperty(runtime, "method", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.method));
+      obj.setProperty(runtime, "body", JSIConverter<std::optional<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>>::toJSI(runtime, arg.body));
+      obj.setProperty(runtime, "tokenStream", JSIConverter<std::optional<TokenStreamOptions>>::toJSI(runtime, arg.tokenStream));
+      obj.setProperty(runtime, "endOfStream", JSIConverter<std::optional<EndOfStreamOptions>>::toJSI(runtime, arg.endOfStream));
+      obj.setProperty(runtime, "contentTypes", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.contentTypes));
+      obj.setProperty(runtime, "latencyTracing", JSIConverter<std::optional<LatencyTracingOptions>>::toJSI(runtime, arg.latencyTracing));
+      obj.setProperty(runtime, "http3", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.http3));
+      obj.setProperty(runtime, "dns", JSIConverter<std::optional<DnsOptions>>::toJSI(runtime, arg.dns));
+      obj.setProperty(runtime, "pull", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.pull));
+      obj.setProperty(runtime, "userAgent", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.userAgent));
+      obj.setProperty(runtime, "standby", JSIConverter<std::optional<StandbyOptions>>::toJSI(runtime, arg.standby));
+      obj.setProperty(runtime, "endpoints", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.endpoints));
+      obj.setProperty(runtime, "circuitBreaker", JSIConverter<std::optional<CircuitBreakerOptions>>::toJSI(runtime, arg.circuitBreaker));
+      obj.setProperty(runtime, "format", JSIConverter<std::optional<StreamFormat>>::toJSI(runtime, arg.format));
+      obj.setProperty(runtime, "rawFraming", JSIConverter<std::optional<RawFraming>>::toJSI(runtime, arg.rawFraming));
+      obj.setProperty(runtime, "messageSchema", JSIConverter<std::optional<MessageSchema>>::toJSI(runtime, arg.messageSchema));
+      obj.setProperty(runtime, "transport", JSIConverter<std::optional<StreamTransport>>::toJSI(runtime, arg.transport));
+      obj.setProperty(runtime, "bufferingDetection", JSIConverter<std::optional<BufferingDetectionOptions>>::toJSI(runtime, arg.bufferingDetection));
+      obj.setProperty(runtime, "sampling", JSIConverter<std::optional<SamplingOptions>>::toJSI(runtime, arg.sampling));
+      obj.setProperty(runtime, "aggregation", JSIConverter<std::optional<AggregationOptions>>::toJSI(runtime, arg.aggregation));
+      obj.setProperty(runtime, "priorityTypes", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.priorityTypes));
+      obj.setProperty(runtime, "maxIdBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxIdBytes));
+      obj.setProperty(runtime, "cpuAccounting", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.cpuAccounting));
+      obj.setProperty(runtime, "capture", JSIConverter<std::optional<CaptureOptions>>::toJSI(runtime, arg.capture));
+      obj.setProperty(runtime, "replay", JSIConverter<std::optional<ReplayOptions>>::toJSI(runtime, arg.replay));
+      obj.setProperty(runtime, "fetchMode", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.fetchMode));
+      obj.setProperty(runtime, "schemas", JSIConverter<std::optional<std::vector<EventSchema>>>::toJSI(runtime, arg.schemas));
+      obj.setProperty(runtime, "utf16MinBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.utf16MinBytes));
+      obj.setProperty(runtime, "efficiencyCores", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.efficiencyCores));
+      obj.setProperty(runtime, "parallelDecode", JSIConverter<std::optional<ParallelDecodeOptions>>::toJSI(runtime, arg.parallelDecode));
+      obj.setProperty(runtime, "redirectCache", JSIConverter<std::optional<RedirectCacheOptions>>::toJSI(runtime, arg.redirectCache));
+      obj.setProperty(runtime, "rateLimit", JSIConverter<std::optional<RateLimitOptions>>::toJSI(runtime, arg.rateLimit));
+      obj.setProperty(runtime, "transformers", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.transformers));
+      obj.setProperty(runtime, "lazyStart", JSIConverter<std::optional<LazyStartOptions>>::toJSI(runtime, arg.lazyStart));
+      obj.setProperty(runtime, "recentEvents", JSIConverter<std::optional<RecentEventsOptions>>::toJSI(runtime, arg.recentEvents));
+      obj.setProperty(runtime, "heartbeat", JSIConverter<std::optional<HeartbeatOptions>>::toJSI(runtime, arg.heartbeat));
+      obj.setProperty(runtime, "underLoad", JSIConverter<std::optional<LoadPolicy>>::toJSI(runtime, arg.underLoad));
+      obj.setProperty(runtime, "listenerBudget", JSIConverter<std::optional<ListenerBudget>>::toJSI(runtime, arg.listenerBudget));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -72,6 +374,70 @@ namespace margelo::nitro {
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "withCredentials"))) return false;
       if (!JSIConverter<std::optional<std::unordered_map<std::string, std::string>>>::canConvert(runtime, obj.getProperty(runtime, "headers"))) return false;
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "rawMode"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "http2"))) return false;
+      if (!JSIConverter<std::optional<ReconnectPolicy>>::canConvert(runtime, obj.getProperty(runtime, "reconnect"))) return false;
+      if (!JSIConverter<std::optional<BatchOptions>>::canConvert(runtime, obj.getProperty(runtime, "batch"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "parseJson"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "lazyPayloads"))) return false;
+      if (!JSIConverter<std::optional<BackpressureOptions>>::canConvert(runtime, obj.getProperty(runtime, "backpressure"))) return false;
+      if (!JSIConverter<std::optional<CoalesceOptions>>::canConvert(runtime, obj.getProperty(runtime, "coalesce"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "frameAligned"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "dedupWindow"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxLineBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxEventBytes"))) return false;
+      if (!JSIConverter<std::optional<OversizePolicy>>::canConvert(runtime, obj.getProperty(runtime, "oversize"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "dataChunkBytes"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "compression"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "zstdDictionary"))) return false;
+      if (!JSIConverter<std::optional<StateSyncOptions>>::canConvert(runtime, obj.getProperty(runtime, "stateSync"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "resumeKey"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "storageDirectory"))) return false;
+      if (!JSIConverter<std::optional<JournalOptions>>::canConvert(runtime, obj.getProperty(runtime, "journal"))) return false;
+      if (!JSIConverter<std::optional<WarmStartOptions>>::canConvert(runtime, obj.getProperty(runtime, "warmStart"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "shareConnection"))) return false;
+      if (!JSIConverter<std::optional<TimeoutOptions>>::canConvert(runtime, obj.getProperty(runtime, "timeouts"))) return false;
+      if (!JSIConverter<std::optional<SocketOptions>>::canConvert(runtime, obj.getProperty(runtime, "socket"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "networkAware"))) return false;
+      if (!JSIConverter<std::optional<BackgroundOptions>>::canConvert(runtime, obj.getProperty(runtime, "background"))) return false;
+      if (!JSIConverter<std::optional<StreamPriority>>::canConvert(runtime, obj.getProperty(runtime, "priority"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "method"))) return false;
+      if (!JSIConverter<std::optional<std::variant<std::string, std::shared_ptr<ArrayBuffer>>>>::canConvert(runtime, obj.getProperty(runtime, "body"))) return false;
+      if (!JSIConverter<std::optional<TokenStreamOptions>>::canConvert(runtime, obj.getProperty(runtime, "tokenStream"))) return false;
+      if (!JSIConverter<std::optional<EndOfStreamOptions>>::canConvert(runtime, obj.getProperty(runtime, "endOfStream"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "contentTypes"))) return false;
+      if (!JSIConverter<std::optional<LatencyTracingOptions>>::canConvert(runtime, obj.getProperty(runtime, "latencyTracing"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "http3"))) return false;
+      if (!JSIConverter<std::optional<DnsOptions>>::canConvert(runtime, obj.getProperty(runtime, "dns"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "pull"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "userAgent"))) return false;
+      if (!JSIConverter<std::optional<StandbyOptions>>::canConvert(runtime, obj.getProperty(runtime, "standby"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "endpoints"))) return false;
+      if (!JSIConverter<std::optional<CircuitBreakerOptions>>::canConvert(runtime, obj.getProperty(runtime, "circuitBreaker"))) return false;
+      if (!JSIConverter<std::optional<StreamFormat>>::canConvert(runtime, obj.getProperty(runtime, "format"))) return false;
+      if (!JSIConverter<std::optional<RawFraming>>::canConvert(runtime, obj.getProperty(runtime, "rawFraming"))) return false;
+      if (!JSIConverter<std::optional<MessageSchema>>::canConvert(runtime, obj.getProperty(runtime, "messageSchema"))) return false;
+      if (!JSIConverter<std::optional<StreamTransport>>::canConvert(runtime, obj.getProperty(runtime, "transport"))) return false;
+      if (!JSIConverter<std::optional<BufferingDetectionOptions>>::canConvert(runtime, obj.getProperty(runtime, "bufferingDetection"))) return false;
+      if (!JSIConverter<std::optional<SamplingOptions>>::canConvert(runtime, obj.getProperty(runtime, "sampling"))) return false;
+      if (!JSIConverter<std::optional<AggregationOptions>>::canConvert(runtime, obj.getProperty(runtime, "aggregation"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "priorityTypes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxIdBytes"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "cpuAccounting"))) return false;
+      if (!JSIConverter<std::optional<CaptureOptions>>::canConvert(runtime, obj.getProperty(runtime, "capture"))) return false;
+      if (!JSIConverter<std::optional<ReplayOptions>>::canConvert(runtime, obj.getProperty(runtime, "replay"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "fetchMode"))) return false;
+      if (!JSIConverter<std::optional<std::vector<EventSchema>>>::canConvert(runtime, obj.getProperty(runtime, "schemas"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "utf16MinBytes"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "efficiencyCores"))) return false;
+      if (!JSIConverter<std::optional<ParallelDecodeOptions>>::canConvert(runtime, obj.getProperty(runtime, "parallelDecode"))) return false;
+      if (!JSIConverter<std::optional<RedirectCacheOptions>>::canConvert(runtime, obj.getProperty(runtime, "redirectCache"))) return false;
+      if (!JSIConverter<std::optional<RateLimitOptions>>::canConvert(runtime, obj.getProperty(runtime, "rateLimit"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "transformers"))) return false;
+      if (!JSIConverter<std::optional<LazyStartOptions>>::canConvert(runtime, obj.getProperty(runtime, "lazyStart"))) return false;
+      if (!JSIConverter<std::optional<RecentEventsOptions>>::canConvert(runtime, obj.getProperty(runtime, "recentEvents"))) return false;
+      if (!JSIConverter<std::optional<HeartbeatOptions>>::canConvert(runtime, obj.getProperty(runtime, "heartbeat"))) return false;
+      if (!JSIConverter<std::optional<LoadPolicy>>::canConvert(runtime, obj.getProperty(runtime, "underLoad"))) return false;
+      if (!JSIConverter<std::optional<ListenerBudget>>::canConvert(runtime, obj.getProperty(runtime, "listenerBudget"))) return false;
       return true;
     }
   };
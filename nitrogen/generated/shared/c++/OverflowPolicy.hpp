@@ -0,0 +1,86 @@
+///
+/// OverflowPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (OverflowPolicy).
+   */
+  enum class OverflowPolicy {
+    BLOCK      SWIFT_NAME(block) = 0,
+    DROP_OLDEST      SWIFT_NAME(drop_oldest) = 1,
+    DROP_NEWEST      SWIFT_NAME(drop_newest) = 2,
+    COALESCE      SWIFT_NAME(coalesce) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ OverflowPolicy <> JS OverflowPolicy (union)
+  template <>
+  struct JSIConverter<OverflowPolicy> final {
+    static inline OverflowPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("block"): return OverflowPolicy::BLOCK;
+        case hashString("drop-oldest"): return OverflowPolicy::DROP_OLDEST;
+        case hashString("drop-newest"): return OverflowPolicy::DROP_NEWEST;
+        case hashString("coalesce"): return OverflowPolicy::COALESCE;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum OverflowPolicy - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, OverflowPolicy arg) {
+      switch (arg) {
+        case OverflowPolicy::BLOCK: return JSIConverter<std::string>::toJSI(runtime, "block");
+        case OverflowPolicy::DROP_OLDEST: return JSIConverter<std::string>::toJSI(runtime, "drop-oldest");
+        case OverflowPolicy::DROP_NEWEST: return JSIConverter<std::string>::toJSI(runtime, "drop-newest");
+        case OverflowPolicy::COALESCE: return JSIConverter<std::string>::toJSI(runtime, "coalesce");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert OverflowPolicy to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("block"):
+        case hashString("drop-oldest"):
+        case hashString("drop-newest"):
+        case hashString("coalesce"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
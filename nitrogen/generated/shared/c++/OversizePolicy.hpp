@@ -0,0 +1,82 @@
+///
+/// OversizePolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (OversizePolicy).
+   */
+  enum class OversizePolicy {
+    DROP      SWIFT_NAME(drop) = 0,
+    TRUNCATE      SWIFT_NAME(truncate) = 1,
+    CHUNK      SWIFT_NAME(chunk) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ OversizePolicy <> JS OversizePolicy (union)
+  template <>
+  struct JSIConverter<OversizePolicy> final {
+    static inline OversizePolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("drop"): return OversizePolicy::DROP;
+        case hashString("truncate"): return OversizePolicy::TRUNCATE;
+        case hashString("chunk"): return OversizePolicy::CHUNK;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum OversizePolicy - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, OversizePolicy arg) {
+      switch (arg) {
+        case OversizePolicy::DROP: return JSIConverter<std::string>::toJSI(runtime, "drop");
+        case OversizePolicy::TRUNCATE: return JSIConverter<std::string>::toJSI(runtime, "truncate");
+        case OversizePolicy::CHUNK: return JSIConverter<std::string>::toJSI(runtime, "chunk");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert OversizePolicy to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("drop"):
+        case hashString("truncate"):
+        case hashString("chunk"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,98 @@
+///
+/// PackedEvents.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `NitroEventSourceEvent` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct NitroEventSourceEvent; }
+
+#include <NitroModules/ArrayBuffer.hpp>
+#include <string>
+#include <vector>
+#include "NitroEventSourceEvent.hpp"
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PackedEvents).
+   */
+  struct PackedEvents {
+  public:
+    double count     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> bytes     SWIFT_PRIVATE;
+    std::shared_ptr<ArrayBuffer> index     SWIFT_PRIVATE;
+    std::vector<std::string> types     SWIFT_PRIVATE;
+    std::vector<NitroEventSourceEvent> details     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> receivedAt     SWIFT_PRIVATE;
+    std::optional<std::shared_ptr<ArrayBuffer>> sequences     SWIFT_PRIVATE;
+
+  public:
+    PackedEvents() = default;
+    explicit PackedEvents(double count, std::shared_ptr<ArrayBuffer> bytes, std::shared_ptr<ArrayBuffer> index, std::vector<std::string> types, std::vector<NitroEventSourceEvent> details, std::optional<std::shared_ptr<ArrayBuffer>> receivedAt, std::optional<std::shared_ptr<ArrayBuffer>> sequences): count(count), bytes(bytes), index(index), types(types), details(details), receivedAt(receivedAt), sequences(sequences) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ PackedEvents <> JS PackedEvents (object)
+  template <>
+  struct JSIConverter<PackedEvents> final {
+    static inline PackedEvents fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return PackedEvents(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "count")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "bytes")),
+        JSIConverter<std::shared_ptr<ArrayBuffer>>::fromJSI(runtime, obj.getProperty(runtime, "index")),
+        JSIConverter<std::vector<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "types")),
+        JSIConverter<std::vector<NitroEventSourceEvent>>::fromJSI(runtime, obj.getProperty(runtime, "details")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "receivedAt")),
+        JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::fromJSI(runtime, obj.getProperty(runtime, "sequences"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const PackedEvents& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "count", JSIConverter<double>::toJSI(runtime, arg.count));
+      obj.setProperty(runtime, "bytes", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.bytes));
+      obj.setProperty(runtime, "index", JSIConverter<std::shared_ptr<ArrayBuffer>>::toJSI(runtime, arg.index));
+      obj.setProperty(runtime, "types", JSIConverter<std::vector<std::string>>::toJSI(runtime, arg.types));
+      obj.setProperty(runtime, "details", JSIConverter<std::vector<NitroEventSourceEvent>>::toJSI(runtime, arg.details));
+      obj.setProperty(runtime, "receivedAt", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.receivedAt));
+      obj.setProperty(runtime, "sequences", JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::toJSI(runtime, arg.sequences));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "count"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "bytes"))) return false;
+      if (!JSIConverter<std::shared_ptr<ArrayBuffer>>::canConvert(runtime, obj.getProperty(runtime, "index"))) return false;
+      if (!JSIConverter<std::vector<std::string>>::canConvert(runtime, obj.getProperty(runtime, "types"))) return false;
+      if (!JSIConverter<std::vector<NitroEventSourceEvent>>::canConvert(runtime, obj.getProperty(runtime, "details"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "receivedAt"))) return false;
+      if (!JSIConverter<std::optional<std::shared_ptr<ArrayBuffer>>>::canConvert(runtime, obj.getProperty(runtime, "sequences"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
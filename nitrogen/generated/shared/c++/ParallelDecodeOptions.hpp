@@ -0,0 +1,73 @@
+///
+/// ParallelDecodeOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ParallelDecodeOptions).
+   */
+  struct ParallelDecodeOptions {
+  public:
+    std::optional<double> minBytes     SWIFT_PRIVATE;
+    std::optional<double> maxInFlight     SWIFT_PRIVATE;
+
+  public:
+    ParallelDecodeOptions() = default;
+    explicit ParallelDecodeOptions(std::optional<double> minBytes, std::optional<double> maxInFlight): minBytes(minBytes), maxInFlight(maxInFlight) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ParallelDecodeOptions <> JS ParallelDecodeOptions (object)
+  template <>
+  struct JSIConverter<ParallelDecodeOptions> final {
+    static inline ParallelDecodeOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ParallelDecodeOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "minBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxInFlight"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ParallelDecodeOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "minBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.minBytes));
+      obj.setProperty(runtime, "maxInFlight", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxInFlight));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "minBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxInFlight"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
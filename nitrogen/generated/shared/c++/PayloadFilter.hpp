@@ -0,0 +1,87 @@
+///
+/// PayloadFilter.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (PayloadFilter).
+   */
+  struct PayloadFilter {
+  public:
+    std::optional<std::string> type     SWIFT_PRIVATE;
+    std::optional<std::string> pointer     SWIFT_PRIVATE;
+    std::optional<std::string> equals     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> oneOf     SWIFT_PRIVATE;
+    std::optional<std::string> idPrefix     SWIFT_PRIVATE;
+
+  public:
+    PayloadFilter() = default;
+    explicit PayloadFilter(std::optional<std::string> type, std::optional<std::string> pointer, std::optional<std::string> equals, std::optional<std::vector<std::string>> oneOf, std::optional<std::string> idPrefix): type(type), pointer(pointer), equals(equals), oneOf(oneOf), idPrefix(idPrefix) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ PayloadFilter <> JS PayloadFilter (object)
+  template <>
+  struct JSIConverter<PayloadFilter> final {
+    static inline PayloadFilter fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return PayloadFilter(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "type")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "pointer")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "equals")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "oneOf")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "idPrefix"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const PayloadFilter& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "type", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, "pointer", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.pointer));
+      obj.setProperty(runtime, "equals", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.equals));
+      obj.setProperty(runtime, "oneOf", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.oneOf));
+      obj.setProperty(runtime, "idPrefix", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.idPrefix));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "pointer"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "equals"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "oneOf"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "idPrefix"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
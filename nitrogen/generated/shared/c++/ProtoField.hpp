@@ -0,0 +1,84 @@
+///
+/// ProtoField.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ProtoFieldType` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class ProtoFieldType; }
+
+#include <string>
+#include "ProtoFieldType.hpp"
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ProtoField).
+   */
+  struct ProtoField {
+  public:
+    std::string name     SWIFT_PRIVATE;
+    double number     SWIFT_PRIVATE;
+    ProtoFieldType type     SWIFT_PRIVATE;
+    std::optional<bool> repeated     SWIFT_PRIVATE;
+
+  public:
+    ProtoField() = default;
+    explicit ProtoField(std::string name, double number, ProtoFieldType type, std::optional<bool> repeated): name(name), number(number), type(type), repeated(repeated) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ProtoField <> JS ProtoField (object)
+  template <>
+  struct JSIConverter<ProtoField> final {
+    static inline ProtoField fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ProtoField(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "name")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "number")),
+        JSIConverter<ProtoFieldType>::fromJSI(runtime, obj.getProperty(runtime, "type")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "repeated"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ProtoField& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "name", JSIConverter<std::string>::toJSI(runtime, arg.name));
+      obj.setProperty(runtime, "number", JSIConverter<double>::toJSI(runtime, arg.number));
+      obj.setProperty(runtime, "type", JSIConverter<ProtoFieldType>::toJSI(runtime, arg.type));
+      obj.setProperty(runtime, "repeated", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.repeated));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "name"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "number"))) return false;
+      if (!JSIConverter<ProtoFieldType>::canConvert(runtime, obj.getProperty(runtime, "type"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "repeated"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
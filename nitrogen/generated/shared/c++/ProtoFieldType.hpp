@@ -0,0 +1,130 @@
+///
+/// ProtoFieldType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (ProtoFieldType).
+   */
+  enum class ProtoFieldType {
+    INT32      SWIFT_NAME(int32) = 0,
+    INT64      SWIFT_NAME(int64) = 1,
+    UINT32      SWIFT_NAME(uint32) = 2,
+    UINT64      SWIFT_NAME(uint64) = 3,
+    SINT32      SWIFT_NAME(sint32) = 4,
+    SINT64      SWIFT_NAME(sint64) = 5,
+    BOOL      SWIFT_NAME(bool) = 6,
+    DOUBLE      SWIFT_NAME(double) = 7,
+    FLOAT      SWIFT_NAME(float) = 8,
+    FIXED32      SWIFT_NAME(fixed32) = 9,
+    FIXED64      SWIFT_NAME(fixed64) = 10,
+    SFIXED32      SWIFT_NAME(sfixed32) = 11,
+    SFIXED64      SWIFT_NAME(sfixed64) = 12,
+    STRING      SWIFT_NAME(string) = 13,
+    BYTES      SWIFT_NAME(bytes) = 14,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ProtoFieldType <> JS ProtoFieldType (union)
+  template <>
+  struct JSIConverter<ProtoFieldType> final {
+    static inline ProtoFieldType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("int32"): return ProtoFieldType::INT32;
+        case hashString("int64"): return ProtoFieldType::INT64;
+        case hashString("uint32"): return ProtoFieldType::UINT32;
+        case hashString("uint64"): return ProtoFieldType::UINT64;
+        case hashString("sint32"): return ProtoFieldType::SINT32;
+        case hashString("sint64"): return ProtoFieldType::SINT64;
+        case hashString("bool"): return ProtoFieldType::BOOL;
+        case hashString("double"): return ProtoFieldType::DOUBLE;
+        case hashString("float"): return ProtoFieldType::FLOAT;
+        case hashString("fixed32"): return ProtoFieldType::FIXED32;
+        case hashString("fixed64"): return ProtoFieldType::FIXED64;
+        case hashString("sfixed32"): return ProtoFieldType::SFIXED32;
+        case hashString("sfixed64"): return ProtoFieldType::SFIXED64;
+        case hashString("string"): return ProtoFieldType::STRING;
+        case hashString("bytes"): return ProtoFieldType::BYTES;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum ProtoFieldType - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, ProtoFieldType arg) {
+      switch (arg) {
+        case ProtoFieldType::INT32: return JSIConverter<std::string>::toJSI(runtime, "int32");
+        case ProtoFieldType::INT64: return JSIConverter<std::string>::toJSI(runtime, "int64");
+        case ProtoFieldType::UINT32: return JSIConverter<std::string>::toJSI(runtime, "uint32");
+        case ProtoFieldType::UINT64: return JSIConverter<std::string>::toJSI(runtime, "uint64");
+        case ProtoFieldType::SINT32: return JSIConverter<std::string>::toJSI(runtime, "sint32");
+        case ProtoFieldType::SINT64: return JSIConverter<std::string>::toJSI(runtime, "sint64");
+        case ProtoFieldType::BOOL: return JSIConverter<std::string>::toJSI(runtime, "bool");
+        case ProtoFieldType::DOUBLE: return JSIConverter<std::string>::toJSI(runtime, "double");
+        case ProtoFieldType::FLOAT: return JSIConverter<std::string>::toJSI(runtime, "float");
+        case ProtoFieldType::FIXED32: return JSIConverter<std::string>::toJSI(runtime, "fixed32");
+        case ProtoFieldType::FIXED64: return JSIConverter<std::string>::toJSI(runtime, "fixed64");
+        case ProtoFieldType::SFIXED32: return JSIConverter<std::string>::toJSI(runtime, "sfixed32");
+        case ProtoFieldType::SFIXED64: return JSIConverter<std::string>::toJSI(runtime, "sfixed64");
+        case ProtoFieldType::STRING: return JSIConverter<std::string>::toJSI(runtime, "string");
+        case ProtoFieldType::BYTES: return JSIConverter<std::string>::toJSI(runtime, "bytes");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert ProtoFieldType to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("int32"):
+        case hashString("int64"):
+        case hashString("uint32"):
+        case hashString("uint64"):
+        case hashString("sint32"):
+        case hashString("sint64"):
+        case hashString("bool"):
+        case hashString("double"):
+        case hashString("float"):
+        case hashString("fixed32"):
+        case hashString("fixed64"):
+        case hashString("sfixed32"):
+        case hashString("sfixed64"):
+        case hashString("string"):
+        case hashString("bytes"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
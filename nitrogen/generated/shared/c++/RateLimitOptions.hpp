@@ -0,0 +1,73 @@
+///
+/// RateLimitOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RateLimitOptions).
+   */
+  struct RateLimitOptions {
+  public:
+    std::optional<double> maxBytesPerSecond     SWIFT_PRIVATE;
+    std::optional<double> maxEventsPerSecond     SWIFT_PRIVATE;
+
+  public:
+    RateLimitOptions() = default;
+    explicit RateLimitOptions(std::optional<double> maxBytesPerSecond, std::optional<double> maxEventsPerSecond): maxBytesPerSecond(maxBytesPerSecond), maxEventsPerSecond(maxEventsPerSecond) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ RateLimitOptions <> JS RateLimitOptions (object)
+  template <>
+  struct JSIConverter<RateLimitOptions> final {
+    static inline RateLimitOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RateLimitOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxBytesPerSecond")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxEventsPerSecond"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RateLimitOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "maxBytesPerSecond", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxBytesPerSecond));
+      obj.setProperty(runtime, "maxEventsPerSecond", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEventsPerSecond));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxBytesPerSecond"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxEventsPerSecond"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
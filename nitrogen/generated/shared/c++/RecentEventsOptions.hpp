@@ -0,0 +1,73 @@
+///
+/// RecentEventsOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RecentEventsOptions).
+   */
+  struct RecentEventsOptions {
+  public:
+    std::optional<double> maxEvents     SWIFT_PRIVATE;
+    std::optional<double> maxAgeMs     SWIFT_PRIVATE;
+
+  public:
+    RecentEventsOptions() = default;
+    explicit RecentEventsOptions(std::optional<double> maxEvents, std::optional<double> maxAgeMs): maxEvents(maxEvents), maxAgeMs(maxAgeMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ RecentEventsOptions <> JS RecentEventsOptions (object)
+  template <>
+  struct JSIConverter<RecentEventsOptions> final {
+    static inline RecentEventsOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RecentEventsOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxEvents")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxAgeMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RecentEventsOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "maxEvents", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEvents));
+      obj.setProperty(runtime, "maxAgeMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxAgeMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxEvents"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxAgeMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,87 @@
+///
+/// ReconnectPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `CloseReasonDelays` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { struct CloseReasonDelays; }
+
+#include <optional>
+#include "CloseReasonDelays.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ReconnectPolicy).
+   */
+  struct ReconnectPolicy {
+  public:
+    std::optional<double> initialDelayMs     SWIFT_PRIVATE;
+    std::optional<double> maxDelayMs     SWIFT_PRIVATE;
+    std::optional<double> multiplier     SWIFT_PRIVATE;
+    std::optional<bool> jitter     SWIFT_PRIVATE;
+    std::optional<CloseReasonDelays> byReason     SWIFT_PRIVATE;
+
+  public:
+    ReconnectPolicy() = default;
+    explicit ReconnectPolicy(std::optional<double> initialDelayMs, std::optional<double> maxDelayMs, std::optional<double> multiplier, std::optional<bool> jitter, std::optional<CloseReasonDelays> byReason): initialDelayMs(initialDelayMs), maxDelayMs(maxDelayMs), multiplier(multiplier), jitter(jitter), byReason(byReason) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ReconnectPolicy <> JS ReconnectPolicy (object)
+  template <>
+  struct JSIConverter<ReconnectPolicy> final {
+    static inline ReconnectPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ReconnectPolicy(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "initialDelayMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxDelayMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "multiplier")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "jitter")),
+        JSIConverter<std::optional<CloseReasonDelays>>::fromJSI(runtime, obj.getProperty(runtime, "byReason"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ReconnectPolicy& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "initialDelayMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.initialDelayMs));
+      obj.setProperty(runtime, "maxDelayMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxDelayMs));
+      obj.setProperty(runtime, "multiplier", JSIConverter<std::optional<double>>::toJSI(runtime, arg.multiplier));
+      obj.setProperty(runtime, "jitter", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.jitter));
+      obj.setProperty(runtime, "byReason", JSIConverter<std::optional<CloseReasonDelays>>::toJSI(runtime, arg.byReason));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "initialDelayMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxDelayMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "multiplier"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "jitter"))) return false;
+      if (!JSIConverter<std::optional<CloseReasonDelays>>::canConvert(runtime, obj.getProperty(runtime, "byReason"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,73 @@
+///
+/// RedirectCacheOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (RedirectCacheOptions).
+   */
+  struct RedirectCacheOptions {
+  public:
+    std::optional<double> permanentMs     SWIFT_PRIVATE;
+    std::optional<double> temporaryMs     SWIFT_PRIVATE;
+
+  public:
+    RedirectCacheOptions() = default;
+    explicit RedirectCacheOptions(std::optional<double> permanentMs, std::optional<double> temporaryMs): permanentMs(permanentMs), temporaryMs(temporaryMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ RedirectCacheOptions <> JS RedirectCacheOptions (object)
+  template <>
+  struct JSIConverter<RedirectCacheOptions> final {
+    static inline RedirectCacheOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return RedirectCacheOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "permanentMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "temporaryMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const RedirectCacheOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "permanentMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.permanentMs));
+      obj.setProperty(runtime, "temporaryMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.temporaryMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "permanentMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "temporaryMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
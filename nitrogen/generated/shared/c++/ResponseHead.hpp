@@ -0,0 +1,74 @@
+///
+/// ResponseHead.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <unordered_map>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (ResponseHead).
+   */
+  struct ResponseHead {
+  public:
+    double status     SWIFT_PRIVATE;
+    std::unordered_map<std::string, std::string> headers     SWIFT_PRIVATE;
+
+  public:
+    ResponseHead() = default;
+    explicit ResponseHead(double status, std::unordered_map<std::string, std::string> headers): status(status), headers(headers) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ ResponseHead <> JS ResponseHead (object)
+  template <>
+  struct JSIConverter<ResponseHead> final {
+    static inline ResponseHead fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return ResponseHead(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "status")),
+        JSIConverter<std::unordered_map<std::string, std::string>>::fromJSI(runtime, obj.getProperty(runtime, "headers"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const ResponseHead& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "status", JSIConverter<double>::toJSI(runtime, arg.status));
+      obj.setProperty(runtime, "headers", JSIConverter<std::unordered_map<std::string, std::string>>::toJSI(runtime, arg.headers));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "status"))) return false;
+      if (!JSIConverter<std::unordered_map<std::string, std::string>>::canConvert(runtime, obj.getProperty(runtime, "headers"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,83 @@
+///
+/// SamplingOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (SamplingOptions).
+   */
+  struct SamplingOptions {
+  public:
+    std::optional<double> every     SWIFT_PRIVATE;
+    std::optional<double> reservoir     SWIFT_PRIVATE;
+    std::optional<double> windowMs     SWIFT_PRIVATE;
+    std::optional<std::vector<std::string>> types     SWIFT_PRIVATE;
+
+  public:
+    SamplingOptions() = default;
+    explicit SamplingOptions(std::optional<double> every, std::optional<double> reservoir, std::optional<double> windowMs, std::optional<std::vector<std::string>> types): every(every), reservoir(reservoir), windowMs(windowMs), types(types) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ SamplingOptions <> JS SamplingOptions (object)
+  template <>
+  struct JSIConverter<SamplingOptions> final {
+    static inline SamplingOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return SamplingOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "every")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "reservoir")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "windowMs")),
+        JSIConverter<std::optional<std::vector<std::string>>>::fromJSI(runtime, obj.getProperty(runtime, "types"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const SamplingOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "every", JSIConverter<std::optional<double>>::toJSI(runtime, arg.every));
+      obj.setProperty(runtime, "reservoir", JSIConverter<std::optional<double>>::toJSI(runtime, arg.reservoir));
+      obj.setProperty(runtime, "windowMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.windowMs));
+      obj.setProperty(runtime, "types", JSIConverter<std::optional<std::vector<std::string>>>::toJSI(runtime, arg.types));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "every"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "reservoir"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "windowMs"))) return false;
+      if (!JSIConverter<std::optional<std::vector<std::string>>>::canConvert(runtime, obj.getProperty(runtime, "types"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
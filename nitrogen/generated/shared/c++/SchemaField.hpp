@@ -0,0 +1,84 @@
+///
+/// SchemaField.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `SchemaFieldKind` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class SchemaFieldKind; }
+
+#include <string>
+#include <optional>
+#include "SchemaFieldKind.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (SchemaField).
+   */
+  struct SchemaField {
+  public:
+    std::string name     SWIFT_PRIVATE;
+    std::optional<std::string> pointer     SWIFT_PRIVATE;
+    SchemaFieldKind kind     SWIFT_PRIVATE;
+    std::optional<bool> required     SWIFT_PRIVATE;
+
+  public:
+    SchemaField() = default;
+    explicit SchemaField(std::string name, std::optional<std::string> pointer, SchemaFieldKind kind, std::optional<bool> required): name(name), pointer(pointer), kind(kind), required(required) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ SchemaField <> JS SchemaField (object)
+  template <>
+  struct JSIConverter<SchemaField> final {
+    static inline SchemaField fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return SchemaField(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "name")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "pointer")),
+        JSIConverter<SchemaFieldKind>::fromJSI(runtime, obj.getProperty(runtime, "kind")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "required"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const SchemaField& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "name", JSIConverter<std::string>::toJSI(runtime, arg.name));
+      obj.setProperty(runtime, "pointer", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.pointer));
+      obj.setProperty(runtime, "kind", JSIConverter<SchemaFieldKind>::toJSI(runtime, arg.kind));
+      obj.setProperty(runtime, "required", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.required));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "name"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "pointer"))) return false;
+      if (!JSIConverter<SchemaFieldKind>::canConvert(runtime, obj.getProperty(runtime, "kind"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "required"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,90 @@
+///
+/// SchemaFieldKind.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (SchemaFieldKind).
+   */
+  enum class SchemaFieldKind {
+    NUMBER      SWIFT_NAME(number) = 0,
+    INTEGER      SWIFT_NAME(integer) = 1,
+    BOOLEAN      SWIFT_NAME(boolean) = 2,
+    STRING      SWIFT_NAME(string) = 3,
+    INT32      SWIFT_NAME(int32) = 4,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ SchemaFieldKind <> JS SchemaFieldKind (union)
+  template <>
+  struct JSIConverter<SchemaFieldKind> final {
+    static inline SchemaFieldKind fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("number"): return SchemaFieldKind::NUMBER;
+        case hashString("integer"): return SchemaFieldKind::INTEGER;
+        case hashString("boolean"): return SchemaFieldKind::BOOLEAN;
+        case hashString("string"): return SchemaFieldKind::STRING;
+        case hashString("int32"): return SchemaFieldKind::INT32;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum SchemaFieldKind - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, SchemaFieldKind arg) {
+      switch (arg) {
+        case SchemaFieldKind::NUMBER: return JSIConverter<std::string>::toJSI(runtime, "number");
+        case SchemaFieldKind::INTEGER: return JSIConverter<std::string>::toJSI(runtime, "integer");
+        case SchemaFieldKind::BOOLEAN: return JSIConverter<std::string>::toJSI(runtime, "boolean");
+        case SchemaFieldKind::STRING: return JSIConverter<std::string>::toJSI(runtime, "string");
+        case SchemaFieldKind::INT32: return JSIConverter<std::string>::toJSI(runtime, "int32");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert SchemaFieldKind to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("number"):
+        case hashString("integer"):
+        case hashString("boolean"):
+        case hashString("string"):
+        case hashString("int32"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,95 @@
+///
+/// SocketOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `IpFamily` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class IpFamily; }
+
+#include <optional>
+#include "IpFamily.hpp"
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (SocketOptions).
+   */
+  struct SocketOptions {
+  public:
+    std::optional<bool> keepalive     SWIFT_PRIVATE;
+    std::optional<double> keepaliveIdleMs     SWIFT_PRIVATE;
+    std::optional<double> keepaliveIntervalMs     SWIFT_PRIVATE;
+    std::optional<bool> noDelay     SWIFT_PRIVATE;
+    std::optional<double> receiveBufferBytes     SWIFT_PRIVATE;
+    std::optional<double> happyEyeballsTimeoutMs     SWIFT_PRIVATE;
+    std::optional<IpFamily> ipFamily     SWIFT_PRIVATE;
+
+  public:
+    SocketOptions() = default;
+    explicit SocketOptions(std::optional<bool> keepalive, std::optional<double> keepaliveIdleMs, std::optional<double> keepaliveIntervalMs, std::optional<bool> noDelay, std::optional<double> receiveBufferBytes, std::optional<double> happyEyeballsTimeoutMs, std::optional<IpFamily> ipFamily): keepalive(keepalive), keepaliveIdleMs(keepaliveIdleMs), keepaliveIntervalMs(keepaliveIntervalMs), noDelay(noDelay), receiveBufferBytes(receiveBufferBytes), happyEyeballsTimeoutMs(happyEyeballsTimeoutMs), ipFamily(ipFamily) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ SocketOptions <> JS SocketOptions (object)
+  template <>
+  struct JSIConverter<SocketOptions> final {
+    static inline SocketOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return SocketOptions(
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "keepalive")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "keepaliveIdleMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "keepaliveIntervalMs")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "noDelay")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "receiveBufferBytes")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "happyEyeballsTimeoutMs")),
+        JSIConverter<std::optional<IpFamily>>::fromJSI(runtime, obj.getProperty(runtime, "ipFamily"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const SocketOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "keepalive", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.keepalive));
+      obj.setProperty(runtime, "keepaliveIdleMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.keepaliveIdleMs));
+      obj.setProperty(runtime, "keepaliveIntervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.keepaliveIntervalMs));
+      obj.setProperty(runtime, "noDelay", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.noDelay));
+      obj.setProperty(runtime, "receiveBufferBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.receiveBufferBytes));
+      obj.setProperty(runtime, "happyEyeballsTimeoutMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.happyEyeballsTimeoutMs));
+      obj.setProperty(runtime, "ipFamily", JSIConverter<std::optional<IpFamily>>::toJSI(runtime, arg.ipFamily));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "keepalive"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "keepaliveIdleMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "keepaliveIntervalMs"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "noDelay"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "receiveBufferBytes"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "happyEyeballsTimeoutMs"))) return false;
+      if (!JSIConverter<std::optional<IpFamily>>::canConvert(runtime, obj.getProperty(runtime, "ipFamily"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,74 @@
+///
+/// StandbyOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StandbyOptions).
+   */
+  struct StandbyOptions {
+  public:
+    std::optional<std::string> url     SWIFT_PRIVATE;
+    std::optional<double> keepWarmMs     SWIFT_PRIVATE;
+
+  public:
+    StandbyOptions() = default;
+    explicit StandbyOptions(std::optional<std::string> url, std::optional<double> keepWarmMs): url(url), keepWarmMs(keepWarmMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StandbyOptions <> JS StandbyOptions (object)
+  template <>
+  struct JSIConverter<StandbyOptions> final {
+    static inline StandbyOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return StandbyOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "url")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "keepWarmMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const StandbyOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "url", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.url));
+      obj.setProperty(runtime, "keepWarmMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.keepWarmMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "url"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "keepWarmMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,86 @@
+///
+/// StateSyncOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StateSyncOptions).
+   */
+  struct StateSyncOptions {
+  public:
+    std::optional<std::string> snapshotEvent     SWIFT_PRIVATE;
+    std::optional<std::string> patchEvent     SWIFT_PRIVATE;
+    std::optional<std::string> key     SWIFT_PRIVATE;
+    std::optional<std::string> versionHeader     SWIFT_PRIVATE;
+    std::optional<std::string> versionPointer     SWIFT_PRIVATE;
+
+  public:
+    StateSyncOptions() = default;
+    explicit StateSyncOptions(std::optional<std::string> snapshotEvent, std::optional<std::string> patchEvent, std::optional<std::string> key, std::optional<std::string> versionHeader, std::optional<std::string> versionPointer): snapshotEvent(snapshotEvent), patchEvent(patchEvent), key(key), versionHeader(versionHeader), versionPointer(versionPointer) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StateSyncOptions <> JS StateSyncOptions (object)
+  template <>
+  struct JSIConverter<StateSyncOptions> final {
+    static inline StateSyncOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return StateSyncOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "snapshotEvent")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "patchEvent")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "key")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "versionHeader")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "versionPointer"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const StateSyncOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "snapshotEvent", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.snapshotEvent));
+      obj.setProperty(runtime, "patchEvent", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.patchEvent));
+      obj.setProperty(runtime, "key", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.key));
+      obj.setProperty(runtime, "versionHeader", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.versionHeader));
+      obj.setProperty(runtime, "versionPointer", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.versionPointer));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "snapshotEvent"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "patchEvent"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "key"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "versionHeader"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "versionPointer"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
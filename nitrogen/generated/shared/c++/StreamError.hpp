@@ -0,0 +1,96 @@
+///
+/// StreamError.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `ErrorPhase` to properly resolve imports.
+namespace margelo::nitro::nitroeventsource { enum class ErrorPhase; }
+
+#include "ErrorPhase.hpp"
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StreamError).
+   */
+  struct StreamError {
+  public:
+    ErrorPhase phase     SWIFT_PRIVATE;
+    double curlCode     SWIFT_PRIVATE;
+    std::optional<double> status     SWIFT_PRIVATE;
+    std::string message     SWIFT_PRIVATE;
+    double attempt     SWIFT_PRIVATE;
+    std::optional<double> retryInMs     SWIFT_PRIVATE;
+    std::optional<bool> circuitOpen     SWIFT_PRIVATE;
+
+  public:
+    StreamError() = default;
+    explicit StreamError(ErrorPhase phase, double curlCode, std::optional<double> status, std::string message, double attempt, std::optional<double> retryInMs, std::optional<bool> circuitOpen): phase(phase), curlCode(curlCode), status(status), message(message), attempt(attempt), retryInMs(retryInMs), circuitOpen(circuitOpen) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StreamError <> JS StreamError (object)
+  template <>
+  struct JSIConverter<StreamError> final {
+    static inline StreamError fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return StreamError(
+        JSIConverter<ErrorPhase>::fromJSI(runtime, obj.getProperty(runtime, "phase")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "curlCode")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "status")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "message")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "attempt")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "retryInMs")),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, "circuitOpen"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const StreamError& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "phase", JSIConverter<ErrorPhase>::toJSI(runtime, arg.phase));
+      obj.setProperty(runtime, "curlCode", JSIConverter<double>::toJSI(runtime, arg.curlCode));
+      obj.setProperty(runtime, "status", JSIConverter<std::optional<double>>::toJSI(runtime, arg.status));
+      obj.setProperty(runtime, "message", JSIConverter<std::string>::toJSI(runtime, arg.message));
+      obj.setProperty(runtime, "attempt", JSIConverter<double>::toJSI(runtime, arg.attempt));
+      obj.setProperty(runtime, "retryInMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.retryInMs));
+      obj.setProperty(runtime, "circuitOpen", JSIConverter<std::optional<bool>>::toJSI(runtime, arg.circuitOpen));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<ErrorPhase>::canConvert(runtime, obj.getProperty(runtime, "phase"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "curlCode"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "status"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "message"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "attempt"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "retryInMs"))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, "circuitOpen"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
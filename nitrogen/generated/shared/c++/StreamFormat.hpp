@@ -0,0 +1,82 @@
+///
+/// StreamFormat.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (StreamFormat).
+   */
+  enum class StreamFormat {
+    SSE      SWIFT_NAME(sse) = 0,
+    NDJSON      SWIFT_NAME(ndjson) = 1,
+    JSON_SEQ      SWIFT_NAME(json_seq) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StreamFormat <> JS StreamFormat (union)
+  template <>
+  struct JSIConverter<StreamFormat> final {
+    static inline StreamFormat fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("sse"): return StreamFormat::SSE;
+        case hashString("ndjson"): return StreamFormat::NDJSON;
+        case hashString("json-seq"): return StreamFormat::JSON_SEQ;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum StreamFormat - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, StreamFormat arg) {
+      switch (arg) {
+        case StreamFormat::SSE: return JSIConverter<std::string>::toJSI(runtime, "sse");
+        case StreamFormat::NDJSON: return JSIConverter<std::string>::toJSI(runtime, "ndjson");
+        case StreamFormat::JSON_SEQ: return JSIConverter<std::string>::toJSI(runtime, "json-seq");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert StreamFormat to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("sse"):
+        case hashString("ndjson"):
+        case hashString("json-seq"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,105 @@
+///
+/// StreamMetricsSample.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (StreamMetricsSample).
+   */
+  struct StreamMetricsSample {
+  public:
+    double id     SWIFT_PRIVATE;
+    std::string url     SWIFT_PRIVATE;
+    double readyState     SWIFT_PRIVATE;
+    double eventsPerSecond     SWIFT_PRIVATE;
+    double bytesPerSecond     SWIFT_PRIVATE;
+    double queuedEvents     SWIFT_PRIVATE;
+    double eventsDropped     SWIFT_PRIVATE;
+    double reconnects     SWIFT_PRIVATE;
+    double dispatchP50Us     SWIFT_PRIVATE;
+    double dispatchP99Us     SWIFT_PRIVATE;
+
+  public:
+    StreamMetricsSample() = default;
+    explicit StreamMetricsSample(double id, std::string url, double readyState, double eventsPerSecond, double bytesPerSecond, double queuedEvents, double eventsDropped, double reconnects, double dispatchP50Us, double dispatchP99Us): id(id), url(url), readyState(readyState), eventsPerSecond(eventsPerSecond), bytesPerSecond(bytesPerSecond), queuedEvents(queuedEvents), eventsDropped(eventsDropped), reconnects(reconnects), dispatchP50Us(dispatchP50Us), dispatchP99Us(dispatchP99Us) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StreamMetricsSample <> JS StreamMetricsSample (object)
+  template <>
+  struct JSIConverter<StreamMetricsSample> final {
+    static inline StreamMetricsSample fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return StreamMetricsSample(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "id")),
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, "url")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "readyState")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsPerSecond")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "bytesPerSecond")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "queuedEvents")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "eventsDropped")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "reconnects")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "dispatchP50Us")),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, "dispatchP99Us"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const StreamMetricsSample& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "id", JSIConverter<double>::toJSI(runtime, arg.id));
+      obj.setProperty(runtime, "url", JSIConverter<std::string>::toJSI(runtime, arg.url));
+      obj.setProperty(runtime, "readyState", JSIConverter<double>::toJSI(runtime, arg.readyState));
+      obj.setProperty(runtime, "eventsPerSecond", JSIConverter<double>::toJSI(runtime, arg.eventsPerSecond));
+      obj.setProperty(runtime, "bytesPerSecond", JSIConverter<double>::toJSI(runtime, arg.bytesPerSecond));
+      obj.setProperty(runtime, "queuedEvents", JSIConverter<double>::toJSI(runtime, arg.queuedEvents));
+      obj.setProperty(runtime, "eventsDropped", JSIConverter<double>::toJSI(runtime, arg.eventsDropped));
+      obj.setProperty(runtime, "reconnects", JSIConverter<double>::toJSI(runtime, arg.reconnects));
+      obj.setProperty(runtime, "dispatchP50Us", JSIConverter<double>::toJSI(runtime, arg.dispatchP50Us));
+      obj.setProperty(runtime, "dispatchP99Us", JSIConverter<double>::toJSI(runtime, arg.dispatchP99Us));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "id"))) return false;
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, "url"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "readyState"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsPerSecond"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "bytesPerSecond"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "queuedEvents"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "eventsDropped"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "reconnects"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "dispatchP50Us"))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, "dispatchP99Us"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,82 @@
+///
+/// StreamPriority.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (StreamPriority).
+   */
+  enum class StreamPriority {
+    INTERACTIVE      SWIFT_NAME(interactive) = 0,
+    NORMAL      SWIFT_NAME(normal) = 1,
+    BACKGROUND      SWIFT_NAME(background) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ StreamPriority <> JS StreamPriority (union)
+  template <>
+  struct JSIConverter<StreamPriority> final {
+    static inline StreamPriority fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("interactive"): return StreamPriority::INTERACTIVE;
+        case hashString("normal"): return StreamPriority::NORMAL;
+        case hashString("background"): return StreamPriority::BACKGROUND;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum StreamPriority - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, StreamPriority arg) {
+      switch (arg) {
+        case StreamPriority::INTERACTIVE: return JSIConverter<std::string>::toJSI(runtime, "interactive");
+        case StreamPriority::NORMAL: return JSIConverter<std::string>::toJSI(runtime, "normal");
+        case StreamPriority::BACKGROUND: return JSIConverter<std::string>::toJSI(runtime, "background");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert StreamPriority to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("interactive"):
+        case hashString("normal"):
+        case hashString("background"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
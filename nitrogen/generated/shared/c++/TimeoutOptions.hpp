@@ -0,0 +1,85 @@
+///
+/// TimeoutOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TimeoutOptions).
+   */
+  struct TimeoutOptions {
+  public:
+    std::optional<double> connectMs     SWIFT_PRIVATE;
+    std::optional<double> idleMs     SWIFT_PRIVATE;
+    std::optional<double> lowSpeedBytesPerSecond     SWIFT_PRIVATE;
+    std::optional<double> lowSpeedMs     SWIFT_PRIVATE;
+    std::optional<double> stallMs     SWIFT_PRIVATE;
+
+  public:
+    TimeoutOptions() = default;
+    explicit TimeoutOptions(std::optional<double> connectMs, std::optional<double> idleMs, std::optional<double> lowSpeedBytesPerSecond, std::optional<double> lowSpeedMs, std::optional<double> stallMs): connectMs(connectMs), idleMs(idleMs), lowSpeedBytesPerSecond(lowSpeedBytesPerSecond), lowSpeedMs(lowSpeedMs), stallMs(stallMs) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ TimeoutOptions <> JS TimeoutOptions (object)
+  template <>
+  struct JSIConverter<TimeoutOptions> final {
+    static inline TimeoutOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TimeoutOptions(
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "connectMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "idleMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "lowSpeedBytesPerSecond")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "lowSpeedMs")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "stallMs"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TimeoutOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "connectMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.connectMs));
+      obj.setProperty(runtime, "idleMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.idleMs));
+      obj.setProperty(runtime, "lowSpeedBytesPerSecond", JSIConverter<std::optional<double>>::toJSI(runtime, arg.lowSpeedBytesPerSecond));
+      obj.setProperty(runtime, "lowSpeedMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.lowSpeedMs));
+      obj.setProperty(runtime, "stallMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.stallMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "connectMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "idleMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "lowSpeedBytesPerSecond"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "lowSpeedMs"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "stallMs"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,82 @@
+///
+/// TimestampUnit.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * An enum which can be represented as a JavaScript union (TimestampUnit).
+   */
+  enum class TimestampUnit {
+    S      SWIFT_NAME(s) = 0,
+    MS      SWIFT_NAME(ms) = 1,
+    US      SWIFT_NAME(us) = 2,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ TimestampUnit <> JS TimestampUnit (union)
+  template <>
+  struct JSIConverter<TimestampUnit> final {
+    static inline TimestampUnit fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("s"): return TimestampUnit::S;
+        case hashString("ms"): return TimestampUnit::MS;
+        case hashString("us"): return TimestampUnit::US;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum TimestampUnit - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, TimestampUnit arg) {
+      switch (arg) {
+        case TimestampUnit::S: return JSIConverter<std::string>::toJSI(runtime, "s");
+        case TimestampUnit::MS: return JSIConverter<std::string>::toJSI(runtime, "ms");
+        case TimestampUnit::US: return JSIConverter<std::string>::toJSI(runtime, "us");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert TimestampUnit to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("s"):
+        case hashString("ms"):
+        case hashString("us"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
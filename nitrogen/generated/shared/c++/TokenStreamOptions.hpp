@@ -0,0 +1,82 @@
+///
+/// TokenStreamOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (TokenStreamOptions).
+   */
+  struct TokenStreamOptions {
+  public:
+    std::optional<std::string> eventType     SWIFT_PRIVATE;
+    std::optional<std::string> field     SWIFT_PRIVATE;
+    std::optional<double> intervalMs     SWIFT_PRIVATE;
+    std::optional<std::string> doneSentinel     SWIFT_PRIVATE;
+
+  public:
+    TokenStreamOptions() = default;
+    explicit TokenStreamOptions(std::optional<std::string> eventType, std::optional<std::string> field, std::optional<double> intervalMs, std::optional<std::string> doneSentinel): eventType(eventType), field(field), intervalMs(intervalMs), doneSentinel(doneSentinel) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ TokenStreamOptions <> JS TokenStreamOptions (object)
+  template <>
+  struct JSIConverter<TokenStreamOptions> final {
+    static inline TokenStreamOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return TokenStreamOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "eventType")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "field")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "intervalMs")),
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "doneSentinel"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const TokenStreamOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "eventType", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.eventType));
+      obj.setProperty(runtime, "field", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.field));
+      obj.setProperty(runtime, "intervalMs", JSIConverter<std::optional<double>>::toJSI(runtime, arg.intervalMs));
+      obj.setProperty(runtime, "doneSentinel", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.doneSentinel));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "eventType"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "field"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "intervalMs"))) return false;
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "doneSentinel"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
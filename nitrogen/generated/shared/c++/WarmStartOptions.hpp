@@ -0,0 +1,74 @@
+///
+/// WarmStartOptions.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © 2025 Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <optional>
+
+namespace margelo::nitro::nitroeventsource {
+
+  /**
+   * A struct which can be represented as a JavaScript object (WarmStartOptions).
+   */
+  struct WarmStartOptions {
+  public:
+    std::optional<std::string> key     SWIFT_PRIVATE;
+    std::optional<double> maxEventBytes     SWIFT_PRIVATE;
+
+  public:
+    WarmStartOptions() = default;
+    explicit WarmStartOptions(std::optional<std::string> key, std::optional<double> maxEventBytes): key(key), maxEventBytes(maxEventBytes) {}
+  };
+
+} // namespace margelo::nitro::nitroeventsource
+
+namespace margelo::nitro {
+
+  using namespace margelo::nitro::nitroeventsource;
+
+  // C++ WarmStartOptions <> JS WarmStartOptions (object)
+  template <>
+  struct JSIConverter<WarmStartOptions> final {
+    static inline WarmStartOptions fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return WarmStartOptions(
+        JSIConverter<std::optional<std::string>>::fromJSI(runtime, obj.getProperty(runtime, "key")),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, "maxEventBytes"))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const WarmStartOptions& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, "key", JSIConverter<std::optional<std::string>>::toJSI(runtime, arg.key));
+      obj.setProperty(runtime, "maxEventBytes", JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEventBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!JSIConverter<std::optional<std::string>>::canConvert(runtime, obj.getProperty(runtime, "key"))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, "maxEventBytes"))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
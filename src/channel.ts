@@ -0,0 +1,183 @@
+import { ErrorEventImpl, MessageEventImpl, OpenEventImpl } from './events';
+import type { SharedStream, StreamConsumer } from './stream-registry';
+import type { ColumnBatch, ErrorEvent, MessageEvent, NitroEventSourceEvent, OpenEvent } from './types';
+import { EventSourceReadyState } from './types';
+
+/**
+ * One logical stream multiplexed over a connection, see `EventSource.channel()`.
+ * Events typed `<name>` arrive as `message`, events typed `<name><delimiter><type>`
+ * as `<type>`; open and error follow the connection. Opening and closing channels
+ * only changes what native lets through, the connection itself is left alone.
+ */
+export class EventSourceChannel implements StreamConsumer {
+    readonly CONNECTING = 0;
+    readonly OPEN = 1;
+    readonly CLOSED = 2;
+
+    readonly url: string;
+    readonly name: string;
+    // Closed by this wrapper; otherwise readyState is the connection's, tracked natively
+    private closed = false;
+    private readonly prefix: string;
+    private readonly listeners = new Map<string, Set<(event: NitroEventSourceEvent) => void>>();
+
+    onmessage: (event: MessageEvent) => void;
+    onerror: (event: ErrorEvent) => void;
+    onopen: (event: OpenEvent) => void;
+
+    /** @internal Use `EventSource.channel()` */
+    constructor(private readonly stream: SharedStream, url: string, name: string, delimiter: string, private readonly onClose: () => void) {
+        this.url = url;
+        this.name = name;
+        this.prefix = name + delimiter;
+
+        this.onmessage = () => { };
+        this.onerror = () => { };
+        this.onopen = () => { };
+
+        stream.attach(this);
+        stream.updateTypeFilter();
+
+        // Like an EventSource joining a shared connection, see there
+        if (stream.isOpen) {
+            const id = stream.lastOpenEventId;
+            queueMicrotask(() => this.deliver({ id, type: 'open', data: '' }));
+        }
+    }
+
+    get readyState(): EventSourceReadyState {
+        return this.closed ? EventSourceReadyState.CLOSED : this.stream.native.readyState as EventSourceReadyState;
+    }
+
+    /** @internal */
+    deliver(event: NitroEventSourceEvent) {
+        if (this.closed) {
+            return;
+        }
+
+        switch (event.type) {
+            case 'open':
+                this.onopen(new OpenEventImpl(event, this as any));
+                return;
+            case 'error':
+                this.onerror(new ErrorEventImpl(event, this as any));
+                return;
+        }
+
+        const type = this.localType(event.type);
+        if (type === undefined) {
+            return;
+        }
+        const local = retype(event, type);
+        if (type === 'message') {
+            this.onmessage(new MessageEventImpl(local, this as any));
+        }
+        this.dispatchToListeners(local);
+    }
+
+    /** @internal rawMode chunks carry no type, so they stay with the EventSource */
+    deliverData(_chunk: ArrayBuffer) { }
+
+    /** @internal `schemas` rows are decoded for the whole stream, so they stay with the EventSource too */
+    deliverColumns(_batch: ColumnBatch) { }
+
+    /** @internal */
+    listenedTypes(): Iterable<string> {
+        if (this.closed) {
+            return [];
+        }
+        const types = [this.name];
+        for (const type of this.listeners.keys()) {
+            if (type !== 'message') {
+                types.push(this.prefix + type);
+            }
+        }
+        return types;
+    }
+
+    addEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void {
+        let listeners = this.listeners.get(type);
+        if (!listeners) {
+            listeners = new Set();
+            this.listeners.set(type, listeners);
+        }
+        if (!listeners.has(listener)) {
+            listeners.add(listener);
+            if (listeners.size === 1) {
+                this.stream.updateTypeFilter();
+            }
+
+            const cached = this.stream.native.getWarmEvent(type === 'message' ? this.name : this.prefix + type);
+            if (cached) {
+                try {
+                    listener(retype(cached, type));
+                } catch (error) {
+                    console.error(`EventSource channel ${this.name} listener [${type}] threw:`, error);
+                }
+            }
+        }
+    }
+
+    removeEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void {
+        const listeners = this.listeners.get(type);
+        if (listeners?.delete(listener) && listeners.size === 0) {
+            this.listeners.delete(type);
+            this.stream.updateTypeFilter();
+        }
+    }
+
+    /** Stops this channel; the connection stays open for its EventSource and other channels */
+    close() {
+        if (this.closed) {
+            return;
+        }
+        this.closed = true;
+        this.listeners.clear();
+        this.onmessage = () => { };
+        this.onerror = () => { };
+        this.onopen = () => { };
+
+        this.onClose();
+        // The owning EventSource is still attached, so this is never the last consumer
+        this.stream.detach(this);
+        this.stream.updateTypeFilter();
+    }
+
+    private localType(type: string): string | undefined {
+        if (type === this.name) {
+            return 'message';
+        }
+        return type.startsWith(this.prefix) && type.length > this.prefix.length ? type.slice(this.prefix.length) : undefined;
+    }
+
+    private dispatchToListeners(event: NitroEventSourceEvent) {
+        const listeners = this.listeners.get(event.type);
+        if (!listeners) {
+            return;
+        }
+
+        for (const listener of Array.from(listeners)) {
+            if (this.closed) {
+                break;
+            }
+            try {
+                listener(event);
+            } catch (error) {
+                console.error(`EventSource channel ${this.name} listener [${event.type}] threw:`, error);
+            }
+        }
+    }
+}
+
+// Native events may be lazy host objects, so read through rather than copy
+function retype(event: NitroEventSourceEvent, type: string): NitroEventSourceEvent {
+    const source = event as NitroEventSourceEvent & { json?: unknown };
+    return {
+        type,
+        get id() { return source.id; },
+        get data() { return source.data; },
+        get json() { return source.json; },
+        get chunk() { return source.chunk; },
+        get paths() { return source.paths; },
+    } as NitroEventSourceEvent;
+}
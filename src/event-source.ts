@@ -1,74 +1,258 @@
 import { NitroModules } from 'react-native-nitro-modules';
+import type { BoxedHybridObject } from 'react-native-nitro-modules';
+import { EventSourceChannel } from './channel';
+import { PackedEventBatch } from './packed-events';
 import { ErrorEventImpl, MessageEventImpl, OpenEventImpl } from './events';
 import type { NitroEventSource as NitroEventSourceSpec } from './specs/nitro-event-source.nitro';
-import type { ErrorEvent, MessageEvent, NitroEventSourceEvent, NitroEventSourceOptions, OpenEvent } from './types';
+import { NitroEventSource, SharedStream, watchAppState, watchStreamMetrics } from './stream-registry';
+import type { StreamConsumer } from './stream-registry';
+import type { ColumnBatch, ErrorEvent, EventSourceMetrics, MessageEvent, MetricsReportOptions, NitroEventSourceEvent, NitroEventSourceOptions, OpenEvent, PayloadFilter, StreamMetricsSample } from './types';
 import { EventSourceReadyState } from './types';
 
-const NitroEventSource =
-    NitroModules.createHybridObject<NitroEventSourceSpec>('NitroEventSource')
+const EMPTY_PACKED = new PackedEventBatch({ count: 0, bytes: new ArrayBuffer(0), index: new ArrayBuffer(0), types: [], details: [] });
 
-class EventSource {
+// listenerBudget defaults, and the slow calls after which coalesceSlow applies
+const DEFAULT_LISTENER_BUDGET_MS = 8;
+const DEFAULT_COALESCE_MS = 100;
+const SLOW_CALLS_BEFORE_COALESCING = 3;
+
+interface SlowListener {
+    slowCalls: number;
+    coalesced: boolean;
+    // coalesceSlow: the latest event waiting for the timer, and the timer
+    pending?: NitroEventSourceEvent;
+    timer?: ReturnType<typeof setTimeout>;
+}
+
+class EventSource implements StreamConsumer {
     readonly CONNECTING = 0;
     readonly OPEN = 1;
     readonly CLOSED = 2;
 
     readonly url: string;
     readonly withCredentials: boolean;
-    private _readyState: EventSourceReadyState;
+    private readonly pull: boolean;
+    // lazyStart: false until the first listener or open() starts the connection
+    private started: boolean;
+    private messageHandler: (event: MessageEvent) => void = () => { };
+    // Closed by this wrapper; otherwise readyState is the connection's, tracked natively
+    private closed = false;
     private nativeEventSource: NitroEventSourceSpec;
+    private readonly stream: SharedStream;
+    // Typed listeners live in JS so a whole drain costs one native call
+    private readonly listeners = new Map<string, Set<(event: NitroEventSourceEvent) => void>>();
+    // recentEvents: per type, the last sequence each replayed listener already received
+    private readonly replayedUpTo = new Map<string, Map<(event: NitroEventSourceEvent) => void, number>>();
+    // listenerBudget: unset when listener calls are not timed; coalesceMs only with coalesceSlow
+    private readonly listenerBudget?: { budgetMs: number; coalesceMs?: number };
+    // listenerBudget: per type, the listeners that went over budget at least once
+    private readonly slowListeners = new Map<string, Map<(event: NitroEventSourceEvent) => void, SlowListener>>();
+    private readonly channels = new Set<EventSourceChannel>();
+
+    /** Assigning it starts a `lazyStart` stream, like addEventListener() */
+    get onmessage(): (event: MessageEvent) => void {
+        return this.messageHandler;
+    }
+
+    set onmessage(handler: (event: MessageEvent) => void) {
+        this.messageHandler = handler;
+        this.open();
+    }
 
-    onmessage: (event: MessageEvent) => void;
     onerror: (event: ErrorEvent) => void;
     onopen: (event: OpenEvent) => void;
+    /** rawMode only: receives the response bytes as they arrive without SSE framing, or one message each with `rawFraming` */
+    ondata: (chunk: ArrayBuffer) => void;
+    /** schemas only: receives the rows of a schema type decoded since the last drain, one batch per type */
+    oncolumns: (batch: ColumnBatch) => void;
+
+    /**
+     * Opens a connection to the origin of `url` ahead of time, e.g. at launch, so the
+     * first stream skips DNS, TCP and TLS. The pooled connection idles out after about two minutes.
+     */
+    static preconnect(url: string): void {
+        NitroEventSource.preconnect(url);
+    }
+
+    /**
+     * Initializes libcurl and TLS and starts the network thread in the background, e.g. at
+     * launch, so the first stream does not pay for it. Calling it again does nothing.
+     */
+    static warmUp(): void {
+        NitroEventSource.warmUp();
+    }
+
+    /**
+     * Caps the connections all streams together keep open, in total (default 32) and to one
+     * host (default 6). Streams beyond a cap wait, connecting once another closes; HTTP/2
+     * streams to one origin share a connection and count once. 0 lifts a cap.
+     */
+    static setConnectionLimits(maxConnections: number, maxConnectionsPerHost: number): void {
+        NitroEventSource.setConnectionLimits(maxConnections, maxConnectionsPerHost);
+    }
+
+    /**
+     * Caps the bytes all streams together hold natively on their way to JS: queued events and
+     * parser buffers. Over the cap, streams with events waiting stop queueing more and stop
+     * pooling buffers until JS drains; their `backpressure.overflow` policy applies, so by
+     * default they pause reading the socket, and `drop-oldest` keeps only the latest event.
+     * Unlimited by default, 0 lifts the cap.
+     */
+    static setMemoryBudget(maxBufferedBytes: number): void {
+        NitroEventSource.setMemoryBudget(maxBufferedBytes);
+    }
+
+    /**
+     * Seeds the cookie jar every `withCredentials` stream shares with Set-Cookie header values,
+     * as if `url` had sent them, e.g. the platform store's cookies for it at launch or after
+     * login. A cookie without `Domain` is for the host of `url`. The jar lives in memory only.
+     */
+    static setCookies(url: string, cookies: string[]): void {
+        NitroEventSource.setCookies(url, cookies);
+    }
+
+    /**
+     * The shared cookie jar, one Netscape cookie-file line per cookie (domain, subdomains,
+     * path, secure, expiry, name and value, tab-separated), including cookies the streams'
+     * responses set, to write back into the platform store.
+     */
+    static getCookies(): string[] {
+        return NitroEventSource.getCookies();
+    }
+
+    /** Empties the shared cookie jar, e.g. on logout */
+    static clearCookies(): void {
+        NitroEventSource.clearCookies();
+    }
+
+    /**
+     * Closes every stream at once, e.g. on logout: all of them are marked closed together and
+     * torn down in one pass on the network thread. Resolves once every connection is gone.
+     * Streams from `createForRuntime()` close too; their runtimes are not told.
+     */
+    static closeAll(): Promise<void> {
+        const closed = NitroEventSource.closeAll();
+        SharedStream.closeAllConsumers();
+        return closed;
+    }
+
+    /**
+     * Calls `watcher` with a sample of every open stream each `intervalMs` (default 1000, at
+     * least 250), read natively off the network thread; `MetricsHud` shows them. Returns the
+     * function that stops it. Watchers in one runtime share a sampler running at the shortest
+     * interval any of them asked for.
+     */
+    static watchMetrics(watcher: (samples: StreamMetricsSample[]) => void, intervalMs = 1000): () => void {
+        return watchStreamMetrics(watcher, intervalMs);
+    }
+
+    /**
+     * Has the network thread append every open stream's metrics, histograms with their buckets,
+     * to a file as one JSON line per interval, for a native telemetry SDK to upload; nothing runs
+     * in JS once set. Native code can take the same reports in memory through
+     * `MetricsReporter::shared().set_sink()`. `undefined` stops writing the file.
+     */
+    static setMetricsReport(options?: MetricsReportOptions): void {
+        NitroEventSource.setMetricsReport(options);
+    }
+
+    /**
+     * Opens a stream to be consumed on another JS runtime, e.g. a worklet runtime, so parsing
+     * results into JS objects and handling them never touches the main JS thread. Unbox it on
+     * that runtime and drive the native object there:
+     *
+     *     const stream = boxed.unbox()
+     *     stream.setDrainCallback(() => handle(stream.drainEvents()))
+     *
+     * Callbacks run on the runtime that set them, which needs a Nitro dispatcher (the worklet
+     * libraries install one). The stream serves that runtime alone: it is not shared with
+     * EventSources, and it stays open until that runtime calls `close()`.
+     */
+    static createForRuntime(url: string, options?: NitroEventSourceOptions): BoxedHybridObject<NitroEventSourceSpec> {
+        if (options?.background) {
+            watchAppState();
+        }
+        return NitroModules.box(NitroEventSource.create(url, options));
+    }
 
     constructor(url: string, options?: NitroEventSourceOptions) {
         console.log('🔧 EventSource constructor: calling .create() for url:', url);
-        this.nativeEventSource = NitroEventSource.create(url, options);
+        this.stream = SharedStream.acquire(url, options);
+        this.nativeEventSource = this.stream.native;
         this.url = url;
         this.withCredentials = options?.withCredentials ?? false;
-        this._readyState = EventSourceReadyState.CONNECTING;
+        this.pull = options?.pull ?? false;
+        this.started = options?.lazyStart === undefined;
+        const budget = options?.listenerBudget;
+        if (budget) {
+            this.listenerBudget = {
+                budgetMs: budget.budgetMs ?? DEFAULT_LISTENER_BUDGET_MS,
+                coalesceMs: budget.coalesceSlow ? budget.coalesceMs ?? DEFAULT_COALESCE_MS : undefined,
+            };
+        }
 
-        this.onmessage = () => { };
         this.onerror = () => { };
         this.onopen = () => { };
+        this.ondata = () => { };
+        this.oncolumns = () => { };
 
-        this.setupEventHandling();
+        this.stream.attach(this);
+        this.updateTypeFilter();
+
+        // Joined a connection that is already open: its `open` already went out,
+        // so replay one once the caller has had a chance to assign `onopen`
+        if (this.stream.isOpen) {
+            const id = this.stream.lastOpenEventId;
+            queueMicrotask(() => this.deliver({ id, type: 'open', data: '' }));
+        }
     }
 
     get readyState(): EventSourceReadyState {
-        return this._readyState;
+        return this.closed ? EventSourceReadyState.CLOSED : this.nativeEventSource.readyState as EventSourceReadyState;
     }
 
 
-    private setupEventHandling() {
-        // 1. Create a callback function that handles events
-        const eventCallback = (event: NitroEventSourceEvent) => {
-            this.dispatchEvent(event);
-        };
+    /** @internal Called by the shared stream for every drained event */
+    deliver(event: NitroEventSourceEvent) {
+        if (this.closed) {
+            return;
+        }
+        this.dispatchEvent(event);
+        this.dispatchToListeners(event);
+    }
 
-        // 2. Set the callback on the native object
-        this.nativeEventSource.setEventCallback(eventCallback);
+    /** @internal Called by the shared stream for every rawMode chunk */
+    deliverData(chunk: ArrayBuffer) {
+        if (!this.closed) {
+            this.ondata(chunk);
+        }
     }
 
+    /** @internal Called by the shared stream for every batch of `schemas` rows */
+    deliverColumns(batch: ColumnBatch) {
+        if (!this.closed) {
+            this.oncolumns(batch);
+        }
+    }
+
+    /** @internal */
+    listenedTypes(): Iterable<string> {
+        return this.listeners.keys();
+    }
 
     dispatchEvent(event: NitroEventSourceEvent) {
         let eventObject: any;
 
         switch (event.type) {
             case 'message':
-                if (this._readyState !== EventSourceReadyState.OPEN) {
-                    this._readyState = EventSourceReadyState.OPEN;
-                }
                 eventObject = new MessageEventImpl(event, this as any);
                 this.onmessage(eventObject);
                 break;
             case 'error':
-                this._readyState = EventSourceReadyState.CONNECTING; // Will retry
                 eventObject = new ErrorEventImpl(event, this as any);
                 this.onerror(eventObject);
                 break;
             case 'open':
-                this._readyState = EventSourceReadyState.OPEN;
                 eventObject = new OpenEventImpl(event, this as any);
                 this.onopen(eventObject);
                 break;
@@ -84,26 +268,399 @@ class EventSource {
         }
     }
 
-    addEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void {
-        this.nativeEventSource.addEventListener(type, listener);
+    private dispatchToListeners(event: NitroEventSourceEvent) {
+        const listeners = this.listeners.get(event.type);
+        if (!listeners) {
+            return;
+        }
+
+        const replayed = this.replayedUpTo.get(event.type);
+        const slowListeners = this.slowListeners.get(event.type);
+        for (const listener of Array.from(listeners)) {
+            if (this.closed) {
+                break;
+            }
+            // Replayed events could still be queued when the listener was added, they only go out once
+            const upTo = replayed?.get(listener);
+            if (upTo !== undefined && event.sequence !== undefined) {
+                if (event.sequence <= upTo) {
+                    continue;
+                }
+                this.forgetReplay(event.type, listener);
+            }
+            const slow = slowListeners?.get(listener);
+            if (slow?.coalesced) {
+                this.deliverCoalesced(event.type, listener, slow, event);
+                continue;
+            }
+            this.callListener(event.type, listener, event);
+        }
+    }
+
+    private callListener(type: string, listener: (event: NitroEventSourceEvent) => void, event: NitroEventSourceEvent) {
+        const started = this.listenerBudget ? performance.now() : 0;
+        try {
+            listener(event);
+        } catch (error) {
+            console.error(`EventSource listener [${type}] threw:`, error);
+        }
+        if (this.listenerBudget) {
+            const elapsedMs = performance.now() - started;
+            if (elapsedMs > this.listenerBudget.budgetMs) {
+                this.recordSlowCall(type, listener, elapsedMs);
+            }
+        }
+    }
+
+    private recordSlowCall(type: string, listener: (event: NitroEventSourceEvent) => void, elapsedMs: number) {
+        const { budgetMs, coalesceMs } = this.listenerBudget!;
+        const name = listener.name || 'anonymous';
+        this.nativeEventSource.reportSlowListener(type, name, elapsedMs);
+
+        let listeners = this.slowListeners.get(type);
+        if (!listeners) {
+            listeners = new Map();
+            this.slowListeners.set(type, listeners);
+        }
+        let slow = listeners.get(listener);
+        if (!slow) {
+            console.warn(`EventSource listener [${type}] ${name} took ${elapsedMs.toFixed(1)} ms, over its ${budgetMs} ms budget`);
+            slow = { slowCalls: 0, coalesced: false };
+            listeners.set(listener, slow);
+        }
+        slow.slowCalls += 1;
+        if (coalesceMs !== undefined && !slow.coalesced && slow.slowCalls >= SLOW_CALLS_BEFORE_COALESCING) {
+            slow.coalesced = true;
+            console.warn(`EventSource listener [${type}] ${name} now receives only the latest event every ${coalesceMs} ms`);
+        }
+    }
+
+    // coalesceSlow: the listener gets the latest event once the timer fires, not every event
+    private deliverCoalesced(type: string, listener: (event: NitroEventSourceEvent) => void, slow: SlowListener, event: NitroEventSourceEvent) {
+        slow.pending = event;
+        if (slow.timer !== undefined) {
+            return;
+        }
+        slow.timer = setTimeout(() => {
+            slow.timer = undefined;
+            const pending = slow.pending;
+            slow.pending = undefined;
+            if (pending && !this.closed) {
+                this.callListener(type, listener, pending);
+            }
+        }, this.listenerBudget!.coalesceMs);
+    }
+
+    private forgetSlowListener(type: string, listener: (event: NitroEventSourceEvent) => void) {
+        const listeners = this.slowListeners.get(type);
+        const slow = listeners?.get(listener);
+        if (!slow) {
+            return;
+        }
+        clearTimeout(slow.timer);
+        listeners!.delete(listener);
+        if (listeners!.size === 0) {
+            this.slowListeners.delete(type);
+        }
+    }
+
+    /**
+     * lazyStart: starts connecting. The first listener, `onmessage` assignment, channel, drain
+     * or iteration does so as well, so this is for streams only read through `onopen`, `ondata`
+     * and the like. Does nothing once started or without lazyStart.
+     */
+    open(): void {
+        if (this.started || this.closed) {
+            return;
+        }
+        this.started = true;
+        this.nativeEventSource.start();
+    }
+
+    /**
+     * With `replay`, the listener first receives the events of `type` kept by `recentEvents`,
+     * oldest first, e.g. for a screen mounted after the stream started; it then receives only
+     * the events after them.
+     */
+    addEventListener(type: string, listener: (event: NitroEventSourceEvent) => void, options?: { replay?: boolean }): void {
+        this.open();
+        let listeners = this.listeners.get(type);
+        if (!listeners) {
+            listeners = new Set();
+            this.listeners.set(type, listeners);
+        }
+        if (!listeners.has(listener)) {
+            listeners.add(listener);
+            if (listeners.size === 1) {
+                this.updateTypeFilter();
+            }
+
+            if (options?.replay && this.replayRecent(type, listener)) {
+                return;
+            }
+            // warmStart: the last event of this type, possibly from the previous session
+            const cached = this.nativeEventSource.getWarmEvent(type);
+            if (cached) {
+                this.callListener(type, listener, cached);
+            }
+        }
+    }
+
+    private replayRecent(type: string, listener: (event: NitroEventSourceEvent) => void): boolean {
+        const events = this.nativeEventSource.getRecentEvents(type);
+        let upTo: number | undefined;
+        for (const event of events) {
+            if (this.closed) {
+                break;
+            }
+            if (event.sequence !== undefined) {
+                upTo = Math.max(upTo ?? event.sequence, event.sequence);
+            }
+            this.callListener(type, listener, event);
+        }
+        if (upTo !== undefined) {
+            let replayed = this.replayedUpTo.get(type);
+            if (!replayed) {
+                replayed = new Map();
+                this.replayedUpTo.set(type, replayed);
+            }
+            replayed.set(listener, upTo);
+        }
+        return events.length > 0;
+    }
+
+    private forgetReplay(type: string, listener: (event: NitroEventSourceEvent) => void) {
+        const replayed = this.replayedUpTo.get(type);
+        if (replayed?.delete(listener) && replayed.size === 0) {
+            this.replayedUpTo.delete(type);
+        }
     }
 
     removeEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void {
-        this.nativeEventSource.removeEventListener(type, listener);
+        this.forgetReplay(type, listener);
+        this.forgetSlowListener(type, listener);
+        const listeners = this.listeners.get(type);
+        if (listeners?.delete(listener) && listeners.size === 0) {
+            this.listeners.delete(type);
+            this.updateTypeFilter();
+        }
+    }
+
+    private updateTypeFilter() {
+        this.stream.updateTypeFilter(this);
+    }
+
+    /**
+     * Marks this EventSource inactive, e.g. for a list row that scrolled off screen: nothing is
+     * delivered to it, and only the latest event of each type is kept, which it receives once
+     * active again. `onopen` and `onerror` still fire, so a stream that ends while inactive
+     * closes. Other EventSources sharing the connection are not affected.
+     */
+    setActive(active: boolean): void {
+        if (!this.closed) {
+            this.stream.setActive(this, active);
+        }
+    }
+
+    /**
+     * A logical stream carried by this connection: events typed `name` arrive as
+     * `message`, events typed `name:type` as `type`. Channels can be opened and
+     * closed at any time without reconnecting and close with their EventSource.
+     */
+    channel(name: string, delimiter = ':'): EventSourceChannel {
+        const channel = this.openChannel(this.url, name, delimiter);
+        this.open();
+        return channel;
+    }
+
+    /**
+     * @internal A channel that reports `url` as its own and leaves starting the connection to
+     * the caller, for EventSourceGateway; `onClose` runs once it closes
+     */
+    openChannel(url: string, name: string, delimiter: string, onClose?: () => void): EventSourceChannel {
+        const channel = new EventSourceChannel(this.stream, url, name, delimiter, () => {
+            this.channels.delete(channel);
+            onClose?.();
+        });
+        if (this.closed) {
+            channel.close();
+        } else {
+            this.channels.add(channel);
+        }
+        return channel;
+    }
+
+    /**
+     * Drops events natively unless they match every filter, so unwanted payloads
+     * are never parsed or copied on the JS thread. Pass `[]` to deliver everything.
+     * The filters apply to the connection, i.e. to every EventSource sharing it.
+     */
+    setPayloadFilters(filters: PayloadFilter[]): void {
+        this.nativeEventSource.setPayloadFilters(filters);
+    }
+
+    /**
+     * pull: takes the events queued since the last call, oldest first and at most `maxEvents`
+     * of them; the rest wait for the next call. Nothing goes to `onmessage` or listeners.
+     * A stream opened without `pull` delivers its events itself and returns none here.
+     */
+    drain(maxEvents?: number): NitroEventSourceEvent[] {
+        this.open();
+        return this.closed || !this.pull ? [] : this.stream.take(maxEvents);
+    }
+
+    /**
+     * pull: drain() for high-rate streams, the events' ids and data in one native buffer that
+     * crosses into JS whole instead of as three strings per event; read them through the
+     * batch, which decodes only what is asked for. Parse `data` yourself, `json` is not set.
+     */
+    drainPacked(maxEvents?: number): PackedEventBatch {
+        this.open();
+        return this.closed || !this.pull ? EMPTY_PACKED : this.stream.takePacked(maxEvents);
+    }
+
+    /**
+     * pull with `schemas`: takes the rows decoded since the last call, one batch per type.
+     * Rows wake `batches()` and the async iterator like events do, so drain both there.
+     */
+    drainColumns(): ColumnBatch[] {
+        this.open();
+        return this.closed || !this.pull ? [] : this.stream.takeColumns();
+    }
+
+    /**
+     * pull: every event as it arrives, straight from the native queue:
+     *
+     *     for await (const event of eventSource) { ... }
+     *
+     * Ends once the EventSource closes. Events pending together are taken in one native call.
+     * A stream opened without `pull` delivers its events itself and yields none here.
+     */
+    async *[Symbol.asyncIterator](): AsyncGenerator<NitroEventSourceEvent, void, undefined> {
+        for await (const events of this.batches()) {
+            yield* events;
+        }
+    }
+
+    /** pull: like iterating the EventSource, but yields all events pending at once, at most `maxEvents` */
+    async *batches(maxEvents?: number): AsyncGenerator<NitroEventSourceEvent[], void, undefined> {
+        if (!this.pull) {
+            return;
+        }
+        this.open();
+        this.stream.watchQueue();
+        while (!this.closed) {
+            const events = this.stream.take(maxEvents);
+            if (events.length > 0) {
+                yield events;
+            } else {
+                await this.stream.waitForEvents();
+            }
+        }
+    }
+
+    /**
+     * Replaces the `headers` sent from the next attempt on, e.g. a refreshed bearer token.
+     * The open connection, parser state and metrics are kept. Applies to the connection,
+     * i.e. to every EventSource sharing it
+     */
+    updateHeaders(headers: Record<string, string>): void {
+        this.nativeEventSource.updateHeaders(headers);
+    }
+
+    /**
+     * Runs on a 401 instead of closing the stream, once until it opens again: resolve with
+     * the headers to retry with and it reconnects at once, without a backoff. Rejecting
+     * closes this EventSource
+     */
+    setUnauthorizedHandler(handler: () => Record<string, string> | Promise<Record<string, string>>): void {
+        this.nativeEventSource.setUnauthorizedCallback(() => {
+            Promise.resolve()
+                .then(handler)
+                .then(
+                    (headers) => this.nativeEventSource.updateHeaders(headers),
+                    (error) => {
+                        console.error('EventSource unauthorized handler failed:', error);
+                        this.close();
+                    }
+                );
+        });
+    }
+
+    /**
+     * messageSchema: the fields of a protobuf message from `ondata`, read from native memory
+     * one at a time as they are accessed, without copying the message or decoding it up front
+     */
+    decodeMessage<T = Record<string, unknown>>(message: ArrayBuffer): T {
+        return this.nativeEventSource.decodeMessage(message) as T;
+    }
+
+    /** Native counters for tuning a long-running stream */
+    getMetrics(): EventSourceMetrics {
+        return this.nativeEventSource.getMetrics();
+    }
+
+    /**
+     * Reads back the journal, see `journal`. Events are returned rather than dispatched;
+     * pass the id of the last event already handled to skip everything up to it.
+     */
+    replay(fromId = ''): NitroEventSourceEvent[] {
+        return this.nativeEventSource.replay(fromId);
+    }
+
+    /**
+     * Reads the stateSync document, or just the value at an RFC 6901 `pointer`.
+     * Only the requested part is serialized and parsed on the JS thread.
+     */
+    getState<T = unknown>(pointer = ''): T | undefined {
+        const text = this.nativeEventSource.getState(pointer);
+        return text === undefined ? undefined : JSON.parse(text) as T;
     }
 
     close() {
-        if (this._readyState === EventSourceReadyState.CLOSED) {
+        if (this.closed) {
             return;
         }
 
-        this._readyState = EventSourceReadyState.CLOSED;
+        this.markClosed();
+        if (this.stream.detach(this)) {
+            this.nativeEventSource.close();
+        }
+    }
+
+    /**
+     * Same as `close()`, but resolves once the native connection has been torn down.
+     */
+    closeAsync(): Promise<void> {
+        this.markClosed();
+        // Other EventSources still read from a shared connection
+        return this.stream.detach(this) ? this.nativeEventSource.closeAsync() : Promise.resolve();
+    }
+
+    private markClosed() {
+        // Before detaching, so the connection closes with the last of us
+        for (const channel of Array.from(this.channels)) {
+            channel.close();
+        }
+        this.closed = true;
+        this.listeners.clear();
+        this.replayedUpTo.clear();
+        for (const listeners of this.slowListeners.values()) {
+            for (const slow of listeners.values()) {
+                clearTimeout(slow.timer);
+            }
+        }
+        this.slowListeners.clear();
+        // Lets a waiting iterator see the close and finish
+        if (this.pull) {
+            this.stream.wake();
+        }
 
         this.onmessage = () => { };
         this.onerror = () => { };
         this.onopen = () => { };
-
-        this.nativeEventSource.close();
+        this.ondata = () => { };
+        this.oncolumns = () => { };
     }
 }
 
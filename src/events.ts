@@ -1,142 +1,85 @@
-import type { ErrorEvent, MessageEvent, NitroEventSourceEvent, OpenEvent } from './types';
-
-
-// Create a proper EventSource-compatible MessageEvent class
-export class MessageEventImpl implements MessageEvent {
-    readonly type: 'message' = 'message';
-    readonly data: string;
-    readonly origin: string;
-    readonly lastEventId: string;
-    readonly source: null = null;
-    readonly ports: never[] = [];
-
-    // Event properties
-    readonly isTrusted: boolean = true;
-    readonly bubbles: boolean = false;
-    readonly cancelable: boolean = false;
-    readonly composed: boolean = false;
-    readonly currentTarget: EventSource;
-    readonly srcElement: EventSource;
-    readonly target: EventSource;
-    readonly timeStamp: number;
-    readonly userActivation: null = null;
-
-    // Mutable event properties
-    private _cancelBubble: boolean = false;
-    private _defaultPrevented: boolean = false;
-    private _returnValue: boolean = true;
-    private _eventPhase: 0 | 2 = 0;
-
-
-
-    constructor(event: NitroEventSourceEvent, eventSource: EventSource) {
-        this.data = event.data;
-        this.origin = new URL(eventSource.url).origin;
-        this.lastEventId = event.id;
-        this.currentTarget = eventSource;
-        this.srcElement = eventSource;
-        this.target = eventSource;
-        this.timeStamp = performance.now();
-    }
-
-    get cancelBubble(): boolean { return this._cancelBubble; }
-    set cancelBubble(value: boolean) { this._cancelBubble = value; }
-
-    get defaultPrevented(): boolean { return this._defaultPrevented; }
-    get eventPhase(): 0 | 2 { return this._eventPhase; }
-    get returnValue(): boolean { return this._returnValue; }
-    set returnValue(value: boolean) { this._returnValue = value; }
-
-    preventDefault(): void {
-        if (this.cancelable) {
-            this._defaultPrevented = true;
-            this._returnValue = false;
-        }
-    }
-
-    stopPropagation(): void {
-        // For EventSource, this doesn't do much but matches the interface
-    }
-
-    stopImmediatePropagation(): void {
-        // For EventSource, this doesn't do much but matches the interface
+import type { ConnectionTiming, DataChunk, ErrorEvent, MessageEvent, NitroEventSourceEvent, OpenEvent, StreamError } from './types';
+
+const NO_PORTS: never[] = [];
+Object.freeze(NO_PORTS);
+
+// Parsing a URL per message shows up in profiles at high rates; streams only have a few URLs
+const origins = new Map<string, string>();
+function originOf(url: string): string {
+    let origin = origins.get(url);
+    if (origin === undefined) {
+        origin = new URL(url).origin;
+        origins.set(url, origin);
     }
+    return origin;
 }
 
+// performance.now() minus Date.now(), taken once: converts native arrival times to the
+// `timeStamp` timeline without a clock call per event
+const performanceOffset = performance.now() - Date.now();
 
-export class ErrorEventImpl implements ErrorEvent {
-    readonly type: 'error' = 'error';
-    readonly data: string;
-    readonly isTrusted: boolean = true;
-    readonly bubbles: boolean = false;
-    readonly cancelable: boolean = false;
-    readonly composed: boolean = false;
-    readonly defaultPrevented: boolean = false;
-    readonly eventPhase: 0 | 2 = 0;
-    readonly returnValue: boolean = true;
+/**
+ * What every event object shares. Only the native event, the target, the timestamp
+ * and `cancelBubble` live on the instance; the constant DOM properties are getters
+ * on the prototype, so an event costs one small allocation.
+ */
+abstract class StreamEvent {
     readonly target: EventSource;
-    readonly currentTarget: EventSource;
-    readonly srcElement: EventSource;
-    readonly lastEventId: string;
     readonly timeStamp: number;
-    private _cancelBubble: boolean = false;
+    // Kept as-is so lazy native payloads are only materialized when `data`/`json` is read
+    protected readonly _event: NitroEventSourceEvent & { json?: unknown };
+    private _cancelBubble = false;
 
     constructor(event: NitroEventSourceEvent, eventSource: EventSource) {
-        this.data = event.data;
+        this._event = event;
         this.target = eventSource;
-        this.lastEventId = event.id;
-        this.currentTarget = eventSource;
-        this.srcElement = eventSource;
-        this.timeStamp = performance.now();
+        // When the event arrived natively rather than when JS got to it
+        const receivedAt = event.receivedAt;
+        this.timeStamp = receivedAt === undefined ? performance.now() : receivedAt + performanceOffset;
     }
 
+    get data(): string { return this._event.data; }
+    get lastEventId(): string { return this._event.id; }
+    get currentTarget(): EventSource { return this.target; }
+    get srcElement(): EventSource { return this.target; }
+
+    get isTrusted(): boolean { return true; }
+    get bubbles(): boolean { return false; }
+    get cancelable(): boolean { return false; }
+    get composed(): boolean { return false; }
+    get defaultPrevented(): boolean { return false; }
+    get eventPhase(): 0 | 2 { return 0; }
+    get returnValue(): boolean { return true; }
+
     get cancelBubble(): boolean { return this._cancelBubble; }
     set cancelBubble(value: boolean) { this._cancelBubble = value; }
 
-    preventDefault(): void {
-        // Error events are typically not cancelable
-    }
-
+    // None of them is cancelable, and there is nothing to propagate to
+    preventDefault(): void { }
     stopPropagation(): void { }
-
     stopImmediatePropagation(): void { }
 }
 
-// Open Event implementation
-export class OpenEventImpl implements OpenEvent {
-    readonly type: 'open' = 'open';
-    readonly data: string;
-    readonly isTrusted: boolean = true;
-    readonly bubbles: boolean = false;
-    readonly cancelable: boolean = false;
-    readonly composed: boolean = false;
-    readonly defaultPrevented: boolean = false;
-    readonly eventPhase: 0 | 2 = 0;
-    readonly returnValue: boolean = true;
-    readonly target: EventSource;
-    readonly currentTarget: EventSource;
-    readonly srcElement: EventSource;
-    readonly lastEventId: string;
-    readonly timeStamp: number;
-    private _cancelBubble: boolean = false;
-
-    constructor(event: NitroEventSourceEvent, eventSource: EventSource) {
-        this.data = event.data;
-        this.lastEventId = event.id;
-        this.target = eventSource;
-        this.currentTarget = eventSource;
-        this.srcElement = eventSource;
-        this.timeStamp = performance.now();
-    }
-
-    get cancelBubble(): boolean { return this._cancelBubble; }
-    set cancelBubble(value: boolean) { this._cancelBubble = value; }
-
-    preventDefault(): void {
-        // Open events are typically not cancelable
-    }
+export class MessageEventImpl extends StreamEvent implements MessageEvent {
+    get type(): 'message' { return 'message'; }
+    get origin(): string { return originOf(this.target.url); }
+    get source(): null { return null; }
+    get ports(): never[] { return NO_PORTS; }
+    get userActivation(): null { return null; }
+
+    // Only present for parseJson streams, attached natively outside the generated struct
+    get json(): unknown { return this._event.json; }
+    get chunk(): DataChunk | undefined { return this._event.chunk; }
+    get paths(): string[] | undefined { return this._event.paths; }
+    get sequence(): number | undefined { return this._event.sequence; }
+}
 
-    stopPropagation(): void { }
+export class ErrorEventImpl extends StreamEvent implements ErrorEvent {
+    get type(): 'error' { return 'error'; }
+    get error(): StreamError | undefined { return this._event.error; }
+}
 
-    stopImmediatePropagation(): void { }
+export class OpenEventImpl extends StreamEvent implements OpenEvent {
+    get type(): 'open' { return 'open'; }
+    get timing(): ConnectionTiming | undefined { return this._event.timing; }
 }
@@ -0,0 +1,304 @@
+import { NitroEventSource } from './stream-registry';
+import type { NitroEventSourceEvent, NitroEventSourceOptions, ResponseHead } from './types';
+
+// React Native ships no web streams; these are the parts fetchStream() uses, of whichever
+// implementation the app installs (AI SDKs on React Native need one anyway)
+interface ByteStreamController {
+    enqueue(chunk: Uint8Array): void;
+    close(): void;
+    error(reason: unknown): void;
+}
+
+interface ByteStreamReader {
+    read(): Promise<{ done: boolean; value?: Uint8Array }>;
+    releaseLock(): void;
+}
+
+/** The `ReadableStream<Uint8Array>` a `fetchStream()` response body is */
+export interface ByteStream {
+    getReader(): ByteStreamReader;
+}
+
+type ByteStreamConstructor = new (
+    source: { pull(controller: ByteStreamController): Promise<void>; cancel(): void },
+    strategy: { highWaterMark: number },
+) => ByteStream;
+
+interface AbortSignalLike {
+    readonly aborted: boolean;
+    readonly reason?: unknown;
+    addEventListener(type: 'abort', listener: () => void): void;
+    removeEventListener(type: 'abort', listener: () => void): void;
+}
+
+type HeadersInit = Record<string, string> | [string, string][] | { forEach(callback: (value: string, name: string) => void): void };
+
+/** What `fetchStream()` takes of fetch's `RequestInit` */
+export interface FetchStreamInit {
+    method?: string;
+    headers?: HeadersInit;
+    body?: string | ArrayBuffer | ArrayBufferView | null;
+    signal?: AbortSignalLike | null;
+    /**
+     * Body bytes held natively before the socket stops being read, until the reader catches up
+     * (default 1 MiB); TCP flow control then slows the server down
+     */
+    highWaterMarkBytes?: number;
+    /** Native options for the request, e.g. `timeouts`, `tls`, `dns` or `priority` */
+    options?: Omit<NitroEventSourceOptions, 'fetchMode' | 'method' | 'headers' | 'body' | 'rawMode' | 'rawFraming' | 'backpressure' | 'pull'>;
+}
+
+/** The response head as `fetch` exposes it, names case-insensitive */
+export class FetchStreamHeaders {
+    constructor(private readonly headers: Record<string, string>) { }
+
+    get(name: string): string | null {
+        return this.headers[name.toLowerCase()] ?? null;
+    }
+
+    has(name: string): boolean {
+        return name.toLowerCase() in this.headers;
+    }
+
+    forEach(callback: (value: string, name: string) => void): void {
+        for (const [name, value] of this.entries()) {
+            callback(value, name);
+        }
+    }
+
+    entries(): IterableIterator<[string, string]> {
+        return new Map(Object.entries(this.headers).sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0))).entries();
+    }
+
+    [Symbol.iterator](): IterableIterator<[string, string]> {
+        return this.entries();
+    }
+}
+
+/** The subset of fetch's `Response` streaming AI SDKs read */
+export interface FetchStreamResponse {
+    readonly ok: boolean;
+    readonly status: number;
+    readonly statusText: string;
+    readonly url: string;
+    readonly headers: FetchStreamHeaders;
+    readonly body: ByteStream;
+    arrayBuffer(): Promise<ArrayBuffer>;
+    text(): Promise<string>;
+    json(): Promise<any>;
+}
+
+const DEFAULT_HIGH_WATER_MARK_BYTES = 1024 * 1024;
+
+function toHeaders(headers: HeadersInit | undefined): Record<string, string> | undefined {
+    if (!headers) {
+        return undefined;
+    }
+    const record: Record<string, string> = {};
+    if (Array.isArray(headers)) {
+        for (const [name, value] of headers) {
+            record[name] = value;
+        }
+    } else if (typeof headers.forEach === 'function') {
+        (headers as { forEach(callback: (value: string, name: string) => void): void }).forEach((value, name) => {
+            record[name] = value;
+        });
+    } else {
+        Object.assign(record, headers);
+    }
+    return record;
+}
+
+function toBody(body: FetchStreamInit['body']): string | ArrayBuffer | undefined {
+    if (body === null || body === undefined || typeof body === 'string' || body instanceof ArrayBuffer) {
+        return body ?? undefined;
+    }
+    return body.buffer.slice(body.byteOffset, body.byteOffset + body.byteLength) as ArrayBuffer;
+}
+
+function abortError(signal: AbortSignalLike): unknown {
+    return signal.reason ?? Object.assign(new Error('The operation was aborted'), { name: 'AbortError' });
+}
+
+async function readAll(body: ByteStream): Promise<Uint8Array> {
+    const reader = body.getReader();
+    const chunks: Uint8Array[] = [];
+    let length = 0;
+    for (let result = await reader.read(); !result.done; result = await reader.read()) {
+        chunks.push(result.value!);
+        length += result.value!.byteLength;
+    }
+    reader.releaseLock();
+    if (chunks.length === 1) {
+        return chunks[0]!;
+    }
+    const bytes = new Uint8Array(length);
+    let offset = 0;
+    for (const chunk of chunks) {
+        bytes.set(chunk, offset);
+        offset += chunk.byteLength;
+    }
+    return bytes;
+}
+
+/**
+ * `fetch` for streaming responses, e.g. to hand AI SDKs as their `fetch` option: the request
+ * runs on this library's native transport and `body` is a `ReadableStream<Uint8Array>` of
+ * native ArrayBuffers, whatever arrived since the last read crossing into JS as one chunk.
+ * Reading nothing holds the body natively up to `highWaterMarkBytes`, then stops reading the
+ * socket. Needs a global `ReadableStream`, and `TextDecoder` for `text()` and `json()`.
+ * Resolves once the response head arrived, for any status; rejects with a `TypeError` when
+ * no response did, as fetch does.
+ */
+export function fetchStream(input: string | { toString(): string }, init: FetchStreamInit = {}): Promise<FetchStreamResponse> {
+    const Stream = (globalThis as { ReadableStream?: ByteStreamConstructor }).ReadableStream;
+    if (!Stream) {
+        return Promise.reject(new TypeError('fetchStream() needs a global ReadableStream, e.g. from web-streams-polyfill'));
+    }
+    const signal = init.signal ?? undefined;
+    if (signal?.aborted) {
+        return Promise.reject(abortError(signal));
+    }
+
+    const url = String(input);
+    const native = NitroEventSource.create(url, {
+        ...init.options,
+        fetchMode: true,
+        method: init.method,
+        headers: toHeaders(init.headers),
+        body: toBody(init.body),
+        backpressure: { maxQueuedBytes: init.highWaterMarkBytes ?? DEFAULT_HIGH_WATER_MARK_BYTES, overflow: 'block' },
+    });
+
+    return new Promise((resolve, reject) => {
+        let responded = false;
+        let ended = false;
+        let failure: unknown;
+        let controller: ByteStreamController | undefined;
+        // A pending read, woken by the drain callback
+        let waiter: (() => void) | undefined;
+
+        const finish = () => {
+            signal?.removeEventListener('abort', onAbort);
+            native.close();
+        };
+
+        const respond = (head: ResponseHead) => {
+            responded = true;
+            let used = false;
+            const body = new Stream(
+                {
+                    async pull(streamController: ByteStreamController) {
+                        controller = streamController;
+                        for (;;) {
+                            take();
+                            // What arrived before a failure is still read, an abort closed the native side already
+                            const chunk = native.drainData();
+                            if (chunk) {
+                                streamController.enqueue(new Uint8Array(chunk));
+                                return;
+                            }
+                            if (ended) {
+                                finish();
+                                if (failure === undefined) {
+                                    streamController.close();
+                                } else {
+                                    streamController.error(failure);
+                                }
+                                return;
+                            }
+                            await new Promise<void>((wake) => {
+                                waiter = wake;
+                            });
+                        }
+                    },
+                    cancel() {
+                        ended = true;
+                        finish();
+                    },
+                },
+                // The bytes wait natively, where backpressure can pause the socket
+                { highWaterMark: 0 },
+            );
+            const consume = () => {
+                if (used) {
+                    return Promise.reject(new TypeError('Body has already been consumed'));
+                }
+                used = true;
+                return readAll(body);
+            };
+            const decode = async () => {
+                const Decoder = (globalThis as { TextDecoder?: new () => { decode(bytes: Uint8Array): string } }).TextDecoder;
+                if (!Decoder) {
+                    throw new TypeError('text() needs a global TextDecoder');
+                }
+                return new Decoder().decode(await consume());
+            };
+            resolve({
+                ok: head.status >= 200 && head.status < 300,
+                status: head.status,
+                statusText: '',
+                url,
+                headers: new FetchStreamHeaders(head.headers),
+                body,
+                arrayBuffer: async () => {
+                    const bytes = await consume();
+                    return bytes.buffer.slice(bytes.byteOffset, bytes.byteOffset + bytes.byteLength) as ArrayBuffer;
+                },
+                text: decode,
+                json: async () => JSON.parse(await decode()),
+            });
+        };
+
+        const fail = (error: unknown) => {
+            failure ??= error;
+            ended = true;
+            if (!responded) {
+                finish();
+                reject(failure);
+            }
+        };
+
+        // Connection state arrives as events: `open` with the first body bytes, a failed
+        // attempt as an `error` with details, and the end of the response as `closed`
+        const track = (event: NitroEventSourceEvent) => {
+            if (event.type === 'open' && !responded) {
+                const head = native.getResponseHead();
+                if (head) {
+                    respond(head);
+                }
+            } else if (event.type === 'error' && event.error) {
+                fail(new TypeError(event.error.message));
+            } else if (event.type === 'error' && event.data === 'closed') {
+                ended = true;
+                // A response without a body never opens
+                const head = responded ? undefined : native.getResponseHead();
+                if (head) {
+                    respond(head);
+                } else if (!responded) {
+                    fail(new TypeError('Network request failed'));
+                }
+            }
+        };
+        const take = () => {
+            for (const event of native.drainEvents()) {
+                track(event);
+            }
+        };
+
+        const onAbort = () => {
+            fail(abortError(signal!));
+            finish();
+            controller?.error(failure);
+            waiter?.();
+        };
+        signal?.addEventListener('abort', onAbort);
+
+        native.setDrainCallback(() => {
+            take();
+            const wake = waiter;
+            waiter = undefined;
+            wake?.();
+        });
+    });
+}
@@ -0,0 +1,158 @@
+import type { EventSourceChannel } from './channel';
+import EventSource from './event-source';
+import type { NitroEventSourceOptions } from './types';
+
+/** What `new EventSourceGateway()` takes besides the options of its connection */
+export interface GatewayOptions {
+    /** Native options for the connection to the gateway; `lazyStart` is implied */
+    options?: Omit<NitroEventSourceOptions, 'lazyStart' | 'shareConnection' | 'pull'>;
+    /** Where subscription changes are POSTed while connected (default the gateway URL) */
+    controlUrl?: string;
+}
+
+const CONNECTION_HEADER = 'Gateway-Connection';
+const SUBSCRIPTIONS_HEADER = 'Gateway-Subscriptions';
+
+interface Subscription {
+    id: string;
+    url: string;
+    // Open channels of this URL, it is unsubscribed with the last
+    channels: number;
+}
+
+/**
+ * Many upstream event streams over one connection to a gateway at the edge, each read
+ * through a channel of its own: `subscribe(url)` works like `new EventSource(url)`, but
+ * costs no connection of its own, and native lets through only the events of subscribed
+ * upstreams.
+ *
+ * The protocol, for the gateway to implement:
+ * - The request names the connection in `Gateway-Connection` and lists every subscription
+ *   as `Gateway-Subscriptions: s1=<url>, s2=<url>`, URLs percent-encoded; a reconnect sends
+ *   the current list.
+ * - Events of subscription `s1` are typed `s1` for upstream `message` events and
+ *   `s1:<type>` for the others, the framing of `EventSource.channel()`.
+ * - `id:` is the gateway's cursor over every subscription, resumed from the one
+ *   Last-Event-ID of a reconnect.
+ * - Changes while connected are POSTed to `controlUrl` as JSON, batched per task:
+ *   `{ "connection": "<id>", "subscribe": { "s3": "<url>" }, "unsubscribe": ["s1"] }`.
+ *   One that fails is logged; the next request's header lists the subscriptions anyway.
+ */
+export class EventSourceGateway {
+    readonly url: string;
+    private readonly connection: string;
+    private readonly controlUrl: string;
+    private readonly headers: Record<string, string>;
+    private readonly eventSource: EventSource;
+    private readonly subscriptions = new Map<string, Subscription>();
+    private nextId = 1;
+    private closed = false;
+    // Changes since the last sync, sent together once the current task is done
+    private subscribed = new Map<string, string>();
+    private unsubscribed = new Set<string>();
+    private syncQueued = false;
+    private started = false;
+
+    constructor(url: string, init?: GatewayOptions) {
+        this.url = url;
+        this.controlUrl = init?.controlUrl ?? url;
+        this.connection = `${Date.now().toString(36)}-${Math.random().toString(36).slice(2, 10)}`;
+        this.headers = { ...init?.options?.headers, [CONNECTION_HEADER]: this.connection };
+        // Started by the first subscription, so the first request already lists it
+        this.eventSource = new EventSource(url, { ...init?.options, headers: this.headers, lazyStart: {}, shareConnection: false });
+    }
+
+    /** The connection to the gateway, e.g. for `getMetrics()`; its events arrive on the channels */
+    get connectionSource(): EventSource {
+        return this.eventSource;
+    }
+
+    /**
+     * The events of the upstream stream at `url`, as a channel whose `url` is that URL.
+     * Subscribing to a URL again returns another channel of the same subscription; it is
+     * unsubscribed once all of them are closed. Channels close with the gateway.
+     */
+    subscribe(url: string): EventSourceChannel {
+        let subscription = this.subscriptions.get(url);
+        if (!subscription) {
+            subscription = { id: `s${(this.nextId++).toString(36)}`, url, channels: 0 };
+            // Closed: the channel closes at once, and the subscription is never sent
+            if (!this.closed) {
+                this.subscriptions.set(url, subscription);
+                this.subscribed.set(subscription.id, url);
+                this.queueSync();
+            }
+        }
+        subscription.channels += 1;
+        return this.eventSource.openChannel(url, subscription.id, ':', () => this.release(url));
+    }
+
+    /** Closes the connection and every channel */
+    close(): void {
+        if (this.closed) {
+            return;
+        }
+        this.closed = true;
+        this.subscriptions.clear();
+        this.subscribed.clear();
+        this.unsubscribed.clear();
+        this.eventSource.close();
+    }
+
+    private release(url: string) {
+        const subscription = this.subscriptions.get(url);
+        if (!subscription || --subscription.channels > 0) {
+            return;
+        }
+        this.subscriptions.delete(url);
+        if (!this.subscribed.delete(subscription.id)) {
+            this.unsubscribed.add(subscription.id);
+        }
+        this.queueSync();
+    }
+
+    private queueSync() {
+        if (this.syncQueued) {
+            return;
+        }
+        this.syncQueued = true;
+        // A screen subscribing to a dozen streams at once sends one header update and one POST
+        queueMicrotask(() => {
+            this.syncQueued = false;
+            this.sync();
+        });
+    }
+
+    private sync() {
+        // Still nothing to connect for
+        if (this.closed || (!this.started && this.subscriptions.size === 0)) {
+            return;
+        }
+        const list = Array.from(this.subscriptions.values(), ({ id, url }) => `${id}=${encodeURIComponent(url)}`).join(', ');
+        // Before starting, so the first request carries the first subscriptions
+        this.eventSource.updateHeaders({ ...this.headers, [SUBSCRIPTIONS_HEADER]: list });
+
+        const subscribe = Object.fromEntries(this.subscribed);
+        const unsubscribe = Array.from(this.unsubscribed);
+        this.subscribed = new Map();
+        this.unsubscribed = new Set();
+        if (!this.started) {
+            this.started = true;
+            this.eventSource.open();
+            return;
+        }
+        if (Object.keys(subscribe).length === 0 && unsubscribe.length === 0) {
+            return;
+        }
+        const body = JSON.stringify({ connection: this.connection, subscribe, unsubscribe });
+        fetch(this.controlUrl, { method: 'POST', headers: { ...this.headers, 'Content-Type': 'application/json' }, body })
+            .then((response) => {
+                if (!response.ok) {
+                    console.warn(`EventSourceGateway subscription update got HTTP ${response.status}, applies on reconnect`);
+                }
+            })
+            .catch((error) => {
+                console.warn('EventSourceGateway subscription update failed, applies on reconnect:', error);
+            });
+    }
+}
@@ -1,4 +1,14 @@
 import EventSource from './event-source';
+export { EventSourceChannel } from './channel';
+export { fetchStream, FetchStreamHeaders } from './fetch-stream';
+export type { ByteStream, FetchStreamInit, FetchStreamResponse } from './fetch-stream';
+export { EventSourceGateway } from './gateway';
+export type { GatewayOptions } from './gateway';
+export { MetricsHud } from './metrics-hud';
+export { PackedEventBatch } from './packed-events';
+export { defineEventSchema } from './schemas';
+export type { MetricsHudProps } from './metrics-hud';
+export type { NitroEventSource as NativeEventSource } from './specs/nitro-event-source.nitro';
 export * from './types';
 
 export default EventSource;
\ No newline at end of file
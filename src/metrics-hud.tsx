@@ -0,0 +1,83 @@
+import React, { useEffect, useState } from 'react';
+import { Platform, StyleSheet, Text, View } from 'react-native';
+import type { StyleProp, ViewStyle } from 'react-native';
+import { watchStreamMetrics } from './stream-registry';
+import type { StreamMetricsSample } from './types';
+
+export interface MetricsHudProps {
+    /** How often to sample, in milliseconds (default 1000, at least 250) */
+    intervalMs?: number;
+    style?: StyleProp<ViewStyle>;
+}
+
+const READY_STATES = ['connecting', 'open', 'closed'];
+const MONOSPACE = Platform.select({ ios: 'Menlo', default: 'monospace' });
+
+/**
+ * A small overlay for QA builds listing every open stream with its events/s,
+ * bytes/s, native queue depth, drops, reconnects and dispatch latency. Samples
+ * are taken natively and only cross into JS once per interval, so leaving it
+ * mounted costs little; it renders nothing while no stream is open.
+ */
+export function MetricsHud({ intervalMs = 1000, style }: MetricsHudProps): React.JSX.Element | null {
+    const [samples, setSamples] = useState<StreamMetricsSample[]>([]);
+    useEffect(() => watchStreamMetrics(setSamples, intervalMs), [intervalMs]);
+
+    if (samples.length === 0) {
+        return null;
+    }
+    return (
+        <View pointerEvents="none" style={[styles.hud, style]}>
+            {samples.map((sample) => (
+                <View key={sample.id} style={styles.stream}>
+                    <Text numberOfLines={1} style={styles.url}>
+                        #{sample.id} {READY_STATES[sample.readyState] ?? '?'} {sample.url}
+                    </Text>
+                    <Text style={styles.line}>
+                        {sample.eventsPerSecond.toFixed(1)} ev/s {formatBytes(sample.bytesPerSecond)}/s queue {sample.queuedEvents}
+                    </Text>
+                    <Text style={styles.line}>
+                        drops {sample.eventsDropped} reconnects {sample.reconnects} dispatch p50 {formatUs(sample.dispatchP50Us)} p99{' '}
+                        {formatUs(sample.dispatchP99Us)}
+                    </Text>
+                </View>
+            ))}
+        </View>
+    );
+}
+
+function formatBytes(bytes: number): string {
+    if (bytes >= 1024 * 1024) {
+        return `${(bytes / (1024 * 1024)).toFixed(1)} MB`;
+    }
+    return bytes >= 1024 ? `${(bytes / 1024).toFixed(1)} KB` : `${Math.round(bytes)} B`;
+}
+
+function formatUs(us: number): string {
+    return us >= 1000 ? `${(us / 1000).toFixed(1)}ms` : `${Math.round(us)}µs`;
+}
+
+const styles = StyleSheet.create({
+    hud: {
+        position: 'absolute',
+        top: 40,
+        left: 8,
+        right: 8,
+        padding: 6,
+        borderRadius: 6,
+        backgroundColor: 'rgba(0, 0, 0, 0.7)',
+    },
+    stream: {
+        paddingVertical: 2,
+    },
+    url: {
+        color: '#9fe29f',
+        fontSize: 11,
+        fontFamily: MONOSPACE,
+    },
+    line: {
+        color: '#ffffff',
+        fontSize: 10,
+        fontFamily: MONOSPACE,
+    },
+});
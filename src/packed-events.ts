@@ -0,0 +1,126 @@
+import type { NitroEventSourceEvent, PackedEvents } from './types';
+
+// Per event in the index: offsets of its id and data, its type's index, and 1 + its detail's
+const STRIDE = 4;
+
+type Utf8Decoder = { decode(bytes: Uint8Array): string };
+const NativeDecoder = (globalThis as { TextDecoder?: new () => Utf8Decoder }).TextDecoder;
+let decoder: Utf8Decoder | undefined;
+
+// Without a global TextDecoder (older Hermes): ASCII in chunks, anything else code point by code point
+function decodeUtf8(bytes: Uint8Array): string {
+    if (NativeDecoder) {
+        decoder ??= new NativeDecoder();
+        return decoder.decode(bytes);
+    }
+    let out = '';
+    const units: number[] = [];
+    for (let i = 0; i < bytes.length;) {
+        const lead = bytes[i]!;
+        let point = lead;
+        let extra = 0;
+        if (lead >= 0xf0) {
+            point = lead & 0x07;
+            extra = 3;
+        } else if (lead >= 0xe0) {
+            point = lead & 0x0f;
+            extra = 2;
+        } else if (lead >= 0xc0) {
+            point = lead & 0x1f;
+            extra = 1;
+        }
+        for (let k = 1; k <= extra; k++) {
+            point = (point << 6) | ((bytes[i + k] ?? 0x80) & 0x3f);
+        }
+        i += 1 + extra;
+        if (point > 0xffff) {
+            point -= 0x10000;
+            units.push(0xd800 | (point >> 10), 0xdc00 | (point & 0x3ff));
+        } else {
+            units.push(point);
+        }
+        if (units.length >= 4096) {
+            out += String.fromCharCode(...units);
+            units.length = 0;
+        }
+    }
+    return out + String.fromCharCode(...units);
+}
+
+/**
+ * A drainPacked() batch: every event's `id` and `data` bytes in one buffer, decoded into
+ * strings only when read. Iterating yields event objects like drainEvents() returns, minus
+ * `json`; `dataBytes()` hands a payload to a binary parser without decoding it at all.
+ * Connection events (`open` with `timing`, `error` with details) are kept whole.
+ */
+export class PackedEventBatch implements Iterable<NitroEventSourceEvent> {
+    readonly length: number;
+    private readonly bytes: Uint8Array;
+    private readonly index: Uint32Array;
+    private readonly received?: Float64Array;
+    private readonly sequences?: Float64Array;
+
+    constructor(private readonly packed: PackedEvents) {
+        this.length = packed.count;
+        this.bytes = new Uint8Array(packed.bytes);
+        this.index = new Uint32Array(packed.index);
+        this.received = packed.receivedAt ? new Float64Array(packed.receivedAt) : undefined;
+        this.sequences = packed.sequences ? new Float64Array(packed.sequences) : undefined;
+    }
+
+    /** Every distinct type in the batch */
+    get types(): readonly string[] {
+        return this.packed.types;
+    }
+
+    type(i: number): string {
+        return this.packed.types[this.index[i * STRIDE + 2]!]!;
+    }
+
+    id(i: number): string {
+        return decodeUtf8(this.bytes.subarray(this.index[i * STRIDE]!, this.index[i * STRIDE + 1]!));
+    }
+
+    /** A view of event `i`'s data bytes in the batch's buffer */
+    dataBytes(i: number): Uint8Array {
+        const end = i + 1 < this.length ? this.index[(i + 1) * STRIDE]! : this.bytes.length;
+        return this.bytes.subarray(this.index[i * STRIDE + 1]!, end);
+    }
+
+    data(i: number): string {
+        return decodeUtf8(this.dataBytes(i));
+    }
+
+    receivedAt(i: number): number | undefined {
+        const at = this.received?.[i];
+        return at === undefined || Number.isNaN(at) ? undefined : at;
+    }
+
+    sequence(i: number): number | undefined {
+        const sequence = this.sequences?.[i];
+        return sequence === undefined || Number.isNaN(sequence) ? undefined : sequence;
+    }
+
+    event(i: number): NitroEventSourceEvent {
+        const detail = this.index[i * STRIDE + 3]!;
+        if (detail > 0) {
+            return this.packed.details[detail - 1]!;
+        }
+        const event: NitroEventSourceEvent = { id: this.id(i), type: this.type(i), data: this.data(i) };
+        const receivedAt = this.receivedAt(i);
+        if (receivedAt !== undefined) {
+            event.receivedAt = receivedAt;
+        }
+        const sequence = this.sequence(i);
+        if (sequence !== undefined) {
+            event.sequence = sequence;
+        }
+        return event;
+    }
+
+    *[Symbol.iterator](): Iterator<NitroEventSourceEvent> {
+        for (let i = 0; i < this.length; i++) {
+            yield this.event(i);
+        }
+    }
+}
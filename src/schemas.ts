@@ -0,0 +1,76 @@
+import type { ColumnBatch, EventColumns, EventSchema, JsonObjectSchema, JsonPropertySchema, SchemaField, SchemaFieldKind } from './types';
+
+const FIELD_KINDS: ReadonlySet<string> = new Set<SchemaFieldKind>(['number', 'integer', 'boolean', 'string']);
+const FIELD_MESSAGE = "{ type: 'number' | 'integer' | 'boolean' | 'string' | 'object' } or { type: 'integer', format: 'int32' }";
+const OBJECT_KEYWORDS: ReadonlySet<string> = new Set(['type', 'properties', 'required', 'additionalProperties', 'title', 'description']);
+
+function escapePointer(key: string): string {
+    return key.replace(/~/g, '~0').replace(/\//g, '~1');
+}
+
+function flatten(schema: JsonObjectSchema, name: string, pointer: string, required: boolean, fields: SchemaField[]): void {
+    if (schema?.type !== 'object' || typeof schema.properties !== 'object' || schema.properties === null) {
+        throw new TypeError(`Schema '${name || '/'}' must be an object with properties`);
+    }
+    for (const keyword of Object.keys(schema)) {
+        if (!OBJECT_KEYWORDS.has(keyword)) {
+            throw new TypeError(`Schema '${name || '/'}' uses unsupported keyword '${keyword}'`);
+        }
+    }
+    const requiredNames = new Set(schema.required ?? []);
+    for (const [key, property] of Object.entries(schema.properties)) {
+        const fieldName = name ? `${name}.${key}` : key;
+        const fieldPointer = `${pointer}/${escapePointer(key)}`;
+        // As in JSON Schema, a property is optional unless its object lists it, and a
+        // field inside an optional object is optional too
+        const fieldRequired = required && requiredNames.has(key);
+        if (property?.type === 'object') {
+            flatten(property as JsonObjectSchema, fieldName, fieldPointer, fieldRequired, fields);
+            continue;
+        }
+        fields.push({ name: fieldName, pointer: fieldPointer, kind: fieldKind(property, fieldName), required: fieldRequired });
+    }
+}
+
+function fieldKind(property: JsonPropertySchema, name: string): SchemaFieldKind {
+    const { type, format, ...rest } = property as { type?: string; format?: string };
+    if (format === 'int32' && type === 'integer' && Object.keys(rest).length === 0) {
+        return 'int32';
+    }
+    if (format !== undefined || !FIELD_KINDS.has(type ?? '') || Object.keys(rest).length !== 0) {
+        throw new TypeError(`Field '${name}' must be ${FIELD_MESSAGE}`);
+    }
+    return type as SchemaFieldKind;
+}
+
+/**
+ * Compiles a JSON Schema for one event type's `data` into a `schemas` entry, once, so events
+ * of that type decode natively into columns. Takes the subset that maps onto columns: an
+ * object of `number`, `integer`, `boolean` and `string` properties and `required`, where
+ * `format: 'int32'` makes an integer an Int32Array column; nested objects flatten into
+ * columns named `a.b`. Throws a TypeError on anything else.
+ */
+export function defineEventSchema(type: string, schema: JsonObjectSchema): EventSchema {
+    const fields: SchemaField[] = [];
+    flatten(schema, '', '', true, fields);
+    if (fields.length === 0) {
+        throw new TypeError(`Schema for '${type}' has no fields`);
+    }
+    return { type, fields };
+}
+
+/** Names a native batch's columns after its schema, viewing the bytes in place */
+export function toColumnBatch(batch: EventColumns, schema: EventSchema): ColumnBatch {
+    const columns: ColumnBatch['columns'] = {};
+    schema.fields.forEach((field, i) => {
+        const buffer = batch.columns[i]!;
+        if (field.kind === 'boolean') {
+            columns[field.name] = new Uint8Array(buffer);
+        } else if (field.kind === 'int32' || field.kind === 'string') {
+            columns[field.name] = new Int32Array(buffer);
+        } else {
+            columns[field.name] = new Float64Array(buffer);
+        }
+    });
+    return { type: batch.type, count: batch.count, lastEventId: batch.lastEventId, columns, strings: batch.strings };
+}
@@ -1,10 +1,128 @@
-import { type HybridObject } from 'react-native-nitro-modules'
-import type { NitroEventSourceEvent, NitroEventSourceOptions } from '../types'
+import { type AnyMap, type HybridObject } from 'react-native-nitro-modules'
+import type { EventColumns, EventSourceMetrics, MetricsReportOptions, NitroEventSourceEvent, NitroEventSourceOptions, PackedEvents, PayloadFilter, ResponseHead, StreamMetricsSample } from '../types'
 
 export interface NitroEventSource extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    /** The connection's EventSourceReadyState, tracked natively as attempts start, open and end */
+    readonly readyState: number
+    /** @deprecated Use NitroEventSourceFactory.create(), which needs no stream to call it on */
     create(url: string, options?: NitroEventSourceOptions): NitroEventSource
+    /** lazyStart: begins connecting; does nothing once started, without lazyStart or after close() */
+    start(): void
     close(): void
+    closeAsync(): Promise<void>
+    /**
+     * Every event, converted and sent on its own. A type's addEventListener() listeners get their
+     * own conversion and crossing on top, so one consumer should pick one of the two; EventSource
+     * instead drains through setDrainCallback(), or subscribe() when it shares the connection
+     */
     setEventCallback(callback: (event: NitroEventSourceEvent) => void): void
-    addEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void
-    removeEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): void
-}
\ No newline at end of file
+    setBatchCallback(callback: (events: NitroEventSourceEvent[]) => void): void
+    setDrainCallback(callback: () => void): void
+    /** Queued events in arrival order, at most `maxEvents` of them when given */
+    drainEvents(maxEvents?: number): NitroEventSourceEvent[]
+    /**
+     * A queue of this stream's events of its own, handed out by natively fanning them out to
+     * every subscription that takes their type; `callback` is called once per drain cycle.
+     * Events go to subscriptions instead of drainEvents() while there are any
+     */
+    subscribe(callback: () => void): number
+    /** Only queue these event types for the subscription (open/error always pass), `undefined` queues everything */
+    setSubscriptionTypes(subscriptionId: number, types?: string[]): void
+    /**
+     * An inactive subscription keeps only the latest event of each type, open and error aside,
+     * and is not woken for them; made active again, it is woken once with those, oldest first
+     */
+    setSubscriptionActive(subscriptionId: number, active: boolean): void
+    /** The subscription's queued events in arrival order, at most `maxEvents` of them when given */
+    drainSubscription(subscriptionId: number, maxEvents?: number): NitroEventSourceEvent[]
+    /**
+     * Like drainEvents(), with every event's id and data packed into one buffer and an index of
+     * offsets instead of three strings each; `PackedEventBatch` decodes them on access
+     */
+    drainPacked(maxEvents?: number): PackedEvents
+    unsubscribe(subscriptionId: number): void
+    addEventListener(type: string, listener: (event: NitroEventSourceEvent) => void): number
+    removeEventListener(subscriptionId: number): void
+    setDataCallback(callback: (chunk: ArrayBuffer) => void): void
+    /** rawFraming: the messages split from one read, each in its own ArrayBuffer */
+    setMessagesCallback(callback: (messages: ArrayBuffer[]) => void): void
+    /**
+     * fetchMode: the body bytes queued since the last call, in one ArrayBuffer, `undefined` when
+     * none are. The drain callback wakes for them like for events
+     */
+    drainData(): ArrayBuffer | undefined
+    /** fetchMode: status and headers of the response, once they arrived */
+    getResponseHead(): ResponseHead | undefined
+    /** schemas: every type's rows decoded since the last call, one batch per type */
+    drainColumns(): EventColumns[]
+    /** The fields `messageSchema` names, read from native memory as JS asks for them */
+    decodeMessage(message: ArrayBuffer): AnyMap
+    /** Only deliver these event types (open/error always pass), `undefined` delivers everything */
+    setTypeFilter(types?: string[]): void
+    /** Only deliver events matching every filter, evaluated natively before anything crosses into JS */
+    setPayloadFilters(filters: PayloadFilter[]): void
+    getMetrics(): EventSourceMetrics
+    /** JSON text of the stateSync document at `pointer`, `undefined` when there is nothing there */
+    getState(pointer: string): string | undefined
+    /** Journaled events after the one with `fromId`, or all of them when `fromId` is not in the journal */
+    replay(fromId: string): NitroEventSourceEvent[]
+    /** The warmStart cache's latest event of `type`, if any */
+    getWarmEvent(type: string): NitroEventSourceEvent | undefined
+    /** The recentEvents ring's events of `type` still within its bounds, oldest first */
+    getRecentEvents(type: string): NitroEventSourceEvent[]
+    /** listenerBudget: a call to `listener` (its function name) for an event of `type` took `durationMs` past the budget */
+    reportSlowListener(type: string, listener: string, durationMs: number): void
+    /** @deprecated Use NitroEventSourceFactory.preconnect() */
+    preconnect(url: string): void
+    /** @deprecated Use NitroEventSourceFactory.warmUp() */
+    warmUp(): void
+    /** @deprecated Use NitroEventSourceFactory.setConnectionLimits() */
+    setConnectionLimits(maxConnections: number, maxConnectionsPerHost: number): void
+    /** @deprecated Use NitroEventSourceFactory.setMemoryBudget() */
+    setMemoryBudget(maxBufferedBytes: number): void
+    /** @deprecated Use NitroEventSourceFactory.setForeground() */
+    setForeground(foreground: boolean): void
+    /** Replaces `headers` from the next attempt on; the open connection is left alone */
+    updateHeaders(headers: Record<string, string>): void
+    /**
+     * Called on a 401 instead of giving up, once until the stream opens again. Answer with
+     * updateHeaders(), which reconnects at once, or close()
+     */
+    setUnauthorizedCallback(callback: () => void): void
+}
+
+/** Opens streams and holds the settings every stream shares; stateless, so one per JS runtime is enough */
+export interface NitroEventSourceFactory extends HybridObject<{ ios: 'c++', android: 'c++' }> {
+    create(url: string, options?: NitroEventSourceOptions): NitroEventSource
+    /**
+     * Hex hash of the URL, method, body and headers in canonical form: scheme and host
+     * lowercased, default port and fragment dropped, header names lowercased and sorted.
+     * Streams with equal keys send the same request
+     */
+    streamKey(url: string, options?: NitroEventSourceOptions): string
+    /** Warms DNS, TCP and TLS for the origin of `url` in the shared connection pool */
+    preconnect(url: string): void
+    /** Initializes libcurl and TLS and starts the I/O thread, in the background */
+    warmUp(): void
+    /** Caps the connections every stream together may hold, in total and to one host; 0 lifts a cap */
+    setConnectionLimits(maxConnections: number, maxConnectionsPerHost: number): void
+    /** Caps the bytes every stream together buffers natively for JS; 0 lifts the cap */
+    setMemoryBudget(maxBufferedBytes: number): void
+    /** Adds Set-Cookie values to the jar withCredentials streams share, as if `url` had sent them */
+    setCookies(url: string, cookies: string[]): void
+    /** The shared jar, one Netscape cookie-file line per cookie */
+    getCookies(): string[]
+    clearCookies(): void
+    /** Reports app foreground/background state, which streams' `background` policies follow */
+    setForeground(foreground: boolean): void
+    /** Closes every open stream, on any runtime, and resolves once all are torn down */
+    closeAll(): Promise<void>
+    /**
+     * Samples every open stream each `intervalMs` (at least 250) and calls `callback` with them,
+     * until unwatchMetrics(); a second watch replaces the first, on any runtime
+     */
+    watchMetrics(intervalMs: number, callback: (samples: StreamMetricsSample[]) => void): void
+    unwatchMetrics(): void
+    /** Appends native metrics reports to `options.file`, `undefined` stops */
+    setMetricsReport(options?: MetricsReportOptions): void
+}
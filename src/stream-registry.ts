@@ -0,0 +1,419 @@
+import { AppState } from 'react-native';
+import type { AppStateStatus } from 'react-native';
+import { NitroModules } from 'react-native-nitro-modules';
+import type { NitroEventSource as NitroEventSourceSpec, NitroEventSourceFactory } from './specs/nitro-event-source.nitro';
+import { PackedEventBatch } from './packed-events';
+import { toColumnBatch } from './schemas';
+import type { ColumnBatch, EventSchema, NitroEventSourceEvent, NitroEventSourceOptions, StreamMetricsSample } from './types';
+
+export const NitroEventSource =
+    NitroModules.createHybridObject<NitroEventSourceFactory>('NitroEventSourceFactory')
+
+/** One `EventSource` receiving the events of a shared native stream */
+export interface StreamConsumer {
+    deliver(event: NitroEventSourceEvent): void;
+    deliverData(chunk: ArrayBuffer): void;
+    deliverColumns(batch: ColumnBatch): void;
+    /** Event types this consumer has listeners for */
+    listenedTypes(): Iterable<string>;
+    close(): void;
+}
+
+// Native `background` policies follow AppState; `inactive` (e.g. Control Center) still counts as foreground
+let watchingAppState = false;
+export function watchAppState() {
+    if (watchingAppState) {
+        return;
+    }
+    watchingAppState = true;
+    const report = (state: AppStateStatus) => NitroEventSource.setForeground(state !== 'background');
+    report(AppState.currentState);
+    AppState.addEventListener('change', report);
+}
+
+// One native metrics watch for every watcher in this runtime, sampling as often as the most eager asks
+const metricsWatchers = new Map<(samples: StreamMetricsSample[]) => void, number>();
+let metricsIntervalMs: number | undefined;
+
+function updateMetricsWatch() {
+    const intervalMs = metricsWatchers.size === 0 ? undefined : Math.min(...metricsWatchers.values());
+    if (intervalMs === metricsIntervalMs) {
+        return;
+    }
+    metricsIntervalMs = intervalMs;
+    if (intervalMs === undefined) {
+        NitroEventSource.unwatchMetrics();
+        return;
+    }
+    NitroEventSource.watchMetrics(intervalMs, (samples: StreamMetricsSample[]) => {
+        for (const watcher of Array.from(metricsWatchers.keys())) {
+            watcher(samples);
+        }
+    });
+}
+
+/** Calls `watcher` with every open stream's sample each `intervalMs`; returns the function that stops it */
+export function watchStreamMetrics(watcher: (samples: StreamMetricsSample[]) => void, intervalMs: number): () => void {
+    metricsWatchers.set(watcher, intervalMs);
+    updateMetricsWatch();
+    return () => {
+        metricsWatchers.delete(watcher);
+        updateMetricsWatch();
+    };
+}
+
+// Streams opened with the same URL and options, keyed by shareKey()
+const streams = new Map<string, SharedStream>();
+// Every stream with consumers, shareable or not
+const openStreams = new Set<SharedStream>();
+
+/**
+ * A native connection and every `EventSource` reading from it; the connection
+ * closes with its last consumer. A connection that can be shared fans events
+ * out natively: each consumer subscribes with the types it listens to and
+ * drains its own queue when woken. Otherwise the single consumer drains the
+ * stream's queue.
+ */
+export class SharedStream {
+    readonly native: NitroEventSourceSpec;
+    private readonly consumers = new Set<StreamConsumer>();
+    // Native subscriptions of the consumers of a shareable connection
+    private readonly subscriptions = new Map<StreamConsumer, number>();
+    // Inactive consumers of an unshared connection, with the latest event of each type held for them
+    private readonly inactive = new Map<StreamConsumer, Map<string, NitroEventSourceEvent>>();
+    private readonly fanOut: boolean;
+    private readonly frameAligned: boolean;
+    // schemas by type, the last one given for a type winning as it does natively
+    private readonly schemas?: Map<string, EventSchema>;
+    private opened = false;
+    private lastEventId = '';
+    // pull: wakes `waitForEvents()`, or remembers the wake-up it has not yet waited for
+    private watchingQueue = false;
+    private woken = false;
+    private waiter?: () => void;
+
+    private constructor(url: string, options: NitroEventSourceOptions | undefined, private readonly key: string | undefined) {
+        if (options?.background) {
+            watchAppState();
+        }
+        this.native = NitroEventSource.create(url, options);
+        this.frameAligned = options?.frameAligned ?? false;
+        this.fanOut = key !== undefined;
+        if (options?.schemas?.length) {
+            this.schemas = new Map(options.schemas.map((schema) => [schema.type, schema]));
+        }
+        const pull = options?.pull ?? false;
+
+        this.native.setDataCallback((chunk: ArrayBuffer) => {
+            for (const consumer of Array.from(this.consumers)) {
+                consumer.deliverData(chunk);
+            }
+        });
+        if (options?.rawFraming || options?.transport === 'websocket') {
+            this.native.setMessagesCallback((messages: ArrayBuffer[]) => {
+                for (const consumer of Array.from(this.consumers)) {
+                    for (const message of messages) {
+                        consumer.deliverData(message);
+                    }
+                }
+            });
+        }
+
+        // Native side only enqueues; we get one wake-up per burst and drain everything in a single call.
+        // No further wake-up arrives until we drain, so frame-aligned mode simply defers the drain
+        // to the next vsync (requestAnimationFrame is driven by CADisplayLink / Choreographer)
+        // In pull mode nothing is delivered, the app takes events through take(); consumers that
+        // subscribe are each woken on their own instead
+        if (pull || this.fanOut) {
+            return;
+        }
+        this.native.setDrainCallback(() => {
+            if (this.frameAligned) {
+                requestAnimationFrame(() => this.drain());
+                return;
+            }
+            this.drain();
+        });
+    }
+
+    /** Joins the stream already open for `url` and `options`, or opens one */
+    static acquire(url: string, options?: NitroEventSourceOptions): SharedStream {
+        const key = shareKey(url, options);
+        const existing = key === undefined ? undefined : streams.get(key);
+        if (existing) {
+            return existing;
+        }
+
+        const stream = new SharedStream(url, options, key);
+        if (key !== undefined) {
+            streams.set(key, stream);
+        }
+        openStreams.add(stream);
+        return stream;
+    }
+
+    /**
+     * Closes the consumers of every stream. Meant to follow the native closeAll(), so each
+     * native close() they make finds its stream already closed and returns at once
+     */
+    static closeAllConsumers(): void {
+        for (const stream of Array.from(openStreams)) {
+            for (const consumer of Array.from(stream.consumers)) {
+                consumer.close();
+            }
+        }
+    }
+
+    /** Whether the connection is already open, so a joining consumer missed its `open` event */
+    get isOpen(): boolean {
+        return this.opened;
+    }
+
+    get lastOpenEventId(): string {
+        return this.lastEventId;
+    }
+
+    attach(consumer: StreamConsumer): void {
+        this.consumers.add(consumer);
+        if (!this.fanOut || this.subscriptions.has(consumer)) {
+            return;
+        }
+        const id = this.native.subscribe(() => {
+            if (this.frameAligned) {
+                requestAnimationFrame(() => this.drainSubscription(consumer, id));
+                return;
+            }
+            this.drainSubscription(consumer, id);
+        });
+        this.subscriptions.set(consumer, id);
+    }
+
+    /** Returns true when `consumer` was the last one and the connection should close */
+    detach(consumer: StreamConsumer): boolean {
+        const id = this.subscriptions.get(consumer);
+        if (id !== undefined) {
+            this.subscriptions.delete(consumer);
+            this.native.unsubscribe(id);
+        }
+        this.inactive.delete(consumer);
+        if (!this.consumers.delete(consumer) || this.consumers.size > 0) {
+            return false;
+        }
+        if (this.key !== undefined && streams.get(this.key) === this) {
+            streams.delete(this.key);
+        }
+        openStreams.delete(this);
+        return true;
+    }
+
+    // Lets native drop event types nobody listens to before they cross into JS, and skip
+    // `consumer`'s queue for the ones it does not listen to; `message` always passes
+    // because `onmessage` may be assigned at any time
+    updateTypeFilter(consumer?: StreamConsumer): void {
+        const types = new Set(['message', ...(this.schemas?.keys() ?? [])]);
+        for (const each of this.consumers) {
+            for (const type of each.listenedTypes()) {
+                types.add(type);
+            }
+        }
+        this.native.setTypeFilter(Array.from(types));
+
+        const id = consumer && this.subscriptions.get(consumer);
+        if (id !== undefined) {
+            this.native.setSubscriptionTypes(id, ['message', ...consumer!.listenedTypes()]);
+        }
+    }
+
+    /**
+     * Holds back what goes to `consumer` while inactive, keeping only the latest event of each
+     * type, and hands it those when active again; `open` and `error` still go out at once.
+     * A shared connection does so natively, so an inactive consumer costs no JS work at all;
+     * an unshared one still drains, but delivers nothing
+     */
+    setActive(consumer: StreamConsumer, active: boolean): void {
+        const id = this.subscriptions.get(consumer);
+        if (id !== undefined) {
+            this.native.setSubscriptionActive(id, active);
+            return;
+        }
+        if (!active) {
+            if (!this.inactive.has(consumer)) {
+                this.inactive.set(consumer, new Map());
+            }
+            return;
+        }
+        const held = this.inactive.get(consumer);
+        this.inactive.delete(consumer);
+        for (const event of held?.values() ?? []) {
+            consumer.deliver(event);
+        }
+    }
+
+    /**
+     * pull: asks native for a wake-up whenever events arrive after a take(). Must happen
+     * before the take() it follows, or a wake-up in between is lost
+     */
+    watchQueue(): void {
+        if (!this.watchingQueue) {
+            this.watchingQueue = true;
+            this.native.setDrainCallback(() => this.wake());
+        }
+    }
+
+    /** pull: resolves once events may be waiting, or wake() was called */
+    waitForEvents(): Promise<void> {
+        if (this.woken) {
+            this.woken = false;
+            return Promise.resolve();
+        }
+        return new Promise((resolve) => {
+            this.waiter = resolve;
+        });
+    }
+
+    wake(): void {
+        const waiter = this.waiter;
+        this.waiter = undefined;
+        if (waiter) {
+            waiter();
+        } else {
+            this.woken = true;
+        }
+    }
+
+    /** pull: hands up to `maxEvents` queued events to the caller instead of the consumers */
+    take(maxEvents?: number): NitroEventSourceEvent[] {
+        const events = this.native.drainEvents(maxEvents);
+        let ended = false;
+        for (const event of events) {
+            ended = this.track(event) || ended;
+        }
+        if (ended) {
+            for (const consumer of Array.from(this.consumers)) {
+                consumer.close();
+            }
+        }
+        return events;
+    }
+
+    /** pull: take() with the events packed into one buffer */
+    takePacked(maxEvents?: number): PackedEventBatch {
+        const batch = new PackedEventBatch(this.native.drainPacked(maxEvents));
+        // Only connection events change the state, and most batches have none
+        let ended = false;
+        if (batch.types.includes('open') || batch.types.includes('error')) {
+            for (let i = 0; i < batch.length; i++) {
+                const type = batch.type(i);
+                if (type === 'open' || type === 'error') {
+                    ended = this.track(batch.event(i)) || ended;
+                }
+            }
+        }
+        if (ended) {
+            for (const consumer of Array.from(this.consumers)) {
+                consumer.close();
+            }
+        }
+        return batch;
+    }
+
+    /** pull: hands the rows decoded since the last call to the caller */
+    takeColumns(): ColumnBatch[] {
+        if (!this.schemas) {
+            return [];
+        }
+        const batches: ColumnBatch[] = [];
+        for (const columns of this.native.drainColumns()) {
+            const schema = this.schemas.get(columns.type);
+            if (schema) {
+                batches.push(toColumnBatch(columns, schema));
+            }
+        }
+        return batches;
+    }
+
+    private drain(): void {
+        const consumers = Array.from(this.consumers);
+        for (const event of this.native.drainEvents()) {
+            const ended = this.track(event);
+            for (const consumer of consumers) {
+                const held = this.inactive.get(consumer);
+                if (held && event.type !== 'open' && event.type !== 'error') {
+                    // Re-inserted, so the held events keep the order of their latest arrival
+                    held.delete(event.type);
+                    held.set(event.type, event);
+                } else {
+                    consumer.deliver(event);
+                }
+            }
+            if (ended) {
+                // Rows that arrived before the end still go out
+                this.deliverColumns(consumers);
+                for (const consumer of consumers) {
+                    consumer.close();
+                }
+            }
+        }
+        this.deliverColumns(consumers);
+    }
+
+    private deliverColumns(consumers: StreamConsumer[]): void {
+        for (const batch of this.takeColumns()) {
+            for (const consumer of consumers) {
+                consumer.deliverColumns(batch);
+            }
+        }
+    }
+
+    private drainSubscription(consumer: StreamConsumer, id: number): void {
+        for (const event of this.native.drainSubscription(id)) {
+            const ended = this.track(event);
+            consumer.deliver(event);
+            if (ended) {
+                consumer.close();
+            }
+        }
+    }
+
+    // Follows the connection state; true once native has stopped for good
+    // (background `close`, tokenStream done, endOfStream)
+    private track(event: NitroEventSourceEvent): boolean {
+        if (event.type === 'open') {
+            this.opened = true;
+            this.lastEventId = event.id;
+        } else if (event.type === 'error') {
+            this.opened = false;
+        }
+        return event.type === 'error' && event.data === 'closed';
+    }
+}
+
+/**
+ * Streams share a connection only when they send the same request, by streamKey(), with identical other options,
+ * and `shareConnection: false` or a `zstdDictionary` (compared by contents it would
+ * cost a copy) opts out. So does any request but a GET: two POSTs are two requests,
+ * `pull`, where whoever drains takes the events, and `schemas`, whose rows are
+ * decoded into one queue rather than fanned out.
+ */
+function shareKey(url: string, options?: NitroEventSourceOptions): string | undefined {
+    if (options?.shareConnection === false || options?.zstdDictionary || options?.pull || options?.schemas?.length) {
+        return undefined;
+    }
+    if (options?.body !== undefined || (options?.method ?? 'GET').toUpperCase() !== 'GET') {
+        return undefined;
+    }
+    // The request compared as native canonicalizes it, the rest as given; JSON leaves out the undefined fields.
+    // listenerBudget applies to each EventSource's own listeners
+    const rest = { ...options, headers: undefined, method: undefined, listenerBudget: undefined };
+    return `${NitroEventSource.streamKey(url, options)}\n${stableStringify(rest)}`;
+}
+
+// JSON with object keys sorted, so `{ a, b }` and `{ b, a }` describe the same stream
+function stableStringify(value: unknown): string {
+    return JSON.stringify(value, (_key, inner: unknown) => {
+        if (!inner || typeof inner !== 'object' || Array.isArray(inner)) {
+            return inner;
+        }
+        return Object.fromEntries(Object.entries(inner).sort(([a], [b]) => (a < b ? -1 : a > b ? 1 : 0)));
+    });
+}
@@ -1,14 +1,1037 @@
 
+export interface ReconnectPolicy {
+    /** Base reconnect delay used until the server sends `retry:` (default 3000) */
+    initialDelayMs?: number
+    /** Upper bound for the exponential backoff (default 60000) */
+    maxDelayMs?: number
+    /** Growth factor applied per consecutive failed attempt (default 2) */
+    multiplier?: number
+    /** Randomize each delay in [0, delay] to avoid reconnect storms (default true) */
+    jitter?: boolean
+    byReason?: CloseReasonDelays
+}
+
+/**
+ * Base delays per reason a connection ended, each taking the place of `initialDelayMs` for
+ * it; a server-sent `retry:` still wins over all of them. `cleanCloseMs: 0` reconnects a
+ * stream the server ended cleanly, e.g. on a routine rotation, at once and over the same
+ * kept-alive connection where the server left it open. A clean close less than a second
+ * after opening takes the regular delay, so a server that keeps hanging up is not hammered
+ */
+export interface CloseReasonDelays {
+    /** The response ended without an error */
+    cleanCloseMs?: number
+    /** The connection was reset or dropped mid-response */
+    resetMs?: number
+    /** A connect, idle or stall timeout */
+    timeoutMs?: number
+    /** A response other than 200 that is retried, e.g. 503 or 429 */
+    httpErrorMs?: number
+}
+
+/**
+ * Stops a stream from hammering an endpoint that keeps failing. After `failureThreshold`
+ * attempts in a row fail before opening, the next one waits `openMs` instead of the
+ * backoff; each attempt after that is a probe, and one that fails doubles the wait up to
+ * `maxOpenMs`. An invalid certificate, a malformed URL or too many redirects open it at
+ * once. An attempt that opens closes it; a network change probes right away. The `error`
+ * event that opens it has `error.circuitOpen` set.
+ */
+export interface CircuitBreakerOptions {
+    /** Default 8, 0 turns the breaker off */
+    failureThreshold?: number
+    /** Default 300000 */
+    openMs?: number
+    /** Default 1800000 */
+    maxOpenMs?: number
+}
+
+export interface TimeoutOptions {
+    /** Longest DNS + TCP + TLS handshake before the attempt fails (default 30000) */
+    connectMs?: number
+    /**
+     * Reconnect when no bytes at all, heartbeat comments included, arrive for this long;
+     * JS sees an `error` event with data `timeout` (default off)
+     */
+    idleMs?: number
+    /** Reconnect once the stream stays below this rate for `lowSpeedMs` (default off) */
+    lowSpeedBytesPerSecond?: number
+    /** Window for `lowSpeedBytesPerSecond`, rounded up to whole seconds (default 30000) */
+    lowSpeedMs?: number
+    /**
+     * After this much silence, shorter than `idleMs`, a fresh connection to the origin is opened
+     * in parallel. If it gets through while the stream is still silent, the stream switches to it
+     * at once, resuming with `Last-Event-ID`, instead of waiting out `idleMs` and a handshake.
+     * Meant for servers that send heartbeats more often than this (default off)
+     */
+    stallMs?: number
+}
+
+export interface SocketOptions {
+    /** Send TCP keepalive probes on an idle connection (default true) */
+    keepalive?: boolean
+    /** Idle time before the first probe, rounded up to whole seconds (default 60000, curl's) */
+    keepaliveIdleMs?: number
+    /** Time between probes, rounded up to whole seconds (default 60000, curl's) */
+    keepaliveIntervalMs?: number
+    /** Disable Nagle's algorithm (default true, as in curl) */
+    noDelay?: boolean
+    /** Kernel receive buffer (SO_RCVBUF); smaller buffers lower latency on interactive streams (default: system) */
+    receiveBufferBytes?: number
+    /** How long an IPv6 attempt leads before IPv4 is tried in parallel (default 200, curl's) */
+    happyEyeballsTimeoutMs?: number
+    /** Only connect over this address family (default both, IPv6 first) */
+    ipFamily?: IpFamily
+}
+
+export type IpFamily = 'v4' | 'v6'
+
+/**
+ * How long reconnects skip a redirect the stream's URL answered with, e.g. a load balancer's
+ * 307 to a regional edge, and connect straight to where it led; 0 follows it every time.
+ * A POST is only sent straight on for 307 and 308, which keep it a POST. Authorization and
+ * Cookie headers are not sent to a target on another origin, as when following the redirect.
+ * A target that fails before opening is forgotten, the next attempt goes through the redirect.
+ */
+export interface RedirectCacheOptions {
+    /** When every hop was a 301 or 308 (default 3600000) */
+    permanentMs?: number
+    /** When any hop was a 302, 303 or 307 (default 60000) */
+    temporaryMs?: number
+}
+
+export interface DnsOptions {
+    /**
+     * How long resolved addresses stay cached (default 60000, curl's). The cache is shared by
+     * every stream, so a reconnect within it skips DNS
+     */
+    cacheTtlMs?: number
+    /**
+     * Fixed addresses in curl's `host:port:address[,address...]` form, used instead of DNS.
+     * They enter the shared cache, so other streams to the same host and port use them too
+     */
+    resolve?: string[]
+    /** DNS-over-HTTPS resolver, e.g. `https://dns.google/dns-query` */
+    dohUrl?: string
+}
+
+/**
+ * Keeps a second connection warm, to another edge host or to the same one, so a stream
+ * that drops after it was open reconnects over it at once instead of after a backoff and a
+ * fresh handshake. The stream resumes with `Last-Event-ID`. The standby goes to the best
+ * endpoint besides the current one, or to the stream's own URL when it has no other.
+ */
+export interface StandbyOptions {
+    /** One more endpoint, e.g. another edge host, serving as the standby */
+    url?: string
+    /** How often the standby is reopened if curl retired it, at least 1000 (default 60000) */
+    keepWarmMs?: number
+}
+
+export interface BatchOptions {
+    /** Flush as soon as this many events are queued (default 256) */
+    maxSize?: number
+    /** Flush at most this long after the first queued event (default 16) */
+    maxLatencyMs?: number
+}
+
+export interface CoalesceOptions {
+    /** Event types to coalesce (default every type except open/error) */
+    types?: string[]
+    /** Also key on the event `id:` */
+    byId?: boolean
+    /** Also key on this top-level field of the JSON `data` payload */
+    keyField?: string
+}
+
+/**
+ * What happens once `maxQueuedEvents` undelivered events are waiting for JS:
+ * - `block`: stop reading from the socket until JS catches up
+ * - `drop-oldest` / `drop-newest`: discard events to stay within the limit
+ * - `coalesce`: replace a waiting event with a newer one of the same type and id
+ */
+export type OverflowPolicy = 'block' | 'drop-oldest' | 'drop-newest' | 'coalesce'
+
+/**
+ * Caps on how fast one stream takes in data, e.g. for background streams, so interactive ones
+ * win the radio and CPU in a burst, or to bound cost on metered networks. Both hold back the
+ * socket rather than dropping anything, so TCP flow control slows the server down.
+ */
+/**
+ * Opens the stream without connecting: create() returns before the network thread starts or
+ * any request state is built, so constructing a screen does not wait on it, and no event can
+ * arrive before a callback is set. EventSource connects once something listens: the first
+ * `addEventListener()`, `onmessage` assignment, channel, drain or iteration, or `open()`;
+ * the native stream on `start()`.
+ */
+export interface LazyStartOptions {
+    /**
+     * Warm DNS, TCP and TLS for the origin right away, so the connection opens fast once
+     * started; this does start the network thread (default false)
+     */
+    prefetch?: boolean
+}
+
+export interface RateLimitOptions {
+    /** Average bytes per second read off the connection (default unlimited) */
+    maxBytesPerSecond?: number
+    /**
+     * Average events per second parsed and delivered, in bursts of up to one second's worth;
+     * events of a chunk already read are let through and paid back by a longer pause (default unlimited)
+     */
+    maxEventsPerSecond?: number
+}
+
+export type DeviceLoadLevel = 'elevated' | 'critical'
+
+/**
+ * How a stream degrades while the device is short of memory or thermally throttled, as
+ * the platform reports it: memory pressure or onTrimMemory(), and the thermal state,
+ * `elevated` from iOS `fair` or Android `moderate` and `critical` from `serious` or `severe`.
+ * Events are batched and coalesced natively so JS runs less often; the regular delivery
+ * returns, with whatever was held back, as soon as the load is gone
+ */
+export interface LoadPolicy {
+    /** Load the policy applies from (default 'elevated') */
+    from?: DeviceLoadLevel
+    /** Batch window, longer than `batch.maxLatencyMs` if that is shorter (default 100) */
+    batchLatencyMs?: number
+    /** Deliver only the latest held-back event of each type, or as `coalesce` says if set (default true) */
+    coalesce?: boolean
+    /** Events per second at most, see `rateLimit.maxEventsPerSecond` (default unchanged) */
+    maxEventsPerSecond?: number
+    /** Events queued for JS at most, see `backpressure.maxQueuedEvents` (default unchanged) */
+    maxQueuedEvents?: number
+}
+
+/**
+ * Times every call of an `addEventListener` listener. A call over `budgetMs` is counted in
+ * `slowListenerCalls` of getMetrics(), the slowest one is named by its type and function
+ * name, and the first slow call of each listener is logged, so a handler that holds up the
+ * JS thread can be found by name.
+ */
+export interface ListenerBudget {
+    /** A listener call taking longer than this is slow (default 8, half a 60 Hz frame) */
+    budgetMs?: number
+    /**
+     * A listener slow on 3 calls only receives the latest event of its type since its
+     * previous call from then on, at most once every `coalesceMs` (default false)
+     */
+    coalesceSlow?: boolean
+    /** How often a coalesced listener is called at most (default 100) */
+    coalesceMs?: number
+}
+
+export interface BackpressureOptions {
+    /** Upper bound of events queued natively for JS (default unbounded) */
+    maxQueuedEvents?: number
+    /**
+     * Upper bound of bytes buffered natively for JS, see `bufferedBytes` (default unbounded).
+     * With 'block', reaching either bound stops reading the socket until JS drains, so TCP
+     * flow control slows the server down instead of the app buffering
+     */
+    maxQueuedBytes?: number
+    /** Overflow behaviour once the bound is hit (default 'block') */
+    overflow?: OverflowPolicy
+}
+
+/**
+ * Declarative predicate evaluated natively before an event is delivered.
+ * All fields are optional; every field that is set must match.
+ */
+export interface PayloadFilter {
+    /** Only apply this filter to events of this type, other types pass */
+    type?: string
+    /** RFC 6901 pointer into the JSON `data` payload, e.g. `/roomId` */
+    pointer?: string
+    /** The value at `pointer` must equal this (numbers compare numerically) */
+    equals?: string
+    /** The value at `pointer` must equal one of these */
+    oneOf?: string[]
+    /** The event `id:` must start with this */
+    idPrefix?: string
+}
+
+/**
+ * What happens to a line over `maxLineBytes` or an event over `maxEventBytes`:
+ * - `drop`: discard the whole event
+ * - `truncate`: deliver the event cut at the limit
+ * - `chunk`: deliver the event in chunks no larger than the limit
+ */
+export type OversizePolicy = 'drop' | 'truncate' | 'chunk'
+
+export type StreamFormat = 'sse' | 'ndjson' | 'json-seq'
+
+export type StreamTransport = 'sse' | 'websocket'
+
+export type RawFraming = 'varint' | 'u32be'
+
+export type ProtoFieldType =
+    | 'int32' | 'int64' | 'uint32' | 'uint64' | 'sint32' | 'sint64' | 'bool'
+    | 'double' | 'float' | 'fixed32' | 'fixed64' | 'sfixed32' | 'sfixed64'
+    | 'string' | 'bytes'
+
+/**
+ * One field of a protobuf message. Numbers are JS numbers, so 64-bit values past 2^53 lose
+ * precision; `bytes` reads as an ArrayBuffer viewing the message. Nested messages are `bytes`
+ */
+export interface ProtoField {
+    name: string
+    number: number
+    type: ProtoFieldType
+    /** Read as an array, packed or not */
+    repeated?: boolean
+}
+
+export interface MessageSchema {
+    fields: ProtoField[]
+}
+
+/**
+ * What a stream does once the app has been in the background for `graceMs`:
+ * - `keep`: nothing, the OS may still kill the socket
+ * - `pause`: disconnect (an `error` with data `paused`) and reconnect with
+ *   `Last-Event-ID` when the app returns to the foreground
+ * - `close`: disconnect for good (an `error` with data `closed`), then close
+ */
+export type BackgroundPolicy = 'keep' | 'pause' | 'close'
+
+export interface BackgroundOptions {
+    /** Default 'keep' */
+    policy?: BackgroundPolicy
+    /** How long the app may stay in the background before the policy applies (default 30000) */
+    graceMs?: number
+    /**
+     * While backgrounded, reconnects wait for the next multiple of this many milliseconds
+     * on a clock every stream shares, so their retries go out together and wake the radio
+     * once (default 30000, 0 to retry on the backoff alone). Applies under every policy
+     */
+    reconnectAlignMs?: number
+}
+
+/**
+ * How urgent a stream is. Every stream shares one I/O thread, which runs at the
+ * QoS of the most urgent open stream (USER_INITIATED / DEFAULT / UTILITY on Apple
+ * platforms, nice -4 / 0 / 10 on Android). Within each loop iteration the most urgent
+ * streams read and parse first, their reconnects start first when due together, and
+ * over HTTP/2 the priority sets the stream weight. See also `efficiencyCores`.
+ */
+export type StreamPriority = 'interactive' | 'normal' | 'background'
+
+/**
+ * Collects token deltas natively, e.g. from an LLM completion, and delivers the text
+ * appended since the last delivery as one event of `eventType` per `intervalMs`.
+ * The sentinel ends the response: the remaining text goes out, then a `done` event
+ * carrying the whole text, then an `error` with data `closed`, and the stream closes
+ * without reconnecting.
+ */
+export interface TokenStreamOptions {
+    /** Event type carrying deltas (default 'message') */
+    eventType?: string
+    /** RFC 6901 pointer to the delta text inside a JSON `data`, e.g. '/choices/0/delta/content' (default: all of `data`) */
+    field?: string
+    /** Delivery cadence (default 50) */
+    intervalMs?: number
+    /** `data` that ends the response (default '[DONE]') */
+    doneSentinel?: string
+}
+
+/**
+ * Server signals that a finite stream is complete. Any of them ends it natively:
+ * an `error` with data `closed` follows and the stream closes without reconnecting.
+ */
+export interface EndOfStreamOptions {
+    /** `data` that ends the stream, e.g. '[DONE]'; the sentinel event itself is not delivered */
+    data?: string
+    /** Event type that ends the stream, delivered before it closes */
+    eventType?: string
+    /** Response statuses that end the stream (default [204], per the EventSource spec) */
+    statusCodes?: number[]
+}
+
+export type TimestampUnit = 's' | 'ms' | 'us'
+
+/**
+ * Measures each event's way from the server to JS into the `serverLatency`,
+ * `nativeLatency` and `dispatchLatency` histograms of `getMetrics()`. The server
+ * stamps events with its epoch time in a custom SSE field, e.g. `ts: 1718000000123`,
+ * or inside a JSON `data`. Device and server clocks differ, so `serverLatency` is
+ * only as good as their sync.
+ */
+export interface LatencyTracingOptions {
+    /** SSE field carrying the timestamp, e.g. 'ts' */
+    field?: string
+    /** RFC 6901 pointer to the timestamp inside a JSON `data`, e.g. '/sentAt' */
+    pointer?: string
+    /** Default 'ms' */
+    unit?: TimestampUnit
+}
+
+/**
+ * Measures the network from heartbeat events carrying the time the server sent them. Clocks
+ * differ, so only the delay on top of the connection's fastest heartbeat counts, smoothed and
+ * with its trend and jitter, in getMetrics(). `connectionQuality` is 1 on an idle network, half
+ * once delay plus twice the jitter reaches `goodDelayMs`, and shrinks with missed heartbeats,
+ * e.g. to switch to `coalesce` below 0.5. Heartbeats are still delivered to their listeners
+ */
+export interface HeartbeatOptions {
+    /** Type of the heartbeat events (default 'heartbeat') */
+    event?: string
+    /** RFC 6901 pointer to the timestamp inside a JSON `data` (default: all of `data`) */
+    field?: string
+    /** Default 'ms' */
+    unit?: TimestampUnit
+    /** The server's heartbeat interval, to count the ones that never arrived (default: not counted) */
+    intervalMs?: number
+    /** Delay plus twice the jitter that halves the quality score (default 250) */
+    goodDelayMs?: number
+    /**
+     * Type of an event raised natively whenever the score moved by 0.1, `data` being
+     * `{"quality","delayMs","delayTrendMs","jitterMs","missed"}` (default: none)
+     */
+    qualityEvent?: string
+}
+
+/**
+ * Flags streams that a proxy buffers: reads that follow a silence and carry a burst of
+ * events, which with `latencyTracing` must also be well behind their server timestamps.
+ * Three bursts among the last eight reads set `proxyBuffering` in the metrics
+ */
+export interface BufferingDetectionOptions {
+    /** Silence before a read for it to count as a burst (default 1000) */
+    gapMs?: number
+    /** Events a burst carries at least (default 4) */
+    burstEvents?: number
+    /** With server timestamps, how far behind a burst's events are at least (default 2000) */
+    lagMs?: number
+    /** Once flagged, reconnect over this transport instead, once per stream */
+    fallback?: StreamTransport
+    /** Once flagged, reconnect to this URL instead, e.g. on another port, once per stream */
+    fallbackUrl?: string
+}
+
+/**
+ * Summarizes events natively instead of delivering them: per window, one `eventType` event
+ * whose JSON `data` maps each type seen to `{ events, count, sum, min, max, mean }`, where
+ * `events` counts all of its events and the rest cover those carrying a number at `field`.
+ * The window opens with its first event
+ */
+export interface AggregationOptions {
+    /** Event types summarized, none of their events are delivered on their own */
+    types: string[]
+    /** RFC 6901 pointer to the number inside a JSON `data` (default: all of `data`) */
+    field?: string
+    /** Window length (default 1000) */
+    windowMs?: number
+    /** Type of the summary event (default 'aggregate') */
+    eventType?: string
+}
+
+/**
+ * Where `capture` records to. A relative `file` is under `storageDirectory`.
+ * Chunks are recorded as curl hands them over, still compressed when the
+ * response is, so replay them with the same options.
+ */
+export interface CaptureOptions {
+    file: string
+    /** Chunks past this size are left out (default 64 MiB, 0 unbounded) */
+    maxBytes?: number
+}
+
+/** The capture `replay` reads, a relative `file` is under `storageDirectory` */
+export interface ReplayOptions {
+    file: string
+    /** Playback rate against the recorded arrival times, 0 as fast as possible (default 1) */
+    speed?: number
+}
+
+/**
+ * Thins out high-rate streams natively, before events reach JS. `every` keeps one event in
+ * that many; `reservoir` then keeps a uniform sample of that many per `windowMs`, delivered
+ * in arrival order when the window closes. Counted in `eventsSampledOut`
+ */
+export interface SamplingOptions {
+    /** Keep one event in this many, starting with the first (default 1, every event) */
+    every?: number
+    /** Events kept per window, chosen uniformly at random (default 0, no reservoir) */
+    reservoir?: number
+    /** Reservoir window, starting with its first event (default 1000) */
+    windowMs?: number
+    /** Event types sampled; others pass untouched (default every type) */
+    types?: string[]
+}
+
+/**
+ * Decodes large JSON payloads on a few worker threads shared by every stream, while the
+ * network thread goes on parsing, so a burst of big events no longer decodes one after
+ * another. Events are still delivered in the order they arrived; zstd stays on the network
+ * thread, a compressed stream is one byte sequence
+ */
+export interface ParallelDecodeOptions {
+    /** Smallest `data` handed to a worker, smaller payloads decode inline (default 16384) */
+    minBytes?: number
+    /** Events decoding at once before the stream decodes inline again (default 16) */
+    maxInFlight?: number
+}
+
 export interface NitroEventSourceOptions {
+    /**
+     * Sends cookies from the jar all such streams share and stores the ones responses set
+     * in it, see `EventSource.setCookies()` (default false, no cookies either way)
+     */
     withCredentials?: boolean
     headers?: Record<string, string>
+    /** Default `nitro-event-source/1.0` */
+    userAgent?: string
+    /** HTTP method (default 'POST' with a `body`, otherwise 'GET') */
+    method?: string
+    /**
+     * Request body, sent again on every reconnect. Set `Content-Type` in `headers`;
+     * without one curl sends `application/x-www-form-urlencoded`
+     */
+    body?: string | ArrayBuffer
+    /** Deliver the response body as `ArrayBuffer` chunks through `ondata` instead of parsing SSE */
     rawMode?: boolean
+    /**
+     * rawMode: split the body into length-prefixed binary messages natively, a protobuf-style
+     * varint or a 32-bit big-endian length before each, and deliver every message as its own
+     * `ondata` ArrayBuffer. The messages of one read cross to JS together; one over
+     * `maxEventBytes` is skipped, and a malformed prefix fails the connection
+     */
+    rawFraming?: RawFraming
+    /** Protobuf fields `decodeMessage()` reads from rawFraming messages, without generated code */
+    messageSchema?: MessageSchema
+    /**
+     * Request/response semantics for `fetchStream()`: the body of any final status is read as
+     * raw bytes, queued natively for `drainData()` and held to `backpressure`; the stream ends
+     * with the body instead of reconnecting, and only `headers` are sent. `getResponseHead()`
+     * has the status and headers
+     */
+    fetchMode?: boolean
+    /**
+     * Events of these types decode natively into typed columns instead of one object each,
+     * see `defineEventSchema()`. Batches go to `oncolumns`, after the events drained with them,
+     * or to `drainColumns()` with `pull`. An event that does not match its schema is delivered
+     * as usual. Rows count towards `backpressure.maxQueuedEvents`; a stream with schemas opens
+     * its own connection
+     */
+    schemas?: EventSchema[]
+    /**
+     * How the body is framed (default 'sse'). 'ndjson' takes one JSON text per line and
+     * 'json-seq' RFC 7464 JSON text sequences; each record is a `message` event's data,
+     * filtered, batched and decoded by `parseJson` like SSE data
+     */
+    format?: StreamFormat
+    /**
+     * 'websocket' connects to the same URL as ws(s):// instead, for networks whose proxies
+     * buffer event streams (default 'sse'). Each text message is a `message` event's data and
+     * each binary one reaches `ondata` as with `rawFraming`; batching, metrics and reconnects
+     * work as for SSE. Needs a libcurl built with WebSocket support
+     */
+    transport?: StreamTransport
+    /** Multiplex streams to the same origin over one HTTP/2 connection (falls back to HTTP/1.1) */
+    http2?: boolean
+    /**
+     * Try HTTP/3 over QUIC first, falling back to HTTP/2 or HTTP/1.1 when QUIC is blocked or
+     * fails. Requires a libcurl built with HTTP/3 (`QUIC=1 third_party/curl/build.sh`)
+     */
+    http3?: boolean
+    /** Negotiate gzip/deflate/brotli/zstd with the server when libcurl supports them (default true) */
+    compression?: boolean
+    /**
+     * Pre-shared zstd dictionary; the server must answer with `Content-Encoding: zstd`
+     * frames compressed against the same dictionary. Requires a build with zstd:
+     * `NitroEventSource_zstd=true` on Android, `NITRO_EVENT_SOURCE_ZSTD=1` for pod install
+     */
+    zstdDictionary?: ArrayBuffer
+    reconnect?: ReconnectPolicy
+    circuitBreaker?: CircuitBreakerOptions
+    timeouts?: TimeoutOptions
+    socket?: SocketOptions
+    dns?: DnsOptions
+    redirectCache?: RedirectCacheOptions
+    /**
+     * More URLs serving the same stream, e.g. one per region. Each attempt goes to the one
+     * that opened fastest lately, with failures counting against it; one that fails sits out
+     * a growing cooldown, so the next attempt rotates to another. `url` stays the stream's URL
+     * for `origin`; the open event's `timing.url` tells which endpoint it connected to
+     */
+    endpoints?: string[]
+    standby?: StandbyOptions
+    /**
+     * Hold reconnects back while the device is offline and reconnect at once when a network
+     * returns or the active one changes interface, e.g. Wi-Fi to cellular (default true)
+     */
+    networkAware?: boolean
+    background?: BackgroundOptions
+    /** Default 'normal' */
+    priority?: StreamPriority
+    /**
+     * With `priority: 'background'`, e.g. sync or analytics: on Android the I/O thread keeps to
+     * the efficiency cores of a big.LITTLE SoC while every open stream is background, saving power
+     * on their parsing and decoding; it returns to every core as soon as a more urgent stream
+     * opens. Apple platforms already move background streams to QoS UTILITY (default false)
+     */
+    efficiencyCores?: boolean
+    tokenStream?: TokenStreamOptions
+    endOfStream?: EndOfStreamOptions
+    /**
+     * Response media types accepted as an event stream (default ['text/event-stream'], or the
+     * `format`'s own types, e.g. 'application/x-ndjson');
+     * anything else fails before its body is parsed, with an `error` carrying data
+     * `content-type`. An empty list accepts any type.
+     */
+    contentTypes?: string[]
+    latencyTracing?: LatencyTracingOptions
+    heartbeat?: HeartbeatOptions
+    bufferingDetection?: BufferingDetectionOptions
+    sampling?: SamplingOptions
+    aggregation?: AggregationOptions
+    /**
+     * Native transformers run on every event that passed the payload filters, in this order,
+     * by the names another native module registered them under with
+     * `EventTransformerRegistry::shared().add()` (see cpp/EventTransformer.hpp). They run in the
+     * transfer pipeline and may drop, rewrite or aggregate events before any reach JS; a name
+     * nothing is registered under is logged and skipped
+     */
+    transformers?: string[]
+    /** Queue events natively and deliver them to JS in batches */
+    batch?: BatchOptions
+    /** Decode `data` as JSON off the JS thread and expose it as `event.json` */
+    parseJson?: boolean
+    /** Deliver events as native host objects that only convert `data`/`json` when read */
+    lazyPayloads?: boolean
+    /**
+     * Hermes: `data` of at least this many bytes that is not ASCII is converted to UTF-16 on
+     * the network thread, so creating its string during the drain is a copy instead of a
+     * decode on the JS thread, e.g. for multi-MB snapshots (default 1024, 0 turns it off).
+     * Costs the converted copy in memory until the event is drained; other engines ignore it
+     */
+    utf16MinBytes?: number
+    /** Decode `data` on worker threads, see ParallelDecodeOptions (default off) */
+    parallelDecode?: ParallelDecodeOptions
+    backpressure?: BackpressureOptions
+    rateLimit?: RateLimitOptions
+    underLoad?: LoadPolicy
+    listenerBudget?: ListenerBudget
+    lazyStart?: LazyStartOptions
+    /**
+     * Event types queued in a lane of their own, e.g. ['control', 'logout']: drained ahead of any
+     * backlog, and never held back, dropped or coalesced by `backpressure`, `batch` or `coalesce`
+     */
+    priorityTypes?: string[]
+    /** Only deliver the latest undelivered event per key in each batch window (implies batching) */
+    coalesce?: CoalesceOptions
+    /** Deliver queued events at most once per display frame instead of as soon as they arrive */
+    frameAligned?: boolean
+    /**
+     * Keep events queued natively until `drain()` takes them, e.g. once per frame, instead of
+     * delivering them to `onmessage` and listeners. A queue JS does not keep up with fills up
+     * and applies `backpressure`
+     */
+    pull?: boolean
+    /** Drop events whose `id:` matches one of this many recently seen ids, e.g. replays after a reconnect (default off) */
+    dedupWindow?: number
+    /**
+     * Longest `id:` kept as the last event id; a longer one is ignored like one containing NUL,
+     * and the previous id stays. An empty `id:` resets it, so no Last-Event-ID is sent (default 1024,
+     * the longest `resumeKey` persists)
+     */
+    maxIdBytes?: number
+    /**
+     * Measure the native thread CPU time this stream costs, reported as `cpuParseMs`, `cpuDecodeMs`
+     * and `cpuDispatchMs` in `getMetrics()`. Reads the thread CPU clock a few times per chunk and
+     * event, so it is off by default
+     */
+    cpuAccounting?: boolean
+    /**
+     * Record the raw response bytes of every attempt, with their arrival times, to a file `replay`
+     * can feed back later, e.g. to turn production traffic into benchmark input
+     */
+    capture?: CaptureOptions
+    /**
+     * Instead of connecting, open at once and feed a `capture` file through the parser and delivery
+     * as if it came from the network, then end the stream. `url` is only used to tell streams apart
+     */
+    replay?: ReplayOptions
+    /** Longest line the parser buffers; bounds memory when a peer never sends a newline (default unbounded) */
+    maxLineBytes?: number
+    /** Largest `data` an event may accumulate (default unbounded) */
+    maxEventBytes?: number
+    /** Limit handling for `maxLineBytes` / `maxEventBytes` (default 'drop') */
+    oversize?: OversizePolicy
+    /**
+     * Deliver `data` as `begin`/`continue`/`end` chunks of about this many bytes while it
+     * arrives, instead of buffering the whole event (default off). Chunked events are not
+     * decoded as JSON, and their `event:`/`id:` fields must precede the data.
+     */
+    dataChunkBytes?: number
+    stateSync?: StateSyncOptions
+    /**
+     * Persists the last event id under this key and sends it as `Last-Event-ID` on the
+     * first connect after an app restart. Ids are saved as their events are parsed
+     */
+    resumeKey?: string
+    /** Directory for state kept across restarts (default: the app's cache directory) */
+    storageDirectory?: string
+    journal?: JournalOptions
+    warmStart?: WarmStartOptions
+    recentEvents?: RecentEventsOptions
+    /**
+     * Share one native connection with every other EventSource opened for the same URL
+     * with identical options; it closes with the last of them (default true)
+     */
+    shareConnection?: boolean
+}
+
+/**
+ * Appends every parsed event to an on-disk log, read back with `replay()`, e.g. to
+ * render the last known state on a cold start while the connection catches up.
+ * Events are stored compactly: each type once per segment, ids as the difference to the
+ * previous numeric id. Chunked events are not journaled.
+ */
+export interface JournalOptions {
+    /**
+     * Names the journal, streams opened with the same key share it (default the stream's
+     * `streamKey()`, so streams sending the same request do)
+     */
+    key?: string
+    /** Size of each log segment (default 1 MiB) */
+    segmentBytes?: number
+    /** Segments kept before the oldest is deleted (default 4) */
+    maxSegments?: number
+    /**
+     * Compresses each full segment with zstd, so the same disk space keeps more history
+     * (default false). Needs a build with zstd, see `zstdDictionary`; otherwise segments
+     * stay as they are.
+     */
+    compress?: boolean
+}
+
+/**
+ * Keeps the most recent event of each type on disk and hands it to a listener as soon as
+ * `addEventListener` attaches it, so screens can paint what the previous session last saw.
+ */
+export interface WarmStartOptions {
+    /** Names the cache, streams opened with the same key share it (default the stream's `streamKey()`) */
+    key?: string
+    /** Largest `id` plus `data` cached per type, bigger events are not cached (default 16 KiB) */
+    maxEventBytes?: number
+}
+
+/**
+ * Keeps the stream's last events in memory, so a listener attached later with
+ * `addEventListener(type, listener, { replay: true })` first receives the ones of its type
+ * it missed. Types nobody listened to yet are kept too. Chunked events are not kept.
+ */
+export interface RecentEventsOptions {
+    /** Events kept across all types, the oldest go first (default 64) */
+    maxEvents?: number
+    /** Events older than this are not replayed (default: no limit) */
+    maxAgeMs?: number
+}
+
+/**
+ * Keeps a JSON document natively: snapshot events replace it, patch events apply
+ * RFC 6902 operations to it. Their listeners receive the changed `paths` instead of
+ * `data`; read values with `getState(pointer)`.
+ */
+export interface StateSyncOptions {
+    /** Event type carrying the full document (default 'snapshot') */
+    snapshotEvent?: string
+    /** Event type carrying a JSON Patch array (default 'patch') */
+    patchEvent?: string
+    /**
+     * Keeps the document across app restarts under this key. A cold start then has the
+     * previous document in `getState()` at once and sends its version with `versionHeader`,
+     * so the server can send only the patches since then instead of a full snapshot
+     */
+    key?: string
+    /** Request header telling the server which version of the document the client has (default 'X-State-Version') */
+    versionHeader?: string
+    /**
+     * JSON Pointer to the document's own version, e.g. '/version'; by default the version is the
+     * id of the last snapshot or patch applied
+     */
+    versionPointer?: string
+}
+
+export interface EventSourceMetrics {
+    /** Delivered events currently held for reuse by the parser */
+    pooledEvents: number
+    /** Events built from a pooled object, keeping its string capacity */
+    poolHits: number
+    /** Events that had to be allocated because the pool was empty */
+    poolMisses: number
+    /** Response body bytes, after decompression */
+    bytesReceived: number
+    /** Complete events the parser produced */
+    eventsParsed: number
+    /** Events handed to JS */
+    eventsDispatched: number
+    /** Events dropped by dedup, size limits, type or payload filters and backpressure */
+    eventsDropped: number
+    /** Connection attempts after the first */
+    reconnects: number
+    /** Total time spent open, the current connection included */
+    connectedMs: number
+    /**
+     * Parser time per received chunk. Over a stream, `bytesReceived / parseTime.sumUs`
+     * is the parser's throughput in MB/s and `eventsParsed / parseTime.sumUs` its
+     * events per microsecond, the figures to compare across parser changes on a
+     * device; bench/sse_parser_bench.cpp measures the parser alone on the host.
+     */
+    parseTime: LatencyHistogram
+    /** From parsing an event to handing it to JS, for queued and batched delivery */
+    dispatchLatency: LatencyHistogram
+    /** latencyTracing: from the server timestamp to the chunk completing the event arriving, by wall clock */
+    serverLatency: LatencyHistogram
+    /** latencyTracing: from that chunk arriving to the event's dispatch, i.e. parsing and filtering */
+    nativeLatency: LatencyHistogram
+    /** Phases of the attempt that opened last, absent before the first open */
+    lastConnection?: ConnectionTiming
+    /** From starting each attempt that opened to its first response byte */
+    timeToFirstByte: LatencyHistogram
+    /** Comment lines received, which is what keepalives are */
+    commentsReceived: number
+    /** When the last comment arrived, in milliseconds since the Unix epoch like `Date.now()` */
+    lastCommentAt?: number
+    /** bufferingDetection: the current connection arrives in proxy-buffered bursts */
+    proxyBuffering: boolean
+    /** bufferingDetection: bursts seen over every connection */
+    bufferedBursts: number
+    /** sampling: events left out of the sample */
+    eventsSampledOut: number
+    /** aggregation: events folded into summaries */
+    eventsAggregated: number
+    /** Bytes this stream holds natively for JS, counted against `EventSource.setMemoryBudget()` */
+    bufferedBytes: number
+    /** `id:` fields ignored for containing NUL or exceeding `maxIdBytes` */
+    idsIgnored: number
+    /** cpuAccounting: I/O thread CPU time spent parsing the stream, excluding decode and dispatch, in milliseconds */
+    cpuParseMs: number
+    /** cpuAccounting: CPU time spent decompressing bodies and parsing JSON payloads */
+    cpuDecodeMs: number
+    /** cpuAccounting: CPU time spent filtering, queueing and delivering events to JS */
+    cpuDispatchMs: number
+    /** heartbeat: beats that never arrived over every connection, with `intervalMs` */
+    heartbeatsMissed: number
+    /** heartbeat: smoothed delay on top of the connection's fastest heartbeat */
+    heartbeatDelayMs?: number
+    /** heartbeat: how fast that delay moves, positive while it grows */
+    heartbeatDelayTrendMs?: number
+    /** heartbeat: RFC 3550 interarrival jitter of the heartbeats */
+    heartbeatJitterMs?: number
+    /** heartbeat: 1 on an idle network down to 0, see HeartbeatOptions; unset until two heartbeats arrived */
+    connectionQuality?: number
+    /** listenerBudget: listener calls that took longer than the budget, from every EventSource on the stream */
+    slowListenerCalls: number
+    /** listenerBudget: the slowest of those calls as "type: function name", unset until one was slow */
+    slowestListener?: string
+    /** listenerBudget: how long that call took */
+    slowestListenerMs?: number
+}
+
+/**
+ * Where `EventSource.setMetricsReport()` appends the native metrics reports:
+ * every `intervalMs`, one JSON line holding getMetrics() of each open stream,
+ * written on the network thread without JS.
+ */
+export interface MetricsReportOptions {
+    /** Absolute path of the file, e.g. in a directory the app's telemetry SDK uploads */
+    file: string
+    /** How often to report (default 60000, at least 1000) */
+    intervalMs?: number
+    /** Past this size the file moves to `<file>.1`, replacing the one before (default 1 MiB, 0 never rotates) */
+    maxFileBytes?: number
+}
+
+/**
+ * One stream as `EventSource.watchMetrics()` last sampled it. Rates cover the
+ * time since the stream's previous sample and are 0 in its first.
+ */
+export interface StreamMetricsSample {
+    /** Numbers streams in the order they were opened */
+    id: number
+    url: string
+    /** EventSourceReadyState */
+    readyState: number
+    eventsPerSecond: number
+    bytesPerSecond: number
+    /** Events waiting natively for JS to drain them */
+    queuedEvents: number
+    eventsDropped: number
+    reconnects: number
+    /** `dispatchLatency` percentiles so far */
+    dispatchP50Us: number
+    dispatchP99Us: number
 }
 
+/**
+ * How long each step of a connection attempt took, in milliseconds. A reused
+ * connection skips DNS, connect and TLS, and those read 0; so does TLS over http.
+ */
+export interface ConnectionTiming {
+    dnsMs: number
+    connectMs: number
+    tlsMs: number
+    /** From the request being ready to send to the first response byte, i.e. server think-time */
+    firstByteMs: number
+    /** Start of the attempt until it opened */
+    totalMs: number
+    /** The attempt went over an already established connection */
+    reused: boolean
+    /** Address family of the connection, i.e. which one won the happy-eyeballs race */
+    ipFamily?: IpFamily
+    /** The endpoint the attempt went to, `url` or one of `endpoints` */
+    url?: string
+}
+
+/**
+ * Durations in microseconds. `buckets[0]` counts samples under 1 µs, `buckets[i]`
+ * those in [2^(i-1), 2^i) µs; percentiles are the upper bound of their bucket.
+ */
+export interface LatencyHistogram {
+    count: number
+    sumUs: number
+    maxUs: number
+    p50Us: number
+    p90Us: number
+    p99Us: number
+    buckets: number[]
+}
+
+/** Position of a partial `data` chunk within its event */
+export type DataChunk = 'begin' | 'continue' | 'end'
+
 export interface NitroEventSourceEvent {
     id: string
     type: string
     data: string
+    /** Set when this is one part of a chunked event, concatenate the parts for the full `data` */
+    chunk?: DataChunk
+    /** JSON pointers a stateSync event changed, `''` for a whole new snapshot */
+    paths?: string[]
+    /** Set on `error` events for a failed attempt */
+    error?: StreamError
+    /** Set on `open` events, see `ConnectionTiming` */
+    timing?: ConnectionTiming
+    /**
+     * When the bytes completing the event arrived natively, in milliseconds since the Unix
+     * epoch like `Date.now()`; for open and error events, when they happened
+     */
+    receivedAt?: number
+    /**
+     * Position among the stream's parsed events, from 1, kept across reconnects and through
+     * batching, queues and `parallelDecode`. A gap means a later stage dropped events, e.g.
+     * `backpressure`, `coalesce`, a sampling reservoir or a payload filter; events native raises
+     * itself (open, error, token and aggregate events) have none
+     */
+    sequence?: number
+}
+
+/** A drainPacked() batch as it crosses from native; `PackedEventBatch` reads it */
+export interface PackedEvents {
+    count: number
+    /** Every event's `id` then `data` bytes, UTF-8, back to back */
+    bytes: ArrayBuffer
+    /** Uint32 per event: offsets of its id and data in `bytes`, its index in `types`, 1 + its index in `details` or 0 */
+    index: ArrayBuffer
+    types: string[]
+    /** Events carrying more than id, type and data, e.g. `error` with details */
+    details: NitroEventSourceEvent[]
+    /** Float64 `receivedAt` per event, NaN where unset; only when some event has one */
+    receivedAt?: ArrayBuffer
+    /** Float64 `sequence` per event, NaN where unset; only when some event has one */
+    sequences?: ArrayBuffer
+}
+
+export type SchemaFieldKind = 'number' | 'integer' | 'int32' | 'boolean' | 'string'
+
+/** One column of a `schemas` type: the value at `pointer` in every event's JSON `data` */
+export interface SchemaField {
+    name: string
+    /** RFC 6901 pointer into `data` (default `/<name>`) */
+    pointer?: string
+    kind: SchemaFieldKind
+    /**
+     * An event without it is delivered as usual rather than as a row (default true). Absent
+     * optional numbers read NaN, int32s and booleans 0 and strings ''
+     */
+    required?: boolean
+}
+
+/** A `schemas` entry, usually compiled by `defineEventSchema()` */
+export interface EventSchema {
+    type: string
+    fields: SchemaField[]
+}
+
+/** The JSON Schema subset `defineEventSchema()` compiles */
+export interface JsonObjectSchema {
+    type: 'object'
+    properties: Record<string, JsonPropertySchema>
+    required?: string[]
+}
+
+export type JsonPropertySchema =
+    | { type: 'number' | 'integer' | 'boolean' | 'string' }
+    /** An `Int32Array` column; a value outside its range delivers the event as usual */
+    | { type: 'integer', format: 'int32' }
+    | JsonObjectSchema
+
+/** A batch of rows as it crosses from native; `ColumnBatch` names its columns */
+export interface EventColumns {
+    type: string
+    count: number
+    lastEventId: string
+    /** Every field in schema order: numbers and integers as Float64, int32s and string indices as Int32, booleans as Uint8 bytes */
+    columns: ArrayBuffer[]
+    /** The batch's distinct strings, indexed by its string columns */
+    strings: string[]
+}
+
+/**
+ * Rows of one `schemas` type in arrival order, every field a column of `count` values:
+ * Float64Array for numbers and integers, Int32Array for int32s, Uint8Array of 0 and 1 for
+ * booleans, and for strings an Int32Array of indices into `strings`
+ */
+export interface ColumnBatch {
+    type: string
+    count: number
+    /** `id` of the batch's last event */
+    lastEventId: string
+    columns: Record<string, Float64Array | Int32Array | Uint8Array>
+    /** Every distinct string of the batch once, shared by its string columns */
+    strings: string[]
+}
+
+/** fetchMode: the final response's status line and headers, names lowercased and repeats joined with `, ` */
+export interface ResponseHead {
+    status: number
+    headers: Record<string, string>
+}
+
+/** Where an attempt failed: before any response, on the response head, or mid-body */
+export type ErrorPhase = 'connect' | 'response' | 'stream'
+
+/**
+ * Why an attempt failed and what happens next. A 4xx other than 408 and 429 is
+ * final: no retry follows and the stream closes, e.g. to refresh credentials first.
+ */
+export interface StreamError {
+    phase: ErrorPhase
+    /** libcurl's CURLcode, 0 when the transfer itself succeeded */
+    curlCode: number
+    /** HTTP status of the response, absent when none arrived */
+    status?: number
+    message: string
+    /** Consecutive failed attempts, this one included */
+    attempt: number
+    /** Delay until the next attempt; absent when giving up or waiting for the network */
+    retryInMs?: number
+    /** This failure opened the circuit breaker, `retryInMs` is how long it stays open */
+    circuitOpen?: boolean
 }
 
 
@@ -21,6 +1044,14 @@ export enum EventSourceReadyState {
 export interface MessageEvent {
     readonly type: 'message';
     readonly data: string;
+    /** Decoded `data`, set when the stream was opened with `parseJson` and the payload is valid JSON */
+    readonly json?: unknown;
+    /** Set for the parts of a chunked event, see `dataChunkBytes` */
+    readonly chunk?: DataChunk;
+    /** Set for stateSync events, see `getState` */
+    readonly paths?: string[];
+    /** See `NitroEventSourceEvent.sequence` */
+    readonly sequence?: number;
     readonly origin: string;
     readonly lastEventId: string;
     readonly source: null;
@@ -47,6 +1078,8 @@ export interface MessageEvent {
 export interface ErrorEvent {
     readonly type: 'error';
     readonly data: string;
+    /** Details of a failed attempt, absent for errors that only signal a state change */
+    readonly error?: StreamError;
     readonly isTrusted: boolean;
     readonly bubbles: boolean;
     readonly eventPhase: 0 | 2;
@@ -67,6 +1100,8 @@ export interface ErrorEvent {
 export interface OpenEvent {
     readonly type: 'open';
     readonly data: string;
+    /** Where the attempt spent its time; absent on the `open` replayed to a listener joining an open stream */
+    readonly timing?: ConnectionTiming;
     readonly isTrusted: boolean;
     readonly bubbles: boolean;
     readonly eventPhase: 0 | 2;
@@ -0,0 +1,132 @@
+/**
+ * The transfer engine built with NITRO_EVENT_SOURCE_TEST_ENGINE: no I/O thread
+ * and no sockets, this thread runs its tasks and timers, on a VirtualClock that
+ * only moves when a test advances it. Whatever waits seconds in an app, e.g. a
+ * reconnect's slot lease, finishes here at once and at the same virtual time
+ * on every run.
+ */
+#include "TransferEngine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::nitroeventsource;
+using namespace std::chrono_literals;
+using Clock = TransferEngine::Clock;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __LINE__)
+
+void check(bool passed, const char* condition, int line) {
+    if (!passed) {
+        std::fprintf(stderr, "transfer_engine_test.cpp:%d: CHECK(%s) failed\n", line, condition);
+        ++failures;
+    }
+}
+
+void timer_fires_at_its_deadline(TransferEngine& engine) {
+    const Clock::time_point deadline = Clock::now() + 5s;
+    std::vector<Clock::time_point> fired;
+    engine.schedule(deadline, [&]() { fired.push_back(Clock::now()); });
+
+    engine.advance(4999ms);
+    CHECK(fired.empty());
+    engine.advance(1ms);
+    CHECK(fired.size() == 1);
+    CHECK(!fired.empty() && fired.front() == deadline);
+}
+
+void cancelled_timer_never_fires(TransferEngine& engine) {
+    bool fired = false;
+    const TransferEngine::Timer timer = engine.schedule(Clock::now() + 1s, [&]() { fired = true; });
+    engine.run_pending();
+    engine.cancel(timer);
+
+    engine.advance(2s);
+    CHECK(!fired);
+}
+
+// On the I/O thread, e.g. an idle timer armed and then cancelled by a transfer that ended straight away
+void timer_cancelled_right_after_scheduling_never_fires(TransferEngine& engine) {
+    bool fired = false;
+    engine.post([&]() {
+        const TransferEngine::Timer timer = engine.schedule(Clock::now() + 1s, [&]() { fired = true; });
+        engine.cancel(timer);
+    });
+
+    engine.advance(2s);
+    CHECK(!fired);
+}
+
+void timers_due_together_run_most_urgent_first(TransferEngine& engine) {
+    const Clock::time_point deadline = Clock::now() + 100ms;
+    std::string order;
+    engine.schedule(deadline, [&]() { order += 'b'; }, TransferEngine::Priority::BACKGROUND);
+    engine.schedule(deadline, [&]() { order += 'd'; });
+    engine.schedule(deadline, [&]() { order += 'i'; }, TransferEngine::Priority::INTERACTIVE);
+
+    engine.advance(100ms);
+    CHECK(order == "idb");
+}
+
+// A reconnect whose handshake neither opens nor fails holds its origin for the 10 s slot lease,
+// then the next reconnect to that origin starts
+void stuck_reconnect_gives_up_its_slot(TransferEngine& engine) {
+    const Clock::time_point start = Clock::now();
+    std::vector<Clock::time_point> started;
+    engine.admit_reconnect("https://example.com", TransferEngine::Priority::DEFAULT, [&]() { started.push_back(Clock::now()); });
+    engine.admit_reconnect("https://example.com", TransferEngine::Priority::DEFAULT, [&]() { started.push_back(Clock::now()); });
+
+    engine.run_pending();
+    CHECK(started.size() == 1);
+    engine.advance(9999ms);
+    CHECK(started.size() == 1);
+    engine.advance(1ms);
+    CHECK(started.size() == 2);
+    CHECK(started.size() == 2 && started[1] - start == 10s);
+
+    // Let the second one's lease run out as well, so the gate is empty for later tests
+    engine.advance(10s);
+}
+
+// A reconnect that got through releases the others waiting for its origin at once
+void warm_reconnect_releases_the_rest(TransferEngine& engine) {
+    std::vector<uint64_t> tickets;
+    size_t started = 0;
+    for (int i = 0; i < 3; ++i) {
+        tickets.push_back(engine.admit_reconnect("https://example.org", TransferEngine::Priority::DEFAULT, [&]() { ++started; }));
+    }
+    engine.run_pending();
+    CHECK(started == 1);
+
+    engine.finish_reconnect(tickets.front(), true);
+    engine.run_pending();
+    CHECK(started == 3);
+}
+
+} // namespace
+
+int main() {
+    // The thread that first uses the engine is its I/O thread
+    TransferEngine& engine = TransferEngine::shared();
+    CHECK(engine.is_io_thread());
+
+    timer_fires_at_its_deadline(engine);
+    cancelled_timer_never_fires(engine);
+    timer_cancelled_right_after_scheduling_never_fires(engine);
+    timers_due_together_run_most_urgent_first(engine);
+    stuck_reconnect_gives_up_its_slot(engine);
+    warm_reconnect_releases_the_rest(engine);
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::puts("ok");
+    return 0;
+}
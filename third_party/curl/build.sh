@@ -0,0 +1,265 @@
+#!/usr/bin/env bash
+#
+# Builds the static TLS library and libcurl the module links, with the same versions and
+# feature flags on every platform: HTTP(S) only, HTTP/2 through nghttp2 for `http2: true`,
+# zlib content decoding, one TLS backend.
+#
+#   ANDROID_NDK_HOME=/path/to/ndk third_party/curl/build.sh armeabi-v7a x86
+#   TLS=mbedtls ANDROID_NDK_HOME=/path/to/ndk third_party/curl/build.sh arm64-v8a
+#   third_party/curl/build.sh ios
+#   QUIC=1 ANDROID_NDK_HOME=/path/to/ndk third_party/curl/build.sh arm64-v8a
+#   ARES=1 ANDROID_NDK_HOME=/path/to/ndk third_party/curl/build.sh arm64-v8a
+#   ZSTD=1 ANDROID_NDK_HOME=/path/to/ndk third_party/curl/build.sh arm64-v8a
+#
+# Android ABIs install into android/<abi>/, built for API 23 as ThinLTO bitcode so the
+# module's release link optimizes across them; list them in NitroEventSource_abis
+# (android/gradle.properties). armeabi-v7a is built with NEON, which the NDK enables by
+# default and SseScanner.hpp picks up.
+#
+# `ios` (macOS with Xcode) installs ios/NitroCurl.xcframework for devices and simulators
+# plus its headers, which NitroEventSource.podspec then links instead of the curl pod.
+#
+# TLS=openssl (the default) builds OpenSSL without the protocols, ciphers and engines an
+# HTTPS client never negotiates; TLS=mbedtls builds mbedTLS instead, a fraction of the size.
+# Certificates are checked against the system store: Android's CA directory, Apple's SecTrust.
+#
+# QUIC=1 adds HTTP/3 through ngtcp2 and nghttp3 on top of OpenSSL's QUIC TLS interface, for
+# streams created with `http3: true`. It needs TLS=openssl and adds roughly 400 KB per ABI.
+#
+# ARES=1 resolves names with c-ares, driven by the transfer engine's event loop, instead of
+# curl's threaded resolver, which starts a thread per lookup; a reconnect storm then resolves
+# without a burst of threads. On Android it reads the DNS servers from ConnectivityManager.
+#
+# ZSTD=1 also builds libzstd, for the module itself rather than curl: `zstdDictionary` and
+# compressed journal segments. Build the module with NitroEventSource_zstd=true in
+# android/gradle.properties, or NITRO_EVENT_SOURCE_ZSTD=1 for pod install, to use it.
+set -euo pipefail
+
+OPENSSL_VERSION=3.5.2
+MBEDTLS_VERSION=3.6.4
+CURL_VERSION=8.16.0
+NGHTTP2_VERSION=1.66.0
+NGHTTP3_VERSION=1.11.0
+NGTCP2_VERSION=1.14.0
+CARES_VERSION=1.34.5
+ZSTD_VERSION=1.5.7
+ANDROID_API=23
+IOS_VERSION=13.4
+TLS="${TLS:-openssl}"
+QUIC="${QUIC:-0}"
+ARES="${ARES:-0}"
+ZSTD="${ZSTD:-0}"
+
+here="$(cd "$(dirname "$0")" && pwd)"
+work="${TMPDIR:-/tmp}/nitro-event-source-curl"
+jobs="$(getconf _NPROCESSORS_ONLN)"
+base_flags="-O2 -fPIC -ffunction-sections -fdata-sections"
+
+mkdir -p "$work"
+cd "$work"
+case "$TLS" in
+    openssl)
+        [ -d "openssl-$OPENSSL_VERSION" ] || curl -fsSL "https://github.com/openssl/openssl/releases/download/openssl-$OPENSSL_VERSION/openssl-$OPENSSL_VERSION.tar.gz" | tar xz ;;
+    mbedtls)
+        [ -d "mbedtls-$MBEDTLS_VERSION" ] || curl -fsSL "https://github.com/Mbed-TLS/mbedtls/releases/download/mbedtls-$MBEDTLS_VERSION/mbedtls-$MBEDTLS_VERSION.tar.bz2" | tar xj ;;
+    *) echo "Unknown TLS backend: $TLS" >&2; exit 1 ;;
+esac
+if [ "$QUIC" = 1 ]; then
+    [ "$TLS" = openssl ] || { echo "QUIC=1 needs TLS=openssl" >&2; exit 1; }
+    [ -d "nghttp3-$NGHTTP3_VERSION" ] || curl -fsSL "https://github.com/ngtcp2/nghttp3/releases/download/v$NGHTTP3_VERSION/nghttp3-$NGHTTP3_VERSION.tar.xz" | tar xJ
+    [ -d "ngtcp2-$NGTCP2_VERSION" ] || curl -fsSL "https://github.com/ngtcp2/ngtcp2/releases/download/v$NGTCP2_VERSION/ngtcp2-$NGTCP2_VERSION.tar.xz" | tar xJ
+fi
+if [ "$ARES" = 1 ]; then
+    [ -d "c-ares-$CARES_VERSION" ] || curl -fsSL "https://github.com/c-ares/c-ares/releases/download/v$CARES_VERSION/c-ares-$CARES_VERSION.tar.gz" | tar xz
+fi
+if [ "$ZSTD" = 1 ]; then
+    [ -d "zstd-$ZSTD_VERSION" ] || curl -fsSL "https://github.com/facebook/zstd/releases/download/v$ZSTD_VERSION/zstd-$ZSTD_VERSION.tar.gz" | tar xz
+fi
+[ -d "nghttp2-$NGHTTP2_VERSION" ] || curl -fsSL "https://github.com/nghttp2/nghttp2/releases/download/v$NGHTTP2_VERSION/nghttp2-$NGHTTP2_VERSION.tar.xz" | tar xJ
+[ -d "curl-$CURL_VERSION" ] || curl -fsSL "https://curl.se/download/curl-$CURL_VERSION.tar.gz" | tar xz
+
+# build_slice <name> <configure host> <OpenSSL target> <CMake toolchain arguments...>
+# with CC, AR, RANLIB and CFLAGS set for the target; installs into $work/install/<name>
+build_slice() {
+    local name="$1" host="$2" openssl_target="$3"
+    shift 3
+    local prefix="$work/install/$name"
+
+    rm -rf "$prefix" "$work/tls-build-$name" "$work/curl-build-$name" "$work/quic-build-$name" "$work/ares-build-$name" "$work/nghttp2-build-$name" "$work/zstd-build-$name"
+    mkdir "$work/tls-build-$name" "$work/curl-build-$name" "$work/nghttp2-build-$name"
+
+    if [ "$TLS" = openssl ]; then
+        local quic_option=no-quic
+        [ "$QUIC" = 1 ] && quic_option=
+        (cd "$work/tls-build-$name" &&
+            "$work/openssl-$OPENSSL_VERSION/Configure" "$openssl_target" \
+                no-shared no-tests no-apps no-docs no-module no-legacy no-engine no-dso no-comp \
+                no-ssl3 no-dtls no-srp no-psk no-srtp no-ct no-cms no-ts no-ocsp no-gost no-sm2 no-sm3 no-sm4 \
+                no-aria no-bf no-camellia no-cast no-des no-idea no-md4 no-mdc2 no-rc2 no-rc4 no-rmd160 \
+                no-seed no-siphash no-whirlpool no-scrypt $quic_option \
+                --prefix="$prefix" --libdir=lib $CFLAGS &&
+            make -j"$jobs" build_libs && make install_dev)
+        tls_option="--with-openssl=$prefix"
+        tls_libraries=(libssl.a libcrypto.a)
+    else
+        (cd "$work/tls-build-$name" &&
+            cmake "$work/mbedtls-$MBEDTLS_VERSION" "$@" -DCMAKE_BUILD_TYPE=Release -DCMAKE_C_FLAGS="$CFLAGS" \
+                -DCMAKE_INSTALL_PREFIX="$prefix" -DCMAKE_INSTALL_LIBDIR=lib \
+                -DENABLE_PROGRAMS=OFF -DENABLE_TESTING=OFF -DUSE_SHARED_MBEDTLS_LIBRARY=OFF &&
+            cmake --build . -j"$jobs" && cmake --install .)
+        tls_option="--with-mbedtls=$prefix"
+        tls_libraries=(libmbedtls.a libmbedx509.a libmbedcrypto.a)
+    fi
+
+    # The library alone: no tools, no Python bindings, no dependencies of its own
+    (cd "$work/nghttp2-build-$name" &&
+        cmake "$work/nghttp2-$NGHTTP2_VERSION" "$@" -DCMAKE_BUILD_TYPE=Release -DCMAKE_C_FLAGS="$CFLAGS" \
+            -DCMAKE_INSTALL_PREFIX="$prefix" -DCMAKE_INSTALL_LIBDIR=lib \
+            -DENABLE_LIB_ONLY=ON -DBUILD_STATIC_LIBS=ON -DBUILD_SHARED_LIBS=OFF -DBUILD_TESTING=OFF &&
+        cmake --build . -j"$jobs" && cmake --install .)
+    tls_libraries=(libnghttp2.a "${tls_libraries[@]}")
+
+    # Never empty, so it expands under `set -u` with macOS's bash 3.2
+    local quic_options=(--without-ngtcp2)
+    if [ "$QUIC" = 1 ]; then
+        local project
+        for project in "nghttp3-$NGHTTP3_VERSION" "ngtcp2-$NGTCP2_VERSION"; do
+            mkdir -p "$work/quic-build-$name/$project"
+            (cd "$work/quic-build-$name/$project" &&
+                cmake "$work/$project" "$@" -DCMAKE_BUILD_TYPE=Release -DCMAKE_C_FLAGS="$CFLAGS" \
+                    -DCMAKE_INSTALL_PREFIX="$prefix" -DCMAKE_INSTALL_LIBDIR=lib -DCMAKE_PREFIX_PATH="$prefix" -DCMAKE_FIND_ROOT_PATH="$prefix" \
+                    -DENABLE_LIB_ONLY=ON -DENABLE_STATIC_LIB=ON -DENABLE_SHARED_LIB=OFF \
+                    -DENABLE_OPENSSL=ON -DOPENSSL_ROOT_DIR="$prefix" &&
+                cmake --build . -j"$jobs" && cmake --install .)
+        done
+        quic_options=(--with-nghttp3="$prefix" --with-ngtcp2="$prefix")
+        tls_libraries=(libngtcp2_crypto_ossl.a libngtcp2.a libnghttp3.a "${tls_libraries[@]}")
+    fi
+
+    local resolver_options=(--enable-threaded-resolver)
+    if [ "$ARES" = 1 ]; then
+        mkdir "$work/ares-build-$name"
+        (cd "$work/ares-build-$name" &&
+            cmake "$work/c-ares-$CARES_VERSION" "$@" -DCMAKE_BUILD_TYPE=Release -DCMAKE_C_FLAGS="$CFLAGS" \
+                -DCMAKE_INSTALL_PREFIX="$prefix" -DCMAKE_INSTALL_LIBDIR=lib \
+                -DCARES_STATIC=ON -DCARES_SHARED=OFF -DCARES_BUILD_TOOLS=OFF -DCARES_BUILD_TESTS=OFF &&
+            cmake --build . -j"$jobs" && cmake --install .)
+        resolver_options=(--enable-ares="$prefix")
+        tls_libraries+=(libcares.a)
+    fi
+
+    # The decoder and compressor only, no legacy formats and no programs
+    if [ "$ZSTD" = 1 ]; then
+        mkdir "$work/zstd-build-$name"
+        (cd "$work/zstd-build-$name" &&
+            cmake "$work/zstd-$ZSTD_VERSION/build/cmake" "$@" -DCMAKE_BUILD_TYPE=Release -DCMAKE_C_FLAGS="$CFLAGS" \
+                -DCMAKE_INSTALL_PREFIX="$prefix" -DCMAKE_INSTALL_LIBDIR=lib \
+                -DZSTD_BUILD_STATIC=ON -DZSTD_BUILD_SHARED=OFF -DZSTD_BUILD_PROGRAMS=OFF -DZSTD_BUILD_TESTS=OFF \
+                -DZSTD_LEGACY_SUPPORT=OFF -DZSTD_MULTITHREAD_SUPPORT=OFF &&
+            cmake --build . -j"$jobs" && cmake --install .)
+        tls_libraries+=(libzstd.a)
+    fi
+
+    local ca_options=(--with-ca-path=/system/etc/security/cacerts --without-ca-bundle)
+    if [ "$name" != "${name#ios}" ]; then
+        ca_options=(--with-apple-sectrust --without-ca-bundle --without-ca-path)
+    fi
+
+    (cd "$work/curl-build-$name" &&
+        "$work/curl-$CURL_VERSION/configure" --host="$host" --prefix="$prefix" \
+            --disable-shared --enable-static "$tls_option" --with-nghttp2="$prefix" --with-zlib "${ca_options[@]}" "${quic_options[@]}" "${resolver_options[@]}" \
+            --disable-ftp --disable-file --disable-ldap --disable-ldaps --disable-rtsp --disable-dict \
+            --disable-telnet --disable-tftp --disable-pop3 --disable-imap --disable-smtp --disable-gopher \
+            --disable-mqtt --disable-smb --disable-ntlm --disable-kerberos-auth --disable-negotiate-auth \
+            --disable-aws --enable-websockets --without-zstd \
+            --without-libpsl --without-libidn2 --disable-manual --disable-docs &&
+        make -j"$jobs" -C lib && make -C lib install && make -C include install)
+}
+
+build_android() {
+    local abi="$1" triple openssl_target
+    case "$abi" in
+        arm64-v8a)   triple=aarch64-linux-android;     openssl_target=android-arm64 ;;
+        armeabi-v7a) triple=armv7a-linux-androideabi;  openssl_target=android-arm ;;
+        x86_64)      triple=x86_64-linux-android;      openssl_target=android-x86_64 ;;
+        x86)         triple=i686-linux-android;        openssl_target=android-x86 ;;
+        *) echo "Unknown ABI: $abi" >&2; exit 1 ;;
+    esac
+
+    local ndk="${ANDROID_NDK_HOME:?set ANDROID_NDK_HOME to the NDK in android/gradle.properties}"
+    local toolchain
+    toolchain="$(echo "$ndk"/toolchains/llvm/prebuilt/*)"
+    export PATH="$toolchain/bin:$PATH"
+    export ANDROID_NDK_ROOT="$ndk"
+    export CC="$toolchain/bin/$triple$ANDROID_API-clang"
+    export AR="$toolchain/bin/llvm-ar"
+    export RANLIB="$toolchain/bin/llvm-ranlib"
+    export CFLAGS="$base_flags -flto=thin -D__ANDROID_API__=$ANDROID_API"
+
+    build_slice "$abi" "$triple" "$openssl_target" \
+        -DCMAKE_TOOLCHAIN_FILE="$ndk/build/cmake/android.toolchain.cmake" -DANDROID_ABI="$abi" -DANDROID_PLATFORM=$ANDROID_API
+
+    local prefix="$work/install/$abi" out="$here/android/$abi"
+    rm -rf "$out"
+    mkdir -p "$out"
+    cp "$prefix"/lib/libcurl.a "$out"/
+    for library in "${tls_libraries[@]}"; do
+        cp "$prefix/lib/$library" "$out"/
+    done
+    cp -R "$prefix"/include "$out"/include
+    echo "Installed $abi ($TLS) into $out"
+}
+
+build_ios() {
+    local slices=("ios-arm64 iphoneos arm64 ios64-xcrun"
+                  "ios-sim-arm64 iphonesimulator arm64 iossimulator-arm64-xcrun"
+                  "ios-sim-x86_64 iphonesimulator x86_64 iossimulator-x86_64-xcrun")
+    local slice name sdk arch openssl_target
+    for slice in "${slices[@]}"; do
+        read -r name sdk arch openssl_target <<< "$slice"
+        local min_version="-mios-version-min=$IOS_VERSION"
+        [ "$sdk" = iphonesimulator ] && min_version="-mios-simulator-version-min=$IOS_VERSION"
+        export CC="$(xcrun -sdk "$sdk" -f clang)"
+        export AR="$(xcrun -sdk "$sdk" -f ar)"
+        export RANLIB="$(xcrun -sdk "$sdk" -f ranlib)"
+        # No bitcode here: Apple's linker would have to match the LLVM that produced it
+        export CFLAGS="$base_flags -arch $arch -isysroot $(xcrun -sdk "$sdk" --show-sdk-path) $min_version"
+
+        build_slice "$name" "$arch-apple-darwin" "$openssl_target" \
+            -DCMAKE_SYSTEM_NAME=iOS -DCMAKE_OSX_SYSROOT="$sdk" -DCMAKE_OSX_ARCHITECTURES="$arch" \
+            -DCMAKE_OSX_DEPLOYMENT_TARGET=$IOS_VERSION
+
+        # One archive per slice, so the pod links a single library
+        local prefix="$work/install/$name" archives=()
+        for library in libcurl.a "${tls_libraries[@]}"; do
+            archives+=("$prefix/lib/$library")
+        done
+        libtool -static -o "$prefix/libnitrocurl.a" "${archives[@]}"
+    done
+
+    local simulator="$work/install/ios-sim"
+    mkdir -p "$simulator"
+    lipo -create "$work/install/ios-sim-arm64/libnitrocurl.a" "$work/install/ios-sim-x86_64/libnitrocurl.a" \
+        -output "$simulator/libnitrocurl.a"
+
+    local out="$here/ios"
+    rm -rf "$out"
+    mkdir -p "$out"
+    xcodebuild -create-xcframework \
+        -library "$work/install/ios-arm64/libnitrocurl.a" \
+        -library "$simulator/libnitrocurl.a" \
+        -output "$out/NitroCurl.xcframework"
+    cp -R "$work/install/ios-arm64/include" "$out"/include
+    echo "Installed ios ($TLS) into $out"
+}
+
+targets=("$@")
+[ ${#targets[@]} -gt 0 ] || targets=(armeabi-v7a x86)
+
+for target in "${targets[@]}"; do
+    if [ "$target" = ios ]; then
+        build_ios
+    else
+        build_android "$target"
+    fi
+done